@@ -13,6 +13,8 @@
 #include <impl/ecs_model/module.h>
 #include <impl/ecs_model_renderer/model_renderer.h>
 #include <impl/ecs_render/kernel/module.h>
+#include <impl/ecs_scene/module.h>
+#include <impl/ecs_skeleton/module.h>
 #include <impl/ecs_ui/module.h>
 #include <core/common/log.h>
 
@@ -74,6 +76,9 @@ bool NWB::CreateInitialProjectWorld(ProjectRuntimeContext& context, UniquePtr<Co
         context.assetManager,
         NWB::Impl::CreateModelObjectRendererHooks()
     );
+    // Registered after ModelSystem so joint attachment updates resolve in the same frame.
+    world->addSystem<NWB::Impl::Scene::TransformHierarchySystem>(*world);
+    world->addSystem<NWB::Impl::SkeletonPaletteSystem>(*world);
     auto& meshSkinningSystem = world->addSystem<NWB::Impl::MeshSkinningSystem>(
         *world,
         context.graphics,
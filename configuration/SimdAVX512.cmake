@@ -0,0 +1,13 @@
+include_guard(GLOBAL)
+
+# Builds individual sources for the SimdKernelTier::AVX512 kernels. The rest of the target keeps the baseline ISA, and
+# the kernels in these sources only run after the runtime tier check, so they must not be called directly.
+function(nwb_apply_simd_avx512_sources)
+    if(CMAKE_SYSTEM_PROCESSOR MATCHES "x86_64|AMD64")
+        if(NWB_COMPILER_FRONTEND_MSVC)
+            set_source_files_properties(${ARGN} PROPERTIES COMPILE_OPTIONS "/arch:AVX512")
+        else()
+            set_source_files_properties(${ARGN} PROPERTIES COMPILE_OPTIONS "-mavx512f;-mavx512dq")
+        endif()
+    endif()
+endfunction()
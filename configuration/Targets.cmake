@@ -3,6 +3,7 @@ include_guard(GLOBAL)
 include("${CMAKE_CURRENT_LIST_DIR}/CodeGen.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/BasicInclude.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/SimdAVX2.cmake")
+include("${CMAKE_CURRENT_LIST_DIR}/SimdAVX512.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/UnicodeChar.cmake")
 
 function(nwb_apply_internal_target_defaults target)
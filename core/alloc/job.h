@@ -11,6 +11,8 @@
 
 #include <global/arena_object.h>
 
+#include <bit>
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -21,6 +23,10 @@ NWB_ALLOC_BEGIN
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// Dependency counting and continuation release are lock-free: a job counts its unfinished dependencies atomically,
+// and each job keeps its dependents in an intrusive list whose head is tagged with the job's generation, so completion
+// closes the list with one exchange. Nodes and list links live in segments that never move once published; only
+// publishing a new segment takes a lock.
 class JobSystem : NoCopy{
 public:
     struct JobHandle{
@@ -38,6 +44,14 @@ private:
     static constexpr usize s_JobInlineStorageBytes = 384;
     static constexpr u32 s_WorkFirstDepthLimit = 8;
 
+    static constexpr u32 s_NodeSegmentShift = 8;
+    static constexpr u32 s_LinkSegmentShift = 10;
+
+    // Dependents list heads pack the owning generation above the first link index.
+    static constexpr u32 s_EmptyDependents = JobHandle::s_InvalidIndex;
+    static constexpr u32 s_ClosedDependents = JobHandle::s_InvalidIndex - 1u;
+    static constexpr u32 s_DependentsGenerationShift = 32;
+
 
 private:
     using JobFunction = InplaceFunction<s_JobInlineStorageBytes>;
@@ -45,32 +59,176 @@ private:
 
 
 private:
-    struct JobSignal{
+    static constexpr u64 packDependents(const u32 generation, const u32 linkIndex){
+        return (static_cast<u64>(generation) << s_DependentsGenerationShift) | linkIndex;
+    }
+    static constexpr u32 dependentsGeneration(const u64 head){
+        return static_cast<u32>(head >> s_DependentsGenerationShift);
+    }
+    static constexpr u32 dependentsLink(const u64 head){
+        return static_cast<u32>(head);
+    }
+
+
+private:
+    struct JobNode{
+        JobFunction func;
+        Atomic<u64> dependents{ packDependents(1, s_EmptyDependents) };
+        Atomic<u32> remainingDependencies{ 0 };
+        Atomic<u32> generation{ 1 };
         Atomic<u32> completedGeneration{ 0 };
+        Atomic<u32> next{ JobHandle::s_InvalidIndex };
     };
 
-    struct JobNode{
-        using DependencyList = Vector<JobHandle, PersistentArena>;
+    // One edge of the dependency graph, linked into the dependents list of the job it waits on. `next` links either
+    // that list or the pool's free list.
+    struct DependentLink{
+        JobHandle dependent;
+        Atomic<u32> next{ JobHandle::s_InvalidIndex };
+    };
 
-        JobFunction func;
-        DependencyList dependents;
-        JobSignal* completionSignal = nullptr;
-        u32 generation = 1;
-        u32 remainingDependencies = 0;
-        bool completed = true;
-        bool scheduled = false;
+    // Slots are handed out from a tagged lock-free free list, or past the high-water mark when it is empty. Segment 0
+    // holds the first `s_BaseSize` slots and every later segment doubles the total, so slots never move and the pool
+    // grows until the arena runs out or the index space is spent, with no cap of its own. Segments are allocated under
+    // `growMutex` because the arena is not thread-safe, and are only released with the pool.
+    template<typename T, u32 BaseShift>
+    class SlotPool : NoCopy{
+    private:
+        static constexpr u32 s_BaseSize = 1u << BaseShift;
+        static constexpr u32 s_SegmentCount = 32u - BaseShift + 1u;
+        // The two highest indices double as dependents list sentinels.
+        static constexpr u32 s_MaxSlots = s_ClosedDependents;
+        static constexpr u32 s_FreeTagShift = 32;
+
+
+    private:
+        static constexpr u32 segmentOf(const u32 index){
+            return index < s_BaseSize ? 0u : static_cast<u32>(std::bit_width(index)) - BaseShift;
+        }
+        static constexpr u32 segmentBase(const u32 segment){
+            return segment == 0u ? 0u : s_BaseSize << (segment - 1u);
+        }
+        static constexpr u32 segmentSize(const u32 segment){
+            return segment == 0u ? s_BaseSize : s_BaseSize << (segment - 1u);
+        }
+
+
+    public:
+        // Bytes of the segments needed to hold `slotCount` slots.
+        static inline usize segmentBytes(usize slotCount){
+            usize bytes = 0;
+            for(u32 segment = 0; segment < s_SegmentCount && segmentBase(segment) < slotCount; ++segment)
+                bytes = AddSize(bytes, SizeOf<sizeof(T)>(segmentSize(segment)));
+            return bytes;
+        }
 
 
     public:
-        inline explicit JobNode(PersistentArena& arena)
-            : dependents(DependencyList::allocator_type(arena))
-        {}
+        inline SlotPool() = default;
+
+
+    public:
+        [[nodiscard]] inline T* tryAt(const u32 index)const{
+            const u32 segment = segmentOf(index);
+            T* slots = m_segments[segment].load(MemoryOrder::acquire);
+            return slots ? slots + (index - segmentBase(segment)) : nullptr;
+        }
+
+        [[nodiscard]] inline T& at(const u32 index)const{
+            T* slot = tryAt(index);
+            NWB_ASSERT_MSG(slot != nullptr, NWB_TEXT("JobSystem accessed an unpublished slot"));
+            return *slot;
+        }
+
+        inline void reserve(PersistentArena& arena, Futex& growMutex, usize slotCount){
+            for(u32 segment = 0; segment < s_SegmentCount && segmentBase(segment) < slotCount; ++segment){
+                if(!publishSegment(arena, growMutex, segment))
+                    return;
+            }
+        }
+
+        // Returns `JobHandle::s_InvalidIndex` once the arena cannot hold another segment.
+        [[nodiscard]] inline u32 acquire(PersistentArena& arena, Futex& growMutex){
+            u64 head = m_freeHead.load(MemoryOrder::acquire);
+            for(;;){
+                const u32 index = static_cast<u32>(head);
+                if(index == JobHandle::s_InvalidIndex)
+                    break;
+
+                const u32 next = at(index).next.load(MemoryOrder::relaxed);
+                if(m_freeHead.compare_exchange_weak(head, nextHead(head, next), MemoryOrder::acquire, MemoryOrder::acquire))
+                    return index;
+            }
+
+            // The high-water mark only moves past slots whose segment is published, so a failed grow leaves it intact.
+            u32 index = m_slotCount.load(MemoryOrder::relaxed);
+            for(;;){
+                if(index >= s_MaxSlots || !publishSegment(arena, growMutex, segmentOf(index)))
+                    return JobHandle::s_InvalidIndex;
+                if(m_slotCount.compare_exchange_weak(index, index + 1u, MemoryOrder::relaxed, MemoryOrder::relaxed))
+                    return index;
+            }
+        }
+
+        inline void release(const u32 index){
+            T& slot = at(index);
+            u64 head = m_freeHead.load(MemoryOrder::relaxed);
+            do{
+                slot.next.store(static_cast<u32>(head), MemoryOrder::relaxed);
+            }while(!m_freeHead.compare_exchange_weak(head, nextHead(head, index), MemoryOrder::release, MemoryOrder::relaxed));
+        }
+
+        inline void destroy(PersistentArena& arena){
+            for(u32 segment = 0; segment < s_SegmentCount; ++segment){
+                T* slots = m_segments[segment].load(MemoryOrder::acquire);
+                if(!slots)
+                    continue;
+
+                const u32 size = segmentSize(segment);
+                for(u32 i = 0; i < size; ++i)
+                    slots[i].~T();
+                arena.template deallocate<T>(slots, size);
+                m_segments[segment].store(nullptr, MemoryOrder::relaxed);
+            }
+        }
+
+
+    private:
+        // The tag changes on every update so a stale head cannot win a compare-exchange after the slot was reused.
+        static inline u64 nextHead(const u64 head, const u32 index){
+            return (((head >> s_FreeTagShift) + 1u) << s_FreeTagShift) | index;
+        }
+
+        inline bool publishSegment(PersistentArena& arena, Futex& growMutex, const u32 segment){
+            if(m_segments[segment].load(MemoryOrder::acquire))
+                return true;
+
+            ScopedLock lock(growMutex);
+            if(m_segments[segment].load(MemoryOrder::relaxed))
+                return true;
+
+            const u32 size = segmentSize(segment);
+            T* slots = arena.template allocate<T>(size);
+            if(!slots)
+                return false;
+
+            for(u32 i = 0; i < size; ++i)
+                new(slots + i) T();
+            m_segments[segment].store(slots, MemoryOrder::release);
+            return true;
+        }
+
+
+    private:
+        Atomic<T*> m_segments[s_SegmentCount] = {};
+        Atomic<u64> m_freeHead{ JobHandle::s_InvalidIndex };
+        Atomic<u32> m_slotCount{ 0 };
     };
 
 
 private:
-    using JobNodeList = Vector<JobNode, PersistentArena>;
-    using JobFreeNodeList = Vector<u32, PersistentArena>;
+    using JobNodePool = SlotPool<JobNode, s_NodeSegmentShift>;
+    using DependentLinkPool = SlotPool<DependentLink, s_LinkSegmentShift>;
 
 
 private:
@@ -86,13 +244,12 @@ private:
         return SizeOf<s_DefaultNodeReservePerThread>(totalThreads);
     }
 
+    // Segments are never returned to the arena, so leave room for twice the reserve before a burst runs it dry.
     static inline usize defaultArenaSize(u32 threadCount){
-        const usize reserveCount = defaultNodeReserveCount(threadCount);
-        const usize nodeBytes = SizeOf<sizeof(JobNode)>(reserveCount);
-        const usize dependencyCount = SizeOf<s_DefaultDependenciesPerNode>(reserveCount);
-        const usize dependencyBytes = SizeOf<sizeof(JobHandle)>(dependencyCount);
-        const usize freeListBytes = SizeOf<sizeof(u32)>(reserveCount);
-        const usize total = AddSize(AddSize(AddSize(nodeBytes, dependencyBytes), freeListBytes), s_DefaultArenaOverheadBytes);
+        const usize reserveCount = SizeOf<2>(defaultNodeReserveCount(threadCount));
+        const usize nodeBytes = JobNodePool::segmentBytes(reserveCount);
+        const usize linkBytes = DependentLinkPool::segmentBytes(SizeOf<s_DefaultDependenciesPerNode>(reserveCount));
+        const usize total = AddSize(AddSize(nodeBytes, linkBytes), s_DefaultArenaOverheadBytes);
         const usize arenaSize = total > s_DefaultMinimumArenaSize ? total : s_DefaultMinimumArenaSize;
         return PersistentArena::StructureAlignedSize(arenaSize);
     }
@@ -106,8 +263,8 @@ private:
 
     inline void reserveDefaultNodes(const u32 threadCount){
         const usize reserveCount = defaultNodeReserveCount(threadCount);
-        m_nodes.reserve(reserveCount);
-        m_freeNodes.reserve(reserveCount);
+        m_nodes.reserve(m_arena, m_growMutex, reserveCount);
+        m_links.reserve(m_arena, m_growMutex, SizeOf<s_DefaultDependenciesPerNode>(reserveCount));
     }
 
 
@@ -115,8 +272,6 @@ public:
     inline explicit JobSystem(ThreadPool& pool, usize arenaSize = 0)
         : m_pool(pool)
         , m_arena(ArenaScope::s_JobSystem, resolveArenaSize(pool.m_threadCount, arenaSize))
-        , m_nodes(JobNodeList::allocator_type(m_arena))
-        , m_freeNodes(JobFreeNodeList::allocator_type(m_arena))
     {
         reserveDefaultNodes(pool.m_threadCount);
     }
@@ -124,8 +279,6 @@ public:
         : m_ownedPool(MakeUnique<ThreadPool>(threadCount, affinityMask, arenaSize))
         , m_pool(*m_ownedPool)
         , m_arena(ArenaScope::s_JobSystem, resolveArenaSize(threadCount, arenaSize))
-        , m_nodes(JobNodeList::allocator_type(m_arena))
-        , m_freeNodes(JobFreeNodeList::allocator_type(m_arena))
     {
         reserveDefaultNodes(threadCount);
     }
@@ -133,14 +286,21 @@ public:
         : m_ownedPool(MakeUnique<ThreadPool>(threadCount, affinity, arenaSize))
         , m_pool(*m_ownedPool)
         , m_arena(ArenaScope::s_JobSystem, resolveArenaSize(threadCount, arenaSize))
-        , m_nodes(JobNodeList::allocator_type(m_arena))
-        , m_freeNodes(JobFreeNodeList::allocator_type(m_arena))
+    {
+        reserveDefaultNodes(threadCount);
+    }
+    inline explicit JobSystem(u32 threadCount, CpuPinning::Enum pinning, usize arenaSize = 0)
+        : m_ownedPool(MakeUnique<ThreadPool>(threadCount, pinning, arenaSize))
+        , m_pool(*m_ownedPool)
+        , m_arena(ArenaScope::s_JobSystem, resolveArenaSize(threadCount, arenaSize))
     {
         reserveDefaultNodes(threadCount);
     }
 
     inline ~JobSystem(){
         waitAll();
+        m_links.destroy(m_arena);
+        m_nodes.destroy(m_arena);
     }
 
 
@@ -175,26 +335,16 @@ public:
         if(!handle.valid())
             return;
 
-        for(;;){
-            JobSignal* completionSignal = nullptr;
-            u32 completedGeneration = 0;
-
-            {
-                ScopedLock lock(m_mutex);
-
-                JobNode* node = tryResolveNodeLocked(handle);
-                if(!node)
-                    return;
-
-                completionSignal = node->completionSignal;
-                NWB_ASSERT_MSG(completionSignal != nullptr, NWB_TEXT("JobSystem encountered a null completion signal"));
+        JobNode* node = m_nodes.tryAt(handle.index);
+        if(!node)
+            return;
 
-                completedGeneration = completionSignal->completedGeneration.load(MemoryOrder::acquire);
-                if(completedGeneration == handle.generation)
-                    return;
-            }
+        for(;;){
+            const u32 completedGeneration = node->completedGeneration.load(MemoryOrder::acquire);
+            if(completedGeneration == handle.generation || node->generation.load(MemoryOrder::acquire) != handle.generation)
+                return;
 
-            completionSignal->completedGeneration.wait(completedGeneration, MemoryOrder::relaxed);
+            node->completedGeneration.wait(completedGeneration, MemoryOrder::relaxed);
         }
     }
 
@@ -215,8 +365,14 @@ public:
         if(!handle.valid())
             return true;
 
-        ScopedLock lock(m_mutex);
-        return !isPendingLocked(handle);
+        const JobNode* node = m_nodes.tryAt(handle.index);
+        if(!node)
+            return true;
+
+        return
+            node->completedGeneration.load(MemoryOrder::acquire) == handle.generation
+            || node->generation.load(MemoryOrder::acquire) != handle.generation
+        ;
     }
 
 private:
@@ -224,111 +380,122 @@ private:
         if(!task)
             return JobHandle{};
 
-        JobHandle output;
-        bool shouldSchedule = false;
-
-        {
-            ScopedLock lock(m_mutex);
-
-            output = acquireNodeLocked(Move(task));
-            JobNode* node = tryResolveNodeLocked(output);
-            NWB_ASSERT_MSG(node != nullptr, NWB_TEXT("JobSystem created an invalid job node"));
-            if(!node)
-                return JobHandle{};
-
-            u32 unresolved = 0;
-            for(usize i = 0; i < dependencyCount; ++i){
-                const JobHandle dependency = dependencies[i];
-                JobNode* dependencyNode = tryResolveNodeLocked(dependency);
-                if(!dependencyNode)
-                    continue;
+        NWB_ASSERT_MSG(
+            dependencyCount < static_cast<usize>(JobHandle::s_InvalidIndex),
+            NWB_TEXT("JobSystem dependency count overflow")
+        );
+        const JobHandle output = acquireNode(Move(task));
+        if(!output.valid())
+            return JobHandle{};
 
-                dependencyNode->dependents.push_back(output);
-                ++unresolved;
-            }
+        // Every link is taken before the first registration, so running out of link storage fails the submission as a
+        // whole instead of leaving a dependency unregistered and letting the job run ahead of it.
+        JobNode& node = m_nodes.at(output.index);
+        u32 reservedLinks = s_EmptyDependents;
+        if(!reserveLinks(dependencyCount, reservedLinks)){
+            recycleNode(output.index, node);
+            return JobHandle{};
+        }
 
-            m_pendingJobCount.fetch_add(1, MemoryOrder::release);
-            node->remainingDependencies = unresolved;
-            if(unresolved == 0){
-                node->scheduled = true;
-                shouldSchedule = true;
-            }
+        // The extra count holds the job back until every dependency has been registered or found already complete.
+        node.remainingDependencies.store(static_cast<u32>(dependencyCount) + 1u, MemoryOrder::relaxed);
+        m_pendingJobCount.fetch_add(1, MemoryOrder::release);
+
+        u32 satisfied = 1;
+        for(usize i = 0; i < dependencyCount; ++i){
+            if(!registerDependent(dependencies[i], output, reservedLinks))
+                ++satisfied;
         }
+        NWB_ASSERT_MSG(reservedLinks == s_EmptyDependents, NWB_TEXT("JobSystem left reserved dependency links unused"));
 
-        if(shouldSchedule)
+        if(node.remainingDependencies.fetch_sub(satisfied, MemoryOrder::acq_rel) == satisfied)
             enqueueExecution(output);
 
         return output;
     }
 
-    inline JobHandle acquireNodeLocked(JobFunction&& task){
-        u32 index = JobHandle::s_InvalidIndex;
-        if(!m_freeNodes.empty()){
-            index = m_freeNodes.back();
-            m_freeNodes.pop_back();
-        }
-        else{
-            if(m_nodes.size() >= static_cast<usize>(JobHandle::s_InvalidIndex)){
-                NWB_ASSERT_MSG(false, NWB_TEXT("JobSystem exceeded maximum number of trackable jobs"));
-                return JobHandle{};
-            }
-
-            index = static_cast<u32>(m_nodes.size());
-            m_nodes.emplace_back(m_arena);
-
-            JobNode& createdNode = m_nodes[index];
-            createdNode.completionSignal = NewArenaObject<JobSignal>(m_arena);
-            NWB_ASSERT_MSG(createdNode.completionSignal != nullptr, NWB_TEXT("JobSystem failed to allocate a completion signal"));
-        }
+    inline JobHandle acquireNode(JobFunction&& task){
+        const u32 index = m_nodes.acquire(m_arena, m_growMutex);
+        if(index == JobHandle::s_InvalidIndex)
+            return JobHandle{};
 
-        JobNode& node = m_nodes[index];
-        NWB_ASSERT_MSG(node.completionSignal != nullptr, NWB_TEXT("JobSystem acquired an invalid completion signal"));
+        JobNode& node = m_nodes.at(index);
         node.func = Move(task);
-        node.dependents.clear();
-        node.remainingDependencies = 0;
-        node.completed = false;
-        node.scheduled = false;
 
         JobHandle output;
         output.index = index;
-        output.generation = node.generation;
+        output.generation = node.generation.load(MemoryOrder::relaxed);
         return output;
     }
 
-    inline void recycleNodeLocked(u32 index, JobNode& node){
+    inline void recycleNode(u32 index, JobNode& node){
         node.func = JobFunction();
-        node.dependents.clear();
-        node.remainingDependencies = 0;
-        node.completed = true;
-        node.scheduled = false;
 
-        ++node.generation;
-        if(node.generation == 0)
-            node.generation = 1;
+        u32 generation = node.generation.load(MemoryOrder::relaxed) + 1;
+        if(generation == 0)
+            generation = 1;
 
-        m_freeNodes.push_back(index);
+        node.dependents.store(packDependents(generation, s_EmptyDependents), MemoryOrder::relaxed);
+        node.generation.store(generation, MemoryOrder::release);
+        m_nodes.release(index);
     }
 
-    inline bool isPendingLocked(JobHandle handle)const{
-        if(handle.index >= m_nodes.size())
-            return false;
+    // Chains `linkCount` free links through their `next` fields. On failure every link taken so far is released.
+    inline bool reserveLinks(const usize linkCount, u32& outLinks){
+        outLinks = s_EmptyDependents;
+        for(usize i = 0; i < linkCount; ++i){
+            const u32 linkIndex = m_links.acquire(m_arena, m_growMutex);
+            if(linkIndex == JobHandle::s_InvalidIndex){
+                releaseLinks(outLinks);
+                outLinks = s_EmptyDependents;
+                return false;
+            }
 
-        const JobNode& node = m_nodes[handle.index];
-        if(node.generation != handle.generation)
-            return false;
+            m_links.at(linkIndex).next.store(outLinks, MemoryOrder::relaxed);
+            outLinks = linkIndex;
+        }
+        return true;
+    }
 
-        return !node.completed;
+    inline void releaseLinks(u32 linkIndex){
+        while(linkIndex != s_EmptyDependents){
+            const u32 nextLink = m_links.at(linkIndex).next.load(MemoryOrder::relaxed);
+            m_links.release(linkIndex);
+            linkIndex = nextLink;
+        }
     }
 
-    inline JobNode* tryResolveNodeLocked(JobHandle handle){
-        if(!handle.valid() || handle.index >= m_nodes.size())
-            return nullptr;
+    // Links `dependent` behind `dependency` with the next link from `inOutReservedLinks`. Returns false when the
+    // dependency is invalid or already complete, in which case the link goes back to the pool and the caller counts the
+    // dependency as satisfied.
+    inline bool registerDependent(JobHandle dependency, JobHandle dependent, u32& inOutReservedLinks){
+        const u32 linkIndex = inOutReservedLinks;
+        DependentLink& link = m_links.at(linkIndex);
+        inOutReservedLinks = link.next.load(MemoryOrder::relaxed);
 
-        JobNode& node = m_nodes[handle.index];
-        if(node.generation != handle.generation || node.completed)
-            return nullptr;
+        JobNode* node = dependency.valid() ? m_nodes.tryAt(dependency.index) : nullptr;
+        if(!node){
+            m_links.release(linkIndex);
+            return false;
+        }
 
-        return &node;
+        link.dependent = dependent;
+        u64 head = node->dependents.load(MemoryOrder::acquire);
+        for(;;){
+            if(dependentsGeneration(head) != dependency.generation || dependentsLink(head) == s_ClosedDependents){
+                m_links.release(linkIndex);
+                return false;
+            }
+
+            link.next.store(dependentsLink(head), MemoryOrder::relaxed);
+            if(node->dependents.compare_exchange_weak(
+                head,
+                packDependents(dependency.generation, linkIndex),
+                MemoryOrder::release,
+                MemoryOrder::acquire
+            ))
+                return true;
+        }
     }
 
     inline void enqueueExecution(JobHandle handle){
@@ -360,22 +527,18 @@ private:
         u32 workFirstDepth = 0;
 
         while(current.valid()){
-            JobFunction task;
-            {
-                ScopedLock lock(m_mutex);
-
-                JobNode* node = tryResolveNodeLocked(current);
-                if(!node || !node->scheduled)
-                    return;
-
-                task = Move(node->func);
-            }
+            JobNode& node = m_nodes.at(current.index);
+            NWB_ASSERT_MSG(
+                node.generation.load(MemoryOrder::relaxed) == current.generation,
+                NWB_TEXT("JobSystem executed a stale job handle")
+            );
 
+            JobFunction task = Move(node.func);
             if(task)
                 task();
 
             const bool allowInline = workFirstDepth < s_WorkFirstDepthLimit;
-            const JobHandle inlineContinuation = complete(current, allowInline);
+            const JobHandle inlineContinuation = complete(current, node, allowInline);
             if(!inlineContinuation.valid())
                 return;
 
@@ -384,53 +547,37 @@ private:
         }
     }
 
-    inline JobHandle complete(JobHandle handle, bool allowInline){
+    inline JobHandle complete(JobHandle handle, JobNode& node, bool allowInline){
         ScratchArena scratchArena(ArenaScope::s_JobReadyBatch);
         ReadyBatch readyJobs{ReadyBatch::allocator_type(scratchArena)};
-        JobSignal* completionSignal = nullptr;
         JobHandle inlineContinuation;
 
-        {
-            ScopedLock lock(m_mutex);
-
-            JobNode* node = tryResolveNodeLocked(handle);
-            if(!node)
-                return JobHandle{};
-
-            completionSignal = node->completionSignal;
-            NWB_ASSERT_MSG(completionSignal != nullptr, NWB_TEXT("JobSystem encountered a null completion signal"));
-
-            const usize dependentCount = node->dependents.size();
-            for(usize i = 0; i < dependentCount; ++i){
-                const JobHandle dependentHandle = node->dependents[i];
-                JobNode* dependentNode = tryResolveNodeLocked(dependentHandle);
-                if(!dependentNode)
-                    continue;
-
-                NWB_ASSERT_MSG(dependentNode->remainingDependencies > 0, NWB_TEXT("JobSystem dependency counter underflow"));
-                if(dependentNode->remainingDependencies == 0)
-                    continue;
-
-                --dependentNode->remainingDependencies;
-                if(dependentNode->remainingDependencies == 0 && !dependentNode->scheduled){
-                    dependentNode->scheduled = true;
-
-                    if(allowInline && !inlineContinuation.valid()){
-                        inlineContinuation = dependentHandle;
-                        continue;
-                    }
-
-                    if(readyJobs.empty())
-                        readyJobs.reserve(dependentCount - i);
-                    readyJobs.push_back(dependentHandle);
-                }
+        // Closing the list makes later registrations see the job as complete, and hands the links to this thread.
+        const u64 head = node.dependents.exchange(packDependents(handle.generation, s_ClosedDependents), MemoryOrder::acq_rel);
+        u32 linkIndex = dependentsLink(head);
+        while(linkIndex != s_EmptyDependents){
+            DependentLink& link = m_links.at(linkIndex);
+            const JobHandle dependentHandle = link.dependent;
+            const u32 nextLink = link.next.load(MemoryOrder::relaxed);
+            m_links.release(linkIndex);
+            linkIndex = nextLink;
+
+            JobNode& dependentNode = m_nodes.at(dependentHandle.index);
+            const u32 remaining = dependentNode.remainingDependencies.fetch_sub(1, MemoryOrder::acq_rel);
+            NWB_ASSERT_MSG(remaining > 0, NWB_TEXT("JobSystem dependency counter underflow"));
+            if(remaining != 1)
+                continue;
+
+            if(allowInline && !inlineContinuation.valid()){
+                inlineContinuation = dependentHandle;
+                continue;
             }
-
-            completionSignal->completedGeneration.store(handle.generation, MemoryOrder::release);
-            recycleNodeLocked(handle.index, *node);
+            readyJobs.push_back(dependentHandle);
         }
 
-        completionSignal->completedGeneration.notify_all();
+        node.completedGeneration.store(handle.generation, MemoryOrder::release);
+        node.completedGeneration.notify_all();
+        recycleNode(handle.index, node);
 
         enqueueExecutionBatch(readyJobs.data(), readyJobs.size());
 
@@ -446,10 +593,10 @@ private:
     ThreadPool& m_pool;
 
     PersistentArena m_arena;
-    JobNodeList m_nodes;
-    JobFreeNodeList m_freeNodes;
+    Futex m_growMutex;
+    JobNodePool m_nodes;
+    DependentLinkPool m_links;
 
-    mutable Futex m_mutex;
     Atomic<usize> m_pendingJobCount{ 0 };
 };
 
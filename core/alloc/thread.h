@@ -157,6 +157,23 @@ private:
 
 public:
     inline explicit ThreadPool(u32 threadCount, u64 affinityMask = 0, usize arenaSize = 0)
+        : ThreadPool(threadCount, affinityMask, CpuPinning::None, arenaSize)
+    {}
+    inline explicit ThreadPool(u32 threadCount, CpuAffinity::Enum affinity, usize arenaSize = 0)
+        : ThreadPool(threadCount, QueryCpuAffinityMask(affinity), arenaSize)
+    {}
+    // Pins every worker by its logical worker index; see CpuPinningMask. The calling thread is left where it is.
+    inline explicit ThreadPool(u32 threadCount, CpuPinning::Enum pinning, usize arenaSize = 0)
+        : ThreadPool(threadCount, 0, pinning, arenaSize)
+    {}
+
+    inline ~ThreadPool(){
+        waitPending();
+    }
+
+
+private:
+    inline ThreadPool(u32 threadCount, u64 affinityMask, CpuPinning::Enum pinning, usize arenaSize)
         : m_arena(ArenaScope::s_ThreadPool, arenaSize > 0 ? arenaSize : defaultArenaSize(threadCount))
         , m_tasks(TaskQueue::allocator_type(m_arena))
         , m_threadCount(threadCount)
@@ -164,18 +181,16 @@ public:
     {
         m_workers.reserve(threadCount);
         for(u32 i = 0; i < threadCount; ++i){
-            m_workers.emplace_back([this, affinityMask, workerIndex = static_cast<usize>(i) + 1u](const StopToken& stopToken){
-                workerLoop(stopToken, affinityMask, workerIndex);
+            const usize workerIndex = static_cast<usize>(i) + 1u;
+            const u64 workerMask = pinning == CpuPinning::None
+                ? affinityMask
+                : CpuPinningMask(QueryCpuTopology(), pinning, workerIndex)
+            ;
+            m_workers.emplace_back([this, workerMask, workerIndex](const StopToken& stopToken){
+                workerLoop(stopToken, workerMask, workerIndex);
             });
         }
     }
-    inline explicit ThreadPool(u32 threadCount, CpuAffinity::Enum affinity, usize arenaSize = 0)
-        : ThreadPool(threadCount, QueryCpuAffinityMask(affinity), arenaSize)
-    {}
-
-    inline ~ThreadPool(){
-        waitPending();
-    }
 
 
 public:
@@ -255,6 +270,54 @@ public:
         runParallelForChunks(begin, end, count, computeChunkCount(maxChunks, totalThreads), func);
     }
 
+    // Runs `func` over [begin, end) on the calling thread plus at most `maxParallelism - 1` queued helper tasks. Unlike
+    // parallelFor it does not take the pool's single parallel-for slot, so independent callers, including tasks already
+    // running on this pool, fan out side by side. While its helpers are still queued the caller runs queued pool tasks
+    // itself, so callers occupying every worker cannot starve their own helpers.
+    template<typename Func>
+    inline void boundedParallelFor(usize begin, usize end, usize grainSize, usize maxParallelism, const Func& func){
+        if(begin >= end)
+            return;
+
+        const usize effectiveGrainSize = grainSize > 0 ? grainSize : 1;
+        const usize chunkCount = DivideUp(end - begin, effectiveGrainSize);
+        const usize helperLimit = maxParallelism > 1 ? Min(maxParallelism - 1, static_cast<usize>(m_threadCount)) : 0;
+        const usize helperCount = Min(helperLimit, chunkCount - 1);
+        if(helperCount == 0){
+            runSerialRange(begin, end, func);
+            return;
+        }
+
+        Atomic<usize> nextChunk{ 0 };
+        Atomic<usize> remainingHelpers{ helperCount };
+        const auto runChunks = [&](){
+            for(;;){
+                const usize chunk = nextChunk.fetch_add(1, MemoryOrder::relaxed);
+                if(chunk >= chunkCount)
+                    return;
+
+                const usize chunkBegin = begin + chunk * effectiveGrainSize;
+                runSerialRange(chunkBegin, Min(chunkBegin + effectiveGrainSize, end), func);
+            }
+        };
+        enqueueBatch(helperCount, [&](usize){
+            return [&runChunks, &remainingHelpers](){
+                runChunks();
+                if(remainingHelpers.fetch_sub(1, MemoryOrder::acq_rel) == 1)
+                    remainingHelpers.notify_all();
+            };
+        });
+        runChunks();
+
+        // Helpers were queued before this loop, so once the queue runs dry every one of them is already running.
+        usize current = remainingHelpers.load(MemoryOrder::acquire);
+        while(current > 0){
+            if(!runQueuedTask())
+                remainingHelpers.wait(current, MemoryOrder::relaxed);
+            current = remainingHelpers.load(MemoryOrder::acquire);
+        }
+    }
+
 public:
     inline void wait(){ waitPending(); }
 
@@ -277,6 +340,24 @@ private:
         }
     }
 
+    inline bool runQueuedTask(){
+        TaskItem item;
+        {
+            ScopedLock taskLock(m_taskMutex);
+            if(m_tasks.empty())
+                return false;
+
+            item = Move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        item.func();
+
+        if(m_pendingCount.fetch_sub(1, MemoryOrder::acq_rel) == 1)
+            m_pendingCount.notify_all();
+        return true;
+    }
+
     inline bool hasParallelWork()const{
         ParallelForDesc* pf = m_pfWork.load(MemoryOrder::acquire);
         return pf && pf->nextChunk.load(MemoryOrder::relaxed) < pf->numChunks;
@@ -50,11 +50,25 @@ class ICookedAssetWriter;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// Everything the volume cooker's input cache needs to know about one parsed .nwb: which entries it declared, which
+// other files the parsers read for it, and whether its cooked output depends on state outside those files.
+struct CookEntrySourceRecord{
+    CookVector<NameHash> virtualPathHashes;
+    CookVector<Path> inputDependencies;
+    bool inputCacheable = true;
+
+    explicit CookEntrySourceRecord(CookArena& arena)
+        : virtualPathHashes(arena)
+        , inputDependencies(arena)
+    {}
+};
+
 struct CookEntryParseContext{
     CookArena& cookArena;
     Core::Alloc::ThreadPool& threadPool;
     ScratchArena& scratchArena;
     CookEntryPathHashSet& seenVirtualPathHashes;
+    CookEntrySourceRecord* source = nullptr;
 };
 
 struct CookEntryWriteContext{
@@ -63,6 +77,12 @@ struct CookEntryWriteContext{
 };
 
 
+inline void RecordCookInputDependency(CookEntryParseContext& context, const Path& dependencyPath){
+    if(context.source)
+        context.source->inputDependencies.push_back(dependencyPath);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -222,7 +242,8 @@ public:
         DocumentParseFunction parseDocument,
         ValueParseFunction parseValue,
         BuildAssetFunction buildAsset,
-        const bool logBuildFailure
+        const bool logBuildFailure,
+        const bool inputCacheable
     )
         : m_entries(arena)
         , m_assetType(assetType)
@@ -231,6 +252,7 @@ public:
         , m_parseValue(parseValue)
         , m_buildAsset(buildAsset)
         , m_logBuildFailure(logBuildFailure)
+        , m_inputCacheable(inputCacheable)
     {}
 
 public:
@@ -330,6 +352,11 @@ private:
         ))
             return false;
 
+        if(context.source){
+            context.source->virtualPathHashes.push_back(CookEntryRegistryDetail::ToCookEntryName(entry.virtualPath).hash());
+            if(!m_inputCacheable)
+                context.source->inputCacheable = false;
+        }
         m_entries.push_back(Move(entry));
         return true;
     }
@@ -342,6 +369,7 @@ private:
     ValueParseFunction m_parseValue = nullptr;
     BuildAssetFunction m_buildAsset = nullptr;
     bool m_logBuildFailure = true;
+    bool m_inputCacheable = true;
 };
 
 
@@ -369,7 +397,8 @@ public:
         typename CookEntryBucket<EntryT, AssetT, CodecT>::DocumentParseFunction parseDocument,
         typename CookEntryBucket<EntryT, AssetT, CodecT>::ValueParseFunction parseValue,
         typename CookEntryBucket<EntryT, AssetT, CodecT>::BuildAssetFunction buildAsset,
-        const bool logBuildFailure = true
+        const bool logBuildFailure = true,
+        const bool inputCacheable = true
     ){
         if(!assetType){
             NWB_LOGGER_ERROR(NWB_TEXT("AssetCook: tried to register an unnamed cook entry type"));
@@ -389,7 +418,8 @@ public:
             parseDocument,
             parseValue,
             buildAsset,
-            logBuildFailure
+            logBuildFailure,
+            inputCacheable
         );
         ICookEntryBucket* bucketPtr = bucket.get();
         if(!m_lookup.emplace(assetType, bucketPtr).second){
@@ -13,6 +13,7 @@
 
 #include <core/common/log.h>
 #include <global/auto_registration.h>
+#include <global/timer.h>
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +36,9 @@ struct AutoMetadataParser{
     AssetValueMetadataParseFunction valueFunction = nullptr;
 };
 
+static constexpr usize s_DocumentBatchSize = 512u;
+
+
 ::AutoRegistrationQueue<AutoMetadataParser, AssetArena>& QueryAutoMetadataParserQueue(){
     static ::AutoRegistrationQueue<AutoMetadataParser, AssetArena> queue(AssetsArenaScope::s_MetadataParserQueueArena);
     return queue;
@@ -45,9 +49,25 @@ struct AutoMetadataParser{
     return queue;
 }
 
-[[nodiscard]] static bool ParseMetascriptDocument(CookArena& cookArena, const Path& nwbFilePath, Core::Metascript::Document& outDoc){
+[[nodiscard]] static bool LoadMetascriptDocument(
+    CookArena& cookArena,
+    AssetMetadataCache& metadataCache,
+    const usize fileIndex,
+    const DiscoveredNwbFile& discoveredNwbFile,
+    Core::Metascript::Document& outDoc
+){
+    const Path& nwbFilePath = discoveredNwbFile.filePath;
     CookString metaText{cookArena};
-    if(!ReadTextFile(nwbFilePath, metaText)){
+    const AssetMetadataCacheLookup::Enum lookup = metadataCache.restore(
+        fileIndex,
+        AStringView(discoveredNwbFile.normalizedPathText),
+        nwbFilePath,
+        outDoc,
+        metaText
+    );
+    if(lookup == AssetMetadataCacheLookup::Restored)
+        return true;
+    if(lookup == AssetMetadataCacheLookup::SourceUnread && !ReadTextFile(nwbFilePath, metaText)){
         NWB_LOGGER_ERROR(NWB_TEXT("AssetCook: failed to read meta '{}'"), PathToString<tchar>(nwbFilePath));
         return false;
     }
@@ -64,6 +84,8 @@ struct AutoMetadataParser{
         }
         return false;
     }
+
+    metadataCache.record(fileIndex, outDoc);
     return true;
 }
 
@@ -75,6 +97,7 @@ struct AutoMetadataParser{
     const Core::Metascript::Value& asset,
     ParsedAssetMetadata& outMetadata,
     CookEntryPathHashSet& seenPropertyAssetPathHashes,
+    CookEntrySourceRecord& source,
     Core::Alloc::ThreadPool& threadPool,
     ScratchArena& scratchArena
 ){
@@ -88,8 +111,10 @@ struct AutoMetadataParser{
         scratchArena
     };
     const AssetMetadataParseResult::Enum metadataParseResult = TryAutoCollectedValueMetadataParsers(metadataParseContext);
-    if(metadataParseResult == AssetMetadataParseResult::Parsed)
+    if(metadataParseResult == AssetMetadataParseResult::Parsed){
+        source.inputCacheable = false;
         return true;
+    }
     if(metadataParseResult == AssetMetadataParseResult::Error)
         return false;
 
@@ -97,7 +122,8 @@ struct AutoMetadataParser{
         cookArena,
         threadPool,
         scratchArena,
-        seenPropertyAssetPathHashes
+        seenPropertyAssetPathHashes,
+        &source
     };
     return outMetadata.entryRegistry.parseValue(
         assetType,
@@ -114,6 +140,7 @@ struct AutoMetadataParser{
     const Core::Metascript::Document& doc,
     ParsedAssetMetadata& outMetadata,
     CookEntryPathHashSet& seenPropertyAssetPathHashes,
+    CookEntrySourceRecord& source,
     Core::Alloc::ThreadPool& threadPool,
     ScratchArena& scratchArena
 ){
@@ -128,8 +155,10 @@ struct AutoMetadataParser{
         scratchArena
     };
     const AssetMetadataParseResult::Enum metadataParseResult = TryAutoCollectedDocumentMetadataParsers(metadataParseContext);
-    if(metadataParseResult == AssetMetadataParseResult::Parsed)
+    if(metadataParseResult == AssetMetadataParseResult::Parsed){
+        source.inputCacheable = false;
         return true;
+    }
     if(metadataParseResult == AssetMetadataParseResult::Error)
         return false;
 
@@ -138,7 +167,8 @@ struct AutoMetadataParser{
             cookArena,
             threadPool,
             scratchArena,
-            seenPropertyAssetPathHashes
+            seenPropertyAssetPathHashes,
+            &source
         };
         return outMetadata.entryRegistry.parseDocument(
             assetType,
@@ -339,10 +369,12 @@ AssetBunchExpandResult::Enum TryAutoCollectedAssetBunchExpanders(AssetBunchExpan
 bool ParseAssetMetadata(
     CookArena& cookArena,
     const DiscoveredNwbFileVector& nwbFiles,
+    const Path& metadataCacheDirectory,
     ParsedAssetMetadata& outMetadata,
     Core::Alloc::ThreadPool& threadPool,
     ScratchArena& scratchArena
 ){
+    const Timer parseBegin = TimerNow();
     outMetadata.entryRegistry.reserveEntries(nwbFiles.size());
     CookEntryPathHashSet seenPropertyAssetPathHashes(
         0,
@@ -352,70 +384,116 @@ bool ParseAssetMetadata(
     );
 
     seenPropertyAssetPathHashes.reserve(nwbFiles.size());
+    outMetadata.sources.reserve(outMetadata.sources.size() + nwbFiles.size());
+
+    AssetMetadataCache metadataCache(cookArena, metadataCacheDirectory, nwbFiles.size());
+    metadataCache.load();
+
+    // Documents are restored or parsed a batch at a time on the pool, then handed to the entry parsers in file order;
+    // the registry and the metadata parsers are not thread safe. Batching bounds how many parsed documents are alive.
+    const usize batchSize = Min(nwbFiles.size(), __hidden_cook_metadata::s_DocumentBatchSize);
+    CookVector<Core::Metascript::Document> documents(cookArena);
+    documents.reserve(batchSize);
+    for(usize documentIndex = 0u; documentIndex < batchSize; ++documentIndex)
+        documents.emplace_back(cookArena);
 
     bool parsedAnyMetadata = false;
-    for(const DiscoveredNwbFile& discoveredNwbFile : nwbFiles){
-        Core::Metascript::Document doc(cookArena);
-        if(!__hidden_cook_metadata::ParseMetascriptDocument(cookArena, discoveredNwbFile.filePath, doc))
+    for(usize batchBegin = 0u; batchBegin < nwbFiles.size(); batchBegin += batchSize){
+        const usize batchEnd = Min(batchBegin + batchSize, nwbFiles.size());
+
+        Atomic<bool> failed{ false };
+        threadPool.parallelFor(batchBegin, batchEnd, [&](const usize fileIndex){
+            if(!__hidden_cook_metadata::LoadMetascriptDocument(
+                cookArena,
+                metadataCache,
+                fileIndex,
+                nwbFiles[fileIndex],
+                documents[fileIndex - batchBegin]
+            ))
+                failed.store(true, MemoryOrder::release);
+        });
+        if(failed.load(MemoryOrder::acquire))
             return false;
 
-        ExpandedAssetMetadataVector expandedAssets(scratchArena);
-        AssetBunchExpandContext assetBunchExpandContext{
-            discoveredNwbFile.assetRoot,
-            discoveredNwbFile.virtualRoot.view(),
-            discoveredNwbFile.filePath,
-            doc,
-            expandedAssets,
-            scratchArena
-        };
-        const AssetBunchExpandResult::Enum assetBunchResult = TryAutoCollectedAssetBunchExpanders(assetBunchExpandContext);
-        if(assetBunchResult == AssetBunchExpandResult::Error)
-            return false;
-        if(assetBunchResult == AssetBunchExpandResult::Parsed){
-            for(const ExpandedAssetMetadata& expandedAsset : expandedAssets){
-                if(!expandedAsset.value){
-                    NWB_LOGGER_ERROR(NWB_TEXT("AssetCook: asset_bunch meta '{}' expanded a null asset value")
-                        , PathToString<tchar>(discoveredNwbFile.filePath)
-                    );
-                    return false;
+        for(usize fileIndex = batchBegin; fileIndex < batchEnd; ++fileIndex){
+            const DiscoveredNwbFile& discoveredNwbFile = nwbFiles[fileIndex];
+            const Core::Metascript::Document& doc = documents[fileIndex - batchBegin];
+            CookEntrySourceRecord& source = outMetadata.sources.emplace_back(cookArena);
+
+            ExpandedAssetMetadataVector expandedAssets(scratchArena);
+            AssetBunchExpandContext assetBunchExpandContext{
+                discoveredNwbFile.assetRoot,
+                discoveredNwbFile.virtualRoot.view(),
+                discoveredNwbFile.filePath,
+                doc,
+                expandedAssets,
+                scratchArena
+            };
+            const AssetBunchExpandResult::Enum assetBunchResult = TryAutoCollectedAssetBunchExpanders(assetBunchExpandContext);
+            if(assetBunchResult == AssetBunchExpandResult::Error)
+                return false;
+            if(assetBunchResult == AssetBunchExpandResult::Parsed){
+                for(const ExpandedAssetMetadata& expandedAsset : expandedAssets){
+                    if(!expandedAsset.value){
+                        NWB_LOGGER_ERROR(NWB_TEXT("AssetCook: asset_bunch meta '{}' expanded a null asset value")
+                            , PathToString<tchar>(discoveredNwbFile.filePath)
+                        );
+                        return false;
+                    }
+                    if(!__hidden_cook_metadata::ParseDeclaredAssetItem(
+                        cookArena,
+                        discoveredNwbFile,
+                        expandedAsset.assetType,
+                        expandedAsset.virtualPath,
+                        *expandedAsset.value,
+                        outMetadata,
+                        seenPropertyAssetPathHashes,
+                        source,
+                        threadPool,
+                        scratchArena
+                    ))
+                        return false;
+                    parsedAnyMetadata = true;
                 }
-                if(!__hidden_cook_metadata::ParseDeclaredAssetItem(
-                    cookArena,
-                    discoveredNwbFile,
-                    expandedAsset.assetType,
-                    expandedAsset.virtualPath,
-                    *expandedAsset.value,
-                    outMetadata,
-                    seenPropertyAssetPathHashes,
-                    threadPool,
-                    scratchArena
-                ))
-                    return false;
-                parsedAnyMetadata = true;
+                continue;
             }
-            continue;
-        }
 
-        if(doc.declarations().size() > 1u){
-            NWB_LOGGER_ERROR(NWB_TEXT("AssetCook: meta '{}' declares multiple asset objects without an asset_bunch object")
-                , PathToString<tchar>(discoveredNwbFile.filePath)
-            );
-            return false;
-        }
+            if(doc.declarations().size() > 1u){
+                NWB_LOGGER_ERROR(NWB_TEXT("AssetCook: meta '{}' declares multiple asset objects without an asset_bunch object")
+                    , PathToString<tchar>(discoveredNwbFile.filePath)
+                );
+                return false;
+            }
 
-        if(!__hidden_cook_metadata::ParseSingleAssetDocument(
-            cookArena,
-            discoveredNwbFile,
-            doc,
-            outMetadata,
-            seenPropertyAssetPathHashes,
-            threadPool,
-            scratchArena
-        ))
-            return false;
-        parsedAnyMetadata = true;
+            if(!__hidden_cook_metadata::ParseSingleAssetDocument(
+                cookArena,
+                discoveredNwbFile,
+                doc,
+                outMetadata,
+                seenPropertyAssetPathHashes,
+                source,
+                threadPool,
+                scratchArena
+            ))
+                return false;
+            parsedAnyMetadata = true;
+        }
     }
 
+    if(!metadataCache.store())
+        return false;
+
+    const AssetMetadataCacheStats cacheStats = metadataCache.stats();
+    outMetadata.metadataCacheStats.hitCount += cacheStats.hitCount;
+    outMetadata.metadataCacheStats.missCount += cacheStats.missCount;
+    NWB_LOGGER_INFO(NWB_TEXT("AssetCook: loaded metadata for {} files in {:.2f} ms - cache hits {} misses {} ({:.1f}% hit rate)")
+        , nwbFiles.size()
+        , DurationInSeconds<f64>(TimerNow(), parseBegin) * 1000.0
+        , cacheStats.hitCount
+        , cacheStats.missCount
+        , nwbFiles.empty() ? 0.0 : static_cast<f64>(cacheStats.hitCount) * 100.0 / static_cast<f64>(nwbFiles.size())
+    );
+
     if(!parsedAnyMetadata){
         NWB_LOGGER_ERROR(NWB_TEXT("AssetCook: no asset metadata found in asset roots"));
         return false;
@@ -12,6 +12,7 @@
 
 
 #include "cook_entry_registry.h"
+#include "cook_metadata_cache.h"
 
 #include <core/assets/paths.h>
 
@@ -66,11 +67,14 @@ struct ParsedAssetMetadata{
     CookArena& arena;
     CookEntryRegistry entryRegistry;
     ParsedMetadataExtensionMap extensions;
+    CookVector<CookEntrySourceRecord> sources; // one per parsed .nwb, in the order ParseAssetMetadata received them
+    AssetMetadataCacheStats metadataCacheStats;
 
     explicit ParsedAssetMetadata(CookArena& arena)
         : arena(arena)
         , entryRegistry(arena)
         , extensions(0, Hasher<Name>(), EqualTo<Name>(), arena)
+        , sources(arena)
     {}
 };
 
@@ -188,9 +192,12 @@ public:
 [[nodiscard]] AssetMetadataParseResult::Enum TryAutoCollectedDocumentMetadataParsers(AssetDocumentMetadataParseContext& context);
 [[nodiscard]] AssetMetadataParseResult::Enum TryAutoCollectedValueMetadataParsers(AssetValueMetadataParseContext& context);
 [[nodiscard]] AssetBunchExpandResult::Enum TryAutoCollectedAssetBunchExpanders(AssetBunchExpandContext& context);
+// Documents come from the metadata cache under `metadataCacheDirectory` when their file is unchanged and are parsed on
+// the thread pool otherwise; an empty directory parses everything. Entry parsers still see them in `nwbFiles` order.
 [[nodiscard]] bool ParseAssetMetadata(
     CookArena& cookArena,
     const DiscoveredNwbFileVector& nwbFiles,
+    const Path& metadataCacheDirectory,
     ParsedAssetMetadata& outMetadata,
     Core::Alloc::ThreadPool& threadPool,
     ScratchArena& scratchArena
@@ -0,0 +1,341 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_COOK)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "cook_metadata_cache.h"
+
+#include <core/common/log.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_cook_metadata_cache{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static constexpr u32 s_SnapshotMagic = 0x4D424E57; // WNBM
+static constexpr u16 s_SnapshotVersion = 2u;
+// Bump when the metascript parser starts producing different documents from unchanged sources.
+static constexpr u32 s_ParserVersion = 1u;
+static constexpr char s_SnapshotDirectoryName[] = "metadata";
+static constexpr char s_SnapshotFileName[] = "documents.nwbmeta";
+static constexpr char s_SnapshotStagingFileName[] = "documents.nwbmeta.tmp";
+
+struct SnapshotHeader{
+    u32 magic = s_SnapshotMagic;
+    u16 version = s_SnapshotVersion;
+    u16 headerSize = sizeof(SnapshotHeader);
+    u32 parserVersion = s_ParserVersion;
+    u32 recordCount = 0u;
+};
+
+
+[[nodiscard]] static bool ReadByteView(const CookVector<u8>& bytes, usize& inOutCursor, BinaryByteView& outView){
+    u32 byteCount = 0u;
+    usize cursor = inOutCursor;
+    if(!ReadPOD(bytes, cursor, byteCount) || !BinaryDetail::CanReadBytes(bytes, cursor, byteCount))
+        return false;
+
+    outView = BinaryByteView{ bytes.data() + cursor, byteCount };
+    inOutCursor = cursor + byteCount;
+    return true;
+}
+
+[[nodiscard]] static bool AppendRecord(
+    CookVector<u8>& outBytes,
+    const AStringView pathText,
+    const AStringView filePathText,
+    const FileStamp& stamp,
+    const u64 contentHash,
+    const u8* document,
+    const usize documentBytes
+){
+    if(documentBytes > Limit<u32>::s_Max)
+        return false;
+    if(!AppendString(outBytes, pathText) || !AppendString(outBytes, filePathText))
+        return false;
+
+    AppendPOD(outBytes, stamp.size);
+    AppendPOD(outBytes, stamp.lastWriteTime);
+    AppendPOD(outBytes, contentHash);
+    AppendPOD(outBytes, static_cast<u32>(documentBytes));
+    BinaryDetail::AppendBytesUnchecked(outBytes, document, documentBytes);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+AssetMetadataCache::AssetMetadataCache(CookArena& arena, const Path& cacheDirectory, const usize fileCount)
+    : m_arena(arena)
+    , m_snapshotPath(arena)
+    , m_snapshotBytes(arena)
+    , m_storedRecords(arena)
+    , m_storedLookup(0, Hasher<u64>(), EqualTo<u64>(), arena)
+    , m_slots(arena)
+{
+    if(!cacheDirectory.empty())
+        m_snapshotPath = cacheDirectory / __hidden_cook_metadata_cache::s_SnapshotDirectoryName / __hidden_cook_metadata_cache::s_SnapshotFileName;
+
+    m_slots.reserve(fileCount);
+    for(usize fileIndex = 0u; fileIndex < fileCount; ++fileIndex)
+        m_slots.emplace_back(arena);
+}
+
+AssetMetadataCacheStats AssetMetadataCache::stats()const{
+    AssetMetadataCacheStats stats;
+    for(const Slot& slot : m_slots){
+        if(slot.state == AssetMetadataCacheSlotState::Hit || slot.state == AssetMetadataCacheSlotState::Refreshed)
+            ++stats.hitCount;
+        else
+            ++stats.missCount;
+    }
+    return stats;
+}
+
+void AssetMetadataCache::load(){
+    if(!enabled())
+        return;
+
+    // A missing, foreign or damaged snapshot is an empty one; the next store() replaces it.
+    ErrorCode errorCode;
+    if(!ReadBinaryFile(m_snapshotPath, m_snapshotBytes, errorCode) || !parseSnapshot()){
+        m_snapshotBytes.clear();
+        m_storedRecords.clear();
+        m_storedLookup.clear();
+    }
+}
+
+bool AssetMetadataCache::parseSnapshot(){
+    usize cursor = 0u;
+    __hidden_cook_metadata_cache::SnapshotHeader header;
+    if(!ReadPOD(m_snapshotBytes, cursor, header))
+        return false;
+    if(
+        header.magic != __hidden_cook_metadata_cache::s_SnapshotMagic
+        || header.version != __hidden_cook_metadata_cache::s_SnapshotVersion
+        || header.headerSize != sizeof(__hidden_cook_metadata_cache::SnapshotHeader)
+        || header.parserVersion != __hidden_cook_metadata_cache::s_ParserVersion
+    )
+        return false;
+
+    m_storedRecords.reserve(header.recordCount);
+    m_storedLookup.reserve(header.recordCount);
+    for(u32 recordIndex = 0u; recordIndex < header.recordCount; ++recordIndex){
+        StoredRecord record;
+        if(
+            !BinaryDetail::ReadLengthPrefixedString(m_snapshotBytes, cursor, record.pathText)
+            || !BinaryDetail::ReadLengthPrefixedString(m_snapshotBytes, cursor, record.filePathText)
+            || !ReadPOD(m_snapshotBytes, cursor, record.stamp.size)
+            || !ReadPOD(m_snapshotBytes, cursor, record.stamp.lastWriteTime)
+            || !ReadPOD(m_snapshotBytes, cursor, record.contentHash)
+            || !__hidden_cook_metadata_cache::ReadByteView(m_snapshotBytes, cursor, record.document)
+        )
+            return false;
+
+        if(m_storedLookup.emplace(ComputeFnv64Text(record.pathText), m_storedRecords.size()).second)
+            m_storedRecords.push_back(record);
+    }
+    return cursor == m_snapshotBytes.size();
+}
+
+AssetMetadataCacheLookup::Enum AssetMetadataCache::restore(
+    const usize fileIndex,
+    const AStringView normalizedPathText,
+    const Path& filePath,
+    Core::Metascript::Document& outDoc,
+    CookString& outSourceText
+){
+    NWB_ASSERT(fileIndex < m_slots.size());
+    Slot& slot = m_slots[fileIndex];
+    slot.pathText = normalizedPathText;
+    slot.filePath = &filePath;
+    if(!enabled())
+        return AssetMetadataCacheLookup::SourceUnread;
+
+    const auto found = m_storedLookup.find(ComputeFnv64Text(normalizedPathText));
+    if(found != m_storedLookup.end() && m_storedRecords[found.value()].pathText == normalizedPathText)
+        slot.stored = &m_storedRecords[found.value()];
+
+    ErrorCode errorCode;
+    if(!QueryFileStamp(filePath, slot.stamp, errorCode))
+        return AssetMetadataCacheLookup::SourceUnread;
+
+    if(slot.stored && slot.stored->stamp == slot.stamp){
+        if(outDoc.readSnapshot(slot.stored->document.data(), slot.stored->document.size())){
+            slot.contentHash = slot.stored->contentHash;
+            slot.state = AssetMetadataCacheSlotState::Hit;
+            return AssetMetadataCacheLookup::Restored;
+        }
+    }
+
+    if(!ReadTextFile(filePath, outSourceText))
+        return AssetMetadataCacheLookup::SourceUnread;
+
+    slot.contentHash = ComputeWyHash64(outSourceText.data(), outSourceText.size());
+    slot.state = AssetMetadataCacheSlotState::Hashed;
+    if(slot.stored && slot.stored->stamp.size == outSourceText.size() && slot.stored->contentHash == slot.contentHash){
+        if(outDoc.readSnapshot(slot.stored->document.data(), slot.stored->document.size())){
+            slot.state = AssetMetadataCacheSlotState::Refreshed;
+            return AssetMetadataCacheLookup::Restored;
+        }
+    }
+    return AssetMetadataCacheLookup::SourceRead;
+}
+
+void AssetMetadataCache::record(const usize fileIndex, const Core::Metascript::Document& doc){
+    NWB_ASSERT(fileIndex < m_slots.size());
+    Slot& slot = m_slots[fileIndex];
+    if(slot.state != AssetMetadataCacheSlotState::Hashed)
+        return;
+
+    if(doc.writeSnapshot(slot.document))
+        slot.state = AssetMetadataCacheSlotState::Recorded;
+    else
+        slot.document.clear();
+}
+
+bool AssetMetadataCache::store(){
+    if(!enabled())
+        return true;
+
+    CookVector<u8> claimed(m_arena);
+    claimed.resize(m_storedRecords.size(), 0u);
+
+    bool changed = false;
+    u32 recordCount = 0u;
+    for(const Slot& slot : m_slots){
+        if(slot.stored)
+            claimed[static_cast<usize>(slot.stored - m_storedRecords.data())] = 1u;
+        if(slot.state != AssetMetadataCacheSlotState::Hit)
+            changed = true;
+        if(slot.state == AssetMetadataCacheSlotState::Hit || slot.state == AssetMetadataCacheSlotState::Refreshed || slot.state == AssetMetadataCacheSlotState::Recorded)
+            ++recordCount;
+    }
+
+    // Records of files outside this cook's list stay for the next cook that parses them, unless the file is gone.
+    CookVector<usize> keptRecords(m_arena);
+    for(usize recordIndex = 0u; recordIndex < m_storedRecords.size(); ++recordIndex){
+        if(claimed[recordIndex])
+            continue;
+        if(!PathIsRegularFile(Path(m_arena, m_storedRecords[recordIndex].filePathText))){
+            changed = true;
+            continue;
+        }
+        keptRecords.push_back(recordIndex);
+        ++recordCount;
+    }
+    if(!changed)
+        return true;
+
+    __hidden_cook_metadata_cache::SnapshotHeader header;
+    header.recordCount = recordCount;
+
+    CookVector<u8> snapshotBytes(m_arena);
+    snapshotBytes.reserve(m_snapshotBytes.size());
+    AppendPOD(snapshotBytes, header);
+    for(const Slot& slot : m_slots){
+        const u8* document = nullptr;
+        usize documentBytes = 0u;
+        switch(slot.state){
+        case AssetMetadataCacheSlotState::Hit:
+        case AssetMetadataCacheSlotState::Refreshed:
+            document = slot.stored->document.data();
+            documentBytes = slot.stored->document.size();
+            break;
+        case AssetMetadataCacheSlotState::Recorded:
+            document = slot.document.data();
+            documentBytes = slot.document.size();
+            break;
+        default:
+            continue;
+        }
+
+        const CookString filePathText = PathToString(m_arena, *slot.filePath);
+        if(!__hidden_cook_metadata_cache::AppendRecord(
+            snapshotBytes,
+            slot.pathText,
+            AStringView(filePathText),
+            slot.stamp,
+            slot.contentHash,
+            document,
+            documentBytes
+        ))
+            return false;
+    }
+    for(const usize recordIndex : keptRecords){
+        const StoredRecord& record = m_storedRecords[recordIndex];
+        if(!__hidden_cook_metadata_cache::AppendRecord(
+            snapshotBytes,
+            record.pathText,
+            record.filePathText,
+            record.stamp,
+            record.contentHash,
+            record.document.data(),
+            record.document.size()
+        ))
+            return false;
+    }
+
+    // Written beside the live snapshot and renamed over it, so a cook that dies mid-write leaves the old one intact.
+    const Path snapshotDirectory = m_snapshotPath.parent_path();
+    const Path stagingPath = snapshotDirectory / __hidden_cook_metadata_cache::s_SnapshotStagingFileName;
+    ErrorCode errorCode;
+    if(!EnsureDirectories(snapshotDirectory, errorCode)){
+        NWB_LOGGER_ERROR(NWB_TEXT("AssetCook: failed to create metadata cache directory '{}': {}")
+            , PathToString<tchar>(snapshotDirectory)
+            , StringConvert(errorCode.message())
+        );
+        return false;
+    }
+    if(!WriteBinaryFile(stagingPath, snapshotBytes)){
+        NWB_LOGGER_ERROR(NWB_TEXT("AssetCook: failed to write metadata cache '{}'"), PathToString<tchar>(stagingPath));
+        return false;
+    }
+    if(!RenamePath(stagingPath, m_snapshotPath, errorCode)){
+        NWB_LOGGER_ERROR(NWB_TEXT("AssetCook: failed to replace metadata cache '{}': {}")
+            , PathToString<tchar>(m_snapshotPath)
+            , StringConvert(errorCode.message())
+        );
+        return false;
+    }
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
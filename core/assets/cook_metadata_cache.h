@@ -0,0 +1,134 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_COOK)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "cook_entry_registry.h"
+
+#include <global/binary.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+struct AssetMetadataCacheStats{
+    u64 hitCount = 0u;
+    u64 missCount = 0u;
+};
+
+namespace AssetMetadataCacheLookup{
+enum Enum : u8{
+    Restored,
+    SourceRead,
+    SourceUnread
+};
+};
+
+namespace AssetMetadataCacheSlotState{
+enum Enum : u8{
+    Pending,
+    Hit,
+    Refreshed,
+    Hashed,
+    Recorded
+};
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Snapshot of parsed .nwb documents, kept in one file under the cook cache directory so the next cook restores
+// unchanged documents without lexing or parsing them. Records are keyed by normalized path and reused while the
+// file's size and write time match; when only the write time moved (a checkout, a touch) the file is read and its
+// content hash decides.
+//
+// The cache works on a fixed list of files. restore() and record() may run concurrently for different file indices;
+// load() and store() run alone. An empty cache directory disables it and every lookup misses.
+class AssetMetadataCache : NoCopy{
+private:
+    struct StoredRecord{
+        AStringView pathText;
+        AStringView filePathText;
+        FileStamp stamp;
+        u64 contentHash = 0u;
+        BinaryByteView document;
+    };
+
+    struct Slot{
+        AStringView pathText;
+        const Path* filePath = nullptr;
+        const StoredRecord* stored = nullptr;
+        FileStamp stamp;
+        u64 contentHash = 0u;
+        CookVector<u8> document;
+        AssetMetadataCacheSlotState::Enum state = AssetMetadataCacheSlotState::Pending;
+
+        explicit Slot(CookArena& arena)
+            : document(arena)
+        {}
+    };
+
+
+public:
+    AssetMetadataCache(CookArena& arena, const Path& cacheDirectory, usize fileCount);
+
+
+public:
+    [[nodiscard]] bool enabled()const{ return !m_snapshotPath.empty(); }
+    [[nodiscard]] AssetMetadataCacheStats stats()const;
+
+    void load();
+    [[nodiscard]] AssetMetadataCacheLookup::Enum restore(
+        usize fileIndex,
+        AStringView normalizedPathText,
+        const Path& filePath,
+        Core::Metascript::Document& outDoc,
+        CookString& outSourceText
+    );
+    void record(usize fileIndex, const Core::Metascript::Document& doc);
+    [[nodiscard]] bool store();
+
+
+private:
+    [[nodiscard]] bool parseSnapshot();
+
+
+private:
+    CookArena& m_arena;
+    Path m_snapshotPath;
+    CookVector<u8> m_snapshotBytes;
+    CookVector<StoredRecord> m_storedRecords;
+    CookMap<u64, usize> m_storedLookup;
+    CookVector<Slot> m_slots;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -17,6 +17,9 @@ NWB_ASSETS_BEGIN
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// Compiler processes a shader cook may keep in flight. 0 runs one per cook thread, including the caller.
+inline constexpr u32 s_DefaultMaxConcurrentShaderCompiles = 0u;
+
 struct AssetCookServices{
     Alloc::ThreadPool& threadPool;
 
@@ -46,6 +49,7 @@ struct AssetCookOptions{
     AssetString cacheDirectory;
     ACompactString configuration;
     ACompactString assetType;
+    u32 maxConcurrentShaderCompiles = s_DefaultMaxConcurrentShaderCompiles;
     AssetCookServices services;
 
     explicit AssetCookOptions(AssetArena& arena, Alloc::ThreadPool& threadPool)
@@ -100,12 +100,21 @@ u64 AssetManager::enqueueLoad(const Name& assetType, const Name& virtualPath){
 
 
 void AssetManager::processPending(){
+    processPending(Limit<usize>::s_Max);
+}
+
+void AssetManager::processPending(const usize maxRequestCount){
+    if(maxRequestCount == 0)
+        return;
+
     Alloc::ScratchArena scratchArena(AssetsArenaScope::s_ProcessPendingScratch);
     Vector<u64, Alloc::ScratchArena> pendingRequestIds{scratchArena};
     {
         ScopedLock lock(m_mutex);
-        pendingRequestIds.reserve(m_requests.size());
+        pendingRequestIds.reserve(Min(m_requests.size(), maxRequestCount));
         for(const auto& [requestId, request] : m_requests){
+            if(pendingRequestIds.size() >= maxRequestCount)
+                break;
             if(request.result.state == AssetLoadState::Pending)
                 pendingRequestIds.push_back(requestId);
         }
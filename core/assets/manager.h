@@ -76,6 +76,9 @@ public:
 
     [[nodiscard]] u64 enqueueLoad(const Name& assetType, const Name& virtualPath);
     void processPending();
+    // Processes at most `maxRequestCount` pending requests on the calling thread. Intended for callers that drive
+    // loading from a frame loop when no async executor is installed.
+    void processPending(usize maxRequestCount);
     bool tryPopResult(u64 requestId, AssetLoadResult& outResult);
 
     void clear();
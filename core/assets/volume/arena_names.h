@@ -24,6 +24,8 @@ namespace AssetsVolumeArenaScope{
 
 
 inline constexpr Name s_CookArena("core/assets/volume/cook");
+inline constexpr Name s_InputCacheArena("core/assets/volume/input_cache");
+inline constexpr Name s_ManifestCookerArena("core/assets/volume/manifest_cooker");
 inline constexpr Name s_PrepareQueueArena("core/assets/volume/prepare_queue");
 inline constexpr Name s_RegisterPreparersArena("core/assets/volume/register_preparers");
 
@@ -118,7 +118,7 @@ static bool PushManifestEntryToVolume(
     case AssetsVolumeCookDetail::AssetVolumePackEntrySource::PayloadBytes:
         if(
             entry.identity.payloadSize != static_cast<u64>(entry.payloadBytes.size())
-            || entry.identity.payloadHash != ComputeFnv64Bytes(entry.payloadBytes.data(), entry.payloadBytes.size())
+            || entry.identity.payloadHash != ComputeWyHash64(entry.payloadBytes.data(), entry.payloadBytes.size())
         ){
             NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: manifest payload identity mismatch '{}'"), StringConvert(entry.virtualPath.c_str()));
             return false;
@@ -0,0 +1,420 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_COOK)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "cook_input_cache.h"
+
+#include "arena_names.h"
+
+#include <core/assets/module.h>
+
+#include <core/common/log.h>
+
+#include <global/binary.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_cook_input_cache{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+using ScratchArena = AssetsVolumeCookDetail::ScratchArena;
+using ScratchString = AssetsVolumeCookDetail::ScratchString;
+
+static constexpr u32 s_InputRecordMagic = 0x49424e57; // WNBI
+static constexpr u16 s_InputRecordVersion = 2u;
+// Bump when a registry cooker starts producing different bytes from unchanged inputs.
+static constexpr u32 s_InputCookerVersion = 1u;
+static constexpr char s_InputRecordExtension[] = ".nwbin";
+static constexpr char s_InputCacheDirectoryName[] = "inputs";
+
+struct CookInputRecordHeader{
+    u32 magic = s_InputRecordMagic;
+    u16 version = s_InputRecordVersion;
+    u16 headerSize = sizeof(CookInputRecordHeader);
+    u64 inputKeyHash = 0u;
+    u64 metadataHash = 0u;
+    u32 dependencyCount = 0u;
+    u32 objectCount = 0u;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static Path BuildInputRecordPath(
+    const Path& cacheDirectory,
+    const AStringView configurationSafeName,
+    const Core::Assets::DiscoveredNwbFile& nwbFile,
+    ScratchArena& scratchArena
+){
+    ScratchString recordFileName{scratchArena};
+    recordFileName.reserve(s_HexU64DigitCount + sizeof(s_InputRecordExtension));
+    AppendHexU64(ComputeFnv64Text(nwbFile.normalizedPathText), recordFileName);
+    recordFileName += s_InputRecordExtension;
+
+    return cacheDirectory / configurationSafeName / s_InputCacheDirectoryName / recordFileName;
+}
+
+static u64 ComputeInputKeyHash(
+    const AStringView configurationSafeName,
+    const Core::Assets::DiscoveredNwbFile& nwbFile,
+    ScratchArena& scratchArena
+){
+    const ScratchString assetRootText = PathToString(scratchArena, nwbFile.assetRoot);
+
+    WyHash64Stream inputKey;
+    inputKey.updateValue(s_InputCookerVersion);
+    inputKey.updateValue(s_InputRecordVersion);
+    inputKey.updateText(configurationSafeName);
+    inputKey.updateText(AStringView(nwbFile.normalizedPathText));
+    inputKey.updateText(AStringView(assetRootText));
+    inputKey.updateText(nwbFile.virtualRoot.view());
+    return inputKey.finish();
+}
+
+static bool ComputeFileHash(const Path& filePath, Core::Assets::AssetBytes& fileBytes, u64& outHash){
+    ErrorCode errorCode;
+    if(!ReadBinaryFile(filePath, fileBytes, errorCode))
+        return false;
+
+    outHash = ComputeWyHash64(fileBytes.data(), fileBytes.size());
+    return true;
+}
+
+static bool ReadInputRecord(
+    const Path& recordPath,
+    const u64 inputKeyHash,
+    Core::Assets::AssetBytes& fileBytes,
+    AssetsVolumeCookDetail::CookInputCacheEntry& inOutEntry
+){
+    Core::Assets::AssetBytes recordBytes(fileBytes.get_allocator().arena());
+    ErrorCode errorCode;
+    if(!ReadBinaryFile(recordPath, recordBytes, errorCode))
+        return false;
+
+    usize cursor = 0u;
+    CookInputRecordHeader header;
+    if(!ReadPOD(recordBytes, cursor, header))
+        return false;
+    if(header.magic != s_InputRecordMagic || header.version != s_InputRecordVersion || header.headerSize != sizeof(CookInputRecordHeader))
+        return false;
+    if(header.inputKeyHash != inputKeyHash || header.metadataHash != inOutEntry.metadataHash)
+        return false;
+
+    CookArena& arena = inOutEntry.objects.get_allocator().arena();
+    for(u32 dependencyIndex = 0u; dependencyIndex < header.dependencyCount; ++dependencyIndex){
+        CookString dependencyText{arena};
+        u64 recordedHash = 0u;
+        if(!ReadString(recordBytes, cursor, dependencyText) || !ReadPOD(recordBytes, cursor, recordedHash))
+            return false;
+
+        u64 currentHash = 0u;
+        if(!ComputeFileHash(Path(arena, AStringView(dependencyText)), fileBytes, currentHash) || currentHash != recordedHash)
+            return false;
+    }
+
+    inOutEntry.objects.reserve(header.objectCount);
+    for(u32 objectIndex = 0u; objectIndex < header.objectCount; ++objectIndex){
+        NameHash virtualPathHash = {};
+        CookString objectPathText{arena};
+        AssetsVolumeCookDetail::CookInputCacheObject& object = inOutEntry.objects.emplace_back(arena);
+        if(!ReadPOD(recordBytes, cursor, virtualPathHash) || !ReadString(recordBytes, cursor, objectPathText) || !ReadPOD(recordBytes, cursor, object.identity))
+            return false;
+
+        object.virtualPath = Name(virtualPathHash);
+        object.objectPath = Path(arena, AStringView(objectPathText));
+        // The object cache is shared with other cooks and may have been pruned; a missing object is a miss.
+        if(!PathIsRegularFile(object.objectPath))
+            return false;
+    }
+
+    return cursor == recordBytes.size();
+}
+
+static void LookupInputRecord(
+    const AssetsVolumeCookDetail::ResolvedCookPaths& resolvedPaths,
+    const AStringView configurationSafeName,
+    const Core::Assets::DiscoveredNwbFile& nwbFile,
+    AssetsVolumeCookDetail::CookInputCacheEntry& outEntry
+){
+    ScratchArena scratchArena(AssetsVolumeArenaScope::s_InputCacheArena);
+    Core::Assets::AssetBytes fileBytes(outEntry.objects.get_allocator().arena());
+    if(!ComputeFileHash(nwbFile.filePath, fileBytes, outEntry.metadataHash))
+        return;
+
+    const Path recordPath = BuildInputRecordPath(resolvedPaths.cacheDirectory, configurationSafeName, nwbFile, scratchArena);
+    const u64 inputKeyHash = ComputeInputKeyHash(configurationSafeName, nwbFile, scratchArena);
+    outEntry.hit = ReadInputRecord(recordPath, inputKeyHash, fileBytes, outEntry);
+    if(!outEntry.hit)
+        outEntry.objects.clear();
+}
+
+static bool WriteInputRecord(
+    const AssetsVolumeCookDetail::ResolvedCookPaths& resolvedPaths,
+    const AStringView configurationSafeName,
+    const Core::Assets::DiscoveredNwbFile& nwbFile,
+    const AssetsVolumeCookDetail::CookInputCacheEntry& entry,
+    const Core::Assets::CookEntrySourceRecord& source,
+    const AssetsVolumeCookDetail::AssetVolumePackManifest& manifest,
+    const Core::Assets::CookMap<NameHash, usize>& manifestEntryIndices
+){
+    ScratchArena scratchArena(AssetsVolumeArenaScope::s_InputCacheArena);
+    CookArena& arena = manifest.entries.get_allocator().arena();
+
+    CookInputRecordHeader header;
+    header.inputKeyHash = ComputeInputKeyHash(configurationSafeName, nwbFile, scratchArena);
+    header.metadataHash = entry.metadataHash;
+    header.dependencyCount = static_cast<u32>(source.inputDependencies.size());
+    header.objectCount = static_cast<u32>(source.virtualPathHashes.size());
+
+    Core::Assets::AssetBytes recordBytes(arena);
+    Core::Assets::AssetBytes fileBytes(arena);
+    AppendPOD(recordBytes, header);
+    for(const Path& dependencyPath : source.inputDependencies){
+        u64 dependencyHash = 0u;
+        if(!ComputeFileHash(dependencyPath, fileBytes, dependencyHash)){
+            NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: failed to hash cook input '{}' of '{}'")
+                , PathToString<tchar>(dependencyPath)
+                , PathToString<tchar>(nwbFile.filePath)
+            );
+            return false;
+        }
+
+        const ScratchString dependencyText = PathToString(scratchArena, dependencyPath);
+        if(!AppendString(recordBytes, AStringView(dependencyText)))
+            return false;
+        AppendPOD(recordBytes, dependencyHash);
+    }
+    for(const NameHash& virtualPathHash : source.virtualPathHashes){
+        const auto found = manifestEntryIndices.find(virtualPathHash);
+        NWB_ASSERT(found != manifestEntryIndices.end());
+        const AssetsVolumeCookDetail::AssetVolumePackEntry& manifestEntry = manifest.entries[found.value()];
+
+        const ScratchString objectPathText = PathToString(scratchArena, manifestEntry.objectPath);
+        AppendPOD(recordBytes, virtualPathHash);
+        if(!AppendString(recordBytes, AStringView(objectPathText)))
+            return false;
+        AppendPOD(recordBytes, manifestEntry.identity);
+    }
+
+    const Path recordPath = BuildInputRecordPath(resolvedPaths.cacheDirectory, configurationSafeName, nwbFile, scratchArena);
+    ErrorCode errorCode;
+    if(!EnsureDirectories(recordPath.parent_path(), errorCode)){
+        NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: failed to create input cache directory '{}': {}")
+            , PathToString<tchar>(recordPath.parent_path())
+            , StringConvert(errorCode.message())
+        );
+        return false;
+    }
+    if(WriteBinaryFile(recordPath, recordBytes))
+        return true;
+
+    NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: failed to write input cache '{}'"), PathToString<tchar>(recordPath));
+    return false;
+}
+
+static bool SourceProducedOnlyObjectFiles(
+    const Core::Assets::CookEntrySourceRecord& source,
+    const AssetsVolumeCookDetail::AssetVolumePackManifest& manifest,
+    const Core::Assets::CookMap<NameHash, usize>& manifestEntryIndices
+){
+    if(source.virtualPathHashes.empty())
+        return false;
+
+    for(const NameHash& virtualPathHash : source.virtualPathHashes){
+        const auto found = manifestEntryIndices.find(virtualPathHash);
+        if(found == manifestEntryIndices.end())
+            return false;
+        if(manifest.entries[found.value()].source != AssetsVolumeCookDetail::AssetVolumePackEntrySource::ObjectFilePayload)
+            return false;
+    }
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace AssetsVolumeCookDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+void LookupCookInputCache(
+    Core::Alloc::ThreadPool& threadPool,
+    const ResolvedCookPaths& resolvedPaths,
+    const AStringView configurationSafeName,
+    const Core::Assets::DiscoveredNwbFileVector& nwbFiles,
+    CookInputCacheEntryVector& outEntries
+){
+    CookArena& arena = outEntries.get_allocator().arena();
+    outEntries.clear();
+    outEntries.reserve(nwbFiles.size());
+    for(usize fileIndex = 0u; fileIndex < nwbFiles.size(); ++fileIndex)
+        outEntries.emplace_back(arena);
+
+    threadPool.parallelFor(static_cast<usize>(0u), nwbFiles.size(), [&](const usize fileIndex){
+        __hidden_cook_input_cache::LookupInputRecord(resolvedPaths, configurationSafeName, nwbFiles[fileIndex], outEntries[fileIndex]);
+    });
+}
+
+u64 CollectCookInputCacheMisses(
+    const Core::Assets::DiscoveredNwbFileVector& nwbFiles,
+    const CookInputCacheEntryVector& entries,
+    Core::Assets::DiscoveredNwbFileVector& outMissFiles,
+    CookVector<usize>& outMissFileIndices
+){
+    outMissFiles.clear();
+    outMissFileIndices.clear();
+
+    u64 cachedObjectCount = 0u;
+    for(usize fileIndex = 0u; fileIndex < nwbFiles.size(); ++fileIndex){
+        if(entries[fileIndex].hit){
+            cachedObjectCount += static_cast<u64>(entries[fileIndex].objects.size());
+            continue;
+        }
+
+        outMissFiles.push_back(nwbFiles[fileIndex]);
+        outMissFileIndices.push_back(fileIndex);
+    }
+    return cachedObjectCount;
+}
+
+bool AppendCookInputCacheHits(
+    const CookInputCacheEntryVector& entries,
+    AssetVolumePackManifest& manifest,
+    VirtualPathHashSet& seenVirtualPathHashes
+){
+    for(const CookInputCacheEntry& entry : entries){
+        if(!entry.hit)
+            continue;
+
+        for(const CookInputCacheObject& object : entry.objects){
+            if(!seenVirtualPathHashes.insert(object.virtualPath.hash()).second){
+                NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: duplicate cached virtual path '{}'"), StringConvert(object.virtualPath.c_str()));
+                return false;
+            }
+            if(!AppendObjectFilePayloadToManifest(manifest, object.virtualPath, object.objectPath, object.identity))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool StoreCookInputCache(
+    Core::Alloc::ThreadPool& threadPool,
+    const ResolvedCookPaths& resolvedPaths,
+    const AStringView configurationSafeName,
+    const Core::Assets::DiscoveredNwbFileVector& nwbFiles,
+    const CookInputCacheEntryVector& entries,
+    const CookVector<usize>& missFileIndices,
+    const ParsedAssetMetadata& parsedMetadata,
+    const AssetVolumePackManifest& manifest,
+    CookInputCacheStats& inOutStats
+){
+    for(const CookInputCacheEntry& entry : entries){
+        if(entry.hit)
+            ++inOutStats.hitCount;
+    }
+    if(missFileIndices.empty())
+        return true;
+    if(parsedMetadata.sources.size() != missFileIndices.size()){
+        NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: parsed {} metadata sources for {} input cache misses")
+            , parsedMetadata.sources.size()
+            , missFileIndices.size()
+        );
+        return false;
+    }
+
+    CookArena& arena = manifest.entries.get_allocator().arena();
+    Core::Assets::CookMap<NameHash, usize> manifestEntryIndices(0, Hasher<NameHash>(), EqualTo<NameHash>(), arena);
+    manifestEntryIndices.reserve(manifest.entries.size());
+    for(usize entryIndex = 0u; entryIndex < manifest.entries.size(); ++entryIndex)
+        manifestEntryIndices.emplace(manifest.entries[entryIndex].virtualPath.hash(), entryIndex);
+
+    CookVector<usize> storeSourceIndices(arena);
+    storeSourceIndices.reserve(missFileIndices.size());
+    for(usize sourceIndex = 0u; sourceIndex < missFileIndices.size(); ++sourceIndex){
+        const Core::Assets::CookEntrySourceRecord& source = parsedMetadata.sources[sourceIndex];
+        if(
+            !source.inputCacheable
+            || entries[missFileIndices[sourceIndex]].metadataHash == 0u
+            || !__hidden_cook_input_cache::SourceProducedOnlyObjectFiles(source, manifest, manifestEntryIndices)
+        ){
+            ++inOutStats.uncachedCount;
+            continue;
+        }
+
+        storeSourceIndices.push_back(sourceIndex);
+    }
+    inOutStats.missCount += static_cast<u64>(storeSourceIndices.size());
+
+    Atomic<bool> failed{ false };
+    threadPool.parallelFor(static_cast<usize>(0u), storeSourceIndices.size(), [&](const usize storeIndex){
+        if(failed.load(MemoryOrder::acquire))
+            return;
+
+        const usize sourceIndex = storeSourceIndices[storeIndex];
+        const usize fileIndex = missFileIndices[sourceIndex];
+        if(__hidden_cook_input_cache::WriteInputRecord(
+            resolvedPaths,
+            configurationSafeName,
+            nwbFiles[fileIndex],
+            entries[fileIndex],
+            parsedMetadata.sources[sourceIndex],
+            manifest,
+            manifestEntryIndices
+        ))
+            return;
+
+        failed.store(true, MemoryOrder::release);
+    });
+    return !failed.load(MemoryOrder::acquire);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
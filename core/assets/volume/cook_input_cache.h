@@ -0,0 +1,118 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_COOK)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "pack_manifest.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace AssetsVolumeCookDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// The input cache keys each discovered .nwb by its own bytes, the bytes of every file its parsers read, the
+// configuration and a cooker version. A hit replays the cooked objects the previous cook recorded for that .nwb
+// straight into the manifest, so neither the metadata parser nor the asset builders run for it.
+
+struct CookInputCacheObject{
+    Name virtualPath = NAME_NONE;
+    Path objectPath;
+    AssetVolumePayloadIdentity identity;
+
+    explicit CookInputCacheObject(CookArena& arena)
+        : objectPath(arena)
+    {}
+};
+
+struct CookInputCacheEntry{
+    CookVector<CookInputCacheObject> objects;
+    u64 metadataHash = 0u;
+    bool hit = false;
+
+    explicit CookInputCacheEntry(CookArena& arena)
+        : objects(arena)
+    {}
+};
+
+using CookInputCacheEntryVector = CookVector<CookInputCacheEntry>;
+
+struct CookInputCacheStats{
+    u64 hitCount = 0u;
+    u64 missCount = 0u;
+    u64 uncachedCount = 0u;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+void LookupCookInputCache(
+    Core::Alloc::ThreadPool& threadPool,
+    const ResolvedCookPaths& resolvedPaths,
+    AStringView configurationSafeName,
+    const Core::Assets::DiscoveredNwbFileVector& nwbFiles,
+    CookInputCacheEntryVector& outEntries
+);
+[[nodiscard]] u64 CollectCookInputCacheMisses(
+    const Core::Assets::DiscoveredNwbFileVector& nwbFiles,
+    const CookInputCacheEntryVector& entries,
+    Core::Assets::DiscoveredNwbFileVector& outMissFiles,
+    CookVector<usize>& outMissFileIndices
+);
+[[nodiscard]] bool AppendCookInputCacheHits(
+    const CookInputCacheEntryVector& entries,
+    AssetVolumePackManifest& manifest,
+    VirtualPathHashSet& seenVirtualPathHashes
+);
+[[nodiscard]] bool StoreCookInputCache(
+    Core::Alloc::ThreadPool& threadPool,
+    const ResolvedCookPaths& resolvedPaths,
+    AStringView configurationSafeName,
+    const Core::Assets::DiscoveredNwbFileVector& nwbFiles,
+    const CookInputCacheEntryVector& entries,
+    const CookVector<usize>& missFileIndices,
+    const ParsedAssetMetadata& parsedMetadata,
+    const AssetVolumePackManifest& manifest,
+    CookInputCacheStats& inOutStats
+);
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -17,6 +17,7 @@
 #include <core/assets/cook_paths.h>
 
 #include <core/alloc/scratch.h>
+#include <core/alloc/thread.h>
 #include <core/filesystem/volume_staging.h>
 
 
@@ -61,9 +62,54 @@ struct AssetVolumeWriteResult{
 
 struct AssetVolumePackManifest;
 
-using AssetVolumeManifestCooker = Function<bool(AssetVolumePackManifest&, VirtualPathHashSet&, ScratchArena&)>;
+// A manifest cooker's share of the cook thread pool. Fan-out goes through ThreadPool::boundedParallelFor, because
+// parallelFor calls on a shared pool take turns and would serialize cookers running side by side. `maxParallelism`
+// counts the cooker's own thread.
+struct AssetVolumeCookerWorkers{
+    Core::Alloc::ThreadPool& threadPool;
+    usize maxParallelism = 1u;
+
+    template<typename Func>
+    void parallelFor(const usize begin, const usize end, const usize grainSize, const Func& func)const{
+        threadPool.boundedParallelFor(begin, end, grainSize, maxParallelism, func);
+    }
+};
+
+using AssetVolumeManifestCookFunction = Function<bool(
+    AssetVolumePackManifest&,
+    VirtualPathHashSet&,
+    const AssetVolumeCookerWorkers&,
+    ScratchArena&
+)>;
+
+// Products are plain names shared between cookers. A cooker runs once every product it lists in `inputs` has been
+// produced, concurrently with any other cooker that is ready, and writes into its own manifest; the cooker merges
+// those manifests back in registration order.
+inline constexpr Name s_RegistryObjectsProduct("core/assets/volume/registry_objects");
+
+struct AssetVolumeManifestCooker{
+    ACompactString name;
+    CookVector<Name> inputs;
+    CookVector<Name> outputs;
+    AssetVolumeManifestCookFunction cook;
+
+    AssetVolumeManifestCooker(CookArena& arena, const AStringView inName, AssetVolumeManifestCookFunction&& inCook)
+        : name(inName)
+        , inputs(arena)
+        , outputs(arena)
+        , cook(Move(inCook))
+    {}
+};
+
 using AssetVolumeManifestCookerVector = CookVector<AssetVolumeManifestCooker>;
 
+struct AssetVolumeCookStageTiming{
+    ACompactString name;
+    f64 seconds = 0.0;
+};
+
+using AssetVolumeCookStageTimingVector = CookVector<AssetVolumeCookStageTiming>;
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -38,8 +38,8 @@ using ScratchArena = AssetsVolumeCookDetail::ScratchArena;
 using ScratchString = AssetsVolumeCookDetail::ScratchString;
 
 static constexpr u32 s_ObjectFileMagic = 0x4f4a424e; // NBJO
-static constexpr u16 s_ObjectFileVersion = 2u;
-static constexpr char s_ObjectFileVersionPrefix[] = "v2_";
+static constexpr u16 s_ObjectFileVersion = 3u;
+static constexpr char s_ObjectFileVersionPrefix[] = "v3_";
 static constexpr char s_ObjectFileHashSeparator[] = "__";
 static constexpr char s_ObjectFileExtension[] = ".nwbobj";
 static constexpr char s_ObjectCacheDirectoryName[] = "objects";
@@ -99,21 +99,20 @@ static AssetVolumeObjectFileHeader BuildObjectFileHeader(
     const Core::Assets::AssetBytes& payload,
     const AStringView configurationSafeName
 ){
-    static constexpr u32 s_ObjectCookKeyVersion = 1u;
+    static constexpr u32 s_ObjectCookKeyVersion = 2u;
 
     AssetVolumeObjectFileHeader header;
     header.assetTypeHash = codec.assetType().hash();
     header.payloadSize = static_cast<u64>(payload.size());
-    header.payloadHash = ComputeFnv64Bytes(payload.data(), payload.size());
-    const u64 configurationHash = ComputeFnv64Text(configurationSafeName);
-    u64 cookKeyHash = FNV64_OFFSET_BASIS;
-    Fnv64AppendValue(cookKeyHash, s_ObjectCookKeyVersion);
-    Fnv64AppendValue(cookKeyHash, s_ObjectFileVersion);
-    Fnv64AppendValue(cookKeyHash, configurationHash);
-    Fnv64AppendValue(cookKeyHash, header.assetTypeHash);
-    Fnv64AppendValue(cookKeyHash, header.payloadSize);
-    Fnv64AppendValue(cookKeyHash, header.payloadHash);
-    header.cookKeyHash = cookKeyHash;
+    header.payloadHash = ComputeWyHash64(payload.data(), payload.size());
+    WyHash64Stream cookKey;
+    cookKey.updateValue(s_ObjectCookKeyVersion);
+    cookKey.updateValue(s_ObjectFileVersion);
+    cookKey.updateText(configurationSafeName);
+    cookKey.updateValue(header.assetTypeHash);
+    cookKey.updateValue(header.payloadSize);
+    cookKey.updateValue(header.payloadHash);
+    header.cookKeyHash = cookKey.finish();
     return header;
 }
 
@@ -161,7 +160,7 @@ static bool ReadObjectFileHeader(
     const usize payloadSize = static_cast<usize>(outHeader.payloadSize);
     if(cursor > objectBytes.size() || objectBytes.size() - cursor != payloadSize)
         return false;
-    if(outHeader.payloadHash != ComputeFnv64Bytes(objectBytes.data() + cursor, payloadSize))
+    if(outHeader.payloadHash != ComputeWyHash64(objectBytes.data() + cursor, payloadSize))
         return false;
 
     outPayloadOffset = cursor;
@@ -372,7 +371,7 @@ namespace AssetsVolumeCookDetail{
 
 bool BuildRegistryObjectManifestEntries(
     Core::Alloc::GlobalArena& arena,
-    Core::Alloc::ThreadPool& threadPool,
+    const AssetVolumeCookerWorkers& workers,
     const ResolvedCookPaths& resolvedPaths,
     const AStringView configurationSafeName,
     ParsedAssetMetadata& parsedMetadata,
@@ -390,7 +389,7 @@ bool BuildRegistryObjectManifestEntries(
 
     Futex objectCacheWriteMutex;
     Atomic<bool> failed{ false };
-    threadPool.parallelFor(static_cast<usize>(0u), bucketCount, [&](const usize bucketIndex){
+    workers.parallelFor(static_cast<usize>(0u), bucketCount, static_cast<usize>(1u), [&](const usize bucketIndex){
         if(failed.load(MemoryOrder::acquire))
             return;
 
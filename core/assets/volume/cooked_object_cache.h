@@ -37,7 +37,7 @@ struct CookedObjectPayloadView{
 
 [[nodiscard]] bool BuildRegistryObjectManifestEntries(
     Core::Alloc::GlobalArena& arena,
-    Core::Alloc::ThreadPool& threadPool,
+    const AssetVolumeCookerWorkers& workers,
     const ResolvedCookPaths& resolvedPaths,
     AStringView configurationSafeName,
     ParsedAssetMetadata& parsedMetadata,
@@ -12,8 +12,10 @@
 
 #include "arena_names.h"
 #include "asset_volume_writer.h"
+#include "cook_input_cache.h"
 #include "cook_paths.h"
 #include "cooked_object_cache.h"
+#include "manifest_cook_graph.h"
 #include "pack_manifest.h"
 #include "volume_prepare_registry.h"
 
@@ -24,6 +26,8 @@
 
 #include <core/common/log.h>
 
+#include <global/timer.h>
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -46,6 +50,18 @@ Core::Assets::AssetCookerAutoRegistrar s_AssetVolumeCookerAutoRegistrar(&Core::A
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+static void AppendStageTiming(
+    AssetsVolumeCookDetail::AssetVolumeCookStageTimingVector& timings,
+    const AStringView name,
+    const Timer& begin
+){
+    timings.push_back(AssetsVolumeCookDetail::AssetVolumeCookStageTiming{ ACompactString(name), DurationInSeconds<f64>(TimerNow(), begin) });
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 };
 
 
@@ -53,16 +69,30 @@ Core::Assets::AssetCookerAutoRegistrar s_AssetVolumeCookerAutoRegistrar(&Core::A
 
 
 bool AssetVolumeCooker::cook(const Core::Assets::AssetCookOptions& options){
-    AssetVolumeCookResult result;
+    AssetVolumeCookResult result(m_arena);
     if(!cookAssetVolume(options, result))
         return false;
 
+    for(const AssetsVolumeCookDetail::AssetVolumeCookStageTiming& timing : result.stageTimings){
+        NWB_LOGGER_ESSENTIAL_INFO(
+            NWB_TEXT("Asset volume cook stage [{}] - '{}' {} ms"),
+            StringConvert(options.configuration.c_str()),
+            StringConvert(timing.name.c_str()),
+            timing.seconds * 1000.0
+        );
+    }
+
     NWB_LOGGER_ESSENTIAL_INFO(
-        NWB_TEXT("Asset volume cook complete [{}] - volume='{}', files={}, segments={}, mount='{}'"),
+        NWB_TEXT("Asset volume cook complete [{}] - volume='{}', files={}, segments={}, input cache hits={} misses={} uncached={}, metadata cache hits={} misses={}, mount='{}'"),
         StringConvert(options.configuration.c_str()),
         StringConvert(result.volumeName.c_str()),
         result.fileCount,
         result.segmentCount,
+        result.inputCacheHits,
+        result.inputCacheMisses,
+        result.inputCacheUncached,
+        result.metadataCacheHits,
+        result.metadataCacheMisses,
         StringConvert(options.outputDirectory)
     );
 
@@ -74,10 +104,12 @@ bool AssetVolumeCooker::cook(const Core::Assets::AssetCookOptions& options){
 
 
 bool AssetVolumeCooker::cookAssetVolume(const Core::Assets::AssetCookOptions& options, AssetVolumeCookResult& outResult){
-    outResult = {};
+    outResult.stageTimings.clear();
+    AssetsVolumeCookDetail::AssetVolumeCookStageTimingVector& timings = outResult.stageTimings;
 
     Core::Alloc::ScratchArena scratchArena(AssetsVolumeArenaScope::s_CookArena);
 
+    Timer stageBegin = TimerNow();
     Core::Assets::ResolvedCookPaths resolvedPaths(m_arena);
     if(!Core::Assets::ResolveCookPaths(options, resolvedPaths, scratchArena))
         return false;
@@ -90,27 +122,54 @@ bool AssetVolumeCooker::cookAssetVolume(const Core::Assets::AssetCookOptions& op
         scratchArena
     ))
         return false;
+    __hidden_cooker::AppendStageTiming(timings, "discover", stageBegin);
+
+    Core::Assets::CookString configurationSafeName = BuildCanonicalSafeCacheName(m_arena, options.configuration.view());
+    if(configurationSafeName.empty())
+        configurationSafeName = "default";
+
+    stageBegin = TimerNow();
+    AssetsVolumeCookDetail::CookInputCacheEntryVector inputCacheEntries(m_arena);
+    AssetsVolumeCookDetail::LookupCookInputCache(
+        options.services.threadPool,
+        resolvedPaths,
+        configurationSafeName,
+        nwbFiles,
+        inputCacheEntries
+    );
+
+    Core::Assets::DiscoveredNwbFileVector missFiles{ m_arena };
+    AssetsVolumeCookDetail::CookVector<usize> missFileIndices(m_arena);
+    const u64 cachedObjectCount = AssetsVolumeCookDetail::CollectCookInputCacheMisses(
+        nwbFiles,
+        inputCacheEntries,
+        missFiles,
+        missFileIndices
+    );
+    __hidden_cooker::AppendStageTiming(timings, "input_cache_lookup", stageBegin);
 
+    stageBegin = TimerNow();
     Core::Assets::ParsedAssetMetadata parsedMetadata(m_arena);
     if(!Core::Assets::RegisterAutoCollectedCookEntryTypes(parsedMetadata.entryRegistry))
         return false;
-    if(!Core::Assets::ParseAssetMetadata(
+    if((!missFiles.empty() || cachedObjectCount == 0u) && !Core::Assets::ParseAssetMetadata(
         m_arena,
-        nwbFiles,
+        missFiles,
+        resolvedPaths.cacheDirectory,
         parsedMetadata,
         options.services.threadPool,
         scratchArena
     ))
         return false;
+    __hidden_cooker::AppendStageTiming(timings, "parse", stageBegin);
 
-    Core::Assets::CookString configurationSafeName = BuildCanonicalSafeCacheName(m_arena, options.configuration.view());
-    if(configurationSafeName.empty())
-        configurationSafeName = "default";
-
+    stageBegin = TimerNow();
     u64 plannedFileCount = 0u;
     AssetsVolumeCookDetail::AssetVolumeManifestCookerVector manifestCookers(m_arena);
     AssetsVolumeCookDetail::AssetVolumePrepareContext prepareContext{
         m_arena,
+        options.services.threadPool,
+        options.maxConcurrentShaderCompiles,
         resolvedPaths,
         configurationSafeName,
         parsedMetadata,
@@ -122,6 +181,47 @@ bool AssetVolumeCooker::cookAssetVolume(const Core::Assets::AssetCookOptions& op
         return false;
     if(!Core::Assets::AddPlannedFileCount(parsedMetadata.entryRegistry.entryCount(), plannedFileCount))
         return false;
+    if(!Core::Assets::AddPlannedFileCount(cachedObjectCount, plannedFileCount))
+        return false;
+    __hidden_cooker::AppendStageTiming(timings, "prepare", stageBegin);
+
+    // Registry objects (cache hits plus freshly built entries) are one more cooker in the graph, so they build while
+    // the preparers' cookers (shader compilation, ...) are still running.
+    AssetsVolumeCookDetail::AssetVolumeManifestCooker& registryCooker = manifestCookers.emplace_back(
+        m_arena,
+        AStringView("registry_objects"),
+        [&](
+            AssetsVolumeCookDetail::AssetVolumePackManifest& registryManifest,
+            AssetsVolumeCookDetail::VirtualPathHashSet& registrySeenVirtualPathHashes,
+            const AssetsVolumeCookDetail::AssetVolumeCookerWorkers& registryWorkers,
+            AssetsVolumeCookDetail::ScratchArena&
+        ){
+            if(!AssetsVolumeCookDetail::AppendCookInputCacheHits(inputCacheEntries, registryManifest, registrySeenVirtualPathHashes))
+                return false;
+            if(!AssetsVolumeCookDetail::BuildRegistryObjectManifestEntries(
+                m_arena,
+                registryWorkers,
+                resolvedPaths,
+                configurationSafeName,
+                parsedMetadata,
+                registryManifest,
+                registrySeenVirtualPathHashes
+            ))
+                return false;
+
+            // Cached and freshly cooked objects interleave differently depending on what hit, so order them by
+            // virtual path to keep the volume independent of the cache state.
+            Sort(
+                registryManifest.entries.begin(),
+                registryManifest.entries.end(),
+                [](const AssetsVolumeCookDetail::AssetVolumePackEntry& lhs, const AssetsVolumeCookDetail::AssetVolumePackEntry& rhs){
+                    return lhs.virtualPath < rhs.virtualPath;
+                }
+            );
+            return true;
+        }
+    );
+    registryCooker.outputs.push_back(AssetsVolumeCookDetail::s_RegistryObjectsProduct);
 
     AssetsVolumeCookDetail::AssetVolumePackManifest manifest(m_arena);
     if(!AssetsVolumeCookDetail::ReserveAssetVolumePackManifest(manifest, plannedFileCount))
@@ -131,21 +231,33 @@ bool AssetVolumeCooker::cookAssetVolume(const Core::Assets::AssetCookOptions& op
     if(plannedFileCount <= static_cast<u64>(Limit<usize>::s_Max))
         seenVirtualPathHashes.reserve(static_cast<usize>(plannedFileCount));
 
-    for(const AssetsVolumeCookDetail::AssetVolumeManifestCooker& manifestCooker : manifestCookers){
-        if(!manifestCooker(manifest, seenVirtualPathHashes, scratchArena))
-            return false;
-    }
-    if(!AssetsVolumeCookDetail::BuildRegistryObjectManifestEntries(
+    if(!AssetsVolumeCookDetail::RunAssetVolumeManifestCookers(
         m_arena,
+        options.services.threadPool,
+        manifestCookers,
+        manifest,
+        seenVirtualPathHashes,
+        timings
+    ))
+        return false;
+
+    stageBegin = TimerNow();
+    AssetsVolumeCookDetail::CookInputCacheStats inputCacheStats;
+    if(!AssetsVolumeCookDetail::StoreCookInputCache(
         options.services.threadPool,
         resolvedPaths,
         configurationSafeName,
+        nwbFiles,
+        inputCacheEntries,
+        missFileIndices,
         parsedMetadata,
         manifest,
-        seenVirtualPathHashes
+        inputCacheStats
     ))
         return false;
+    __hidden_cooker::AppendStageTiming(timings, "input_cache_store", stageBegin);
 
+    stageBegin = TimerNow();
     AssetsVolumeCookDetail::AssetVolumeWriteResult volumeResult;
     if(!AssetsVolumeCookDetail::WriteAssetVolume(
         m_arena,
@@ -156,10 +268,16 @@ bool AssetVolumeCooker::cookAssetVolume(const Core::Assets::AssetCookOptions& op
         scratchArena
     ))
         return false;
+    __hidden_cooker::AppendStageTiming(timings, "write_volume", stageBegin);
 
     outResult.volumeName = volumeResult.volumeName;
     outResult.fileCount = volumeResult.fileCount;
     outResult.segmentCount = volumeResult.segmentCount;
+    outResult.inputCacheHits = inputCacheStats.hitCount;
+    outResult.inputCacheMisses = inputCacheStats.missCount;
+    outResult.inputCacheUncached = inputCacheStats.uncachedCount;
+    outResult.metadataCacheHits = parsedMetadata.metadataCacheStats.hitCount;
+    outResult.metadataCacheMisses = parsedMetadata.metadataCacheStats.missCount;
     return true;
 }
 
@@ -31,6 +31,16 @@ struct AssetVolumeCookResult{
     ACompactString volumeName;
     u64 fileCount = 0;
     u64 segmentCount = 0;
+    u64 inputCacheHits = 0;
+    u64 inputCacheMisses = 0;
+    u64 inputCacheUncached = 0;
+    u64 metadataCacheHits = 0;
+    u64 metadataCacheMisses = 0;
+    AssetsVolumeCookDetail::AssetVolumeCookStageTimingVector stageTimings;
+
+    explicit AssetVolumeCookResult(Core::Alloc::GlobalArena& arena)
+        : stageTimings(arena)
+    {}
 };
 
 
@@ -0,0 +1,278 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_COOK)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "manifest_cook_graph.h"
+
+#include "arena_names.h"
+
+#include <core/alloc/job.h>
+#include <core/common/log.h>
+
+#include <global/timer.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_manifest_cook_graph{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+using JobHandle = Core::Alloc::JobSystem::JobHandle;
+
+struct ManifestCookerRun{
+    AssetsVolumeCookDetail::AssetVolumePackManifest manifest;
+    Core::Assets::CookEntryPathHashSet seenVirtualPathHashes;
+    Core::Assets::CookVector<usize> dependencies;
+    JobHandle job;
+    f64 seconds = 0.0;
+
+    explicit ManifestCookerRun(Core::Alloc::GlobalArena& arena)
+        : manifest(arena)
+        , seenVirtualPathHashes(0, Hasher<NameHash>(), EqualTo<NameHash>(), arena)
+        , dependencies(arena)
+    {}
+};
+
+using ManifestCookerRunVector = Core::Assets::CookVector<ManifestCookerRun>;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static bool ResolveManifestCookerDependencies(
+    Core::Alloc::GlobalArena& arena,
+    const AssetsVolumeCookDetail::AssetVolumeManifestCookerVector& manifestCookers,
+    ManifestCookerRunVector& runs
+){
+    Core::Assets::CookMap<Name, usize> producers(0, Hasher<Name>(), EqualTo<Name>(), arena);
+    for(usize cookerIndex = 0u; cookerIndex < manifestCookers.size(); ++cookerIndex){
+        for(const Name& output : manifestCookers[cookerIndex].outputs){
+            const auto [found, inserted] = producers.emplace(output, cookerIndex);
+            if(inserted)
+                continue;
+
+            NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: manifest cookers '{}' and '{}' both produce '{}'")
+                , StringConvert(manifestCookers[found.value()].name.c_str())
+                , StringConvert(manifestCookers[cookerIndex].name.c_str())
+                , StringConvert(output.c_str())
+            );
+            return false;
+        }
+    }
+
+    for(usize cookerIndex = 0u; cookerIndex < manifestCookers.size(); ++cookerIndex){
+        for(const Name& input : manifestCookers[cookerIndex].inputs){
+            const auto found = producers.find(input);
+            if(found == producers.end()){
+                NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: manifest cooker '{}' reads '{}' which no cooker produces")
+                    , StringConvert(manifestCookers[cookerIndex].name.c_str())
+                    , StringConvert(input.c_str())
+                );
+                return false;
+            }
+
+            Core::Assets::CookVector<usize>& dependencies = runs[cookerIndex].dependencies;
+            bool known = false;
+            for(const usize dependency : dependencies)
+                known = known || dependency == found.value();
+            if(!known)
+                dependencies.push_back(found.value());
+        }
+    }
+    return true;
+}
+
+// Kahn's algorithm, always releasing the lowest ready index so the submission order is stable between cooks.
+static bool SortManifestCookers(
+    Core::Alloc::GlobalArena& arena,
+    const AssetsVolumeCookDetail::AssetVolumeManifestCookerVector& manifestCookers,
+    const ManifestCookerRunVector& runs,
+    Core::Assets::CookVector<usize>& outOrder
+){
+    const usize cookerCount = runs.size();
+    Core::Assets::CookVector<usize> pendingDependencyCounts(arena);
+    Core::Assets::CookVector<u8> released(arena);
+    pendingDependencyCounts.reserve(cookerCount);
+    released.resize(cookerCount, 0u);
+    for(const ManifestCookerRun& run : runs)
+        pendingDependencyCounts.push_back(run.dependencies.size());
+
+    outOrder.clear();
+    outOrder.reserve(cookerCount);
+    while(outOrder.size() < cookerCount){
+        usize ready = cookerCount;
+        for(usize cookerIndex = 0u; cookerIndex < cookerCount; ++cookerIndex){
+            if(!released[cookerIndex] && pendingDependencyCounts[cookerIndex] == 0u){
+                ready = cookerIndex;
+                break;
+            }
+        }
+        if(ready == cookerCount){
+            for(usize cookerIndex = 0u; cookerIndex < cookerCount; ++cookerIndex){
+                if(released[cookerIndex])
+                    continue;
+
+                NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: manifest cooker '{}' is part of a dependency cycle")
+                    , StringConvert(manifestCookers[cookerIndex].name.c_str())
+                );
+            }
+            return false;
+        }
+
+        released[ready] = 1u;
+        outOrder.push_back(ready);
+        for(usize cookerIndex = 0u; cookerIndex < cookerCount; ++cookerIndex){
+            for(const usize dependency : runs[cookerIndex].dependencies){
+                if(dependency == ready)
+                    --pendingDependencyCounts[cookerIndex];
+            }
+        }
+    }
+    return true;
+}
+
+static bool MergeManifestCookerRuns(
+    const AssetsVolumeCookDetail::AssetVolumeManifestCookerVector& manifestCookers,
+    ManifestCookerRunVector& runs,
+    AssetsVolumeCookDetail::AssetVolumePackManifest& manifest,
+    AssetsVolumeCookDetail::VirtualPathHashSet& seenVirtualPathHashes
+){
+    for(usize cookerIndex = 0u; cookerIndex < runs.size(); ++cookerIndex){
+        for(AssetsVolumeCookDetail::AssetVolumePackEntry& entry : runs[cookerIndex].manifest.entries){
+            if(!seenVirtualPathHashes.insert(entry.virtualPath.hash()).second){
+                NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: manifest cooker '{}' produced duplicate virtual path '{}'")
+                    , StringConvert(manifestCookers[cookerIndex].name.c_str())
+                    , StringConvert(entry.virtualPath.c_str())
+                );
+                return false;
+            }
+
+            manifest.entries.push_back(Move(entry));
+        }
+    }
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace AssetsVolumeCookDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+bool RunAssetVolumeManifestCookers(
+    Core::Alloc::GlobalArena& arena,
+    Core::Alloc::ThreadPool& threadPool,
+    AssetVolumeManifestCookerVector& manifestCookers,
+    AssetVolumePackManifest& manifest,
+    VirtualPathHashSet& seenVirtualPathHashes,
+    AssetVolumeCookStageTimingVector& outTimings
+){
+    const usize cookerCount = manifestCookers.size();
+    if(cookerCount == 0u)
+        return true;
+
+    __hidden_manifest_cook_graph::ManifestCookerRunVector runs(arena);
+    runs.reserve(cookerCount);
+    for(usize cookerIndex = 0u; cookerIndex < cookerCount; ++cookerIndex)
+        runs.emplace_back(arena);
+
+    Core::Assets::CookVector<usize> order(arena);
+    if(!__hidden_manifest_cook_graph::ResolveManifestCookerDependencies(arena, manifestCookers, runs))
+        return false;
+    if(!__hidden_manifest_cook_graph::SortManifestCookers(arena, manifestCookers, runs, order))
+        return false;
+
+    const AssetVolumeCookerWorkers workers{ threadPool, static_cast<usize>(threadPool.workerThreadCount()) + 1u };
+    Atomic<bool> failed{ false };
+    {
+        Core::Alloc::JobSystem jobSystem(threadPool);
+        Core::Assets::CookVector<__hidden_manifest_cook_graph::JobHandle> dependencyJobs(arena);
+        for(const usize cookerIndex : order){
+            __hidden_manifest_cook_graph::ManifestCookerRun& run = runs[cookerIndex];
+            dependencyJobs.clear();
+            for(const usize dependency : run.dependencies)
+                dependencyJobs.push_back(runs[dependency].job);
+
+            AssetVolumeManifestCooker& manifestCooker = manifestCookers[cookerIndex];
+            run.job = jobSystem.submit(
+                [&manifestCooker, &run, &failed, &workers](){
+                    if(failed.load(MemoryOrder::acquire))
+                        return;
+
+                    // Each cooker gets its own scratch arena; cookers may run on different threads at the same time.
+                    Core::Alloc::ScratchArena scratchArena(AssetsVolumeArenaScope::s_ManifestCookerArena);
+                    const Timer begin = TimerNow();
+                    const bool cooked = manifestCooker.cook(run.manifest, run.seenVirtualPathHashes, workers, scratchArena);
+                    run.seconds = DurationInSeconds<f64>(TimerNow(), begin);
+                    if(!cooked)
+                        failed.store(true, MemoryOrder::release);
+                },
+                dependencyJobs.data(),
+                dependencyJobs.size()
+            );
+            if(run.job.valid())
+                continue;
+
+            NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: failed to schedule manifest cooker '{}'"), StringConvert(manifestCooker.name.c_str()));
+            failed.store(true, MemoryOrder::release);
+            break;
+        }
+        jobSystem.waitAll();
+    }
+    if(failed.load(MemoryOrder::acquire))
+        return false;
+
+    outTimings.reserve(outTimings.size() + cookerCount);
+    for(usize cookerIndex = 0u; cookerIndex < cookerCount; ++cookerIndex)
+        outTimings.push_back(AssetVolumeCookStageTiming{ manifestCookers[cookerIndex].name, runs[cookerIndex].seconds });
+
+    return __hidden_manifest_cook_graph::MergeManifestCookerRuns(manifestCookers, runs, manifest, seenVirtualPathHashes);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
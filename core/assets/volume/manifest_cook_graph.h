@@ -0,0 +1,64 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_COOK)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "pack_manifest.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace AssetsVolumeCookDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Orders the cookers by their declared products, runs them on a job system over `threadPool`, and appends their
+// manifests to `manifest` in registration order so the result does not depend on scheduling. Every cooker fans out on
+// `threadPool` itself, up to the pool's full width. Timings come back in registration order as well.
+[[nodiscard]] bool RunAssetVolumeManifestCookers(
+    Core::Alloc::GlobalArena& arena,
+    Core::Alloc::ThreadPool& threadPool,
+    AssetVolumeManifestCookerVector& manifestCookers,
+    AssetVolumePackManifest& manifest,
+    VirtualPathHashSet& seenVirtualPathHashes,
+    AssetVolumeCookStageTimingVector& outTimings
+);
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
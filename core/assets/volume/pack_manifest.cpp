@@ -43,13 +43,13 @@ static u64 BuildDefaultCookKeyHash(
     const u64 payloadSize,
     const u64 payloadHash
 ){
-    static constexpr u32 s_DefaultPayloadCookKeyVersion = 1u;
-    u64 hash = FNV64_OFFSET_BASIS;
-    Fnv64AppendValue(hash, s_DefaultPayloadCookKeyVersion);
-    Fnv64AppendValue(hash, virtualPath.hash());
-    Fnv64AppendValue(hash, payloadSize);
-    Fnv64AppendValue(hash, payloadHash);
-    return hash;
+    static constexpr u32 s_DefaultPayloadCookKeyVersion = 2u;
+    WyHash64Stream hash;
+    hash.updateValue(s_DefaultPayloadCookKeyVersion);
+    hash.updateValue(virtualPath.hash());
+    hash.updateValue(payloadSize);
+    hash.updateValue(payloadHash);
+    return hash.finish();
 }
 
 static AssetVolumePayloadIdentity BuildPayloadIdentity(
@@ -60,7 +60,7 @@ static AssetVolumePayloadIdentity BuildPayloadIdentity(
 ){
     AssetVolumePayloadIdentity identity;
     identity.payloadSize = static_cast<u64>(payloadByteCount);
-    identity.payloadHash = ComputeFnv64Bytes(payloadBytes, payloadByteCount);
+    identity.payloadHash = ComputeWyHash64(payloadBytes, payloadByteCount);
     identity.cookKeyHash = cookKeyHash != 0u
         ? cookKeyHash
         : BuildDefaultCookKeyHash(virtualPath, identity.payloadSize, identity.payloadHash);
@@ -31,6 +31,8 @@ namespace AssetsVolumeCookDetail{
 
 struct AssetVolumePrepareContext{
     Core::Alloc::GlobalArena& arena;
+    Core::Alloc::ThreadPool& threadPool;
+    u32 maxConcurrentShaderCompiles;
     const ResolvedCookPaths& resolvedPaths;
     CookString& configurationSafeName;
     ParsedAssetMetadata& parsedMetadata;
@@ -3,6 +3,7 @@
 
 
 #include "package_internal.h"
+#include "package_codec.h"
 
 #if defined(NWB_PLATFORM_WINDOWS)
 #include <dbghelp.h>
@@ -28,6 +29,8 @@ namespace Detail{
 inline constexpr usize s_UnsignedTextBufferCapacity = 32u;
 inline constexpr usize s_ManifestReserveBytes = 2048u;
 inline constexpr usize s_LinuxProcPathTextCapacity = 128u;
+inline constexpr u32 s_SignatureFrameCount = 4u;
+inline constexpr u64 s_SignatureFramePageOffsetMask = 0xFFFu;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -295,6 +298,118 @@ static bool WriteCrashPackageBasics(ArenaT& arena, const CrashRequest& request){
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// Identifies one crash site of one build across processes. Frame addresses move with ASLR, so only their offset
+// within the page, which image relocation preserves, takes part; the free-form trigger message is left out.
+static u64 ComputeCrashSignature(const CrashRequest& request){
+    u64 hash = FNV64_OFFSET_BASIS;
+    hash = UpdateFnv64TextExact(hash, AStringView(request.applicationName));
+    hash = UpdateFnv64TextExact(hash, AStringView(request.versionText));
+    hash = UpdateFnv64TextExact(hash, AStringView(request.buildId));
+    Fnv64AppendValue(hash, request.platform);
+    Fnv64AppendValue(hash, request.reasonKind);
+    Fnv64AppendValue(hash, request.reasonCode);
+    hash = UpdateFnv64TextExact(hash, AStringView(request.event));
+    hash = UpdateFnv64TextExact(hash, AStringView(request.triggerCategory));
+    hash = UpdateFnv64TextExact(hash, AStringView(request.triggerExpression));
+    hash = UpdateFnv64TextExact(hash, AStringView(request.triggerFile));
+    Fnv64AppendValue(hash, request.triggerLine);
+
+    const u32 frameCount = Min(request.callstackFrameCount, s_SignatureFrameCount);
+    for(u32 i = 0u; i < frameCount; ++i)
+        Fnv64AppendValue(hash, request.callstackFrames[i] & s_SignatureFramePageOffsetMask);
+    return hash;
+}
+
+template<typename ArenaT>
+static CrashStringT<ArenaT> BuildSignatureText(ArenaT& arena, const AStringView signature){
+    CrashStringT<ArenaT> text{arena};
+    text += PackageNames::s_SignatureKey;
+    text += '=';
+    text += signature;
+    text += '\n';
+    return text;
+}
+
+template<typename ArenaT>
+static CrashStringT<ArenaT> BuildOccurrencesText(
+    ArenaT& arena,
+    const u64 count,
+    const AStringView firstCrashId,
+    const CrashRequest& lastRequest
+){
+    CrashStringT<ArenaT> text{arena};
+    text += PackageNames::s_OccurrenceCountKey;
+    text += '=';
+    AppendUnsignedText(text, count);
+    text += '\n';
+    text += PackageNames::s_OccurrenceFirstCrashIdKey;
+    text += '=';
+    text += firstCrashId;
+    text += '\n';
+    text += PackageNames::s_OccurrenceLastCrashIdKey;
+    text += '=';
+    text += lastRequest.crashId;
+    text += '\n';
+    text += PackageNames::s_OccurrenceLastProcessIdKey;
+    text += '=';
+    AppendUnsignedText(text, lastRequest.processId);
+    text += '\n';
+    return text;
+}
+
+// A crash loop reproduces the same package over and over; a repeat only bumps the counter of the pending entry that
+// already carries its signature. Entries already uploading or uploaded are left alone, so the next repeat after an
+// upload starts a fresh entry and the server keeps seeing that the crash continues.
+template<typename ArenaT>
+static bool FoldRepeatCrash(ArenaT& arena, const CrashRequest& request, const AStringView signature){
+    const ::Path<ArenaT> pendingDirectory = PendingDirectory(::Path<ArenaT>(arena, request.spoolDirectory));
+    ErrorCode error;
+    if(!IsDirectory(pendingDirectory, error) || error)
+        return false;
+
+    DirectoryIterator directory(pendingDirectory, error);
+    if(error)
+        return false;
+
+    for(const auto& entry : directory){
+        CrashStringT<ArenaT> signatureText{arena};
+        if(!ReadTextFile(entry.path() / PackageNames::s_SignatureFileName, signatureText))
+            continue;
+
+        AStringView existingSignature;
+        if(
+            !FindLineKeyValue(AStringView(signatureText.data(), signatureText.size()), PackageNames::s_SignatureKey, existingSignature)
+            || existingSignature != signature
+        )
+            continue;
+
+        const CrashStringT<ArenaT> packageName = PathToString<char>(arena, entry.path().filename());
+        CrashStringT<ArenaT> occurrencesText{arena};
+        u64 count = 1u;
+        AStringView firstCrashId(packageName.data(), packageName.size());
+        if(ReadTextFile(entry.path() / PackageNames::s_OccurrencesFileName, occurrencesText)){
+            const AStringView occurrences(occurrencesText.data(), occurrencesText.size());
+            if(!FindLineKeyValueU64(occurrences, PackageNames::s_OccurrenceCountKey, count) || count == 0u)
+                count = 1u;
+            AStringView recordedFirstCrashId;
+            if(FindLineKeyValue(occurrences, PackageNames::s_OccurrenceFirstCrashIdKey, recordedFirstCrashId))
+                firstCrashId = recordedFirstCrashId;
+        }
+
+        // The entry may have moved to uploading since it was listed; a failed write spools this crash in full.
+        return WriteCrashTextFile(
+            entry.path() / PackageNames::s_OccurrencesFileName,
+            BuildOccurrencesText(arena, count + 1u, firstCrashId, request)
+        );
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 #if defined(NWB_PLATFORM_WINDOWS)
 template<typename ArenaT>
 static bool WriteWindowsMinidump(ArenaT& arena, const CrashRequest& request){
@@ -360,6 +475,14 @@ template<typename ArenaT>
 static bool WriteCrashPackageWithArena(ArenaT& arena, const CrashRequest& request){
     if(request.magic != s_RequestMagic || request.version != s_RequestVersion)
         return false;
+
+    const CrashStringT<ArenaT> signature = FormatHex64A(arena, ComputeCrashSignature(request));
+    const AStringView signatureView(signature.data(), signature.size());
+    // GPU reports and dumps are written by the crashing process before the handler runs. They are unique to this
+    // crash, so a package that already has them is always spooled in full.
+    if(!PathExists(RequestPendingDirectory(arena, request)) && FoldRepeatCrash(arena, request, signatureView))
+        return true;
+
     if(!WriteCrashPackageBasics(arena, request))
         return false;
 
@@ -403,7 +526,14 @@ static bool WriteCrashPackageWithArena(ArenaT& arena, const CrashRequest& reques
         return false;
 #endif
 
-    return true;
+    // The signature goes last: a package becomes a fold target only once all of its files are on disk.
+    const ::Path<ArenaT> packageDirectory = RequestPendingDirectory(arena, request);
+    if(!WriteCrashTextFile(
+        packageDirectory / PackageNames::s_OccurrencesFileName,
+        BuildOccurrencesText(arena, 1u, AStringView(request.crashId), request)
+    ))
+        return false;
+    return WriteCrashTextFile(packageDirectory / PackageNames::s_SignatureFileName, BuildSignatureText(arena, signatureView));
 }
 
 bool WriteCrashPackage(const CrashRequest& request){
@@ -433,6 +563,60 @@ static void AppendArchiveUnsigned(CrashBytesT<ArenaT>& out, const u64 value){
     AppendArchiveText(out, buffer);
 }
 
+template<typename ArenaT>
+static bool AppendArchiveFileEntry(
+    ArenaT& arena,
+    const ::Path<ArenaT>& packageDirectory,
+    const ::Path<ArenaT>& filePath,
+    CrashBytesT<ArenaT>& outArchive
+){
+    CrashBytesT<ArenaT> fileBytes{arena};
+    ErrorCode readError;
+    if(!ReadBinaryFile(filePath, fileBytes, readError))
+        return false;
+
+    const CrashStringT<ArenaT> pathText = PathToGenericString<char>(arena, filePath.lexically_relative(packageDirectory));
+    AppendArchiveText(outArchive, PackageNames::s_ArchiveFileHeaderPrefix);
+    AppendArchiveText(outArchive, AStringView(pathText.data(), pathText.size()));
+    AppendArchiveText(outArchive, " ");
+    AppendArchiveUnsigned(outArchive, fileBytes.size());
+    AppendArchiveText(outArchive, "\n");
+    outArchive.insert(outArchive.end(), fileBytes.begin(), fileBytes.end());
+    AppendArchiveText(outArchive, PackageNames::s_ArchiveEntryEndText);
+    return true;
+}
+
+// Splices the entries of a sealed package back into a plain archive: both share the same header, so the inflated
+// body after it is a run of ordinary file entries.
+template<typename ArenaT>
+static bool AppendSealedArchiveEntries(ArenaT& arena, const ::Path<ArenaT>& sealedPath, CrashBytesT<ArenaT>& outArchive){
+    CrashBytesT<ArenaT> sealedBytes{arena};
+    ErrorCode readError;
+    if(!ReadBinaryFile(sealedPath, sealedBytes, readError))
+        return false;
+
+    CrashBytesT<ArenaT> sealedArchive{arena};
+    if(!PackageCodec::DecompressArchive(arena, sealedBytes.data(), sealedBytes.size(), Limit<usize>::s_Max, sealedArchive))
+        return false;
+
+    constexpr AStringView header(PackageNames::s_ArchiveHeaderText);
+    if(
+        sealedArchive.size() <= header.size()
+        || AStringView(reinterpret_cast<const char*>(sealedArchive.data()), header.size()) != header
+    )
+        return false;
+
+    outArchive.insert(outArchive.end(), sealedArchive.begin() + header.size(), sealedArchive.end());
+    return true;
+}
+
+[[nodiscard]] static bool IsLoosePackageFile(const AStringView relativePath){
+    return relativePath == PackageNames::s_SignatureFileName
+        || relativePath == PackageNames::s_OccurrencesFileName
+        || relativePath == PackageNames::s_UploadAttemptFileName
+    ;
+}
+
 template<typename ArenaT>
 bool BuildPackageArchive(ArenaT& arena, const ::Path<ArenaT>& packageDirectory, CrashBytesT<ArenaT>& outArchive){
     outArchive.clear();
@@ -449,25 +633,76 @@ bool BuildPackageArchive(ArenaT& arena, const ::Path<ArenaT>& packageDirectory,
         if(!entry.is_regular_file(entryError) || entryError)
             continue;
 
-        CrashBytesT<ArenaT> fileBytes{arena};
-        ErrorCode readError;
-        if(!ReadBinaryFile(entry.path(), fileBytes, readError))
+        const CrashStringT<ArenaT> relativePath = PathToGenericString<char>(arena, entry.path().lexically_relative(packageDirectory));
+        if(relativePath == PackageNames::s_SealingArchiveFileName)
+            continue;
+        if(relativePath == PackageNames::s_SealedArchiveFileName){
+            if(!AppendSealedArchiveEntries(arena, entry.path(), outArchive))
+                return false;
+        }
+        else if(!AppendArchiveFileEntry(arena, packageDirectory, entry.path(), outArchive))
             return false;
-
-        const CrashStringT<ArenaT> pathText = PathToGenericString<char>(arena, entry.path().lexically_relative(packageDirectory));
-        AppendArchiveText(outArchive, PackageNames::s_ArchiveFileHeaderPrefix);
-        AppendArchiveText(outArchive, AStringView(pathText.data(), pathText.size()));
-        AppendArchiveText(outArchive, " ");
-        AppendArchiveUnsigned(outArchive, fileBytes.size());
-        AppendArchiveText(outArchive, "\n");
-        outArchive.insert(outArchive.end(), fileBytes.begin(), fileBytes.end());
-        AppendArchiveText(outArchive, PackageNames::s_ArchiveEntryEndText);
         wroteFile = true;
     }
 
     return wroteFile;
 }
 
+// Moves every write-once file of a pending package into one compressed archive beside the loose files that keep
+// changing after the package is written (signature, occurrence counter, upload attempt). The archive is staged under
+// a temporary name and the originals are removed only after it is renamed into place, so an interrupted seal leaves
+// either the loose package or a complete sealed one behind.
+template<typename ArenaT>
+bool SealPackageDirectory(ArenaT& arena, const ::Path<ArenaT>& packageDirectory){
+    const ::Path<ArenaT> sealedPath = packageDirectory / PackageNames::s_SealedArchiveFileName;
+    if(PathIsRegularFile(sealedPath))
+        return true;
+
+    CrashBytesT<ArenaT> archive{arena};
+    AppendArchiveText(archive, PackageNames::s_ArchiveHeaderText);
+    Vector<::Path<ArenaT>, ArenaT> sealedFiles{arena};
+
+    ErrorCode error;
+    RecursiveDirectoryIterator directory(packageDirectory, error);
+    if(error)
+        return false;
+
+    for(const auto& entry : directory){
+        ErrorCode entryError;
+        if(!entry.is_regular_file(entryError) || entryError)
+            continue;
+
+        const CrashStringT<ArenaT> relativePath = PathToGenericString<char>(arena, entry.path().lexically_relative(packageDirectory));
+        const AStringView relativePathView(relativePath.data(), relativePath.size());
+        if(IsLoosePackageFile(relativePathView) || relativePathView == PackageNames::s_SealingArchiveFileName)
+            continue;
+        if(!AppendArchiveFileEntry(arena, packageDirectory, entry.path(), archive))
+            return false;
+        sealedFiles.emplace_back(arena, entry.path());
+    }
+    if(sealedFiles.empty())
+        return true;
+
+    CrashBytesT<ArenaT> compressed{arena};
+    if(!PackageCodec::CompressArchive(arena, archive.data(), archive.size(), compressed))
+        return false;
+
+    const ::Path<ArenaT> sealingPath = packageDirectory / PackageNames::s_SealingArchiveFileName;
+    if(!WriteBinaryFile(sealingPath, compressed))
+        return false;
+    error.clear();
+    if(!RenamePath(sealingPath, sealedPath, error))
+        return false;
+
+    bool ok = true;
+    for(const ::Path<ArenaT>& sealedFile : sealedFiles){
+        error.clear();
+        if(!RemoveFile(sealedFile, error))
+            ok = false;
+    }
+    return ok;
+}
+
 template bool BuildPackageArchive(
     Alloc::GlobalArena& arena,
     const ::Path<Alloc::GlobalArena>& packageDirectory,
@@ -480,6 +715,9 @@ template bool BuildPackageArchive(
     CrashBytesT<Alloc::PersistentArena>& outArchive
 );
 
+template bool SealPackageDirectory(Alloc::GlobalArena& arena, const ::Path<Alloc::GlobalArena>& packageDirectory);
+template bool SealPackageDirectory(Alloc::PersistentArena& arena, const ::Path<Alloc::PersistentArena>& packageDirectory);
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,192 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "package_names.h"
+
+#include <global/arena_c_allocator.h>
+#include <global/fixed_buffer.h>
+#include <global/text_utils.h>
+
+#include <miniz.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_CRASH_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace PackageCodec{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace Detail{
+
+
+inline constexpr int s_CompressionLevel = MZ_DEFAULT_LEVEL;
+inline constexpr usize s_MaxStreamChunkBytes = 64u * 1024u * 1024u;
+inline constexpr usize s_OutputChunkBytes = 256u * 1024u;
+inline constexpr usize s_MaxHeaderLineBytes = 64u;
+inline constexpr usize s_HeaderTextCapacity = 64u;
+
+
+template<typename ArenaT>
+[[nodiscard]] inline void* StreamAllocate(void* const opaque, const size_t items, const size_t size){
+    return ZeroAllocateArenaCMemory(*static_cast<ArenaT*>(opaque), static_cast<usize>(items), static_cast<usize>(size));
+}
+
+template<typename ArenaT>
+inline void StreamFree(void* const opaque, void* const address){
+    DeallocateArenaCMemory(*static_cast<ArenaT*>(opaque), address);
+}
+
+template<typename ArenaT>
+inline void BindStreamArena(mz_stream& stream, ArenaT& arena){
+    stream.zalloc = &StreamAllocate<ArenaT>;
+    stream.zfree = &StreamFree<ArenaT>;
+    stream.opaque = &arena;
+}
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Compressed archive: one "NWBCRASHZ 1 <raw size>" line followed by a zlib stream of a plain NWBCRASHPKG archive.
+[[nodiscard]] inline bool IsCompressedArchive(const u8* bytes, const usize byteCount)noexcept{
+    constexpr AStringView prefix(PackageNames::s_CompressedArchiveHeaderPrefix);
+    return bytes
+        && byteCount > prefix.size()
+        && AStringView(reinterpret_cast<const char*>(bytes), prefix.size()) == prefix
+    ;
+}
+
+template<typename ArenaT>
+[[nodiscard]] inline bool CompressArchive(ArenaT& arena, const u8* bytes, const usize byteCount, Vector<u8, ArenaT>& outBytes){
+    outBytes.clear();
+    if(!bytes || byteCount == 0u)
+        return false;
+
+    char header[Detail::s_HeaderTextCapacity] = {};
+    CopyFixedBuffer(header, PackageNames::s_CompressedArchiveHeaderPrefix);
+    AppendUnsignedToFixedBuffer(header, byteCount);
+    AppendFixedBuffer(header, "\n");
+    const AStringView headerText(header);
+    outBytes.insert(outBytes.end(), headerText.begin(), headerText.end());
+
+    mz_stream stream = {};
+    Detail::BindStreamArena(stream, arena);
+    if(mz_deflateInit(&stream, Detail::s_CompressionLevel) != MZ_OK)
+        return false;
+
+    usize inputOffset = 0u;
+    int status = MZ_OK;
+    while(status == MZ_OK){
+        const usize inputChunk = Min(byteCount - inputOffset, Detail::s_MaxStreamChunkBytes);
+        const bool finalInput = inputOffset + inputChunk == byteCount;
+        const usize outputOffset = outBytes.size();
+        outBytes.resize(outputOffset + Detail::s_OutputChunkBytes);
+
+        stream.next_in = bytes + inputOffset;
+        stream.avail_in = static_cast<unsigned int>(inputChunk);
+        stream.next_out = outBytes.data() + outputOffset;
+        stream.avail_out = static_cast<unsigned int>(Detail::s_OutputChunkBytes);
+        status = mz_deflate(&stream, finalInput ? MZ_FINISH : MZ_NO_FLUSH);
+
+        inputOffset += inputChunk - stream.avail_in;
+        outBytes.resize(outBytes.size() - stream.avail_out);
+    }
+
+    const bool ok = mz_deflateEnd(&stream) == MZ_OK && status == MZ_STREAM_END;
+    if(!ok)
+        outBytes.clear();
+    return ok;
+}
+
+// `maxRawBytes` bounds the declared raw size so a hostile header cannot make the receiver allocate without limit.
+template<typename ArenaT>
+[[nodiscard]] inline bool DecompressArchive(
+    ArenaT& arena,
+    const u8* bytes,
+    const usize byteCount,
+    const usize maxRawBytes,
+    Vector<u8, ArenaT>& outBytes
+){
+    outBytes.clear();
+    if(!IsCompressedArchive(bytes, byteCount))
+        return false;
+
+    constexpr AStringView prefix(PackageNames::s_CompressedArchiveHeaderPrefix);
+    usize headerEnd = prefix.size();
+    while(headerEnd < byteCount && headerEnd < Detail::s_MaxHeaderLineBytes && bytes[headerEnd] != '\n')
+        ++headerEnd;
+    if(headerEnd >= byteCount || bytes[headerEnd] != '\n')
+        return false;
+
+    u64 rawSize = 0u;
+    const AStringView sizeText(reinterpret_cast<const char*>(bytes) + prefix.size(), headerEnd - prefix.size());
+    if(!ParseU64(sizeText, rawSize) || rawSize == 0u || rawSize > maxRawBytes)
+        return false;
+
+    const u8* payload = bytes + headerEnd + 1u;
+    const usize payloadSize = byteCount - headerEnd - 1u;
+
+    mz_stream stream = {};
+    Detail::BindStreamArena(stream, arena);
+    if(mz_inflateInit(&stream) != MZ_OK)
+        return false;
+
+    outBytes.resize(static_cast<usize>(rawSize));
+    usize inputOffset = 0u;
+    usize outputOffset = 0u;
+    int status = MZ_OK;
+    while(status == MZ_OK){
+        const usize inputChunk = Min(payloadSize - inputOffset, Detail::s_MaxStreamChunkBytes);
+        const usize outputChunk = Min(outBytes.size() - outputOffset, Detail::s_MaxStreamChunkBytes);
+
+        stream.next_in = payload + inputOffset;
+        stream.avail_in = static_cast<unsigned int>(inputChunk);
+        stream.next_out = outBytes.data() + outputOffset;
+        stream.avail_out = static_cast<unsigned int>(outputChunk);
+        status = mz_inflate(&stream, MZ_NO_FLUSH);
+
+        const usize consumed = inputChunk - stream.avail_in;
+        const usize produced = outputChunk - stream.avail_out;
+        inputOffset += consumed;
+        outputOffset += produced;
+        if(status == MZ_OK && consumed == 0u && produced == 0u)
+            break;
+    }
+
+    const bool ok = mz_inflateEnd(&stream) == MZ_OK && status == MZ_STREAM_END && outputOffset == outBytes.size();
+    if(!ok)
+        outBytes.clear();
+    return ok;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_CRASH_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -23,8 +23,26 @@ namespace Detail{
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+inline constexpr usize s_DefaultCrashUploadBatchPackages = 16u;
+inline constexpr usize s_DefaultCrashUploadBatchBytes = 4u * 1024u * 1024u;
+inline constexpr u32 s_DefaultCrashUploadAttempts = 4u;
+inline constexpr u32 s_DefaultCrashUploadBackoffMilliseconds = 250u;
+inline constexpr u32 s_DefaultCrashUploadMaxBackoffMilliseconds = 4000u;
+
+
+// One flush drains the pending spool in batches. A batch that keeps failing with a transient error is retried with
+// doubling backoff up to `maxAttempts` times, after which the flush stops and leaves the rest pending.
+struct CrashUploadPolicy{
+    usize maxBatchPackages = s_DefaultCrashUploadBatchPackages;
+    usize maxBatchBytes = s_DefaultCrashUploadBatchBytes;
+    u32 maxAttempts = s_DefaultCrashUploadAttempts;
+    u32 initialBackoffMilliseconds = s_DefaultCrashUploadBackoffMilliseconds;
+    u32 maxBackoffMilliseconds = s_DefaultCrashUploadMaxBackoffMilliseconds;
+};
+
 struct CrashUploadSnapshot{
     CrashSpoolRetentionConfig spoolRetention;
+    CrashUploadPolicy uploadPolicy;
     char spoolDirectory[s_MaxPathText] = {};
     char logServerUrl[s_MaxUrlText] = {};
     char crashUploadToken[s_MaxMediumText] = {};
@@ -44,6 +62,8 @@ template<typename ArenaT>
     CrashBytesT<ArenaT>& outArchive
 );
 template<typename ArenaT>
+[[nodiscard]] bool SealPackageDirectory(ArenaT& arena, const ::Path<ArenaT>& packageDirectory);
+template<typename ArenaT>
 [[nodiscard]] bool ApplyCrashSpoolRetention(
     ArenaT& arena,
     const ::Path<ArenaT>& spoolDirectory,
@@ -43,6 +43,10 @@ inline constexpr StringView s_AftermathGpuDumpFileName = "gpu_crash.nv-gpudmp";
 inline constexpr StringView s_SymbolicationFileName = "symbolication.txt";
 inline constexpr StringView s_ProcessDumpFileName = "process.dmp";
 inline constexpr StringView s_UploadAttemptFileName = "upload_attempt.txt";
+inline constexpr StringView s_SignatureFileName = "signature.txt";
+inline constexpr StringView s_OccurrencesFileName = "occurrences.txt";
+inline constexpr StringView s_SealedArchiveFileName = "package.nwbz";
+inline constexpr StringView s_SealingArchiveFileName = "package.nwbz.partial";
 inline constexpr StringView s_AndroidCollectionFileName = "android_collection.txt";
 inline constexpr StringView s_AndroidTombstoneFileName = "android_tombstone.txt";
 inline constexpr StringView s_AndroidEmergencyRequestFileName = "last_android_native_crash_request.bin";
@@ -77,6 +81,10 @@ inline constexpr StringView s_ArchiveHeaderText = "NWBCRASHPKG 1\n";
 inline constexpr StringView s_ArchiveFileHeaderPrefix = "FILE ";
 inline constexpr StringView s_ArchiveEntryEndLine = "END";
 inline constexpr StringView s_ArchiveEntryEndText = "\nEND\n";
+inline constexpr StringView s_CompressedArchiveHeaderPrefix = "NWBCRASHZ 1 ";
+inline constexpr StringView s_BatchHeaderLine = "NWBCRASHBATCH 1";
+inline constexpr StringView s_BatchHeaderText = "NWBCRASHBATCH 1\n";
+inline constexpr StringView s_BatchPackageHeaderPrefix = "PACKAGE ";
 inline constexpr StringView s_CrashUploadEndpoint = "/crash";
 inline constexpr StringView s_CrashUploadEndpointName = "crash";
 inline constexpr StringView s_UploadAttemptUnknownState = "unknown";
@@ -84,6 +92,12 @@ inline constexpr StringView s_UploadAttemptUploadingState = "uploading";
 inline constexpr StringView s_UploadAttemptUploadedState = "uploaded";
 inline constexpr StringView s_UploadAttemptRetryPendingState = "retry_pending";
 inline constexpr StringView s_UploadAttemptRetryInterruptedState = "retry_pending_after_interrupted_upload";
+inline constexpr StringView s_UploadAttemptRejectedState = "rejected";
+inline constexpr StringView s_SignatureKey = "signature";
+inline constexpr StringView s_OccurrenceCountKey = "count";
+inline constexpr StringView s_OccurrenceFirstCrashIdKey = "first_crash_id";
+inline constexpr StringView s_OccurrenceLastCrashIdKey = "last_crash_id";
+inline constexpr StringView s_OccurrenceLastProcessIdKey = "last_process_id";
 
 inline constexpr StringView s_ManifestFormatKey = "format";
 inline constexpr StringView s_ManifestCrashIdKey = "crash_id";
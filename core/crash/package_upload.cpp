@@ -3,9 +3,12 @@
 
 
 #include "package_internal.h"
+#include "package_codec.h"
 #include "arena_names.h"
 
+#include <global/algorithm.h>
 #include <global/filesystem/retention.h>
+#include <global/thread.h>
 
 #include <cstddef>
 
@@ -34,6 +37,19 @@ inline constexpr long s_CrashUploadConnectTimeoutMilliseconds = 1000L;
 inline constexpr long s_CrashUploadTimeoutMilliseconds = 5000L;
 inline constexpr long s_HttpSuccessStatusBegin = 200L;
 inline constexpr long s_HttpSuccessStatusEnd = 300L;
+inline constexpr long s_HttpRequestTimeoutStatus = 408L;
+inline constexpr long s_HttpTooManyRequestsStatus = 429L;
+inline constexpr long s_HttpServerErrorStatusBegin = 500L;
+inline constexpr usize s_UnsignedTextBufferCapacity = 32u;
+
+
+namespace CrashUploadStatus{
+    enum Enum : u8{
+        Uploaded,
+        Retryable,
+        Rejected,
+    };
+};
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -141,16 +157,30 @@ static CrashStringT<ArenaT> CrashUploadUrl(ArenaT& arena, const char* logServerU
     return url;
 }
 
+// Transport failures, timeouts, throttling and server errors are worth another attempt; any other non-2xx status
+// means the server will not take this body however often it is sent.
+[[nodiscard]] static CrashUploadStatus::Enum ClassifyUploadResponse(const long responseCode){
+    if(responseCode >= s_HttpSuccessStatusBegin && responseCode < s_HttpSuccessStatusEnd)
+        return CrashUploadStatus::Uploaded;
+    if(
+        responseCode == s_HttpRequestTimeoutStatus
+        || responseCode == s_HttpTooManyRequestsStatus
+        || responseCode >= s_HttpServerErrorStatusBegin
+    )
+        return CrashUploadStatus::Retryable;
+    return CrashUploadStatus::Rejected;
+}
+
 template<typename ArenaT>
-static bool UploadPackage(
+static CrashUploadStatus::Enum UploadBody(
     ArenaT& arena,
     const CrashStringT<ArenaT>& url,
-    const CrashBytesT<ArenaT>& archiveBytes,
+    const CrashBytesT<ArenaT>& bodyBytes,
     const AStringView crashUploadToken
 ){
     CURL* curl = curl_easy_init();
     if(!curl)
-        return false;
+        return CrashUploadStatus::Retryable;
 
     curl_slist* headers = nullptr;
     CrashStringT<ArenaT> authorizationHeader{arena};
@@ -161,7 +191,7 @@ static bool UploadPackage(
         headers = curl_slist_append(headers, authorizationHeader.c_str());
         if(!headers){
             curl_easy_cleanup(curl);
-            return false;
+            return CrashUploadStatus::Retryable;
         }
     }
 
@@ -171,8 +201,8 @@ static bool UploadPackage(
     ok = ok && curl_easy_setopt(curl, CURLOPT_NOSIGNAL, s_CurlOptionEnabled) == CURLE_OK;
     ok = ok && curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, s_CrashUploadConnectTimeoutMilliseconds) == CURLE_OK;
     ok = ok && curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, s_CrashUploadTimeoutMilliseconds) == CURLE_OK;
-    ok = ok && curl_easy_setopt(curl, CURLOPT_POSTFIELDS, reinterpret_cast<const char*>(archiveBytes.data())) == CURLE_OK;
-    ok = ok && curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(archiveBytes.size())) == CURLE_OK;
+    ok = ok && curl_easy_setopt(curl, CURLOPT_POSTFIELDS, reinterpret_cast<const char*>(bodyBytes.data())) == CURLE_OK;
+    ok = ok && curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(bodyBytes.size())) == CURLE_OK;
     if(headers)
         ok = ok && curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers) == CURLE_OK;
 
@@ -181,15 +211,12 @@ static bool UploadPackage(
 
     long responseCode = 0;
     if(ok)
-        ok = curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode) == CURLE_OK
-            && responseCode >= s_HttpSuccessStatusBegin
-            && responseCode < s_HttpSuccessStatusEnd
-        ;
+        ok = curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode) == CURLE_OK;
 
     if(headers)
         curl_slist_free_all(headers);
     curl_easy_cleanup(curl);
-    return ok;
+    return ok ? ClassifyUploadResponse(responseCode) : CrashUploadStatus::Retryable;
 }
 
 template<typename ArenaT>
@@ -253,41 +280,177 @@ bool ApplyCrashSpoolRetention(
 }
 
 template<typename ArenaT>
-static bool UploadPackageDirectory(
+static void AppendBatchText(CrashBytesT<ArenaT>& out, const AStringView text){
+    out.insert(out.end(), text.begin(), text.end());
+}
+
+// Every package travels compressed: a sealed one is inflated and merged with its loose files first, since the
+// occurrence counter and upload attempt state beside it have changed since it was sealed.
+template<typename ArenaT>
+static bool BuildCompressedPackageArchive(
     ArenaT& arena,
-    const ::Path<ArenaT>& spoolDirectory,
     const ::Path<ArenaT>& packageDirectory,
-    const CrashStringT<ArenaT>& url,
-    const AStringView crashUploadToken
+    CrashBytesT<ArenaT>& outCompressedArchive
 ){
-    if(url.empty())
+    CrashBytesT<ArenaT> archiveBytes{arena};
+    if(!BuildPackageArchive(arena, packageDirectory, archiveBytes))
         return false;
 
-    const ::Path<ArenaT> uploadingPackageDirectory = UploadingDirectory(spoolDirectory) / packageDirectory.filename();
-    if(!::MovePathToDirectory(packageDirectory, UploadingDirectory(spoolDirectory)))
-        return false;
+    return PackageCodec::CompressArchive(arena, archiveBytes.data(), archiveBytes.size(), outCompressedArchive);
+}
 
-    if(!WriteUploadAttemptText(arena, uploadingPackageDirectory, PackageNames::s_UploadAttemptUploadingState))
-        return false;
+template<typename ArenaT>
+static CrashUploadStatus::Enum UploadBodyWithRetry(
+    ArenaT& arena,
+    const CrashStringT<ArenaT>& url,
+    const CrashBytesT<ArenaT>& bodyBytes,
+    const AStringView crashUploadToken,
+    const CrashUploadPolicy& policy
+){
+    const u32 maxAttempts = Max(policy.maxAttempts, 1u);
+    u32 backoffMilliseconds = policy.initialBackoffMilliseconds;
+    CrashUploadStatus::Enum status = CrashUploadStatus::Retryable;
+    for(u32 attempt = 0u; attempt < maxAttempts; ++attempt){
+        if(attempt != 0u){
+            SleepMS(backoffMilliseconds);
+            backoffMilliseconds = Min(backoffMilliseconds * 2u, Max(policy.maxBackoffMilliseconds, policy.initialBackoffMilliseconds));
+        }
 
-    CrashBytesT<ArenaT> archiveBytes{arena};
-    if(!BuildPackageArchive(arena, uploadingPackageDirectory, archiveBytes)){
-        if(!::MovePathToDirectory(uploadingPackageDirectory, FailedDirectory(spoolDirectory)))
-            return false;
-        return false;
+        status = UploadBody(arena, url, bodyBytes, crashUploadToken);
+        if(status != CrashUploadStatus::Retryable)
+            break;
     }
+    return status;
+}
 
-    if(UploadPackage(arena, url, archiveBytes, crashUploadToken)){
-        if(!WriteUploadAttemptText(arena, uploadingPackageDirectory, PackageNames::s_UploadAttemptUploadedState))
-            return false;
-        return ::MovePathToDirectory(uploadingPackageDirectory, UploadedDirectory(spoolDirectory));
+template<typename ArenaT>
+static void AppendBatchPackage(CrashBytesT<ArenaT>& bodyBytes, const CrashBytesT<ArenaT>& compressedArchive){
+    char sizeText[s_UnsignedTextBufferCapacity] = {};
+    AppendUnsignedToFixedBuffer(sizeText, compressedArchive.size());
+    AppendBatchText(bodyBytes, PackageNames::s_BatchPackageHeaderPrefix);
+    AppendBatchText(bodyBytes, AStringView(sizeText));
+    AppendBatchText(bodyBytes, "\n");
+    bodyBytes.insert(bodyBytes.end(), compressedArchive.begin(), compressedArchive.end());
+    AppendBatchText(bodyBytes, PackageNames::s_ArchiveEntryEndText);
+}
+
+template<typename ArenaT>
+static CrashUploadStatus::Enum UploadBatchRange(
+    ArenaT& arena,
+    const CrashStringT<ArenaT>& url,
+    const CrashUploadSnapshot& snapshot,
+    const Vector<CrashBytesT<ArenaT>, ArenaT>& compressedArchives,
+    const usize begin,
+    const usize end
+){
+    CrashBytesT<ArenaT> bodyBytes{arena};
+    AppendBatchText(bodyBytes, PackageNames::s_BatchHeaderText);
+    for(usize i = begin; i < end; ++i)
+        AppendBatchPackage(bodyBytes, compressedArchives[i]);
+
+    return UploadBodyWithRetry(arena, url, bodyBytes, AStringView(snapshot.crashUploadToken), snapshot.uploadPolicy);
+}
+
+// Uploaded packages go to uploaded, refused ones to failed, and anything still worth retrying back to pending.
+template<typename ArenaT>
+static bool SettleUploadingPackage(
+    ArenaT& arena,
+    const ::Path<ArenaT>& spoolDirectory,
+    const ::Path<ArenaT>& uploadingPackageDirectory,
+    const CrashUploadStatus::Enum status
+){
+    AStringView state = PackageNames::s_UploadAttemptRetryPendingState;
+    ::Path<ArenaT> targetDirectory = PendingDirectory(spoolDirectory);
+    if(status == CrashUploadStatus::Uploaded){
+        state = PackageNames::s_UploadAttemptUploadedState;
+        targetDirectory = UploadedDirectory(spoolDirectory);
+    }
+    else if(status == CrashUploadStatus::Rejected){
+        state = PackageNames::s_UploadAttemptRejectedState;
+        targetDirectory = FailedDirectory(spoolDirectory);
     }
 
-    if(!WriteUploadAttemptText(arena, uploadingPackageDirectory, PackageNames::s_UploadAttemptRetryPendingState))
-        return false;
-    if(!::MovePathToDirectory(uploadingPackageDirectory, PendingDirectory(spoolDirectory)))
-        return false;
-    return false;
+    const bool wroteState = WriteUploadAttemptText(arena, uploadingPackageDirectory, state);
+    return ::MovePathToDirectory(uploadingPackageDirectory, targetDirectory) && wroteState;
+}
+
+// Claims pending packages from `inOutNextPackage` on into one batch body until the package or byte budget is spent,
+// posts it, then settles every claimed package. A package that cannot be archived is moved to failed on the spot.
+// An oversized package still travels alone rather than being stuck forever, and the archive of the package that
+// overflowed the budget is handed back in `inOutCarriedArchive` so the next batch does not compress it again.
+template<typename ArenaT>
+static CrashUploadStatus::Enum UploadPackageBatch(
+    ArenaT& arena,
+    const ::Path<ArenaT>& spoolDirectory,
+    const Vector<::Path<ArenaT>, ArenaT>& pendingPackages,
+    usize& inOutNextPackage,
+    CrashBytesT<ArenaT>& inOutCarriedArchive,
+    const CrashStringT<ArenaT>& url,
+    const CrashUploadSnapshot& snapshot,
+    bool& inOutAllUploaded
+){
+    const CrashUploadPolicy& policy = snapshot.uploadPolicy;
+    const usize maxBatchPackages = Max(policy.maxBatchPackages, static_cast<usize>(1u));
+
+    Vector<::Path<ArenaT>, ArenaT> batchPackages{arena};
+    Vector<CrashBytesT<ArenaT>, ArenaT> compressedArchives{arena};
+    usize batchBytes = PackageNames::s_BatchHeaderText.size();
+    while(inOutNextPackage < pendingPackages.size() && batchPackages.size() < maxBatchPackages){
+        const ::Path<ArenaT>& packageDirectory = pendingPackages[inOutNextPackage];
+        CrashBytesT<ArenaT> compressedArchive{arena};
+        if(!inOutCarriedArchive.empty()){
+            compressedArchive.swap(inOutCarriedArchive);
+        }
+        else if(!BuildCompressedPackageArchive(arena, packageDirectory, compressedArchive)){
+            // Either way this package did not upload; a failed move leaves it in pending for the next flush.
+            [[maybe_unused]] const bool movedToFailed = ::MovePathToDirectory(packageDirectory, FailedDirectory(spoolDirectory));
+            inOutAllUploaded = false;
+            ++inOutNextPackage;
+            continue;
+        }
+        if(!batchPackages.empty() && batchBytes + compressedArchive.size() > policy.maxBatchBytes){
+            inOutCarriedArchive.swap(compressedArchive);
+            break;
+        }
+
+        ++inOutNextPackage;
+        if(!::MovePathToDirectory(packageDirectory, UploadingDirectory(spoolDirectory))){
+            inOutAllUploaded = false;
+            continue;
+        }
+        const ::Path<ArenaT>& uploadingPackageDirectory =
+            batchPackages.emplace_back(arena, UploadingDirectory(spoolDirectory) / packageDirectory.filename())
+        ;
+        if(!WriteUploadAttemptText(arena, uploadingPackageDirectory, PackageNames::s_UploadAttemptUploadingState))
+            inOutAllUploaded = false;
+
+        batchBytes += compressedArchive.size();
+        compressedArchives.push_back(Move(compressedArchive));
+    }
+    if(batchPackages.empty())
+        return CrashUploadStatus::Uploaded;
+
+    CrashUploadStatus::Enum status = UploadBatchRange(arena, url, snapshot, compressedArchives, 0u, batchPackages.size());
+
+    // A refused batch may be down to a single package the server will never take. Resending each package alone lets
+    // its batch-mates through and parks only the refused one in failed, instead of the whole batch returning to
+    // pending and being refused again on every later flush.
+    const bool resendAlone = status == CrashUploadStatus::Rejected && batchPackages.size() > 1u;
+    for(usize i = 0u; i < batchPackages.size(); ++i){
+        // Once the server stops answering, the rest of the batch waits in pending for the next flush.
+        CrashUploadStatus::Enum packageStatus = status;
+        if(resendAlone && status != CrashUploadStatus::Retryable){
+            packageStatus = UploadBatchRange(arena, url, snapshot, compressedArchives, i, i + 1u);
+            if(packageStatus == CrashUploadStatus::Retryable)
+                status = CrashUploadStatus::Retryable;
+        }
+
+        if(!SettleUploadingPackage(arena, spoolDirectory, batchPackages[i], packageStatus))
+            inOutAllUploaded = false;
+        if(packageStatus != CrashUploadStatus::Uploaded)
+            inOutAllUploaded = false;
+    }
+    return status;
 }
 
 template<typename ArenaT>
@@ -377,7 +540,6 @@ bool FlushPendingCrashReportsImpl(ArenaT& arena, const CrashUploadSnapshot& snap
     if(!EnsureCrashCurlGlobalInit())
         return false;
 
-    bool allUploaded = true;
     const ::Path<ArenaT> pendingDirectory = PendingDirectory(spoolDirectory);
     ErrorCode error;
     if(!IsDirectory(pendingDirectory, error) || error)
@@ -387,13 +549,35 @@ bool FlushPendingCrashReportsImpl(ArenaT& arena, const CrashUploadSnapshot& snap
     if(error)
         return false;
 
+    // Sealing only happens once an upload target exists: a spool nobody drains stays readable in place.
+    bool allUploaded = true;
+    Vector<::Path<ArenaT>, ArenaT> pendingPackages{arena};
     for(const auto& entry : directory){
         ErrorCode entryError;
         if(!IsDirectory(entry.path(), entryError) || entryError || !IsSafePackageName(arena, entry.path()))
             continue;
 
-        if(!UploadPackageDirectory(arena, spoolDirectory, entry.path(), url, AStringView(snapshot.crashUploadToken)))
+        if(!SealPackageDirectory(arena, entry.path()))
             allUploaded = false;
+        pendingPackages.emplace_back(arena, entry.path());
+    }
+    Sort(pendingPackages.begin(), pendingPackages.end());
+
+    CrashBytesT<ArenaT> carriedArchive{arena};
+    for(usize nextPackage = 0u; nextPackage < pendingPackages.size();){
+        const CrashUploadStatus::Enum status = UploadPackageBatch(
+            arena,
+            spoolDirectory,
+            pendingPackages,
+            nextPackage,
+            carriedArchive,
+            url,
+            snapshot,
+            allUploaded
+        );
+        // The retry budget is spent on an unreachable or overloaded server; later batches would only repeat that.
+        if(status == CrashUploadStatus::Retryable)
+            break;
     }
 
     retentionOk = ApplyCrashSpoolRetention(arena, spoolDirectory, snapshot.spoolRetention) && retentionOk;
@@ -6,6 +6,7 @@
 
 
 #include "entity_id.h"
+#include "snapshot.h"
 #include "type_id.h"
 
 
@@ -24,6 +25,35 @@ using ComponentTypeId = usize;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// World change ticks wrap around u32. A tick is only compared against ticks at most s_MaxAge behind the current one,
+// which the world keeps true by clamping stored ticks every s_CheckInterval advances, so a signed difference orders them.
+namespace ChangeTick{
+    inline constexpr u32 s_MaxAge = 1u << 30;
+    inline constexpr u32 s_CheckInterval = 1u << 29;
+
+    [[nodiscard]] inline constexpr bool IsNewer(const u32 tick, const u32 sinceTick){
+        return static_cast<i32>(tick - sinceTick) > 0;
+    }
+    [[nodiscard]] inline constexpr u32 Clamp(const u32 tick, const u32 currentTick){
+        return currentTick - tick > s_MaxAge ? currentTick - s_MaxAge : tick;
+    }
+};
+
+
+struct ComponentTicks{
+    u32 added = 0;
+    u32 changed = 0;
+};
+
+struct RemovedComponent{
+    EntityID entity;
+    u32 tick = 0;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 namespace ECSDetail{
 
 
@@ -65,6 +95,10 @@ public:
     virtual void clear() = 0;
     virtual usize size()const = 0;
     virtual u64 mutationVersion()const = 0;
+
+    virtual void setChangeTick(u32 tick) = 0;
+    virtual void clampChangeTicks(u32 currentTick) = 0;
+    virtual void trimRemoved(u32 oldestTick) = 0;
 };
 
 
@@ -76,6 +110,12 @@ class ComponentPool final : public IComponentPool{
     friend struct ECSDetail::ViewTupleAccess;
 
 
+private:
+    // Removals past this many entries push the oldest half out even if a reader still wants them, so a world that is
+    // never ticked cannot grow the log without bound. eachRemoved() reports when that cost a reader entries.
+    static constexpr usize s_MaxRemovedEntries = 1u << 16;
+
+
 private:
     [[nodiscard]] inline bool findDenseIndex(EntityID entityId, u32& outDenseIndex)const{
         const u32 index = entityId.index();
@@ -107,7 +147,12 @@ public:
         : m_sparse(arena)
         , m_dense(arena)
         , m_components(arena)
+        , m_ticks(arena)
+        , m_removed(arena)
         , m_mutationVersion(0u)
+        , m_changeTick(0u)
+        , m_removedDiscardTick(0u)
+        , m_removedDiscarded(false)
     {}
 
 
@@ -127,6 +172,7 @@ public:
         m_sparse[index] = denseIndex;
         m_dense.push_back(entityId);
         m_components.emplace_back(Forward<Args>(args)...);
+        m_ticks.push_back(ComponentTicks{ m_changeTick, m_changeTick });
         ++m_mutationVersion;
 
         return m_components[denseIndex];
@@ -168,12 +214,17 @@ public:
             const EntityID lastEntityId = m_dense[lastDense];
             m_dense[denseIndex] = lastEntityId;
             m_components[denseIndex] = Move(m_components[lastDense]);
+            m_ticks[denseIndex] = m_ticks[lastDense];
             m_sparse[lastEntityId.index()] = denseIndex;
         }
 
         m_dense.pop_back();
         m_components.pop_back();
+        m_ticks.pop_back();
         m_sparse[index] = ~0u;
+        if(m_removed.size() >= s_MaxRemovedEntries)
+            discardRemoved(m_removed.size() / 2u);
+        m_removed.push_back(RemovedComponent{ entityId, m_changeTick });
         ++m_mutationVersion;
         return true;
     }
@@ -184,16 +235,152 @@ public:
         m_sparse.clear();
         m_dense.clear();
         m_components.clear();
+        m_ticks.clear();
+        // Clearing drops components without logging them, so readers from before now have to rescan.
+        m_removed.clear();
+        m_removedDiscardTick = m_changeTick;
+        m_removedDiscarded = true;
     }
 
     inline virtual usize size()const override{ return m_dense.size(); }
     inline virtual u64 mutationVersion()const override{ return m_mutationVersion; }
 
+
+public:
+    // Stamps the component as changed at the current tick. References handed out by get() do not track writes; views
+    // stamp the components named in View::write(), and everything else calls this for Changed<T> filters to see it.
+    inline bool markChanged(EntityID entityId){
+        u32 denseIndex = 0;
+        if(!findDenseIndex(entityId, denseIndex))
+            return false;
+        m_ticks[denseIndex].changed = m_changeTick;
+        return true;
+    }
+
+    [[nodiscard]] inline const ComponentTicks* tryGetTicks(EntityID entityId)const{
+        u32 denseIndex = 0;
+        if(!findDenseIndex(entityId, denseIndex))
+            return nullptr;
+        return &m_ticks[denseIndex];
+    }
+
+    [[nodiscard]] inline u32 changeTick()const{ return m_changeTick; }
+
+    // Visits every removal recorded after `sinceTick` in removal order. The entity may be dead or hold the component
+    // again by the time it is visited. Returns false when removals after `sinceTick` were already discarded, in which
+    // case the caller has to rescan instead of relying on the visited set.
+    template<typename Func>
+    bool eachRemoved(const u32 sinceTick, Func&& func)const{
+        for(const RemovedComponent& removed : m_removed){
+            if(ChangeTick::IsNewer(removed.tick, sinceTick))
+                func(removed.entity);
+        }
+        return !m_removedDiscarded || !ChangeTick::IsNewer(m_removedDiscardTick, sinceTick);
+    }
+
+    inline virtual void setChangeTick(const u32 tick)override{ m_changeTick = tick; }
+
+    virtual void clampChangeTicks(const u32 currentTick)override{
+        for(ComponentTicks& ticks : m_ticks){
+            ticks.added = ChangeTick::Clamp(ticks.added, currentTick);
+            ticks.changed = ChangeTick::Clamp(ticks.changed, currentTick);
+        }
+        for(RemovedComponent& removed : m_removed)
+            removed.tick = ChangeTick::Clamp(removed.tick, currentTick);
+        m_removedDiscardTick = ChangeTick::Clamp(m_removedDiscardTick, currentTick);
+    }
+
+    [[nodiscard]] inline const Vector<EntityID, Alloc::GlobalArena>& entities()const{ return m_dense; }
+
+    // Appends the dense entity ids followed by the component payload.
+    template<typename Serializer>
+    [[nodiscard]] bool appendSnapshot(WorldSnapshotBytes& outBytes)const{
+        if(AppendBinaryVectorPayload(outBytes, m_dense) != BinaryVectorPayloadFailure::None)
+            return false;
+
+        if constexpr(Serializer::s_Bulk){
+            return AppendBinaryVectorPayload(outBytes, m_components) == BinaryVectorPayloadFailure::None;
+        }
+        else{
+            for(const T& component : m_components){
+                if(!Serializer::Write(outBytes, component))
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    // Reads what appendSnapshot wrote into an empty pool, keeping the dense order. Restored components count as added
+    // at the current tick. Fails on truncated input or an entity listed twice; the pool must be cleared afterwards.
+    template<typename Serializer>
+    [[nodiscard]] bool restoreSnapshot(const BinaryByteView& bytes, usize& inOutCursor, const u32 count){
+        NWB_ASSERT(m_dense.empty());
+
+        if(ReadBinaryVectorPayload(bytes, inOutCursor, count, m_dense) != BinaryVectorPayloadFailure::None)
+            return false;
+
+        if constexpr(Serializer::s_Bulk){
+            if(ReadBinaryVectorPayload(bytes, inOutCursor, count, m_components) != BinaryVectorPayloadFailure::None)
+                return false;
+        }
+        else{
+            m_components.reserve(count);
+            for(u32 i = 0u; i < count; ++i){
+                if(!Serializer::Read(bytes, inOutCursor, m_components.emplace_back()))
+                    return false;
+            }
+        }
+
+        u32 maxIndex = 0u;
+        for(const EntityID entityId : m_dense){
+            if(!entityId.valid())
+                return false;
+            maxIndex = Max(maxIndex, entityId.index());
+        }
+        m_sparse.assign(count > 0u ? static_cast<usize>(maxIndex) + 1u : 0u, ~0u);
+        for(u32 denseIndex = 0u; denseIndex < count; ++denseIndex){
+            u32& sparse = m_sparse[m_dense[denseIndex].index()];
+            if(sparse != ~0u)
+                return false;
+            sparse = denseIndex;
+        }
+
+        m_ticks.assign(count, ComponentTicks{ m_changeTick, m_changeTick });
+        ++m_mutationVersion;
+        return true;
+    }
+
+    // Removals are recorded in tick order, so everything no newer than `oldestTick` is a prefix of the log.
+    virtual void trimRemoved(const u32 oldestTick)override{
+        usize keepBegin = 0;
+        while(keepBegin < m_removed.size() && !ChangeTick::IsNewer(m_removed[keepBegin].tick, oldestTick))
+            ++keepBegin;
+        discardRemoved(keepBegin);
+    }
+
+
+private:
+    void discardRemoved(const usize count){
+        if(count == 0)
+            return;
+
+        // The log is in tick order, so the last discarded entry carries the newest discarded tick.
+        m_removedDiscardTick = m_removed[count - 1u].tick;
+        m_removedDiscarded = true;
+        m_removed.erase(m_removed.begin(), m_removed.begin() + static_cast<isize>(count));
+    }
+
+
 private:
     Vector<u32, Alloc::GlobalArena> m_sparse;
     Vector<EntityID, Alloc::GlobalArena> m_dense;
     Vector<T, Alloc::GlobalArena> m_components;
+    Vector<ComponentTicks, Alloc::GlobalArena> m_ticks;
+    Vector<RemovedComponent, Alloc::GlobalArena> m_removed;
     u64 m_mutationVersion;
+    u32 m_changeTick;
+    u32 m_removedDiscardTick;
+    bool m_removedDiscarded;
 };
 
 
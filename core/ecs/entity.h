@@ -49,6 +49,12 @@ public:
         return m_world.getComponent<T>(m_entity);
     }
 
+    // Stamps T as changed so Changed<T> view filters visit this entity; returns false if it has no T.
+    template<typename T>
+    bool markChanged(){
+        return m_world.markComponentChanged<T>(m_entity);
+    }
+
     template<typename T>
     bool hasComponent()const{
         return m_world.hasComponent<T>(m_entity);
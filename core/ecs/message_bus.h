@@ -32,11 +32,273 @@ inline MessageTypeId MessageType(){
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+namespace ECSDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Dense index of the calling thread, used to pick its MessageBus posting segment. Indices are handed out on a thread's
+// first post and the low ones are recycled when the thread exits, so they stay close to the number of live posting
+// threads.
+class MessageThreadSlotRegistry : NoCopy{
+private:
+    static constexpr u32 s_RecycledSlotCount = 256u;
+    static constexpr u32 s_FreeMaskBits = 64u;
+    static constexpr u32 s_FreeMaskCount = s_RecycledSlotCount / s_FreeMaskBits;
+
+
+public:
+    [[nodiscard]] static MessageThreadSlotRegistry& instance(){
+        static MessageThreadSlotRegistry s_Registry;
+        return s_Registry;
+    }
+
+
+public:
+    [[nodiscard]] u32 acquire(){
+        ScopedLock lock(m_mutex);
+        for(u32 maskIndex = 0u; maskIndex < s_FreeMaskCount; ++maskIndex){
+            u64& mask = m_freeMasks[maskIndex];
+            if(mask == 0u)
+                continue;
+
+            for(u32 bit = 0u; bit < s_FreeMaskBits; ++bit){
+                const u64 bitMask = static_cast<u64>(1u) << bit;
+                if((mask & bitMask) != 0u){
+                    mask &= ~bitMask;
+                    return maskIndex * s_FreeMaskBits + bit;
+                }
+            }
+        }
+        return m_nextSlot++;
+    }
+
+    void release(const u32 slot){
+        if(slot >= s_RecycledSlotCount)
+            return;
+
+        ScopedLock lock(m_mutex);
+        m_freeMasks[slot / s_FreeMaskBits] |= static_cast<u64>(1u) << (slot % s_FreeMaskBits);
+    }
+
+
+private:
+    Futex m_mutex;
+    u64 m_freeMasks[s_FreeMaskCount] = {};
+    u32 m_nextSlot = 0u;
+};
+
+class MessageThreadSlot : NoCopy{
+public:
+    MessageThreadSlot()
+        : m_index(MessageThreadSlotRegistry::instance().acquire())
+    {}
+    ~MessageThreadSlot(){
+        MessageThreadSlotRegistry::instance().release(m_index);
+    }
+
+
+public:
+    [[nodiscard]] u32 index()const{ return m_index; }
+
+
+private:
+    u32 m_index;
+};
+
+[[nodiscard]] inline u32 CurrentMessageThreadSlot(){
+    thread_local const MessageThreadSlot s_Slot;
+    return s_Slot.index();
+}
+
+
+// Fork-join position of the posting code. The last element counts the parallel regions the current context has opened;
+// a region item appends the region's position and its item index. Keys compare lexicographically with a prefix first,
+// so posts made before a region sort ahead of its items, items sort by index, and later posts sort after the region.
+struct MessageOrderKey{
+    static constexpr u32 s_MaxDepth = 12u;
+
+    u32 path[s_MaxDepth] = {};
+    u32 depth = 1u;
+
+    [[nodiscard]] bool operator==(const MessageOrderKey& rhs)const{
+        if(depth != rhs.depth)
+            return false;
+        for(u32 i = 0u; i < depth; ++i){
+            if(path[i] != rhs.path[i])
+                return false;
+        }
+        return true;
+    }
+    [[nodiscard]] bool operator<(const MessageOrderKey& rhs)const{
+        const u32 commonDepth = depth < rhs.depth ? depth : rhs.depth;
+        for(u32 i = 0u; i < commonDepth; ++i){
+            if(path[i] != rhs.path[i])
+                return path[i] < rhs.path[i];
+        }
+        return depth < rhs.depth;
+    }
+};
+
+[[nodiscard]] inline MessageOrderKey& CurrentMessageOrderKey(){
+    thread_local MessageOrderKey s_Key;
+    return s_Key;
+}
+
+
+// Index -> pointer table that readers load without locking. Writers serialize store() among themselves; growing
+// publishes a copied table and keeps the old ones alive until destruction, so a reader holding an old table still
+// sees valid slots. The table does not own the pointees.
+template<typename T>
+class AtomicPointerTable : NoCopy{
+private:
+    static constexpr usize s_InitialCapacity = 8u;
+
+
+private:
+    struct Table{
+        GlobalUniquePtr<Atomic<T*>[]> slots;
+        usize capacity = 0u;
+    };
+
+
+public:
+    explicit AtomicPointerTable(Alloc::GlobalArena& arena)
+        : m_arena(arena)
+        , m_tables(arena)
+    {}
+
+
+public:
+    [[nodiscard]] T* load(const usize index)const noexcept{
+        const Table* table = m_current.load(MemoryOrder::acquire);
+        if(!table || index >= table->capacity)
+            return nullptr;
+        return table->slots[index].load(MemoryOrder::acquire);
+    }
+
+    void store(const usize index, T* value){
+        Table* table = m_current.load(MemoryOrder::relaxed);
+        if(!table || index >= table->capacity)
+            table = grow(index + 1u);
+        table->slots[index].store(value, MemoryOrder::release);
+    }
+
+    // Visits non-null entries in index order.
+    template<typename Func>
+    void forEach(Func&& func)const{
+        const Table* table = m_current.load(MemoryOrder::acquire);
+        if(!table)
+            return;
+
+        for(usize index = 0u; index < table->capacity; ++index){
+            T* value = table->slots[index].load(MemoryOrder::acquire);
+            if(value)
+                func(*value);
+        }
+    }
+
+
+private:
+    Table* grow(const usize minCapacity){
+        const Table* previous = m_current.load(MemoryOrder::relaxed);
+        const usize previousCapacity = previous ? previous->capacity : 0u;
+
+        usize capacity = previousCapacity > 0u ? previousCapacity * 2u : s_InitialCapacity;
+        while(capacity < minCapacity)
+            capacity *= 2u;
+
+        auto table = MakeGlobalUnique<Table>(m_arena);
+        table->slots = MakeGlobalUnique<Atomic<T*>[]>(m_arena, capacity);
+        table->capacity = capacity;
+        for(usize index = 0u; index < capacity; ++index){
+            T* value = index < previousCapacity ? previous->slots[index].load(MemoryOrder::relaxed) : nullptr;
+            table->slots[index].store(value, MemoryOrder::relaxed);
+        }
+
+        Table* raw = table.get();
+        m_tables.push_back(Move(table));
+        m_current.store(raw, MemoryOrder::release);
+        return raw;
+    }
+
+
+private:
+    Alloc::GlobalArena& m_arena;
+    Atomic<Table*> m_current{ nullptr };
+    Vector<GlobalUniquePtr<Table>, Alloc::GlobalArena> m_tables;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Opens a parallel region on the launching thread. Each item of the region runs under a MessageOrderScope built from it,
+// so messages posted by item `i` consume after those of every lower index no matter which thread ran it or when.
+class MessageOrderScope;
+
+class MessageOrderRegion : NoCopy{
+    friend class MessageOrderScope;
+
+
+public:
+    MessageOrderRegion()
+        : m_key(ECSDetail::CurrentMessageOrderKey())
+    {
+        ECSDetail::MessageOrderKey& current = ECSDetail::CurrentMessageOrderKey();
+        ++current.path[current.depth - 1u];
+    }
+
+
+private:
+    ECSDetail::MessageOrderKey m_key;
+};
+
+class MessageOrderScope : NoCopy{
+public:
+    MessageOrderScope(const MessageOrderRegion& region, const usize index)
+        : m_previous(ECSDetail::CurrentMessageOrderKey())
+    {
+        ECSDetail::MessageOrderKey key = region.m_key;
+        // Past the depth limit items share the region's key and fall back to thread-slot order among themselves.
+        if(key.depth + 2u <= ECSDetail::MessageOrderKey::s_MaxDepth){
+            key.path[key.depth] = static_cast<u32>(index);
+            key.path[key.depth + 1u] = 0u;
+            key.depth += 2u;
+        }
+        ECSDetail::CurrentMessageOrderKey() = key;
+    }
+    ~MessageOrderScope(){
+        ECSDetail::CurrentMessageOrderKey() = m_previous;
+    }
+
+
+private:
+    ECSDetail::MessageOrderKey m_previous;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Double-buffered typed message queues. Each posting thread appends to its own pending segment of the channel, so
+// post()/emplace() take no lock once the thread's segment exists. A segment splits into runs that share one
+// MessageOrderKey, and swapBuffers() publishes the runs of every segment in key order, each in posting order. Posts
+// made under MessageOrderScope (View::parallelEach and parallel scheduler stages open one per item) therefore consume in
+// the same order on every run, independent of thread count and timing. Only unscoped posts from different threads tie;
+// those fall back to thread-slot order. swapBuffers() and clear() must not run concurrently with posts; consume() may
+// run from any number of threads between swaps.
 class MessageBus : NoCopy{
 private:
     class IMessageChannel;
     using MessageChannelPtr = GlobalUniquePtr<IMessageChannel>;
-    using ChannelLock = SharedMutex::scoped_lock;
 
 
 private:
@@ -50,70 +312,61 @@ private:
         virtual void clear() = 0;
     };
 
+    struct PendingRun{
+        ECSDetail::MessageOrderKey key;
+        usize begin = 0u;
+    };
+
     template<typename T>
     class MessageChannel final : public IMessageChannel{
     private:
-        class PendingMessage{
-        public:
-            PendingMessage() = default;
-            PendingMessage(const PendingMessage&) = delete;
-            PendingMessage(PendingMessage&& rhs)noexcept(IsNothrowMoveConstructible_V<T>){
-                moveFrom(Move(rhs));
-            }
-            template<typename... Args>
-            explicit PendingMessage(InPlaceType, Args&&... args)
-                : m_value(s_InPlace, Forward<Args>(args)...)
+        struct PendingSegment{
+            explicit PendingSegment(Alloc::GlobalArena& arena)
+                : messages(arena)
+                , runs(arena)
             {}
-            ~PendingMessage() = default;
 
-            PendingMessage& operator=(const PendingMessage&) = delete;
-            PendingMessage& operator=(PendingMessage&& rhs)noexcept(IsNothrowMoveConstructible_V<T>){
-                if(this != &rhs){
-                    m_value.reset();
-                    moveFrom(Move(rhs));
-                }
-                return *this;
-            }
-
-            T& value(){
-                NWB_ASSERT(m_value.has_value());
-                return *m_value;
-            }
-
-            void reset(){
-                m_value.reset();
-            }
-
-
-        private:
-            void moveFrom(PendingMessage&& rhs)noexcept(IsNothrowMoveConstructible_V<T>){
-                if(rhs.m_value)
-                    m_value.emplace(Move(*rhs.m_value));
+            // Starts a new run when the posting thread moved to another order key since its previous post.
+            Vector<T, Alloc::GlobalArena>& messagesForPost(){
+                const ECSDetail::MessageOrderKey& key = ECSDetail::CurrentMessageOrderKey();
+                if(runs.empty() || runs.back().key != key)
+                    runs.push_back(PendingRun{ key, messages.size() });
+                return messages;
             }
 
+            Vector<T, Alloc::GlobalArena> messages;
+            Vector<PendingRun, Alloc::GlobalArena> runs;
+        };
+        using PendingSegmentPtr = GlobalUniquePtr<PendingSegment>;
 
-        private:
-            Optional<T> m_value;
+        struct MergeRun{
+            PendingSegment* segment = nullptr;
+            u32 segmentOrder = 0u;
+            u32 run = 0u;
         };
 
+
     public:
         explicit MessageChannel(Alloc::GlobalArena& arena)
-            : m_pending(arena)
+            : m_arena(arena)
+            , m_segmentTable(arena)
+            , m_segments(arena)
+            , m_mergeRuns(arena)
             , m_readBuffer(arena)
         {}
 
     public:
         void post(const T& message){
-            m_pending.emplace(s_InPlace, message);
+            currentSegment().messagesForPost().push_back(message);
         }
 
         void post(T&& message){
-            m_pending.emplace(s_InPlace, Move(message));
+            currentSegment().messagesForPost().push_back(Move(message));
         }
 
         template<typename... Args>
         void emplace(Args&&... args){
-            m_pending.emplace(s_InPlace, Forward<Args>(args)...);
+            currentSegment().messagesForPost().emplace_back(Forward<Args>(args)...);
         }
 
         template<typename Func>
@@ -128,47 +381,105 @@ private:
     public:
         virtual void swapBuffers()override{
             m_readBuffer.clear();
-            drainPending([this](T& message){ m_readBuffer.push_back(Move(message)); });
+            m_mergeRuns.clear();
+
+            u32 segmentOrder = 0u;
+            m_segmentTable.forEach([this, &segmentOrder](PendingSegment& segment){
+                for(usize run = 0u; run < segment.runs.size(); ++run)
+                    m_mergeRuns.push_back(MergeRun{ &segment, segmentOrder, static_cast<u32>(run) });
+                ++segmentOrder;
+            });
+            if(m_mergeRuns.empty())
+                return;
+
+            // Equal keys only come from unscoped posts on different threads; those keep thread-slot order.
+            Sort(m_mergeRuns.begin(), m_mergeRuns.end(), [](const MergeRun& lhs, const MergeRun& rhs){
+                const ECSDetail::MessageOrderKey& lhsKey = lhs.segment->runs[lhs.run].key;
+                const ECSDetail::MessageOrderKey& rhsKey = rhs.segment->runs[rhs.run].key;
+                if(lhsKey < rhsKey)
+                    return true;
+                if(rhsKey < lhsKey)
+                    return false;
+                if(lhs.segmentOrder != rhs.segmentOrder)
+                    return lhs.segmentOrder < rhs.segmentOrder;
+                return lhs.run < rhs.run;
+            });
+
+            // A single segment whose runs are already in order trades storage with the drained read buffer.
+            PendingSegment* firstSegment = m_mergeRuns.front().segment;
+            bool singleOrderedSegment = true;
+            for(usize i = 0u; i < m_mergeRuns.size(); ++i){
+                if(m_mergeRuns[i].segment != firstSegment || m_mergeRuns[i].run != i){
+                    singleOrderedSegment = false;
+                    break;
+                }
+            }
+            if(singleOrderedSegment){
+                Swap(m_readBuffer, firstSegment->messages);
+                firstSegment->runs.clear();
+                return;
+            }
+
+            for(const MergeRun& mergeRun : m_mergeRuns){
+                PendingSegment& segment = *mergeRun.segment;
+                const usize begin = segment.runs[mergeRun.run].begin;
+                const usize nextRun = mergeRun.run + 1u;
+                const usize end = nextRun < segment.runs.size() ? segment.runs[nextRun].begin : segment.messages.size();
+                for(usize i = begin; i < end; ++i)
+                    m_readBuffer.push_back(Move(segment.messages[i]));
+            }
+            m_segmentTable.forEach([](PendingSegment& segment){
+                segment.messages.clear();
+                segment.runs.clear();
+            });
         }
 
         virtual void clear()override{
             m_readBuffer.clear();
-            drainPending([](T& message){ static_cast<void>(message); });
+            m_segmentTable.forEach([](PendingSegment& segment){
+                segment.messages.clear();
+                segment.runs.clear();
+            });
         }
 
 
     private:
-        template<typename Func>
-        void drainPending(Func&& func){
-            PendingMessage message;
-            while(m_pending.try_pop(message)){
-                func(message.value());
-                message.reset();
-            }
+        PendingSegment& currentSegment(){
+            const u32 slot = ECSDetail::CurrentMessageThreadSlot();
+            PendingSegment* segment = m_segmentTable.load(slot);
+            if(segment)
+                return *segment;
+            return createSegment(slot);
+        }
+
+        PendingSegment& createSegment(const u32 slot){
+            ScopedLock lock(m_segmentMutex);
+
+            PendingSegmentPtr segment = MakeGlobalUnique<PendingSegment>(m_arena, m_arena);
+            NWB_ASSERT(segment);
+            PendingSegment* raw = segment.get();
+            m_segments.push_back(Move(segment));
+            m_segmentTable.store(slot, raw);
+            return *raw;
         }
 
 
     private:
-        ParallelQueue<PendingMessage, Alloc::GlobalArena> m_pending;
+        Alloc::GlobalArena& m_arena;
+        Futex m_segmentMutex;
+        ECSDetail::AtomicPointerTable<PendingSegment> m_segmentTable;
+        Vector<PendingSegmentPtr, Alloc::GlobalArena> m_segments;
+        Vector<MergeRun, Alloc::GlobalArena> m_mergeRuns;
         Vector<T, Alloc::GlobalArena> m_readBuffer;
     };
 
     using ChannelVector = Vector<MessageChannelPtr, Alloc::GlobalArena>;
 
 
-private:
-    static ChannelLock readChannelLock(SharedMutex& mutex){
-        return ChannelLock(mutex, false);
-    }
-
-    static ChannelLock writeChannelLock(SharedMutex& mutex){
-        return ChannelLock(mutex, true);
-    }
-
-
 public:
     explicit MessageBus(Alloc::GlobalArena& arena)
         : m_arena(arena)
+        , m_channelTable(arena)
         , m_channels(arena)
     {}
     ~MessageBus() = default;
@@ -215,80 +526,49 @@ public:
     }
 
     void swapBuffers(){
-        forEachChannel([](IMessageChannel& ch){ ch.swapBuffers(); });
+        m_channelTable.forEach([](IMessageChannel& ch){ ch.swapBuffers(); });
     }
 
     void clear(){
-        forEachChannel([](IMessageChannel& ch){ ch.clear(); });
+        m_channelTable.forEach([](IMessageChannel& ch){ ch.clear(); });
     }
 
 
 private:
-    template<typename Func>
-    void forEachChannel(Func&& func){
-        if(!m_hasChannels.load(MemoryOrder::acquire))
-            return;
-
-        ChannelLock lock = readChannelLock(m_channelsMutex);
-
-        for(auto& channel : m_channels){
-            if(!channel)
-                continue;
-            func(*channel);
-        }
-    }
-
     template<typename T>
     MessageChannel<T>* getOrCreateChannel(){
         const MessageTypeId typeId = MessageType<T>();
 
-        if(m_hasChannels.load(MemoryOrder::acquire)){
-            ChannelLock readLock = readChannelLock(m_channelsMutex);
-            if(typeId < m_channels.size()){
-                auto& channel = m_channels[typeId];
-                if(channel)
-                    return checked_cast<MessageChannel<T>*>(channel.get());
-            }
-        }
-
-        ChannelLock writeLock = writeChannelLock(m_channelsMutex);
-        if(typeId >= m_channels.size())
-            m_channels.resize(typeId + 1u);
+        IMessageChannel* channel = m_channelTable.load(typeId);
+        if(channel)
+            return checked_cast<MessageChannel<T>*>(channel);
 
-        auto& slot = m_channels[typeId];
-        if(slot)
-            return checked_cast<MessageChannel<T>*>(slot.get());
+        ScopedLock lock(m_channelsMutex);
+        channel = m_channelTable.load(typeId);
+        if(channel)
+            return checked_cast<MessageChannel<T>*>(channel);
 
-        auto channel = MakeGlobalUnique<MessageChannel<T>>(m_arena, m_arena);
-        auto* raw = channel.get();
-        slot = Move(channel);
-        m_hasChannels.store(true, MemoryOrder::release);
+        auto created = MakeGlobalUnique<MessageChannel<T>>(m_arena, m_arena);
+        NWB_ASSERT(created);
+        auto* raw = created.get();
+        m_channels.push_back(Move(created));
+        m_channelTable.store(typeId, raw);
         return raw;
     }
 
     template<typename T>
     const MessageChannel<T>* getChannel()const{
-        if(!m_hasChannels.load(MemoryOrder::acquire))
-            return nullptr;
-
-        const MessageTypeId typeId = MessageType<T>();
-
-        ChannelLock lock = readChannelLock(m_channelsMutex);
-
-        if(typeId >= m_channels.size())
-            return nullptr;
-
-        const auto& channel = m_channels[typeId];
+        const IMessageChannel* channel = m_channelTable.load(MessageType<T>());
         if(!channel)
             return nullptr;
-        return checked_cast<const MessageChannel<T>*>(channel.get());
+        return checked_cast<const MessageChannel<T>*>(channel);
     }
 
 
 private:
     Alloc::GlobalArena& m_arena;
-    mutable SharedMutex m_channelsMutex;
-    Atomic<bool> m_hasChannels{ false };
+    Futex m_channelsMutex;
+    ECSDetail::AtomicPointerTable<IMessageChannel> m_channelTable;
     ChannelVector m_channels;
 };
 
@@ -6,6 +6,7 @@
 
 
 #include "system.h"
+#include "message_bus.h"
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -17,6 +18,33 @@ NWB_ECS_BEGIN
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+namespace ChangeFilter{
+    enum Enum : u8{
+        None,
+        Added,
+        Changed
+    };
+};
+
+
+// View filters: keep only entities whose T was added (Added) or added or marked changed (Changed) after the tick passed
+// to View::filter. T must be one of the view's components.
+template<typename T>
+struct Added{
+    using Component = T;
+    static constexpr ChangeFilter::Enum s_Filter = ChangeFilter::Added;
+};
+
+template<typename T>
+struct Changed{
+    using Component = T;
+    static constexpr ChangeFilter::Enum s_Filter = ChangeFilter::Changed;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 namespace ECSDetail{
 
 
@@ -34,6 +62,28 @@ using ViewDenseIndexTuple = Tuple<Conditional_T<true, u32, Ts>...>;
 
 using ViewEntityVector = Vector<EntityID, Alloc::GlobalArena>;
 
+template<typename T, typename... Ts>
+struct ViewTypeIndex;
+template<typename T, typename... Ts>
+struct ViewTypeIndex<T, T, Ts...>{
+    static constexpr usize value = 0u;
+};
+template<typename T, typename U, typename... Ts>
+struct ViewTypeIndex<T, U, Ts...>{
+    static constexpr usize value = 1u + ViewTypeIndex<T, Ts...>::value;
+};
+
+template<typename T, typename... Ts>
+inline constexpr bool ViewContains_V = (IsSame_V<T, Ts> || ...);
+
+template<usize N>
+struct ViewChangeFilters{
+    ChangeFilter::Enum filters[N] = {};
+    bool writes[N] = {};
+    u32 sinceTick = 0;
+    bool active = false;
+};
+
 struct ViewTupleAccess{
     template<usize I, typename... Ts>
     static const ViewEntityVector* entityVector(const Tuple<ComponentPool<Ts>*...>& pools){
@@ -61,6 +111,31 @@ struct ViewTupleAccess{
     static auto& componentAtDense(const Tuple<ComponentPool<Ts>*...>& pools, u32 denseIndex){
         return Get<I>(pools)->m_components[denseIndex];
     }
+
+    template<usize I, usize N, typename... Ts>
+    static bool passesChangeFilter(const Tuple<ComponentPool<Ts>*...>& pools, const ViewChangeFilters<N>& filters, u32 denseIndex){
+        if(!filters.active)
+            return true;
+
+        const ComponentTicks& ticks = Get<I>(pools)->m_ticks[denseIndex];
+        switch(filters.filters[I]){
+        case ChangeFilter::Added:
+            return ChangeTick::IsNewer(ticks.added, filters.sinceTick);
+        case ChangeFilter::Changed:
+            return ChangeTick::IsNewer(ticks.changed, filters.sinceTick);
+        default:
+            return true;
+        }
+    }
+
+    template<usize I, usize N, typename... Ts>
+    static void markWritten(const Tuple<ComponentPool<Ts>*...>& pools, const ViewChangeFilters<N>& filters, u32 denseIndex){
+        if(!filters.writes[I])
+            return;
+
+        auto* pool = Get<I>(pools);
+        pool->m_ticks[denseIndex].changed = pool->m_changeTick;
+    }
 };
 
 
@@ -72,8 +147,10 @@ struct ViewIterator{
     using ComponentTuple = Tuple<ComponentPool<Ts>*...>;
     using ValueTuple = Tuple<EntityID, Ts&...>;
     using DenseIndexTuple = ViewDenseIndexTuple<Ts...>;
+    using FilterSet = ViewChangeFilters<sizeof...(Ts)>;
 
     ComponentTuple pools;
+    FilterSet filters;
     const ViewEntityVector* anchorEntities;
     usize anchorPoolIndex;
     usize index;
@@ -83,6 +160,7 @@ struct ViewIterator{
 
     ViewIterator(
         ComponentTuple poolsValue,
+        const FilterSet& filtersValue,
         const ViewEntityVector* anchorEntitiesValue,
         usize anchorPoolIndexValue,
         usize indexValue,
@@ -90,6 +168,7 @@ struct ViewIterator{
         bool validValue
     )
         : pools(Move(poolsValue))
+        , filters(filtersValue)
         , anchorEntities(anchorEntitiesValue)
         , anchorPoolIndex(anchorPoolIndexValue)
         , index(indexValue)
@@ -104,6 +183,8 @@ struct ViewIterator{
 
     void skipInvalid(){
         if constexpr(sizeof...(Ts) == 1u){
+            while(index < count && !ViewTupleAccess::passesChangeFilter<0>(pools, filters, static_cast<u32>(index)))
+                ++index;
             if(index < count){
                 entity = entityAt(index);
                 Get<0>(denseIndices) = static_cast<u32>(index);
@@ -116,7 +197,7 @@ struct ViewIterator{
 
         while(index < count){
             const EntityID entityId = entityAt(index);
-            if(resolveDenseIndices(entityId, index)){
+            if(resolveDenseIndices(entityId, index) && passesChangeFilters(IndexSequenceFor<Ts...>{})){
                 entity = entityId;
                 break;
             }
@@ -135,6 +216,11 @@ struct ViewIterator{
         return (ViewTupleAccess::findDenseIndex<Is>(pools, anchorPoolIndex, anchorDenseIndex, entityId, Get<Is>(denseIndices)) && ...);
     }
 
+    template<usize... Is>
+    bool passesChangeFilters(IndexSequence<Is...>)const{
+        return (ViewTupleAccess::passesChangeFilter<Is>(pools, filters, Get<Is>(denseIndices)) && ...);
+    }
+
     EntityID entityAt(usize denseIndex)const{
         return ViewTupleAccess::entityAt(anchorEntities, denseIndex);
     }
@@ -144,6 +230,7 @@ struct ViewIterator{
     }
     template<usize... Is>
     ValueTuple deref(IndexSequence<Is...>)const{
+        (ViewTupleAccess::markWritten<Is>(pools, filters, Get<Is>(denseIndices)), ...);
         return ::ForwardAsTuple(entity, ViewTupleAccess::componentAtDense<Is>(pools, Get<Is>(denseIndices))...);
     }
 
@@ -176,6 +263,7 @@ class View{
 public:
     using IteratorType = ECSDetail::ViewIterator<Ts...>;
     using ComponentTuple = Tuple<ComponentPool<Ts>*...>;
+    using FilterSet = ECSDetail::ViewChangeFilters<sizeof...(Ts)>;
 
 
 public:
@@ -188,17 +276,58 @@ public:
 
 public:
     IteratorType begin()const{
-        return IteratorType(m_pools, m_anchorEntities, m_anchorPoolIndex, 0, m_count, m_valid);
+        return IteratorType(m_pools, m_filters, m_anchorEntities, m_anchorPoolIndex, 0, m_count, m_valid);
     }
     IteratorType end()const{
-        return IteratorType(m_pools, m_anchorEntities, m_anchorPoolIndex, m_count, m_count, false);
+        return IteratorType(m_pools, m_filters, m_anchorEntities, m_anchorPoolIndex, m_count, m_count, false);
     }
 
+    // Candidates are the anchor pool's entries; change filters are applied while iterating and do not shrink this.
     [[nodiscard]] usize candidateCount()const noexcept{
         return m_valid ? m_count : 0u;
     }
 
 
+public:
+    // Returns a copy of the view that skips entities failing any of the Added<T>/Changed<T> filters relative to
+    // `sinceTick`, normally ISystem::lastRunTick(). Filters accumulate across calls but share the latest since tick.
+    template<typename... Filters>
+    [[nodiscard]] View filter(const u32 sinceTick)const{
+        static_assert(sizeof...(Filters) > 0, "View::filter requires at least one filter");
+
+        View result(*this);
+        result.m_filters.sinceTick = sinceTick;
+        result.m_filters.active = true;
+        (result.addFilter<Filters>(), ...);
+        return result;
+    }
+
+    template<typename T>
+    [[nodiscard]] View added(const u32 sinceTick)const{ return filter<Added<T>>(sinceTick); }
+    template<typename T>
+    [[nodiscard]] View changed(const u32 sinceTick)const{ return filter<Changed<T>>(sinceTick); }
+
+    // Returns a copy of the view that stamps each listed component as changed for every entity it hands out, so writes
+    // through the references count for Changed<T> filters without a markChanged call per entity. The stamp is taken
+    // on visit, whether or not the callback ends up writing.
+    template<typename... Us>
+    [[nodiscard]] View write()const{
+        static_assert(sizeof...(Us) > 0, "View::write requires at least one component");
+        static_assert((ECSDetail::ViewContains_V<Us, Ts...> && ...), "View::write must name the view's components");
+
+        View result(*this);
+        ((result.m_filters.writes[ECSDetail::ViewTypeIndex<Us, Ts...>::value] = true), ...);
+        return result;
+    }
+
+    // Stamps T of `entityId` as changed without a world lookup; safe from parallelEach for the visited entity.
+    template<typename T>
+    bool markChanged(const EntityID entityId)const{
+        auto* pool = Get<ECSDetail::ViewTypeIndex<T, Ts...>::value>(m_pools);
+        return pool != nullptr && pool->markChanged(entityId);
+    }
+
+
 public:
     template<typename Func>
     void each(Func&& func)const{
@@ -229,6 +358,10 @@ private:
     void applyFunc(Func& func, const usize denseIndex)const{
         const EntityID entityId = entityAt(denseIndex);
         if constexpr(sizeof...(Ts) == 1u){
+            if(!ECSDetail::ViewTupleAccess::passesChangeFilter<0>(m_pools, m_filters, static_cast<u32>(denseIndex)))
+                return;
+
+            ECSDetail::ViewTupleAccess::markWritten<0>(m_pools, m_filters, static_cast<u32>(denseIndex));
             auto& component = ECSDetail::ViewTupleAccess::componentAtDense<0>(m_pools, static_cast<u32>(denseIndex));
             func(entityId, component);
         }
@@ -242,7 +375,10 @@ private:
         if(!m_valid)
             return;
 
-        dispatch([this, &func](const usize denseIndex){
+        // Messages posted per entity consume in dense order whichever thread visited it.
+        const MessageOrderRegion messageOrder;
+        dispatch([this, &func, &messageOrder](const usize denseIndex){
+            const MessageOrderScope messageScope(messageOrder, denseIndex);
             applyFunc(func, denseIndex);
         });
     }
@@ -283,28 +419,48 @@ private:
         }
     }
 
+    template<typename Filter>
+    void addFilter(){
+        using FilterComponent = typename Filter::Component;
+        static_assert(ECSDetail::ViewContains_V<FilterComponent, Ts...>, "change filters must name one of the view's components");
+
+        // Added is the narrower filter, so it wins when both name the same component.
+        ChangeFilter::Enum& slot = m_filters.filters[ECSDetail::ViewTypeIndex<FilterComponent, Ts...>::value];
+        if(slot != ChangeFilter::Added)
+            slot = Filter::s_Filter;
+    }
+
     EntityID entityAt(usize denseIndex)const{
         return ECSDetail::ViewTupleAccess::entityAt(m_anchorEntities, denseIndex);
     }
 
+    // Returns whether `func` ran; written components are only stamped once every component was found and passed.
     template<usize I = 0, typename Func, typename... Args>
-    void tryApplyFunc(Func& func, EntityID entityId, usize denseIndex, Args&... args)const{
+    bool tryApplyFunc(Func& func, EntityID entityId, usize denseIndex, Args&... args)const{
         if constexpr(I < sizeof...(Ts)){
             u32 componentDenseIndex = 0;
             if(!ECSDetail::ViewTupleAccess::findDenseIndex<I>(m_pools, m_anchorPoolIndex, denseIndex, entityId, componentDenseIndex))
-                return;
+                return false;
+            if(!ECSDetail::ViewTupleAccess::passesChangeFilter<I>(m_pools, m_filters, componentDenseIndex))
+                return false;
 
             auto& component = ECSDetail::ViewTupleAccess::componentAtDense<I>(m_pools, componentDenseIndex);
-            tryApplyFunc<I + 1u>(func, entityId, denseIndex, args..., component);
+            if(!tryApplyFunc<I + 1u>(func, entityId, denseIndex, args..., component))
+                return false;
+
+            ECSDetail::ViewTupleAccess::markWritten<I>(m_pools, m_filters, componentDenseIndex);
+            return true;
         }
         else{
             func(entityId, args...);
+            return true;
         }
     }
 
 
 private:
     ComponentTuple m_pools;
+    FilterSet m_filters;
     const ECSDetail::ViewEntityVector* m_anchorEntities = nullptr;
     usize m_anchorPoolIndex = 0;
     usize m_count = 0;
@@ -0,0 +1,77 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "global.h"
+
+#include <global/binary.h>
+#include <global/name.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ECS_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// World snapshot layout, native endian:
+//   WorldSnapshotHeader
+//   u16 generation[entitySlotCount]
+//   u32 freeEntityIndex[freeEntityCount], in EntityManager reuse order
+//   per registered component type: WorldSnapshotComponentHeader, EntityID[count] in dense order, component payload
+// Bump s_WorldSnapshotVersion whenever this layout changes.
+inline constexpr u32 s_WorldSnapshotMagic = 0x534E574Eu; // NWNS
+inline constexpr u16 s_WorldSnapshotVersion = 1u;
+
+using WorldSnapshotBytes = Vector<u8, Alloc::GlobalArena>;
+
+struct WorldSnapshotHeader{
+    u32 magic = s_WorldSnapshotMagic;
+    u16 version = s_WorldSnapshotVersion;
+    u16 headerSize = sizeof(WorldSnapshotHeader);
+    u32 entitySlotCount = 0u;
+    u32 freeEntityCount = 0u;
+    u32 componentSectionCount = 0u;
+};
+
+// `elementBytes` is sizeof(T) for bulk sections and zero for custom ones; `payloadBytes` covers the entity ids and
+// component payload so readers can skip types they do not register.
+struct WorldSnapshotComponentHeader{
+    NameHash key = {};
+    u32 count = 0u;
+    u32 elementBytes = 0u;
+    u64 payloadBytes = 0u;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Default snapshot serializer: a pool's dense component array is written and restored with one copy, padding included.
+// A custom serializer instead sets s_Bulk to false and provides
+//   static bool Write(WorldSnapshotBytes& outBytes, const T& component);
+//   static bool Read(const BinaryByteView& bytes, usize& inOutCursor, T& outComponent);
+// where Read consumes exactly what Write appended and fills a default-constructed component.
+template<typename T>
+struct TrivialComponentSerializer{
+    static_assert(IsTriviallyCopyable_V<T>, "bulk snapshot components must be trivially copyable");
+    static_assert(IsDefaultConstructible_V<T>, "bulk snapshot components must be default constructible");
+
+    static constexpr bool s_Bulk = true;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ECS_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
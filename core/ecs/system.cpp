@@ -85,6 +85,7 @@ void mergeSystemAccess(StageAccessContainer& stageAccesses, const SystemAccessCo
 
 ISystem::ISystem(Alloc::GlobalArena& arena)
     : m_access(arena)
+    , m_lastRunTick(0u)
 {}
 
 
@@ -228,19 +229,28 @@ void SystemScheduler::execute(World& world, f32 delta){
 
     Alloc::ThreadPool& pool = world.taskPool();
 
+    // Every stage writes at its own tick and the tick advances past the last stage, so a system sees writes from later
+    // stages of the previous frame, earlier stages of this one and from outside the scheduler, but never its own.
     for(auto& stage : m_stages){
+        const u32 changeTick = world.changeTick();
         if(stage.size() == 1){
             stage[0]->update(world, delta);
+            stage[0]->m_lastRunTick = changeTick;
         }
         else{
+            // Messages from a parallel stage consume in the stage's system order, as if the systems ran one by one.
+            const MessageOrderRegion messageOrder;
             pool.parallelFor(
                 static_cast<usize>(0),
                 stage.size(),
-                [&stage, &world, delta](usize i){
+                [&stage, &world, delta, changeTick, &messageOrder](usize i){
+                    const MessageOrderScope messageScope(messageOrder, i);
                     stage[i]->update(world, delta);
+                    stage[i]->m_lastRunTick = changeTick;
                 }
             );
         }
+        world.advanceChangeTick();
     }
 }
 
@@ -51,6 +51,7 @@ class World;
 
 class ISystem{
     friend class SystemScheduler;
+    friend class World;
 
 
 public:
@@ -66,6 +67,10 @@ public:
 
 
 protected:
+    // The world change tick of this system's previous update; pass it to View::filter and World::eachRemoved to visit
+    // only what changed since then. Before the first update it reaches back ChangeTick::s_MaxAge ticks.
+    [[nodiscard]] inline u32 lastRunTick()const{ return m_lastRunTick; }
+
     template<typename T>
     inline void readAccess(){
         registerAccess(ComponentType<T>(), AccessMode::Read);
@@ -78,6 +83,7 @@ protected:
 
 private:
     Vector<ComponentAccess, Alloc::GlobalArena> m_access;
+    u32 m_lastRunTick;
 };
 
 
@@ -26,6 +26,9 @@ World::World(Alloc::GlobalArena& arena, Alloc::ThreadPool& threadPool)
     , m_systems(m_arena)
     , m_scheduler(m_arena)
     , m_messageBus(m_arena)
+    , m_snapshotComponents(m_arena)
+    , m_changeTick(1u)
+    , m_lastChangeTickCheck(1u)
 {}
 World::~World(){
     clear();
@@ -65,8 +68,10 @@ void World::removeSystem(ISystem& system){
 
 
 void World::tick(f32 delta){
+    const u32 frameBeginTick = m_changeTick;
     m_messageBus.swapBuffers();
     m_scheduler.execute(*this, delta);
+    trimRemovedComponents(frameBeginTick);
 }
 
 void World::clear(){
@@ -74,6 +79,7 @@ void World::clear(){
     m_messageBus.clear();
     m_scheduler.clear();
     m_systems.clear();
+    m_snapshotComponents.clear();
     m_pools.clear();
     m_entityComponentHeads.clear();
     m_entityComponentNodes.clear();
@@ -82,6 +88,205 @@ void World::clear(){
 }
 
 
+bool World::writeSnapshot(WorldSnapshotBytes& outBytes)const{
+    outBytes.clear();
+
+    const auto& generations = m_entityManager.m_generations;
+    const auto& freeIndices = m_entityManager.m_freeIndices;
+
+    WorldSnapshotHeader header;
+    header.entitySlotCount = static_cast<u32>(generations.size());
+    header.freeEntityCount = static_cast<u32>(freeIndices.size());
+    header.componentSectionCount = static_cast<u32>(m_snapshotComponents.size());
+
+    // Bulk sections are sized exactly up front so the dense arrays land with one copy each and no regrowth.
+    usize reserveBytes = sizeof(WorldSnapshotHeader);
+    bool reserveValid = AddBinaryVectorReserveBytes(reserveBytes, generations)
+        && AddBinaryVectorReserveBytes(reserveBytes, freeIndices)
+    ;
+    for(const SnapshotComponentEntry& entry : m_snapshotComponents){
+        auto itr = m_pools.find(entry.typeId);
+        const usize count = itr != m_pools.end() ? itr.value()->size() : 0u;
+        reserveValid = reserveValid
+            && AddBinaryReserveBytes(reserveBytes, sizeof(WorldSnapshotComponentHeader))
+            && AddBinaryRepeatedReserveBytes(reserveBytes, count, sizeof(EntityID) + entry.elementBytes)
+        ;
+    }
+    if(!reserveValid)
+        return false;
+    outBytes.reserve(reserveBytes);
+
+    AppendPOD(outBytes, header);
+    if(AppendBinaryVectorPayload(outBytes, generations) != BinaryVectorPayloadFailure::None)
+        return false;
+    if(AppendBinaryVectorPayload(outBytes, freeIndices) != BinaryVectorPayloadFailure::None)
+        return false;
+
+    for(const SnapshotComponentEntry& entry : m_snapshotComponents){
+        auto itr = m_pools.find(entry.typeId);
+        const IComponentPool* pool = itr != m_pools.end() ? itr.value().get() : nullptr;
+
+        WorldSnapshotComponentHeader componentHeader;
+        componentHeader.key = entry.key;
+        componentHeader.count = pool ? static_cast<u32>(pool->size()) : 0u;
+        componentHeader.elementBytes = entry.elementBytes;
+
+        const usize headerOffset = outBytes.size();
+        AppendPOD(outBytes, componentHeader);
+        if(pool && !entry.append(*pool, outBytes))
+            return false;
+
+        // Custom payload sizes are only known once written, so the header is patched afterwards.
+        componentHeader.payloadBytes = static_cast<u64>(outBytes.size() - headerOffset - sizeof(WorldSnapshotComponentHeader));
+        NWB_MEMCPY(outBytes.data() + headerOffset, sizeof(componentHeader), &componentHeader, sizeof(componentHeader));
+    }
+
+    return true;
+}
+
+
+bool World::restoreSnapshot(const BinaryByteView& bytes){
+    taskPool().wait();
+
+    clearEntities();
+    if(readSnapshot(bytes))
+        return true;
+
+    clearEntities();
+    return false;
+}
+
+
+void World::clearEntities(){
+    for(const auto& [_, pool] : m_pools)
+        pool->clear();
+    m_entityComponentHeads.clear();
+    m_entityComponentNodes.clear();
+    m_freeEntityComponentNode = s_InvalidEntityComponentNode;
+    m_entityManager.clear();
+}
+
+
+bool World::readSnapshot(const BinaryByteView& bytes){
+    usize cursor = 0u;
+    WorldSnapshotHeader header;
+    if(!ReadPOD(bytes, cursor, header))
+        return false;
+    if(
+        header.magic != s_WorldSnapshotMagic
+        || header.version != s_WorldSnapshotVersion
+        || header.headerSize != sizeof(WorldSnapshotHeader)
+        || header.entitySlotCount > ECSDetail::ENTITY_INVALID_INDEX
+        || header.freeEntityCount > header.entitySlotCount
+    )
+        return false;
+
+    auto& generations = m_entityManager.m_generations;
+    auto& freeIndices = m_entityManager.m_freeIndices;
+    if(ReadBinaryVectorPayload(bytes, cursor, header.entitySlotCount, generations) != BinaryVectorPayloadFailure::None)
+        return false;
+    if(ReadBinaryVectorPayload(bytes, cursor, header.freeEntityCount, freeIndices) != BinaryVectorPayloadFailure::None)
+        return false;
+
+    for(const u16 generation : generations){
+        if(generation > ECSDetail::ENTITY_GENERATION_MASK)
+            return false;
+    }
+
+    // Until the sections are linked, free slots carry a dead marker: a free index listed twice would be handed out to
+    // two entities, and a component listed for a free slot would belong to no live entity.
+    m_entityComponentHeads.assign(generations.size(), s_InvalidEntityComponentNode);
+    for(const u32 index : freeIndices){
+        if(index >= header.entitySlotCount || m_entityComponentHeads[index] == s_DeadEntityComponentHead)
+            return false;
+        m_entityComponentHeads[index] = s_DeadEntityComponentHead;
+    }
+    m_entityManager.m_aliveCount = static_cast<usize>(header.entitySlotCount - header.freeEntityCount);
+
+    for(u32 sectionIndex = 0u; sectionIndex < header.componentSectionCount; ++sectionIndex){
+        WorldSnapshotComponentHeader componentHeader;
+        if(!ReadPOD(bytes, cursor, componentHeader))
+            return false;
+        if(!BinaryDetail::CanReadBytes(bytes, cursor, componentHeader.payloadBytes))
+            return false;
+
+        const SnapshotComponentEntry* entry = nullptr;
+        for(const SnapshotComponentEntry& candidate : m_snapshotComponents){
+            if(candidate.key == componentHeader.key){
+                entry = &candidate;
+                break;
+            }
+        }
+
+        const usize payloadEnd = cursor + static_cast<usize>(componentHeader.payloadBytes);
+        if(!entry){
+            cursor = payloadEnd;
+            continue;
+        }
+        if(entry->elementBytes != componentHeader.elementBytes)
+            return false;
+
+        auto itr = m_pools.find(entry->typeId);
+        if(itr != m_pools.end() && itr.value()->size() != 0u)
+            return false;
+        if(!entry->restore(*this, bytes, cursor, componentHeader.count) || cursor != payloadEnd)
+            return false;
+    }
+
+    for(const u32 index : freeIndices)
+        m_entityComponentHeads[index] = s_InvalidEntityComponentNode;
+    return cursor == bytes.size();
+}
+
+
+bool World::linkRestoredComponents(ComponentTypeId typeId, IComponentPool& pool, const EntityID* entities, usize count){
+    if(count > static_cast<usize>(Limit<u32>::s_Max) - m_entityComponentNodes.size())
+        return false;
+    m_entityComponentNodes.reserve(m_entityComponentNodes.size() + count);
+
+    for(usize i = 0u; i < count; ++i){
+        const EntityID entityId = entities[i];
+        if(!m_entityManager.alive(entityId))
+            return false;
+
+        u32& headNode = m_entityComponentHeads[entityId.index()];
+        if(headNode == s_DeadEntityComponentHead)
+            return false;
+        headNode = acquireEntityComponentNode(typeId, pool, headNode);
+    }
+    return true;
+}
+
+
+void World::advanceChangeTick(){
+    ++m_changeTick;
+    for(const auto& [_, pool] : m_pools)
+        pool->setChangeTick(m_changeTick);
+
+    if(m_changeTick - m_lastChangeTickCheck < ChangeTick::s_CheckInterval)
+        return;
+
+    m_lastChangeTickCheck = m_changeTick;
+    for(const auto& [_, pool] : m_pools)
+        pool->clampChangeTicks(m_changeTick);
+    for(SystemEntry& entry : m_systems)
+        entry.system->m_lastRunTick = ChangeTick::Clamp(entry.system->m_lastRunTick, m_changeTick);
+}
+
+
+void World::trimRemovedComponents(const u32 frameBeginTick){
+    // Keep removals newer than the stalest system's last run; without systems they survive one frame for outside readers.
+    u32 oldestTick = frameBeginTick;
+    for(const SystemEntry& entry : m_systems){
+        if(ChangeTick::IsNewer(oldestTick, entry.system->m_lastRunTick))
+            oldestTick = entry.system->m_lastRunTick;
+    }
+
+    for(const auto& [_, pool] : m_pools)
+        pool->trimRemoved(oldestTick);
+}
+
+
 void World::destroyEntityComponents(EntityID entityId){
     const usize index = static_cast<usize>(entityId.index());
     if(index >= m_entityComponentHeads.size())
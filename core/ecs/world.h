@@ -26,6 +26,7 @@ class Entity;
 
 class World : NoCopy, public Alloc::ITaskScheduler{
     friend class Entity;
+    friend class SystemScheduler;
 
 
 private:
@@ -50,7 +51,16 @@ private:
         SystemPtr system;
     };
 
+    struct SnapshotComponentEntry{
+        NameHash key;
+        ComponentTypeId typeId;
+        u32 elementBytes;
+        bool (*append)(const IComponentPool& pool, WorldSnapshotBytes& outBytes);
+        bool (*restore)(World& world, const BinaryByteView& bytes, usize& inOutCursor, u32 count);
+    };
+
     static constexpr u32 s_InvalidEntityComponentNode = Limit<u32>::s_Max;
+    static constexpr u32 s_DeadEntityComponentHead = Limit<u32>::s_Max - 1u;
 
 
 public:
@@ -91,6 +101,25 @@ public:
         return pool ? pool->mutationVersion() : 0u;
     }
 
+    // Tick stamped on component adds, removals and markChanged calls made now.
+    [[nodiscard]] u32 changeTick()const{ return m_changeTick; }
+
+    template<typename T>
+    [[nodiscard]] const ComponentTicks* tryGetComponentTicks(EntityID entityId)const{
+        const auto* pool = getPool<T>();
+        return pool ? pool->tryGetTicks(entityId) : nullptr;
+    }
+
+    // Visits entities whose T was removed (or destroyed with them) after `sinceTick`. Removals stay queryable until
+    // every system added to this world has run past them, or until the per-pool log cap pushes them out. Returns false
+    // when some removal after `sinceTick` may be missing, including when the world has no pool for T (clear() drops
+    // pools with their logs); a reader that keeps per-entity state then rescans.
+    template<typename T, typename Func>
+    bool eachRemoved(u32 sinceTick, Func&& func)const{
+        const auto* pool = getPool<T>();
+        return pool ? pool->eachRemoved(sinceTick, Forward<Func>(func)) : false;
+    }
+
 
 private:
     template<typename T, typename... Args>
@@ -127,6 +156,12 @@ private:
         return requirePool<T>().get(entityId);
     }
 
+    template<typename T>
+    bool markComponentChanged(EntityID entityId){
+        auto* pool = getPool<T>();
+        return pool ? pool->markChanged(entityId) : false;
+    }
+
     template<typename T>
     bool hasComponent(EntityID entityId)const{
         auto* pool = getPool<T>();
@@ -141,6 +176,7 @@ public:
 
         auto ptr = MakeGlobalUnique<T>(m_arena, m_arena, Forward<Args>(args)...);
         T& ref = *ptr;
+        ref.m_lastRunTick = m_changeTick - ChangeTick::s_MaxAge;
         m_scheduler.addSystem(ref);
         m_systems.push_back(SystemEntry{ SystemType<T>(), Move(ptr) });
         return ref;
@@ -196,6 +232,38 @@ public:
     void clearMessages(){ m_messageBus.clear(); }
 
 
+public:
+    // Opts T into world snapshots under `name`, which must stay stable across builds. Types without a registration are
+    // neither written nor restored. Serializer defaults to the bulk copy; see snapshot.h for custom serializers.
+    template<typename T, typename Serializer = TrivialComponentSerializer<T>>
+    void registerSnapshotComponent(const Name& name){
+        const ComponentTypeId typeId = ComponentType<T>();
+        const NameHash& key = name.hash();
+        for(const SnapshotComponentEntry& entry : m_snapshotComponents){
+            NWB_ASSERT_MSG(entry.key != key || entry.typeId == typeId, NWB_TEXT("snapshot component name registered twice"));
+            if(entry.typeId == typeId)
+                return;
+        }
+
+        m_snapshotComponents.push_back(SnapshotComponentEntry{
+            key,
+            typeId,
+            Serializer::s_Bulk ? static_cast<u32>(sizeof(T)) : 0u,
+            &World::appendSnapshotComponents<T, Serializer>,
+            &World::restoreSnapshotComponents<T, Serializer>
+        });
+    }
+
+    // Writes entities (generations and free list included) and every registered component pool in dense order, so a
+    // restored world snapshots to identical bytes and recreates entities with the same ids.
+    [[nodiscard]] bool writeSnapshot(WorldSnapshotBytes& outBytes)const;
+
+    // Replaces all entities and components with the snapshot's. Components of unregistered types are dropped and
+    // snapshot sections this world does not register are skipped. Systems and messages are kept; restored components
+    // count as added at the current tick. On malformed input the world is left without entities and false is returned.
+    [[nodiscard]] bool restoreSnapshot(const BinaryByteView& bytes);
+
+
 public:
     void tick(f32 delta);
     void clear();
@@ -231,6 +299,7 @@ private:
 
         auto pool = MakeGlobalUnique<ComponentPool<T>>(m_arena, m_arena);
         auto* raw = pool.get();
+        raw->setChangeTick(m_changeTick);
         m_pools.emplace(typeId, Move(pool));
         return raw;
     }
@@ -255,6 +324,28 @@ private:
     u32 acquireEntityComponentNode(ComponentTypeId typeId, IComponentPool& pool, u32 nextNode);
     void releaseEntityComponentNode(u32 nodeIndex);
 
+    template<typename T, typename Serializer>
+    static bool appendSnapshotComponents(const IComponentPool& pool, WorldSnapshotBytes& outBytes){
+        return checked_cast<const ComponentPool<T>*>(&pool)->template appendSnapshot<Serializer>(outBytes);
+    }
+
+    template<typename T, typename Serializer>
+    static bool restoreSnapshotComponents(World& world, const BinaryByteView& bytes, usize& inOutCursor, const u32 count){
+        ComponentPool<T>* pool = world.assurePool<T>();
+        if(!pool->template restoreSnapshot<Serializer>(bytes, inOutCursor, count))
+            return false;
+
+        const auto& entities = pool->entities();
+        return world.linkRestoredComponents(ComponentType<T>(), *pool, entities.data(), entities.size());
+    }
+
+    void clearEntities();
+    bool readSnapshot(const BinaryByteView& bytes);
+    bool linkRestoredComponents(ComponentTypeId typeId, IComponentPool& pool, const EntityID* entities, usize count);
+
+    void advanceChangeTick();
+    void trimRemovedComponents(u32 frameBeginTick);
+
 
 private:
     Alloc::GlobalArena& m_arena;
@@ -267,6 +358,9 @@ private:
     Vector<SystemEntry, Alloc::GlobalArena> m_systems;
     SystemScheduler m_scheduler;
     MessageBus m_messageBus;
+    Vector<SnapshotComponentEntry, Alloc::GlobalArena> m_snapshotComponents;
+    u32 m_changeTick;
+    u32 m_lastChangeTickCheck;
 };
 
 
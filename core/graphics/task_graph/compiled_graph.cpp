@@ -27,6 +27,8 @@ GpuCompiledGraph::GpuCompiledGraph(GraphicsArena& arena)
     , m_epilogueBarriers(arena)
     , m_externalResourceExports(arena)
     , m_externalResourceExportSources(arena)
+    , m_transientResources(arena)
+    , m_transientAliasingBarriers(arena)
     , m_queueTopology(arena)
 {}
 
@@ -42,8 +44,11 @@ void GpuCompiledGraph::reset(){
     m_epilogueBarriers.clear();
     m_externalResourceExports.clear();
     m_externalResourceExportSources.clear();
+    m_transientResources.clear();
+    m_transientAliasingBarriers.clear();
     m_queueTopology.clear();
     m_presentEndpoint = {};
+    m_transientAllocationAlignment = 0u;
     m_generation = 0u;
     m_declarationRevision = 0u;
     m_planGeneration = 0u;
@@ -316,6 +321,43 @@ const GpuCompiledBarrier* GpuCompiledGraph::taskEpilogueBarriers(const GpuTaskId
     return m_epilogueBarriers.data() + compiledTask->epilogueBarrierOffset;
 }
 
+const GpuCompiledTransientAliasingBarrier* GpuCompiledGraph::taskTransientAliasingBarriers(
+    const GpuTaskId& task
+)const noexcept{
+    const GpuCompiledTask* const compiledTask = findTask(task);
+    if(
+        !compiledTask
+        || compiledTask->transientAliasingBarrierCount == 0u
+        || compiledTask->transientAliasingBarrierOffset > m_transientAliasingBarriers.size()
+        || compiledTask->transientAliasingBarrierCount
+            > m_transientAliasingBarriers.size() - compiledTask->transientAliasingBarrierOffset
+    )
+        return nullptr;
+    return m_transientAliasingBarriers.data() + compiledTask->transientAliasingBarrierOffset;
+}
+
+const GpuCompiledTransientResource* GpuCompiledGraph::transientResourceAt(const usize index)const noexcept{
+    return index < m_transientResources.size() ? &m_transientResources[index] : nullptr;
+}
+
+const GpuCompiledTransientResource* GpuCompiledGraph::transientResource(
+    const GpuGraphResourceId& resource
+)const noexcept{
+    if(!resource.valid() || resource.generation != m_generation)
+        return nullptr;
+    for(const GpuCompiledTransientResource& transient : m_transientResources){
+        if(transient.resource == resource)
+            return &transient;
+    }
+    return nullptr;
+}
+
+const GpuCompiledTransientAliasingBarrier* GpuCompiledGraph::transientAliasingBarrierAt(
+    const usize index
+)const noexcept{
+    return index < m_transientAliasingBarriers.size() ? &m_transientAliasingBarriers[index] : nullptr;
+}
+
 const GpuCompiledExternalResourceExport* GpuCompiledGraph::externalResourceExport(
     const GpuGraphResourceId& resource
 )const noexcept{
@@ -79,6 +79,33 @@ struct GpuCompiledTask{
     u32 prologueBarrierCount = 0u;
     u32 epilogueBarrierOffset = 0u;
     u32 epilogueBarrierCount = 0u;
+    u32 transientAliasingBarrierOffset = 0u;
+    u32 transientAliasingBarrierCount = 0u;
+};
+
+// Compiler placement of one used graph-owned transient inside the shared transient allocation. The lifetime spans
+// compiler topological order from the first to the last task that declares a use; `queue` is the physical queue of
+// the first use. Unused transients receive no placement.
+struct GpuCompiledTransientResource{
+    GpuGraphResourceId resource;
+    GpuTaskId firstTask;
+    GpuTaskId lastTask;
+    GpuPhysicalQueueId queue;
+    u64 offset = 0u;
+    u64 byteSize = 0u;
+    u64 alignment = 0u;
+    // True when the placement reuses memory an earlier transient occupied in this plan.
+    bool aliased = false;
+};
+
+// The first use of `after` reuses memory last used by `before`. It belongs to the task that first uses `after`:
+// before that task's prologue barriers move `after` out of UNDEFINED, the runtime realizing the placement must make
+// the earlier accesses to `before` complete on `queue`.
+struct GpuCompiledTransientAliasingBarrier{
+    GpuTaskId task;
+    GpuPhysicalQueueId queue;
+    GpuGraphResourceId before;
+    GpuGraphResourceId after;
 };
 
 // One terminal declared range that contributes to an explicit graph-to-external release.  Textures may have
@@ -184,6 +211,14 @@ struct GpuTaskGraphCompileStatistics{
     f64 packetizationSeconds = 0.0;
     f64 resourceStatePlanningSeconds = 0.0;
     f64 packetDependencyPlanningSeconds = 0.0;
+    // Transient packing: peak bytes is the size of the shared allocation after aliasing, unaliased bytes the sum a
+    // dedicated allocation per transient would need.
+    usize transientResourceCount = 0u;
+    usize aliasedTransientResourceCount = 0u;
+    usize transientAliasingBarrierCount = 0u;
+    u64 transientPeakBytes = 0u;
+    u64 transientUnaliasedBytes = 0u;
+    f64 transientPlanningSeconds = 0.0;
 
     [[nodiscard]] bool valid()const noexcept{ return graphGeneration != 0u && planGeneration != 0u; }
 };
@@ -285,6 +320,18 @@ public:
     [[nodiscard]] const GpuPacketStateSeed* taskPrologueStateSeeds(const GpuTaskId& task)const noexcept;
     [[nodiscard]] const GpuCompiledBarrier* taskPrologueBarriers(const GpuTaskId& task)const noexcept;
     [[nodiscard]] const GpuCompiledBarrier* taskEpilogueBarriers(const GpuTaskId& task)const noexcept;
+    [[nodiscard]] const GpuCompiledTransientAliasingBarrier* taskTransientAliasingBarriers(
+        const GpuTaskId& task
+    )const noexcept;
+    // Transient placements in packing order. The shared allocation must provide transientAllocationBytes() with
+    // transientAllocationAlignment(); callers create it once per plan and bind each virtual resource at its offset.
+    [[nodiscard]] usize transientResourceCount()const noexcept{ return m_transientResources.size(); }
+    [[nodiscard]] const GpuCompiledTransientResource* transientResourceAt(usize index)const noexcept;
+    [[nodiscard]] const GpuCompiledTransientResource* transientResource(const GpuGraphResourceId& resource)const noexcept;
+    [[nodiscard]] usize transientAliasingBarrierCount()const noexcept{ return m_transientAliasingBarriers.size(); }
+    [[nodiscard]] const GpuCompiledTransientAliasingBarrier* transientAliasingBarrierAt(usize index)const noexcept;
+    [[nodiscard]] u64 transientAllocationBytes()const noexcept{ return m_compileStatistics.transientPeakBytes; }
+    [[nodiscard]] u64 transientAllocationAlignment()const noexcept{ return m_transientAllocationAlignment; }
     // Resolves the terminal graph-to-external release declaration for this imported resource. No result means the
     // resource did not request a graph-to-external handoff in this compiled generation.
     [[nodiscard]] const GpuCompiledExternalResourceExport* externalResourceExport(
@@ -322,8 +369,11 @@ private:
     GraphicsVector<GpuCompiledBarrier> m_epilogueBarriers;
     GraphicsVector<GpuCompiledExternalResourceExport> m_externalResourceExports;
     GraphicsVector<GpuCompiledExternalResourceExportSource> m_externalResourceExportSources;
+    GraphicsVector<GpuCompiledTransientResource> m_transientResources;
+    GraphicsVector<GpuCompiledTransientAliasingBarrier> m_transientAliasingBarriers;
     GraphicsVector<GpuPhysicalQueueInfo> m_queueTopology;
     GpuCompiledPresentEndpoint m_presentEndpoint;
+    u64 m_transientAllocationAlignment = 0u;
     u64 m_generation = 0u;
     u64 m_declarationRevision = 0u;
     u64 m_planGeneration = 0u;
@@ -51,6 +51,9 @@ bool GpuTaskGraphCompiler::compile(
             for(usize useIndex = 0u; useIndex < task.resourceUseCount; ++useIndex){
                 const GpuTaskResourceUse& use = task.resourceUses[useIndex];
                 const GpuTaskGraphResourceView resource = graph.resourceAt(use.resource.index);
+                // Transients are bound to their backend resources only after this plan places them.
+                if(resource.transient)
+                    continue;
                 switch(resource.type){
                 case GpuGraphResourceType::Texture:
                     if(graph.textureForResource(use.resource))
@@ -123,6 +126,9 @@ bool GpuTaskGraphCompiler::compile(
         .epilogueBarriers = outCompiledGraph.m_epilogueBarriers,
         .externalResourceExports = outCompiledGraph.m_externalResourceExports,
         .externalResourceExportSources = outCompiledGraph.m_externalResourceExportSources,
+        .transientResources = outCompiledGraph.m_transientResources,
+        .transientAliasingBarriers = outCompiledGraph.m_transientAliasingBarriers,
+        .transientAllocationAlignment = outCompiledGraph.m_transientAllocationAlignment,
         .queueTopology = outCompiledGraph.m_queueTopology,
         .presentEndpoint = outCompiledGraph.m_presentEndpoint,
         .hasPresentEndpoint = outCompiledGraph.m_hasPresentEndpoint,
@@ -283,6 +289,13 @@ bool GpuTaskGraphCompiler::compile(
     }
     const f64 packetDependencyPlanningSeconds = DurationInSeconds<f64>(TimerNow(), packetDependencyPlanningBegin);
 
+    const Timer transientPlanningBegin = TimerNow();
+    if(!PlanTransientResourceAliasing(graph, outAnalysis, scratchArena, compiledPlan)){
+        outCompiledGraph.reset();
+        return false;
+    }
+    const f64 transientPlanningSeconds = DurationInSeconds<f64>(TimerNow(), transientPlanningBegin);
+
     GpuTaskGraphCompileStatistics& statistics = outCompiledGraph.m_compileStatistics;
     statistics.graphGeneration = outCompiledGraph.m_generation;
     statistics.planGeneration = outCompiledGraph.m_planGeneration;
@@ -394,6 +407,14 @@ bool GpuTaskGraphCompiler::compile(
     };
     countBarriers(outCompiledGraph.m_prologueBarriers);
     countBarriers(outCompiledGraph.m_epilogueBarriers);
+    statistics.transientResourceCount = outCompiledGraph.m_transientResources.size();
+    statistics.transientAliasingBarrierCount = outCompiledGraph.m_transientAliasingBarriers.size();
+    for(const GpuCompiledTransientResource& transient : outCompiledGraph.m_transientResources){
+        if(transient.aliased)
+            ++statistics.aliasedTransientResourceCount;
+        statistics.transientPeakBytes = Max(statistics.transientPeakBytes, transient.offset + transient.byteSize);
+        statistics.transientUnaliasedBytes += transient.byteSize;
+    }
     statistics.declarationSeconds = IsFinite(options.declarationSeconds) && options.declarationSeconds >= 0.0
         ? options.declarationSeconds
         : 0.0
@@ -404,6 +425,7 @@ bool GpuTaskGraphCompiler::compile(
     statistics.packetizationSeconds = packetizationSeconds;
     statistics.resourceStatePlanningSeconds = resourceStatePlanningSeconds;
     statistics.packetDependencyPlanningSeconds = packetDependencyPlanningSeconds;
+    statistics.transientPlanningSeconds = transientPlanningSeconds;
     statistics.totalSeconds = DurationInSeconds<f64>(TimerNow(), compileBegin);
 
     outCompiledGraph.m_valid = true;
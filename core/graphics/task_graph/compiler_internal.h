@@ -34,6 +34,9 @@ struct GpuTaskGraphCompiledPlanStorage{
     GraphicsVector<GpuCompiledBarrier>& epilogueBarriers;
     GraphicsVector<GpuCompiledExternalResourceExport>& externalResourceExports;
     GraphicsVector<GpuCompiledExternalResourceExportSource>& externalResourceExportSources;
+    GraphicsVector<GpuCompiledTransientResource>& transientResources;
+    GraphicsVector<GpuCompiledTransientAliasingBarrier>& transientAliasingBarriers;
+    u64& transientAllocationAlignment;
     const GraphicsVector<GpuPhysicalQueueInfo>& queueTopology;
     GpuCompiledPresentEndpoint& presentEndpoint;
     bool& hasPresentEndpoint;
@@ -234,6 +237,13 @@ void AppendPendingEpilogueBarriers(GpuTaskGraphResourceStatePlan& plan);
     GpuTaskGraphCompiledPlanStorage& compiledPlan
 );
 
+[[nodiscard]] bool PlanTransientResourceAliasing(
+    const GpuTaskGraph& graph,
+    const GpuTaskGraphAnalysis& analysis,
+    Alloc::ScratchArena& scratchArena,
+    GpuTaskGraphCompiledPlanStorage& compiledPlan
+);
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,238 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "compiler_internal.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_CORE_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_gpu_task_graph_transient_aliasing{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+struct TransientLifetime{
+    GpuGraphResourceId resource;
+    GpuTaskId firstTask;
+    GpuTaskId lastTask;
+    GpuPhysicalQueueId queue;
+    u64 byteSize = 0u;
+    u64 alignment = 0u;
+    u64 offset = 0u;
+    u32 firstOrder = Limit<u32>::s_Max;
+    u32 lastOrder = 0u;
+    bool singleQueue = true;
+    bool aliased = false;
+};
+
+struct OccupiedRange{
+    u64 begin = 0u;
+    u64 end = 0u;
+};
+
+
+// Earlier lifetimes first; within one task the larger transient takes the lower offset, and resource order breaks
+// the remaining ties so one graph always packs the same way.
+[[nodiscard]] static bool LifetimeLess(const TransientLifetime& lhs, const TransientLifetime& rhs)noexcept{
+    if(lhs.firstOrder != rhs.firstOrder)
+        return lhs.firstOrder < rhs.firstOrder;
+    if(lhs.byteSize != rhs.byteSize)
+        return lhs.byteSize > rhs.byteSize;
+    return lhs.resource.index < rhs.resource.index;
+}
+
+[[nodiscard]] static bool RangeLess(const OccupiedRange& lhs, const OccupiedRange& rhs)noexcept{
+    return lhs.begin < rhs.begin;
+}
+
+// `previous` may hand its memory to `next` only when every use of it precedes next's first use on that same
+// physical queue. Submission order plus the aliasing barrier then orders the reuse; a transient used on several
+// queues would need a cross-queue wait the plan does not otherwise contain, so it keeps its memory to itself.
+[[nodiscard]] static bool CanReuseMemory(const TransientLifetime& previous, const TransientLifetime& next)noexcept{
+    return previous.singleQueue && previous.queue == next.queue && previous.lastOrder < next.firstOrder;
+}
+
+[[nodiscard]] static bool MemoryOverlaps(const TransientLifetime& lhs, const TransientLifetime& rhs)noexcept{
+    return lhs.offset < rhs.offset + rhs.byteSize && rhs.offset < lhs.offset + lhs.byteSize;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace GpuTaskGraphCompilerDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+[[nodiscard]] bool PlanTransientResourceAliasing(
+    const GpuTaskGraph& graph,
+    const GpuTaskGraphAnalysis& analysis,
+    Alloc::ScratchArena& scratchArena,
+    GpuTaskGraphCompiledPlanStorage& compiledPlan
+){
+    using namespace __hidden_gpu_task_graph_transient_aliasing;
+
+    const usize resourceCount = graph.resourceCount();
+    Vector<u32, Alloc::ScratchArena> lifetimeForResource(resourceCount, scratchArena);
+    Vector<TransientLifetime, Alloc::ScratchArena> lifetimes(scratchArena);
+    lifetimes.reserve(graph.transientResourceCount());
+    for(usize resourceIndex = 0u; resourceIndex < resourceCount; ++resourceIndex){
+        lifetimeForResource[resourceIndex] = Limit<u32>::s_Max;
+        const GpuTaskGraphResourceView resource = graph.resourceAt(resourceIndex);
+        if(!resource.transient)
+            continue;
+        if(resource.transientMemory.size == 0u || resource.transientMemory.alignment == 0u)
+            return false;
+
+        lifetimeForResource[resourceIndex] = static_cast<u32>(lifetimes.size());
+        TransientLifetime& lifetime = lifetimes.emplace_back();
+        lifetime.resource = resource.id;
+        lifetime.byteSize = resource.transientMemory.size;
+        lifetime.alignment = resource.transientMemory.alignment;
+    }
+    if(lifetimes.empty())
+        return true;
+
+    // Lifetimes follow the compiler's topological order, which is also per-queue submission order.
+    const GraphicsVector<GpuTaskId>& topologicalOrder = analysis.topologicalOrder();
+    for(usize position = 0u; position < topologicalOrder.size(); ++position){
+        const GpuTaskId& taskId = topologicalOrder[position];
+        const GpuCompiledTask* const compiledTask = FindCompiledTask(compiledPlan, taskId);
+        if(!compiledTask)
+            return false;
+
+        const GpuTaskGraphTaskView task = graph.taskAt(taskId.index);
+        for(usize useIndex = 0u; useIndex < task.resourceUseCount; ++useIndex){
+            const GpuGraphResourceId& resource = task.resourceUses[useIndex].resource;
+            if(resource.index >= resourceCount || lifetimeForResource[resource.index] == Limit<u32>::s_Max)
+                continue;
+
+            TransientLifetime& lifetime = lifetimes[lifetimeForResource[resource.index]];
+            if(lifetime.firstOrder == Limit<u32>::s_Max){
+                lifetime.firstOrder = static_cast<u32>(position);
+                lifetime.firstTask = taskId;
+                lifetime.queue = compiledTask->queue;
+            }
+            else if(lifetime.queue != compiledTask->queue)
+                lifetime.singleQueue = false;
+            lifetime.lastOrder = static_cast<u32>(position);
+            lifetime.lastTask = taskId;
+        }
+    }
+
+    usize usedLifetimeCount = 0u;
+    for(usize lifetimeIndex = 0u; lifetimeIndex < lifetimes.size(); ++lifetimeIndex){
+        if(lifetimes[lifetimeIndex].firstOrder != Limit<u32>::s_Max)
+            lifetimes[usedLifetimeCount++] = lifetimes[lifetimeIndex];
+    }
+    lifetimes.resize(usedLifetimeCount);
+    Sort(lifetimes.begin(), lifetimes.end(), LifetimeLess);
+
+    // Greedy first fit in lifetime order: each transient takes the lowest aligned offset that does not overlap a
+    // placed transient it cannot reuse memory from.
+    Vector<OccupiedRange, Alloc::ScratchArena> occupiedRanges(scratchArena);
+    occupiedRanges.reserve(lifetimes.size());
+    compiledPlan.transientResources.reserve(lifetimes.size());
+    u64 allocationAlignment = 1u;
+    for(usize lifetimeIndex = 0u; lifetimeIndex < lifetimes.size(); ++lifetimeIndex){
+        TransientLifetime& next = lifetimes[lifetimeIndex];
+
+        occupiedRanges.clear();
+        for(usize previousIndex = 0u; previousIndex < lifetimeIndex; ++previousIndex){
+            const TransientLifetime& previous = lifetimes[previousIndex];
+            if(!CanReuseMemory(previous, next))
+                occupiedRanges.push_back(OccupiedRange{ previous.offset, previous.offset + previous.byteSize });
+        }
+        Sort(occupiedRanges.begin(), occupiedRanges.end(), RangeLess);
+
+        u64 cursor = 0u;
+        for(const OccupiedRange& range : occupiedRanges){
+            u64 candidate = 0u;
+            if(!AlignUpChecked(cursor, next.alignment, candidate))
+                return false;
+            if(candidate <= range.begin && next.byteSize <= range.begin - candidate)
+                break;
+            cursor = Max(cursor, range.end);
+        }
+        if(!AlignUpChecked(cursor, next.alignment, next.offset) || next.offset > Limit<u64>::s_Max - next.byteSize)
+            return false;
+        allocationAlignment = Max(allocationAlignment, next.alignment);
+
+        for(usize previousIndex = 0u; previousIndex < lifetimeIndex; ++previousIndex){
+            const TransientLifetime& previous = lifetimes[previousIndex];
+            if(!CanReuseMemory(previous, next) || !MemoryOverlaps(previous, next))
+                continue;
+
+            next.aliased = true;
+            compiledPlan.transientAliasingBarriers.push_back(GpuCompiledTransientAliasingBarrier{
+                .task = next.firstTask,
+                .queue = next.queue,
+                .before = previous.resource,
+                .after = next.resource,
+            });
+        }
+
+        compiledPlan.transientResources.push_back(GpuCompiledTransientResource{
+            .resource = next.resource,
+            .firstTask = next.firstTask,
+            .lastTask = next.lastTask,
+            .queue = next.queue,
+            .offset = next.offset,
+            .byteSize = next.byteSize,
+            .alignment = next.alignment,
+            .aliased = next.aliased,
+        });
+    }
+
+    // Lifetimes were placed in first-use order, so each task's aliasing barriers are already contiguous.
+    const GraphicsVector<GpuCompiledTransientAliasingBarrier>& barriers = compiledPlan.transientAliasingBarriers;
+    for(usize barrierIndex = 0u; barrierIndex < barriers.size();){
+        const GpuTaskId task = barriers[barrierIndex].task;
+        usize barrierEnd = barrierIndex + 1u;
+        while(barrierEnd < barriers.size() && barriers[barrierEnd].task == task)
+            ++barrierEnd;
+
+        GpuCompiledTask* const compiledTask = FindCompiledTask(compiledPlan, task);
+        if(!compiledTask)
+            return false;
+        compiledTask->transientAliasingBarrierOffset = static_cast<u32>(barrierIndex);
+        compiledTask->transientAliasingBarrierCount = static_cast<u32>(barrierEnd - barrierIndex);
+        barrierIndex = barrierEnd;
+    }
+
+    compiledPlan.transientAllocationAlignment = allocationAlignment;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_CORE_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -83,6 +83,10 @@ struct GpuTaskGraphResourceView{
     usize initialOwnerHandoffSourceCount = 0u;
     ResourceQueueSharing::Mask queueSharing = ResourceQueueSharing::Exclusive;
     bool hasBackendResource = false;
+    // Graph-owned transient texture or buffer. Its backend resource is bound only after compilation has placed it
+    // in the shared transient allocation, so hasBackendResource stays false until then.
+    bool transient = false;
+    MemoryRequirements transientMemory;
 };
 
 struct GpuTaskGraphResourceSetView{
@@ -280,6 +284,16 @@ private:
         GpuPhysicalQueueId initialOwnerReleaseDestinationQueue;
         GpuGraphResourceType::Enum type = GpuGraphResourceType::HazardDomain;
         ResourceQueueSharing::Mask queueSharing = ResourceQueueSharing::Exclusive;
+        u32 transientIndex = Limit<u32>::s_Max;
+    };
+
+    // Creation-time descriptor and placement size of one graph-owned transient. Only the member matching the
+    // resource type is meaningful.
+    struct GpuGraphTransientNode{
+        u32 resourceIndex = 0u;
+        TextureDesc texture;
+        BufferDesc buffer;
+        MemoryRequirements memory;
     };
 
     struct GpuGraphResourceSetNode{
@@ -429,6 +443,27 @@ public:
         const GpuGraphResourceDesc& desc
     );
     [[nodiscard]] GpuGraphResourceId importHazardDomain(const GpuGraphResourceDesc& desc);
+    // Graph-owned transients exist only for this graph's work: their contents are undefined before the first use
+    // and discarded after the last. The compiler derives each lifetime from task resource uses and packs transients
+    // with disjoint lifetimes into one shared allocation. `memory` should be the device's requirements for the
+    // virtual resource; a zero size falls back to a conservative estimate from the descriptor. desc must name the
+    // matching type and leave initial/final state and ownership handoff fields unset.
+    [[nodiscard]] GpuGraphResourceId createTransientTexture(
+        const TextureDesc& texture,
+        const GpuGraphResourceDesc& desc,
+        const MemoryRequirements& memory = {}
+    );
+    [[nodiscard]] GpuGraphResourceId createTransientBuffer(
+        const BufferDesc& buffer,
+        const GpuGraphResourceDesc& desc,
+        const MemoryRequirements& memory = {}
+    );
+    // Attaches the virtual backend resource the caller bound at the compiled transient placement. A transient may
+    // be bound once per graph generation; native recording requires every used transient to be bound.
+    [[nodiscard]] bool bindTransientTexture(const GpuGraphResourceId& resource, const TextureHandle& texture);
+    [[nodiscard]] bool bindTransientBuffer(const GpuGraphResourceId& resource, const BufferHandle& buffer);
+    [[nodiscard]] const TextureDesc* transientTextureDesc(const GpuGraphResourceId& resource)const noexcept;
+    [[nodiscard]] const BufferDesc* transientBufferDesc(const GpuGraphResourceId& resource)const noexcept;
     // Stores an immutable dynamic resource collection. Task resource-set declarations expand to the set's concrete
     // members at task creation, so compilation and recording keep their existing resource-level contracts.
     [[nodiscard]] GpuGraphResourceSetId importResourceSet(const GpuGraphResourceSetDesc& desc);
@@ -489,6 +524,7 @@ public:
     [[nodiscard]] bool validExternalCompletion(const GpuExternalCompletionId& id)const noexcept;
     [[nodiscard]] usize taskCount()const noexcept{ return m_tasks.size(); }
     [[nodiscard]] usize resourceCount()const noexcept{ return m_resources.size(); }
+    [[nodiscard]] usize transientResourceCount()const noexcept{ return m_transients.size(); }
     [[nodiscard]] usize resourceSetCount()const noexcept{ return m_resourceSets.size(); }
     [[nodiscard]] usize uploadBlobCount()const noexcept{ return m_uploadBlobs.size(); }
     [[nodiscard]] usize pipelineCount()const noexcept{ return m_pipelines.size(); }
@@ -661,6 +697,13 @@ private:
         GpuTaskPayloadDestroyThunk destroyPayload
     )noexcept;
     [[nodiscard]] GpuGraphResourceId appendResource(const GpuGraphResourceDesc& desc);
+    [[nodiscard]] GpuGraphResourceId appendTransientResource(
+        const GpuGraphResourceDesc& desc,
+        const TextureDesc* texture,
+        const BufferDesc* buffer,
+        const MemoryRequirements& memory
+    );
+    [[nodiscard]] const GpuGraphTransientNode* findTransient(const GpuGraphResourceId& resource)const noexcept;
     [[nodiscard]] GpuGraphResourceSetId appendResourceSet(const GpuGraphResourceSetDesc& desc);
     [[nodiscard]] GpuGraphPipelineId appendPipeline(const GpuGraphPipelineDesc& desc);
     [[nodiscard]] GpuExternalCompletionId appendExternalCompletion(const GpuExternalCompletionDesc& desc);
@@ -682,6 +725,7 @@ private:
     GraphicsVector<CommandListResourceStateHandoff*> m_externalStateSnapshots;
     GraphicsVector<GpuTaskResourceUse> m_resourceUses;
     GraphicsVector<GpuGraphResourceNode> m_resources;
+    GraphicsVector<GpuGraphTransientNode> m_transients;
     GraphicsVector<GpuTaskGraphInitialOwnerHandoffSourceView> m_initialOwnerHandoffSources;
     GraphicsVector<GpuGraphResourceSetNode> m_resourceSets;
     GraphicsVector<GpuGraphResourceId> m_resourceSetMembers;
@@ -35,6 +35,7 @@ GpuTaskGraph::GpuTaskGraph(GraphicsArena& arena)
     , m_externalStateSnapshots(arena)
     , m_resourceUses(arena)
     , m_resources(arena)
+    , m_transients(arena)
     , m_initialOwnerHandoffSources(arena)
     , m_resourceSets(arena)
     , m_resourceSetMembers(arena)
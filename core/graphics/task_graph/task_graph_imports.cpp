@@ -78,6 +78,9 @@ GpuGraphResourceId GpuTaskGraph::importResource(const GpuGraphResourceDesc& desc
         const GpuTaskGraphResourceView existing = resourceAt(resourceIndex);
         if(existing.identity != desc.identity)
             continue;
+        // A metadata import cannot adopt a graph-owned transient; its lifetime ends with this graph's work.
+        if(existing.transient)
+            return {};
         if(!__hidden_gpu_task_graph_imports::CompatibleResourceMetadata(
             existing,
             m_resources[resourceIndex].initialOwnerStateSourceIdentity,
@@ -52,6 +52,7 @@ void GpuTaskGraph::reset(){
         m_externalStateSources.clear();
         m_resourceUses.clear();
         m_resources.clear();
+        m_transients.clear();
         m_initialOwnerHandoffSources.clear();
         m_resourceSets.clear();
         m_resourceSetMembers.clear();
@@ -275,6 +276,10 @@ GpuTaskGraphResourceView GpuTaskGraph::resourceAt(const usize index)const{
         .initialOwnerHandoffSourceCount = resource.initialOwnerHandoffSourceCount,
         .queueSharing = resource.queueSharing,
         .hasBackendResource = resource.texture != nullptr || resource.buffer != nullptr || resource.accelStruct != nullptr,
+        .transient = resource.transientIndex < m_transients.size(),
+        .transientMemory = resource.transientIndex < m_transients.size()
+            ? m_transients[resource.transientIndex].memory
+            : MemoryRequirements{},
     };
 }
 
@@ -0,0 +1,266 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "task_graph.h"
+
+#include <core/graphics/backend_selection.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_CORE_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_gpu_task_graph_transients{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Estimates assume the largest common placement granularity, so a texture and a buffer placed next to each other
+// in one allocation never share a bufferImageGranularity page.
+inline constexpr u64 s_EstimatedPlacementAlignment = 64u * 1024u;
+inline constexpr u32 s_MaxTransientMipLevels = 32u;
+
+
+[[nodiscard]] static bool ValidTransientDesc(const GpuGraphResourceDesc& desc)noexcept{
+    return desc.identity
+        && !desc.markerLabel.empty()
+        && !desc.hasExplicitInitialState
+        && desc.initialState == ResourceStates::Unknown
+        && desc.externalFinalState == ResourceStates::Unknown
+        && !desc.externalFinalReleaseDestinationQueue.valid()
+        && !desc.initialOwnerQueue.valid()
+        && !desc.initialOwnerReleaseDestinationQueue.valid()
+        && !desc.initialOwnerCompletion.valid()
+        && !desc.initialOwnerMinimumCompletionToken.valid()
+        && !desc.initialOwnerStateSource
+        && !desc.initialOwnerHandoffSources
+        && desc.initialOwnerHandoffSourceCount == 0u
+    ;
+}
+
+[[nodiscard]] static bool ValidTransientTexture(const TextureDesc& texture)noexcept{
+    return texture.format != Format::UNKNOWN
+        && texture.format < Format::kCount
+        && texture.dimension != TextureDimension::Unknown
+        && texture.width != 0u
+        && texture.height != 0u
+        && texture.depth != 0u
+        && texture.arraySize != 0u
+        && texture.mipLevels != 0u
+        && texture.mipLevels <= s_MaxTransientMipLevels
+        && texture.sampleCount != 0u
+        && GetFormatInfo(texture.format).bytesPerBlock != 0u
+    ;
+}
+
+[[nodiscard]] static u64 EstimateTextureBytes(const TextureDesc& texture)noexcept{
+    const FormatInfo& formatInfo = GetFormatInfo(texture.format);
+    const u64 blockWidth = Max(GetFormatBlockWidth(formatInfo), 1u);
+    const u64 blockHeight = Max(GetFormatBlockHeight(formatInfo), 1u);
+    const bool volume = texture.dimension == TextureDimension::Texture3D;
+
+    u64 sliceBytes = 0u;
+    for(u32 mip = 0u; mip < texture.mipLevels; ++mip){
+        const u64 width = Max(texture.width >> mip, 1u);
+        const u64 height = Max(texture.height >> mip, 1u);
+        const u64 depth = volume ? Max(texture.depth >> mip, 1u) : 1u;
+        sliceBytes += DivideUp(width, blockWidth) * DivideUp(height, blockHeight) * depth * formatInfo.bytesPerBlock;
+    }
+    const u64 bytes = sliceBytes * texture.arraySize * texture.sampleCount;
+    return AlignUp(bytes, s_EstimatedPlacementAlignment);
+}
+
+[[nodiscard]] static bool ResolveTransientMemory(
+    const MemoryRequirements& requested,
+    const u64 estimatedBytes,
+    MemoryRequirements& outMemory
+)noexcept{
+    if(requested.alignment != 0u && (requested.alignment & (requested.alignment - 1u)) != 0u)
+        return false;
+
+    outMemory.size = requested.size != 0u ? requested.size : estimatedBytes;
+    outMemory.alignment = requested.alignment != 0u ? requested.alignment : s_EstimatedPlacementAlignment;
+    return outMemory.size != 0u;
+}
+
+[[nodiscard]] static bool MatchingTextureShape(const TextureDesc& lhs, const TextureDesc& rhs)noexcept{
+    return lhs.format == rhs.format
+        && lhs.dimension == rhs.dimension
+        && lhs.width == rhs.width
+        && lhs.height == rhs.height
+        && lhs.depth == rhs.depth
+        && lhs.arraySize == rhs.arraySize
+        && lhs.mipLevels == rhs.mipLevels
+        && lhs.sampleCount == rhs.sampleCount
+    ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+GpuGraphResourceId GpuTaskGraph::createTransientTexture(
+    const TextureDesc& texture,
+    const GpuGraphResourceDesc& desc,
+    const MemoryRequirements& memory
+){
+    if(
+        desc.type != GpuGraphResourceType::Texture
+        || !__hidden_gpu_task_graph_transients::ValidTransientDesc(desc)
+        || !__hidden_gpu_task_graph_transients::ValidTransientTexture(texture)
+    )
+        return {};
+
+    MemoryRequirements resolvedMemory;
+    if(!__hidden_gpu_task_graph_transients::ResolveTransientMemory(
+        memory,
+        __hidden_gpu_task_graph_transients::EstimateTextureBytes(texture),
+        resolvedMemory
+    ))
+        return {};
+
+    GpuGraphResourceDesc resolvedDesc = desc;
+    if(resolvedDesc.queueSharing == ResourceQueueSharing::Exclusive)
+        resolvedDesc.queueSharing = texture.queueSharing;
+    return appendTransientResource(resolvedDesc, &texture, nullptr, resolvedMemory);
+}
+
+GpuGraphResourceId GpuTaskGraph::createTransientBuffer(
+    const BufferDesc& buffer,
+    const GpuGraphResourceDesc& desc,
+    const MemoryRequirements& memory
+){
+    if(
+        desc.type != GpuGraphResourceType::Buffer
+        || !__hidden_gpu_task_graph_transients::ValidTransientDesc(desc)
+        || buffer.byteSize == 0u
+    )
+        return {};
+
+    MemoryRequirements resolvedMemory;
+    if(!__hidden_gpu_task_graph_transients::ResolveTransientMemory(
+        memory,
+        AlignUp(buffer.byteSize, __hidden_gpu_task_graph_transients::s_EstimatedPlacementAlignment),
+        resolvedMemory
+    ))
+        return {};
+
+    GpuGraphResourceDesc resolvedDesc = desc;
+    if(resolvedDesc.queueSharing == ResourceQueueSharing::Exclusive)
+        resolvedDesc.queueSharing = buffer.queueSharing;
+    return appendTransientResource(resolvedDesc, nullptr, &buffer, resolvedMemory);
+}
+
+GpuGraphResourceId GpuTaskGraph::appendTransientResource(
+    const GpuGraphResourceDesc& desc,
+    const TextureDesc* const texture,
+    const BufferDesc* const buffer,
+    const MemoryRequirements& memory
+){
+    for(const GpuGraphResourceNode& existing : m_resources){
+        if(existing.identity == desc.identity)
+            return {};
+    }
+    if(m_transients.size() >= Limit<u32>::s_Max)
+        return {};
+
+    // Contents never survive from a previous use of the shared allocation, so every transient starts as an
+    // explicit Unknown and its first writer transitions out of UNDEFINED.
+    GpuGraphResourceDesc transientDesc = desc;
+    transientDesc.setInitialState(ResourceStates::Unknown);
+    const GpuGraphResourceId resource = appendResource(transientDesc);
+    if(!resource.valid())
+        return {};
+
+    GpuGraphTransientNode& transient = m_transients.emplace_back();
+    transient.resourceIndex = resource.index;
+    if(texture)
+        transient.texture = *texture;
+    if(buffer)
+        transient.buffer = *buffer;
+    transient.memory = memory;
+    m_resources[resource.index].transientIndex = static_cast<u32>(m_transients.size() - 1u);
+    return resource;
+}
+
+const GpuTaskGraph::GpuGraphTransientNode* GpuTaskGraph::findTransient(
+    const GpuGraphResourceId& resource
+)const noexcept{
+    if(!validResource(resource))
+        return nullptr;
+    const u32 transientIndex = m_resources[resource.index].transientIndex;
+    return transientIndex < m_transients.size() ? &m_transients[transientIndex] : nullptr;
+}
+
+bool GpuTaskGraph::bindTransientTexture(const GpuGraphResourceId& resource, const TextureHandle& texture){
+    const GpuGraphTransientNode* const transient = findTransient(resource);
+    if(!transient || !texture)
+        return false;
+
+    GpuGraphResourceNode& node = m_resources[resource.index];
+    if(
+        node.type != GpuGraphResourceType::Texture
+        || node.texture
+        || !__hidden_gpu_task_graph_transients::MatchingTextureShape(transient->texture, texture->getDescription())
+    )
+        return false;
+
+    node.texture = texture;
+    node.deviceGeneration = texture->getDeviceGeneration();
+    return true;
+}
+
+bool GpuTaskGraph::bindTransientBuffer(const GpuGraphResourceId& resource, const BufferHandle& buffer){
+    const GpuGraphTransientNode* const transient = findTransient(resource);
+    if(!transient || !buffer)
+        return false;
+
+    GpuGraphResourceNode& node = m_resources[resource.index];
+    if(
+        node.type != GpuGraphResourceType::Buffer
+        || node.buffer
+        || buffer->getDescription().byteSize < transient->buffer.byteSize
+    )
+        return false;
+
+    node.buffer = buffer;
+    node.deviceGeneration = buffer->getDeviceGeneration();
+    return true;
+}
+
+const TextureDesc* GpuTaskGraph::transientTextureDesc(const GpuGraphResourceId& resource)const noexcept{
+    const GpuGraphTransientNode* const transient = findTransient(resource);
+    if(!transient || m_resources[resource.index].type != GpuGraphResourceType::Texture)
+        return nullptr;
+    return &transient->texture;
+}
+
+const BufferDesc* GpuTaskGraph::transientBufferDesc(const GpuGraphResourceId& resource)const noexcept{
+    const GpuGraphTransientNode* const transient = findTransient(resource);
+    if(!transient || m_resources[resource.index].type != GpuGraphResourceType::Buffer)
+        return nullptr;
+    return &transient->buffer;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_CORE_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
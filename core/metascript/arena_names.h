@@ -27,6 +27,7 @@ namespace MetascriptArenaScope{
 
 inline constexpr Name s_ParserScratch("core/metascript/parser_scratch");
 inline constexpr Name s_DocumentReaderScratch("core/metascript/document_reader_scratch");
+inline constexpr Name s_CompactBuildScratch("core/metascript/compact_build_scratch");
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,576 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "compact_document.h"
+#include "compact_value_detail.h"
+
+#include "arena_names.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_METASCRIPT_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_metascript_compact{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+constexpr usize s_BuildScratchChunkBytes = 64u * 1024u;
+
+const CompactValue s_NullValue;
+
+
+struct FlattenTotals{
+    usize nodeCount = 0u;
+    usize fieldCount = 0u;
+    usize stringBytes = 0u;
+};
+
+
+[[nodiscard]] bool IsSourceText(const MStringView source, const MStringView text){
+    if(text.empty())
+        return true;
+
+    const usize sourceBegin = reinterpret_cast<usize>(source.data());
+    const usize textBegin = reinterpret_cast<usize>(text.data());
+    return textBegin >= sourceBegin && textBegin - sourceBegin <= source.size() && text.size() <= source.size() - (textBegin - sourceBegin);
+}
+
+[[nodiscard]] bool CountText(const MStringView source, const MStringView text, FlattenTotals& totals){
+    if(text.size() > Limit<u32>::s_Max)
+        return false;
+    if(!IsSourceText(source, text))
+        totals.stringBytes += text.size();
+    return true;
+}
+
+[[nodiscard]] bool CountBuildValue(const MStringView source, const CompactValueDetail::BuildValue& value, FlattenTotals& totals){
+    switch(value.type()){
+    case ValueType::String:
+    case ValueType::Reference:
+        return CountText(source, value.text(), totals);
+    case ValueType::List:{
+        const auto& list = value.asList();
+        if(list.size() > Limit<u32>::s_Max)
+            return false;
+        totals.nodeCount += list.size();
+        for(const CompactValueDetail::BuildValue& elem : list){
+            if(!CountBuildValue(source, elem, totals))
+                return false;
+        }
+        return true;
+    }
+    case ValueType::Map:{
+        const auto& map = value.asMap();
+        if(map.size() > Limit<u32>::s_Max)
+            return false;
+        totals.fieldCount += map.size();
+        for(const CompactValueDetail::BuildField& field : map){
+            if(!CountText(source, field.key, totals) || !CountBuildValue(source, field.value, totals))
+                return false;
+        }
+        return true;
+    }
+    default:
+        return true;
+    }
+}
+
+[[nodiscard]] bool CompactFieldKeyLess(const CompactField& lhs, const CompactField& rhs){
+    return lhs.first < rhs.first;
+}
+
+[[nodiscard]] const CompactField* FindSortedField(const CompactField* fields, const usize count, const MStringView name){
+    const CompactField* end = fields + count;
+    const CompactField* it = LowerBound(
+        fields,
+        end,
+        name,
+        [](const CompactField& field, const MStringView key){ return field.first < key; }
+    );
+    if(it == end || it->first != name)
+        return nullptr;
+    return it;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace CompactValueDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+BuildContext::BuildContext()
+    : m_arena(MetascriptArenaScope::s_CompactBuildScratch, __hidden_metascript_compact::s_BuildScratchChunkBytes)
+{}
+
+MStringView BuildContext::copyText(const MStringView text){
+    return concatText(text, MStringView());
+}
+
+MStringView BuildContext::concatText(const MStringView lhs, const MStringView rhs){
+    const usize size = lhs.size() + rhs.size();
+    if(size == 0u)
+        return MStringView();
+
+    MChar* text = m_arena.allocate<MChar>(size);
+    if(!text)
+        throw RuntimeException("metascript compact build scratch exhausted");
+
+    if(!lhs.empty())
+        NWB_MEMCPY(text, size, lhs.data(), lhs.size());
+    if(!rhs.empty())
+        NWB_MEMCPY(text + lhs.size(), size - lhs.size(), rhs.data(), rhs.size());
+    return MStringView(text, size);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+BuildValue::BuildValue(i64 val, BuildContext& context)
+    : m_context(&context)
+    , m_type(ValueType::Integer)
+{
+    m_data.m_integer = val;
+}
+
+BuildValue::BuildValue(f64 val, BuildContext& context)
+    : m_context(&context)
+    , m_type(ValueType::Double)
+{
+    m_data.m_double = val;
+}
+
+BuildValue::BuildValue(MStringView val, BuildContext& context)
+    : m_context(&context)
+{
+    setText(ValueType::String, val);
+}
+
+BuildValue BuildValue::Reference(MStringView val, BuildContext& context){
+    BuildValue out(context);
+    out.setText(ValueType::Reference, context.copyText(val));
+    return out;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+BuildValue BuildValue::operator+(const BuildValue& rhs)const{
+    if(m_type == ValueType::Integer && rhs.m_type == ValueType::Integer){
+        if(AddOverflows<i64>(m_data.m_integer, rhs.m_data.m_integer)){
+            NWB_ASSERT_MSG(false, NWB_TEXT("integer overflow"));
+            return BuildValue(*m_context);
+        }
+        return BuildValue(m_data.m_integer + rhs.m_data.m_integer, *m_context);
+    }
+
+    if(isNumeric() && rhs.isNumeric())
+        return BuildValue(toDouble() + rhs.toDouble(), *m_context);
+
+    if(m_type == ValueType::String && rhs.m_type == ValueType::String){
+        BuildValue v(*m_context);
+        v.setText(ValueType::String, m_context->concatText(text(), rhs.text()));
+        return v;
+    }
+
+    if(m_type == ValueType::List && rhs.m_type == ValueType::List){
+        BuildValue v(*m_context);
+        v.makeList();
+        auto& dst = *v.m_data.m_list;
+        dst.reserve(m_data.m_list->size() + rhs.m_data.m_list->size());
+        dst.insert(dst.end(), m_data.m_list->begin(), m_data.m_list->end());
+        dst.insert(dst.end(), rhs.m_data.m_list->begin(), rhs.m_data.m_list->end());
+        return v;
+    }
+
+    NWB_ASSERT_MSG(false, NWB_TEXT("invalid operand types for operator+"));
+    return BuildValue(*m_context);
+}
+
+BuildValue BuildValue::operator-(const BuildValue& rhs)const{
+    if(m_type == ValueType::Integer && rhs.m_type == ValueType::Integer){
+        if(SubtractOverflows<i64>(m_data.m_integer, rhs.m_data.m_integer)){
+            NWB_ASSERT_MSG(false, NWB_TEXT("integer overflow"));
+            return BuildValue(*m_context);
+        }
+        return BuildValue(m_data.m_integer - rhs.m_data.m_integer, *m_context);
+    }
+
+    if(isNumeric() && rhs.isNumeric())
+        return BuildValue(toDouble() - rhs.toDouble(), *m_context);
+
+    NWB_ASSERT_MSG(false, NWB_TEXT("invalid operand types for operator-"));
+    return BuildValue(*m_context);
+}
+
+BuildValue BuildValue::operator*(const BuildValue& rhs)const{
+    if(m_type == ValueType::Integer && rhs.m_type == ValueType::Integer){
+        if(MultiplyOverflows<i64>(m_data.m_integer, rhs.m_data.m_integer)){
+            NWB_ASSERT_MSG(false, NWB_TEXT("integer overflow"));
+            return BuildValue(*m_context);
+        }
+        return BuildValue(m_data.m_integer * rhs.m_data.m_integer, *m_context);
+    }
+
+    if(isNumeric() && rhs.isNumeric())
+        return BuildValue(toDouble() * rhs.toDouble(), *m_context);
+
+    NWB_ASSERT_MSG(false, NWB_TEXT("invalid operand types for operator*"));
+    return BuildValue(*m_context);
+}
+
+BuildValue BuildValue::operator/(const BuildValue& rhs)const{
+    if(m_type == ValueType::Integer && rhs.m_type == ValueType::Integer){
+        if(rhs.m_data.m_integer == 0){
+            NWB_ASSERT_MSG(false, NWB_TEXT("division by zero"));
+            return BuildValue(*m_context);
+        }
+        if(DivideOverflows<i64>(m_data.m_integer, rhs.m_data.m_integer)){
+            NWB_ASSERT_MSG(false, NWB_TEXT("integer overflow"));
+            return BuildValue(*m_context);
+        }
+        return BuildValue(m_data.m_integer / rhs.m_data.m_integer, *m_context);
+    }
+
+    if(isNumeric() && rhs.isNumeric()){
+        if(rhs.toDouble() == 0.0){
+            NWB_ASSERT_MSG(false, NWB_TEXT("division by zero"));
+            return BuildValue(*m_context);
+        }
+        return BuildValue(toDouble() / rhs.toDouble(), *m_context);
+    }
+
+    NWB_ASSERT_MSG(false, NWB_TEXT("invalid operand types for operator/"));
+    return BuildValue(*m_context);
+}
+
+BuildValue& BuildValue::operator+=(const BuildValue& rhs){
+    if(m_type == ValueType::List){
+        auto& list = *m_data.m_list;
+        if(rhs.m_type == ValueType::List){
+            if(rhs.m_data.m_list == m_data.m_list){
+                const usize count = list.size();
+                list.reserve(count * 2u);
+                for(usize i = 0u; i < count; ++i)
+                    list.push_back(list[i]);
+            }
+            else
+                list.insert(list.end(), rhs.m_data.m_list->begin(), rhs.m_data.m_list->end());
+        }
+        else
+            list.push_back(rhs);
+        return *this;
+    }
+
+    *this = *this + rhs;
+    return *this;
+}
+
+BuildValue& BuildValue::operator-=(const BuildValue& rhs){
+    *this = *this - rhs;
+    return *this;
+}
+
+BuildValue& BuildValue::operator*=(const BuildValue& rhs){
+    *this = *this * rhs;
+    return *this;
+}
+
+BuildValue& BuildValue::operator/=(const BuildValue& rhs){
+    *this = *this / rhs;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+f64 BuildValue::toDouble()const{
+    if(m_type == ValueType::Integer)
+        return static_cast<f64>(m_data.m_integer);
+    NWB_ASSERT(m_type == ValueType::Double);
+    return m_data.m_double;
+}
+
+void BuildValue::setString(MStringView val){
+    setText(ValueType::String, val);
+}
+
+void BuildValue::makeList(){
+    m_type = ValueType::List;
+    m_data.m_list = NewArenaObject<ListType>(m_context->arena(), m_context->arena());
+    if(!m_data.m_list)
+        throw RuntimeException("metascript compact build scratch exhausted");
+}
+
+void BuildValue::makeMap(){
+    m_type = ValueType::Map;
+    m_data.m_map = NewArenaObject<MapType>(m_context->arena(), m_context->arena());
+    if(!m_data.m_map)
+        throw RuntimeException("metascript compact build scratch exhausted");
+}
+
+BuildValue& BuildValue::field(MStringView name){
+    if(m_type == ValueType::Null)
+        makeMap();
+    NWB_ASSERT(m_type == ValueType::Map);
+
+    for(BuildField& field : *m_data.m_map){
+        if(field.key == name)
+            return field.value;
+    }
+
+    m_data.m_map->push_back(BuildField{ name, BuildValue(*m_context) });
+    return m_data.m_map->back().value;
+}
+
+const BuildValue* BuildValue::findField(MStringView name)const{
+    NWB_ASSERT(m_type == ValueType::Map);
+
+    for(const BuildField& field : *m_data.m_map){
+        if(field.key == name)
+            return &field.value;
+    }
+    return nullptr;
+}
+
+void BuildValue::append(BuildValue&& val){
+    NWB_ASSERT_MSG(&val != this, NWB_TEXT("compact build values cannot append themselves"));
+
+    if(m_type == ValueType::Null)
+        makeList();
+    NWB_ASSERT(m_type == ValueType::List);
+
+    m_data.m_list->push_back(val);
+}
+
+void BuildValue::setText(const ValueType::Enum type, const MStringView val){
+    m_type = type;
+    m_data.m_text.data = val.data();
+    m_data.m_text.size = val.size();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+i64 CompactValue::asInteger()const{
+    NWB_ASSERT(m_type == ValueType::Integer);
+    return m_data.m_integer;
+}
+
+f64 CompactValue::asDouble()const{
+    NWB_ASSERT(m_type == ValueType::Double);
+    return m_data.m_double;
+}
+
+f64 CompactValue::toDouble()const{
+    if(m_type == ValueType::Integer)
+        return static_cast<f64>(m_data.m_integer);
+    NWB_ASSERT(m_type == ValueType::Double);
+    return m_data.m_double;
+}
+
+MStringView CompactValue::asString()const{
+    NWB_ASSERT(m_type == ValueType::String);
+    return MStringView(m_data.m_text, m_size);
+}
+
+MStringView CompactValue::asReference()const{
+    NWB_ASSERT(m_type == ValueType::Reference);
+    return MStringView(m_data.m_text, m_size);
+}
+
+CompactValue::ListType CompactValue::asList()const{
+    NWB_ASSERT(m_type == ValueType::List);
+    return ListType(m_data.m_items, m_size);
+}
+
+CompactValue::MapType CompactValue::asMap()const{
+    NWB_ASSERT(m_type == ValueType::Map);
+    return MapType(m_data.m_fields, m_size);
+}
+
+const CompactValue* CompactValue::findField(MStringView name)const{
+    NWB_ASSERT(m_type == ValueType::Map);
+
+    const CompactField* field = __hidden_metascript_compact::FindSortedField(m_data.m_fields, m_size, name);
+    return field ? &field->second : nullptr;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+struct CompactDocument::FlattenCursor{
+    MStringView source;
+    usize nodeOffset = 0u;
+    usize fieldOffset = 0u;
+    usize stringOffset = 0u;
+};
+
+
+CompactDocument::CompactDocument(MetaArena& arena)
+    : m_arena(arena)
+    , m_ownedSource(arena)
+    , m_assetType(arena)
+    , m_assetVariable(arena)
+    , m_nodes(arena)
+    , m_fields(arena)
+    , m_variables(arena)
+    , m_strings(arena)
+    , m_declarations(arena)
+    , m_errors(arena)
+{}
+
+
+const CompactValue& CompactDocument::asset()const{
+    const CompactValue* value = findVariable(assetVariable());
+    NWB_ASSERT(value != nullptr);
+    return value ? *value : __hidden_metascript_compact::s_NullValue;
+}
+
+const CompactValue* CompactDocument::findVariable(MStringView name)const{
+    const CompactField* variable = __hidden_metascript_compact::FindSortedField(m_variables.data(), m_variables.size(), name);
+    return variable ? &variable->second : nullptr;
+}
+
+void CompactDocument::reset(){
+    m_errors.clear();
+    m_assetType.clear();
+    m_assetVariable.clear();
+    m_nodes.clear();
+    m_fields.clear();
+    m_variables.clear();
+    m_strings.clear();
+    m_declarations.clear();
+}
+
+bool CompactDocument::flatten(const MStringView source, const MStringMap<CompactValueDetail::BuildValue>& variables){
+    __hidden_metascript_compact::FlattenTotals totals;
+    for(const auto& [name, value] : variables){
+        totals.stringBytes += name.size();
+        if(!__hidden_metascript_compact::CountBuildValue(source, value, totals)){
+            m_errors.push_back(ParseError{0, 0, MString("value is too large for a compact document", m_arena)});
+            return false;
+        }
+    }
+
+    // Sized once up front: nodes point at their children and strings, so none of these arrays may move afterwards.
+    m_nodes.resize(totals.nodeCount);
+    m_fields.resize(totals.fieldCount);
+    m_strings.resize(totals.stringBytes);
+    m_variables.resize(variables.size());
+
+    FlattenCursor cursor;
+    cursor.source = source;
+
+    usize variableIndex = 0u;
+    for(const auto& [name, value] : variables){
+        CompactField& variable = m_variables[variableIndex++];
+        MChar* text = m_strings.data() + cursor.stringOffset;
+        if(!name.empty())
+            NWB_MEMCPY(text, m_strings.size() - cursor.stringOffset, name.data(), name.size());
+        cursor.stringOffset += name.size();
+        variable.first = MStringView(text, name.size());
+        flattenValue(value, variable.second, cursor);
+    }
+    Sort(m_variables.begin(), m_variables.end(), __hidden_metascript_compact::CompactFieldKeyLess);
+
+    NWB_ASSERT(cursor.nodeOffset == m_nodes.size());
+    NWB_ASSERT(cursor.fieldOffset == m_fields.size());
+    NWB_ASSERT(cursor.stringOffset == m_strings.size());
+    return true;
+}
+
+void CompactDocument::flattenValue(const CompactValueDetail::BuildValue& source, CompactValue& outValue, FlattenCursor& cursor){
+    const auto stableText = [this, &cursor](const MStringView text){
+        if(__hidden_metascript_compact::IsSourceText(cursor.source, text))
+            return text;
+
+        MChar* copy = m_strings.data() + cursor.stringOffset;
+        NWB_MEMCPY(copy, m_strings.size() - cursor.stringOffset, text.data(), text.size());
+        cursor.stringOffset += text.size();
+        return MStringView(copy, text.size());
+    };
+
+    outValue.m_type = source.type();
+    switch(source.type()){
+    case ValueType::Integer:
+        outValue.m_data.m_integer = source.asInteger();
+        break;
+    case ValueType::Double:
+        outValue.m_data.m_double = source.asDouble();
+        break;
+    case ValueType::String:
+    case ValueType::Reference:{
+        const MStringView text = stableText(source.text());
+        outValue.m_size = static_cast<u32>(text.size());
+        outValue.m_data.m_text = text.data();
+        break;
+    }
+    case ValueType::List:{
+        const auto& list = source.asList();
+        CompactValue* items = m_nodes.data() + cursor.nodeOffset;
+        cursor.nodeOffset += list.size();
+
+        outValue.m_size = static_cast<u32>(list.size());
+        outValue.m_data.m_items = items;
+        for(usize i = 0u; i < list.size(); ++i)
+            flattenValue(list[i], items[i], cursor);
+        break;
+    }
+    case ValueType::Map:{
+        const auto& map = source.asMap();
+        CompactField* fields = m_fields.data() + cursor.fieldOffset;
+        cursor.fieldOffset += map.size();
+
+        outValue.m_size = static_cast<u32>(map.size());
+        outValue.m_data.m_fields = fields;
+        for(usize i = 0u; i < map.size(); ++i){
+            fields[i].first = stableText(map[i].key);
+            flattenValue(map[i].value, fields[i].second, cursor);
+        }
+        Sort(fields, fields + map.size(), __hidden_metascript_compact::CompactFieldKeyLess);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_METASCRIPT_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,239 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "parser.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_METASCRIPT_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace CompactValueDetail{
+    class BuildValue;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<typename T>
+class CompactRange{
+public:
+    constexpr CompactRange() = default;
+    constexpr CompactRange(const T* data, const usize size)
+        : m_data(data)
+        , m_size(size)
+    {}
+
+
+public:
+    [[nodiscard]] constexpr const T* begin()const{ return m_data; }
+    [[nodiscard]] constexpr const T* end()const{ return m_data + m_size; }
+    [[nodiscard]] constexpr const T* data()const{ return m_data; }
+    [[nodiscard]] constexpr usize size()const{ return m_size; }
+    [[nodiscard]] constexpr bool empty()const{ return m_size == 0u; }
+    [[nodiscard]] constexpr const T& operator[](const usize index)const{ NWB_ASSERT(index < m_size); return m_data[index]; }
+
+
+private:
+    const T* m_data = nullptr;
+    usize m_size = 0u;
+};
+
+
+struct CompactField;
+
+// Read-only node of a CompactDocument. Its query surface matches Value, so code that only reads a parsed asset works
+// with either DOM. List elements are stored next to each other in the document's node array and map fields are sorted
+// by key, so findField is a binary search instead of a hash lookup.
+class CompactValue{
+    friend class CompactDocument;
+
+
+public:
+    using ListType = CompactRange<CompactValue>;
+    using MapType = CompactRange<CompactField>;
+
+
+public:
+    [[nodiscard]] ValueType::Enum type()const{ return m_type; }
+    [[nodiscard]] bool isNull()const{ return m_type == ValueType::Null; }
+    [[nodiscard]] bool isInteger()const{ return m_type == ValueType::Integer; }
+    [[nodiscard]] bool isDouble()const{ return m_type == ValueType::Double; }
+    [[nodiscard]] bool isString()const{ return m_type == ValueType::String; }
+    [[nodiscard]] bool isReference()const{ return m_type == ValueType::Reference; }
+    [[nodiscard]] bool isList()const{ return m_type == ValueType::List; }
+    [[nodiscard]] bool isMap()const{ return m_type == ValueType::Map; }
+    [[nodiscard]] bool isNumeric()const{ return m_type == ValueType::Integer || m_type == ValueType::Double; }
+
+    [[nodiscard]] i64 asInteger()const;
+    [[nodiscard]] f64 asDouble()const;
+    [[nodiscard]] f64 toDouble()const;
+    [[nodiscard]] MStringView asString()const;
+    [[nodiscard]] MStringView asReference()const;
+    [[nodiscard]] ListType asList()const;
+    [[nodiscard]] MapType asMap()const;
+
+    [[nodiscard]] const CompactValue* findField(MStringView name)const;
+
+    template<typename Container>
+    [[nodiscard]] bool copyStringList(Container& outList)const{
+        if(!isList())
+            return false;
+        const ListType list = asList();
+        for(const auto& elem : list){
+            if(!elem.isString())
+                return false;
+        }
+
+        constexpr bool canAppendString =
+            requires(Container& c, usize n){ c.reserve(n); }
+            && requires(Container& c, const MChar* data, usize size){ c.emplace_back(data, size); }
+        ;
+        constexpr bool canAppendArenaString =
+            requires(Container& c, usize n){ c.reserve(n); }
+            && requires(Container& c){ c.get_allocator().arena(); }
+            && requires(
+                Container& c,
+                const MChar* data,
+                usize size,
+                typename Container::value_type::allocator_type allocator
+            ){
+                c.emplace_back(data, size, allocator);
+            }
+        ;
+        const usize listOffset = outList.size();
+        if constexpr(canAppendArenaString){
+            auto& arena = outList.get_allocator().arena();
+            outList.reserve(listOffset + list.size());
+            for(const auto& elem : list){
+                const MStringView text = elem.asString();
+                outList.emplace_back(text.data(), text.size(), arena);
+            }
+        }
+        else if constexpr(canAppendString){
+            outList.reserve(listOffset + list.size());
+            for(const auto& elem : list){
+                const MStringView text = elem.asString();
+                outList.emplace_back(text.data(), text.size());
+            }
+        }
+        else{
+            outList.resize(listOffset + list.size());
+            for(usize i = 0u; i < list.size(); ++i){
+                const MStringView text = list[i].asString();
+                outList[listOffset + i].assign(text.data(), text.size());
+            }
+        }
+        return true;
+    }
+
+
+private:
+    ValueType::Enum m_type = ValueType::Null;
+    u32 m_size = 0u;
+
+    union{
+        i64 m_integer;
+        f64 m_double;
+        const MChar* m_text;
+        const CompactValue* m_items;
+        const CompactField* m_fields;
+    } m_data{};
+};
+static_assert(sizeof(CompactValue) == 16u, "CompactValue should stay two words");
+
+// Named like the pair an MStringMap yields, so readers that iterate a Value map with .first/.second or structured
+// bindings accept a CompactValue map unchanged.
+struct CompactField{
+    MStringView first;
+    CompactValue second;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Read-only parse mode for cookers. It runs the same parser as Document, but keeps strings as views into the source
+// text instead of copying them, builds its temporaries in a scratch arena, and flattens the result into one node array
+// and one field array. Only strings the script synthesizes (concatenations, reference paths) are copied into a
+// document-owned pool.
+//
+// parse(MStringView) and parseWithImplicitAsset() do not copy the source: it must outlive the document or the next
+// parse. parse(IMetaReader&) keeps the bytes it read.
+class CompactDocument : NoCopy{
+public:
+    using ErrorList = Document::ErrorList;
+    using DeclarationList = Document::DeclarationList;
+
+
+public:
+    explicit CompactDocument(MetaArena& arena);
+
+
+public:
+    [[nodiscard]] bool parse(MStringView source);
+    [[nodiscard]] bool parseWithImplicitAsset(MStringView source, MStringView assetType, MStringView assetVariable);
+    [[nodiscard]] bool parse(IMetaReader& reader);
+
+    [[nodiscard]] MStringView assetType()const{ return MStringView(m_assetType.data(), m_assetType.size()); }
+    [[nodiscard]] MStringView assetVariable()const{ return MStringView(m_assetVariable.data(), m_assetVariable.size()); }
+    [[nodiscard]] const CompactValue& asset()const;
+
+    [[nodiscard]] const CompactValue* findVariable(MStringView name)const;
+    [[nodiscard]] const DeclarationList& declarations()const{ return m_declarations; }
+
+    [[nodiscard]] bool hasErrors()const{ return !m_errors.empty(); }
+    [[nodiscard]] const ErrorList& errors()const{ return m_errors; }
+
+    [[nodiscard]] usize nodeCount()const{ return m_nodes.size() + m_fields.size(); }
+
+
+private:
+    struct FlattenCursor;
+
+    [[nodiscard]] bool parseSource(MStringView source, MStringView assetType, MStringView assetVariable, bool implicitAsset);
+    void reset();
+    [[nodiscard]] bool flatten(MStringView source, const MStringMap<CompactValueDetail::BuildValue>& variables);
+    void flattenValue(const CompactValueDetail::BuildValue& source, CompactValue& outValue, FlattenCursor& cursor);
+
+
+private:
+    MetaArena& m_arena;
+    MVector<MChar> m_ownedSource;
+    MString m_assetType;
+    MString m_assetVariable;
+    MVector<CompactValue> m_nodes;
+    MVector<CompactField> m_fields;
+    MVector<CompactField> m_variables;
+    MVector<MChar> m_strings;
+    DeclarationList m_declarations;
+    ErrorList m_errors;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+[[nodiscard]] inline const CompactValue* FindField(const CompactValue& map, const AStringView fieldName){
+    return map.findField(MStringView(fieldName.data(), fieldName.size()));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_METASCRIPT_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
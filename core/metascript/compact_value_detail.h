@@ -0,0 +1,147 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "value.h"
+
+#include <core/alloc/scratch.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_METASCRIPT_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace CompactValueDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Parse-time state for CompactDocument. Every container a BuildValue creates lives in the scratch arena and is released
+// in bulk when the parse finishes, after CompactDocument has flattened the tree.
+class BuildContext : NoCopy{
+public:
+    BuildContext();
+
+
+public:
+    [[nodiscard]] Alloc::ScratchArena& arena(){ return m_arena; }
+
+    [[nodiscard]] MStringView copyText(MStringView text);
+    [[nodiscard]] MStringView concatText(MStringView lhs, MStringView rhs);
+
+
+private:
+    Alloc::ScratchArena m_arena;
+};
+
+
+struct BuildField;
+
+// Mirrors the mutable Value API the parser relies on, without owning anything. Strings are views into the source, into
+// static storage or into the build scratch arena; lists and maps are scratch vectors that copies share. The parser
+// never mutates a value after copying it, so sharing is safe and keeps temporaries free.
+class BuildValue{
+public:
+    using ListType = Vector<BuildValue, Alloc::ScratchArena>;
+    using MapType = Vector<BuildField, Alloc::ScratchArena>;
+
+
+public:
+    explicit BuildValue(BuildContext& context)
+        : m_context(&context)
+    {}
+    BuildValue(i64 val, BuildContext& context);
+    BuildValue(f64 val, BuildContext& context);
+    BuildValue(MStringView val, BuildContext& context);
+    [[nodiscard]] static BuildValue Reference(MStringView val, BuildContext& context);
+
+    [[nodiscard]] BuildValue operator+(const BuildValue& rhs)const;
+    [[nodiscard]] BuildValue operator-(const BuildValue& rhs)const;
+    [[nodiscard]] BuildValue operator*(const BuildValue& rhs)const;
+    [[nodiscard]] BuildValue operator/(const BuildValue& rhs)const;
+    BuildValue& operator+=(const BuildValue& rhs);
+    BuildValue& operator-=(const BuildValue& rhs);
+    BuildValue& operator*=(const BuildValue& rhs);
+    BuildValue& operator/=(const BuildValue& rhs);
+
+
+public:
+    [[nodiscard]] ValueType::Enum type()const{ return m_type; }
+    [[nodiscard]] bool isNull()const{ return m_type == ValueType::Null; }
+    [[nodiscard]] bool isInteger()const{ return m_type == ValueType::Integer; }
+    [[nodiscard]] bool isDouble()const{ return m_type == ValueType::Double; }
+    [[nodiscard]] bool isString()const{ return m_type == ValueType::String; }
+    [[nodiscard]] bool isReference()const{ return m_type == ValueType::Reference; }
+    [[nodiscard]] bool isList()const{ return m_type == ValueType::List; }
+    [[nodiscard]] bool isMap()const{ return m_type == ValueType::Map; }
+    [[nodiscard]] bool isNumeric()const{ return m_type == ValueType::Integer || m_type == ValueType::Double; }
+
+    [[nodiscard]] i64 asInteger()const{ NWB_ASSERT(isInteger()); return m_data.m_integer; }
+    [[nodiscard]] f64 asDouble()const{ NWB_ASSERT(isDouble()); return m_data.m_double; }
+    [[nodiscard]] f64 toDouble()const;
+    [[nodiscard]] MStringView asString()const{ NWB_ASSERT(isString()); return text(); }
+    [[nodiscard]] MStringView asReference()const{ NWB_ASSERT(isReference()); return text(); }
+    [[nodiscard]] MStringView text()const{ return MStringView(m_data.m_text.data, m_data.m_text.size); }
+    [[nodiscard]] const ListType& asList()const{ NWB_ASSERT(isList()); return *m_data.m_list; }
+    [[nodiscard]] ListType& asList(){ NWB_ASSERT(isList()); return *m_data.m_list; }
+    [[nodiscard]] const MapType& asMap()const{ NWB_ASSERT(isMap()); return *m_data.m_map; }
+
+    void setString(MStringView val);
+    void makeList();
+    void makeMap();
+
+    BuildValue& field(MStringView name);
+    [[nodiscard]] const BuildValue* findField(MStringView name)const;
+
+    void append(BuildValue&& val);
+
+
+private:
+    void setText(ValueType::Enum type, MStringView val);
+
+
+private:
+    BuildContext* m_context;
+    ValueType::Enum m_type = ValueType::Null;
+
+    union{
+        i64 m_integer;
+        f64 m_double;
+        struct{
+            const MChar* data;
+            usize size;
+        } m_text;
+        ListType* m_list;
+        MapType* m_map;
+    } m_data{};
+};
+
+struct BuildField{
+    MStringView key;
+    BuildValue value;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_METASCRIPT_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,316 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "parser.h"
+
+#include <global/binary.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_METASCRIPT_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_metascript_snapshot{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+constexpr u32 s_SnapshotMagic = 0x534D574E; // NWMS
+constexpr u32 s_SnapshotVersion = 1u;
+// Nesting the reader accepts before it treats the bytes as corrupt; scripts never get close.
+constexpr u32 s_SnapshotMaxDepth = 1024u;
+
+struct SnapshotHeader{
+    u32 magic = s_SnapshotMagic;
+    u32 version = s_SnapshotVersion;
+};
+
+
+[[nodiscard]] bool AppendText(MVector<u8>& outBytes, const MStringView text){
+    return AppendString(outBytes, AStringView(text.data(), text.size()));
+}
+
+[[nodiscard]] bool AppendCount(MVector<u8>& outBytes, const usize count){
+    if(count > Limit<u32>::s_Max)
+        return false;
+    AppendPOD(outBytes, static_cast<u32>(count));
+    return true;
+}
+
+[[nodiscard]] bool AppendValue(MVector<u8>& outBytes, const Value& value){
+    AppendPOD(outBytes, static_cast<u8>(value.type()));
+
+    switch(value.type()){
+    case ValueType::Null:
+        return true;
+    case ValueType::Integer:
+        AppendPOD(outBytes, value.asInteger());
+        return true;
+    case ValueType::Double:
+        AppendPOD(outBytes, value.asDouble());
+        return true;
+    case ValueType::String:
+        return AppendText(outBytes, value.asString());
+    case ValueType::Reference:
+        return AppendText(outBytes, value.asReference());
+    case ValueType::List:{
+        const Value::ListType& list = value.asList();
+        if(!AppendCount(outBytes, list.size()))
+            return false;
+        for(const Value& item : list){
+            if(!AppendValue(outBytes, item))
+                return false;
+        }
+        return true;
+    }
+    case ValueType::Map:{
+        const Value::MapType& map = value.asMap();
+        if(!AppendCount(outBytes, map.size()))
+            return false;
+        for(const auto& [key, item] : map){
+            if(!AppendText(outBytes, MStringView(key.data(), key.size())) || !AppendValue(outBytes, item))
+                return false;
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+
+class SnapshotReader{
+public:
+    SnapshotReader(const u8* bytes, const usize byteCount)
+        : m_bytes{ bytes, byteCount }
+    {}
+
+
+public:
+    [[nodiscard]] bool finished()const{ return m_cursor == m_bytes.size(); }
+
+    template<typename PodType>
+    [[nodiscard]] bool readPOD(PodType& outValue){
+        return ReadPOD(m_bytes, m_cursor, outValue);
+    }
+
+    [[nodiscard]] bool readText(MStringView& outText){
+        AStringView text;
+        if(!BinaryDetail::ReadLengthPrefixedString(m_bytes, m_cursor, text))
+            return false;
+        outText = MStringView(text.data(), text.size());
+        return true;
+    }
+
+    // Every element takes at least one byte, so a count larger than what is left can only come from corrupt data; it
+    // is rejected before anything reserves memory for it.
+    [[nodiscard]] bool readCount(u32& outCount){
+        if(!readPOD(outCount))
+            return false;
+        return static_cast<usize>(outCount) <= m_bytes.size() - m_cursor;
+    }
+
+    [[nodiscard]] bool readValue(Value& outValue, const u32 depth){
+        if(depth > s_SnapshotMaxDepth)
+            return false;
+
+        u8 type = 0u;
+        if(!readPOD(type))
+            return false;
+
+        switch(static_cast<ValueType::Enum>(type)){
+        case ValueType::Null:
+            return true;
+        case ValueType::Integer:{
+            i64 integer = 0;
+            if(!readPOD(integer))
+                return false;
+            outValue.setInteger(integer);
+            return true;
+        }
+        case ValueType::Double:{
+            f64 real = 0.0;
+            if(!readPOD(real))
+                return false;
+            outValue.setDouble(real);
+            return true;
+        }
+        case ValueType::String:
+        case ValueType::Reference:{
+            MStringView text;
+            if(!readText(text))
+                return false;
+            if(type == ValueType::String)
+                outValue.setString(text);
+            else
+                outValue.setReference(text);
+            return true;
+        }
+        case ValueType::List:{
+            u32 count = 0u;
+            if(!readCount(count))
+                return false;
+            outValue.makeList();
+            Value::ListType& list = outValue.asList();
+            list.reserve(count);
+            for(u32 i = 0u; i < count; ++i){
+                list.emplace_back(outValue.arena());
+                if(!readValue(list.back(), depth + 1u))
+                    return false;
+            }
+            return true;
+        }
+        case ValueType::Map:{
+            u32 count = 0u;
+            if(!readCount(count))
+                return false;
+            outValue.makeMap();
+            outValue.asMap().reserve(count);
+            for(u32 i = 0u; i < count; ++i){
+                MStringView key;
+                if(!readText(key) || !readValue(outValue.field(key), depth + 1u))
+                    return false;
+            }
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+
+private:
+    BinaryByteView m_bytes;
+    usize m_cursor = 0u;
+};
+
+
+[[nodiscard]] bool ReadDocument(
+    SnapshotReader& reader,
+    MetaArena& arena,
+    MString& outAssetType,
+    MString& outAssetVariable,
+    Document::DeclarationList& outDeclarations,
+    Document::VariableMap& outVariables
+){
+    SnapshotHeader header;
+    if(!reader.readPOD(header))
+        return false;
+    if(header.magic != s_SnapshotMagic || header.version != s_SnapshotVersion)
+        return false;
+
+    MStringView assetType;
+    MStringView assetVariable;
+    if(!reader.readText(assetType) || !reader.readText(assetVariable))
+        return false;
+    outAssetType.assign(assetType.data(), assetType.size());
+    outAssetVariable.assign(assetVariable.data(), assetVariable.size());
+
+    u32 declarationCount = 0u;
+    if(!reader.readCount(declarationCount))
+        return false;
+    outDeclarations.reserve(declarationCount);
+    for(u32 i = 0u; i < declarationCount; ++i){
+        MStringView type;
+        MStringView variable;
+        if(!reader.readText(type) || !reader.readText(variable))
+            return false;
+        outDeclarations.emplace_back(type, variable, arena);
+    }
+
+    u32 variableCount = 0u;
+    if(!reader.readCount(variableCount))
+        return false;
+    outVariables.reserve(variableCount);
+    for(u32 i = 0u; i < variableCount; ++i){
+        MStringView name;
+        if(!reader.readText(name))
+            return false;
+
+        auto inserted = outVariables.emplace(MString(name.data(), name.size(), arena), Value(arena));
+        if(!inserted.second || !reader.readValue(inserted.first.value(), 0u))
+            return false;
+    }
+
+    // A document without its asset variable would assert on the first asset() call.
+    if(!assetVariable.empty() && outVariables.find(assetVariable) == outVariables.end())
+        return false;
+    return reader.finished();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+bool Document::writeSnapshot(MVector<u8>& outBytes)const{
+    outBytes.clear();
+    if(hasErrors())
+        return false;
+
+    AppendPOD(outBytes, __hidden_metascript_snapshot::SnapshotHeader{});
+    if(!__hidden_metascript_snapshot::AppendText(outBytes, assetType()))
+        return false;
+    if(!__hidden_metascript_snapshot::AppendText(outBytes, assetVariable()))
+        return false;
+
+    if(!__hidden_metascript_snapshot::AppendCount(outBytes, m_declarations.size()))
+        return false;
+    for(const Declaration& declaration : m_declarations){
+        if(!__hidden_metascript_snapshot::AppendText(outBytes, MStringView(declaration.type.data(), declaration.type.size())))
+            return false;
+        if(!__hidden_metascript_snapshot::AppendText(outBytes, MStringView(declaration.variable.data(), declaration.variable.size())))
+            return false;
+    }
+
+    if(!__hidden_metascript_snapshot::AppendCount(outBytes, m_variables.size()))
+        return false;
+    for(const auto& [name, value] : m_variables){
+        if(!__hidden_metascript_snapshot::AppendText(outBytes, MStringView(name.data(), name.size())))
+            return false;
+        if(!__hidden_metascript_snapshot::AppendValue(outBytes, value))
+            return false;
+    }
+    return true;
+}
+
+bool Document::readSnapshot(const u8* bytes, const usize byteCount){
+    clear();
+
+    __hidden_metascript_snapshot::SnapshotReader reader(bytes, byteCount);
+    const bool read = __hidden_metascript_snapshot::ReadDocument(
+        reader,
+        m_arena,
+        m_assetType,
+        m_assetVariable,
+        m_declarations,
+        m_variables
+    );
+    if(read)
+        return true;
+
+    clear();
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_METASCRIPT_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
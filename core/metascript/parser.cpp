@@ -3,6 +3,8 @@
 
 
 #include "parser.h"
+#include "compact_document.h"
+#include "compact_value_detail.h"
 
 #include "arena_names.h"
 
@@ -62,17 +64,20 @@ template<usize N>
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-class Parser{
+template<typename ValueT, typename ValueContext>
+class BasicParser{
 public:
-    Parser(
+    BasicParser(
         MStringView source,
         MetaArena& arena,
+        ValueContext& valueContext,
         MVector<ParseError>& errors,
-        MStringMap<Value>& variables,
+        MStringMap<ValueT>& variables,
         Document::DeclarationList& declarations
     )
         : m_lexer(source)
         , m_arena(arena)
+        , m_valueContext(valueContext)
         , m_scratchArena(MetascriptArenaScope::s_ParserScratch, s_ParserScratchArenaBytes)
         , m_declaredStructs(m_scratchArena)
         , m_errors(errors)
@@ -157,7 +162,7 @@ private:
         const u32 variableColumn = m_current.column;
         advance();
 
-        Value initialValue(m_arena);
+        ValueT initialValue(m_valueContext);
         if(m_current.type == TokenType::Equal){
             advance();
             initialValue = parseExpression();
@@ -174,7 +179,7 @@ private:
     bool declareVariable(
         const MStringView typeName,
         const MStringView variableName,
-        Value&& initialValue,
+        ValueT&& initialValue,
         const u32 typeLine,
         const u32 typeColumn,
         const u32 variableLine,
@@ -219,13 +224,13 @@ private:
         m_declaredAssetVariable = MStringView(outAssetVariable.data(), outAssetVariable.size());
 
         MString key(outAssetVariable.data(), outAssetVariable.size(), m_arena);
-        m_variables.emplace(Move(key), Value(m_arena));
+        m_variables.emplace(Move(key), ValueT(m_valueContext));
         m_declarations.emplace_back(assetType, assetVariable, m_arena);
         return true;
     }
 
     bool parseStatement(){
-        Value attributes = parseAttributeList();
+        ValueT attributes = parseAttributeList();
         if(!m_errors.empty())
             return false;
 
@@ -283,14 +288,14 @@ private:
         }
         advance();
 
-        Value rhs = parseExpression();
+        ValueT rhs = parseExpression();
         if(!m_errors.empty())
             return false;
 
         if(!expect(TokenType::Semicolon, "expected ';' after expression"))
             return false;
 
-        Value* target = resolveTarget(path, assignOp == TokenType::Equal, firstLine, firstColumn);
+        ValueT* target = resolveTarget(path, assignOp == TokenType::Equal, firstLine, firstColumn);
         if(!target)
             return false;
 
@@ -320,77 +325,77 @@ private:
         return true;
     }
 
-    Value parseAttributeList(){
-        Value attributes(m_arena);
+    ValueT parseAttributeList(){
+        ValueT attributes(m_valueContext);
         attributes.makeList();
 
         while(m_current.type == TokenType::LeftBracket){
-            Value attribute = parseAttribute();
+            ValueT attribute = parseAttribute();
             if(!m_errors.empty())
-                return Value(m_arena);
+                return ValueT(m_valueContext);
             attributes.append(Move(attribute));
         }
 
         return attributes;
     }
 
-    Value parseAttribute(){
+    ValueT parseAttribute(){
         if(!expect(TokenType::LeftBracket, "expected '[' before attribute"))
-            return Value(m_arena);
+            return ValueT(m_valueContext);
 
         if(m_current.type != TokenType::Identifier){
             errorExpected("expected attribute name");
-            return Value(m_arena);
+            return ValueT(m_valueContext);
         }
 
         const MStringView attributeName = m_current.text;
         advance();
 
-        Value attribute(m_arena);
+        ValueT attribute(m_valueContext);
         attribute.makeMap();
         attribute.field(LiteralView("name")).setString(attributeName);
 
-        Value& arguments = attribute.field(LiteralView("arguments"));
+        ValueT& arguments = attribute.field(LiteralView("arguments"));
         arguments.makeList();
 
         if(m_current.type == TokenType::LeftParen){
             advance();
             if(m_current.type != TokenType::RightParen){
                 for(;;){
-                    Value argument = parseAttributeArgument();
+                    ValueT argument = parseAttributeArgument();
                     if(!m_errors.empty())
-                        return Value(m_arena);
+                        return ValueT(m_valueContext);
                     arguments.append(Move(argument));
 
                     if(m_current.type == TokenType::RightParen)
                         break;
                     if(!expect(TokenType::Comma, "expected ',' or ')' in attribute arguments"))
-                        return Value(m_arena);
+                        return ValueT(m_valueContext);
                 }
             }
 
             if(!expect(TokenType::RightParen, "expected ')' after attribute arguments"))
-                return Value(m_arena);
+                return ValueT(m_valueContext);
         }
 
         if(!expect(TokenType::RightBracket, "expected ']' after attribute"))
-            return Value(m_arena);
+            return ValueT(m_valueContext);
 
         return attribute;
     }
 
-    Value parseAttributeArgument(){
+    ValueT parseAttributeArgument(){
         if(m_current.type == TokenType::StringLiteral){
             const MStringView text = m_current.text;
             advance();
-            return Value(text, m_arena);
+            return ValueT(text, m_valueContext);
         }
 
         errorExpected("expected string attribute argument");
-        return Value(m_arena);
+        return ValueT(m_valueContext);
     }
 
-    bool parseStructDeclaration(Value&& attributes, const u32 structLine, const u32 structColumn){
+    bool parseStructDeclaration(ValueT&& attributes, const u32 structLine, const u32 structColumn){
         const MStringView structName = m_current.text;
         advance();
 
@@ -402,7 +407,7 @@ private:
         if(!expect(TokenType::LeftBrace, "expected '{' after struct name"))
             return false;
 
-        Value fields(m_arena);
+        ValueT fields(m_valueContext);
         fields.makeList();
 
         ScratchNameList fieldNames{m_scratchArena};
@@ -414,7 +419,7 @@ private:
                 return false;
             }
 
-            Value fieldAttributes = parseAttributeList();
+            ValueT fieldAttributes = parseAttributeList();
             if(!m_errors.empty())
                 return false;
 
@@ -426,7 +431,7 @@ private:
                 break;
             }
 
-            Value field = parseStructField(Move(fieldAttributes), fieldNames);
+            ValueT field = parseStructField(Move(fieldAttributes), fieldNames);
             if(!m_errors.empty())
                 return false;
             fields.append(Move(field));
@@ -444,17 +449,17 @@ private:
         return true;
     }
 
-    Value parseStructField(Value&& attributes, ScratchNameList& fieldNames){
+    ValueT parseStructField(ValueT&& attributes, ScratchNameList& fieldNames){
         if(m_current.type != TokenType::Identifier){
             errorExpected("expected field type");
-            return Value(m_arena);
+            return ValueT(m_valueContext);
         }
         const MStringView typeName = m_current.text;
         advance();
 
         if(m_current.type != TokenType::Identifier){
             errorExpected("expected field name after type");
-            return Value(m_arena);
+            return ValueT(m_valueContext);
         }
         const MStringView fieldName = m_current.text;
         const u32 fieldLine = m_current.line;
@@ -463,15 +468,15 @@ private:
 
         if(isNameInList(fieldNames, fieldName)){
             error(fieldLine, fieldColumn, "duplicate struct field declaration");
-            return Value(m_arena);
+            return ValueT(m_valueContext);
         }
 
         if(!expect(TokenType::Semicolon, "expected ';' after field declaration"))
-            return Value(m_arena);
+            return ValueT(m_valueContext);
 
         fieldNames.push_back(fieldName);
 
-        Value field(m_arena);
+        ValueT field(m_valueContext);
         field.makeMap();
         field.field(LiteralView("type")).setString(typeName);
         field.field(LiteralView("name")).setString(fieldName);
@@ -492,13 +497,13 @@ private:
     }
 
 
-    Value parseExpression(){
+    ValueT parseExpression(){
         return parseAdditive();
     }
 
     template<typename ParseNext, typename ApplyOperation>
-    Value parseBinaryExpression(ParseNext&& parseNext, const TokenType::Enum lhsOp, const TokenType::Enum rhsOp, ApplyOperation&& applyOperation){
-        Value left = parseNext();
+    ValueT parseBinaryExpression(ParseNext&& parseNext, const TokenType::Enum lhsOp, const TokenType::Enum rhsOp, ApplyOperation&& applyOperation){
+        ValueT left = parseNext();
         if(!m_errors.empty())
             return left;
 
@@ -507,12 +512,12 @@ private:
             const u32 opLine = m_current.line;
             const u32 opColumn = m_current.column;
             advance();
-            Value right = parseNext();
+            ValueT right = parseNext();
             if(!m_errors.empty())
-                return Value(m_arena);
+                return ValueT(m_valueContext);
 
             if(!validateBinaryOperation(op, left, right, opLine, opColumn))
-                return Value(m_arena);
+                return ValueT(m_valueContext);
 
             left = applyOperation(op, left, right);
         }
@@ -520,53 +525,53 @@ private:
         return left;
     }
 
-    Value parseAdditive(){
+    ValueT parseAdditive(){
         return parseBinaryExpression(
             [&](){ return parseMultiplicative(); },
             TokenType::Plus,
             TokenType::Minus,
-            [](const TokenType::Enum op, const Value& left, const Value& right){
+            [](const TokenType::Enum op, const ValueT& left, const ValueT& right){
                 return op == TokenType::Plus ? left + right : left - right;
             }
         );
     }
 
-    Value parseMultiplicative(){
+    ValueT parseMultiplicative(){
         return parseBinaryExpression(
             [&](){ return parseUnary(); },
             TokenType::Star,
             TokenType::Slash,
-            [](const TokenType::Enum op, const Value& left, const Value& right){
+            [](const TokenType::Enum op, const ValueT& left, const ValueT& right){
                 return op == TokenType::Star ? left * right : left / right;
             }
         );
     }
 
-    Value parseUnary(){
+    ValueT parseUnary(){
         if(m_current.type == TokenType::Minus){
             advance();
-            Value val = parseUnary();
+            ValueT val = parseUnary();
             if(!m_errors.empty())
-                return Value(m_arena);
+                return ValueT(m_valueContext);
 
             if(val.isInteger()){
                 if(NegateOverflows<i64>(val.asInteger())){
                     error("integer overflow");
-                    return Value(m_arena);
+                    return ValueT(m_valueContext);
                 }
-                return Value(-val.asInteger(), m_arena);
+                return ValueT(-val.asInteger(), m_valueContext);
             }
             if(val.isDouble())
-                return Value(-val.asDouble(), m_arena);
+                return ValueT(-val.asDouble(), m_valueContext);
 
             error("unary '-' requires numeric operand");
-            return Value(m_arena);
+            return ValueT(m_valueContext);
         }
 
         return parsePrimary();
     }
 
-    Value parsePrimary(){
+    ValueT parsePrimary(){
         switch(m_current.type){
         case TokenType::IntegerLiteral:{
             const auto text = m_current.text;
@@ -575,9 +580,9 @@ private:
             i64 result = 0;
             if(!ParseI64FromChars(text.data(), text.data() + text.size(), result)){
                 error("invalid integer literal");
-                return Value(m_arena);
+                return ValueT(m_valueContext);
             }
-            return Value(result, m_arena);
+            return ValueT(result, m_valueContext);
         }
         case TokenType::DoubleLiteral:{
             const auto text = m_current.text;
@@ -586,14 +591,14 @@ private:
             f64 result = 0.0;
             if(!ParseF64FromChars(text.data(), text.data() + text.size(), result)){
                 error("invalid double literal");
-                return Value(m_arena);
+                return ValueT(m_valueContext);
             }
-            return Value(result, m_arena);
+            return ValueT(result, m_valueContext);
         }
         case TokenType::StringLiteral:{
             const auto text = m_current.text;
             advance();
-            return Value(text, m_arena);
+            return ValueT(text, m_valueContext);
         }
         case TokenType::Identifier:{
             const auto name = m_current.text;
@@ -607,7 +612,7 @@ private:
                 advance();
                 if(m_current.type != TokenType::Identifier){
                     errorExpected("expected identifier after '.'");
-                    return Value(m_arena);
+                    return ValueT(m_valueContext);
                 }
                 path.push_back(m_current.text);
                 advance();
@@ -621,11 +626,11 @@ private:
             return parseBraceExpression();
         case TokenType::LeftParen:{
             advance();
-            Value val = parseExpression();
+            ValueT val = parseExpression();
             if(!m_errors.empty())
-                return Value(m_arena);
+                return ValueT(m_valueContext);
             if(!expect(TokenType::RightParen, "expected ')' after expression"))
-                return Value(m_arena);
+                return ValueT(m_valueContext);
             return val;
         }
         default:
@@ -633,14 +638,14 @@ private:
         }
 
         errorExpected("expected expression");
-        return Value(m_arena);
+        return ValueT(m_valueContext);
     }
 
 
-    Value parseListLiteral(TokenType::Enum closeToken){
+    ValueT parseListLiteral(TokenType::Enum closeToken){
         advance();
 
-        Value list(m_arena);
+        ValueT list(m_valueContext);
         list.makeList();
 
         if(m_current.type == closeToken){
@@ -649,9 +654,9 @@ private:
         }
 
         for(;;){
-            Value elem = parseExpression();
+            ValueT elem = parseExpression();
             if(!m_errors.empty())
-                return Value(m_arena);
+                return ValueT(m_valueContext);
             list.append(Move(elem));
 
             if(m_current.type == closeToken){
@@ -660,7 +665,7 @@ private:
             }
 
             if(!expect(TokenType::Comma, "expected ',' or closing delimiter in list"))
-                return Value(m_arena);
+                return ValueT(m_valueContext);
             if(m_current.type == closeToken){
                 advance();
                 return list;
@@ -668,24 +673,24 @@ private:
         }
     }
 
-    Value parseBraceExpression(){
+    ValueT parseBraceExpression(){
         advance();
 
         if(m_current.type == TokenType::RightBrace){
             advance();
-            Value list(m_arena);
+            ValueT list(m_valueContext);
             list.makeList();
             return list;
         }
 
-        Value first = parseExpression();
+        ValueT first = parseExpression();
         if(!m_errors.empty())
-            return Value(m_arena);
+            return ValueT(m_valueContext);
 
         if(m_current.type == TokenType::Colon)
             return parseMapLiteralContinuation(Move(first));
 
-        Value list(m_arena);
+        ValueT list(m_valueContext);
         list.makeList();
         list.append(Move(first));
 
@@ -695,23 +700,23 @@ private:
         }
 
         if(!expect(TokenType::Comma, "expected ',' or '}' in list"))
-            return Value(m_arena);
+            return ValueT(m_valueContext);
         if(m_current.type == TokenType::RightBrace){
             advance();
             return list;
         }
 
         while(m_current.type != TokenType::RightBrace){
-            Value elem = parseExpression();
+            ValueT elem = parseExpression();
             if(!m_errors.empty())
-                return Value(m_arena);
+                return ValueT(m_valueContext);
             list.append(Move(elem));
 
             if(m_current.type == TokenType::RightBrace)
                 break;
 
             if(!expect(TokenType::Comma, "expected ',' or '}' in list"))
-                return Value(m_arena);
+                return ValueT(m_valueContext);
             if(m_current.type == TokenType::RightBrace)
                 break;
         }
@@ -720,20 +725,20 @@ private:
         return list;
     }
 
-    Value parseMapLiteralContinuation(Value&& firstKey){
+    ValueT parseMapLiteralContinuation(ValueT&& firstKey){
         advance();
 
         if(!firstKey.isString()){
             error("map keys must be strings");
-            return Value(m_arena);
+            return ValueT(m_valueContext);
         }
 
-        Value map(m_arena);
+        ValueT map(m_valueContext);
         map.makeMap();
 
-        Value firstValue = parseExpression();
+        ValueT firstValue = parseExpression();
         if(!m_errors.empty())
-            return Value(m_arena);
+            return ValueT(m_valueContext);
 
         map.field(firstKey.asString()) = Move(firstValue);
 
@@ -743,28 +748,28 @@ private:
         }
 
         if(!expect(TokenType::Comma, "expected ',' or '}' in map"))
-            return Value(m_arena);
+            return ValueT(m_valueContext);
         if(m_current.type == TokenType::RightBrace){
             advance();
             return map;
         }
 
         while(m_current.type != TokenType::RightBrace){
-            Value key = parseExpression();
+            ValueT key = parseExpression();
             if(!m_errors.empty())
-                return Value(m_arena);
+                return ValueT(m_valueContext);
 
             if(!key.isString()){
                 error("map keys must be strings");
-                return Value(m_arena);
+                return ValueT(m_valueContext);
             }
 
             if(!expect(TokenType::Colon, "expected ':' after map key"))
-                return Value(m_arena);
+                return ValueT(m_valueContext);
 
-            Value val = parseExpression();
+            ValueT val = parseExpression();
             if(!m_errors.empty())
-                return Value(m_arena);
+                return ValueT(m_valueContext);
 
             map.field(key.asString()) = Move(val);
 
@@ -772,7 +777,7 @@ private:
                 break;
 
             if(!expect(TokenType::Comma, "expected ',' or '}' in map"))
-                return Value(m_arena);
+                return ValueT(m_valueContext);
             if(m_current.type == TokenType::RightBrace)
                 break;
         }
@@ -782,7 +787,7 @@ private:
     }
 
 
-    Value* resolveTarget(const ScratchPath& path, const bool allowCreateRoot, const u32 errorLine, const u32 errorColumn){
+    ValueT* resolveTarget(const ScratchPath& path, const bool allowCreateRoot, const u32 errorLine, const u32 errorColumn){
         NWB_ASSERT(!path.empty());
 
         const auto rootName = path[0];
@@ -799,11 +804,11 @@ private:
             }
 
             MString rootKey(rootName.data(), rootName.size(), m_arena);
-            auto result = m_variables.emplace(Move(rootKey), Value(m_arena));
+            auto result = m_variables.emplace(Move(rootKey), ValueT(m_valueContext));
             rootIt = result.first;
         }
 
-        Value* current = &rootIt.value();
+        ValueT* current = &rootIt.value();
         for(usize i = 1; i < path.size(); ++i){
             if(current->isNull())
                 current->makeMap();
@@ -818,52 +823,52 @@ private:
         return current;
     }
 
-    Value resolveRead(const ScratchPath& path){
+    ValueT resolveRead(const ScratchPath& path){
         NWB_ASSERT(!path.empty());
 
         if(!isDeclaredVariable(path[0])){
             error("references must target a declared variable");
-            return Value(m_arena);
+            return ValueT(m_valueContext);
         }
 
         auto rootIt = m_variables.find(path[0]);
         if(rootIt == m_variables.end()){
             error("undefined variable");
-            return Value(m_arena);
+            return ValueT(m_valueContext);
         }
 
-        const Value* current = &rootIt.value();
+        const ValueT* current = &rootIt.value();
         for(usize i = 1; i < path.size(); ++i){
             if(!current->isMap()){
                 error("cannot access field on non-map value");
-                return Value(m_arena);
+                return ValueT(m_valueContext);
             }
             current = current->findField(path[i]);
             if(!current){
                 error("undefined field");
-                return Value(m_arena);
+                return ValueT(m_valueContext);
             }
         }
 
         return *current;
     }
 
-    Value makeReference(const ScratchPath& path){
+    ValueT makeReference(const ScratchPath& path){
         NWB_ASSERT(!path.empty());
 
         if(!isDeclaredVariable(path[0])){
             error("references must target a declared variable");
-            return Value(m_arena);
+            return ValueT(m_valueContext);
         }
 
-        MString text(m_arena);
+        ScratchString text{m_scratchArena};
         for(usize i = 0u; i < path.size(); ++i){
             if(i != 0u)
                 text.push_back('.');
             text.append(path[i].data(), path[i].size());
         }
 
-        return Value::Reference(MStringView(text.data(), text.size()), m_arena);
+        return ValueT::Reference(MStringView(text.data(), text.size()), m_valueContext);
     }
 
     [[nodiscard]] bool isNameInList(const ScratchNameList& names, MStringView name)const{
@@ -886,7 +891,7 @@ private:
         return false;
     }
 
-    [[nodiscard]] Value* declaredAssetRoot(const u32 line, const u32 column){
+    [[nodiscard]] ValueT* declaredAssetRoot(const u32 line, const u32 column){
         auto rootIt = m_variables.find(m_declaredAssetVariable);
         if(rootIt == m_variables.end()){
             error(line, column, "missing declared asset variable");
@@ -895,7 +900,7 @@ private:
         return &rootIt.value();
     }
 
-    bool ensureMapValue(Value& value, const u32 line, const u32 column, MStringView message){
+    bool ensureMapValue(ValueT& value, const u32 line, const u32 column, MStringView message){
         if(value.isNull())
             value.makeMap();
         else if(!value.isMap()){
@@ -905,7 +910,7 @@ private:
         return true;
     }
 
-    bool ensureListValue(Value& value, const u32 line, const u32 column, MStringView message){
+    bool ensureListValue(ValueT& value, const u32 line, const u32 column, MStringView message){
         if(value.isNull())
             value.makeList();
         else if(!value.isList()){
@@ -915,14 +920,14 @@ private:
         return true;
     }
 
-    [[nodiscard]] bool containsBindInstanceName(const Value& instances, MStringView instanceName)const{
+    [[nodiscard]] bool containsBindInstanceName(const ValueT& instances, MStringView instanceName)const{
         NWB_ASSERT(instances.isList());
 
-        for(const Value& instance : instances.asList()){
+        for(const ValueT& instance : instances.asList()){
             if(!instance.isMap())
                 continue;
 
-            const Value* name = instance.findField(LiteralView("name"));
+            const ValueT* name = instance.findField(LiteralView("name"));
             if(name && name->isString() && name->asString() == instanceName)
                 return true;
         }
@@ -930,14 +935,14 @@ private:
         return false;
     }
 
-    bool addBindStruct(MStringView structName, Value&& attributes, Value&& fields, const u32 line, const u32 column){
-        Value* assetRoot = declaredAssetRoot(line, column);
+    bool addBindStruct(MStringView structName, ValueT&& attributes, ValueT&& fields, const u32 line, const u32 column){
+        ValueT* assetRoot = declaredAssetRoot(line, column);
         if(!assetRoot)
             return false;
         if(!ensureMapValue(*assetRoot, line, column, "bind declarations require asset root to be a map"))
             return false;
 
-        Value& structs = assetRoot->field(LiteralView("structs"));
+        ValueT& structs = assetRoot->field(LiteralView("structs"));
         if(!ensureMapValue(structs, line, column, "asset.structs must be a map"))
             return false;
         if(structs.findField(structName)){
@@ -945,7 +950,7 @@ private:
             return false;
         }
 
-        Value& outStruct = structs.field(structName);
+        ValueT& outStruct = structs.field(structName);
         outStruct.makeMap();
         outStruct.field(LiteralView("attributes")) = Move(attributes);
         outStruct.field(LiteralView("fields")) = Move(fields);
@@ -953,13 +958,13 @@ private:
     }
 
     bool addBindInstance(MStringView typeName, MStringView instanceName, const u32 line, const u32 column){
-        Value* assetRoot = declaredAssetRoot(line, column);
+        ValueT* assetRoot = declaredAssetRoot(line, column);
         if(!assetRoot)
             return false;
         if(!ensureMapValue(*assetRoot, line, column, "bind declarations require asset root to be a map"))
             return false;
 
-        Value& instances = assetRoot->field(LiteralView("instances"));
+        ValueT& instances = assetRoot->field(LiteralView("instances"));
         if(!ensureListValue(instances, line, column, "asset.instances must be a list"))
             return false;
         if(containsBindInstanceName(instances, instanceName)){
@@ -967,7 +972,7 @@ private:
             return false;
         }
 
-        Value instance(m_arena);
+        ValueT instance(m_valueContext);
         instance.makeMap();
         instance.field(LiteralView("type")).setString(typeName);
         instance.field(LiteralView("name")).setString(instanceName);
@@ -975,7 +980,7 @@ private:
         return true;
     }
 
-    [[nodiscard]] bool isZero(const Value& value)const{
+    [[nodiscard]] bool isZero(const ValueT& value)const{
         if(value.isInteger())
             return value.asInteger() == 0;
         if(value.isDouble())
@@ -985,8 +990,8 @@ private:
 
     bool validateNumericOperands(
         const TokenType::Enum op,
-        const Value& lhs,
-        const Value& rhs,
+        const ValueT& lhs,
+        const ValueT& rhs,
         const u32 line,
         const u32 column,
         const char* operandError,
@@ -1007,7 +1012,7 @@ private:
         return true;
     }
 
-    bool validateBinaryOperation(const TokenType::Enum op, const Value& lhs, const Value& rhs, const u32 line, const u32 column){
+    bool validateBinaryOperation(const TokenType::Enum op, const ValueT& lhs, const ValueT& rhs, const u32 line, const u32 column){
         switch(op){
         case TokenType::Plus:
             if(lhs.isNumeric() && rhs.isNumeric())
@@ -1042,7 +1047,7 @@ private:
         return false;
     }
 
-    bool validateAssignment(const TokenType::Enum op, const Value& target, const Value& rhs, const u32 line, const u32 column){
+    bool validateAssignment(const TokenType::Enum op, const ValueT& target, const ValueT& rhs, const u32 line, const u32 column){
         switch(op){
         case TokenType::Equal:
             return true;
@@ -1165,10 +1170,11 @@ private:
 private:
     Lexer m_lexer;
     MetaArena& m_arena;
+    ValueContext& m_valueContext;
     Alloc::ScratchArena m_scratchArena;
     ScratchNameList m_declaredStructs;
     MVector<ParseError>& m_errors;
-    MStringMap<Value>& m_variables;
+    MStringMap<ValueT>& m_variables;
     Document::DeclarationList& m_declarations;
     MStringView m_declaredAssetVariable;
 
@@ -1176,6 +1182,33 @@ private:
     Token m_previous;
 };
 
+using Parser = BasicParser<Value, MetaArena>;
+using CompactParser = BasicParser<CompactValueDetail::BuildValue, CompactValueDetail::BuildContext>;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<typename AppendChunk>
+[[nodiscard]] bool ReadSourceChunks(IMetaReader& reader, MVector<ParseError>& errors, MetaArena& arena, AppendChunk&& appendChunk){
+    MChar chunk[s_DocumentReaderChunkBytes];
+
+    for(;;){
+        const isize bytesRead = reader.read(chunk, s_DocumentReaderChunkBytes);
+        if(bytesRead < 0){
+            errors.push_back(ParseError{0, 0, MString("read error", arena)});
+            return false;
+        }
+        if(bytesRead == 0)
+            return true;
+        if(static_cast<usize>(bytesRead) > s_DocumentReaderChunkBytes){
+            errors.push_back(ParseError{0, 0, MString("reader returned more bytes than requested", arena)});
+            return false;
+        }
+        appendChunk(chunk, static_cast<usize>(bytesRead));
+    }
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -1197,33 +1230,21 @@ Document::Document(MetaArena& arena)
 
 
 bool Document::parse(MStringView source){
-    m_errors.clear();
-    m_assetType.clear();
-    m_assetVariable.clear();
-    m_variables.clear();
-    m_declarations.clear();
+    clear();
 
-    __hidden_metascript_parser::Parser parser(source, m_arena, m_errors, m_variables, m_declarations);
+    __hidden_metascript_parser::Parser parser(source, m_arena, m_arena, m_errors, m_variables, m_declarations);
     return parser.parseInto(m_assetType, m_assetVariable);
 }
 
 bool Document::parseWithImplicitAsset(MStringView source, MStringView assetType, MStringView assetVariable){
-    m_errors.clear();
-    m_assetType.clear();
-    m_assetVariable.clear();
-    m_variables.clear();
-    m_declarations.clear();
+    clear();
 
-    __hidden_metascript_parser::Parser parser(source, m_arena, m_errors, m_variables, m_declarations);
+    __hidden_metascript_parser::Parser parser(source, m_arena, m_arena, m_errors, m_variables, m_declarations);
     return parser.parseWithImplicitAsset(m_assetType, m_assetVariable, assetType, assetVariable);
 }
 
 bool Document::parse(IMetaReader& reader){
-    m_errors.clear();
-    m_assetType.clear();
-    m_assetVariable.clear();
-    m_variables.clear();
-    m_declarations.clear();
+    clear();
 
     try{
         Alloc::ScratchArena scratchArena(
@@ -1232,22 +1253,15 @@ bool Document::parse(IMetaReader& reader){
         );
         BasicString<MChar, Alloc::ScratchArena> buffer{scratchArena};
         buffer.reserve(__hidden_metascript_parser::s_DocumentReaderChunkBytes);
-        MChar chunk[__hidden_metascript_parser::s_DocumentReaderChunkBytes];
 
-        for(;;){
-            const isize bytesRead = reader.read(chunk, __hidden_metascript_parser::s_DocumentReaderChunkBytes);
-            if(bytesRead < 0){
-                m_errors.push_back(ParseError{0, 0, MString("read error", m_arena)});
-                return false;
-            }
-            if(bytesRead == 0)
-                break;
-            if(static_cast<usize>(bytesRead) > __hidden_metascript_parser::s_DocumentReaderChunkBytes){
-                m_errors.push_back(ParseError{0, 0, MString("reader returned more bytes than requested", m_arena)});
-                return false;
-            }
-            buffer.append(chunk, static_cast<usize>(bytesRead));
-        }
+        const bool read = __hidden_metascript_parser::ReadSourceChunks(
+            reader,
+            m_errors,
+            m_arena,
+            [&buffer](const MChar* chunk, const usize size){ buffer.append(chunk, size); }
+        );
+        if(!read)
+            return false;
 
         return parse(MStringView(buffer.data(), buffer.size()));
     }
@@ -1257,6 +1271,14 @@ bool Document::parse(IMetaReader& reader){
     }
 }
 
+void Document::clear(){
+    m_errors.clear();
+    m_assetType.clear();
+    m_assetVariable.clear();
+    m_variables.clear();
+    m_declarations.clear();
+}
+
 const Value& Document::asset()const{
     const MStringView key(m_assetVariable.data(), m_assetVariable.size());
     auto it = m_variables.find(key);
@@ -1282,6 +1304,70 @@ const Value* Document::findVariable(MStringView name)const{
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+bool CompactDocument::parse(MStringView source){
+    m_ownedSource.clear();
+    return parseSource(source, MStringView(), MStringView(), false);
+}
+
+bool CompactDocument::parseWithImplicitAsset(MStringView source, MStringView assetType, MStringView assetVariable){
+    m_ownedSource.clear();
+    return parseSource(source, assetType, assetVariable, true);
+}
+
+bool CompactDocument::parse(IMetaReader& reader){
+    reset();
+    m_ownedSource.clear();
+
+    try{
+        const bool read = __hidden_metascript_parser::ReadSourceChunks(
+            reader,
+            m_errors,
+            m_arena,
+            [this](const MChar* chunk, const usize size){ m_ownedSource.insert(m_ownedSource.end(), chunk, chunk + size); }
+        );
+        if(!read)
+            return false;
+    }
+    catch(const GeneralException& e){
+        m_errors.push_back(ParseError{0, 0, MString(e.what(), m_arena)});
+        return false;
+    }
+
+    return parseSource(MStringView(m_ownedSource.data(), m_ownedSource.size()), MStringView(), MStringView(), false);
+}
+
+bool CompactDocument::parseSource(
+    const MStringView source,
+    const MStringView assetType,
+    const MStringView assetVariable,
+    const bool implicitAsset
+){
+    reset();
+
+    try{
+        CompactValueDetail::BuildContext context;
+        MStringMap<CompactValueDetail::BuildValue> variables(0, MStringHash(), MStringEqual(), m_arena);
+
+        __hidden_metascript_parser::CompactParser parser(source, m_arena, context, m_errors, variables, m_declarations);
+        const bool parsed = implicitAsset
+            ? parser.parseWithImplicitAsset(m_assetType, m_assetVariable, assetType, assetVariable)
+            : parser.parseInto(m_assetType, m_assetVariable)
+        ;
+        if(!parsed)
+            return false;
+
+        return flatten(source, variables);
+    }
+    catch(const GeneralException& e){
+        m_errors.push_back(ParseError{0, 0, MString(e.what(), m_arena)});
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 NWB_METASCRIPT_END
 
 
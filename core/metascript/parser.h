@@ -70,6 +70,16 @@ public:
     [[nodiscard]] bool hasErrors()const{ return !m_errors.empty(); }
     [[nodiscard]] const ErrorList& errors()const{ return m_errors; }
 
+    // Binary image of a parsed document for tools that cache parse results between runs. readSnapshot restores the
+    // asset type, declarations and variables without running the lexer or parser; it rejects truncated or foreign
+    // bytes and leaves the document empty when it does.
+    [[nodiscard]] bool writeSnapshot(MVector<u8>& outBytes)const;
+    [[nodiscard]] bool readSnapshot(const u8* bytes, usize byteCount);
+
+
+private:
+    void clear();
+
 
 private:
     MetaArena& m_arena;
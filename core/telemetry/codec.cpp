@@ -22,6 +22,23 @@ namespace __hidden_telemetry_codec{
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+static constexpr u32 s_CompactReservedShift = 16u;
+static constexpr u64 s_CompactKindTagLimit = static_cast<u64>(1u) << (s_CompactReservedShift + 8u);
+static constexpr usize s_MaxVarUIntBytes = 10u;
+// Kind tag, stream id, both deltas and payload size at their longest encodings.
+static constexpr usize s_MaxCompactRecordHeaderBytes = 4u + 5u + s_MaxVarUIntBytes * 3u;
+
+
+struct StreamCursor{
+    u64 frameIndex = 0u;
+    u64 timestampNanoseconds = 0u;
+};
+using StreamCursorMap = HashMap<u32, StreamCursor, Hasher<u32>, EqualTo<u32>, TelemetryArena>;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 [[nodiscard]] static bool ValidatePayloadPointer(const void* const payload, const usize payloadBytes)noexcept{
     return payloadBytes == 0u || payload != nullptr;
 }
@@ -40,6 +57,7 @@ namespace __hidden_telemetry_codec{
 
 [[nodiscard]] static bool ValidateStreamHeader(const EncodedStreamHeader& header)noexcept{
     return header.magic == s_StreamMagic
+        && (header.version == s_TelemetryFixedHeaderFormatVersion || header.version == s_TelemetryFormatVersion)
         && header.reserved == 0u
     ;
 }
@@ -89,6 +107,122 @@ template<typename Container>
     return true;
 }
 
+[[nodiscard]] static u64 ZigZagEncode(const u64 delta)noexcept{
+    return (delta << 1u) ^ static_cast<u64>(static_cast<i64>(delta) >> 63u);
+}
+
+[[nodiscard]] static u64 ZigZagDecode(const u64 value)noexcept{
+    return (value >> 1u) ^ (0u - (value & 1u));
+}
+
+static void AppendVarUInt(TelemetryBytes& outBytes, u64 value){
+    u8 encoded[s_MaxVarUIntBytes];
+    usize byteCount = 0u;
+    while(value >= 0x80u){
+        encoded[byteCount++] = static_cast<u8>(value | 0x80u);
+        value >>= 7u;
+    }
+    encoded[byteCount++] = static_cast<u8>(value);
+    BinaryDetail::AppendBytesNoReserveUnchecked(outBytes, encoded, byteCount);
+}
+
+[[nodiscard]] static DecodeStatus::Enum ReadVarUInt(const BinaryByteView& encoded, usize& inOutCursor, u64& outValue){
+    u64 value = 0u;
+    for(u32 shift = 0u; shift < 64u; shift += 7u){
+        if(inOutCursor >= encoded.size())
+            return DecodeStatus::TruncatedHeader;
+
+        const u8 byte = encoded[inOutCursor++];
+        value |= static_cast<u64>(byte & 0x7fu) << shift;
+        if((byte & 0x80u) == 0u){
+            // The tenth byte only carries bit 63.
+            if(shift == 63u && byte > 1u)
+                return DecodeStatus::InvalidHeader;
+            outValue = value;
+            return DecodeStatus::Ok;
+        }
+    }
+    return DecodeStatus::InvalidHeader;
+}
+
+static void AppendCompactEvent(TelemetryBytes& outBytes, StreamCursor& cursor, const EventRecord& event){
+    const EventHeader& header = event.header;
+    AppendVarUInt(outBytes, static_cast<u64>(header.kind) | (static_cast<u64>(header.reserved) << s_CompactReservedShift));
+    AppendVarUInt(outBytes, header.streamId);
+    AppendVarUInt(outBytes, ZigZagEncode(header.frameIndex - cursor.frameIndex));
+    AppendVarUInt(outBytes, ZigZagEncode(header.timestampNanoseconds - cursor.timestampNanoseconds));
+    AppendVarUInt(outBytes, static_cast<u64>(event.payload.size()));
+    if(!event.payload.empty())
+        BinaryDetail::AppendBytesNoReserveUnchecked(outBytes, event.payload.data(), event.payload.size());
+
+    cursor.frameIndex = header.frameIndex;
+    cursor.timestampNanoseconds = header.timestampNanoseconds;
+}
+
+[[nodiscard]] static DecodeResult ReadCompactEvent(
+    const BinaryByteView& encoded,
+    const usize begin,
+    const u16 version,
+    StreamCursorMap& cursors,
+    EventRecord& outEvent
+){
+    DecodeResult result;
+    usize cursor = begin;
+
+    u64 kindTag = 0u;
+    u64 streamId = 0u;
+    u64 frameDelta = 0u;
+    u64 timestampDelta = 0u;
+    u64 payloadBytes = 0u;
+    u64* const fields[] = { &kindTag, &streamId, &frameDelta, &timestampDelta, &payloadBytes };
+    for(u64* const field : fields){
+        result.status = ReadVarUInt(encoded, cursor, *field);
+        if(result.status != DecodeStatus::Ok){
+            result.bytesRead = cursor - begin;
+            return result;
+        }
+    }
+    result.bytesRead = cursor - begin;
+
+    if(kindTag >= s_CompactKindTagLimit || streamId > static_cast<u64>(Limit<u32>::s_Max)){
+        result.status = DecodeStatus::InvalidHeader;
+        return result;
+    }
+
+    StreamCursor& streamCursor = cursors[static_cast<u32>(streamId)];
+    EventHeader& header = outEvent.header;
+    header.version = version;
+    header.kind = static_cast<EventKind::Enum>(kindTag & 0xffffu);
+    header.reserved = static_cast<u8>(kindTag >> s_CompactReservedShift);
+    header.streamId = static_cast<u32>(streamId);
+    header.frameIndex = streamCursor.frameIndex + ZigZagDecode(frameDelta);
+    header.timestampNanoseconds = streamCursor.timestampNanoseconds + ZigZagDecode(timestampDelta);
+    header.payloadBytes = payloadBytes;
+    if(!ValidateHeaderPayload(header)){
+        result.status = DecodeStatus::InvalidHeader;
+        return result;
+    }
+    if(payloadBytes > static_cast<u64>(Limit<usize>::s_Max)){
+        result.status = DecodeStatus::PayloadSizeOverflow;
+        return result;
+    }
+    if(encoded.size() - cursor < static_cast<usize>(payloadBytes)){
+        result.status = DecodeStatus::TruncatedPayload;
+        return result;
+    }
+
+    if(payloadBytes != 0u){
+        outEvent.payload.resize(static_cast<usize>(payloadBytes));
+        NWB_MEMCPY(outEvent.payload.data(), outEvent.payload.size(), encoded.data() + cursor, outEvent.payload.size());
+    }
+    streamCursor.frameIndex = header.frameIndex;
+    streamCursor.timestampNanoseconds = header.timestampNanoseconds;
+
+    result.status = DecodeStatus::Ok;
+    result.bytesRead = cursor + static_cast<usize>(payloadBytes) - begin;
+    return result;
+}
+
 [[nodiscard]] static DecodeResult ReadHeader(const BinaryByteView& encoded, EventHeader& outHeader){
     DecodeResult result;
     result.status = DecodeStatus::TruncatedHeader;
@@ -178,38 +312,36 @@ bool EncodeEventStream(const EventView& events, TelemetryBytes& outBytes){
         return false;
 
     const usize eventCount = events.eventCount();
-    usize payloadBytes = 0u;
+    usize reserveBytes = sizeof(EncodedStreamHeader);
     for(usize i = 0u; i < eventCount; ++i){
         const EventRecord* event = events.eventAt(i);
         if(!event)
             return false;
         if(!__hidden_telemetry_codec::ValidateEventPayload(event->header, event->payload.data(), event->payload.size()))
             return false;
-        if(!AddBinaryReserveBytes(payloadBytes, sizeof(EncodedEventHeader)))
+        if(!AddBinaryReserveBytes(reserveBytes, __hidden_telemetry_codec::s_MaxCompactRecordHeaderBytes))
             return false;
-        if(!AddBinaryReserveBytes(payloadBytes, event->payload.size()))
+        if(!AddBinaryReserveBytes(reserveBytes, event->payload.size()))
             return false;
     }
 
-    usize encodedBytes = sizeof(EncodedStreamHeader);
-    if(!AddBinaryReserveBytes(encodedBytes, payloadBytes))
-        return false;
-
     EncodedStreamHeader streamHeader;
     streamHeader.eventCount = static_cast<u64>(eventCount);
-    streamHeader.payloadBytes = static_cast<u64>(payloadBytes);
 
     outBytes.clear();
-    outBytes.reserve(encodedBytes);
+    outBytes.reserve(reserveBytes);
     AppendPOD(outBytes, streamHeader);
 
+    __hidden_telemetry_codec::StreamCursorMap cursors(0, Hasher<u32>(), EqualTo<u32>(), *outBytes.get_allocator().arenaPtr());
     for(usize i = 0u; i < eventCount; ++i){
         const EventRecord* event = events.eventAt(i);
-        if(!__hidden_telemetry_codec::AppendEncodedEvent(outBytes, event->header, event->payload.data(), event->payload.size()))
-            return false;
+        __hidden_telemetry_codec::AppendCompactEvent(outBytes, cursors[event->header.streamId], *event);
     }
 
-    return outBytes.size() == encodedBytes;
+    // The record sizes are only known once written, so the header is patched in place.
+    streamHeader.payloadBytes = static_cast<u64>(outBytes.size() - sizeof(EncodedStreamHeader));
+    NWB_MEMCPY(outBytes.data(), outBytes.size(), &streamHeader, sizeof(streamHeader));
+    return outBytes.size() <= reserveBytes;
 }
 
 DecodeResult DecodeEventStream(TelemetryArena& arena, const void* const bytes, const usize byteCount, Recorder& outRecorder){
@@ -251,9 +383,15 @@ DecodeResult DecodeEventStream(TelemetryArena& arena, const void* const bytes, c
     }
 
     const usize streamEnd = cursor + streamPayloadBytes;
+    const BinaryByteView streamBytes{ encoded.data(), streamEnd };
+    const bool compact = streamHeader.version != s_TelemetryFixedHeaderFormatVersion;
+    __hidden_telemetry_codec::StreamCursorMap cursors(0, Hasher<u32>(), EqualTo<u32>(), arena);
     for(u64 i = 0u; i < streamHeader.eventCount; ++i){
         EventRecord event(arena);
-        const DecodeResult eventResult = DecodeEvent(arena, encoded.data() + cursor, streamEnd - cursor, event);
+        const DecodeResult eventResult = compact
+            ? __hidden_telemetry_codec::ReadCompactEvent(streamBytes, cursor, streamHeader.version, cursors, event)
+            : DecodeEvent(arena, encoded.data() + cursor, streamEnd - cursor, event)
+        ;
         if(!eventResult.ok()){
             result.status = eventResult.status;
             result.bytesRead = cursor + eventResult.bytesRead;
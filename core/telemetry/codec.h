@@ -19,6 +19,14 @@ NWB_TELEMETRY_BEGIN
 
 inline constexpr u32 s_StreamMagic = 0x4E574253u; // NWBS
 
+// Streams of this version repeat a full EncodedEventHeader before every payload. DecodeEventStream still reads them;
+// EncodeEventStream writes s_TelemetryFormatVersion streams, where each event is a compact record:
+//   varint kind | reserved << 16, varint streamId,
+//   zigzag varint frameIndex and timestampNanoseconds deltas from the previous event of the same streamId (zero before
+//   the first), varint payloadBytes, payload bytes.
+// Compact records drop the per-event magic and version; decoded events take the stream's version.
+inline constexpr u16 s_TelemetryFixedHeaderFormatVersion = 1u;
+
 #pragma pack(push, 1)
 struct EncodedStreamHeader{
     u32 magic = s_StreamMagic;
@@ -17,9 +17,9 @@ NWB_TELEMETRY_BEGIN
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-// Single telemetry wire-format revision shared by the stream header, event header, and per-event identity.
+// Current telemetry wire-format revision shared by the stream header, event header, and per-event identity.
 // Per-payload codecs keep independent version constants.
-inline constexpr u16 s_TelemetryFormatVersion = 1u;
+inline constexpr u16 s_TelemetryFormatVersion = 2u;
 inline constexpr u32 s_EventMagic = 0x4E574254u; // NWBT
 
 
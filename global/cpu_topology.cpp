@@ -4,7 +4,10 @@
 
 #include "cpu_topology.h"
 
+#include "algorithm.h"
+#include "basic_string.h"
 #include "containers.h"
+#include "filesystem/operations.h"
 #include "limit.h"
 #include "platform.h"
 #include "sync.h"
@@ -16,6 +19,13 @@
 #if defined(NWB_PLATFORM_LINUX)
 #include <sched.h>
 #endif
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define NWB_CPU_TOPOLOGY_HAS_CPUID 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define NWB_CPU_TOPOLOGY_HAS_CPUID 1
+#endif
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -108,6 +118,342 @@ AffinityMasks& GetAffinityMasks(){
 }
 
 
+#if defined(NWB_CPU_TOPOLOGY_HAS_CPUID)
+struct CpuidRegisters{
+    u32 eax = 0u;
+    u32 ebx = 0u;
+    u32 ecx = 0u;
+    u32 edx = 0u;
+};
+
+CpuidRegisters Cpuid(const u32 leaf, const u32 subleaf){
+    CpuidRegisters registers;
+#if defined(_MSC_VER)
+    int values[4] = {};
+    __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+    registers.eax = static_cast<u32>(values[0]);
+    registers.ebx = static_cast<u32>(values[1]);
+    registers.ecx = static_cast<u32>(values[2]);
+    registers.edx = static_cast<u32>(values[3]);
+#else
+    __cpuid_count(leaf, subleaf, registers.eax, registers.ebx, registers.ecx, registers.edx);
+#endif
+    return registers;
+}
+
+// XGETBV without requiring the XSAVE target flag on the whole translation unit.
+u64 ReadExtendedControlRegister(){
+#if defined(_MSC_VER)
+    return static_cast<u64>(_xgetbv(0));
+#else
+    u32 low = 0u;
+    u32 high = 0u;
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0u));
+    return (static_cast<u64>(high) << 32u) | low;
+#endif
+}
+#endif
+
+CpuFeature::Mask DetectCpuFeatures(){
+    u32 features = CpuFeature::None;
+#if defined(NWB_CPU_TOPOLOGY_HAS_CPUID)
+    static constexpr u32 s_Leaf1EcxSse42 = 1u << 20u;
+    static constexpr u32 s_Leaf1EcxFma3 = 1u << 12u;
+    static constexpr u32 s_Leaf1EcxOsxsave = 1u << 27u;
+    static constexpr u32 s_Leaf1EcxAvx = 1u << 28u;
+    static constexpr u32 s_Leaf1EcxF16c = 1u << 29u;
+    static constexpr u32 s_Leaf7EbxAvx2 = 1u << 5u;
+    static constexpr u32 s_Leaf7EbxAvx512F = 1u << 16u;
+    static constexpr u32 s_Leaf7EbxAvx512Dq = 1u << 17u;
+    static constexpr u32 s_Leaf7EbxAvx512Bw = 1u << 30u;
+    static constexpr u32 s_Leaf7EbxAvx512Vl = 1u << 31u;
+    // XCR0 bits: SSE and AVX state, then opmask, upper ZMM0-15 and ZMM16-31 state.
+    static constexpr u64 s_XcrAvxState = 0x6u;
+    static constexpr u64 s_XcrAvx512State = 0xE6u;
+
+    const u32 maxLeaf = Cpuid(0u, 0u).eax;
+    if(maxLeaf < 1u)
+        return CpuFeature::None;
+
+    const CpuidRegisters leaf1 = Cpuid(1u, 0u);
+    if(leaf1.ecx & s_Leaf1EcxSse42)
+        features |= CpuFeature::SSE42;
+
+    // The CPU can report AVX while the OS does not save YMM/ZMM state; both have to agree before wide code runs.
+    u64 enabledState = 0u;
+    if(leaf1.ecx & s_Leaf1EcxOsxsave)
+        enabledState = ReadExtendedControlRegister();
+    if((enabledState & s_XcrAvxState) != s_XcrAvxState || !(leaf1.ecx & s_Leaf1EcxAvx))
+        return static_cast<CpuFeature::Mask>(features);
+
+    features |= CpuFeature::AVX;
+    if(leaf1.ecx & s_Leaf1EcxFma3)
+        features |= CpuFeature::FMA3;
+    if(leaf1.ecx & s_Leaf1EcxF16c)
+        features |= CpuFeature::F16C;
+    if(maxLeaf < 7u)
+        return static_cast<CpuFeature::Mask>(features);
+
+    const CpuidRegisters leaf7 = Cpuid(7u, 0u);
+    if(leaf7.ebx & s_Leaf7EbxAvx2)
+        features |= CpuFeature::AVX2;
+    if((enabledState & s_XcrAvx512State) != s_XcrAvx512State || !(leaf7.ebx & s_Leaf7EbxAvx512F))
+        return static_cast<CpuFeature::Mask>(features);
+
+    features |= CpuFeature::AVX512F;
+    if(leaf7.ebx & s_Leaf7EbxAvx512Dq)
+        features |= CpuFeature::AVX512DQ;
+    if(leaf7.ebx & s_Leaf7EbxAvx512Bw)
+        features |= CpuFeature::AVX512BW;
+    if(leaf7.ebx & s_Leaf7EbxAvx512Vl)
+        features |= CpuFeature::AVX512VL;
+#endif
+    return static_cast<CpuFeature::Mask>(features);
+}
+
+static CpuFeature::Mask s_CpuFeatures = CpuFeature::None;
+static OnceFlag s_CpuFeaturesOnce;
+
+// Features each tier's kernels are compiled for; configuration/SimdAVX512.cmake must not enable more than this.
+constexpr u32 s_SimdKernelTierFeatures[SimdKernelTier::kCount] = {
+    CpuFeature::None,
+    CpuFeature::AVX512F | CpuFeature::AVX512DQ,
+};
+static_assert(SimdKernelTier::kCount == 2u, "list the required CpuFeature bits of every SimdKernelTier");
+
+static Atomic<u8> s_ActiveSimdKernelTier{ SimdKernelTier::kCount };
+
+
+static constexpr u32 s_InvalidTopologyIndex = Limit<u32>::s_Max;
+static constexpr u32 s_MaxSysfsCacheIndex = 16u;
+static constexpr u32 s_SharedClusterCacheLevel = 3u;
+static constexpr usize s_SysfsReadBytes = 4096u;
+#if defined(NWB_PLATFORM_LINUX)
+static constexpr const char s_LinuxSystemRoot[] = "/sys/devices/system";
+#endif
+
+using SysfsPath = AInteropString;
+using SysfsBuffer = char[s_SysfsReadBytes];
+
+
+[[nodiscard]] constexpr u64 CpuBit(const u32 cpu){
+    return 1ull << cpu;
+}
+
+[[nodiscard]] u32 CountBits(u64 mask){
+    u32 count = 0u;
+    while(mask){
+        mask &= mask - 1u;
+        ++count;
+    }
+    return count;
+}
+
+[[nodiscard]] u32 LowestCpu(const u64 mask){
+    for(u32 cpu = 0u; cpu < s_MaxCpuTopologyProcessors; ++cpu){
+        if(mask & CpuBit(cpu))
+            return cpu;
+    }
+    return s_InvalidTopologyIndex;
+}
+
+void AppendDecimal(SysfsPath& path, const u32 value){
+    char digits[10];
+    u32 digitCount = 0u;
+    u32 remaining = value;
+    do{
+        digits[digitCount++] = static_cast<char>('0' + remaining % 10u);
+        remaining /= 10u;
+    }while(remaining > 0u);
+    while(digitCount > 0u)
+        path.push_back(digits[--digitCount]);
+}
+
+[[nodiscard]] SysfsPath MakeSysfsPath(
+    const SysfsPath& root,
+    const char* const directory,
+    const u32 index,
+    const char* const leaf
+){
+    SysfsPath path = root;
+    path += directory;
+    AppendDecimal(path, index);
+    path += leaf;
+    return path;
+}
+
+// sysfs reports one page as the size of every attribute, so read up to EOF instead of trusting the file size.
+[[nodiscard]] bool ReadSysfsText(const SysfsPath& path, SysfsBuffer& buffer, AStringView& outText){
+    GlobalFilesystemDetail::InputFileStream stream(path.c_str(), GlobalFilesystemDetail::InputFileStream::binary);
+    if(!stream.is_open())
+        return false;
+
+    stream.read(buffer, static_cast<GlobalFilesystemDetail::StreamSize>(s_SysfsReadBytes));
+    if(stream.bad())
+        return false;
+
+    outText = AStringView(buffer, static_cast<usize>(stream.gcount()));
+    while(!outText.empty() && (outText.back() == '\n' || outText.back() == '\r' || outText.back() == ' '))
+        outText.remove_suffix(1u);
+    return true;
+}
+
+[[nodiscard]] bool ParseDecimal(const AStringView text, usize& cursor, u32& outValue){
+    const usize begin = cursor;
+    u64 value = 0u;
+    while(cursor < text.size() && text[cursor] >= '0' && text[cursor] <= '9'){
+        value = value * 10u + static_cast<u64>(text[cursor] - '0');
+        if(value > Limit<u32>::s_Max)
+            return false;
+        ++cursor;
+    }
+    outValue = static_cast<u32>(value);
+    return cursor > begin;
+}
+
+[[nodiscard]] bool ParseUnsigned(const AStringView text, u32& outValue){
+    usize cursor = 0u;
+    return ParseDecimal(text, cursor, outValue) && cursor == text.size();
+}
+
+// Kernel cpulist format: comma-separated numbers and inclusive ranges such as "0-3,8-11". An empty list is valid.
+// Entries at or past s_MaxCpuTopologyProcessors are dropped.
+[[nodiscard]] bool ParseCpuList(const AStringView text, u64& outMask){
+    u64 mask = 0u;
+    usize cursor = 0u;
+    while(cursor < text.size()){
+        u32 first = 0u;
+        if(!ParseDecimal(text, cursor, first))
+            return false;
+
+        u32 last = first;
+        if(cursor < text.size() && text[cursor] == '-'){
+            ++cursor;
+            if(!ParseDecimal(text, cursor, last) || last < first)
+                return false;
+        }
+        for(u32 cpu = first; cpu <= last && cpu < s_MaxCpuTopologyProcessors; ++cpu)
+            mask |= CpuBit(cpu);
+
+        if(cursor == text.size())
+            break;
+        if(text[cursor] != ',')
+            return false;
+        ++cursor;
+        if(cursor == text.size())
+            return false;
+    }
+    outMask = mask;
+    return true;
+}
+
+[[nodiscard]] bool ReadSysfsCpuList(const SysfsPath& path, SysfsBuffer& buffer, u64& outMask){
+    AStringView text;
+    return ReadSysfsText(path, buffer, text) && ParseCpuList(text, outMask);
+}
+
+// Newer kernels name the sibling lists core_cpus_list and package_cpus_list; older ones only have the legacy names.
+[[nodiscard]] bool ReadCoreSiblings(const SysfsPath& cpuRoot, SysfsBuffer& buffer, u64& outMask){
+    return
+        ReadSysfsCpuList(cpuRoot + "/topology/core_cpus_list", buffer, outMask)
+        || ReadSysfsCpuList(cpuRoot + "/topology/thread_siblings_list", buffer, outMask)
+    ;
+}
+
+[[nodiscard]] bool ReadPackageSiblings(const SysfsPath& cpuRoot, SysfsBuffer& buffer, u64& outMask){
+    return
+        ReadSysfsCpuList(cpuRoot + "/topology/package_cpus_list", buffer, outMask)
+        || ReadSysfsCpuList(cpuRoot + "/topology/core_siblings_list", buffer, outMask)
+    ;
+}
+
+// Cache index directories are not guaranteed to be contiguous, so every index is probed.
+[[nodiscard]] bool ReadSharedL3(const SysfsPath& cpuRoot, SysfsBuffer& buffer, u64& outMask){
+    for(u32 index = 0u; index < s_MaxSysfsCacheIndex; ++index){
+        const SysfsPath cacheRoot = MakeSysfsPath(cpuRoot, "/cache/index", index, "");
+
+        AStringView text;
+        u32 level = 0u;
+        if(!ReadSysfsText(cacheRoot + "/level", buffer, text) || !ParseUnsigned(text, level))
+            continue;
+        if(level == s_SharedClusterCacheLevel && ReadSysfsCpuList(cacheRoot + "/shared_cpu_list", buffer, outMask))
+            return true;
+    }
+    return false;
+}
+
+// Hands out dense indices in order of first appearance, keyed by the lowest CPU of a sibling mask.
+struct DenseIndexMap{
+    u32 indices[s_MaxCpuTopologyProcessors];
+    u32 count = 0u;
+
+    DenseIndexMap(){
+        for(u32& index : indices)
+            index = s_InvalidTopologyIndex;
+    }
+
+    [[nodiscard]] u32 indexOf(const u64 mask){
+        const u32 key = LowestCpu(mask);
+        if(indices[key] == s_InvalidTopologyIndex)
+            indices[key] = count++;
+        return indices[key];
+    }
+};
+
+[[nodiscard]] bool ReadNumaNodes(
+    const SysfsPath& root,
+    const u64 cpuMask,
+    SysfsBuffer& buffer,
+    u32 (&outNodes)[s_MaxCpuTopologyProcessors]
+){
+    u64 nodeMask = 0u;
+    if(!ReadSysfsCpuList(root + "/node/online", buffer, nodeMask))
+        return false;
+
+    for(u32 node = 0u; node < s_MaxCpuTopologyProcessors; ++node){
+        if(!(nodeMask & CpuBit(node)))
+            continue;
+
+        u64 nodeCpus = 0u;
+        if(!ReadSysfsCpuList(MakeSysfsPath(root, "/node/node", node, "/cpulist"), buffer, nodeCpus))
+            return false;
+        for(u32 cpu = 0u; cpu < s_MaxCpuTopologyProcessors; ++cpu){
+            if(nodeCpus & cpuMask & CpuBit(cpu))
+                outNodes[cpu] = node;
+        }
+    }
+    return true;
+}
+
+[[nodiscard]] bool PinningOrderLess(const CpuTopologyProcessor& lhs, const CpuTopologyProcessor& rhs){
+    if(lhs.smtRank != rhs.smtRank)
+        return lhs.smtRank < rhs.smtRank;
+    if(lhs.numaNode != rhs.numaNode)
+        return lhs.numaNode < rhs.numaNode;
+    if(lhs.cluster != rhs.cluster)
+        return lhs.cluster < rhs.cluster;
+    return lhs.physicalCore < rhs.physicalCore;
+}
+
+static CpuTopology s_CpuTopology;
+static OnceFlag s_CpuTopologyOnce;
+
+
+u64 QueryCurrentThreadCpuMask(){
+    u64 mask = 0u;
+#if defined(NWB_PLATFORM_LINUX)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if(::sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0){
+        for(u32 cpu = 0u; cpu < s_MaxCpuTopologyProcessors; ++cpu){
+            if(CPU_ISSET(cpu, &cpuSet))
+                mask |= CpuBit(cpu);
+        }
+    }
+#endif
+    return mask;
+}
+
 u32 QueryCurrentThreadCpuCoreCount(){
 #if defined(NWB_PLATFORM_LINUX)
     cpu_set_t cpuSet;
@@ -165,11 +511,156 @@ void SetCurrentThreadCpuAffinity(u64 mask){
 #if defined(NWB_PLATFORM_WINDOWS)
     if(mask != 0)
         SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask));
+#elif defined(NWB_PLATFORM_LINUX)
+    if(mask == 0)
+        return;
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for(u32 cpu = 0u; cpu < s_MaxCpuTopologyProcessors; ++cpu){
+        if(mask & __hidden_cpu_topology::CpuBit(cpu))
+            CPU_SET(cpu, &cpuSet);
+    }
+    ::sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
 #else
     static_cast<void>(mask);
 #endif
 }
 
 
+bool ParseCpuTopology(const char* systemRoot, u64 allowedMask, CpuTopology& outTopology){
+    using namespace __hidden_cpu_topology;
+
+    outTopology = CpuTopology{};
+    if(!systemRoot)
+        return false;
+
+    const SysfsPath root(systemRoot);
+    SysfsBuffer buffer;
+
+    u64 cpuMask = 0u;
+    if(!ReadSysfsCpuList(root + "/cpu/online", buffer, cpuMask))
+        return false;
+    if(allowedMask != 0u)
+        cpuMask &= allowedMask;
+    if(cpuMask == 0u)
+        return false;
+
+    // A missing node directory means a kernel without NUMA support: everything lives on node 0.
+    u32 numaNodes[s_MaxCpuTopologyProcessors] = {};
+    if(!ReadNumaNodes(root, cpuMask, buffer, numaNodes)){
+        for(u32& node : numaNodes)
+            node = 0u;
+    }
+
+    CpuTopology topology;
+    DenseIndexMap cores;
+    DenseIndexMap clusters;
+    u64 nodeMask = 0u;
+    for(u32 cpu = 0u; cpu < s_MaxCpuTopologyProcessors; ++cpu){
+        if(!(cpuMask & CpuBit(cpu)))
+            continue;
+
+        const SysfsPath cpuRoot = MakeSysfsPath(root, "/cpu/cpu", cpu, "");
+
+        u64 coreMask = 0u;
+        if(!ReadCoreSiblings(cpuRoot, buffer, coreMask))
+            return false;
+        coreMask = (coreMask & cpuMask) | CpuBit(cpu);
+
+        u64 clusterMask = cpuMask;
+        if(!ReadSharedL3(cpuRoot, buffer, clusterMask) && !ReadPackageSiblings(cpuRoot, buffer, clusterMask))
+            clusterMask = cpuMask;
+        clusterMask = (clusterMask & cpuMask) | CpuBit(cpu);
+
+        CpuTopologyProcessor& processor = topology.processors[topology.processorCount++];
+        processor.cpu = cpu;
+        processor.physicalCore = cores.indexOf(coreMask);
+        processor.cluster = clusters.indexOf(clusterMask);
+        processor.numaNode = numaNodes[cpu];
+        processor.smtRank = CountBits(coreMask & (CpuBit(cpu) - 1u));
+        nodeMask |= CpuBit(processor.numaNode);
+    }
+
+    Sort(topology.processors, topology.processors + topology.processorCount, PinningOrderLess);
+    topology.physicalCoreCount = cores.count;
+    topology.clusterCount = clusters.count;
+    topology.numaNodeCount = CountBits(nodeMask);
+    outTopology = topology;
+    return true;
+}
+
+const CpuTopology& QueryCpuTopology(){
+    CallOnce(__hidden_cpu_topology::s_CpuTopologyOnce, [](){
+#if defined(NWB_PLATFORM_LINUX)
+        if(!ParseCpuTopology(
+            __hidden_cpu_topology::s_LinuxSystemRoot,
+            __hidden_cpu_topology::QueryCurrentThreadCpuMask(),
+            __hidden_cpu_topology::s_CpuTopology
+        ))
+            __hidden_cpu_topology::s_CpuTopology = CpuTopology{};
+#endif
+    });
+    return __hidden_cpu_topology::s_CpuTopology;
+}
+
+u64 CpuPinningMask(const CpuTopology& topology, CpuPinning::Enum pinning, usize workerIndex){
+    if(pinning == CpuPinning::None || topology.processorCount == 0u)
+        return 0u;
+
+    const CpuTopologyProcessor& processor = topology.processors[workerIndex % topology.processorCount];
+    if(pinning == CpuPinning::PhysicalCore)
+        return __hidden_cpu_topology::CpuBit(processor.cpu);
+
+    u64 mask = 0u;
+    for(u32 i = 0u; i < topology.processorCount; ++i){
+        if(topology.processors[i].cluster == processor.cluster)
+            mask |= __hidden_cpu_topology::CpuBit(topology.processors[i].cpu);
+    }
+    return mask;
+}
+
+
+CpuFeature::Mask QueryCpuFeatures(){
+    CallOnce(__hidden_cpu_topology::s_CpuFeaturesOnce, [](){
+        __hidden_cpu_topology::s_CpuFeatures = __hidden_cpu_topology::DetectCpuFeatures();
+    });
+    return __hidden_cpu_topology::s_CpuFeatures;
+}
+
+bool SimdKernelTierSupported(const SimdKernelTier::Enum tier){
+    if(tier >= SimdKernelTier::kCount)
+        return false;
+    const u32 required = __hidden_cpu_topology::s_SimdKernelTierFeatures[tier];
+    return (QueryCpuFeatures() & required) == required;
+}
+
+SimdKernelTier::Enum ActiveSimdKernelTier(){
+    u8 tier = __hidden_cpu_topology::s_ActiveSimdKernelTier.load(MemoryOrder::relaxed);
+    if(tier < SimdKernelTier::kCount)
+        return static_cast<SimdKernelTier::Enum>(tier);
+
+    u8 widest = SimdKernelTier::Baseline;
+    for(u8 candidate = SimdKernelTier::kCount - 1u; candidate > SimdKernelTier::Baseline; --candidate){
+        if(SimdKernelTierSupported(static_cast<SimdKernelTier::Enum>(candidate))){
+            widest = candidate;
+            break;
+        }
+    }
+    // A concurrent override wins over the detected default.
+    u8 expected = SimdKernelTier::kCount;
+    if(!__hidden_cpu_topology::s_ActiveSimdKernelTier.compare_exchange_strong(expected, widest, MemoryOrder::relaxed))
+        return static_cast<SimdKernelTier::Enum>(expected);
+    return static_cast<SimdKernelTier::Enum>(widest);
+}
+
+bool SetActiveSimdKernelTier(const SimdKernelTier::Enum tier){
+    if(!SimdKernelTierSupported(tier))
+        return false;
+    __hidden_cpu_topology::s_ActiveSimdKernelTier.store(tier, MemoryOrder::relaxed);
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
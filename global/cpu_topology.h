@@ -19,6 +19,74 @@ namespace CpuAffinity{
     };
 };
 
+namespace CpuFeature{
+    enum Mask : u32{
+        None = 0u,
+        SSE42 = 1u << 0u,
+        AVX = 1u << 1u,
+        AVX2 = 1u << 2u,
+        FMA3 = 1u << 3u,
+        F16C = 1u << 4u,
+        AVX512F = 1u << 5u,
+        AVX512DQ = 1u << 6u,
+        AVX512BW = 1u << 7u,
+        AVX512VL = 1u << 8u,
+    };
+};
+
+// Instruction tiers for hot batch kernels that ship more than one build of the same loop. Baseline is whatever the
+// target was compiled for; wider tiers live in translation units built with extra ISA flags and only run when the CPU
+// reports the features for them.
+namespace SimdKernelTier{
+    enum Enum : u8{
+        Baseline,
+        AVX512,
+
+        kCount
+    };
+};
+
+// How ThreadPool workers are placed on the CPU topology. PhysicalCore gives each worker its own core, on that core's
+// first SMT thread, until every core has one; later workers take the remaining SMT threads in the same order.
+// ClusterLocal walks the same order but lets each worker float over every CPU of the shared-L3 cluster it lands in.
+namespace CpuPinning{
+    enum Enum : u8{
+        None,
+        PhysicalCore,
+        ClusterLocal,
+    };
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Affinity masks are u64, so topology detection and pinning only cover logical CPUs 0 to 63.
+inline constexpr u32 s_MaxCpuTopologyProcessors = 64u;
+
+
+struct CpuTopologyProcessor{
+    // Kernel logical CPU number; also the bit this CPU takes in affinity masks.
+    u32 cpu = 0u;
+    // Dense indices in order of first appearance while walking CPUs in ascending order.
+    u32 physicalCore = 0u;
+    u32 cluster = 0u;
+    // Kernel NUMA node number, 0 when the kernel reports no nodes.
+    u32 numaNode = 0u;
+    // Position among the SMT siblings of the same physical core; 0 is the core's first thread.
+    u32 smtRank = 0u;
+};
+
+// Processors are kept in pinning order: the first SMT thread of every core grouped by NUMA node, then by shared-L3
+// cluster, then the second SMT thread of every core in the same order, and so on.
+struct CpuTopology{
+    CpuTopologyProcessor processors[s_MaxCpuTopologyProcessors];
+    u32 processorCount = 0u;
+    u32 physicalCoreCount = 0u;
+    u32 clusterCount = 0u;
+    u32 numaNodeCount = 0u;
+};
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -27,6 +95,25 @@ namespace CpuAffinity{
 [[nodiscard]] u32 QueryCpuCoreCount(CpuAffinity::Enum type);
 void SetCurrentThreadCpuAffinity(u64 mask);
 
+// Builds a topology from a Linux sysfs "devices/system" tree rooted at `systemRoot`, keeping only the online CPUs set in
+// `allowedMask` (0 keeps all of them). Caches other than L3 are ignored; CPUs without an L3 entry are clustered by
+// package. Fails, leaving `outTopology` empty, when the CPU list or a CPU's sibling list cannot be read.
+[[nodiscard]] bool ParseCpuTopology(const char* systemRoot, u64 allowedMask, CpuTopology& outTopology);
+// Topology of the CPUs the first calling thread may run on, detected once and cached. Empty outside Linux.
+[[nodiscard]] const CpuTopology& QueryCpuTopology();
+// Affinity mask for ThreadPool logical worker `workerIndex`. Index 0 is the pool's calling thread, which keeps its own
+// affinity but still claims the first slot so workers avoid its core. Returns 0 (leave unpinned) for
+// CpuPinning::None or an empty topology; indices past the last processor wrap around.
+[[nodiscard]] u64 CpuPinningMask(const CpuTopology& topology, CpuPinning::Enum pinning, usize workerIndex);
+
+// Features the CPU reports and the OS has enabled register state for; detected once and cached.
+[[nodiscard]] CpuFeature::Mask QueryCpuFeatures();
+[[nodiscard]] bool SimdKernelTierSupported(SimdKernelTier::Enum tier);
+// The widest supported tier is selected on first use. Overriding it is for tests and A/B profiling; it fails, leaving
+// the active tier unchanged, when the CPU cannot run the requested tier.
+[[nodiscard]] SimdKernelTier::Enum ActiveSimdKernelTier();
+bool SetActiveSimdKernelTier(SimdKernelTier::Enum tier);
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
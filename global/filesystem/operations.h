@@ -154,6 +154,15 @@ struct StagedDirectoryPaths{
     Path<ArenaT> backupDirectory;
 };
 
+// Size and last write time of a file. The time is in platform ticks and only compares against another stamp taken on
+// the same machine.
+struct FileStamp{
+    u64 size = 0u;
+    u64 lastWriteTime = 0u;
+
+    [[nodiscard]] bool operator==(const FileStamp& rhs)const{ return size == rhs.size && lastWriteTime == rhs.lastWriteTime; }
+};
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -843,6 +852,41 @@ template<typename ArenaT>
 #endif
 }
 
+template<typename ArenaT>
+[[nodiscard]] inline bool QueryFileStamp(const Path<ArenaT>& path, FileStamp& outStamp, ErrorCode& outError)noexcept{
+#if defined(NWB_PLATFORM_WINDOWS)
+    WIN32_FILE_ATTRIBUTE_DATA data = {};
+    if(!GetFileAttributesEx(path.c_str(), GetFileExInfoStandard, &data)){
+        GlobalFilesystemDetail::SetLastSystemError(outError);
+        return false;
+    }
+
+    GlobalFilesystemDetail::ClearError(outError);
+    outStamp.size = (static_cast<u64>(data.nFileSizeHigh) << GlobalFilesystemDetail::s_FileSizeHighPartShiftBits) | static_cast<u64>(data.nFileSizeLow);
+    outStamp.lastWriteTime =
+        (static_cast<u64>(data.ftLastWriteTime.dwHighDateTime) << GlobalFilesystemDetail::s_FileSizeHighPartShiftBits)
+        | static_cast<u64>(data.ftLastWriteTime.dwLowDateTime)
+    ;
+    return true;
+#else
+    struct stat pathStat;
+    if(stat(path.c_str(), &pathStat) != 0){
+        GlobalFilesystemDetail::SetLastSystemError(outError);
+        return false;
+    }
+
+#if defined(NWB_PLATFORM_APPLE)
+    const timespec& writeTime = pathStat.st_mtimespec;
+#else
+    const timespec& writeTime = pathStat.st_mtim;
+#endif
+    GlobalFilesystemDetail::ClearError(outError);
+    outStamp.size = static_cast<u64>(pathStat.st_size);
+    outStamp.lastWriteTime = static_cast<u64>(writeTime.tv_sec) * 1000000000ull + static_cast<u64>(writeTime.tv_nsec);
+    return true;
+#endif
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
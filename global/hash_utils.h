@@ -10,6 +10,10 @@
 #include "type.h"
 #include "type_borrow.h"
 
+#if NWB_COMPILER_FRONTEND_MSVC
+#include <intrin.h>
+#endif
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -97,6 +101,197 @@ template<typename CharT>
     );
 }
 
+
+
+// wyhash (final version 4) with its default secret. Cooked payload hashes and cache keys are written to disk with it,
+// so the definition must never change; ComputeWyHash64 and WyHash64Stream produce the same value for the same bytes.
+inline constexpr u64 s_WyHashSecret[] = {
+    0x2d358dccaa6c78a5ull,
+    0x8bb84b93962eacc9ull,
+    0x4b33a62ed433d4a3ull,
+    0x4d5a2da51de1aa47ull,
+};
+inline constexpr usize s_WyHashBlockBytes = 48u;
+inline constexpr usize s_WyHashPairBytes = 16u;
+
+
+namespace HashUtilsDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_INLINE void WyMultiply(u64& inOutLow, u64& inOutHigh){
+#if NWB_COMPILER_FRONTEND_GNU
+    const unsigned __int128 product = static_cast<unsigned __int128>(inOutLow) * inOutHigh;
+    inOutLow = static_cast<u64>(product);
+    inOutHigh = static_cast<u64>(product >> 64u);
+#else
+    inOutLow = _umul128(inOutLow, inOutHigh, &inOutHigh);
+#endif
+}
+
+[[nodiscard]] NWB_INLINE u64 WyMix(u64 lhs, u64 rhs){
+    WyMultiply(lhs, rhs);
+    return lhs ^ rhs;
+}
+
+// Little-endian reads; every supported target is little-endian.
+[[nodiscard]] NWB_INLINE u64 WyRead8(const u8* bytes){
+    u64 value = 0u;
+    NWB_MEMCPY(&value, sizeof(value), bytes, sizeof(value));
+    return value;
+}
+
+[[nodiscard]] NWB_INLINE u64 WyRead4(const u8* bytes){
+    u32 value = 0u;
+    NWB_MEMCPY(&value, sizeof(value), bytes, sizeof(value));
+    return value;
+}
+
+[[nodiscard]] NWB_INLINE u64 WySeed(const u64 seed){
+    return seed ^ WyMix(seed ^ s_WyHashSecret[0], s_WyHashSecret[1]);
+}
+
+NWB_INLINE void WyConsumeBlock(const u8* bytes, u64& inOutSeed, u64& inOutSee1, u64& inOutSee2){
+    inOutSeed = WyMix(WyRead8(bytes) ^ s_WyHashSecret[1], WyRead8(bytes + 8u) ^ inOutSeed);
+    inOutSee1 = WyMix(WyRead8(bytes + 16u) ^ s_WyHashSecret[2], WyRead8(bytes + 24u) ^ inOutSee1);
+    inOutSee2 = WyMix(WyRead8(bytes + 32u) ^ s_WyHashSecret[3], WyRead8(bytes + 40u) ^ inOutSee2);
+}
+
+// Hashes the final 1..48 bytes at `bytes` once every full block before them has been consumed. When the whole input
+// is longer than 16 bytes, the 16 bytes before `bytes` must be readable: a short tail re-reads the end of the last
+// block.
+[[nodiscard]] NWB_INLINE u64 WyFinish(const u8* bytes, usize remaining, u64 seed, const u64 totalLength){
+    u64 a = 0u;
+    u64 b = 0u;
+    if(totalLength <= s_WyHashPairBytes){
+        if(remaining >= 4u){
+            const usize middle = (remaining >> 3u) << 2u;
+            a = (WyRead4(bytes) << 32u) | WyRead4(bytes + middle);
+            b = (WyRead4(bytes + remaining - 4u) << 32u) | WyRead4(bytes + remaining - 4u - middle);
+        }
+        else if(remaining > 0u)
+            a = (static_cast<u64>(bytes[0]) << 16u) | (static_cast<u64>(bytes[remaining >> 1u]) << 8u) | bytes[remaining - 1u];
+    }
+    else{
+        while(remaining > s_WyHashPairBytes){
+            seed = WyMix(WyRead8(bytes) ^ s_WyHashSecret[1], WyRead8(bytes + 8u) ^ seed);
+            bytes += s_WyHashPairBytes;
+            remaining -= s_WyHashPairBytes;
+        }
+        a = WyRead8(bytes + remaining - 16u);
+        b = WyRead8(bytes + remaining - 8u);
+    }
+
+    a ^= s_WyHashSecret[1];
+    b ^= seed;
+    WyMultiply(a, b);
+    return WyMix(a ^ s_WyHashSecret[0] ^ totalLength, b ^ s_WyHashSecret[1]);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+[[nodiscard]] inline u64 ComputeWyHash64(const void* data, const usize byteCount, const u64 seed = 0u){
+    const u8* bytes = static_cast<const u8*>(data);
+    usize remaining = byteCount;
+    u64 state = HashUtilsDetail::WySeed(seed);
+    if(remaining > s_WyHashBlockBytes){
+        u64 see1 = state;
+        u64 see2 = state;
+        do{
+            HashUtilsDetail::WyConsumeBlock(bytes, state, see1, see2);
+            bytes += s_WyHashBlockBytes;
+            remaining -= s_WyHashBlockBytes;
+        }while(remaining > s_WyHashBlockBytes);
+        state ^= see1 ^ see2;
+    }
+    return HashUtilsDetail::WyFinish(bytes, remaining, state, static_cast<u64>(byteCount));
+}
+
+// Incremental form of ComputeWyHash64 for inputs that arrive in pieces. Up to one block is held back, so only the
+// bytes after the last full block are copied.
+class WyHash64Stream{
+public:
+    explicit WyHash64Stream(const u64 seed = 0u)
+        : m_seed(HashUtilsDetail::WySeed(seed))
+        , m_see1(m_seed)
+        , m_see2(m_seed)
+    {}
+
+
+public:
+    void update(const void* data, usize byteCount){
+        const u8* bytes = static_cast<const u8*>(data);
+        m_length += static_cast<u64>(byteCount);
+        if(m_pendingCount + byteCount <= s_WyHashBlockBytes){
+            if(byteCount != 0u)
+                NWB_MEMCPY(m_pending + s_WyHashPairBytes + m_pendingCount, s_WyHashBlockBytes - m_pendingCount, bytes, byteCount);
+            m_pendingCount += byteCount;
+            return;
+        }
+
+        // A block is consumed only once a later byte exists, matching the one-shot loop that leaves the last
+        // 1..48 bytes to WyFinish.
+        if(m_pendingCount != 0u){
+            const usize fillCount = s_WyHashBlockBytes - m_pendingCount;
+            NWB_MEMCPY(m_pending + s_WyHashPairBytes + m_pendingCount, fillCount, bytes, fillCount);
+            bytes += fillCount;
+            byteCount -= fillCount;
+            consumeBlock(m_pending + s_WyHashPairBytes);
+        }
+        while(byteCount > s_WyHashBlockBytes){
+            consumeBlock(bytes);
+            bytes += s_WyHashBlockBytes;
+            byteCount -= s_WyHashBlockBytes;
+        }
+
+        NWB_MEMCPY(m_pending + s_WyHashPairBytes, s_WyHashBlockBytes, bytes, byteCount);
+        m_pendingCount = byteCount;
+    }
+    template<typename T>
+    void updateValue(const T& value){
+        static_assert(IsTriviallyCopyable_V<T>, "WyHash64Stream::updateValue requires a trivially copyable value");
+        update(&value, sizeof(value));
+    }
+    template<typename CharT>
+    void updateText(const BasicStringView<CharT> text){
+        updateValue(static_cast<u64>(text.size()));
+        update(text.data(), text.size() * sizeof(CharT));
+    }
+
+    [[nodiscard]] u64 finish()const{
+        u64 seed = m_seed;
+        if(m_length > s_WyHashBlockBytes)
+            seed ^= m_see1 ^ m_see2;
+        return HashUtilsDetail::WyFinish(m_pending + s_WyHashPairBytes, m_pendingCount, seed, m_length);
+    }
+
+
+private:
+    void consumeBlock(const u8* block){
+        HashUtilsDetail::WyConsumeBlock(block, m_seed, m_see1, m_see2);
+        // Keep the block's last pair in front of the pending bytes for a short tail in finish().
+        NWB_MEMCPY(m_pending, s_WyHashPairBytes, block + s_WyHashBlockBytes - s_WyHashPairBytes, s_WyHashPairBytes);
+        m_pendingCount = 0u;
+    }
+
+
+private:
+    u64 m_seed = 0u;
+    u64 m_see1 = 0u;
+    u64 m_see2 = 0u;
+    u64 m_length = 0u;
+    usize m_pendingCount = 0u;
+    u8 m_pending[s_WyHashPairBytes + s_WyHashBlockBytes] = {};
+};
+
+
 inline void HashCombineHash(usize& seed, const usize hash){
     seed ^= hash
         + s_HashCombineGoldenRatio
@@ -600,7 +600,7 @@ inline void FrustumPlanes(
     const SIMDVector rhsExtents,
     const SIMDVector rhsOrientation
 )noexcept{
-    const SIMDVector relativeOrientation = QuaternionMultiply(lhsOrientation, QuaternionConjugate(rhsOrientation));
+    const SIMDVector relativeOrientation = QuaternionMultiply(QuaternionConjugate(lhsOrientation), rhsOrientation);
     SIMDMatrix rotation = MatrixRotationQuaternion(relativeOrientation);
     const SIMDVector translation = Vector3InverseRotate(VectorSubtract(rhsCenter, lhsCenter), lhsOrientation);
 
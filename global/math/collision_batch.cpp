@@ -0,0 +1,28 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <global/math/collision_batch.h>
+#include <global/cpu_topology.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+const CollisionBatchDetail::TierKernels* CollisionBatchDetail::ActiveTierKernels()noexcept{
+    switch(ActiveSimdKernelTier()){
+    case SimdKernelTier::AVX512:
+        return g_Avx512TierKernels.laneCount != 0u ? &g_Avx512TierKernels : nullptr;
+    default:
+        return nullptr;
+    }
+}
+
+usize BoundsBatch::ActiveLaneCount()noexcept{
+    const CollisionBatchDetail::TierKernels* tierKernels = CollisionBatchDetail::ActiveTierKernels();
+    return tierKernels ? tierKernels->laneCount : s_LaneCount;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
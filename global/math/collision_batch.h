@@ -0,0 +1,275 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "collision.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Structure-of-arrays bound streams shared by the batch tests below. Every kernel processes one lane per bound with the
+// same comparisons as the matching scalar Bounding* method, so results only differ where float rounding puts a bound
+// on a boundary. Kernels that select bounds write indices compacted and in input order; their index (and distance)
+// outputs must hold `count` entries because full lanes are stored before the selection is known.
+namespace BoundsBatch{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Lanes of the baseline loops. Frustum culling and box transforms also have SimdKernelTier builds selected at run time;
+// ActiveLaneCount() reports the width those currently use.
+#if defined(NWB_HAS_AVX2)
+inline constexpr usize s_LaneCount = 8u;
+#elif defined(NWB_HAS_SSE4)
+inline constexpr usize s_LaneCount = 4u;
+#else
+inline constexpr usize s_LaneCount = 1u;
+#endif
+
+
+struct SphereStream{
+    const f32* centerX = nullptr;
+    const f32* centerY = nullptr;
+    const f32* centerZ = nullptr;
+    const f32* radius = nullptr;
+};
+
+struct BoxStream{
+    const f32* centerX = nullptr;
+    const f32* centerY = nullptr;
+    const f32* centerZ = nullptr;
+    const f32* extentsX = nullptr;
+    const f32* extentsY = nullptr;
+    const f32* extentsZ = nullptr;
+};
+
+// Orientations must be unit quaternions; the box axes are built from them without renormalizing.
+struct OrientedBoxStream{
+    const f32* centerX = nullptr;
+    const f32* centerY = nullptr;
+    const f32* centerZ = nullptr;
+    const f32* extentsX = nullptr;
+    const f32* extentsY = nullptr;
+    const f32* extentsZ = nullptr;
+    const f32* orientationX = nullptr;
+    const f32* orientationY = nullptr;
+    const f32* orientationZ = nullptr;
+    const f32* orientationW = nullptr;
+};
+
+struct BoxOutputStream{
+    f32* centerX = nullptr;
+    f32* centerY = nullptr;
+    f32* centerZ = nullptr;
+    f32* extentsX = nullptr;
+    f32* extentsY = nullptr;
+    f32* extentsZ = nullptr;
+};
+
+
+[[nodiscard]] usize ActiveLaneCount()noexcept;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Frustum culling against six inward-facing planes. A bound is rejected exactly when some plane puts it fully behind,
+// matching BoundingFrustum::intersects for spheres, boxes and oriented boxes.
+namespace FrustumBatchTests{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+inline constexpr u32 s_PlaneCount = 6u;
+
+
+struct alignas(16) Planes{
+    f32 normalX[s_PlaneCount];
+    f32 normalY[s_PlaneCount];
+    f32 normalZ[s_PlaneCount];
+    f32 distance[s_PlaneCount];
+    f32 absNormalX[s_PlaneCount];
+    f32 absNormalY[s_PlaneCount];
+    f32 absNormalZ[s_PlaneCount];
+};
+
+
+void LoadPlanes(Planes& outPlanes, const SIMDVector* planes)noexcept;
+void LoadPlanes(Planes& outPlanes, const Float4* planes)noexcept;
+void LoadPlanes(Planes& outPlanes, const BoundingFrustum& frustum)noexcept;
+
+// Returns the number of visible bounds written to `outVisibleIndices`.
+[[nodiscard]] usize CullSpheres(
+    const Planes& planes,
+    const BoundsBatch::SphereStream& spheres,
+    usize count,
+    u32* outVisibleIndices
+)noexcept;
+[[nodiscard]] usize CullBoxes(
+    const Planes& planes,
+    const BoundsBatch::BoxStream& boxes,
+    usize count,
+    u32* outVisibleIndices
+)noexcept;
+[[nodiscard]] usize CullOrientedBoxes(
+    const Planes& planes,
+    const BoundsBatch::OrientedBoxStream& boxes,
+    usize count,
+    u32* outVisibleIndices
+)noexcept;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Classifies every bound against one plane (normal xyz, distance w) like the scalar intersects(plane) overloads.
+namespace PlaneBatchTests{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+void ClassifySpheres(
+    const Float4& plane,
+    const BoundsBatch::SphereStream& spheres,
+    usize count,
+    PlaneIntersectionType::Enum* outResults
+)noexcept;
+void ClassifyBoxes(
+    const Float4& plane,
+    const BoundsBatch::BoxStream& boxes,
+    usize count,
+    PlaneIntersectionType::Enum* outResults
+)noexcept;
+void ClassifyOrientedBoxes(
+    const Float4& plane,
+    const BoundsBatch::OrientedBoxStream& boxes,
+    usize count,
+    PlaneIntersectionType::Enum* outResults
+)noexcept;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Casts one ray against every bound. Hit indices are written compacted and `outDistances[i]` is the distance for
+// `outHitIndices[i]`, with the same value the scalar intersects(origin, direction, distance) overload reports.
+namespace RayBatchTests{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+[[nodiscard]] usize IntersectSpheres(
+    const Float3U& origin,
+    const Float3U& direction,
+    const BoundsBatch::SphereStream& spheres,
+    usize count,
+    u32* outHitIndices,
+    f32* outDistances
+)noexcept;
+[[nodiscard]] usize IntersectBoxes(
+    const Float3U& origin,
+    const Float3U& direction,
+    const BoundsBatch::BoxStream& boxes,
+    usize count,
+    u32* outHitIndices,
+    f32* outDistances
+)noexcept;
+[[nodiscard]] usize IntersectOrientedBoxes(
+    const Float3U& origin,
+    const Float3U& direction,
+    const BoundsBatch::OrientedBoxStream& boxes,
+    usize count,
+    u32* outHitIndices,
+    f32* outDistances
+)noexcept;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Overlap queries of one axis-aligned box against every bound, matching BoundingBox::intersects, plus bulk transform of
+// box streams.
+namespace AabbBatchTests{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Returns the number of overlapping bounds written to `outIndices`.
+[[nodiscard]] usize OverlapSpheres(
+    const BoundingBox& query,
+    const BoundsBatch::SphereStream& spheres,
+    usize count,
+    u32* outIndices
+)noexcept;
+[[nodiscard]] usize OverlapBoxes(
+    const BoundingBox& query,
+    const BoundsBatch::BoxStream& boxes,
+    usize count,
+    u32* outIndices
+)noexcept;
+[[nodiscard]] usize OverlapOrientedBoxes(
+    const BoundingBox& query,
+    const BoundsBatch::OrientedBoxStream& boxes,
+    usize count,
+    u32* outIndices
+)noexcept;
+
+// out[i] = the axis-aligned box enclosing boxes[i] transformed by `matrix`, like BoundingBox::transform. The output
+// stream may alias the input stream element for element.
+void TransformBoxes(
+    const SIMDMatrix& matrix,
+    const BoundsBatch::BoxStream& boxes,
+    usize count,
+    const BoundsBatch::BoxOutputStream& outBoxes
+)noexcept;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#define NWB_MATH_COLLISION_BATCH_INCLUDE_INLINE
+#include "collision_batch.inl"
+#undef NWB_MATH_COLLISION_BATCH_INCLUDE_INLINE
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,1126 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if !defined(NWB_MATH_COLLISION_BATCH_INCLUDE_INLINE)
+#error "Do not include collision_batch.inl directly. Include collision_batch.h from global/math or simdmath.h elsewhere."
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace CollisionBatchDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+inline constexpr f32 s_RayParallelEpsilon = 1.0e-20f;
+
+
+// Min/Max keep the SSE operand order (the second operand wins on NaN) so the scalar tail rounds and propagates like
+// the wide lanes and like the AoS collision code.
+struct Lanes1{
+    using Register = f32;
+    using Mask = bool;
+    static constexpr usize s_Count = 1u;
+
+    [[nodiscard]] static NWB_INLINE Register Load(const f32* source)noexcept{ return *source; }
+    static NWB_INLINE void Store(f32* destination, const Register value)noexcept{ *destination = value; }
+    [[nodiscard]] static NWB_INLINE Register Set(const f32 value)noexcept{ return value; }
+    [[nodiscard]] static NWB_INLINE Register Add(const Register lhs, const Register rhs)noexcept{ return lhs + rhs; }
+    [[nodiscard]] static NWB_INLINE Register Sub(const Register lhs, const Register rhs)noexcept{ return lhs - rhs; }
+    [[nodiscard]] static NWB_INLINE Register Mul(const Register lhs, const Register rhs)noexcept{ return lhs * rhs; }
+    [[nodiscard]] static NWB_INLINE Register Div(const Register lhs, const Register rhs)noexcept{ return lhs / rhs; }
+    [[nodiscard]] static NWB_INLINE Register Min(const Register lhs, const Register rhs)noexcept{ return lhs < rhs ? lhs : rhs; }
+    [[nodiscard]] static NWB_INLINE Register Max(const Register lhs, const Register rhs)noexcept{ return lhs > rhs ? lhs : rhs; }
+    [[nodiscard]] static NWB_INLINE Register Abs(const Register value)noexcept{ return ::Abs(value); }
+    [[nodiscard]] static NWB_INLINE Register Negate(const Register value)noexcept{ return -value; }
+    [[nodiscard]] static NWB_INLINE Register Sqrt(const Register value)noexcept{ return ::Sqrt(value); }
+
+    [[nodiscard]] static NWB_INLINE Mask Less(const Register lhs, const Register rhs)noexcept{ return lhs < rhs; }
+    [[nodiscard]] static NWB_INLINE Mask LessEqual(const Register lhs, const Register rhs)noexcept{ return lhs <= rhs; }
+    [[nodiscard]] static NWB_INLINE Mask Greater(const Register lhs, const Register rhs)noexcept{ return lhs > rhs; }
+    [[nodiscard]] static NWB_INLINE Mask GreaterEqual(const Register lhs, const Register rhs)noexcept{ return lhs >= rhs; }
+    [[nodiscard]] static NWB_INLINE Mask None()noexcept{ return false; }
+    [[nodiscard]] static NWB_INLINE Mask Or(const Mask lhs, const Mask rhs)noexcept{ return lhs || rhs; }
+    [[nodiscard]] static NWB_INLINE Mask And(const Mask lhs, const Mask rhs)noexcept{ return lhs && rhs; }
+    [[nodiscard]] static NWB_INLINE Mask AndNot(const Mask lhs, const Mask rhs)noexcept{ return lhs && !rhs; }
+    [[nodiscard]] static NWB_INLINE Register Select(const Mask mask, const Register ifTrue, const Register ifFalse)noexcept{
+        return mask ? ifTrue : ifFalse;
+    }
+    [[nodiscard]] static NWB_INLINE u32 Bits(const Mask mask)noexcept{ return mask ? 1u : 0u; }
+};
+
+#if defined(NWB_HAS_AVX2)
+struct Lanes8{
+    using Register = __m256;
+    using Mask = __m256;
+    static constexpr usize s_Count = 8u;
+
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Load(const f32* source)noexcept{ return _mm256_loadu_ps(source); }
+    static NWB_INLINE void SIMDCALL Store(f32* destination, const Register value)noexcept{ _mm256_storeu_ps(destination, value); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Set(const f32 value)noexcept{ return _mm256_set1_ps(value); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Add(const Register lhs, const Register rhs)noexcept{ return _mm256_add_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Sub(const Register lhs, const Register rhs)noexcept{ return _mm256_sub_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Mul(const Register lhs, const Register rhs)noexcept{ return _mm256_mul_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Div(const Register lhs, const Register rhs)noexcept{ return _mm256_div_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Min(const Register lhs, const Register rhs)noexcept{ return _mm256_min_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Max(const Register lhs, const Register rhs)noexcept{ return _mm256_max_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Abs(const Register value)noexcept{ return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Negate(const Register value)noexcept{ return _mm256_xor_ps(value, _mm256_set1_ps(-0.0f)); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Sqrt(const Register value)noexcept{ return _mm256_sqrt_ps(value); }
+
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL Less(const Register lhs, const Register rhs)noexcept{ return _mm256_cmp_ps(lhs, rhs, _CMP_LT_OQ); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL LessEqual(const Register lhs, const Register rhs)noexcept{ return _mm256_cmp_ps(lhs, rhs, _CMP_LE_OQ); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL Greater(const Register lhs, const Register rhs)noexcept{ return _mm256_cmp_ps(lhs, rhs, _CMP_GT_OQ); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL GreaterEqual(const Register lhs, const Register rhs)noexcept{ return _mm256_cmp_ps(lhs, rhs, _CMP_GE_OQ); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL None()noexcept{ return _mm256_setzero_ps(); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL Or(const Mask lhs, const Mask rhs)noexcept{ return _mm256_or_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL And(const Mask lhs, const Mask rhs)noexcept{ return _mm256_and_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL AndNot(const Mask lhs, const Mask rhs)noexcept{ return _mm256_andnot_ps(rhs, lhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Select(const Mask mask, const Register ifTrue, const Register ifFalse)noexcept{
+        return _mm256_blendv_ps(ifFalse, ifTrue, mask);
+    }
+    [[nodiscard]] static NWB_INLINE u32 SIMDCALL Bits(const Mask mask)noexcept{ return static_cast<u32>(_mm256_movemask_ps(mask)); }
+};
+#elif defined(NWB_HAS_SSE4)
+struct Lanes4{
+    using Register = __m128;
+    using Mask = __m128;
+    static constexpr usize s_Count = 4u;
+
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Load(const f32* source)noexcept{ return _mm_loadu_ps(source); }
+    static NWB_INLINE void SIMDCALL Store(f32* destination, const Register value)noexcept{ _mm_storeu_ps(destination, value); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Set(const f32 value)noexcept{ return _mm_set1_ps(value); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Add(const Register lhs, const Register rhs)noexcept{ return _mm_add_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Sub(const Register lhs, const Register rhs)noexcept{ return _mm_sub_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Mul(const Register lhs, const Register rhs)noexcept{ return _mm_mul_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Div(const Register lhs, const Register rhs)noexcept{ return _mm_div_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Min(const Register lhs, const Register rhs)noexcept{ return _mm_min_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Max(const Register lhs, const Register rhs)noexcept{ return _mm_max_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Abs(const Register value)noexcept{ return _mm_andnot_ps(_mm_set1_ps(-0.0f), value); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Negate(const Register value)noexcept{ return _mm_xor_ps(value, _mm_set1_ps(-0.0f)); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Sqrt(const Register value)noexcept{ return _mm_sqrt_ps(value); }
+
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL Less(const Register lhs, const Register rhs)noexcept{ return _mm_cmplt_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL LessEqual(const Register lhs, const Register rhs)noexcept{ return _mm_cmple_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL Greater(const Register lhs, const Register rhs)noexcept{ return _mm_cmpgt_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL GreaterEqual(const Register lhs, const Register rhs)noexcept{ return _mm_cmpge_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL None()noexcept{ return _mm_setzero_ps(); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL Or(const Mask lhs, const Mask rhs)noexcept{ return _mm_or_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL And(const Mask lhs, const Mask rhs)noexcept{ return _mm_and_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL AndNot(const Mask lhs, const Mask rhs)noexcept{ return _mm_andnot_ps(rhs, lhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Select(const Mask mask, const Register ifTrue, const Register ifFalse)noexcept{
+        return _mm_blendv_ps(ifFalse, ifTrue, mask);
+    }
+    [[nodiscard]] static NWB_INLINE u32 SIMDCALL Bits(const Mask mask)noexcept{ return static_cast<u32>(_mm_movemask_ps(mask)); }
+};
+#endif
+
+#if defined(NWB_HAS_AVX512)
+// Only compiled into the SimdKernelTier::AVX512 sources. Comparisons produce opmask registers, so masks are bit sets.
+struct Lanes16{
+    using Register = __m512;
+    using Mask = __mmask16;
+    static constexpr usize s_Count = 16u;
+
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Load(const f32* source)noexcept{ return _mm512_loadu_ps(source); }
+    static NWB_INLINE void SIMDCALL Store(f32* destination, const Register value)noexcept{ _mm512_storeu_ps(destination, value); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Set(const f32 value)noexcept{ return _mm512_set1_ps(value); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Add(const Register lhs, const Register rhs)noexcept{ return _mm512_add_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Sub(const Register lhs, const Register rhs)noexcept{ return _mm512_sub_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Mul(const Register lhs, const Register rhs)noexcept{ return _mm512_mul_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Div(const Register lhs, const Register rhs)noexcept{ return _mm512_div_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Min(const Register lhs, const Register rhs)noexcept{ return _mm512_min_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Max(const Register lhs, const Register rhs)noexcept{ return _mm512_max_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Abs(const Register value)noexcept{ return _mm512_abs_ps(value); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Negate(const Register value)noexcept{ return _mm512_xor_ps(value, _mm512_set1_ps(-0.0f)); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Sqrt(const Register value)noexcept{ return _mm512_sqrt_ps(value); }
+
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL Less(const Register lhs, const Register rhs)noexcept{ return _mm512_cmp_ps_mask(lhs, rhs, _CMP_LT_OQ); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL LessEqual(const Register lhs, const Register rhs)noexcept{ return _mm512_cmp_ps_mask(lhs, rhs, _CMP_LE_OQ); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL Greater(const Register lhs, const Register rhs)noexcept{ return _mm512_cmp_ps_mask(lhs, rhs, _CMP_GT_OQ); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL GreaterEqual(const Register lhs, const Register rhs)noexcept{ return _mm512_cmp_ps_mask(lhs, rhs, _CMP_GE_OQ); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL None()noexcept{ return 0u; }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL Or(const Mask lhs, const Mask rhs)noexcept{ return static_cast<Mask>(lhs | rhs); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL And(const Mask lhs, const Mask rhs)noexcept{ return static_cast<Mask>(lhs & rhs); }
+    [[nodiscard]] static NWB_INLINE Mask SIMDCALL AndNot(const Mask lhs, const Mask rhs)noexcept{ return static_cast<Mask>(lhs & ~rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Select(const Mask mask, const Register ifTrue, const Register ifFalse)noexcept{
+        return _mm512_mask_blend_ps(mask, ifFalse, ifTrue);
+    }
+    [[nodiscard]] static NWB_INLINE u32 SIMDCALL Bits(const Mask mask)noexcept{ return static_cast<u32>(mask); }
+};
+#endif
+
+#if defined(NWB_HAS_AVX2)
+using WideLanes = Lanes8;
+#elif defined(NWB_HAS_SSE4)
+using WideLanes = Lanes4;
+#else
+using WideLanes = Lanes1;
+#endif
+
+
+template<typename Lanes>
+struct Vector3Lanes{
+    typename Lanes::Register x;
+    typename Lanes::Register y;
+    typename Lanes::Register z;
+};
+
+template<typename Lanes>
+struct OrientedAxesLanes{
+    Vector3Lanes<Lanes> axis[3];
+};
+
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE u32 LaneBits()noexcept{
+    return (1u << Lanes::s_Count) - 1u;
+}
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE typename Lanes::Register Dot3(
+    const typename Lanes::Register ax,
+    const typename Lanes::Register ay,
+    const typename Lanes::Register az,
+    const typename Lanes::Register bx,
+    const typename Lanes::Register by,
+    const typename Lanes::Register bz
+)noexcept{
+    return Lanes::Add(Lanes::Add(Lanes::Mul(ax, bx), Lanes::Mul(ay, by)), Lanes::Mul(az, bz));
+}
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE Vector3Lanes<Lanes> LoadCenter(const f32* x, const f32* y, const f32* z, const usize base)noexcept{
+    return Vector3Lanes<Lanes>{ Lanes::Load(x + base), Lanes::Load(y + base), Lanes::Load(z + base) };
+}
+
+// Rows of the rotation matrix of a unit quaternion: axis[k] is the box's local k axis in world space, the same vectors
+// CollisionDetail::ObbAxes produces with Vector3Rotate.
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE OrientedAxesLanes<Lanes> LoadOrientedAxes(
+    const BoundsBatch::OrientedBoxStream& boxes,
+    const usize base
+)noexcept{
+    const auto qx = Lanes::Load(boxes.orientationX + base);
+    const auto qy = Lanes::Load(boxes.orientationY + base);
+    const auto qz = Lanes::Load(boxes.orientationZ + base);
+    const auto qw = Lanes::Load(boxes.orientationW + base);
+    const auto one = Lanes::Set(1.0f);
+    const auto two = Lanes::Set(2.0f);
+
+    const auto xx = Lanes::Mul(qx, qx);
+    const auto yy = Lanes::Mul(qy, qy);
+    const auto zz = Lanes::Mul(qz, qz);
+    const auto xy = Lanes::Mul(qx, qy);
+    const auto xz = Lanes::Mul(qx, qz);
+    const auto yz = Lanes::Mul(qy, qz);
+    const auto wx = Lanes::Mul(qw, qx);
+    const auto wy = Lanes::Mul(qw, qy);
+    const auto wz = Lanes::Mul(qw, qz);
+
+    OrientedAxesLanes<Lanes> axes;
+    axes.axis[0] = Vector3Lanes<Lanes>{
+        Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(yy, zz))),
+        Lanes::Mul(two, Lanes::Add(xy, wz)),
+        Lanes::Mul(two, Lanes::Sub(xz, wy))
+    };
+    axes.axis[1] = Vector3Lanes<Lanes>{
+        Lanes::Mul(two, Lanes::Sub(xy, wz)),
+        Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(xx, zz))),
+        Lanes::Mul(two, Lanes::Add(yz, wx))
+    };
+    axes.axis[2] = Vector3Lanes<Lanes>{
+        Lanes::Mul(two, Lanes::Add(xz, wy)),
+        Lanes::Mul(two, Lanes::Sub(yz, wx)),
+        Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(xx, yy)))
+    };
+    return axes;
+}
+
+// Helpers below are templated on the lane type even where only the count matters, so a tier's translation unit never
+// emits a shared inline definition built for its wider ISA.
+template<typename Lanes>
+NWB_INLINE usize AppendSelectedLanes(u32 selectedMask, const usize base, u32* outIndices, usize selectedCount)noexcept{
+    for(usize lane = 0u; lane < Lanes::s_Count; ++lane){
+        outIndices[selectedCount] = static_cast<u32>(base + lane);
+        selectedCount += selectedMask & 1u;
+        selectedMask >>= 1u;
+    }
+    return selectedCount;
+}
+
+template<typename Lanes>
+NWB_INLINE usize AppendSelectedLanes(
+    u32 selectedMask,
+    const usize base,
+    const f32* laneDistances,
+    u32* outIndices,
+    f32* outDistances,
+    usize selectedCount
+)noexcept{
+    for(usize lane = 0u; lane < Lanes::s_Count; ++lane){
+        outIndices[selectedCount] = static_cast<u32>(base + lane);
+        outDistances[selectedCount] = laneDistances[lane];
+        selectedCount += selectedMask & 1u;
+        selectedMask >>= 1u;
+    }
+    return selectedCount;
+}
+
+template<typename Lanes>
+NWB_INLINE void StorePlaneResults(
+    u32 frontMask,
+    u32 backMask,
+    const usize base,
+    PlaneIntersectionType::Enum* outResults
+)noexcept{
+    for(usize lane = 0u; lane < Lanes::s_Count; ++lane){
+        outResults[base + lane] = (backMask & 1u) != 0u
+            ? PlaneIntersectionType::Back
+            : ((frontMask & 1u) != 0u ? PlaneIntersectionType::Front : PlaneIntersectionType::Intersecting)
+        ;
+        frontMask >>= 1u;
+        backMask >>= 1u;
+    }
+}
+
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE typename Lanes::Register FrustumPlaneDistance(
+    const FrustumBatchTests::Planes& planes,
+    const u32 planeIndex,
+    const Vector3Lanes<Lanes>& center
+)noexcept{
+    const auto xyz = Dot3<Lanes>(
+        center.x,
+        center.y,
+        center.z,
+        Lanes::Set(planes.normalX[planeIndex]),
+        Lanes::Set(planes.normalY[planeIndex]),
+        Lanes::Set(planes.normalZ[planeIndex])
+    );
+    return Lanes::Add(xyz, Lanes::Set(planes.distance[planeIndex]));
+}
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE u32 FrustumSphereMask(
+    const FrustumBatchTests::Planes& planes,
+    const BoundsBatch::SphereStream& spheres,
+    const usize base
+)noexcept{
+    const auto center = LoadCenter<Lanes>(spheres.centerX, spheres.centerY, spheres.centerZ, base);
+    const auto negativeRadius = Lanes::Negate(Lanes::Load(spheres.radius + base));
+
+    auto outside = Lanes::None();
+    for(u32 planeIndex = 0u; planeIndex < FrustumBatchTests::s_PlaneCount; ++planeIndex)
+        outside = Lanes::Or(outside, Lanes::Less(FrustumPlaneDistance<Lanes>(planes, planeIndex, center), negativeRadius));
+    return ~Lanes::Bits(outside) & LaneBits<Lanes>();
+}
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE u32 FrustumBoxMask(
+    const FrustumBatchTests::Planes& planes,
+    const BoundsBatch::BoxStream& boxes,
+    const usize base
+)noexcept{
+    const auto center = LoadCenter<Lanes>(boxes.centerX, boxes.centerY, boxes.centerZ, base);
+    const auto extentsX = Lanes::Load(boxes.extentsX + base);
+    const auto extentsY = Lanes::Load(boxes.extentsY + base);
+    const auto extentsZ = Lanes::Load(boxes.extentsZ + base);
+
+    auto outside = Lanes::None();
+    for(u32 planeIndex = 0u; planeIndex < FrustumBatchTests::s_PlaneCount; ++planeIndex){
+        const auto radius = Dot3<Lanes>(
+            extentsX,
+            extentsY,
+            extentsZ,
+            Lanes::Set(planes.absNormalX[planeIndex]),
+            Lanes::Set(planes.absNormalY[planeIndex]),
+            Lanes::Set(planes.absNormalZ[planeIndex])
+        );
+        const auto distance = FrustumPlaneDistance<Lanes>(planes, planeIndex, center);
+        outside = Lanes::Or(outside, Lanes::Less(distance, Lanes::Negate(radius)));
+    }
+    return ~Lanes::Bits(outside) & LaneBits<Lanes>();
+}
+
+// Projected half width of an oriented box onto a plane normal.
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE typename Lanes::Register OrientedBoxPlaneRadius(
+    const OrientedAxesLanes<Lanes>& axes,
+    const typename Lanes::Register extentsX,
+    const typename Lanes::Register extentsY,
+    const typename Lanes::Register extentsZ,
+    const typename Lanes::Register normalX,
+    const typename Lanes::Register normalY,
+    const typename Lanes::Register normalZ
+)noexcept{
+    const auto projected0 = Dot3<Lanes>(normalX, normalY, normalZ, axes.axis[0].x, axes.axis[0].y, axes.axis[0].z);
+    const auto projected1 = Dot3<Lanes>(normalX, normalY, normalZ, axes.axis[1].x, axes.axis[1].y, axes.axis[1].z);
+    const auto projected2 = Dot3<Lanes>(normalX, normalY, normalZ, axes.axis[2].x, axes.axis[2].y, axes.axis[2].z);
+    return Dot3<Lanes>(extentsX, extentsY, extentsZ, Lanes::Abs(projected0), Lanes::Abs(projected1), Lanes::Abs(projected2));
+}
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE u32 FrustumOrientedBoxMask(
+    const FrustumBatchTests::Planes& planes,
+    const BoundsBatch::OrientedBoxStream& boxes,
+    const usize base
+)noexcept{
+    const auto center = LoadCenter<Lanes>(boxes.centerX, boxes.centerY, boxes.centerZ, base);
+    const auto extentsX = Lanes::Load(boxes.extentsX + base);
+    const auto extentsY = Lanes::Load(boxes.extentsY + base);
+    const auto extentsZ = Lanes::Load(boxes.extentsZ + base);
+    const auto axes = LoadOrientedAxes<Lanes>(boxes, base);
+
+    auto outside = Lanes::None();
+    for(u32 planeIndex = 0u; planeIndex < FrustumBatchTests::s_PlaneCount; ++planeIndex){
+        const auto radius = OrientedBoxPlaneRadius<Lanes>(
+            axes,
+            extentsX,
+            extentsY,
+            extentsZ,
+            Lanes::Set(planes.normalX[planeIndex]),
+            Lanes::Set(planes.normalY[planeIndex]),
+            Lanes::Set(planes.normalZ[planeIndex])
+        );
+        const auto distance = FrustumPlaneDistance<Lanes>(planes, planeIndex, center);
+        outside = Lanes::Or(outside, Lanes::Less(distance, Lanes::Negate(radius)));
+    }
+    return ~Lanes::Bits(outside) & LaneBits<Lanes>();
+}
+
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE typename Lanes::Register PlaneDistance(const Float4& plane, const Vector3Lanes<Lanes>& center)noexcept{
+    const auto xyz = Dot3<Lanes>(center.x, center.y, center.z, Lanes::Set(plane.x), Lanes::Set(plane.y), Lanes::Set(plane.z));
+    return Lanes::Add(xyz, Lanes::Set(plane.w));
+}
+
+template<typename Lanes>
+NWB_INLINE void ClassifySphereLanes(
+    const Float4& plane,
+    const BoundsBatch::SphereStream& spheres,
+    const usize base,
+    PlaneIntersectionType::Enum* outResults
+)noexcept{
+    const auto center = LoadCenter<Lanes>(spheres.centerX, spheres.centerY, spheres.centerZ, base);
+    const auto radius = Lanes::Load(spheres.radius + base);
+    const auto distance = PlaneDistance<Lanes>(plane, center);
+    StorePlaneResults<Lanes>(
+        Lanes::Bits(Lanes::Greater(distance, radius)),
+        Lanes::Bits(Lanes::Less(distance, Lanes::Negate(radius))),
+        base,
+        outResults
+    );
+}
+
+template<typename Lanes>
+NWB_INLINE void ClassifyBoxLanes(
+    const Float4& plane,
+    const BoundsBatch::BoxStream& boxes,
+    const usize base,
+    PlaneIntersectionType::Enum* outResults
+)noexcept{
+    const auto center = LoadCenter<Lanes>(boxes.centerX, boxes.centerY, boxes.centerZ, base);
+    const auto radius = Dot3<Lanes>(
+        Lanes::Load(boxes.extentsX + base),
+        Lanes::Load(boxes.extentsY + base),
+        Lanes::Load(boxes.extentsZ + base),
+        Lanes::Abs(Lanes::Set(plane.x)),
+        Lanes::Abs(Lanes::Set(plane.y)),
+        Lanes::Abs(Lanes::Set(plane.z))
+    );
+    const auto distance = PlaneDistance<Lanes>(plane, center);
+    StorePlaneResults<Lanes>(
+        Lanes::Bits(Lanes::GreaterEqual(distance, radius)),
+        Lanes::Bits(Lanes::Less(distance, Lanes::Negate(radius))),
+        base,
+        outResults
+    );
+}
+
+template<typename Lanes>
+NWB_INLINE void ClassifyOrientedBoxLanes(
+    const Float4& plane,
+    const BoundsBatch::OrientedBoxStream& boxes,
+    const usize base,
+    PlaneIntersectionType::Enum* outResults
+)noexcept{
+    const auto center = LoadCenter<Lanes>(boxes.centerX, boxes.centerY, boxes.centerZ, base);
+    const auto radius = OrientedBoxPlaneRadius<Lanes>(
+        LoadOrientedAxes<Lanes>(boxes, base),
+        Lanes::Load(boxes.extentsX + base),
+        Lanes::Load(boxes.extentsY + base),
+        Lanes::Load(boxes.extentsZ + base),
+        Lanes::Set(plane.x),
+        Lanes::Set(plane.y),
+        Lanes::Set(plane.z)
+    );
+    const auto distance = PlaneDistance<Lanes>(plane, center);
+    StorePlaneResults<Lanes>(
+        Lanes::Bits(Lanes::GreaterEqual(distance, radius)),
+        Lanes::Bits(Lanes::Less(distance, Lanes::Negate(radius))),
+        base,
+        outResults
+    );
+}
+
+
+// One slab of the ray/box test in CollisionDetail::RayIntersectsMinMax. `axisOrigin` is the box center relative to
+// the ray origin; parallel axes take the full range and miss only when the origin lies outside the slab.
+template<typename Lanes>
+NWB_INLINE void RaySlab(
+    const typename Lanes::Register axisOrigin,
+    const typename Lanes::Register extents,
+    const typename Lanes::Register direction,
+    typename Lanes::Register& outNear,
+    typename Lanes::Register& outFar,
+    typename Lanes::Mask& inOutMiss
+)noexcept{
+    const auto parallel = Lanes::LessEqual(Lanes::Abs(direction), Lanes::Set(s_RayParallelEpsilon));
+    const auto inverseDirection = Lanes::Div(Lanes::Set(1.0f), direction);
+    const auto t1 = Lanes::Mul(Lanes::Sub(axisOrigin, extents), inverseDirection);
+    const auto t2 = Lanes::Mul(Lanes::Add(axisOrigin, extents), inverseDirection);
+    outNear = Lanes::Select(parallel, Lanes::Set(-s_MaxF32), Lanes::Min(t1, t2));
+    outFar = Lanes::Select(parallel, Lanes::Set(s_MaxF32), Lanes::Max(t1, t2));
+
+    const auto inside = Lanes::And(Lanes::LessEqual(axisOrigin, extents), Lanes::LessEqual(Lanes::Negate(extents), axisOrigin));
+    inOutMiss = Lanes::Or(inOutMiss, Lanes::AndNot(parallel, inside));
+}
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE u32 RaySlabs(
+    const Vector3Lanes<Lanes>& axisOrigin,
+    const Vector3Lanes<Lanes>& extents,
+    const Vector3Lanes<Lanes>& direction,
+    typename Lanes::Register& outDistance
+)noexcept{
+    auto miss = Lanes::None();
+    typename Lanes::Register nearX, farX, nearY, farY, nearZ, farZ;
+    RaySlab<Lanes>(axisOrigin.x, extents.x, direction.x, nearX, farX, miss);
+    RaySlab<Lanes>(axisOrigin.y, extents.y, direction.y, nearY, farY, miss);
+    RaySlab<Lanes>(axisOrigin.z, extents.z, direction.z, nearZ, farZ, miss);
+
+    const auto tMin = Lanes::Max(Lanes::Max(nearX, nearY), nearZ);
+    const auto tMax = Lanes::Min(Lanes::Min(farX, farY), farZ);
+    miss = Lanes::Or(miss, Lanes::Greater(tMin, tMax));
+    miss = Lanes::Or(miss, Lanes::Less(tMax, Lanes::Set(0.0f)));
+    outDistance = tMin;
+    return ~Lanes::Bits(miss) & LaneBits<Lanes>();
+}
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE u32 RaySphereMask(
+    const Float3U& origin,
+    const Float3U& direction,
+    const BoundsBatch::SphereStream& spheres,
+    const usize base,
+    typename Lanes::Register& outDistance
+)noexcept{
+    const auto localX = Lanes::Sub(Lanes::Set(origin.x), Lanes::Load(spheres.centerX + base));
+    const auto localY = Lanes::Sub(Lanes::Set(origin.y), Lanes::Load(spheres.centerY + base));
+    const auto localZ = Lanes::Sub(Lanes::Set(origin.z), Lanes::Load(spheres.centerZ + base));
+    const auto radius = Lanes::Load(spheres.radius + base);
+    const auto zero = Lanes::Set(0.0f);
+
+    const auto b = Dot3<Lanes>(localX, localY, localZ, Lanes::Set(direction.x), Lanes::Set(direction.y), Lanes::Set(direction.z));
+    const auto c = Lanes::Sub(Dot3<Lanes>(localX, localY, localZ, localX, localY, localZ), Lanes::Mul(radius, radius));
+    const auto discriminant = Lanes::Sub(Lanes::Mul(b, b), c);
+
+    auto miss = Lanes::And(Lanes::Greater(c, zero), Lanes::Greater(b, zero));
+    miss = Lanes::Or(miss, Lanes::Less(discriminant, zero));
+    outDistance = Lanes::Max(zero, Lanes::Sub(Lanes::Negate(b), Lanes::Sqrt(discriminant)));
+    return ~Lanes::Bits(miss) & LaneBits<Lanes>();
+}
+
+// Rebuilds center and extents from min/max first, like BoundingBox::intersects(ray), so the slab inputs round the same.
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE u32 RayBoxMask(
+    const Float3U& origin,
+    const Vector3Lanes<Lanes>& direction,
+    const BoundsBatch::BoxStream& boxes,
+    const usize base,
+    typename Lanes::Register& outDistance
+)noexcept{
+    const auto half = Lanes::Set(0.5f);
+    const auto rebuild = [&](const f32* center, const f32* extents, const f32 rayOrigin, auto& outAxisOrigin, auto& outExtents){
+        const auto centerValue = Lanes::Load(center + base);
+        const auto extentsValue = Lanes::Load(extents + base);
+        const auto minBound = Lanes::Sub(centerValue, extentsValue);
+        const auto maxBound = Lanes::Add(centerValue, extentsValue);
+        outAxisOrigin = Lanes::Sub(Lanes::Mul(Lanes::Add(minBound, maxBound), half), Lanes::Set(rayOrigin));
+        outExtents = Lanes::Mul(Lanes::Sub(maxBound, minBound), half);
+    };
+
+    Vector3Lanes<Lanes> axisOrigin;
+    Vector3Lanes<Lanes> extents;
+    rebuild(boxes.centerX, boxes.extentsX, origin.x, axisOrigin.x, extents.x);
+    rebuild(boxes.centerY, boxes.extentsY, origin.y, axisOrigin.y, extents.y);
+    rebuild(boxes.centerZ, boxes.extentsZ, origin.z, axisOrigin.z, extents.z);
+    return RaySlabs<Lanes>(axisOrigin, extents, direction, outDistance);
+}
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE u32 RayOrientedBoxMask(
+    const Float3U& origin,
+    const Float3U& direction,
+    const BoundsBatch::OrientedBoxStream& boxes,
+    const usize base,
+    typename Lanes::Register& outDistance
+)noexcept{
+    const auto axes = LoadOrientedAxes<Lanes>(boxes, base);
+    const auto relativeX = Lanes::Sub(Lanes::Set(origin.x), Lanes::Load(boxes.centerX + base));
+    const auto relativeY = Lanes::Sub(Lanes::Set(origin.y), Lanes::Load(boxes.centerY + base));
+    const auto relativeZ = Lanes::Sub(Lanes::Set(origin.z), Lanes::Load(boxes.centerZ + base));
+    const auto directionX = Lanes::Set(direction.x);
+    const auto directionY = Lanes::Set(direction.y);
+    const auto directionZ = Lanes::Set(direction.z);
+
+    Vector3Lanes<Lanes> localAxisOrigin;
+    Vector3Lanes<Lanes> localDirection;
+    typename Lanes::Register* axisOriginComponents[3] = { &localAxisOrigin.x, &localAxisOrigin.y, &localAxisOrigin.z };
+    typename Lanes::Register* directionComponents[3] = { &localDirection.x, &localDirection.y, &localDirection.z };
+    for(u32 axisIndex = 0u; axisIndex < 3u; ++axisIndex){
+        const Vector3Lanes<Lanes>& axis = axes.axis[axisIndex];
+        *axisOriginComponents[axisIndex] = Lanes::Negate(Dot3<Lanes>(relativeX, relativeY, relativeZ, axis.x, axis.y, axis.z));
+        *directionComponents[axisIndex] = Dot3<Lanes>(directionX, directionY, directionZ, axis.x, axis.y, axis.z);
+    }
+
+    const Vector3Lanes<Lanes> extents{
+        Lanes::Load(boxes.extentsX + base),
+        Lanes::Load(boxes.extentsY + base),
+        Lanes::Load(boxes.extentsZ + base)
+    };
+    return RaySlabs<Lanes>(localAxisOrigin, extents, localDirection, outDistance);
+}
+
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE u32 AabbSphereMask(
+    const Float4& queryMin,
+    const Float4& queryMax,
+    const BoundsBatch::SphereStream& spheres,
+    const usize base
+)noexcept{
+    const auto center = LoadCenter<Lanes>(spheres.centerX, spheres.centerY, spheres.centerZ, base);
+    const auto radius = Lanes::Load(spheres.radius + base);
+    const auto deltaX = Lanes::Sub(Lanes::Min(Lanes::Max(center.x, Lanes::Set(queryMin.x)), Lanes::Set(queryMax.x)), center.x);
+    const auto deltaY = Lanes::Sub(Lanes::Min(Lanes::Max(center.y, Lanes::Set(queryMin.y)), Lanes::Set(queryMax.y)), center.y);
+    const auto deltaZ = Lanes::Sub(Lanes::Min(Lanes::Max(center.z, Lanes::Set(queryMin.z)), Lanes::Set(queryMax.z)), center.z);
+    const auto distanceSquared = Dot3<Lanes>(deltaX, deltaY, deltaZ, deltaX, deltaY, deltaZ);
+    return Lanes::Bits(Lanes::LessEqual(distanceSquared, Lanes::Mul(radius, radius)));
+}
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE u32 AabbBoxMask(
+    const Float4& queryMin,
+    const Float4& queryMax,
+    const BoundsBatch::BoxStream& boxes,
+    const usize base
+)noexcept{
+    auto disjoint = Lanes::None();
+    const auto testAxis = [&](const f32* center, const f32* extents, const f32 minBound, const f32 maxBound){
+        const auto centerValue = Lanes::Load(center + base);
+        const auto extentsValue = Lanes::Load(extents + base);
+        disjoint = Lanes::Or(disjoint, Lanes::Greater(Lanes::Set(minBound), Lanes::Add(centerValue, extentsValue)));
+        disjoint = Lanes::Or(disjoint, Lanes::Greater(Lanes::Sub(centerValue, extentsValue), Lanes::Set(maxBound)));
+    };
+    testAxis(boxes.centerX, boxes.extentsX, queryMin.x, queryMax.x);
+    testAxis(boxes.centerY, boxes.extentsY, queryMin.y, queryMax.y);
+    testAxis(boxes.centerZ, boxes.extentsZ, queryMin.z, queryMax.z);
+    return ~Lanes::Bits(disjoint) & LaneBits<Lanes>();
+}
+
+// Separating axis test of the query box against each oriented box: the query's three face axes, the oriented box's
+// three face axes, and the nine edge cross products, as in CollisionDetail::ObbIntersectsObb.
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE u32 AabbOrientedBoxMask(
+    const Float4& queryCenter,
+    const Float4& queryExtents,
+    const BoundsBatch::OrientedBoxStream& boxes,
+    const usize base
+)noexcept{
+    using Register = typename Lanes::Register;
+
+    const auto axes = LoadOrientedAxes<Lanes>(boxes, base);
+    const Register translation[3] = {
+        Lanes::Sub(Lanes::Load(boxes.centerX + base), Lanes::Set(queryCenter.x)),
+        Lanes::Sub(Lanes::Load(boxes.centerY + base), Lanes::Set(queryCenter.y)),
+        Lanes::Sub(Lanes::Load(boxes.centerZ + base), Lanes::Set(queryCenter.z)),
+    };
+    const Register queryHalf[3] = { Lanes::Set(queryExtents.x), Lanes::Set(queryExtents.y), Lanes::Set(queryExtents.z) };
+    const Register boxHalf[3] = {
+        Lanes::Load(boxes.extentsX + base),
+        Lanes::Load(boxes.extentsY + base),
+        Lanes::Load(boxes.extentsZ + base),
+    };
+
+    // rotation[i][j] is world axis i of the oriented box's axis j.
+    Register rotation[3][3];
+    Register absRotation[3][3];
+    for(u32 j = 0u; j < 3u; ++j){
+        rotation[0][j] = axes.axis[j].x;
+        rotation[1][j] = axes.axis[j].y;
+        rotation[2][j] = axes.axis[j].z;
+        for(u32 i = 0u; i < 3u; ++i)
+            absRotation[i][j] = Lanes::Abs(rotation[i][j]);
+    }
+
+    auto separated = Lanes::None();
+    for(u32 i = 0u; i < 3u; ++i){
+        const auto boxRadius = Dot3<Lanes>(boxHalf[0], boxHalf[1], boxHalf[2], absRotation[i][0], absRotation[i][1], absRotation[i][2]);
+        separated = Lanes::Or(separated, Lanes::Greater(Lanes::Abs(translation[i]), Lanes::Add(queryHalf[i], boxRadius)));
+    }
+    for(u32 j = 0u; j < 3u; ++j){
+        const auto distance = Dot3<Lanes>(translation[0], translation[1], translation[2], rotation[0][j], rotation[1][j], rotation[2][j]);
+        const auto queryRadius = Dot3<Lanes>(queryHalf[0], queryHalf[1], queryHalf[2], absRotation[0][j], absRotation[1][j], absRotation[2][j]);
+        separated = Lanes::Or(separated, Lanes::Greater(Lanes::Abs(distance), Lanes::Add(queryRadius, boxHalf[j])));
+    }
+    for(u32 i = 0u; i < 3u; ++i){
+        const u32 i1 = (i + 1u) % 3u;
+        const u32 i2 = (i + 2u) % 3u;
+        for(u32 j = 0u; j < 3u; ++j){
+            const u32 j1 = (j + 1u) % 3u;
+            const u32 j2 = (j + 2u) % 3u;
+            const auto distance = Lanes::Sub(Lanes::Mul(translation[i2], rotation[i1][j]), Lanes::Mul(translation[i1], rotation[i2][j]));
+            const auto queryRadius = Lanes::Add(Lanes::Mul(queryHalf[i1], absRotation[i2][j]), Lanes::Mul(queryHalf[i2], absRotation[i1][j]));
+            const auto boxRadius = Lanes::Add(Lanes::Mul(boxHalf[j1], absRotation[i][j2]), Lanes::Mul(boxHalf[j2], absRotation[i][j1]));
+            separated = Lanes::Or(separated, Lanes::Greater(Lanes::Abs(distance), Lanes::Add(queryRadius, boxRadius)));
+        }
+    }
+    return ~Lanes::Bits(separated) & LaneBits<Lanes>();
+}
+
+// center' = M * center and extents' = |M| * extents, which is the tight box around the eight transformed corners.
+template<typename Lanes>
+NWB_INLINE void TransformBoxLanes(
+    const Float4* rows,
+    const BoundsBatch::BoxStream& boxes,
+    const usize base,
+    const BoundsBatch::BoxOutputStream& outBoxes
+)noexcept{
+    const auto center = LoadCenter<Lanes>(boxes.centerX, boxes.centerY, boxes.centerZ, base);
+    const auto extentsX = Lanes::Load(boxes.extentsX + base);
+    const auto extentsY = Lanes::Load(boxes.extentsY + base);
+    const auto extentsZ = Lanes::Load(boxes.extentsZ + base);
+
+    typename Lanes::Register outCenter[3];
+    typename Lanes::Register outExtents[3];
+    for(u32 row = 0u; row < 3u; ++row){
+        const Float4& m = rows[row];
+        outCenter[row] = Lanes::Add(
+            Dot3<Lanes>(center.x, center.y, center.z, Lanes::Set(m.x), Lanes::Set(m.y), Lanes::Set(m.z)),
+            Lanes::Set(m.w)
+        );
+        outExtents[row] = Dot3<Lanes>(
+            extentsX,
+            extentsY,
+            extentsZ,
+            Lanes::Abs(Lanes::Set(m.x)),
+            Lanes::Abs(Lanes::Set(m.y)),
+            Lanes::Abs(Lanes::Set(m.z))
+        );
+    }
+
+    Lanes::Store(outBoxes.centerX + base, outCenter[0]);
+    Lanes::Store(outBoxes.centerY + base, outCenter[1]);
+    Lanes::Store(outBoxes.centerZ + base, outCenter[2]);
+    Lanes::Store(outBoxes.extentsX + base, outExtents[0]);
+    Lanes::Store(outBoxes.extentsY + base, outExtents[1]);
+    Lanes::Store(outBoxes.extentsZ + base, outExtents[2]);
+}
+
+// Full-block kernels of a wider SimdKernelTier, built in their own translation unit. Each entry processes the first
+// `blockCount` elements (a multiple of `laneCount`) exactly like the baseline loops, leaving the remainder to them.
+struct TierKernels{
+    usize laneCount = 0u;
+    usize (*cullSpheres)(const FrustumBatchTests::Planes&, const BoundsBatch::SphereStream&, usize, u32*)noexcept = nullptr;
+    usize (*cullBoxes)(const FrustumBatchTests::Planes&, const BoundsBatch::BoxStream&, usize, u32*)noexcept = nullptr;
+    usize (*cullOrientedBoxes)(const FrustumBatchTests::Planes&, const BoundsBatch::OrientedBoxStream&, usize, u32*)noexcept = nullptr;
+    void (*transformBoxes)(const Float4*, const BoundsBatch::BoxStream&, usize, const BoundsBatch::BoxOutputStream&)noexcept = nullptr;
+};
+
+// Empty (zero lanes) when the build has no AVX-512 kernels.
+extern const TierKernels g_Avx512TierKernels;
+
+// Kernels of the active SimdKernelTier, or null when the baseline loops should run alone.
+[[nodiscard]] const TierKernels* ActiveTierKernels()noexcept;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+inline void FrustumBatchTests::LoadPlanes(Planes& outPlanes, const SIMDVector* planes)noexcept{
+    for(u32 planeIndex = 0u; planeIndex < s_PlaneCount; ++planeIndex){
+        Float4 plane;
+        StoreFloat(planes[planeIndex], &plane);
+        outPlanes.normalX[planeIndex] = plane.x;
+        outPlanes.normalY[planeIndex] = plane.y;
+        outPlanes.normalZ[planeIndex] = plane.z;
+        outPlanes.distance[planeIndex] = plane.w;
+        outPlanes.absNormalX[planeIndex] = Abs(plane.x);
+        outPlanes.absNormalY[planeIndex] = Abs(plane.y);
+        outPlanes.absNormalZ[planeIndex] = Abs(plane.z);
+    }
+}
+
+inline void FrustumBatchTests::LoadPlanes(Planes& outPlanes, const Float4* planes)noexcept{
+    SIMDVector planeVectors[s_PlaneCount];
+    for(u32 planeIndex = 0u; planeIndex < s_PlaneCount; ++planeIndex)
+        planeVectors[planeIndex] = LoadFloat(planes[planeIndex]);
+    LoadPlanes(outPlanes, planeVectors);
+}
+
+inline void FrustumBatchTests::LoadPlanes(Planes& outPlanes, const BoundingFrustum& frustum)noexcept{
+    SIMDVector planeVectors[s_PlaneCount];
+    CollisionDetail::FrustumPlanes(
+        LoadFloat(frustum.origin),
+        LoadFloat(frustum.orientation),
+        frustum.rightSlope,
+        frustum.leftSlope,
+        frustum.topSlope,
+        frustum.bottomSlope,
+        frustum.nearPlane,
+        frustum.farPlane,
+        planeVectors
+    );
+    LoadPlanes(outPlanes, planeVectors);
+}
+
+[[nodiscard]] inline usize FrustumBatchTests::CullSpheres(
+    const Planes& planes,
+    const BoundsBatch::SphereStream& spheres,
+    const usize count,
+    u32* outVisibleIndices
+)noexcept{
+    using WideLanes = CollisionBatchDetail::WideLanes;
+    using Lanes1 = CollisionBatchDetail::Lanes1;
+
+    usize visibleCount = 0u;
+    usize index = 0u;
+    if(const CollisionBatchDetail::TierKernels* tierKernels = CollisionBatchDetail::ActiveTierKernels()){
+        index = count - count % tierKernels->laneCount;
+        visibleCount = tierKernels->cullSpheres(planes, spheres, index, outVisibleIndices);
+    }
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count){
+        const u32 visibleMask = CollisionBatchDetail::FrustumSphereMask<WideLanes>(planes, spheres, index);
+        visibleCount = CollisionBatchDetail::AppendSelectedLanes<WideLanes>(visibleMask, index, outVisibleIndices, visibleCount);
+    }
+    for(; index < count; ++index){
+        const u32 visibleMask = CollisionBatchDetail::FrustumSphereMask<Lanes1>(planes, spheres, index);
+        visibleCount = CollisionBatchDetail::AppendSelectedLanes<Lanes1>(visibleMask, index, outVisibleIndices, visibleCount);
+    }
+    return visibleCount;
+}
+
+[[nodiscard]] inline usize FrustumBatchTests::CullBoxes(
+    const Planes& planes,
+    const BoundsBatch::BoxStream& boxes,
+    const usize count,
+    u32* outVisibleIndices
+)noexcept{
+    using WideLanes = CollisionBatchDetail::WideLanes;
+    using Lanes1 = CollisionBatchDetail::Lanes1;
+
+    usize visibleCount = 0u;
+    usize index = 0u;
+    if(const CollisionBatchDetail::TierKernels* tierKernels = CollisionBatchDetail::ActiveTierKernels()){
+        index = count - count % tierKernels->laneCount;
+        visibleCount = tierKernels->cullBoxes(planes, boxes, index, outVisibleIndices);
+    }
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count){
+        const u32 visibleMask = CollisionBatchDetail::FrustumBoxMask<WideLanes>(planes, boxes, index);
+        visibleCount = CollisionBatchDetail::AppendSelectedLanes<WideLanes>(visibleMask, index, outVisibleIndices, visibleCount);
+    }
+    for(; index < count; ++index){
+        const u32 visibleMask = CollisionBatchDetail::FrustumBoxMask<Lanes1>(planes, boxes, index);
+        visibleCount = CollisionBatchDetail::AppendSelectedLanes<Lanes1>(visibleMask, index, outVisibleIndices, visibleCount);
+    }
+    return visibleCount;
+}
+
+[[nodiscard]] inline usize FrustumBatchTests::CullOrientedBoxes(
+    const Planes& planes,
+    const BoundsBatch::OrientedBoxStream& boxes,
+    const usize count,
+    u32* outVisibleIndices
+)noexcept{
+    using WideLanes = CollisionBatchDetail::WideLanes;
+    using Lanes1 = CollisionBatchDetail::Lanes1;
+
+    usize visibleCount = 0u;
+    usize index = 0u;
+    if(const CollisionBatchDetail::TierKernels* tierKernels = CollisionBatchDetail::ActiveTierKernels()){
+        index = count - count % tierKernels->laneCount;
+        visibleCount = tierKernels->cullOrientedBoxes(planes, boxes, index, outVisibleIndices);
+    }
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count){
+        const u32 visibleMask = CollisionBatchDetail::FrustumOrientedBoxMask<WideLanes>(planes, boxes, index);
+        visibleCount = CollisionBatchDetail::AppendSelectedLanes<WideLanes>(visibleMask, index, outVisibleIndices, visibleCount);
+    }
+    for(; index < count; ++index){
+        const u32 visibleMask = CollisionBatchDetail::FrustumOrientedBoxMask<Lanes1>(planes, boxes, index);
+        visibleCount = CollisionBatchDetail::AppendSelectedLanes<Lanes1>(visibleMask, index, outVisibleIndices, visibleCount);
+    }
+    return visibleCount;
+}
+
+
+inline void PlaneBatchTests::ClassifySpheres(
+    const Float4& plane,
+    const BoundsBatch::SphereStream& spheres,
+    const usize count,
+    PlaneIntersectionType::Enum* outResults
+)noexcept{
+    using WideLanes = CollisionBatchDetail::WideLanes;
+
+    usize index = 0u;
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count)
+        CollisionBatchDetail::ClassifySphereLanes<WideLanes>(plane, spheres, index, outResults);
+    for(; index < count; ++index)
+        CollisionBatchDetail::ClassifySphereLanes<CollisionBatchDetail::Lanes1>(plane, spheres, index, outResults);
+}
+
+inline void PlaneBatchTests::ClassifyBoxes(
+    const Float4& plane,
+    const BoundsBatch::BoxStream& boxes,
+    const usize count,
+    PlaneIntersectionType::Enum* outResults
+)noexcept{
+    using WideLanes = CollisionBatchDetail::WideLanes;
+
+    usize index = 0u;
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count)
+        CollisionBatchDetail::ClassifyBoxLanes<WideLanes>(plane, boxes, index, outResults);
+    for(; index < count; ++index)
+        CollisionBatchDetail::ClassifyBoxLanes<CollisionBatchDetail::Lanes1>(plane, boxes, index, outResults);
+}
+
+inline void PlaneBatchTests::ClassifyOrientedBoxes(
+    const Float4& plane,
+    const BoundsBatch::OrientedBoxStream& boxes,
+    const usize count,
+    PlaneIntersectionType::Enum* outResults
+)noexcept{
+    using WideLanes = CollisionBatchDetail::WideLanes;
+
+    usize index = 0u;
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count)
+        CollisionBatchDetail::ClassifyOrientedBoxLanes<WideLanes>(plane, boxes, index, outResults);
+    for(; index < count; ++index)
+        CollisionBatchDetail::ClassifyOrientedBoxLanes<CollisionBatchDetail::Lanes1>(plane, boxes, index, outResults);
+}
+
+
+[[nodiscard]] inline usize RayBatchTests::IntersectSpheres(
+    const Float3U& origin,
+    const Float3U& direction,
+    const BoundsBatch::SphereStream& spheres,
+    const usize count,
+    u32* outHitIndices,
+    f32* outDistances
+)noexcept{
+    using WideLanes = CollisionBatchDetail::WideLanes;
+    using Lanes1 = CollisionBatchDetail::Lanes1;
+
+    usize hitCount = 0u;
+    usize index = 0u;
+    f32 laneDistances[WideLanes::s_Count];
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count){
+        WideLanes::Register distance;
+        const u32 hitMask = CollisionBatchDetail::RaySphereMask<WideLanes>(origin, direction, spheres, index, distance);
+        WideLanes::Store(laneDistances, distance);
+        hitCount = CollisionBatchDetail::AppendSelectedLanes<WideLanes>(hitMask, index, laneDistances, outHitIndices, outDistances, hitCount);
+    }
+    for(; index < count; ++index){
+        Lanes1::Register distance;
+        const u32 hitMask = CollisionBatchDetail::RaySphereMask<Lanes1>(origin, direction, spheres, index, distance);
+        hitCount = CollisionBatchDetail::AppendSelectedLanes<Lanes1>(hitMask, index, &distance, outHitIndices, outDistances, hitCount);
+    }
+    return hitCount;
+}
+
+[[nodiscard]] inline usize RayBatchTests::IntersectBoxes(
+    const Float3U& origin,
+    const Float3U& direction,
+    const BoundsBatch::BoxStream& boxes,
+    const usize count,
+    u32* outHitIndices,
+    f32* outDistances
+)noexcept{
+    using WideLanes = CollisionBatchDetail::WideLanes;
+    using Lanes1 = CollisionBatchDetail::Lanes1;
+
+    const CollisionBatchDetail::Vector3Lanes<WideLanes> wideDirection{
+        WideLanes::Set(direction.x),
+        WideLanes::Set(direction.y),
+        WideLanes::Set(direction.z)
+    };
+    const CollisionBatchDetail::Vector3Lanes<Lanes1> scalarDirection{ direction.x, direction.y, direction.z };
+
+    usize hitCount = 0u;
+    usize index = 0u;
+    f32 laneDistances[WideLanes::s_Count];
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count){
+        WideLanes::Register distance;
+        const u32 hitMask = CollisionBatchDetail::RayBoxMask<WideLanes>(origin, wideDirection, boxes, index, distance);
+        WideLanes::Store(laneDistances, distance);
+        hitCount = CollisionBatchDetail::AppendSelectedLanes<WideLanes>(hitMask, index, laneDistances, outHitIndices, outDistances, hitCount);
+    }
+    for(; index < count; ++index){
+        Lanes1::Register distance;
+        const u32 hitMask = CollisionBatchDetail::RayBoxMask<Lanes1>(origin, scalarDirection, boxes, index, distance);
+        hitCount = CollisionBatchDetail::AppendSelectedLanes<Lanes1>(hitMask, index, &distance, outHitIndices, outDistances, hitCount);
+    }
+    return hitCount;
+}
+
+[[nodiscard]] inline usize RayBatchTests::IntersectOrientedBoxes(
+    const Float3U& origin,
+    const Float3U& direction,
+    const BoundsBatch::OrientedBoxStream& boxes,
+    const usize count,
+    u32* outHitIndices,
+    f32* outDistances
+)noexcept{
+    using WideLanes = CollisionBatchDetail::WideLanes;
+    using Lanes1 = CollisionBatchDetail::Lanes1;
+
+    usize hitCount = 0u;
+    usize index = 0u;
+    f32 laneDistances[WideLanes::s_Count];
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count){
+        WideLanes::Register distance;
+        const u32 hitMask = CollisionBatchDetail::RayOrientedBoxMask<WideLanes>(origin, direction, boxes, index, distance);
+        WideLanes::Store(laneDistances, distance);
+        hitCount = CollisionBatchDetail::AppendSelectedLanes<WideLanes>(hitMask, index, laneDistances, outHitIndices, outDistances, hitCount);
+    }
+    for(; index < count; ++index){
+        Lanes1::Register distance;
+        const u32 hitMask = CollisionBatchDetail::RayOrientedBoxMask<Lanes1>(origin, direction, boxes, index, distance);
+        hitCount = CollisionBatchDetail::AppendSelectedLanes<Lanes1>(hitMask, index, &distance, outHitIndices, outDistances, hitCount);
+    }
+    return hitCount;
+}
+
+
+[[nodiscard]] inline usize AabbBatchTests::OverlapSpheres(
+    const BoundingBox& query,
+    const BoundsBatch::SphereStream& spheres,
+    const usize count,
+    u32* outIndices
+)noexcept{
+    using WideLanes = CollisionBatchDetail::WideLanes;
+    using Lanes1 = CollisionBatchDetail::Lanes1;
+
+    SIMDVector minBounds{};
+    SIMDVector maxBounds{};
+    CollisionDetail::MinMaxFromCenterExtents(LoadFloat(query.center), LoadFloat(query.extents), minBounds, maxBounds);
+    Float4 queryMin;
+    Float4 queryMax;
+    StoreFloat(minBounds, &queryMin);
+    StoreFloat(maxBounds, &queryMax);
+
+    usize overlapCount = 0u;
+    usize index = 0u;
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count){
+        const u32 overlapMask = CollisionBatchDetail::AabbSphereMask<WideLanes>(queryMin, queryMax, spheres, index);
+        overlapCount = CollisionBatchDetail::AppendSelectedLanes<WideLanes>(overlapMask, index, outIndices, overlapCount);
+    }
+    for(; index < count; ++index){
+        const u32 overlapMask = CollisionBatchDetail::AabbSphereMask<Lanes1>(queryMin, queryMax, spheres, index);
+        overlapCount = CollisionBatchDetail::AppendSelectedLanes<Lanes1>(overlapMask, index, outIndices, overlapCount);
+    }
+    return overlapCount;
+}
+
+[[nodiscard]] inline usize AabbBatchTests::OverlapBoxes(
+    const BoundingBox& query,
+    const BoundsBatch::BoxStream& boxes,
+    const usize count,
+    u32* outIndices
+)noexcept{
+    using WideLanes = CollisionBatchDetail::WideLanes;
+    using Lanes1 = CollisionBatchDetail::Lanes1;
+
+    SIMDVector minBounds{};
+    SIMDVector maxBounds{};
+    CollisionDetail::MinMaxFromCenterExtents(LoadFloat(query.center), LoadFloat(query.extents), minBounds, maxBounds);
+    Float4 queryMin;
+    Float4 queryMax;
+    StoreFloat(minBounds, &queryMin);
+    StoreFloat(maxBounds, &queryMax);
+
+    usize overlapCount = 0u;
+    usize index = 0u;
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count){
+        const u32 overlapMask = CollisionBatchDetail::AabbBoxMask<WideLanes>(queryMin, queryMax, boxes, index);
+        overlapCount = CollisionBatchDetail::AppendSelectedLanes<WideLanes>(overlapMask, index, outIndices, overlapCount);
+    }
+    for(; index < count; ++index){
+        const u32 overlapMask = CollisionBatchDetail::AabbBoxMask<Lanes1>(queryMin, queryMax, boxes, index);
+        overlapCount = CollisionBatchDetail::AppendSelectedLanes<Lanes1>(overlapMask, index, outIndices, overlapCount);
+    }
+    return overlapCount;
+}
+
+[[nodiscard]] inline usize AabbBatchTests::OverlapOrientedBoxes(
+    const BoundingBox& query,
+    const BoundsBatch::OrientedBoxStream& boxes,
+    const usize count,
+    u32* outIndices
+)noexcept{
+    using WideLanes = CollisionBatchDetail::WideLanes;
+    using Lanes1 = CollisionBatchDetail::Lanes1;
+
+    usize overlapCount = 0u;
+    usize index = 0u;
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count){
+        const u32 overlapMask = CollisionBatchDetail::AabbOrientedBoxMask<WideLanes>(query.center, query.extents, boxes, index);
+        overlapCount = CollisionBatchDetail::AppendSelectedLanes<WideLanes>(overlapMask, index, outIndices, overlapCount);
+    }
+    for(; index < count; ++index){
+        const u32 overlapMask = CollisionBatchDetail::AabbOrientedBoxMask<Lanes1>(query.center, query.extents, boxes, index);
+        overlapCount = CollisionBatchDetail::AppendSelectedLanes<Lanes1>(overlapMask, index, outIndices, overlapCount);
+    }
+    return overlapCount;
+}
+
+inline void AabbBatchTests::TransformBoxes(
+    const SIMDMatrix& matrix,
+    const BoundsBatch::BoxStream& boxes,
+    const usize count,
+    const BoundsBatch::BoxOutputStream& outBoxes
+)noexcept{
+    using WideLanes = CollisionBatchDetail::WideLanes;
+
+    // Vector3Transform dots each matrix row with (x, y, z, 1), so row k produces output component k.
+    Float4 rows[3];
+    for(u32 row = 0u; row < 3u; ++row)
+        StoreFloat(matrix.v[row], &rows[row]);
+
+    usize index = 0u;
+    if(const CollisionBatchDetail::TierKernels* tierKernels = CollisionBatchDetail::ActiveTierKernels()){
+        index = count - count % tierKernels->laneCount;
+        tierKernels->transformBoxes(rows, boxes, index, outBoxes);
+    }
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count)
+        CollisionBatchDetail::TransformBoxLanes<WideLanes>(rows, boxes, index, outBoxes);
+    for(; index < count; ++index)
+        CollisionBatchDetail::TransformBoxLanes<CollisionBatchDetail::Lanes1>(rows, boxes, index, outBoxes);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
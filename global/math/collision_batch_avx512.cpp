@@ -0,0 +1,103 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Built with AVX-512 flags by nwb_apply_simd_avx512_sources. Everything here runs only after ActiveTierKernels() has
+// checked the CPU, so this file must not define anything the baseline code calls directly: only the Lanes16
+// instantiations and the table below.
+
+
+#include <global/math/collision_batch.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_HAS_AVX512)
+namespace __hidden_collision_batch_avx512{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+using Lanes16 = CollisionBatchDetail::Lanes16;
+
+
+usize CullSpheres(
+    const FrustumBatchTests::Planes& planes,
+    const BoundsBatch::SphereStream& spheres,
+    const usize blockCount,
+    u32* outVisibleIndices
+)noexcept{
+    usize visibleCount = 0u;
+    for(usize index = 0u; index < blockCount; index += Lanes16::s_Count){
+        const u32 visibleMask = CollisionBatchDetail::FrustumSphereMask<Lanes16>(planes, spheres, index);
+        visibleCount = CollisionBatchDetail::AppendSelectedLanes<Lanes16>(visibleMask, index, outVisibleIndices, visibleCount);
+    }
+    return visibleCount;
+}
+
+usize CullBoxes(
+    const FrustumBatchTests::Planes& planes,
+    const BoundsBatch::BoxStream& boxes,
+    const usize blockCount,
+    u32* outVisibleIndices
+)noexcept{
+    usize visibleCount = 0u;
+    for(usize index = 0u; index < blockCount; index += Lanes16::s_Count){
+        const u32 visibleMask = CollisionBatchDetail::FrustumBoxMask<Lanes16>(planes, boxes, index);
+        visibleCount = CollisionBatchDetail::AppendSelectedLanes<Lanes16>(visibleMask, index, outVisibleIndices, visibleCount);
+    }
+    return visibleCount;
+}
+
+usize CullOrientedBoxes(
+    const FrustumBatchTests::Planes& planes,
+    const BoundsBatch::OrientedBoxStream& boxes,
+    const usize blockCount,
+    u32* outVisibleIndices
+)noexcept{
+    usize visibleCount = 0u;
+    for(usize index = 0u; index < blockCount; index += Lanes16::s_Count){
+        const u32 visibleMask = CollisionBatchDetail::FrustumOrientedBoxMask<Lanes16>(planes, boxes, index);
+        visibleCount = CollisionBatchDetail::AppendSelectedLanes<Lanes16>(visibleMask, index, outVisibleIndices, visibleCount);
+    }
+    return visibleCount;
+}
+
+void TransformBoxes(
+    const Float4* rows,
+    const BoundsBatch::BoxStream& boxes,
+    const usize blockCount,
+    const BoundsBatch::BoxOutputStream& outBoxes
+)noexcept{
+    for(usize index = 0u; index < blockCount; index += Lanes16::s_Count)
+        CollisionBatchDetail::TransformBoxLanes<Lanes16>(rows, boxes, index, outBoxes);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_HAS_AVX512)
+const CollisionBatchDetail::TierKernels CollisionBatchDetail::g_Avx512TierKernels = {
+    .laneCount = CollisionBatchDetail::Lanes16::s_Count,
+    .cullSpheres = &__hidden_collision_batch_avx512::CullSpheres,
+    .cullBoxes = &__hidden_collision_batch_avx512::CullBoxes,
+    .cullOrientedBoxes = &__hidden_collision_batch_avx512::CullOrientedBoxes,
+    .transformBoxes = &__hidden_collision_batch_avx512::TransformBoxes,
+};
+#else
+const CollisionBatchDetail::TierKernels CollisionBatchDetail::g_Avx512TierKernels = {};
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -24,6 +24,11 @@
 #define NWB_HAS_AVX2 1
 #endif
 
+// Only translation units built through nwb_apply_simd_avx512_sources see this; see SimdKernelTier in cpu_topology.h.
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+#define NWB_HAS_AVX512 1
+#endif
+
 #if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64) || defined(_M_ARM64EC)
 #define NWB_HAS_NEON 1
 #endif
@@ -0,0 +1,85 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "quaternion.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Structure-of-arrays quaternion kernels for pose sampling and blending. Every kernel processes one lane per
+// quaternion, takes the shortest arc by flipping the second operand when the 4D dot product is negative, and maps
+// degenerate (near zero length) results to identity so a cancelled blend never produces NaNs. Output streams may
+// alias input streams element for element.
+namespace QuaternionBatch{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_HAS_AVX2)
+inline constexpr usize s_LaneCount = 8u;
+#elif defined(NWB_HAS_SSE4)
+inline constexpr usize s_LaneCount = 4u;
+#else
+inline constexpr usize s_LaneCount = 1u;
+#endif
+inline constexpr f32 s_DegenerateLengthSquared = 1.0e-12f;
+
+
+struct Stream{
+    f32* x = nullptr;
+    f32* y = nullptr;
+    f32* z = nullptr;
+    f32* w = nullptr;
+};
+
+struct ConstStream{
+    const f32* x = nullptr;
+    const f32* y = nullptr;
+    const f32* z = nullptr;
+    const f32* w = nullptr;
+
+    ConstStream() = default;
+    ConstStream(const f32* inX, const f32* inY, const f32* inZ, const f32* inW)noexcept
+        : x(inX)
+        , y(inY)
+        , z(inZ)
+        , w(inW)
+    {}
+    ConstStream(const Stream& stream)noexcept
+        : x(stream.x)
+        , y(stream.y)
+        , z(stream.z)
+        , w(stream.w)
+    {}
+};
+
+
+// out[i] = normalize(from[i] + factor[i] * (to[i] - from[i])) along the shortest arc.
+void Nlerp(const ConstStream& from, const ConstStream& to, const f32* factor, usize count, const Stream& out)noexcept;
+// accumulator[i] += weight * q[i], with q[i] flipped into the accumulator's hemisphere first.
+void AccumulateWeighted(const ConstStream& q, f32 weight, usize count, const Stream& accumulator)noexcept;
+void Normalize(const Stream& q, usize count)noexcept;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#define NWB_MATH_QUATERNION_BATCH_INCLUDE_INLINE
+#include "quaternion_batch.inl"
+#undef NWB_MATH_QUATERNION_BATCH_INCLUDE_INLINE
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,257 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if !defined(NWB_MATH_QUATERNION_BATCH_INCLUDE_INLINE)
+#error "Do not include quaternion_batch.inl directly. Include quaternion_batch.h from global/math or simdmath.h elsewhere."
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace QuaternionBatchDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+struct Lanes1{
+    using Register = f32;
+    static constexpr usize s_Count = 1u;
+
+    [[nodiscard]] static NWB_INLINE Register Load(const f32* source)noexcept{ return *source; }
+    static NWB_INLINE void Store(f32* destination, const Register value)noexcept{ *destination = value; }
+    [[nodiscard]] static NWB_INLINE Register Set(const f32 value)noexcept{ return value; }
+    [[nodiscard]] static NWB_INLINE Register Add(const Register lhs, const Register rhs)noexcept{ return lhs + rhs; }
+    [[nodiscard]] static NWB_INLINE Register Sub(const Register lhs, const Register rhs)noexcept{ return lhs - rhs; }
+    [[nodiscard]] static NWB_INLINE Register Mul(const Register lhs, const Register rhs)noexcept{ return lhs * rhs; }
+    [[nodiscard]] static NWB_INLINE Register FlipWhenNegative(const Register value, const Register sign)noexcept{
+        return sign < 0.0f ? -value : value;
+    }
+    static NWB_INLINE void Normalize(Register& x, Register& y, Register& z, Register& w)noexcept{
+        const f32 lengthSquared = ((x * x + y * y) + z * z) + w * w;
+        if(!(lengthSquared > QuaternionBatch::s_DegenerateLengthSquared)){
+            x = 0.0f;
+            y = 0.0f;
+            z = 0.0f;
+            w = 1.0f;
+            return;
+        }
+
+        const f32 inverseLength = 1.0f / Sqrt(lengthSquared);
+        x *= inverseLength;
+        y *= inverseLength;
+        z *= inverseLength;
+        w *= inverseLength;
+    }
+};
+
+#if defined(NWB_HAS_AVX2)
+struct Lanes8{
+    using Register = __m256;
+    static constexpr usize s_Count = 8u;
+
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Load(const f32* source)noexcept{ return _mm256_loadu_ps(source); }
+    static NWB_INLINE void SIMDCALL Store(f32* destination, const Register value)noexcept{ _mm256_storeu_ps(destination, value); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Set(const f32 value)noexcept{ return _mm256_set1_ps(value); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Add(const Register lhs, const Register rhs)noexcept{ return _mm256_add_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Sub(const Register lhs, const Register rhs)noexcept{ return _mm256_sub_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Mul(const Register lhs, const Register rhs)noexcept{ return _mm256_mul_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL FlipWhenNegative(const Register value, const Register sign)noexcept{
+        return _mm256_xor_ps(value, _mm256_and_ps(_mm256_cmp_ps(sign, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(-0.0f)));
+    }
+    static NWB_INLINE void SIMDCALL Normalize(Register& x, Register& y, Register& z, Register& w)noexcept{
+        const __m256 lengthSquared = _mm256_add_ps(
+            _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)),
+            _mm256_mul_ps(w, w)
+        );
+        const __m256 valid = _mm256_cmp_ps(lengthSquared, _mm256_set1_ps(QuaternionBatch::s_DegenerateLengthSquared), _CMP_GT_OQ);
+        const __m256 inverseLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSquared));
+        x = _mm256_and_ps(_mm256_mul_ps(x, inverseLength), valid);
+        y = _mm256_and_ps(_mm256_mul_ps(y, inverseLength), valid);
+        z = _mm256_and_ps(_mm256_mul_ps(z, inverseLength), valid);
+        w = _mm256_blendv_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(w, inverseLength), valid);
+    }
+};
+#elif defined(NWB_HAS_SSE4)
+struct Lanes4{
+    using Register = __m128;
+    static constexpr usize s_Count = 4u;
+
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Load(const f32* source)noexcept{ return _mm_loadu_ps(source); }
+    static NWB_INLINE void SIMDCALL Store(f32* destination, const Register value)noexcept{ _mm_storeu_ps(destination, value); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Set(const f32 value)noexcept{ return _mm_set1_ps(value); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Add(const Register lhs, const Register rhs)noexcept{ return _mm_add_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Sub(const Register lhs, const Register rhs)noexcept{ return _mm_sub_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL Mul(const Register lhs, const Register rhs)noexcept{ return _mm_mul_ps(lhs, rhs); }
+    [[nodiscard]] static NWB_INLINE Register SIMDCALL FlipWhenNegative(const Register value, const Register sign)noexcept{
+        return _mm_xor_ps(value, _mm_and_ps(_mm_cmplt_ps(sign, _mm_setzero_ps()), _mm_set1_ps(-0.0f)));
+    }
+    static NWB_INLINE void SIMDCALL Normalize(Register& x, Register& y, Register& z, Register& w)noexcept{
+        const __m128 lengthSquared = _mm_add_ps(
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)),
+            _mm_mul_ps(w, w)
+        );
+        const __m128 valid = _mm_cmpgt_ps(lengthSquared, _mm_set1_ps(QuaternionBatch::s_DegenerateLengthSquared));
+        const __m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSquared));
+        x = _mm_and_ps(_mm_mul_ps(x, inverseLength), valid);
+        y = _mm_and_ps(_mm_mul_ps(y, inverseLength), valid);
+        z = _mm_and_ps(_mm_mul_ps(z, inverseLength), valid);
+        w = _mm_blendv_ps(_mm_set1_ps(1.0f), _mm_mul_ps(w, inverseLength), valid);
+    }
+};
+#endif
+
+#if defined(NWB_HAS_AVX2)
+using WideLanes = Lanes8;
+#elif defined(NWB_HAS_SSE4)
+using WideLanes = Lanes4;
+#else
+using WideLanes = Lanes1;
+#endif
+
+
+template<typename Lanes>
+[[nodiscard]] NWB_INLINE typename Lanes::Register Dot(
+    const typename Lanes::Register ax,
+    const typename Lanes::Register ay,
+    const typename Lanes::Register az,
+    const typename Lanes::Register aw,
+    const typename Lanes::Register bx,
+    const typename Lanes::Register by,
+    const typename Lanes::Register bz,
+    const typename Lanes::Register bw
+)noexcept{
+    return Lanes::Add(
+        Lanes::Add(Lanes::Add(Lanes::Mul(ax, bx), Lanes::Mul(ay, by)), Lanes::Mul(az, bz)),
+        Lanes::Mul(aw, bw)
+    );
+}
+
+template<typename Lanes>
+NWB_INLINE void NlerpLanes(
+    const QuaternionBatch::ConstStream& from,
+    const QuaternionBatch::ConstStream& to,
+    const f32* factor,
+    const usize base,
+    const QuaternionBatch::Stream& out
+)noexcept{
+    const auto ax = Lanes::Load(from.x + base);
+    const auto ay = Lanes::Load(from.y + base);
+    const auto az = Lanes::Load(from.z + base);
+    const auto aw = Lanes::Load(from.w + base);
+    auto bx = Lanes::Load(to.x + base);
+    auto by = Lanes::Load(to.y + base);
+    auto bz = Lanes::Load(to.z + base);
+    auto bw = Lanes::Load(to.w + base);
+
+    const auto dot = Dot<Lanes>(ax, ay, az, aw, bx, by, bz, bw);
+    bx = Lanes::FlipWhenNegative(bx, dot);
+    by = Lanes::FlipWhenNegative(by, dot);
+    bz = Lanes::FlipWhenNegative(bz, dot);
+    bw = Lanes::FlipWhenNegative(bw, dot);
+
+    const auto t = Lanes::Load(factor + base);
+    auto x = Lanes::Add(ax, Lanes::Mul(t, Lanes::Sub(bx, ax)));
+    auto y = Lanes::Add(ay, Lanes::Mul(t, Lanes::Sub(by, ay)));
+    auto z = Lanes::Add(az, Lanes::Mul(t, Lanes::Sub(bz, az)));
+    auto w = Lanes::Add(aw, Lanes::Mul(t, Lanes::Sub(bw, aw)));
+    Lanes::Normalize(x, y, z, w);
+    Lanes::Store(out.x + base, x);
+    Lanes::Store(out.y + base, y);
+    Lanes::Store(out.z + base, z);
+    Lanes::Store(out.w + base, w);
+}
+
+template<typename Lanes>
+NWB_INLINE void AccumulateWeightedLanes(
+    const QuaternionBatch::ConstStream& q,
+    const typename Lanes::Register weight,
+    const usize base,
+    const QuaternionBatch::Stream& accumulator
+)noexcept{
+    const auto ax = Lanes::Load(accumulator.x + base);
+    const auto ay = Lanes::Load(accumulator.y + base);
+    const auto az = Lanes::Load(accumulator.z + base);
+    const auto aw = Lanes::Load(accumulator.w + base);
+    const auto qx = Lanes::Load(q.x + base);
+    const auto qy = Lanes::Load(q.y + base);
+    const auto qz = Lanes::Load(q.z + base);
+    const auto qw = Lanes::Load(q.w + base);
+
+    const auto signedWeight = Lanes::FlipWhenNegative(weight, Dot<Lanes>(ax, ay, az, aw, qx, qy, qz, qw));
+    Lanes::Store(accumulator.x + base, Lanes::Add(ax, Lanes::Mul(signedWeight, qx)));
+    Lanes::Store(accumulator.y + base, Lanes::Add(ay, Lanes::Mul(signedWeight, qy)));
+    Lanes::Store(accumulator.z + base, Lanes::Add(az, Lanes::Mul(signedWeight, qz)));
+    Lanes::Store(accumulator.w + base, Lanes::Add(aw, Lanes::Mul(signedWeight, qw)));
+}
+
+template<typename Lanes>
+NWB_INLINE void NormalizeLanes(const QuaternionBatch::Stream& q, const usize base)noexcept{
+    auto x = Lanes::Load(q.x + base);
+    auto y = Lanes::Load(q.y + base);
+    auto z = Lanes::Load(q.z + base);
+    auto w = Lanes::Load(q.w + base);
+    Lanes::Normalize(x, y, z, w);
+    Lanes::Store(q.x + base, x);
+    Lanes::Store(q.y + base, y);
+    Lanes::Store(q.z + base, z);
+    Lanes::Store(q.w + base, w);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+inline void QuaternionBatch::Nlerp(
+    const ConstStream& from,
+    const ConstStream& to,
+    const f32* factor,
+    const usize count,
+    const Stream& out
+)noexcept{
+    using WideLanes = QuaternionBatchDetail::WideLanes;
+
+    usize index = 0u;
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count)
+        QuaternionBatchDetail::NlerpLanes<WideLanes>(from, to, factor, index, out);
+    for(; index < count; ++index)
+        QuaternionBatchDetail::NlerpLanes<QuaternionBatchDetail::Lanes1>(from, to, factor, index, out);
+}
+
+inline void QuaternionBatch::AccumulateWeighted(
+    const ConstStream& q,
+    const f32 weight,
+    const usize count,
+    const Stream& accumulator
+)noexcept{
+    using WideLanes = QuaternionBatchDetail::WideLanes;
+
+    usize index = 0u;
+    const auto wideWeight = WideLanes::Set(weight);
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count)
+        QuaternionBatchDetail::AccumulateWeightedLanes<WideLanes>(q, wideWeight, index, accumulator);
+    for(; index < count; ++index)
+        QuaternionBatchDetail::AccumulateWeightedLanes<QuaternionBatchDetail::Lanes1>(q, weight, index, accumulator);
+}
+
+inline void QuaternionBatch::Normalize(const Stream& q, const usize count)noexcept{
+    using WideLanes = QuaternionBatchDetail::WideLanes;
+
+    usize index = 0u;
+    for(; index + WideLanes::s_Count <= count; index += WideLanes::s_Count)
+        QuaternionBatchDetail::NormalizeLanes<WideLanes>(q, index);
+    for(; index < count; ++index)
+        QuaternionBatchDetail::NormalizeLanes<QuaternionBatchDetail::Lanes1>(q, index);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -12,6 +12,8 @@
 #include "math/quaternion.h"
 #include "math/matrix.h"
 #include "math/collision.h"
+#include "math/collision_batch.h"
+#include "math/quaternion_batch.h"
 #include "math/frame.h"
 
 
@@ -17,9 +17,19 @@
 #define NWB_SCENE_LIGHT_LIST_DEFAULT_SET 0
 #define NWB_SCENE_LIGHT_LIST_DEFAULT_BINDING 6
 
-#define NWB_SCENE_SHADING_BUFFER_FLOAT_COUNT 4u
+#define NWB_SCENE_SHADING_BUFFER_FLOAT_COUNT 28u
 #define NWB_SCENE_LIGHT_RECORD_FLOAT_COUNT 20u
+// The light list is ranked most important first. Per-light passes (shadow, caustic and GI producers, and every shading
+// point without cluster lists) walk only its first NWB_SCENE_MAX_LIGHTS entries; clustered deferred lighting reaches
+// up to NWB_SCENE_LIGHT_LIST_CAPACITY lights.
 #define NWB_SCENE_MAX_LIGHTS 64u
+#define NWB_SCENE_LIGHT_LIST_CAPACITY 4096u
+
+// Per-cluster light lists share one uint StructuredBuffer: an (offset, count) pair per cluster, the directional light
+// indices, then the cluster lists. The grid coarsens its tiles until the pairs fit NWB_SCENE_LIGHT_CLUSTER_MAX_COUNT;
+// lists past the word capacity are truncated, dropping their least important lights.
+#define NWB_SCENE_LIGHT_CLUSTER_MAX_COUNT 65536u
+#define NWB_SCENE_LIGHT_CLUSTER_WORD_CAPACITY 1048576u
 
 // NwbSceneLight.params.y packs the LightType enum into a float. These midpoint thresholds are shared by CPU scene
 // preparation and every shader that decodes directional, point, and spot light behavior.
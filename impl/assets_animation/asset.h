@@ -0,0 +1,160 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "../global.h"
+
+#include <impl/assets_skeleton/asset.h>
+
+#include <core/assets/module.h>
+#include <core/assets/ref.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Key frames are stored as u16, so a clip spans at most 65536 frames.
+inline constexpr u32 s_AnimationClipMaxFrameCount = static_cast<u32>(Limit<u16>::s_Max) + 1u;
+inline constexpr u32 s_AnimationClipInvalidTrackIndex = Limit<u32>::s_Max;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// A channel with zero keys is not animated and samples the skeleton bind pose. A channel with one key is constant.
+struct AnimationKeyRange{
+    u32 firstKey = 0u;
+    u32 keyCount = 0u;
+};
+
+// Vector keys decode as minimum + extent * (value / 65535) per axis.
+struct AnimationVectorRange{
+    Float3U minimum = Float3U(0.0f, 0.0f, 0.0f);
+    Float3U extent = Float3U(0.0f, 0.0f, 0.0f);
+};
+
+// Smallest-three rotation: three 15-bit components with the dropped component index in the top bits of the first two.
+struct AnimationRotationKey{
+    u16 frame = 0u;
+    u16 packed[3] = {};
+};
+static_assert(sizeof(AnimationRotationKey) == sizeof(u16) * 4u);
+
+struct AnimationVectorKey{
+    u16 frame = 0u;
+    u16 value[3] = {};
+};
+static_assert(sizeof(AnimationVectorKey) == sizeof(u16) * 4u);
+
+struct AnimationClipTrack{
+    Name joint = NAME_NONE;
+    AnimationKeyRange rotation;
+    AnimationKeyRange translation;
+    AnimationKeyRange scale;
+    AnimationVectorRange translationRange;
+    AnimationVectorRange scaleRange;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class AnimationClip final : public Core::Assets::TypedAsset<AnimationClip>{
+public:
+    NWB_DEFINE_ASSET_TYPE("animation_clip")
+
+
+public:
+    using TrackVector = Core::Assets::AssetVector<AnimationClipTrack>;
+    using RotationKeyVector = Core::Assets::AssetVector<AnimationRotationKey>;
+    using VectorKeyVector = Core::Assets::AssetVector<AnimationVectorKey>;
+
+
+public:
+    explicit AnimationClip(Core::Assets::AssetArena& arena)
+        : m_tracks(arena)
+        , m_rotationKeys(arena)
+        , m_translationKeys(arena)
+        , m_scaleKeys(arena)
+    {}
+    AnimationClip(Core::Assets::AssetArena& arena, const Name& virtualPath)
+        : Core::Assets::TypedAsset<AnimationClip>(virtualPath)
+        , m_tracks(arena)
+        , m_rotationKeys(arena)
+        , m_translationKeys(arena)
+        , m_scaleKeys(arena)
+    {}
+
+
+public:
+    bool loadBinary(const Core::Assets::AssetBytes& binary);
+    [[nodiscard]] bool validatePayload()const;
+
+public:
+    void setSkeleton(const Core::Assets::AssetRef<Skeleton>& skeleton){ m_skeleton = skeleton; }
+    void setTiming(const f32 frameRate, const u32 frameCount){ m_frameRate = frameRate; m_frameCount = frameCount; }
+    void setTracks(
+        TrackVector&& tracks,
+        RotationKeyVector&& rotationKeys,
+        VectorKeyVector&& translationKeys,
+        VectorKeyVector&& scaleKeys
+    );
+
+public:
+    [[nodiscard]] const Core::Assets::AssetRef<Skeleton>& skeleton()const{ return m_skeleton; }
+    [[nodiscard]] f32 frameRate()const{ return m_frameRate; }
+    [[nodiscard]] u32 frameCount()const{ return m_frameCount; }
+    // Seconds between the first and the last frame. A single-frame clip has zero duration.
+    [[nodiscard]] f32 duration()const{
+        return m_frameCount > 1u && m_frameRate > 0.0f ? static_cast<f32>(m_frameCount - 1u) / m_frameRate : 0.0f;
+    }
+    [[nodiscard]] const TrackVector& tracks()const{ return m_tracks; }
+    [[nodiscard]] const RotationKeyVector& rotationKeys()const{ return m_rotationKeys; }
+    [[nodiscard]] const VectorKeyVector& translationKeys()const{ return m_translationKeys; }
+    [[nodiscard]] const VectorKeyVector& scaleKeys()const{ return m_scaleKeys; }
+    [[nodiscard]] u32 findTrackIndex(Name jointName)const;
+
+
+private:
+    Core::Assets::AssetRef<Skeleton> m_skeleton;
+    f32 m_frameRate = 0.0f;
+    u32 m_frameCount = 0u;
+    TrackVector m_tracks;
+    RotationKeyVector m_rotationKeys;
+    VectorKeyVector m_translationKeys;
+    VectorKeyVector m_scaleKeys;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class AnimationClipAssetCodec final : public Core::Assets::AssetCodec<AnimationClip>{
+public:
+    AnimationClipAssetCodec() = default;
+
+
+#if defined(NWB_COOK)
+public:
+    virtual bool serialize(const Core::Assets::IAsset& asset, Core::Assets::AssetBytes& outBinary)const override;
+#endif
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
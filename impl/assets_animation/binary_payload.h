@@ -0,0 +1,70 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "asset.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace AnimationClipBinaryPayload{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+inline constexpr u32 s_AnimationClipMagic = 0x414E4331u; // ANC1
+
+struct HeaderBinary{
+    u32 magic = s_AnimationClipMagic;
+    u32 frameCount = 0u;
+    f32 frameRate = 0.0f;
+    u32 padding0 = 0u;
+    NameHash skeletonNameHash = {};
+    u64 trackCount = 0u;
+    u64 rotationKeyCount = 0u;
+    u64 translationKeyCount = 0u;
+    u64 scaleKeyCount = 0u;
+};
+static_assert(IsStandardLayout_V<HeaderBinary>, "Animation clip header must stay binary-serializable");
+static_assert(IsTriviallyCopyable_V<HeaderBinary>, "Animation clip header must stay binary-serializable");
+
+struct TrackBinary{
+    NameHash jointNameHash = {};
+    AnimationKeyRange rotation;
+    AnimationKeyRange translation;
+    AnimationKeyRange scale;
+    AnimationVectorRange translationRange;
+    AnimationVectorRange scaleRange;
+    u32 padding0[2u] = {};
+};
+static_assert(IsStandardLayout_V<TrackBinary>, "Animation clip track must stay binary-serializable");
+static_assert(IsTriviallyCopyable_V<TrackBinary>, "Animation clip track must stay binary-serializable");
+static_assert(IsTriviallyCopyable_V<AnimationRotationKey>, "Animation rotation key must stay binary-serializable");
+static_assert(IsTriviallyCopyable_V<AnimationVectorKey>, "Animation vector key must stay binary-serializable");
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,162 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "asset.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Key quantization shared by the cooker, which encodes and measures error, and the runtime sampler, which decodes.
+namespace AnimationClipCompression{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+inline constexpr u32 s_RotationComponentBits = 15u;
+inline constexpr u16 s_RotationComponentMask = static_cast<u16>((1u << s_RotationComponentBits) - 1u);
+inline constexpr f32 s_RotationComponentScale = static_cast<f32>(s_RotationComponentMask);
+// The three smallest components of a unit quaternion lie in [-1/sqrt(2), 1/sqrt(2)].
+inline constexpr f32 s_RotationComponentBound = 0.70710678118654752f;
+inline constexpr f32 s_VectorComponentScale = static_cast<f32>(Limit<u16>::s_Max);
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+[[nodiscard]] NWB_INLINE u16 QuantizeRotationComponent(const f32 value){
+    const f32 unit = Saturate((value + s_RotationComponentBound) / (2.0f * s_RotationComponentBound));
+    return static_cast<u16>(unit * s_RotationComponentScale + 0.5f);
+}
+
+[[nodiscard]] NWB_INLINE f32 DequantizeRotationComponent(const u16 value){
+    const f32 unit = static_cast<f32>(value & s_RotationComponentMask) * (1.0f / s_RotationComponentScale);
+    return unit * (2.0f * s_RotationComponentBound) - s_RotationComponentBound;
+}
+
+// `rotation` must be normalized. q and -q encode identically up to the sign of the dropped component.
+NWB_INLINE void PackRotation(const Float4& rotation, u16 (&outPacked)[3]){
+    const f32 components[4] = { rotation.x, rotation.y, rotation.z, rotation.w };
+    u32 largestIndex = 0u;
+    for(u32 i = 1u; i < 4u; ++i){
+        if(Abs(components[i]) > Abs(components[largestIndex]))
+            largestIndex = i;
+    }
+
+    const f32 sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+    u32 packedIndex = 0u;
+    for(u32 i = 0u; i < 4u; ++i){
+        if(i == largestIndex)
+            continue;
+        outPacked[packedIndex++] = QuantizeRotationComponent(components[i] * sign);
+    }
+    outPacked[0] = static_cast<u16>(outPacked[0] | ((largestIndex & 1u) << s_RotationComponentBits));
+    outPacked[1] = static_cast<u16>(outPacked[1] | (((largestIndex >> 1u) & 1u) << s_RotationComponentBits));
+}
+
+[[nodiscard]] NWB_INLINE Float4 UnpackRotation(const u16 (&packed)[3]){
+    const u32 largestIndex = static_cast<u32>(packed[0] >> s_RotationComponentBits)
+        | (static_cast<u32>(packed[1] >> s_RotationComponentBits) << 1u)
+    ;
+    const f32 a = DequantizeRotationComponent(packed[0]);
+    const f32 b = DequantizeRotationComponent(packed[1]);
+    const f32 c = DequantizeRotationComponent(packed[2]);
+    const f32 largest = Sqrt(Max(0.0f, 1.0f - ((a * a + b * b) + c * c)));
+
+    switch(largestIndex){
+    case 0u:
+        return Float4(largest, a, b, c);
+    case 1u:
+        return Float4(a, largest, b, c);
+    case 2u:
+        return Float4(a, b, largest, c);
+    default:
+        return Float4(a, b, c, largest);
+    }
+}
+
+[[nodiscard]] NWB_INLINE u16 QuantizeVectorComponent(const f32 value, const f32 minimum, const f32 extent){
+    if(!(extent > 0.0f))
+        return 0u;
+
+    const f32 unit = Saturate((value - minimum) / extent);
+    return static_cast<u16>(unit * s_VectorComponentScale + 0.5f);
+}
+
+[[nodiscard]] NWB_INLINE f32 DequantizeVectorComponent(const u16 value, const f32 minimum, const f32 extent){
+    return minimum + extent * (static_cast<f32>(value) * (1.0f / s_VectorComponentScale));
+}
+
+[[nodiscard]] NWB_INLINE Float3U DequantizeVector(const AnimationVectorKey& key, const AnimationVectorRange& range){
+    return Float3U(
+        DequantizeVectorComponent(key.value[0], range.minimum.x, range.extent.x),
+        DequantizeVectorComponent(key.value[1], range.minimum.y, range.extent.y),
+        DequantizeVectorComponent(key.value[2], range.minimum.z, range.extent.z)
+    );
+}
+
+// Finds the keys around `frame` in a channel whose key frames strictly increase. Frames before the first or after the
+// last key clamp to that key with a zero factor.
+template<typename KeyT>
+NWB_INLINE void FindKeyPair(
+    const KeyT* keys,
+    const u32 keyCount,
+    const f32 frame,
+    u32& outLower,
+    u32& outUpper,
+    f32& outFactor
+){
+    outLower = 0u;
+    outUpper = 0u;
+    outFactor = 0.0f;
+    if(keyCount <= 1u || !(frame > static_cast<f32>(keys[0].frame)))
+        return;
+    if(frame >= static_cast<f32>(keys[keyCount - 1u].frame)){
+        outLower = keyCount - 1u;
+        outUpper = keyCount - 1u;
+        return;
+    }
+
+    u32 low = 0u;
+    u32 high = keyCount - 1u;
+    while(high - low > 1u){
+        const u32 middle = low + ((high - low) >> 1u);
+        if(static_cast<f32>(keys[middle].frame) <= frame)
+            low = middle;
+        else
+            high = middle;
+    }
+
+    const f32 lowerFrame = static_cast<f32>(keys[low].frame);
+    const f32 upperFrame = static_cast<f32>(keys[high].frame);
+    outLower = low;
+    outUpper = high;
+    outFactor = (frame - lowerFrame) / (upperFrame - lowerFrame);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,702 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_COOK)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "cook.h"
+#include "binary_payload.h"
+#include "compression.h"
+
+#include <core/assets/binary_payload_io.h>
+#include <core/assets/paths.h>
+#include <core/common/log.h>
+#include <core/metascript/parser.h>
+#include <global/binary.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+bool AnimationClipAssetCodec::serialize(const Core::Assets::IAsset& asset, Core::Assets::AssetBytes& outBinary)const{
+    if(asset.assetType() != assetType()){
+        NWB_LOGGER_ERROR(NWB_TEXT("AnimationClipAssetCodec::serialize failed: invalid asset type '{}', expected '{}'")
+            , StringConvert(asset.assetType().c_str())
+            , StringConvert(AnimationClip::s_AssetTypeText)
+        );
+        return false;
+    }
+
+    const AnimationClip& clip = static_cast<const AnimationClip&>(asset);
+    if(!clip.validatePayload())
+        return false;
+
+    Core::Assets::AssetVector<AnimationClipBinaryPayload::TrackBinary> trackBinaries(outBinary.get_allocator().arena());
+    trackBinaries.reserve(clip.tracks().size());
+    for(const AnimationClipTrack& track : clip.tracks()){
+        AnimationClipBinaryPayload::TrackBinary trackBinary = {};
+        trackBinary.jointNameHash = track.joint.hash();
+        trackBinary.rotation = track.rotation;
+        trackBinary.translation = track.translation;
+        trackBinary.scale = track.scale;
+        trackBinary.translationRange = track.translationRange;
+        trackBinary.scaleRange = track.scaleRange;
+        trackBinaries.push_back(trackBinary);
+    }
+
+    outBinary.clear();
+    outBinary.reserve(
+        sizeof(AnimationClipBinaryPayload::HeaderBinary)
+        + trackBinaries.size() * sizeof(AnimationClipBinaryPayload::TrackBinary)
+        + clip.rotationKeys().size() * sizeof(AnimationRotationKey)
+        + (clip.translationKeys().size() + clip.scaleKeys().size()) * sizeof(AnimationVectorKey)
+    );
+
+    AnimationClipBinaryPayload::HeaderBinary header;
+    header.frameCount = clip.frameCount();
+    header.frameRate = clip.frameRate();
+    header.skeletonNameHash = clip.skeleton().name().hash();
+    header.trackCount = static_cast<u64>(trackBinaries.size());
+    header.rotationKeyCount = static_cast<u64>(clip.rotationKeys().size());
+    header.translationKeyCount = static_cast<u64>(clip.translationKeys().size());
+    header.scaleKeyCount = static_cast<u64>(clip.scaleKeys().size());
+    AppendPOD(outBinary, header);
+    return Core::Assets::AppendVectorPayload(outBinary, trackBinaries, NWB_TEXT("AnimationClipAssetCodec::serialize"), NWB_TEXT("tracks"))
+        && Core::Assets::AppendVectorPayload(outBinary, clip.rotationKeys(), NWB_TEXT("AnimationClipAssetCodec::serialize"), NWB_TEXT("rotation keys"))
+        && Core::Assets::AppendVectorPayload(outBinary, clip.translationKeys(), NWB_TEXT("AnimationClipAssetCodec::serialize"), NWB_TEXT("translation keys"))
+        && Core::Assets::AppendVectorPayload(outBinary, clip.scaleKeys(), NWB_TEXT("AnimationClipAssetCodec::serialize"), NWB_TEXT("scale keys"))
+    ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_animation_clip_cook{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+using namespace Core::Metascript;
+
+static constexpr AStringView s_SkeletonField = "skeleton";
+static constexpr AStringView s_FrameRateField = "frame_rate";
+static constexpr AStringView s_RotationToleranceField = "rotation_tolerance";
+static constexpr AStringView s_TranslationToleranceField = "translation_tolerance";
+static constexpr AStringView s_ScaleToleranceField = "scale_tolerance";
+static constexpr AStringView s_TracksField = "tracks";
+static constexpr AStringView s_JointField = "joint";
+static constexpr AStringView s_RotationsField = "rotations";
+static constexpr AStringView s_TranslationsField = "translations";
+static constexpr AStringView s_ScalesField = "scales";
+static constexpr AStringView s_AnimationClipMetaKind = "Animation clip meta";
+static constexpr AStringView s_AnimationTrackMetaKind = "Animation clip track meta";
+
+static constexpr f32 s_MinimumRotationLengthSquared = 1.0e-12f;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+[[nodiscard]] bool ReadFiniteNumber(
+    const Path& nwbFilePath,
+    const Value& value,
+    const AStringView label,
+    f32& outValue
+){
+    outValue = 0.0f;
+    if(!value.isNumeric()){
+        NWB_LOGGER_ERROR(NWB_TEXT("{} '{}': '{}' must be numeric")
+            , StringConvert(s_AnimationClipMetaKind)
+            , PathToString<tchar>(nwbFilePath)
+            , StringConvert(label)
+        );
+        return false;
+    }
+
+    const f64 numericValue = value.toDouble();
+    if(!IsFinite(numericValue) || numericValue < static_cast<f64>(Limit<f32>::s_Min) || numericValue > static_cast<f64>(Limit<f32>::s_Max)){
+        NWB_LOGGER_ERROR(NWB_TEXT("{} '{}': '{}' must be a finite f32 value")
+            , StringConvert(s_AnimationClipMetaKind)
+            , PathToString<tchar>(nwbFilePath)
+            , StringConvert(label)
+        );
+        return false;
+    }
+
+    outValue = static_cast<f32>(numericValue);
+    return true;
+}
+
+[[nodiscard]] bool ReadNonNegativeField(
+    const Path& nwbFilePath,
+    const Value& asset,
+    const AStringView fieldName,
+    const bool required,
+    const bool allowZero,
+    f32& inOutValue
+){
+    const Value* field = FindField(asset, fieldName);
+    if(!field){
+        if(!required)
+            return true;
+
+        NWB_LOGGER_ERROR(NWB_TEXT("{} '{}': field '{}' is required")
+            , StringConvert(s_AnimationClipMetaKind)
+            , PathToString<tchar>(nwbFilePath)
+            , StringConvert(fieldName)
+        );
+        return false;
+    }
+
+    f32 value = 0.0f;
+    if(!ReadFiniteNumber(nwbFilePath, *field, fieldName, value))
+        return false;
+    if(value < 0.0f || (!allowZero && value == 0.0f)){
+        NWB_LOGGER_ERROR(NWB_TEXT("{} '{}': field '{}' must be {}")
+            , StringConvert(s_AnimationClipMetaKind)
+            , PathToString<tchar>(nwbFilePath)
+            , StringConvert(fieldName)
+            , allowZero ? NWB_TEXT("non-negative") : NWB_TEXT("positive")
+        );
+        return false;
+    }
+
+    inOutValue = value;
+    return true;
+}
+
+template<usize ComponentCount>
+[[nodiscard]] bool ReadTuple(
+    const Path& nwbFilePath,
+    const Value& value,
+    const Name& joint,
+    const AStringView fieldName,
+    const usize sampleIndex,
+    f32 (&outValues)[ComponentCount]
+){
+    if(!value.isList() || value.asList().size() != ComponentCount){
+        NWB_LOGGER_ERROR(NWB_TEXT("{} '{}': joint '{}' {}[{}] must be a {}-component numeric list")
+            , StringConvert(s_AnimationTrackMetaKind)
+            , PathToString<tchar>(nwbFilePath)
+            , StringConvert(joint.c_str())
+            , StringConvert(fieldName)
+            , sampleIndex
+            , ComponentCount
+        );
+        return false;
+    }
+
+    const auto& list = value.asList();
+    for(usize componentIndex = 0u; componentIndex < ComponentCount; ++componentIndex){
+        if(!ReadFiniteNumber(nwbFilePath, list[componentIndex], fieldName, outValues[componentIndex]))
+            return false;
+    }
+    return true;
+}
+
+[[nodiscard]] const Value* FindChannelList(
+    const Path& nwbFilePath,
+    const Value& trackValue,
+    const Name& joint,
+    const AStringView fieldName,
+    bool& outValid
+){
+    outValid = true;
+    const Value* channel = FindField(trackValue, fieldName);
+    if(!channel)
+        return nullptr;
+    if(channel->isList())
+        return channel;
+
+    NWB_LOGGER_ERROR(NWB_TEXT("{} '{}': joint '{}' field '{}' must be a list")
+        , StringConvert(s_AnimationTrackMetaKind)
+        , PathToString<tchar>(nwbFilePath)
+        , StringConvert(joint.c_str())
+        , StringConvert(fieldName)
+    );
+    outValid = false;
+    return nullptr;
+}
+
+[[nodiscard]] bool ParseRotationChannel(
+    const Path& nwbFilePath,
+    const Value& trackValue,
+    AnimationClipCookTrack& inOutTrack
+){
+    bool valid = false;
+    const Value* channel = FindChannelList(nwbFilePath, trackValue, inOutTrack.joint, s_RotationsField, valid);
+    if(!channel)
+        return valid;
+
+    const auto& list = channel->asList();
+    inOutTrack.rotations.reserve(list.size());
+    for(usize sampleIndex = 0u; sampleIndex < list.size(); ++sampleIndex){
+        f32 values[4] = {};
+        if(!ReadTuple(nwbFilePath, list[sampleIndex], inOutTrack.joint, s_RotationsField, sampleIndex, values))
+            return false;
+
+        const f32 lengthSquared = ((values[0] * values[0] + values[1] * values[1]) + values[2] * values[2]) + values[3] * values[3];
+        if(!(lengthSquared > s_MinimumRotationLengthSquared)){
+            NWB_LOGGER_ERROR(NWB_TEXT("{} '{}': joint '{}' rotations[{}] must not be a zero quaternion")
+                , StringConvert(s_AnimationTrackMetaKind)
+                , PathToString<tchar>(nwbFilePath)
+                , StringConvert(inOutTrack.joint.c_str())
+                , sampleIndex
+            );
+            return false;
+        }
+
+        const f32 inverseLength = 1.0f / Sqrt(lengthSquared);
+        inOutTrack.rotations.push_back(Float4(
+            values[0] * inverseLength,
+            values[1] * inverseLength,
+            values[2] * inverseLength,
+            values[3] * inverseLength
+        ));
+    }
+    return true;
+}
+
+[[nodiscard]] bool ParseVectorChannel(
+    const Path& nwbFilePath,
+    const Value& trackValue,
+    const Name& joint,
+    const AStringView fieldName,
+    Core::Assets::AssetVector<Float3U>& outSamples
+){
+    bool valid = false;
+    const Value* channel = FindChannelList(nwbFilePath, trackValue, joint, fieldName, valid);
+    if(!channel)
+        return valid;
+
+    const auto& list = channel->asList();
+    outSamples.reserve(list.size());
+    for(usize sampleIndex = 0u; sampleIndex < list.size(); ++sampleIndex){
+        f32 values[3] = {};
+        if(!ReadTuple(nwbFilePath, list[sampleIndex], joint, fieldName, sampleIndex, values))
+            return false;
+        outSamples.push_back(Float3U(values[0], values[1], values[2]));
+    }
+    return true;
+}
+
+[[nodiscard]] bool ParseTrack(const Path& nwbFilePath, const Value& trackValue, AnimationClipCookTrack& outTrack){
+    if(!Core::Assets::ValidateMetadataAssetFields(
+        nwbFilePath,
+        trackValue,
+        s_AnimationTrackMetaKind,
+        { s_JointField, s_RotationsField, s_TranslationsField, s_ScalesField }
+    ))
+        return false;
+    if(!Core::Assets::ReadMetadataNameField(nwbFilePath, trackValue, s_AnimationTrackMetaKind, s_JointField, true, outTrack.joint))
+        return false;
+
+    return ParseRotationChannel(nwbFilePath, trackValue, outTrack)
+        && ParseVectorChannel(nwbFilePath, trackValue, outTrack.joint, s_TranslationsField, outTrack.translations)
+        && ParseVectorChannel(nwbFilePath, trackValue, outTrack.joint, s_ScalesField, outTrack.scales)
+    ;
+}
+
+[[nodiscard]] bool ResolveFrameCount(const Path& nwbFilePath, AnimationClipCookEntry& inOutEntry){
+    usize frameCount = 1u;
+    for(const AnimationClipCookTrack& track : inOutEntry.tracks){
+        frameCount = Max(frameCount, track.rotations.size());
+        frameCount = Max(frameCount, track.translations.size());
+        frameCount = Max(frameCount, track.scales.size());
+    }
+    if(frameCount > s_AnimationClipMaxFrameCount){
+        NWB_LOGGER_ERROR(NWB_TEXT("{} '{}': clip has more than {} frames")
+            , StringConvert(s_AnimationClipMetaKind)
+            , PathToString<tchar>(nwbFilePath)
+            , s_AnimationClipMaxFrameCount
+        );
+        return false;
+    }
+
+    for(const AnimationClipCookTrack& track : inOutEntry.tracks){
+        const usize channelSizes[] = { track.rotations.size(), track.translations.size(), track.scales.size() };
+        bool animated = false;
+        for(const usize channelSize : channelSizes){
+            animated = animated || channelSize != 0u;
+            if(channelSize == 0u || channelSize == 1u || channelSize == frameCount)
+                continue;
+
+            NWB_LOGGER_ERROR(NWB_TEXT("{} '{}': joint '{}' channel has {} samples, expected 1 or {}")
+                , StringConvert(s_AnimationTrackMetaKind)
+                , PathToString<tchar>(nwbFilePath)
+                , StringConvert(track.joint.c_str())
+                , channelSize
+                , frameCount
+            );
+            return false;
+        }
+        if(!animated){
+            NWB_LOGGER_ERROR(NWB_TEXT("{} '{}': joint '{}' has no rotations, translations, or scales")
+                , StringConvert(s_AnimationTrackMetaKind)
+                , PathToString<tchar>(nwbFilePath)
+                , StringConvert(track.joint.c_str())
+            );
+            return false;
+        }
+    }
+
+    inOutEntry.frameCount = static_cast<u32>(frameCount);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+[[nodiscard]] f32 RotationDot(const Float4& lhs, const Float4& rhs){
+    return ((lhs.x * rhs.x + lhs.y * rhs.y) + lhs.z * rhs.z) + lhs.w * rhs.w;
+}
+
+[[nodiscard]] Float4 RotationNlerp(const Float4& from, const Float4& to, const f32 factor){
+    const f32 sign = RotationDot(from, to) < 0.0f ? -1.0f : 1.0f;
+    Float4 result(
+        from.x + factor * (to.x * sign - from.x),
+        from.y + factor * (to.y * sign - from.y),
+        from.z + factor * (to.z * sign - from.z),
+        from.w + factor * (to.w * sign - from.w)
+    );
+    const f32 lengthSquared = RotationDot(result, result);
+    if(!(lengthSquared > s_MinimumRotationLengthSquared))
+        return Float4(0.0f, 0.0f, 0.0f, 1.0f);
+
+    const f32 inverseLength = 1.0f / Sqrt(lengthSquared);
+    result.x *= inverseLength;
+    result.y *= inverseLength;
+    result.z *= inverseLength;
+    result.w *= inverseLength;
+    return result;
+}
+
+[[nodiscard]] Float3U VectorLerp(const Float3U& from, const Float3U& to, const f32 factor){
+    return Float3U(
+        from.x + factor * (to.x - from.x),
+        from.y + factor * (to.y - from.y),
+        from.z + factor * (to.z - from.z)
+    );
+}
+
+// Greedy error-bounded reduction. Starting from an anchor key, the next key is pushed out as far as interpolation
+// between the anchor and the candidate still reproduces every skipped sample.
+template<typename ValueT, typename InterpolateFn, typename WithinToleranceFn>
+void ReduceKeyFrames(
+    const Core::Assets::AssetVector<ValueT>& decoded,
+    InterpolateFn&& interpolate,
+    WithinToleranceFn&& withinTolerance,
+    Core::Assets::AssetVector<u32>& outFrames
+){
+    outFrames.clear();
+    const u32 sampleCount = static_cast<u32>(decoded.size());
+    if(sampleCount == 0u)
+        return;
+
+    outFrames.push_back(0u);
+    bool constant = true;
+    for(u32 frame = 1u; frame < sampleCount && constant; ++frame)
+        constant = withinTolerance(frame, decoded[0u]);
+    if(constant)
+        return;
+
+    const auto spanReproduced = [&](const u32 anchor, const u32 candidate){
+        const f32 inverseSpan = 1.0f / static_cast<f32>(candidate - anchor);
+        for(u32 frame = anchor + 1u; frame < candidate; ++frame){
+            const f32 factor = static_cast<f32>(frame - anchor) * inverseSpan;
+            if(!withinTolerance(frame, interpolate(decoded[anchor], decoded[candidate], factor)))
+                return false;
+        }
+        return true;
+    };
+
+    u32 anchor = 0u;
+    for(u32 candidate = 2u; candidate < sampleCount;){
+        if(spanReproduced(anchor, candidate)){
+            ++candidate;
+            continue;
+        }
+
+        anchor = candidate - 1u;
+        outFrames.push_back(anchor);
+        candidate = anchor + 2u;
+    }
+    if(outFrames.back() != sampleCount - 1u)
+        outFrames.push_back(sampleCount - 1u);
+}
+
+void BuildRotationChannel(
+    const AnimationClipCookTrack& track,
+    const f32 tolerance,
+    AnimationKeyRange& outRange,
+    AnimationClip::RotationKeyVector& inOutKeys
+){
+    outRange = {};
+    outRange.firstKey = static_cast<u32>(inOutKeys.size());
+    if(track.rotations.empty())
+        return;
+
+    Core::Assets::AssetArena& arena = inOutKeys.get_allocator().arena();
+    Core::Assets::AssetVector<Float4> source(arena);
+    Core::Assets::AssetVector<Float4> decoded(arena);
+    Core::Assets::AssetVector<AnimationRotationKey> encoded(arena);
+    source.reserve(track.rotations.size());
+    decoded.reserve(track.rotations.size());
+    encoded.reserve(track.rotations.size());
+    for(const Float4& rotation : track.rotations){
+        // Keep consecutive samples in one hemisphere so interpolation between kept keys follows the authored arc.
+        Float4 sample = rotation;
+        if(!source.empty() && RotationDot(source.back(), sample) < 0.0f)
+            sample = Float4(-sample.x, -sample.y, -sample.z, -sample.w);
+        source.push_back(sample);
+
+        AnimationRotationKey key;
+        AnimationClipCompression::PackRotation(sample, key.packed);
+        Float4 unpacked = AnimationClipCompression::UnpackRotation(key.packed);
+        if(RotationDot(unpacked, sample) < 0.0f)
+            unpacked = Float4(-unpacked.x, -unpacked.y, -unpacked.z, -unpacked.w);
+        decoded.push_back(unpacked);
+        encoded.push_back(key);
+    }
+
+    // |dot(a, b)| >= cos(angle / 2) bounds the rotation angle between a and b.
+    const f32 minimumDot = Cos(Min(tolerance, 3.14159265f) * 0.5f);
+    Core::Assets::AssetVector<u32> frames(arena);
+    ReduceKeyFrames(
+        decoded,
+        &RotationNlerp,
+        [&](const u32 frame, const Float4& value){
+            return Abs(RotationDot(value, source[frame])) >= minimumDot;
+        },
+        frames
+    );
+
+    for(const u32 frame : frames){
+        AnimationRotationKey key = encoded[frame];
+        key.frame = static_cast<u16>(frame);
+        inOutKeys.push_back(key);
+    }
+    outRange.keyCount = static_cast<u32>(frames.size());
+}
+
+void BuildVectorChannel(
+    const Core::Assets::AssetVector<Float3U>& samples,
+    const f32 tolerance,
+    AnimationKeyRange& outRange,
+    AnimationVectorRange& outQuantizationRange,
+    AnimationClip::VectorKeyVector& inOutKeys
+){
+    outRange = {};
+    outQuantizationRange = {};
+    outRange.firstKey = static_cast<u32>(inOutKeys.size());
+    if(samples.empty())
+        return;
+
+    Float3U minimum = samples[0u];
+    Float3U maximum = samples[0u];
+    for(const Float3U& sample : samples){
+        minimum = Float3U(Min(minimum.x, sample.x), Min(minimum.y, sample.y), Min(minimum.z, sample.z));
+        maximum = Float3U(Max(maximum.x, sample.x), Max(maximum.y, sample.y), Max(maximum.z, sample.z));
+    }
+    outQuantizationRange.minimum = minimum;
+    outQuantizationRange.extent = Float3U(maximum.x - minimum.x, maximum.y - minimum.y, maximum.z - minimum.z);
+
+    Core::Assets::AssetArena& arena = inOutKeys.get_allocator().arena();
+    Core::Assets::AssetVector<Float3U> decoded(arena);
+    Core::Assets::AssetVector<AnimationVectorKey> encoded(arena);
+    decoded.reserve(samples.size());
+    encoded.reserve(samples.size());
+    for(const Float3U& sample : samples){
+        AnimationVectorKey key;
+        key.value[0] = AnimationClipCompression::QuantizeVectorComponent(sample.x, minimum.x, outQuantizationRange.extent.x);
+        key.value[1] = AnimationClipCompression::QuantizeVectorComponent(sample.y, minimum.y, outQuantizationRange.extent.y);
+        key.value[2] = AnimationClipCompression::QuantizeVectorComponent(sample.z, minimum.z, outQuantizationRange.extent.z);
+        decoded.push_back(AnimationClipCompression::DequantizeVector(key, outQuantizationRange));
+        encoded.push_back(key);
+    }
+
+    Core::Assets::AssetVector<u32> frames(arena);
+    ReduceKeyFrames(
+        decoded,
+        &VectorLerp,
+        [&](const u32 frame, const Float3U& value){
+            const Float3U& sample = samples[frame];
+            return Abs(value.x - sample.x) <= tolerance
+                && Abs(value.y - sample.y) <= tolerance
+                && Abs(value.z - sample.z) <= tolerance
+            ;
+        },
+        frames
+    );
+
+    for(const u32 frame : frames){
+        AnimationVectorKey key = encoded[frame];
+        key.frame = static_cast<u16>(frame);
+        inOutKeys.push_back(key);
+    }
+    outRange.keyCount = static_cast<u32>(frames.size());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+bool ParseAnimationClipCookMetadata(
+    const Name virtualPath,
+    const Path& nwbFilePath,
+    const Core::Metascript::Value& asset,
+    AnimationClipCookEntry& outEntry
+){
+    using namespace __hidden_animation_clip_cook;
+
+    outEntry = AnimationClipCookEntry(outEntry.tracks.get_allocator().arena());
+    Core::Assets::AssetArena& arena = outEntry.tracks.get_allocator().arena();
+
+    if(!asset.isMap()){
+        NWB_LOGGER_ERROR(NWB_TEXT("Animation clip meta '{}': asset is not a map"), PathToString<tchar>(nwbFilePath));
+        return false;
+    }
+
+    outEntry.virtualPath = virtualPath;
+    if(!outEntry.virtualPath){
+        NWB_LOGGER_ERROR(NWB_TEXT("Animation clip meta '{}': virtual path must not be empty"), PathToString<tchar>(nwbFilePath));
+        return false;
+    }
+    if(!Core::Assets::ValidateMetadataAssetFields(
+        nwbFilePath,
+        asset,
+        s_AnimationClipMetaKind,
+        {
+            s_SkeletonField,
+            s_FrameRateField,
+            s_RotationToleranceField,
+            s_TranslationToleranceField,
+            s_ScaleToleranceField,
+            s_TracksField,
+        }
+    ))
+        return false;
+
+    if(
+        !Core::Assets::ReadMetadataAssetRefField(nwbFilePath, asset, s_AnimationClipMetaKind, s_SkeletonField, true, outEntry.skeleton)
+        || !ReadNonNegativeField(nwbFilePath, asset, s_FrameRateField, true, false, outEntry.frameRate)
+        || !ReadNonNegativeField(nwbFilePath, asset, s_RotationToleranceField, false, true, outEntry.rotationTolerance)
+        || !ReadNonNegativeField(nwbFilePath, asset, s_TranslationToleranceField, false, true, outEntry.translationTolerance)
+        || !ReadNonNegativeField(nwbFilePath, asset, s_ScaleToleranceField, false, true, outEntry.scaleTolerance)
+    )
+        return false;
+
+    const Value* tracks = FindField(asset, s_TracksField);
+    if(!tracks || !tracks->isList() || tracks->asList().size() == 0u){
+        NWB_LOGGER_ERROR(NWB_TEXT("Animation clip meta '{}': field '{}' must be a non-empty list")
+            , PathToString<tchar>(nwbFilePath)
+            , StringConvert(s_TracksField)
+        );
+        return false;
+    }
+
+    const auto& trackList = tracks->asList();
+    outEntry.tracks.reserve(trackList.size());
+    for(usize trackIndex = 0u; trackIndex < trackList.size(); ++trackIndex){
+        const Value& trackValue = trackList[trackIndex];
+        if(!trackValue.isMap()){
+            NWB_LOGGER_ERROR(NWB_TEXT("Animation clip meta '{}': tracks[{}] must be a map")
+                , PathToString<tchar>(nwbFilePath)
+                , trackIndex
+            );
+            return false;
+        }
+
+        AnimationClipCookTrack track(arena);
+        if(!ParseTrack(nwbFilePath, trackValue, track))
+            return false;
+        for(const AnimationClipCookTrack& previousTrack : outEntry.tracks){
+            if(previousTrack.joint != track.joint)
+                continue;
+
+            NWB_LOGGER_ERROR(NWB_TEXT("Animation clip meta '{}': joint '{}' has multiple tracks")
+                , PathToString<tchar>(nwbFilePath)
+                , StringConvert(track.joint.c_str())
+            );
+            return false;
+        }
+        outEntry.tracks.push_back(Move(track));
+    }
+
+    return ResolveFrameCount(nwbFilePath, outEntry);
+}
+
+bool ParseAnimationClipCookMetadata(
+    const Path& assetRoot,
+    const AStringView virtualRoot,
+    const Path& nwbFilePath,
+    const Core::Metascript::Document& doc,
+    AnimationClipCookEntry& outEntry,
+    Core::Alloc::ScratchArena& scratchArena
+){
+    Name virtualPath = NAME_NONE;
+    if(!Core::Assets::BuildMetadataDerivedAssetVirtualPath(assetRoot, virtualRoot, nwbFilePath, virtualPath, scratchArena))
+        return false;
+    return ParseAnimationClipCookMetadata(virtualPath, nwbFilePath, doc.asset(), outEntry);
+}
+
+bool BuildAnimationClipAsset(const AnimationClipCookEntry& clipEntry, AnimationClip& outClip){
+    using namespace __hidden_animation_clip_cook;
+
+    Core::Assets::AssetArena& arena = clipEntry.tracks.get_allocator().arena();
+    outClip = AnimationClip(arena, clipEntry.virtualPath);
+
+    AnimationClip::TrackVector tracks(arena);
+    AnimationClip::RotationKeyVector rotationKeys(arena);
+    AnimationClip::VectorKeyVector translationKeys(arena);
+    AnimationClip::VectorKeyVector scaleKeys(arena);
+    tracks.reserve(clipEntry.tracks.size());
+    for(const AnimationClipCookTrack& cookTrack : clipEntry.tracks){
+        AnimationClipTrack track;
+        track.joint = cookTrack.joint;
+        BuildRotationChannel(cookTrack, clipEntry.rotationTolerance, track.rotation, rotationKeys);
+        BuildVectorChannel(cookTrack.translations, clipEntry.translationTolerance, track.translation, track.translationRange, translationKeys);
+        BuildVectorChannel(cookTrack.scales, clipEntry.scaleTolerance, track.scale, track.scaleRange, scaleKeys);
+        tracks.push_back(track);
+    }
+
+    outClip.setSkeleton(clipEntry.skeleton);
+    outClip.setTiming(clipEntry.frameRate, clipEntry.frameCount);
+    outClip.setTracks(Move(tracks), Move(rotationKeys), Move(translationKeys), Move(scaleKeys));
+    return outClip.validatePayload();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,104 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_COOK)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "asset.h"
+
+#include <core/alloc/scratch.h>
+#include <core/metascript/parser.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+inline constexpr f32 s_AnimationClipDefaultRotationTolerance = 0.0005f;
+inline constexpr f32 s_AnimationClipDefaultTranslationTolerance = 0.0001f;
+inline constexpr f32 s_AnimationClipDefaultScaleTolerance = 0.0001f;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Dense authored samples, one per clip frame. A channel with a single sample is constant; an empty channel keeps the
+// skeleton bind pose for that component.
+struct AnimationClipCookTrack{
+    Name joint = NAME_NONE;
+    Core::Assets::AssetVector<Float4> rotations;
+    Core::Assets::AssetVector<Float3U> translations;
+    Core::Assets::AssetVector<Float3U> scales;
+
+    explicit AnimationClipCookTrack(Core::Assets::AssetArena& arena)
+        : rotations(arena)
+        , translations(arena)
+        , scales(arena)
+    {}
+};
+
+struct AnimationClipCookEntry{
+    Name virtualPath = NAME_NONE;
+    Core::Assets::AssetRef<Skeleton> skeleton;
+    f32 frameRate = 0.0f;
+    u32 frameCount = 0u;
+    // Rotation tolerance is an angle in radians; translation and scale tolerances are per-axis absolute errors.
+    f32 rotationTolerance = s_AnimationClipDefaultRotationTolerance;
+    f32 translationTolerance = s_AnimationClipDefaultTranslationTolerance;
+    f32 scaleTolerance = s_AnimationClipDefaultScaleTolerance;
+    Core::Assets::AssetVector<AnimationClipCookTrack> tracks;
+
+    explicit AnimationClipCookEntry(Core::Assets::AssetArena& arena)
+        : tracks(arena)
+    {}
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+[[nodiscard]] bool ParseAnimationClipCookMetadata(
+    const Path& assetRoot,
+    AStringView virtualRoot,
+    const Path& nwbFilePath,
+    const Core::Metascript::Document& doc,
+    AnimationClipCookEntry& outEntry,
+    Core::Alloc::ScratchArena& scratchArena
+);
+[[nodiscard]] bool ParseAnimationClipCookMetadata(
+    Name virtualPath,
+    const Path& nwbFilePath,
+    const Core::Metascript::Value& asset,
+    AnimationClipCookEntry& outEntry
+);
+// Quantizes every channel and drops keys that linear interpolation (nlerp for rotations) between the kept neighbours
+// reproduces within the entry tolerances, measured against the authored samples after quantization.
+[[nodiscard]] bool BuildAnimationClipAsset(const AnimationClipCookEntry& clipEntry, AnimationClip& outClip);
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,236 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "asset.h"
+#include "binary_payload.h"
+
+#include <core/assets/auto_registration.h>
+#include <core/assets/binary_payload_io.h>
+#include <core/common/log.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_animation_clip_runtime{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+Core::Assets::AssetCodecAutoRegistrar s_AnimationClipAssetCodecAutoRegistrar(&Core::Assets::CreateAssetCodec<AnimationClipAssetCodec>);
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+[[nodiscard]] static bool FiniteVectorRange(const AnimationVectorRange& range){
+    return IsFinite(range.minimum.x) && IsFinite(range.minimum.y) && IsFinite(range.minimum.z)
+        && IsFinite(range.extent.x) && IsFinite(range.extent.y) && IsFinite(range.extent.z)
+        && range.extent.x >= 0.0f && range.extent.y >= 0.0f && range.extent.z >= 0.0f
+    ;
+}
+
+template<typename KeyT>
+[[nodiscard]] static bool ValidateKeyRange(
+    const Name& jointName,
+    const tchar* channelName,
+    const AnimationKeyRange& range,
+    const Core::Assets::AssetVector<KeyT>& keys,
+    const u32 frameCount,
+    u64& inOutReferencedKeyCount
+){
+    const u64 rangeEnd = static_cast<u64>(range.firstKey) + static_cast<u64>(range.keyCount);
+    if(rangeEnd > keys.size()){
+        NWB_LOGGER_ERROR(NWB_TEXT("AnimationClip::validatePayload failed: joint '{}' has an invalid {} key range")
+            , StringConvert(jointName.c_str())
+            , channelName
+        );
+        return false;
+    }
+
+    for(u32 keyOffset = 0u; keyOffset < range.keyCount; ++keyOffset){
+        const u32 frame = keys[range.firstKey + keyOffset].frame;
+        const bool increasing = keyOffset == 0u || frame > keys[range.firstKey + keyOffset - 1u].frame;
+        if(frame >= frameCount || !increasing){
+            NWB_LOGGER_ERROR(NWB_TEXT("AnimationClip::validatePayload failed: joint '{}' has an invalid {} key frame {}")
+                , StringConvert(jointName.c_str())
+                , channelName
+                , frame
+            );
+            return false;
+        }
+    }
+
+    inOutReferencedKeyCount += range.keyCount;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+void AnimationClip::setTracks(
+    TrackVector&& tracks,
+    RotationKeyVector&& rotationKeys,
+    VectorKeyVector&& translationKeys,
+    VectorKeyVector&& scaleKeys
+){
+    m_tracks = Move(tracks);
+    m_rotationKeys = Move(rotationKeys);
+    m_translationKeys = Move(translationKeys);
+    m_scaleKeys = Move(scaleKeys);
+}
+
+u32 AnimationClip::findTrackIndex(const Name jointName)const{
+    for(usize trackIndex = 0u; trackIndex < m_tracks.size(); ++trackIndex){
+        if(m_tracks[trackIndex].joint == jointName)
+            return static_cast<u32>(trackIndex);
+    }
+    return s_AnimationClipInvalidTrackIndex;
+}
+
+bool AnimationClip::validatePayload()const{
+    using namespace __hidden_animation_clip_runtime;
+
+    if(!virtualPath()){
+        NWB_LOGGER_ERROR(NWB_TEXT("AnimationClip::validatePayload failed: virtual path is empty"));
+        return false;
+    }
+    if(!m_skeleton.valid()){
+        NWB_LOGGER_ERROR(NWB_TEXT("AnimationClip::validatePayload failed: clip '{}' has no skeleton"), StringConvert(virtualPath().c_str()));
+        return false;
+    }
+    if(!IsFinite(m_frameRate) || m_frameRate <= 0.0f){
+        NWB_LOGGER_ERROR(NWB_TEXT("AnimationClip::validatePayload failed: clip '{}' has invalid frame rate"), StringConvert(virtualPath().c_str()));
+        return false;
+    }
+    if(m_frameCount == 0u || m_frameCount > s_AnimationClipMaxFrameCount){
+        NWB_LOGGER_ERROR(NWB_TEXT("AnimationClip::validatePayload failed: clip '{}' has invalid frame count {}")
+            , StringConvert(virtualPath().c_str())
+            , m_frameCount
+        );
+        return false;
+    }
+    if(m_tracks.empty()){
+        NWB_LOGGER_ERROR(NWB_TEXT("AnimationClip::validatePayload failed: clip '{}' has no tracks"), StringConvert(virtualPath().c_str()));
+        return false;
+    }
+
+    u64 referencedRotationKeys = 0u;
+    u64 referencedTranslationKeys = 0u;
+    u64 referencedScaleKeys = 0u;
+    for(usize trackIndex = 0u; trackIndex < m_tracks.size(); ++trackIndex){
+        const AnimationClipTrack& track = m_tracks[trackIndex];
+        if(!track.joint){
+            NWB_LOGGER_ERROR(NWB_TEXT("AnimationClip::validatePayload failed: track {} has no joint"), trackIndex);
+            return false;
+        }
+        for(usize previousIndex = 0u; previousIndex < trackIndex; ++previousIndex){
+            if(m_tracks[previousIndex].joint != track.joint)
+                continue;
+
+            NWB_LOGGER_ERROR(NWB_TEXT("AnimationClip::validatePayload failed: joint '{}' has multiple tracks"), StringConvert(track.joint.c_str()));
+            return false;
+        }
+        if(!FiniteVectorRange(track.translationRange) || !FiniteVectorRange(track.scaleRange)){
+            NWB_LOGGER_ERROR(NWB_TEXT("AnimationClip::validatePayload failed: joint '{}' has an invalid quantization range")
+                , StringConvert(track.joint.c_str())
+            );
+            return false;
+        }
+
+        if(
+            !ValidateKeyRange(track.joint, NWB_TEXT("rotation"), track.rotation, m_rotationKeys, m_frameCount, referencedRotationKeys)
+            || !ValidateKeyRange(track.joint, NWB_TEXT("translation"), track.translation, m_translationKeys, m_frameCount, referencedTranslationKeys)
+            || !ValidateKeyRange(track.joint, NWB_TEXT("scale"), track.scale, m_scaleKeys, m_frameCount, referencedScaleKeys)
+        )
+            return false;
+    }
+
+    if(
+        referencedRotationKeys != m_rotationKeys.size()
+        || referencedTranslationKeys != m_translationKeys.size()
+        || referencedScaleKeys != m_scaleKeys.size()
+    ){
+        NWB_LOGGER_ERROR(NWB_TEXT("AnimationClip::validatePayload failed: clip '{}' key ranges do not cover the key streams")
+            , StringConvert(virtualPath().c_str())
+        );
+        return false;
+    }
+
+    return true;
+}
+
+bool AnimationClip::loadBinary(const Core::Assets::AssetBytes& binary){
+    m_skeleton.reset();
+    m_frameRate = 0.0f;
+    m_frameCount = 0u;
+    m_tracks.clear();
+    m_rotationKeys.clear();
+    m_translationKeys.clear();
+    m_scaleKeys.clear();
+
+    usize cursor = 0u;
+    AnimationClipBinaryPayload::HeaderBinary header;
+    if(!Core::Assets::ReadMagicHeaderPayload(
+        binary,
+        cursor,
+        header,
+        AnimationClipBinaryPayload::s_AnimationClipMagic,
+        NWB_TEXT("AnimationClip::loadBinary"),
+        NWB_TEXT("animation clip")
+    ))
+        return false;
+
+    Core::Assets::AssetVector<AnimationClipBinaryPayload::TrackBinary> trackBinaries(m_tracks.get_allocator().arena());
+    if(
+        !Core::Assets::ReadVectorPayload(binary, cursor, header.trackCount, trackBinaries, NWB_TEXT("AnimationClip::loadBinary"), NWB_TEXT("tracks"))
+        || !Core::Assets::ReadVectorPayload(binary, cursor, header.rotationKeyCount, m_rotationKeys, NWB_TEXT("AnimationClip::loadBinary"), NWB_TEXT("rotation keys"))
+        || !Core::Assets::ReadVectorPayload(binary, cursor, header.translationKeyCount, m_translationKeys, NWB_TEXT("AnimationClip::loadBinary"), NWB_TEXT("translation keys"))
+        || !Core::Assets::ReadVectorPayload(binary, cursor, header.scaleKeyCount, m_scaleKeys, NWB_TEXT("AnimationClip::loadBinary"), NWB_TEXT("scale keys"))
+    )
+        return false;
+
+    m_skeleton.virtualPath = Name(header.skeletonNameHash);
+    m_frameRate = header.frameRate;
+    m_frameCount = header.frameCount;
+    m_tracks.reserve(trackBinaries.size());
+    for(const AnimationClipBinaryPayload::TrackBinary& trackBinary : trackBinaries){
+        AnimationClipTrack track;
+        track.joint = Name(trackBinary.jointNameHash);
+        track.rotation = trackBinary.rotation;
+        track.translation = trackBinary.translation;
+        track.scale = trackBinary.scale;
+        track.translationRange = trackBinary.translationRange;
+        track.scaleRange = trackBinary.scaleRange;
+        m_tracks.push_back(track);
+    }
+
+    return Core::Assets::ReadCompletePayload(binary, cursor, NWB_TEXT("AnimationClip::loadBinary"))
+        && validatePayload()
+    ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
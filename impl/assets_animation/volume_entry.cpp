@@ -0,0 +1,104 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_COOK)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "cook.h"
+
+#include <core/assets/cook_entry_registry.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_assets_animation_volume_entry{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static bool ParseAnimationClipDocument(
+    const Path& assetRoot,
+    const AStringView virtualRoot,
+    const Path& nwbFilePath,
+    const Core::Metascript::Document& doc,
+    AnimationClipCookEntry& outEntry,
+    Core::Assets::CookEntryParseContext& context
+){
+    return ParseAnimationClipCookMetadata(
+        assetRoot,
+        virtualRoot,
+        nwbFilePath,
+        doc,
+        outEntry,
+        context.scratchArena
+    );
+}
+
+static bool ParseAnimationClipValue(
+    const Name virtualPath,
+    const Path& nwbFilePath,
+    const Core::Metascript::Value& asset,
+    AnimationClipCookEntry& outEntry,
+    Core::Assets::CookEntryParseContext&
+){
+    return ParseAnimationClipCookMetadata(
+        virtualPath,
+        nwbFilePath,
+        asset,
+        outEntry
+    );
+}
+
+static bool BuildAnimationClipCookedAsset(AnimationClipCookEntry& entry, AnimationClip& outAsset){
+    return BuildAnimationClipAsset(entry, outAsset);
+}
+
+static bool RegisterAnimationClipCookEntry(Core::Assets::CookEntryRegistry& registry){
+    return registry.registerType<AnimationClipCookEntry, AnimationClip, AnimationClipAssetCodec>(
+        AnimationClip::AssetTypeName(),
+        NWB_TEXT("animation_clip"),
+        &ParseAnimationClipDocument,
+        &ParseAnimationClipValue,
+        &BuildAnimationClipCookedAsset
+    );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+Core::Assets::CookEntryAutoRegistrar s_AnimationClipCookEntryRegistrar(&RegisterAnimationClipCookEntry);
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -54,6 +54,30 @@ enum Enum : u8{
 };
 };
 
+// One archive record's worth of work. Jobs are planned serially in record order, compiled concurrently, and then
+// appended to the manifest serially in the same order so the archive layout does not depend on scheduling.
+struct ShaderVariantJob{
+    usize preparedEntryIndex = 0u;
+    Name shaderName = NAME_NONE;
+    Name stageName = NAME_NONE;
+    ShaderCook::DefineCombo defineCombo;
+    CookString variantName;
+    CookString sourceChecksumHex;
+    VariantCachePaths cachePaths;
+    Core::GraphicsBytes bytecode;
+    u64 sourceChecksum = 0u;
+
+    ShaderVariantJob(ShaderCook::CookArena& arena, Path::Arena& pathArena)
+        : defineCombo(0, Hasher<CookString>(), EqualTo<CookString>(), arena)
+        , variantName(arena)
+        , sourceChecksumHex(arena)
+        , cachePaths(pathArena)
+        , bytecode(arena)
+    {}
+};
+
+using ShaderVariantJobVector = Vector<ShaderVariantJob, ShaderCook::CookArena>;
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -63,6 +87,8 @@ inline constexpr AStringView s_BytecodeNameSeparator = "__";
 inline constexpr AStringView s_BytecodeExtension = ".spv";
 inline constexpr AStringView s_SourceChecksumExtension = ".source";
 
+inline constexpr Name s_VariantCompileScratchArena("impl/assets_graphics/shader_variant_compile");
+
 
 static VariantCachePaths BuildVariantCachePaths(
     const Path& cacheDirectory,
@@ -160,8 +186,6 @@ static bool GetVariantBytecode(
     Core::GraphicsBytes& outBytecode,
     ScratchArena& scratchArena
 ){
-    ErrorCode errorCode;
-
     outBytecode.clear();
 
     ScratchString cachedText{scratchArena};
@@ -223,15 +247,6 @@ static bool GetVariantBytecode(
         return lhs.name < rhs.name;
     });
 
-    errorCode.clear();
-    if(!EnsureDirectories(cachePaths.bytecodePath.parent_path(), errorCode)){
-        NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: failed to create cache directory '{}': {}")
-            , PathToString<tchar>(cachePaths.bytecodePath.parent_path())
-            , StringConvert(errorCode.message())
-        );
-        return false;
-    }
-
     const ShaderCook::ShaderCompilerRequest compileRequest = {
         entry.name,
         entry.stage.view(),
@@ -262,7 +277,7 @@ static bool GetVariantBytecode(
 
 static bool ReserveShaderIndexRecords(
     const PreparedShaderVector& preparedEntries,
-    Core::GraphicsVector<Core::ShaderArchive::Record>& outShaderIndexRecords,
+    ShaderIndexRecordVector& outShaderIndexRecords,
     usize& outShaderRecordCount
 ){
     outShaderRecordCount = 0u;
@@ -286,9 +301,39 @@ static bool ReserveShaderIndexRecords(
     return true;
 }
 
-static bool AppendShaderIndexToManifest(
+static u64 BuildShaderVariantCookKeyHash(
+    const NameHash& virtualPathHash,
+    const u64 sourceChecksum,
+    const u64 bytecodeChecksum
+){
+    static constexpr u32 s_ShaderVariantCookKeyVersion = 3u;
+    WyHash64Stream hash;
+    hash.updateValue(s_ShaderVariantCookKeyVersion);
+    hash.updateValue(virtualPathHash);
+    hash.updateValue(sourceChecksum);
+    hash.updateValue(bytecodeChecksum);
+    return hash.finish();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace AssetsGraphicsCookDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+bool AppendShaderIndexToManifest(
     ShaderCook::CookArena& cookArena,
-    const Core::GraphicsVector<Core::ShaderArchive::Record>& shaderIndexRecords,
+    const ShaderIndexRecordVector& shaderIndexRecords,
     Core::Assets::AssetsVolumeCookDetail::AssetVolumePackManifest& manifest,
     VirtualPathHashSet& inOutSeenVirtualPathHashes
 ){
@@ -312,57 +357,30 @@ static bool AppendShaderIndexToManifest(
     return false;
 }
 
-static u64 BuildShaderVariantCookKeyHash(
-    const NameHash& virtualPathHash,
-    const u64 sourceChecksum,
-    const u64 bytecodeChecksum
-){
-    static constexpr u32 s_ShaderVariantCookKeyVersion = 2u;
-    u64 hash = FNV64_OFFSET_BASIS;
-    Fnv64AppendValue(hash, s_ShaderVariantCookKeyVersion);
-    Fnv64AppendValue(hash, virtualPathHash);
-    Fnv64AppendValue(hash, sourceChecksum);
-    Fnv64AppendValue(hash, bytecodeChecksum);
-    return hash;
-}
-
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-
-};
-
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-
-namespace AssetsGraphicsCookDetail{
-
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-
-bool AppendPreparedShadersToManifest(
+bool AppendPreparedShaderBytecodeToManifest(
     ShaderCook::CookArena& cookArena,
     ShaderCook& shaderCook,
+    Core::Alloc::ThreadPool& threadPool,
+    const u32 maxConcurrentCompiles,
     const Path& cacheDirectory,
     const AStringView configurationSafeName,
     PreparedShaderVector& preparedEntries,
     Core::Assets::AssetsVolumeCookDetail::AssetVolumePackManifest& manifest,
     VirtualPathHashSet& inOutSeenVirtualPathHashes,
+    ShaderIndexRecordVector& outShaderIndexRecords,
     ScratchArena& scratchArena
 ){
-    Core::GraphicsVector<Core::ShaderArchive::Record> shaderIndexRecords{cookArena};
     usize shaderRecordCount = 0u;
-    if(!__hidden_shader_volume_writer::ReserveShaderIndexRecords(preparedEntries, shaderIndexRecords, shaderRecordCount))
+    if(!__hidden_shader_volume_writer::ReserveShaderIndexRecords(preparedEntries, outShaderIndexRecords, shaderRecordCount))
         return false;
 
-    Core::GraphicsBytes cookedBytecode{cookArena};
-    Core::GraphicsBytes shaderAssetPayload{cookArena};
+    __hidden_shader_volume_writer::ShaderVariantJobVector variantJobs{cookArena};
+    variantJobs.reserve(shaderRecordCount);
     ShaderCook::CookVector<ShaderCook::DefineCombo> defineCombinations{ cookArena };
-    shaderIndexRecords.clear();
+    outShaderIndexRecords.clear();
 
-    for(PreparedShaderEntry& preparedEntry : preparedEntries){
+    for(usize preparedEntryIndex = 0u; preparedEntryIndex < preparedEntries.size(); ++preparedEntryIndex){
+        PreparedShaderEntry& preparedEntry = preparedEntries[preparedEntryIndex];
         ShaderCook::ShaderEntry& entry = preparedEntry.entry;
         const Name shaderName = ToName(entry.name);
         const Name stageName = ToName(entry.archiveStage.view());
@@ -378,98 +396,37 @@ bool AppendPreparedShadersToManifest(
         const CookString shaderSafeName = BuildSafeCacheName(entry.name);
         const CookString stageSafeName = BuildSafeCacheName(cookArena, entry.archiveStage.view());
 
-        auto appendShaderVariant = [&](const ShaderCook::DefineCombo& defineCombo) -> bool{
-            const CookString generatedVariantName = shaderCook.buildVariantName(defineCombo, scratchArena);
+        auto planShaderVariant = [&](const ShaderCook::DefineCombo& defineCombo) -> bool{
+            if(variantJobs.size() >= shaderRecordCount){
+                NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: shader record count exceeded prepared capacity"));
+                return false;
+            }
 
-            u64 sourceChecksum = 0;
+            __hidden_shader_volume_writer::ShaderVariantJob job(cookArena, cacheDirectory.arena());
+            job.preparedEntryIndex = preparedEntryIndex;
+            job.shaderName = shaderName;
+            job.stageName = stageName;
+            job.defineCombo = defineCombo;
+            job.variantName = shaderCook.buildVariantName(defineCombo, scratchArena);
             if(!shaderCook.computeSourceChecksum(
                 entry,
-                generatedVariantName,
+                job.variantName,
                 preparedEntry.dependencyChecksum,
-                sourceChecksum,
+                job.sourceChecksum,
                 scratchArena
             ))
                 return false;
-            const CookString sourceChecksumHex = FormatHex64A(cookArena, sourceChecksum);
+            job.sourceChecksumHex = FormatHex64A(cookArena, job.sourceChecksum);
 
-            const __hidden_shader_volume_writer::VariantCachePaths cachePaths = __hidden_shader_volume_writer::BuildVariantCachePaths(
+            job.cachePaths = __hidden_shader_volume_writer::BuildVariantCachePaths(
                 cacheDirectory,
                 configurationSafeName,
                 shaderSafeName,
                 stageSafeName,
-                generatedVariantName,
+                job.variantName,
                 scratchArena
             );
-            if(!__hidden_shader_volume_writer::GetVariantBytecode(
-                entry,
-                generatedVariantName,
-                defineCombo,
-                preparedEntry.includeDirectories,
-                preparedEntry.dependencies,
-                preparedEntry.sourcePath,
-                cachePaths,
-                sourceChecksumHex,
-                shaderCook,
-                cookedBytecode,
-                scratchArena
-            ))
-                return false;
-
-            const Name virtualPath = Core::ShaderArchive::buildVirtualPathName(shaderName, generatedVariantName, stageName);
-            if(!virtualPath){
-                NWB_LOGGER_ERROR(NWB_TEXT("Shader cook failed to build virtual path for '{}' stage '{}' variant '{}'")
-                    , StringConvert(entry.name)
-                    , StringConvert(entry.archiveStage.c_str())
-                    , StringConvert(generatedVariantName)
-                );
-                return false;
-            }
-
-            const NameHash virtualPathHash = virtualPath.hash();
-            if(!inOutSeenVirtualPathHashes.insert(virtualPathHash).second){
-                NWB_LOGGER_ERROR(NWB_TEXT("Shader cook produced duplicate virtual path '{}' (entry='{}', variant='{}')")
-                    , StringConvert(virtualPath.c_str())
-                    , StringConvert(entry.name)
-                    , StringConvert(generatedVariantName)
-                );
-                return false;
-            }
-
-            const u64 bytecodeChecksum = ComputeFnv64Bytes(cookedBytecode.data(), cookedBytecode.size());
-            const u64 cookKeyHash = __hidden_shader_volume_writer::BuildShaderVariantCookKeyHash(
-                virtualPathHash,
-                sourceChecksum,
-                bytecodeChecksum
-            );
-            const ShaderBinaryPayload::AssetPayloadFailure::Enum payloadFailure = ShaderBinaryPayload::EncodeAssetPayload(
-                AStringView(entry.entryPoint),
-                cookedBytecode,
-                shaderAssetPayload
-            );
-            if(payloadFailure != ShaderBinaryPayload::AssetPayloadFailure::None){
-                NWB_LOGGER_ERROR(NWB_TEXT("Failed to package shader payload '{}' (failure {})")
-                    , StringConvert(virtualPath.c_str())
-                    , static_cast<u32>(payloadFailure)
-                );
-                return false;
-            }
-            if(!Core::Assets::AssetsVolumeCookDetail::AppendPayloadBytesToManifest(manifest, virtualPath, shaderAssetPayload, cookKeyHash)){
-                NWB_LOGGER_ERROR(NWB_TEXT("Failed to append shader payload '{}' to manifest"), StringConvert(virtualPath.c_str()));
-                return false;
-            }
-
-            Core::ShaderArchive::Record record(cookArena);
-            record.shaderName = shaderName;
-            record.variantName = generatedVariantName;
-            record.stage = stageName;
-            record.sourceChecksum = sourceChecksum;
-            record.bytecodeChecksum = bytecodeChecksum;
-            record.virtualPathHash = virtualPathHash;
-            if(shaderIndexRecords.size() >= shaderRecordCount){
-                NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: shader record count exceeded prepared capacity"));
-                return false;
-            }
-            shaderIndexRecords.push_back(Move(record));
+            variantJobs.push_back(Move(job));
             return true;
         };
 
@@ -483,7 +440,7 @@ bool AppendPreparedShadersToManifest(
             defineCombinations.push_back(ShaderCook::DefineCombo(cookArena));
 
         for(const ShaderCook::DefineCombo& defineCombo : defineCombinations){
-            if(!appendShaderVariant(defineCombo))
+            if(!planShaderVariant(defineCombo))
                 return false;
 
             if(preparedEntry.supportsCsgClipVariant || preparedEntry.supportsAvboitCsgClipVariant){
@@ -491,22 +448,162 @@ bool AppendPreparedShadersToManifest(
                 if(!AssetsGraphicsCsgShaderVariants::BuildClipDefineCombo(cookArena, AStringView(entry.name), defineCombo, csgDefineCombo))
                     return false;
 
-                if(!appendShaderVariant(csgDefineCombo))
+                if(!planShaderVariant(csgDefineCombo))
                     return false;
             }
         }
     }
-
-    if(shaderIndexRecords.size() != shaderRecordCount){
+    if(variantJobs.size() != shaderRecordCount){
         NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: shader record count mismatch after cook"));
         return false;
     }
-    return __hidden_shader_volume_writer::AppendShaderIndexToManifest(
+
+    // Every variant of a configuration shares one cache directory; create it up front rather than racing from the
+    // compile slots.
+    if(!variantJobs.empty()){
+        ErrorCode errorCode;
+        const Path cacheVariantDirectory = variantJobs.front().cachePaths.bytecodePath.parent_path();
+        if(!EnsureDirectories(cacheVariantDirectory, errorCode)){
+            NWB_LOGGER_ERROR(NWB_TEXT("AssetVolumeCooker: failed to create cache directory '{}': {}")
+                , PathToString<tchar>(cacheVariantDirectory)
+                , StringConvert(errorCode.message())
+            );
+            return false;
+        }
+    }
+
+    // Each compile slot pulls the next variant off a shared cursor, so at most slotCount compiler processes are in
+    // flight. Compiler diagnostics are logged by the slot that produced them as soon as the variant finishes.
+    const usize variantJobCount = variantJobs.size();
+    usize compileSlotCount = maxConcurrentCompiles != 0u
+        ? static_cast<usize>(maxConcurrentCompiles)
+        : static_cast<usize>(threadPool.workerThreadCount()) + 1u
+    ;
+    compileSlotCount = Min(compileSlotCount, variantJobCount);
+
+    Atomic<usize> nextVariantJob{ 0u };
+    Atomic<bool> failed{ false };
+    threadPool.boundedParallelFor(static_cast<usize>(0u), compileSlotCount, static_cast<usize>(1u), compileSlotCount, [&](const usize){
+        Core::Alloc::ScratchArena compileScratchArena(__hidden_shader_volume_writer::s_VariantCompileScratchArena);
+        for(;;){
+            if(failed.load(MemoryOrder::acquire))
+                return;
+
+            const usize jobIndex = nextVariantJob.fetch_add(1u, MemoryOrder::relaxed);
+            if(jobIndex >= variantJobCount)
+                return;
+
+            __hidden_shader_volume_writer::ShaderVariantJob& job = variantJobs[jobIndex];
+            const PreparedShaderEntry& preparedEntry = preparedEntries[job.preparedEntryIndex];
+            if(!__hidden_shader_volume_writer::GetVariantBytecode(
+                preparedEntry.entry,
+                job.variantName,
+                job.defineCombo,
+                preparedEntry.includeDirectories,
+                preparedEntry.dependencies,
+                preparedEntry.sourcePath,
+                job.cachePaths,
+                job.sourceChecksumHex,
+                shaderCook,
+                job.bytecode,
+                compileScratchArena
+            ))
+                failed.store(true, MemoryOrder::release);
+        }
+    });
+    if(failed.load(MemoryOrder::acquire))
+        return false;
+
+    Core::GraphicsBytes shaderAssetPayload{cookArena};
+    for(__hidden_shader_volume_writer::ShaderVariantJob& job : variantJobs){
+        const ShaderCook::ShaderEntry& entry = preparedEntries[job.preparedEntryIndex].entry;
+        const Name virtualPath = Core::ShaderArchive::buildVirtualPathName(job.shaderName, job.variantName, job.stageName);
+        if(!virtualPath){
+            NWB_LOGGER_ERROR(NWB_TEXT("Shader cook failed to build virtual path for '{}' stage '{}' variant '{}'")
+                , StringConvert(entry.name)
+                , StringConvert(entry.archiveStage.c_str())
+                , StringConvert(job.variantName)
+            );
+            return false;
+        }
+
+        const NameHash virtualPathHash = virtualPath.hash();
+        if(!inOutSeenVirtualPathHashes.insert(virtualPathHash).second){
+            NWB_LOGGER_ERROR(NWB_TEXT("Shader cook produced duplicate virtual path '{}' (entry='{}', variant='{}')")
+                , StringConvert(virtualPath.c_str())
+                , StringConvert(entry.name)
+                , StringConvert(job.variantName)
+            );
+            return false;
+        }
+
+        const u64 bytecodeChecksum = ComputeWyHash64(job.bytecode.data(), job.bytecode.size());
+        const u64 cookKeyHash = __hidden_shader_volume_writer::BuildShaderVariantCookKeyHash(
+            virtualPathHash,
+            job.sourceChecksum,
+            bytecodeChecksum
+        );
+        const ShaderBinaryPayload::AssetPayloadFailure::Enum payloadFailure = ShaderBinaryPayload::EncodeAssetPayload(
+            AStringView(entry.entryPoint),
+            job.bytecode,
+            shaderAssetPayload
+        );
+        if(payloadFailure != ShaderBinaryPayload::AssetPayloadFailure::None){
+            NWB_LOGGER_ERROR(NWB_TEXT("Failed to package shader payload '{}' (failure {})")
+                , StringConvert(virtualPath.c_str())
+                , static_cast<u32>(payloadFailure)
+            );
+            return false;
+        }
+        if(!Core::Assets::AssetsVolumeCookDetail::AppendPayloadBytesToManifest(manifest, virtualPath, shaderAssetPayload, cookKeyHash)){
+            NWB_LOGGER_ERROR(NWB_TEXT("Failed to append shader payload '{}' to manifest"), StringConvert(virtualPath.c_str()));
+            return false;
+        }
+        // The manifest owns a packaged copy; release the compiled bytes as the append walks forward.
+        job.bytecode.clear();
+        job.bytecode.shrink_to_fit();
+
+        Core::ShaderArchive::Record record(cookArena);
+        record.shaderName = job.shaderName;
+        record.variantName = job.variantName;
+        record.stage = job.stageName;
+        record.sourceChecksum = job.sourceChecksum;
+        record.bytecodeChecksum = bytecodeChecksum;
+        record.virtualPathHash = virtualPathHash;
+        outShaderIndexRecords.push_back(Move(record));
+    }
+    return true;
+}
+
+bool AppendPreparedShadersToManifest(
+    ShaderCook::CookArena& cookArena,
+    ShaderCook& shaderCook,
+    Core::Alloc::ThreadPool& threadPool,
+    const u32 maxConcurrentCompiles,
+    const Path& cacheDirectory,
+    const AStringView configurationSafeName,
+    PreparedShaderVector& preparedEntries,
+    Core::Assets::AssetsVolumeCookDetail::AssetVolumePackManifest& manifest,
+    VirtualPathHashSet& inOutSeenVirtualPathHashes,
+    ScratchArena& scratchArena
+){
+    ShaderIndexRecordVector shaderIndexRecords{cookArena};
+    if(!AppendPreparedShaderBytecodeToManifest(
         cookArena,
-        shaderIndexRecords,
+        shaderCook,
+        threadPool,
+        maxConcurrentCompiles,
+        cacheDirectory,
+        configurationSafeName,
+        preparedEntries,
         manifest,
-        inOutSeenVirtualPathHashes
-    );
+        inOutSeenVirtualPathHashes,
+        shaderIndexRecords,
+        scratchArena
+    ))
+        return false;
+
+    return AppendShaderIndexToManifest(cookArena, shaderIndexRecords, manifest, inOutSeenVirtualPathHashes);
 }
 
 
@@ -13,7 +13,9 @@
 
 #include "shader_cook_plan.h"
 
+#include <core/alloc/thread.h>
 #include <core/assets/volume/pack_manifest.h>
+#include <core/graphics/shader_archive.h>
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -31,9 +33,44 @@ namespace AssetsGraphicsCookDetail{
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+using ShaderIndexRecordVector = Core::GraphicsVector<Core::ShaderArchive::Record>;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Compiles every prepared shader variant and appends its payload, returning the archive index records in
+// outShaderIndexRecords. Cache misses compile concurrently on threadPool with at most maxConcurrentCompiles compiler
+// invocations in flight (0 allows one per pool thread, including the caller); records and payloads are appended in the
+// same order regardless of concurrency.
+[[nodiscard]] bool AppendPreparedShaderBytecodeToManifest(
+    ShaderCook::CookArena& cookArena,
+    ShaderCook& shaderCook,
+    Core::Alloc::ThreadPool& threadPool,
+    u32 maxConcurrentCompiles,
+    const Path& cacheDirectory,
+    AStringView configurationSafeName,
+    PreparedShaderVector& preparedEntries,
+    Core::Assets::AssetsVolumeCookDetail::AssetVolumePackManifest& manifest,
+    VirtualPathHashSet& inOutSeenVirtualPathHashes,
+    ShaderIndexRecordVector& outShaderIndexRecords,
+    ScratchArena& scratchArena
+);
+
+// Serializes the shader archive index built from AppendPreparedShaderBytecodeToManifest's records.
+[[nodiscard]] bool AppendShaderIndexToManifest(
+    ShaderCook::CookArena& cookArena,
+    const ShaderIndexRecordVector& shaderIndexRecords,
+    Core::Assets::AssetsVolumeCookDetail::AssetVolumePackManifest& manifest,
+    VirtualPathHashSet& inOutSeenVirtualPathHashes
+);
+
+// Both of the above in one call: variant payloads followed by the shader archive index.
 [[nodiscard]] bool AppendPreparedShadersToManifest(
     ShaderCook::CookArena& cookArena,
     ShaderCook& shaderCook,
+    Core::Alloc::ThreadPool& threadPool,
+    u32 maxConcurrentCompiles,
     const Path& cacheDirectory,
     AStringView configurationSafeName,
     PreparedShaderVector& preparedEntries,
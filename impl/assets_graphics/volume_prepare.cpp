@@ -40,6 +40,8 @@ namespace __hidden_assets_graphics_volume_prepare{
 
 inline constexpr Name s_GraphicsVolumeMetadataExtensionName("assets_graphics/volume_metadata");
 inline constexpr Name s_IncludeAssetTypeName("include");
+inline constexpr Name s_ShaderBytecodeProduct("impl/assets_graphics/shader_bytecode");
+inline constexpr Name s_ShaderIndexProduct("impl/assets_graphics/shader_index");
 
 using MaterialBindEntryVector = ShaderCook::CookVector<MaterialBindEntry>;
 using CsgShapeEntryVector = ShaderCook::CookVector<AssetsCsgCook::CsgShapeCookEntry>;
@@ -51,6 +53,7 @@ struct GraphicsVolumeMetadata{
     MaterialBindEntryVector materialBindEntries;
     CsgShapeEntryVector csgShapeEntries;
     AssetsGraphicsCookDetail::PreparedShaderPlan preparedPlan;
+    AssetsGraphicsCookDetail::ShaderIndexRecordVector shaderIndexRecords;
     HashSet<
         AssetsGraphicsCookDetail::PreparedShaderKey,
         AssetsGraphicsCookDetail::PreparedShaderKeyHasher,
@@ -65,6 +68,7 @@ struct GraphicsVolumeMetadata{
         , materialBindEntries(arena)
         , csgShapeEntries(arena)
         , preparedPlan(arena)
+        , shaderIndexRecords(arena)
         , seenShaderIdentityKeys(
             0,
             AssetsGraphicsCookDetail::PreparedShaderKeyHasher(),
@@ -490,22 +494,53 @@ static bool PrepareGraphicsVolumeAssets(Core::Assets::AssetsVolumeCookDetail::As
     if(!Core::Assets::AddPlannedFileCount(graphicsMetadata.preparedPlan.plannedFileCount, context.plannedFileCount))
         return false;
 
-    context.manifestCookers.emplace_back([&context](
-        Core::Assets::AssetsVolumeCookDetail::AssetVolumePackManifest& manifest,
-        Core::Assets::CookEntryPathHashSet& seenVirtualPathHashes,
-        Core::Assets::ScratchArena& writeScratchArena
-    ){
-        return AssetsGraphicsCookDetail::AppendPreparedShadersToManifest(
-            context.arena,
-            GraphicsMetadata(context.parsedMetadata).shaderCook,
-            context.resolvedPaths.cacheDirectory,
-            context.configurationSafeName,
-            GraphicsMetadata(context.parsedMetadata).preparedPlan.preparedEntries,
-            manifest,
-            seenVirtualPathHashes,
-            writeScratchArena
-        );
-    });
+    // Shader bytecode only reads the prepared plan, so it compiles alongside the registry objects. The archive index is
+    // built from the records the bytecode cooker leaves behind, so it waits on that product.
+    Core::Assets::AssetsVolumeCookDetail::AssetVolumeManifestCooker& shaderCooker = context.manifestCookers.emplace_back(
+        context.arena,
+        AStringView("graphics_shaders"),
+        [&context, &graphicsMetadata](
+            Core::Assets::AssetsVolumeCookDetail::AssetVolumePackManifest& manifest,
+            Core::Assets::CookEntryPathHashSet& seenVirtualPathHashes,
+            const Core::Assets::AssetsVolumeCookDetail::AssetVolumeCookerWorkers& shaderWorkers,
+            Core::Assets::ScratchArena& writeScratchArena
+        ){
+            return AssetsGraphicsCookDetail::AppendPreparedShaderBytecodeToManifest(
+                context.arena,
+                graphicsMetadata.shaderCook,
+                shaderWorkers.threadPool,
+                context.maxConcurrentShaderCompiles,
+                context.resolvedPaths.cacheDirectory,
+                context.configurationSafeName,
+                graphicsMetadata.preparedPlan.preparedEntries,
+                manifest,
+                seenVirtualPathHashes,
+                graphicsMetadata.shaderIndexRecords,
+                writeScratchArena
+            );
+        }
+    );
+    shaderCooker.outputs.push_back(s_ShaderBytecodeProduct);
+
+    Core::Assets::AssetsVolumeCookDetail::AssetVolumeManifestCooker& shaderIndexCooker = context.manifestCookers.emplace_back(
+        context.arena,
+        AStringView("graphics_shader_index"),
+        [&context, &graphicsMetadata](
+            Core::Assets::AssetsVolumeCookDetail::AssetVolumePackManifest& manifest,
+            Core::Assets::CookEntryPathHashSet& seenVirtualPathHashes,
+            const Core::Assets::AssetsVolumeCookDetail::AssetVolumeCookerWorkers&,
+            Core::Assets::ScratchArena&
+        ){
+            return AssetsGraphicsCookDetail::AppendShaderIndexToManifest(
+                context.arena,
+                graphicsMetadata.shaderIndexRecords,
+                manifest,
+                seenVirtualPathHashes
+            );
+        }
+    );
+    shaderIndexCooker.inputs.push_back(s_ShaderBytecodeProduct);
+    shaderIndexCooker.outputs.push_back(s_ShaderIndexProduct);
     return true;
 }
 
@@ -144,8 +144,12 @@ bool ParseMaterialBindSource(
     outEntry.reset();
 
     MaterialCookArena& arena = outEntry.source.get_allocator().arena();
-    Metascript::Document doc(arena);
-    if(!MaterialBindDetail::ParseMaterialBindDocument(bindFilePath, arena, doc))
+    MaterialCookString bindText{arena};
+    if(!MaterialBindDetail::ReadMaterialBindText(bindFilePath, bindText))
+        return false;
+
+    Metascript::CompactDocument doc(arena);
+    if(!MaterialBindDetail::ParseMaterialBindDocument(bindFilePath, AStringView(bindText), doc))
         return false;
 
     return MaterialBindDetail::ParseMaterialBindSource(bindFilePath, doc, arena, outEntry, scratchArena);
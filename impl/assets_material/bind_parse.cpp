@@ -26,15 +26,23 @@ namespace MaterialBindDetail{
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-bool ParseMaterialBindDocument(const Path& bindFilePath, MaterialCookArena& arena, Metascript::Document& outDoc){
-    CookString bindText{arena};
-    if(!ReadTextFile(bindFilePath, bindText)){
+bool ReadMaterialBindText(const Path& bindFilePath, CookString& outText){
+    outText.clear();
+    if(!ReadTextFile(bindFilePath, outText)){
         NWB_LOGGER_ERROR(NWB_TEXT("Failed to read Bind '{}'"), PathToString<tchar>(bindFilePath));
         return false;
     }
-    StripUtf8Bom(bindText);
+    StripUtf8Bom(outText);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 
-    if(!outDoc.parseWithImplicitAsset(AStringView(bindText), s_AssetTypeMaterialBind, s_AssetVariableMaterialBind)){
+template<typename MetadataDocument>
+static bool ParseMaterialBindDocumentText(const Path& bindFilePath, const AStringView bindText, MetadataDocument& outDoc){
+    if(!outDoc.parseWithImplicitAsset(bindText, s_AssetTypeMaterialBind, s_AssetVariableMaterialBind)){
         for(const Metascript::ParseError& err : outDoc.errors()){
             NWB_LOGGER_ERROR(NWB_TEXT("Bind '{}' parse error at {}:{}: {}")
                 , PathToString<tchar>(bindFilePath)
@@ -48,13 +56,22 @@ bool ParseMaterialBindDocument(const Path& bindFilePath, MaterialCookArena& aren
     return true;
 }
 
+bool ParseMaterialBindDocument(const Path& bindFilePath, const AStringView bindText, Metascript::Document& outDoc){
+    return ParseMaterialBindDocumentText(bindFilePath, bindText, outDoc);
+}
+
+bool ParseMaterialBindDocument(const Path& bindFilePath, const AStringView bindText, Metascript::CompactDocument& outDoc){
+    return ParseMaterialBindDocumentText(bindFilePath, bindText, outDoc);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-static const Metascript::Value* FindAssetMapValue(const Path& bindFilePath, const Metascript::Document& doc){
+template<typename MetadataValue, typename MetadataDocument>
+static const MetadataValue* FindAssetMapValue(const Path& bindFilePath, const MetadataDocument& doc){
     const Metascript::MStringView assetVariable = doc.assetVariable();
-    const Metascript::Value* asset = doc.findVariable(assetVariable);
+    const MetadataValue* asset = doc.findVariable(assetVariable);
     if(!asset){
         NWB_LOGGER_ERROR(NWB_TEXT("Material bind '{}': asset variable '{}' has no assignments")
             , PathToString<tchar>(bindFilePath)
@@ -199,16 +216,17 @@ bool ParseMaterialBindResourceFieldTypeText(
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+template<typename MetadataValue>
 static bool ParseMaterialBindStringField(
     const Path& bindFilePath,
-    const Metascript::Value& map,
+    const MetadataValue& map,
     const AStringView fieldName,
     const AStringView contextLabel,
     CookString& outValue
 ){
     outValue.clear();
 
-    const Metascript::Value* value = map.findField(fieldName);
+    const MetadataValue* value = map.findField(fieldName);
     if(!value || !value->isString()){
         NWB_LOGGER_ERROR(NWB_TEXT("Material bind '{}': {} field '{}' must be a string")
             , PathToString<tchar>(bindFilePath)
@@ -227,9 +245,10 @@ static bool ParseMaterialBindStringField(
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+template<typename MetadataValue>
 static bool ParseMaterialBindAttributeList(
     const Path& bindFilePath,
-    const Metascript::Value* attributesValue,
+    const MetadataValue* attributesValue,
     const AStringView contextLabel,
     MaterialCookArena& arena,
     MaterialCookVector<MaterialBindAttribute>& outAttributes
@@ -248,7 +267,7 @@ static bool ParseMaterialBindAttributeList(
 
     const auto& attributeList = attributesValue->asList();
     outAttributes.reserve(attributeList.size());
-    for(const Metascript::Value& attributeValue : attributeList){
+    for(const MetadataValue& attributeValue : attributeList){
         if(!attributeValue.isMap()){
             NWB_LOGGER_ERROR(NWB_TEXT("Material bind '{}': {} attribute entries must be maps")
                 , PathToString<tchar>(bindFilePath)
@@ -269,7 +288,7 @@ static bool ParseMaterialBindAttributeList(
             return false;
         }
 
-        const Metascript::Value* argumentsValue = attributeValue.findField("arguments");
+        const MetadataValue* argumentsValue = attributeValue.findField("arguments");
         if(argumentsValue){
             if(!argumentsValue->isList()){
                 NWB_LOGGER_ERROR(NWB_TEXT("Material bind '{}': attribute '{}' arguments must be a list")
@@ -281,7 +300,7 @@ static bool ParseMaterialBindAttributeList(
 
             const auto& argumentList = argumentsValue->asList();
             attribute.arguments.reserve(argumentList.size());
-            for(const Metascript::Value& argumentValue : argumentList){
+            for(const MetadataValue& argumentValue : argumentList){
                 if(!argumentValue.isString()){
                     NWB_LOGGER_ERROR(NWB_TEXT("Material bind '{}': attribute '{}' arguments must be strings")
                         , PathToString<tchar>(bindFilePath)
@@ -419,9 +438,10 @@ static bool ValidateMaterialBindFieldAttributes(const Path& bindFilePath, const
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+template<typename MetadataValue>
 static bool ParseMaterialBindField(
     const Path& bindFilePath,
-    const Metascript::Value& fieldValue,
+    const MetadataValue& fieldValue,
     const MaterialBindStruct& bindStruct,
     MaterialCookArena& arena,
     MaterialBindField& outField
@@ -481,10 +501,11 @@ static bool ParseMaterialBindField(
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+template<typename MetadataValue>
 static bool ParseMaterialBindStruct(
     const Path& bindFilePath,
     const Metascript::MStringView structName,
-    const Metascript::Value& structValue,
+    const MetadataValue& structValue,
     MaterialCookArena& arena,
     MaterialBindStruct& outStruct
 ){
@@ -509,7 +530,7 @@ static bool ParseMaterialBindStruct(
     if(!ValidateMaterialBindStructAttributes(bindFilePath, outStruct))
         return false;
 
-    const Metascript::Value* fieldsValue = structValue.findField("fields");
+    const MetadataValue* fieldsValue = structValue.findField("fields");
     if(!fieldsValue || !fieldsValue->isList()){
         NWB_LOGGER_ERROR(NWB_TEXT("Material bind '{}': struct '{}' fields must be a list")
             , PathToString<tchar>(bindFilePath)
@@ -526,7 +547,7 @@ static bool ParseMaterialBindStruct(
     }
 
     outStruct.fields.reserve(fieldsValue->asList().size());
-    for(const Metascript::Value& fieldValue : fieldsValue->asList()){
+    for(const MetadataValue& fieldValue : fieldsValue->asList()){
         MaterialBindField field(arena);
         if(!ParseMaterialBindField(bindFilePath, fieldValue, outStruct, arena, field))
             return false;
@@ -550,10 +571,11 @@ static bool ParseMaterialBindStruct(
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-static bool ParseMaterialBindStructs(const Path& bindFilePath, const Metascript::Value& asset, MaterialCookArena& arena, MaterialCookVector<MaterialBindStruct>& outStructs){
+template<typename MetadataValue>
+static bool ParseMaterialBindStructs(const Path& bindFilePath, const MetadataValue& asset, MaterialCookArena& arena, MaterialCookVector<MaterialBindStruct>& outStructs){
     outStructs.clear();
 
-    const Metascript::Value* structsValue = asset.findField("structs");
+    const MetadataValue* structsValue = asset.findField("structs");
     if(!structsValue || !structsValue->isMap()){
         NWB_LOGGER_ERROR(NWB_TEXT("Material bind '{}': asset.structs must be a map"), PathToString<tchar>(bindFilePath));
         return false;
@@ -583,10 +605,11 @@ static bool ParseMaterialBindStructs(const Path& bindFilePath, const Metascript:
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-static bool ParseMaterialBindInstances(const Path& bindFilePath, const Metascript::Value& asset, MaterialCookArena& arena, MaterialBindEntry& outEntry){
+template<typename MetadataValue>
+static bool ParseMaterialBindInstances(const Path& bindFilePath, const MetadataValue& asset, MaterialCookArena& arena, MaterialBindEntry& outEntry){
     outEntry.instances.clear();
 
-    const Metascript::Value* instancesValue = asset.findField("instances");
+    const MetadataValue* instancesValue = asset.findField("instances");
     if(!instancesValue || !instancesValue->isList()){
         NWB_LOGGER_ERROR(NWB_TEXT("Material bind '{}': asset.instances must be a list"), PathToString<tchar>(bindFilePath));
         return false;
@@ -597,7 +620,7 @@ static bool ParseMaterialBindInstances(const Path& bindFilePath, const Metascrip
     }
 
     outEntry.instances.reserve(instancesValue->asList().size());
-    for(const Metascript::Value& instanceValue : instancesValue->asList()){
+    for(const MetadataValue& instanceValue : instancesValue->asList()){
         if(!instanceValue.isMap()){
             NWB_LOGGER_ERROR(NWB_TEXT("Material bind '{}': asset.instances entries must be maps"), PathToString<tchar>(bindFilePath));
             return false;
@@ -641,9 +664,10 @@ static bool ParseMaterialBindInstances(const Path& bindFilePath, const Metascrip
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-bool ParseMaterialBindSource(
+template<typename MetadataValue, typename MetadataDocument>
+static bool ParseMaterialBindSourceDocument(
     const Path& bindFilePath,
-    const Metascript::Document& doc,
+    const MetadataDocument& doc,
     MaterialCookArena& arena,
     MaterialBindEntry& outEntry,
     ScratchArena& scratchArena
@@ -654,7 +678,7 @@ bool ParseMaterialBindSource(
     if(!ValidatePairedSourceExtension(bindFilePath, outEntry.source, scratchArena))
         return false;
 
-    const Metascript::Value* assetValue = FindAssetMapValue(bindFilePath, doc);
+    const MetadataValue* assetValue = FindAssetMapValue<MetadataValue>(bindFilePath, doc);
     if(!assetValue)
         return false;
     if(!Core::Assets::ValidateMetadataAssetFields(bindFilePath, *assetValue, "Material bind", { "structs", "instances" }))
@@ -668,6 +692,26 @@ bool ParseMaterialBindSource(
     return true;
 }
 
+bool ParseMaterialBindSource(
+    const Path& bindFilePath,
+    const Metascript::Document& doc,
+    MaterialCookArena& arena,
+    MaterialBindEntry& outEntry,
+    ScratchArena& scratchArena
+){
+    return ParseMaterialBindSourceDocument<Metascript::Value>(bindFilePath, doc, arena, outEntry, scratchArena);
+}
+
+bool ParseMaterialBindSource(
+    const Path& bindFilePath,
+    const Metascript::CompactDocument& doc,
+    MaterialCookArena& arena,
+    MaterialBindEntry& outEntry,
+    ScratchArena& scratchArena
+){
+    return ParseMaterialBindSourceDocument<Metascript::CompactValue>(bindFilePath, doc, arena, outEntry, scratchArena);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -16,7 +16,7 @@
 
 #include <core/alloc/scratch.h>
 #include <core/assets/paths.h>
-#include <core/metascript/parser.h>
+#include <core/metascript/compact_document.h>
 
 #include <core/common/log.h>
 #include <global/hash_utils.h>
@@ -102,7 +102,12 @@ static constexpr AStringView s_DefaultAttribute = "default";
 
 // Cross-TU helper declarations (definitions de-static'd in their domain .cpp).
 
-bool ParseMaterialBindDocument(const Path& bindFilePath, MaterialCookArena& arena, Metascript::Document& outDoc);
+bool ReadMaterialBindText(const Path& bindFilePath, CookString& outText);
+
+// The cook parses binds into a CompactDocument, which keeps views into bindText: the text must outlive the document.
+// The Document overloads run the same reader over the mutable DOM and exist for A/B checks against it.
+bool ParseMaterialBindDocument(const Path& bindFilePath, AStringView bindText, Metascript::Document& outDoc);
+bool ParseMaterialBindDocument(const Path& bindFilePath, AStringView bindText, Metascript::CompactDocument& outDoc);
 
 bool ParseMaterialParameterTypeText(
     const AStringView typeText,
@@ -122,6 +127,13 @@ bool ParseMaterialBindSource(
     MaterialBindEntry& outEntry,
     ScratchArena& scratchArena
 );
+bool ParseMaterialBindSource(
+    const Path& bindFilePath,
+    const Metascript::CompactDocument& doc,
+    MaterialCookArena& arena,
+    MaterialBindEntry& outEntry,
+    ScratchArena& scratchArena
+);
 
 bool ApplyMaterialBindTypedLayoutParameterValue(
     const MaterialBindTypedLayout& layout,
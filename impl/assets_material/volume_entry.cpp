@@ -57,7 +57,8 @@ static bool RegisterMaterialCookEntry(Core::Assets::CookEntryRegistry& registry)
         &ParseMaterialDocument,
         nullptr,
         &BuildMaterialCookedAsset,
-        false
+        false,
+        false // Cooked materials embed resolved shader and texture state, so their .nwb alone does not key the output.
     );
 }
 
@@ -85,6 +85,8 @@ public:
 
 
     public:
+        // The volume writer calls this from several cook threads at once, one request per variant; implementations
+        // must not share mutable state between calls.
         virtual bool compileVariant(const ShaderCompilerRequest& request, CookVector<u8>& outBytecode) = 0;
 
 
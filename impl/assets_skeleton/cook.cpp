@@ -176,6 +176,19 @@ static constexpr AStringView s_SkeletonJointMetaKind = "Skeleton joint meta";
 
         SkeletonJoint joint;
         joint.localBindPose = cookJoint.localBindPose;
+        if(!MatrixIsInvertibleAffine(
+            LoadFloat(joint.localBindPose),
+            s_SkeletonJointAffineEpsilon,
+            s_SkeletonJointDeterminantEpsilon
+        )){
+            NWB_LOGGER_ERROR(NWB_TEXT("Skeleton meta '{}': joint '{}' local bind pose is not an invertible affine matrix")
+                , StringConvert(skeletonEntry.virtualPath.c_str())
+                , StringConvert(cookJoint.name.c_str())
+            );
+            outJoints.clear();
+            outJointIndices.clear();
+            return false;
+        }
         if(!ResolveParentIndex(skeletonEntry, jointIndex, cookJoint.parent, joint.parentIndex)){
             outJoints.clear();
             outJointIndices.clear();
@@ -25,6 +25,10 @@ static_assert(IsTriviallyCopyable_V<SkeletonJointMatrix>, "SkeletonJointMatrix m
 static_assert(sizeof(SkeletonJointMatrix) == sizeof(f32) * s_SkeletonJointMatrixFloatCount, "SkeletonJointMatrix GPU layout drifted");
 static_assert(alignof(SkeletonJointMatrix) >= alignof(Float4), "SkeletonJointMatrix must stay SIMD-aligned");
 
+// Joint matrices below these tolerances are rejected at cook time, so runtime palette evaluation can skip the check.
+inline constexpr f32 s_SkeletonJointAffineEpsilon = 0.000001f;
+inline constexpr f32 s_SkeletonJointDeterminantEpsilon = 0.000000000001f;
+
 NWB_IMPL_END
 
 
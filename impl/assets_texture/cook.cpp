@@ -732,7 +732,8 @@ bool ParseTextureCookMetadata(
     if(!ValidateTextureDataFileName(nwbFilePath, dataFileName, scratchArena))
         return false;
 
-    Path dataPath(nwbFilePath.parent_path());
+    Path& dataPath = outEntry.dataPath;
+    dataPath = nwbFilePath.parent_path();
     dataPath /= dataFileName;
     ErrorCode errorCode;
     if(!ReadBinaryFile(dataPath, outEntry.payloadBytes, errorCode)){
@@ -41,10 +41,12 @@ struct TextureCookEntry{
 
     Texture::MipLevelVector mipLevels;
     Core::Assets::AssetBytes payloadBytes;
+    Path dataPath;
 
     explicit TextureCookEntry(Core::Assets::AssetArena& arena)
         : mipLevels(arena)
         , payloadBytes(arena)
+        , dataPath(arena)
     {}
 };
 
@@ -36,14 +36,18 @@ static bool ParseTextureDocument(
     TextureCookEntry& outEntry,
     Core::Assets::CookEntryParseContext& context
 ){
-    return ParseTextureCookMetadata(
+    if(!ParseTextureCookMetadata(
         assetRoot,
         virtualRoot,
         nwbFilePath,
         doc,
         outEntry,
         context.scratchArena
-    );
+    ))
+        return false;
+
+    Core::Assets::RecordCookInputDependency(context, outEntry.dataPath);
+    return true;
 }
 
 static bool BuildTextureCookedAsset(TextureCookEntry& entry, Texture& outAsset){
@@ -0,0 +1,58 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "../global.h"
+
+#include <core/assets/ref.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class AnimationClip;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+inline constexpr u32 s_AnimationPlayerMaxLayerCount = 4u;
+
+// `time` is in seconds and advances by delta * speed every update. Looping layers wrap at the clip duration; other
+// layers clamp to [0, duration].
+struct AnimationLayer{
+    Core::Assets::AssetRef<AnimationClip> clip;
+    f32 time = 0.0f;
+    f32 speed = 1.0f;
+    f32 weight = 1.0f;
+    bool loop = true;
+};
+
+// Sits next to a SkeletonPoseComponent and overwrites its local joints every update. Layers are blended by their
+// normalized weights; joints without a track in any playing clip keep the bind pose of the clip's skeleton.
+struct AnimationPlayerComponent{
+    AnimationLayer layers[s_AnimationPlayerMaxLayerCount];
+    u32 layerCount = 0u;
+};
+
+static_assert(IsStandardLayout_V<AnimationPlayerComponent>, "AnimationPlayerComponent must stay layout-stable for ECS storage");
+static_assert(IsTriviallyCopyable_V<AnimationPlayerComponent>, "AnimationPlayerComponent must stay cheap to move in dense ECS storage");
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
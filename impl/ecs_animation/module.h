@@ -0,0 +1,13 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "components.h"
+#include "system.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
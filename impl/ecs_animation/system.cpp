@@ -0,0 +1,495 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "system.h"
+
+#include <core/assets/manager.h>
+#include <core/common/log.h>
+#include <core/ecs/world.h>
+#include <impl/assets_animation/asset.h>
+#include <impl/assets_animation/compression.h>
+#include <impl/assets_skeleton/asset.h>
+#include <impl/ecs_skeleton/components.h>
+#include <global/simdmath.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_animation_system{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static constexpr usize s_ParallelAnimationPlayerGrainSize = 16u;
+// Joints are sampled in chunks so every SoA stream of one chunk stays on the stack and in L1.
+static constexpr usize s_JointChunkSize = 64u;
+
+namespace AssetPollResult{
+    enum Enum : u8{
+        Waiting,
+        Loaded,
+        Failed,
+    };
+};
+
+AssetPollResult::Enum PollAssetLoad(
+    Core::Assets::AssetManager& assetManager,
+    const u64 requestId,
+    const Name& assetType,
+    const Name& virtualPath,
+    UniquePtr<Core::Assets::IAsset>& outAsset
+){
+    Core::Assets::AssetLoadResult result;
+    if(!assetManager.tryPopResult(requestId, result))
+        return AssetPollResult::Waiting;
+
+    if(!result.success || !result.asset){
+        NWB_LOGGER_ERROR(NWB_TEXT("AnimationSystem: failed to load {} '{}'")
+            , StringConvert(assetType.c_str())
+            , StringConvert(virtualPath.c_str())
+        );
+        return AssetPollResult::Failed;
+    }
+    if(result.asset->assetType() != assetType){
+        NWB_LOGGER_ERROR(NWB_TEXT("AnimationSystem: asset '{}' is not a {}")
+            , StringConvert(virtualPath.c_str())
+            , StringConvert(assetType.c_str())
+        );
+        return AssetPollResult::Failed;
+    }
+
+    outAsset = Move(result.asset);
+    return AssetPollResult::Loaded;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+struct QuaternionChunk{
+    alignas(32) f32 x[s_JointChunkSize];
+    alignas(32) f32 y[s_JointChunkSize];
+    alignas(32) f32 z[s_JointChunkSize];
+    alignas(32) f32 w[s_JointChunkSize];
+
+    [[nodiscard]] QuaternionBatch::Stream stream(){ return { x, y, z, w }; }
+
+    void clear(const usize count){
+        for(usize i = 0u; i < count; ++i){
+            x[i] = 0.0f;
+            y[i] = 0.0f;
+            z[i] = 0.0f;
+            w[i] = 0.0f;
+        }
+    }
+
+    void set(const usize index, const Float4& value){
+        x[index] = value.x;
+        y[index] = value.y;
+        z[index] = value.z;
+        w[index] = value.w;
+    }
+};
+
+struct VectorChunk{
+    alignas(32) f32 x[s_JointChunkSize];
+    alignas(32) f32 y[s_JointChunkSize];
+    alignas(32) f32 z[s_JointChunkSize];
+
+    void clear(const usize count){
+        for(usize i = 0u; i < count; ++i){
+            x[i] = 0.0f;
+            y[i] = 0.0f;
+            z[i] = 0.0f;
+        }
+    }
+
+    void accumulate(const usize index, const Float3U& value, const f32 weight){
+        x[index] += weight * value.x;
+        y[index] += weight * value.y;
+        z[index] += weight * value.z;
+    }
+};
+
+struct ActiveLayer{
+    const AnimationClip* clip = nullptr;
+    const Vector<u32, Core::Alloc::GlobalArena>* jointTracks = nullptr;
+    const Vector<Float4, Core::Alloc::GlobalArena>* bindRotations = nullptr;
+    const Vector<Float3U, Core::Alloc::GlobalArena>* bindTranslations = nullptr;
+    const Vector<Float3U, Core::Alloc::GlobalArena>* bindScales = nullptr;
+    f32 frame = 0.0f;
+    f32 weight = 0.0f;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+void AdvanceLayerTime(AnimationLayer& layer, const f32 duration, const f32 delta){
+    layer.time += delta * layer.speed;
+    if(!IsFinite(layer.time) || !(duration > 0.0f)){
+        layer.time = 0.0f;
+        return;
+    }
+
+    if(layer.loop)
+        layer.time -= Floor(layer.time / duration) * duration;
+    else
+        layer.time = Min(Max(layer.time, 0.0f), duration);
+}
+
+void DecodeRotationPair(
+    const AnimationClip& clip,
+    const AnimationKeyRange& range,
+    const Float4& bindRotation,
+    const f32 frame,
+    Float4& outFrom,
+    Float4& outTo,
+    f32& outFactor
+){
+    if(range.keyCount == 0u){
+        outFrom = bindRotation;
+        outTo = bindRotation;
+        outFactor = 0.0f;
+        return;
+    }
+
+    const AnimationRotationKey* keys = clip.rotationKeys().data() + range.firstKey;
+    u32 lower = 0u;
+    u32 upper = 0u;
+    AnimationClipCompression::FindKeyPair(keys, range.keyCount, frame, lower, upper, outFactor);
+    outFrom = AnimationClipCompression::UnpackRotation(keys[lower].packed);
+    outTo = AnimationClipCompression::UnpackRotation(keys[upper].packed);
+}
+
+[[nodiscard]] Float3U SampleVector(
+    const AnimationClip::VectorKeyVector& keyStream,
+    const AnimationKeyRange& range,
+    const AnimationVectorRange& quantization,
+    const Float3U& bindValue,
+    const f32 frame
+){
+    if(range.keyCount == 0u)
+        return bindValue;
+
+    const AnimationVectorKey* keys = keyStream.data() + range.firstKey;
+    u32 lower = 0u;
+    u32 upper = 0u;
+    f32 factor = 0.0f;
+    AnimationClipCompression::FindKeyPair(keys, range.keyCount, frame, lower, upper, factor);
+    const Float3U from = AnimationClipCompression::DequantizeVector(keys[lower], quantization);
+    if(lower == upper)
+        return from;
+
+    const Float3U to = AnimationClipCompression::DequantizeVector(keys[upper], quantization);
+    return Float3U(
+        from.x + factor * (to.x - from.x),
+        from.y + factor * (to.y - from.y),
+        from.z + factor * (to.z - from.z)
+    );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+AnimationSystem::AnimationSystem(Core::Alloc::GlobalArena& arena, Core::ECS::World& world, Core::Assets::AssetManager& assetManager)
+    : Core::ECS::ISystem(arena)
+    , m_arena(arena)
+    , m_world(world)
+    , m_assetManager(assetManager)
+    , m_clipLoads(0, Hasher<Name>(), EqualTo<Name>(), arena)
+{
+    writeAccess<AnimationPlayerComponent>();
+    writeAccess<SkeletonPoseComponent>();
+}
+
+void AnimationSystem::prepare(Core::ECS::World& world){
+    static_cast<void>(world);
+
+    m_assetManager.processPending(m_loadBudget);
+    requestClipLoads();
+    pollClipLoads();
+}
+
+void AnimationSystem::syncClipLoads(){
+    requestClipLoads();
+    for(;;){
+        m_assetManager.processPending();
+        pollClipLoads();
+        if(!hasClipLoadsInFlight())
+            break;
+
+        YieldThread();
+    }
+}
+
+void AnimationSystem::update(Core::ECS::World& world, const f32 delta){
+    static_cast<void>(world);
+
+    // Layer times advance on every visit, and the stamped poses are what SkeletonPaletteSystem re-evaluates.
+    const auto playerView = m_world.view<AnimationPlayerComponent, SkeletonPoseComponent>()
+        .write<AnimationPlayerComponent, SkeletonPoseComponent>()
+    ;
+    playerView.parallelEach(
+        m_world.taskPool(),
+        __hidden_animation_system::s_ParallelAnimationPlayerGrainSize,
+        [&](const Core::ECS::EntityID entity, AnimationPlayerComponent& player, SkeletonPoseComponent& pose){
+            static_cast<void>(entity);
+            samplePlayer(player, pose, delta);
+        }
+    );
+}
+
+bool AnimationSystem::clipReady(const Name clipName)const{
+    const auto found = m_clipLoads.find(clipName);
+    return found != m_clipLoads.end() && found.value().state == AnimationClipLoadState::Ready;
+}
+
+void AnimationSystem::requestClipLoads(){
+    m_world.view<AnimationPlayerComponent>().each(
+        [&](const Core::ECS::EntityID entity, AnimationPlayerComponent& player){
+            static_cast<void>(entity);
+
+            const u32 layerCount = Min(player.layerCount, s_AnimationPlayerMaxLayerCount);
+            for(u32 layerIndex = 0u; layerIndex < layerCount; ++layerIndex){
+                const Name clipName = player.layers[layerIndex].clip.name();
+                if(clipName)
+                    requestClipLoad(clipName);
+            }
+        }
+    );
+}
+
+void AnimationSystem::requestClipLoad(const Name clipName){
+    if(m_clipLoads.find(clipName) != m_clipLoads.end())
+        return;
+
+    ClipLoad load(m_arena);
+    load.clipRequestId = m_assetManager.enqueueLoad(AnimationClip::AssetTypeName(), clipName);
+    if(load.clipRequestId == 0u)
+        load.state = AnimationClipLoadState::Failed;
+    m_clipLoads.emplace(clipName, Move(load));
+}
+
+void AnimationSystem::pollClipLoads(){
+    using namespace __hidden_animation_system;
+
+    for(auto it = m_clipLoads.begin(); it != m_clipLoads.end(); ++it){
+        const Name& clipName = it.key();
+        ClipLoad& load = it.value();
+
+        if(load.state == AnimationClipLoadState::LoadingClip){
+            switch(PollAssetLoad(m_assetManager, load.clipRequestId, AnimationClip::AssetTypeName(), clipName, load.clip)){
+            case AssetPollResult::Waiting:
+                continue;
+            case AssetPollResult::Failed:
+                load.state = AnimationClipLoadState::Failed;
+                continue;
+            case AssetPollResult::Loaded:
+                break;
+            }
+
+            const Name skeletonName = checked_cast<const AnimationClip*>(load.clip.get())->skeleton().name();
+            load.skeletonRequestId = m_assetManager.enqueueLoad(Skeleton::AssetTypeName(), skeletonName);
+            load.state = load.skeletonRequestId != 0u ? AnimationClipLoadState::LoadingSkeleton : AnimationClipLoadState::Failed;
+        }
+
+        if(load.state == AnimationClipLoadState::LoadingSkeleton){
+            const Name skeletonName = checked_cast<const AnimationClip*>(load.clip.get())->skeleton().name();
+            switch(PollAssetLoad(m_assetManager, load.skeletonRequestId, Skeleton::AssetTypeName(), skeletonName, load.skeleton)){
+            case AssetPollResult::Waiting:
+                continue;
+            case AssetPollResult::Failed:
+                load.state = AnimationClipLoadState::Failed;
+                continue;
+            case AssetPollResult::Loaded:
+                break;
+            }
+
+            load.state = buildClipBinding(clipName, load) ? AnimationClipLoadState::Ready : AnimationClipLoadState::Failed;
+        }
+    }
+}
+
+bool AnimationSystem::hasClipLoadsInFlight()const{
+    for(const auto& [clipName, load] : m_clipLoads){
+        static_cast<void>(clipName);
+        if(load.state == AnimationClipLoadState::LoadingClip || load.state == AnimationClipLoadState::LoadingSkeleton)
+            return true;
+    }
+    return false;
+}
+
+bool AnimationSystem::buildClipBinding(const Name clipName, ClipLoad& load){
+    const AnimationClip& clip = *checked_cast<const AnimationClip*>(load.clip.get());
+    const Skeleton& skeleton = *checked_cast<const Skeleton*>(load.skeleton.get());
+    ClipBinding& binding = load.binding;
+
+    const u32 jointCount = skeleton.jointCount();
+    binding.jointTracks.assign(jointCount, s_AnimationClipInvalidTrackIndex);
+    binding.bindRotations.resize(jointCount);
+    binding.bindTranslations.resize(jointCount);
+    binding.bindScales.resize(jointCount);
+    for(u32 jointIndex = 0u; jointIndex < jointCount; ++jointIndex){
+        SIMDVector scale;
+        SIMDVector rotation;
+        SIMDVector translation;
+        if(!MatrixDecompose(&scale, &rotation, &translation, LoadFloat(skeleton.joints()[jointIndex].localBindPose))){
+            NWB_LOGGER_ERROR(NWB_TEXT("AnimationSystem: clip '{}' skeleton joint {} has a bind pose that cannot be decomposed")
+                , StringConvert(clipName.c_str())
+                , jointIndex
+            );
+            return false;
+        }
+
+        StoreFloat(rotation, &binding.bindRotations[jointIndex]);
+        StoreFloat(translation, &binding.bindTranslations[jointIndex]);
+        StoreFloat(scale, &binding.bindScales[jointIndex]);
+    }
+
+    for(usize trackIndex = 0u; trackIndex < clip.tracks().size(); ++trackIndex){
+        const Name jointName = clip.tracks()[trackIndex].joint;
+        const u32 jointIndex = skeleton.findJointIndex(jointName);
+        if(jointIndex >= jointCount){
+            NWB_LOGGER_ERROR(NWB_TEXT("AnimationSystem: clip '{}' animates joint '{}' that skeleton '{}' does not have")
+                , StringConvert(clipName.c_str())
+                , StringConvert(jointName.c_str())
+                , StringConvert(skeleton.virtualPath().c_str())
+            );
+            return false;
+        }
+        binding.jointTracks[jointIndex] = static_cast<u32>(trackIndex);
+    }
+    return true;
+}
+
+void AnimationSystem::samplePlayer(AnimationPlayerComponent& player, SkeletonPoseComponent& pose, const f32 delta)const{
+    using namespace __hidden_animation_system;
+
+    const usize jointCount = pose.localJoints.size();
+    ActiveLayer activeLayers[s_AnimationPlayerMaxLayerCount];
+    u32 activeLayerCount = 0u;
+    f32 totalWeight = 0.0f;
+
+    const u32 layerCount = Min(player.layerCount, s_AnimationPlayerMaxLayerCount);
+    for(u32 layerIndex = 0u; layerIndex < layerCount; ++layerIndex){
+        AnimationLayer& layer = player.layers[layerIndex];
+        const auto found = m_clipLoads.find(layer.clip.name());
+        if(found == m_clipLoads.end() || found.value().state != AnimationClipLoadState::Ready)
+            continue;
+
+        const ClipLoad& load = found.value();
+        const AnimationClip& clip = *checked_cast<const AnimationClip*>(load.clip.get());
+        AdvanceLayerTime(layer, clip.duration(), delta);
+        if(load.binding.jointTracks.size() != jointCount || !IsFinite(layer.weight) || !(layer.weight > 0.0f))
+            continue;
+
+        ActiveLayer& active = activeLayers[activeLayerCount++];
+        active.clip = &clip;
+        active.jointTracks = &load.binding.jointTracks;
+        active.bindRotations = &load.binding.bindRotations;
+        active.bindTranslations = &load.binding.bindTranslations;
+        active.bindScales = &load.binding.bindScales;
+        active.frame = Min(layer.time * clip.frameRate(), static_cast<f32>(clip.frameCount() - 1u));
+        active.weight = layer.weight;
+        totalWeight += layer.weight;
+    }
+    if(activeLayerCount == 0u || !(totalWeight > 0.0f))
+        return;
+
+    const f32 inverseTotalWeight = 1.0f / totalWeight;
+    QuaternionChunk from;
+    QuaternionChunk to;
+    QuaternionChunk sampled;
+    QuaternionChunk rotations;
+    VectorChunk translations;
+    VectorChunk scales;
+    alignas(32) f32 factors[s_JointChunkSize];
+
+    for(usize chunkBase = 0u; chunkBase < jointCount; chunkBase += s_JointChunkSize){
+        const usize chunkCount = Min(s_JointChunkSize, jointCount - chunkBase);
+        rotations.clear(chunkCount);
+        translations.clear(chunkCount);
+        scales.clear(chunkCount);
+
+        for(u32 layerIndex = 0u; layerIndex < activeLayerCount; ++layerIndex){
+            const ActiveLayer& layer = activeLayers[layerIndex];
+            const AnimationClip& clip = *layer.clip;
+            const f32 weight = layer.weight * inverseTotalWeight;
+
+            for(usize chunkIndex = 0u; chunkIndex < chunkCount; ++chunkIndex){
+                const usize jointIndex = chunkBase + chunkIndex;
+                const u32 trackIndex = (*layer.jointTracks)[jointIndex];
+                const Float4& bindRotation = (*layer.bindRotations)[jointIndex];
+                const Float3U& bindTranslation = (*layer.bindTranslations)[jointIndex];
+                const Float3U& bindScale = (*layer.bindScales)[jointIndex];
+                if(trackIndex == s_AnimationClipInvalidTrackIndex){
+                    from.set(chunkIndex, bindRotation);
+                    to.set(chunkIndex, bindRotation);
+                    factors[chunkIndex] = 0.0f;
+                    translations.accumulate(chunkIndex, bindTranslation, weight);
+                    scales.accumulate(chunkIndex, bindScale, weight);
+                    continue;
+                }
+
+                const AnimationClipTrack& track = clip.tracks()[trackIndex];
+                Float4 fromRotation;
+                Float4 toRotation;
+                DecodeRotationPair(clip, track.rotation, bindRotation, layer.frame, fromRotation, toRotation, factors[chunkIndex]);
+                from.set(chunkIndex, fromRotation);
+                to.set(chunkIndex, toRotation);
+                translations.accumulate(
+                    chunkIndex,
+                    SampleVector(clip.translationKeys(), track.translation, track.translationRange, bindTranslation, layer.frame),
+                    weight
+                );
+                scales.accumulate(
+                    chunkIndex,
+                    SampleVector(clip.scaleKeys(), track.scale, track.scaleRange, bindScale, layer.frame),
+                    weight
+                );
+            }
+
+            QuaternionBatch::Nlerp(from.stream(), to.stream(), factors, chunkCount, sampled.stream());
+            QuaternionBatch::AccumulateWeighted(sampled.stream(), weight, chunkCount, rotations.stream());
+        }
+
+        QuaternionBatch::Normalize(rotations.stream(), chunkCount);
+        for(usize chunkIndex = 0u; chunkIndex < chunkCount; ++chunkIndex){
+            const SIMDMatrix joint = MatrixAffineTransformation(
+                VectorSet(scales.x[chunkIndex], scales.y[chunkIndex], scales.z[chunkIndex], 0.0f),
+                VectorZero(),
+                VectorSet(rotations.x[chunkIndex], rotations.y[chunkIndex], rotations.z[chunkIndex], rotations.w[chunkIndex]),
+                VectorSet(translations.x[chunkIndex], translations.y[chunkIndex], translations.z[chunkIndex], 0.0f)
+            );
+            StoreFloat(joint, &pose.localJoints[chunkBase + chunkIndex]);
+        }
+    }
+    ++pose.revision;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,146 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "components.h"
+
+#include <core/assets/module.h>
+#include <core/ecs/system.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class AssetManager;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_ASSETS_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class Skeleton;
+struct SkeletonPoseComponent;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace AnimationClipLoadState{
+    enum Enum : u8{
+        LoadingClip,
+        LoadingSkeleton,
+        Ready,
+        Failed,
+    };
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Samples AnimationPlayerComponent layers into SkeletonPoseComponent::localJoints. Clips and their skeletons load
+// through the asset manager in prepare(); update() decodes and blends every ready player in parallel, walking joints
+// in fixed-size structure-of-arrays chunks so quaternion interpolation and blending run on SIMD lanes.
+class AnimationSystem final : public Core::ECS::ISystem{
+private:
+    // Per-clip sampling data resolved against the clip's skeleton. Joint streams are indexed by skeleton joint;
+    // bind-pose components fill the channels a clip does not animate.
+    struct ClipBinding{
+        explicit ClipBinding(Core::Alloc::GlobalArena& arena)
+            : jointTracks(arena)
+            , bindRotations(arena)
+            , bindTranslations(arena)
+            , bindScales(arena)
+        {}
+
+        Vector<u32, Core::Alloc::GlobalArena> jointTracks;
+        Vector<Float4, Core::Alloc::GlobalArena> bindRotations;
+        Vector<Float3U, Core::Alloc::GlobalArena> bindTranslations;
+        Vector<Float3U, Core::Alloc::GlobalArena> bindScales;
+    };
+
+    struct ClipLoad{
+        explicit ClipLoad(Core::Alloc::GlobalArena& arena)
+            : binding(arena)
+        {}
+
+        u64 clipRequestId = 0u;
+        u64 skeletonRequestId = 0u;
+        AnimationClipLoadState::Enum state = AnimationClipLoadState::LoadingClip;
+        UniquePtr<Core::Assets::IAsset> clip;
+        UniquePtr<Core::Assets::IAsset> skeleton;
+        ClipBinding binding;
+    };
+
+    using ClipLoadMap = HashMap<Name, ClipLoad, Hasher<Name>, EqualTo<Name>, Core::Alloc::GlobalArena>;
+
+
+public:
+    static constexpr u32 s_DefaultLoadBudget = 8u;
+
+
+public:
+    AnimationSystem(Core::Alloc::GlobalArena& arena, Core::ECS::World& world, Core::Assets::AssetManager& assetManager);
+    virtual ~AnimationSystem()override = default;
+
+
+public:
+    virtual void prepare(Core::ECS::World& world)override;
+    virtual void update(Core::ECS::World& world, f32 delta)override;
+    // Blocks until every clip referenced by an AnimationPlayerComponent is ready or failed.
+    void syncClipLoads();
+
+    // Pending asset requests processed on the calling thread per prepare() when the asset manager has no async
+    // executor.
+    void setLoadBudget(u32 loadBudget){ m_loadBudget = loadBudget; }
+    [[nodiscard]] u32 loadBudget()const{ return m_loadBudget; }
+
+    [[nodiscard]] bool clipReady(Name clipName)const;
+
+
+private:
+    void requestClipLoads();
+    void requestClipLoad(Name clipName);
+    void pollClipLoads();
+    [[nodiscard]] bool hasClipLoadsInFlight()const;
+    [[nodiscard]] bool buildClipBinding(Name clipName, ClipLoad& load);
+    void samplePlayer(AnimationPlayerComponent& player, SkeletonPoseComponent& pose, f32 delta)const;
+
+
+private:
+    Core::Alloc::GlobalArena& m_arena;
+    Core::ECS::World& m_world;
+    Core::Assets::AssetManager& m_assetManager;
+    ClipLoadMap m_clipLoads;
+    u32 m_loadBudget = s_DefaultLoadBudget;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -9,6 +9,7 @@
 
 #include <impl/assets/graphics/skinned_mesh/constants.h>
 #include <impl/assets_mesh/skin_validation.h>
+#include <impl/ecs_skeleton/joint_palette.h>
 #include <impl/ecs_skeleton/runtime_helpers.h>
 #include <core/alloc/scratch.h>
 #include <core/common/log.h>
@@ -213,15 +214,27 @@ template<typename SkinInfluenceVector, typename JointPaletteVector>
 
 // The render pass uses this shared helper twice: first while declaring graph-owned joint-palette upload blobs and
 // again while recording the legacy compute work that consumes them.  Keeping pose resolution here prevents those
-// two phases from drifting apart.
+// two phases from drifting apart.  A pose palette evaluated for the current pose revision is used as-is; otherwise
+// the pose is resolved here.
 [[nodiscard]] inline bool BuildRuntimeSkinPayload(
     MeshSkinningRuntimeInstance& instance,
     const SkeletonJointPaletteComponent* jointPalette,
     const SkeletonPoseComponent* skeletonPose,
+    const SkeletonPosePaletteComponent* posePalette,
     RuntimeSkinPayloadScratch& payload
 ){
     payload.resolvedSkinningMode = jointPalette ? jointPalette->skinningMode : SkeletonSkinningMode::LinearBlend;
     if(SkeletonRuntime::HasSkeletonPose(skeletonPose)){
+        if(SkeletonRuntime::SkeletonPosePaletteCurrent(*skeletonPose, posePalette)){
+            payload.resolvedSkinningMode = posePalette->skinningMode;
+            return BuildSkinPayloadFromJointMatrices(
+                instance,
+                posePalette->joints,
+                payload.resolvedSkinningMode,
+                payload.skinInfluences,
+                payload.jointMatrices
+            );
+        }
         if(!SkeletonRuntime::BuildStoredJointPaletteFromSkeletonPose(*skeletonPose, payload.poseJoints, payload.resolvedSkinningMode)){
             NWB_LOGGER_ERROR(NWB_TEXT("MeshSkinningSystem: runtime mesh '{}' skeleton pose is invalid"), instance.handle.value);
             return false;
@@ -32,11 +32,12 @@ NWB_IMPL_BEGIN
 bool MeshSkinningSystem::prepareRuntimeMeshResources(
     MeshSkinningRuntimeInstance& instance,
     const SkeletonJointPaletteComponent* jointPalette,
-    const SkeletonPoseComponent* skeletonPose
+    const SkeletonPoseComponent* skeletonPose,
+    const SkeletonPosePaletteComponent* posePalette
 ){
     Core::Alloc::ScratchArena scratchArena(SkinningArenaScope::s_PrepareRuntimeArena);
     RuntimeSkinPayloadScratch payload{ scratchArena };
-    if(!MeshSkinningPayload::BuildRuntimeSkinPayload(instance, jointPalette, skeletonPose, payload))
+    if(!MeshSkinningPayload::BuildRuntimeSkinPayload(instance, jointPalette, skeletonPose, posePalette, payload))
         return false;
 
     const bool hasActiveSkin = payload.hasActiveSkin();
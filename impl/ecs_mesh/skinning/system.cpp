@@ -57,11 +57,13 @@ static void ResolveSkeletonComponents(
     const Core::ECS::EntityID fallbackEntity,
     const Core::ECS::EntityID skeletonEntity,
     const SkeletonJointPaletteComponent*& outJointPalette,
-    const SkeletonPoseComponent*& outSkeletonPose
+    const SkeletonPoseComponent*& outSkeletonPose,
+    const SkeletonPosePaletteComponent*& outPosePalette
 ){
     const Core::ECS::EntityID resolvedEntity = skeletonEntity.valid() ? skeletonEntity : fallbackEntity;
     outJointPalette = world.tryGetComponent<SkeletonJointPaletteComponent>(resolvedEntity);
     outSkeletonPose = world.tryGetComponent<SkeletonPoseComponent>(resolvedEntity);
+    outPosePalette = world.tryGetComponent<SkeletonPosePaletteComponent>(resolvedEntity);
 }
 
 static constexpr bool s_RuntimeSkinningMeshletFrustumCullingEnabled = true;
@@ -354,6 +356,7 @@ MeshSkinningSystem::MeshSkinningSystem(
     writeAccess<SkinnedMeshBindingComponent>();
     readAccess<SkeletonJointPaletteComponent>();
     readAccess<SkeletonPoseComponent>();
+    readAccess<SkeletonPosePaletteComponent>();
 
     m_runtimeMeshRegistry.registerRuntimeMeshProvider(*this);
 }
@@ -407,8 +410,9 @@ bool MeshSkinningSystem::prepareResources(Core::Framebuffer* framebuffer){
 
             const SkeletonJointPaletteComponent* jointPalette = nullptr;
             const SkeletonPoseComponent* skeletonPose = nullptr;
-            __hidden_system::ResolveSkeletonComponents(m_world, entity, binding.skeletonEntity, jointPalette, skeletonPose);
-            ready = prepareRuntimeMeshResources(*instance, jointPalette, skeletonPose);
+            const SkeletonPosePaletteComponent* posePalette = nullptr;
+            __hidden_system::ResolveSkeletonComponents(m_world, entity, binding.skeletonEntity, jointPalette, skeletonPose, posePalette);
+            ready = prepareRuntimeMeshResources(*instance, jointPalette, skeletonPose, posePalette);
             const auto foundResources = m_runtimeResources.find(instance->handle.value);
             const bool hasSkinningResources = foundResources != m_runtimeResources.end() && foundResources.value().usesSkinning();
             hasRenderWork =
@@ -550,7 +554,8 @@ bool MeshSkinningSystem::submitFrameSkinningGraph(){
 
             const SkeletonJointPaletteComponent* jointPalette = nullptr;
             const SkeletonPoseComponent* skeletonPose = nullptr;
-            __hidden_system::ResolveSkeletonComponents(m_world, entity, binding.skeletonEntity, jointPalette, skeletonPose);
+            const SkeletonPosePaletteComponent* posePalette = nullptr;
+            __hidden_system::ResolveSkeletonComponents(m_world, entity, binding.skeletonEntity, jointPalette, skeletonPose, posePalette);
             const auto foundResources = m_runtimeResources.find(instance->handle.value);
             const bool hadSkinningResources = foundResources != m_runtimeResources.end() && foundResources.value().usesSkinning();
             if(!__hidden_system::HasPotentialSkinningWork(*instance, jointPalette, skeletonPose) && !hadSkinningResources)
@@ -559,7 +564,7 @@ bool MeshSkinningSystem::submitFrameSkinningGraph(){
             RuntimeSkinPayloadScratch payload{ scratchArena };
             // Preserve the direct path's per-mesh retry semantics: an invalid pose never prevents another ready
             // mesh from declaring its immutable packet plan.
-            if(!MeshSkinningPayload::BuildRuntimeSkinPayload(*instance, jointPalette, skeletonPose, payload))
+            if(!MeshSkinningPayload::BuildRuntimeSkinPayload(*instance, jointPalette, skeletonPose, posePalette, payload))
                 return;
 
             const bool hasActiveSkin = payload.hasActiveSkin();
@@ -314,7 +314,8 @@ private:
     [[nodiscard]] bool prepareRuntimeMeshResources(
         MeshSkinningRuntimeInstance& instance,
         const SkeletonJointPaletteComponent* jointPalette,
-        const SkeletonPoseComponent* skeletonPose
+        const SkeletonPoseComponent* skeletonPose,
+        const SkeletonPosePaletteComponent* posePalette
     );
     [[nodiscard]] bool recordGraphOwnedSkinningDeformation(
         const GraphOwnedSkinningDispatchPlan& plan,
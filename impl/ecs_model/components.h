@@ -63,6 +63,21 @@ static_assert(IsTriviallyCopyable_V<ModelRuntimeComponent>, "ModelRuntimeCompone
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// Present while the owner's model and skeleton assets are loading asynchronously or while the owner waits for a spawn
+// slot. `failed` keeps a model that could not be loaded or expanded from being requested again every frame; changing
+// ModelComponent::model clears it.
+struct ModelPendingSpawnComponent{
+    Name model = NAME_NONE;
+    bool failed = false;
+};
+
+static_assert(IsStandardLayout_V<ModelPendingSpawnComponent>, "ModelPendingSpawnComponent must stay layout-stable for ECS storage");
+static_assert(IsTriviallyCopyable_V<ModelPendingSpawnComponent>, "ModelPendingSpawnComponent must stay cheap to move in dense ECS storage");
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 struct ModelObjectComponent{
     Name model = NAME_NONE;
     Name object = NAME_NONE;
@@ -89,12 +104,15 @@ static_assert(IsTriviallyCopyable_V<ModelSkeletonComponent>, "ModelSkeletonCompo
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// The mesh follows its parent through TransformParentComponent. Joint attachments fold the joint matrix into the node's
+// local transform, which ModelSystem refreshes only when the parent pose revision moves past poseRevision.
 struct ModelStaticMeshAttachmentComponent{
     Name parentObject = NAME_NONE;
     Name parentJoint = NAME_NONE;
     Core::ECS::EntityID parentEntity = Core::ECS::ENTITY_ID_INVALID;
     u32 parentJointIndex = Limit<u32>::s_Max;
     SkeletonJointMatrix localTransform = ::Float34Identity();
+    u64 poseRevision = Limit<u64>::s_Max;
 };
 
 static_assert(IsStandardLayout_V<ModelStaticMeshAttachmentComponent>, "ModelStaticMeshAttachmentComponent must stay layout-stable for ECS storage");
@@ -13,6 +13,7 @@
 #include <impl/ecs_mesh/components.h>
 #include <impl/ecs_scene/components.h>
 #include <impl/ecs_skeleton/components.h>
+#include <impl/ecs_skeleton/joint_palette.h>
 #include <impl/ecs_skeleton/runtime_helpers.h>
 
 
@@ -31,7 +32,18 @@ namespace __hidden_model_system{
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-static constexpr usize s_ParallelModelObjectTransformGrainSize = 256u;
+[[nodiscard]] bool StoreDecomposedTransform(const SIMDMatrix& matrix, Scene::TransformComponent& transform){
+    SIMDVector scale;
+    SIMDVector rotation;
+    SIMDVector translation;
+    if(!MatrixDecompose(&scale, &rotation, &translation, matrix))
+        return false;
+
+    StoreFloat(VectorSetW(translation, 0.0f), &transform.position);
+    StoreFloat(rotation, &transform.rotation);
+    StoreFloat(VectorSetW(scale, 0.0f), &transform.scale);
+    return true;
+}
 
 void StoreObjectWorldTransform(
     Core::ECS::World& world,
@@ -50,15 +62,17 @@ void StoreObjectWorldTransform(
         : MatrixIdentity()
     ;
 
-    SIMDVector scale;
-    SIMDVector rotation;
-    SIMDVector translation;
-    if(!MatrixDecompose(&scale, &rotation, &translation, MatrixMultiply(ownerMatrix, LoadFloat(localTransform))))
-        return;
+    static_cast<void>(StoreDecomposedTransform(MatrixMultiply(ownerMatrix, LoadFloat(localTransform)), transform));
+}
 
-    StoreFloat(VectorSetW(translation, 0.0f), &transform.position);
-    StoreFloat(rotation, &transform.rotation);
-    StoreFloat(VectorSetW(scale, 0.0f), &transform.scale);
+// Parents a spawned object in the transform hierarchy so TransformHierarchySystem keeps its TransformComponent in step
+// with the parent. The TransformComponent written at spawn only covers the frames before the hierarchy first runs.
+void AttachObjectNode(Core::ECS::Entity& entity, const Core::ECS::EntityID parent, const SkeletonJointMatrix& localTransform){
+    auto& node = entity.addComponent<Scene::TransformParentComponent>();
+    node.parent = parent;
+    node.dirty = true;
+    static_cast<void>(StoreDecomposedTransform(LoadFloat(localTransform), node.local));
+    entity.addComponent<Scene::WorldTransformComponent>();
 }
 
 void TagObject(
@@ -77,32 +91,42 @@ void TagObject(
     objectComponent.kind = kind;
 }
 
-bool LoadSkeleton(
+namespace AssetPollResult{
+    enum Enum : u8{
+        Waiting,
+        Loaded,
+        Failed,
+    };
+};
+
+AssetPollResult::Enum PollAssetLoad(
     Core::Assets::AssetManager& assetManager,
-    const Core::Assets::AssetRef<Skeleton>& skeletonRef,
-    UniquePtr<Core::Assets::IAsset>& outAsset,
-    const Skeleton*& outSkeleton
+    const u64 requestId,
+    const Name& assetType,
+    const Name& virtualPath,
+    UniquePtr<Core::Assets::IAsset>& outAsset
 ){
-    outAsset.reset();
-    outSkeleton = nullptr;
-
-    const Name skeletonName = skeletonRef.name();
-    if(!skeletonName)
-        return false;
-
-    if(!assetManager.loadSync(Skeleton::AssetTypeName(), skeletonName, outAsset)){
-        NWB_LOGGER_ERROR(NWB_TEXT("ModelSystem: failed to load skeleton '{}'"), StringConvert(skeletonName.c_str()));
-        return false;
+    Core::Assets::AssetLoadResult result;
+    if(!assetManager.tryPopResult(requestId, result))
+        return AssetPollResult::Waiting;
+
+    if(!result.success || !result.asset){
+        NWB_LOGGER_ERROR(NWB_TEXT("ModelSystem: failed to load {} '{}'")
+            , StringConvert(assetType.c_str())
+            , StringConvert(virtualPath.c_str())
+        );
+        return AssetPollResult::Failed;
     }
-    if(!outAsset || outAsset->assetType() != Skeleton::AssetTypeName()){
-        NWB_LOGGER_ERROR(NWB_TEXT("ModelSystem: asset '{}' is not a skeleton"), StringConvert(skeletonName.c_str()));
-        outAsset.reset();
-        return false;
+    if(result.asset->assetType() != assetType){
+        NWB_LOGGER_ERROR(NWB_TEXT("ModelSystem: asset '{}' is not a {}")
+            , StringConvert(virtualPath.c_str())
+            , StringConvert(assetType.c_str())
+        );
+        return AssetPollResult::Failed;
     }
 
-    outSkeleton = checked_cast<const Skeleton*>(outAsset.get());
-    NWB_ASSERT(outSkeleton != nullptr);
-    return true;
+    outAsset = Move(result.asset);
+    return AssetPollResult::Loaded;
 }
 
 
@@ -115,6 +139,15 @@ bool LoadSkeleton(
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+const Skeleton* ModelSystem::ModelLoad::findSkeleton(const Name skeletonName)const{
+    for(const SkeletonLoad& load : skeletons){
+        if(load.skeleton == skeletonName)
+            return load.asset ? checked_cast<const Skeleton*>(load.asset.get()) : nullptr;
+    }
+    return nullptr;
+}
+
+
 ModelSystem::ModelSystem(
     Core::Alloc::GlobalArena& arena,
     Core::ECS::World& world,
@@ -126,17 +159,21 @@ ModelSystem::ModelSystem(
     , m_assetManager(assetManager)
     , m_applyRenderer(Move(rendererHooks.apply))
     , m_scratchEntities(arena)
+    , m_scratchSpawnEntities(arena)
     , m_scratchJoints(arena)
+    , m_modelLoads(0, Hasher<Name>(), EqualTo<Name>(), arena)
 {
     readAccess<ModelComponent>();
     writeAccess<ModelRuntimeComponent>();
+    writeAccess<ModelPendingSpawnComponent>();
     writeAccess<ModelObjectComponent>();
     writeAccess<ModelSkeletonComponent>();
     writeAccess<ModelStaticMeshAttachmentComponent>();
     writeAccess<MeshComponent>();
     writeAccess<SkinnedMeshBindingComponent>();
-    writeAccess<Scene::TransformComponent>();
+    writeAccess<Scene::TransformParentComponent>();
     writeAccess<SkeletonPoseComponent>();
+    readAccess<SkeletonPosePaletteComponent>();
 
     if(rendererHooks.accesses){
         for(usize i = 0u; i < rendererHooks.accessCount; ++i)
@@ -147,10 +184,41 @@ ModelSystem::ModelSystem(
 void ModelSystem::prepare(Core::ECS::World& world){
     static_cast<void>(world);
 
-    syncModelRuntimes();
+    m_assetManager.processPending(m_loadBudget);
+    advanceModelRuntimes(m_spawnBudget);
 }
 
 void ModelSystem::syncModelRuntimes(){
+    for(;;){
+        m_assetManager.processPending();
+        advanceModelRuntimes(Limit<u32>::s_Max);
+        if(!hasModelLoadsInFlight())
+            break;
+
+        YieldThread();
+    }
+}
+
+void ModelSystem::update(Core::ECS::World& world, const f32 delta){
+    static_cast<void>(world);
+    static_cast<void>(delta);
+
+    updateStaticMeshAttachments();
+}
+
+usize ModelSystem::pendingSpawnCount()const{
+    usize pendingCount = 0u;
+    m_world.view<ModelPendingSpawnComponent>().each(
+        [&](const Core::ECS::EntityID entity, ModelPendingSpawnComponent& pending){
+            static_cast<void>(entity);
+            if(!pending.failed)
+                ++pendingCount;
+        }
+    );
+    return pendingCount;
+}
+
+void ModelSystem::advanceModelRuntimes(const u32 spawnBudget){
     clearInvalidSpawnedObjects();
     clearRuntimeObjectsWithoutModel();
 
@@ -159,14 +227,9 @@ void ModelSystem::syncModelRuntimes(){
             ensureModelRuntime(entity, component);
         }
     );
-}
 
-void ModelSystem::update(Core::ECS::World& world, const f32 delta){
-    static_cast<void>(world);
-    static_cast<void>(delta);
-
-    updateModelObjectTransforms();
-    updateStaticMeshAttachments();
+    pollModelLoads();
+    spawnReadyModels(spawnBudget);
 }
 
 void ModelSystem::clearInvalidSpawnedObjects(){
@@ -196,37 +259,43 @@ void ModelSystem::clearRuntimeObjectsWithoutModel(){
         clearModelRuntime(entity);
         m_world.entity(entity).removeComponent<ModelRuntimeComponent>();
     }
+
+    m_scratchEntities.clear();
+    m_world.view<ModelPendingSpawnComponent>().each(
+        [&](const Core::ECS::EntityID entity, ModelPendingSpawnComponent& pending){
+            static_cast<void>(pending);
+            if(!m_world.tryGetComponent<ModelComponent>(entity))
+                m_scratchEntities.push_back(entity);
+        }
+    );
+
+    for(const Core::ECS::EntityID entity : m_scratchEntities)
+        m_world.entity(entity).removeComponent<ModelPendingSpawnComponent>();
 }
 
 void ModelSystem::ensureModelRuntime(const Core::ECS::EntityID entity, const ModelComponent& component){
     if(!component.model.valid()){
         clearModelRuntime(entity);
         m_world.entity(entity).removeComponent<ModelRuntimeComponent>();
+        m_world.entity(entity).removeComponent<ModelPendingSpawnComponent>();
         return;
     }
 
+    const Name modelName = component.model.name();
     auto& runtime = m_world.entity(entity).addComponent<ModelRuntimeComponent>();
-    if(runtime.model == component.model.name())
+    if(runtime.model == modelName)
         return;
 
-    clearModelRuntime(entity);
-
-    UniquePtr<Core::Assets::IAsset> loadedAsset;
-    const Name modelName = component.model.name();
-    if(!m_assetManager.loadSync(Model::AssetTypeName(), modelName, loadedAsset)){
-        NWB_LOGGER_ERROR(NWB_TEXT("ModelSystem: failed to load model '{}'"), StringConvert(modelName.c_str()));
-        runtime = ModelRuntimeComponent{};
-        return;
-    }
-    if(!loadedAsset || loadedAsset->assetType() != Model::AssetTypeName()){
-        NWB_LOGGER_ERROR(NWB_TEXT("ModelSystem: asset '{}' is not a model"), StringConvert(modelName.c_str()));
-        runtime = ModelRuntimeComponent{};
+    const ModelPendingSpawnComponent* pending = m_world.tryGetComponent<ModelPendingSpawnComponent>(entity);
+    if(pending && pending->model == modelName)
         return;
-    }
 
-    const Model& model = *checked_cast<const Model*>(loadedAsset.get());
-    if(!expandModel(entity, model, runtime))
-        clearModelRuntime(entity);
+    clearModelRuntime(entity);
+
+    auto& pendingSpawn = m_world.entity(entity).addComponent<ModelPendingSpawnComponent>();
+    pendingSpawn.model = modelName;
+    pendingSpawn.failed = false;
+    requestModelLoad(modelName);
 }
 
 void ModelSystem::clearModelRuntime(const Core::ECS::EntityID entity){
@@ -245,9 +314,158 @@ void ModelSystem::clearModelRuntime(const Core::ECS::EntityID entity){
         *runtime = ModelRuntimeComponent{};
 }
 
+void ModelSystem::requestModelLoad(const Name modelName){
+    if(m_modelLoads.find(modelName) != m_modelLoads.end())
+        return;
+
+    ModelLoad load(m_arena);
+    load.requestId = m_assetManager.enqueueLoad(Model::AssetTypeName(), modelName);
+    if(load.requestId == 0u)
+        load.state = ModelAssetLoadState::Failed;
+    m_modelLoads.emplace(modelName, Move(load));
+}
+
+void ModelSystem::pollModelLoads(){
+    for(auto it = m_modelLoads.begin(); it != m_modelLoads.end(); ++it){
+        const Name& modelName = it.key();
+        ModelLoad& load = it.value();
+
+        if(load.state == ModelAssetLoadState::LoadingModel){
+            switch(__hidden_model_system::PollAssetLoad(m_assetManager, load.requestId, Model::AssetTypeName(), modelName, load.asset)){
+            case __hidden_model_system::AssetPollResult::Waiting:
+                continue;
+            case __hidden_model_system::AssetPollResult::Failed:
+                load.state = ModelAssetLoadState::Failed;
+                continue;
+            case __hidden_model_system::AssetPollResult::Loaded:
+                break;
+            }
+
+            // Every skeleton object is requested up front so the owner can be expanded in one step once resident.
+            const Model& model = *checked_cast<const Model*>(load.asset.get());
+            for(const ModelSkeletonObject& object : model.skeletonObjects()){
+                const Name skeletonName = object.skeleton.name();
+                if(!skeletonName)
+                    continue;
+
+                bool requested = false;
+                for(const SkeletonLoad& skeletonLoad : load.skeletons)
+                    requested = requested || skeletonLoad.skeleton == skeletonName;
+                if(requested)
+                    continue;
+
+                SkeletonLoad skeletonLoad;
+                skeletonLoad.skeleton = skeletonName;
+                skeletonLoad.requestId = m_assetManager.enqueueLoad(Skeleton::AssetTypeName(), skeletonName);
+                skeletonLoad.failed = skeletonLoad.requestId == 0u;
+                load.skeletons.push_back(Move(skeletonLoad));
+            }
+            load.state = ModelAssetLoadState::LoadingSkeletons;
+        }
+
+        if(load.state == ModelAssetLoadState::LoadingSkeletons){
+            bool waiting = false;
+            for(SkeletonLoad& skeletonLoad : load.skeletons){
+                if(skeletonLoad.asset || skeletonLoad.failed)
+                    continue;
+
+                switch(__hidden_model_system::PollAssetLoad(
+                    m_assetManager,
+                    skeletonLoad.requestId,
+                    Skeleton::AssetTypeName(),
+                    skeletonLoad.skeleton,
+                    skeletonLoad.asset
+                )){
+                case __hidden_model_system::AssetPollResult::Waiting:
+                    waiting = true;
+                    break;
+                case __hidden_model_system::AssetPollResult::Failed:
+                    skeletonLoad.failed = true;
+                    break;
+                case __hidden_model_system::AssetPollResult::Loaded:
+                    break;
+                }
+            }
+            if(!waiting)
+                load.state = ModelAssetLoadState::Ready;
+        }
+    }
+}
+
+bool ModelSystem::hasModelLoadsInFlight()const{
+    for(const auto& [modelName, load] : m_modelLoads){
+        static_cast<void>(modelName);
+        if(load.state == ModelAssetLoadState::LoadingModel || load.state == ModelAssetLoadState::LoadingSkeletons)
+            return true;
+    }
+    return false;
+}
+
+void ModelSystem::spawnReadyModels(const u32 spawnBudget){
+    for(auto it = m_modelLoads.begin(); it != m_modelLoads.end(); ++it)
+        it.value().waiters = 0u;
+
+    m_scratchSpawnEntities.clear();
+    m_world.view<ModelPendingSpawnComponent>().each(
+        [&](const Core::ECS::EntityID entity, ModelPendingSpawnComponent& pending){
+            if(pending.failed)
+                return;
+
+            auto found = m_modelLoads.find(pending.model);
+            if(found == m_modelLoads.end())
+                return;
+
+            ModelLoad& load = found.value();
+            ++load.waiters;
+            if(load.state != ModelAssetLoadState::Ready && load.state != ModelAssetLoadState::Failed)
+                return;
+            if(m_scratchSpawnEntities.size() < spawnBudget)
+                m_scratchSpawnEntities.push_back(entity);
+        }
+    );
+
+    for(const Core::ECS::EntityID entity : m_scratchSpawnEntities){
+        auto found = m_modelLoads.find(m_world.entity(entity).getComponent<ModelPendingSpawnComponent>().model);
+        NWB_ASSERT(found != m_modelLoads.end());
+
+        ModelLoad& load = found.value();
+        NWB_ASSERT(load.waiters > 0u);
+        --load.waiters;
+        finishModelSpawn(entity, load);
+    }
+
+    for(auto it = m_modelLoads.begin(); it != m_modelLoads.end();){
+        const ModelLoad& load = it.value();
+        const bool settled = load.state == ModelAssetLoadState::Ready || load.state == ModelAssetLoadState::Failed;
+        if(settled && load.waiters == 0u)
+            it = m_modelLoads.erase(it);
+        else
+            ++it;
+    }
+}
+
+void ModelSystem::finishModelSpawn(const Core::ECS::EntityID owner, ModelLoad& load){
+    auto& runtime = m_world.entity(owner).addComponent<ModelRuntimeComponent>();
+    if(load.state == ModelAssetLoadState::Failed){
+        runtime = ModelRuntimeComponent{};
+        m_world.entity(owner).getComponent<ModelPendingSpawnComponent>().failed = true;
+        return;
+    }
+
+    const Model& model = *checked_cast<const Model*>(load.asset.get());
+    if(!expandModel(owner, model, load, runtime)){
+        clearModelRuntime(owner);
+        m_world.entity(owner).getComponent<ModelPendingSpawnComponent>().failed = true;
+        return;
+    }
+
+    m_world.entity(owner).removeComponent<ModelPendingSpawnComponent>();
+}
+
 bool ModelSystem::expandModel(
     const Core::ECS::EntityID owner,
     const Model& model,
+    const ModelLoad& load,
     ModelRuntimeComponent& runtime
 ){
     runtime.model = model.virtualPath();
@@ -255,13 +473,13 @@ bool ModelSystem::expandModel(
 
     bool complete = true;
     for(const ModelSkeletonObject& object : model.skeletonObjects()){
-        if(spawnSkeletonObject(owner, object))
+        if(spawnSkeletonObject(owner, object, load.findSkeleton(object.skeleton.name())))
             ++runtime.objectCount;
         else
             complete = false;
     }
     for(const ModelStaticMeshObject& object : model.staticMeshObjects()){
-        if(spawnStaticMeshObject(owner, object))
+        if(spawnStaticMeshObject(owner, object, load))
             ++runtime.objectCount;
         else
             complete = false;
@@ -276,10 +494,9 @@ bool ModelSystem::expandModel(
     return complete;
 }
 
-bool ModelSystem::spawnSkeletonObject(const Core::ECS::EntityID owner, const ModelSkeletonObject& object){
-    UniquePtr<Core::Assets::IAsset> loadedAsset;
-    const Skeleton* skeleton = nullptr;
-    if(!__hidden_model_system::LoadSkeleton(m_assetManager, object.skeleton, loadedAsset, skeleton))
+bool ModelSystem::spawnSkeletonObject(const Core::ECS::EntityID owner, const ModelSkeletonObject& object, const Skeleton* skeleton){
+    // Load failures were already reported while polling.
+    if(!skeleton)
         return false;
 
     Core::ECS::Entity entity = m_world.createEntity();
@@ -293,6 +510,7 @@ bool ModelSystem::spawnSkeletonObject(const Core::ECS::EntityID owner, const Mod
     );
     auto& transform = entity.addComponent<Scene::TransformComponent>();
     __hidden_model_system::StoreObjectWorldTransform(m_world, owner, object.transform, transform);
+    __hidden_model_system::AttachObjectNode(entity, owner, object.transform);
 
     auto& pose = entity.addComponent<SkeletonPoseComponent>(m_arena);
     pose.parentJoints.clear();
@@ -303,6 +521,7 @@ bool ModelSystem::spawnSkeletonObject(const Core::ECS::EntityID owner, const Mod
         pose.parentJoints.push_back(joint.parentIndex);
         pose.localJoints.push_back(joint.localBindPose);
     }
+    ++pose.revision;
 
     auto& skeletonComponent = entity.addComponent<ModelSkeletonComponent>();
     skeletonComponent.skeleton = object.skeleton;
@@ -310,7 +529,7 @@ bool ModelSystem::spawnSkeletonObject(const Core::ECS::EntityID owner, const Mod
     return true;
 }
 
-bool ModelSystem::spawnStaticMeshObject(const Core::ECS::EntityID owner, const ModelStaticMeshObject& object){
+bool ModelSystem::spawnStaticMeshObject(const Core::ECS::EntityID owner, const ModelStaticMeshObject& object, const ModelLoad& load){
     Core::ECS::Entity entity = m_world.createEntity();
     __hidden_model_system::TagObject(
         entity,
@@ -322,6 +541,7 @@ bool ModelSystem::spawnStaticMeshObject(const Core::ECS::EntityID owner, const M
     );
     auto& transform = entity.addComponent<Scene::TransformComponent>();
     __hidden_model_system::StoreObjectWorldTransform(m_world, owner, object.transform, transform);
+    __hidden_model_system::AttachObjectNode(entity, owner, object.transform);
     if(m_applyRenderer)
         m_applyRenderer(m_world, m_arena, entity, owner, object.material);
 
@@ -350,6 +570,7 @@ bool ModelSystem::spawnStaticMeshObject(const Core::ECS::EntityID owner, const M
             );
             return false;
         }
+        entity.getComponent<Scene::TransformParentComponent>().parent = attachment.parentEntity;
 
         const ModelSkeletonComponent* skeletonComponent = m_world.tryGetComponent<ModelSkeletonComponent>(attachment.parentEntity);
         if(!skeletonComponent){
@@ -361,9 +582,8 @@ bool ModelSystem::spawnStaticMeshObject(const Core::ECS::EntityID owner, const M
         }
 
         if(object.parentJoint){
-            UniquePtr<Core::Assets::IAsset> loadedAsset;
-            const Skeleton* skeleton = nullptr;
-            if(!__hidden_model_system::LoadSkeleton(m_assetManager, skeletonComponent->skeleton, loadedAsset, skeleton))
+            const Skeleton* skeleton = load.findSkeleton(skeletonComponent->skeleton.name());
+            if(!skeleton)
                 return false;
 
             attachment.parentJointIndex = skeleton->findJointIndex(object.parentJoint);
@@ -401,6 +621,7 @@ bool ModelSystem::spawnSkinnedMeshObject(const Core::ECS::EntityID owner, const
     );
     auto& transform = entity.addComponent<Scene::TransformComponent>();
     __hidden_model_system::StoreObjectWorldTransform(m_world, owner, object.transform, transform);
+    __hidden_model_system::AttachObjectNode(entity, owner, object.transform);
     if(m_applyRenderer)
         m_applyRenderer(m_world, m_arena, entity, owner, object.material);
 
@@ -411,76 +632,38 @@ bool ModelSystem::spawnSkinnedMeshObject(const Core::ECS::EntityID owner, const
     return true;
 }
 
-void ModelSystem::updateModelObjectTransforms(){
-    m_world.view<ModelObjectComponent, Scene::TransformComponent>().parallelEach(
-        m_world.taskPool(),
-        __hidden_model_system::s_ParallelModelObjectTransformGrainSize,
-        [&](const Core::ECS::EntityID entity, ModelObjectComponent& object, Scene::TransformComponent& transform){
+void ModelSystem::updateStaticMeshAttachments(){
+    // Other attachments follow their parent node without any work here; joint attachments only need their node's
+    // local transform refreshed when the parent pose changes.
+    m_world.view<ModelStaticMeshAttachmentComponent, Scene::TransformParentComponent>().each(
+        [&](const Core::ECS::EntityID entity, ModelStaticMeshAttachmentComponent& attachment, Scene::TransformParentComponent& node){
             static_cast<void>(entity);
-            if(object.kind == ModelObjectKind::StaticMesh)
+            if(!attachment.parentEntity.valid() || attachment.parentJointIndex == Limit<u32>::s_Max)
                 return;
 
-            __hidden_model_system::StoreObjectWorldTransform(m_world, object.owner, object.localTransform, transform);
-        }
-    );
-}
-
-void ModelSystem::updateStaticMeshAttachments(){
-    m_world.view<ModelObjectComponent, ModelStaticMeshAttachmentComponent, Scene::TransformComponent>().each(
-        [&](const Core::ECS::EntityID entity, ModelObjectComponent& object, ModelStaticMeshAttachmentComponent& attachment, Scene::TransformComponent& transform){
-            static_cast<void>(entity);
+            const SkeletonPoseComponent* pose = m_world.tryGetComponent<SkeletonPoseComponent>(attachment.parentEntity);
+            if(!pose || pose->revision == attachment.poseRevision)
+                return;
 
-            const Scene::TransformComponent* ownerTransform = m_world.tryGetComponent<Scene::TransformComponent>(object.owner);
-            const Scene::TransformComponent* parentTransform = attachment.parentEntity.valid()
-                ? m_world.tryGetComponent<Scene::TransformComponent>(attachment.parentEntity)
-                : ownerTransform;
-            const SIMDMatrix ownerMatrix = ownerTransform
-                ? MatrixAffineTransformation(
-                    LoadFloat(ownerTransform->scale),
-                    VectorZero(),
-                    LoadFloat(ownerTransform->rotation),
-                    LoadFloat(ownerTransform->position)
-                )
-                : MatrixIdentity()
+            const SkeletonPosePaletteComponent* posePalette =
+                m_world.tryGetComponent<SkeletonPosePaletteComponent>(attachment.parentEntity)
             ;
-            const SIMDMatrix parentMatrix = parentTransform
-                ? MatrixAffineTransformation(
-                    LoadFloat(parentTransform->scale),
-                    VectorZero(),
-                    LoadFloat(parentTransform->rotation),
-                    LoadFloat(parentTransform->position)
-                )
-                : ownerMatrix
-            ;
-            const SIMDMatrix localMatrix = LoadFloat(attachment.localTransform);
-
-            SIMDMatrix worldTransform{};
-            if(!attachment.parentEntity.valid() || attachment.parentJointIndex == Limit<u32>::s_Max){
-                worldTransform = MatrixMultiply(parentMatrix, localMatrix);
-            }
-            else{
-                const SkeletonPoseComponent* pose = m_world.tryGetComponent<SkeletonPoseComponent>(attachment.parentEntity);
-                if(!pose)
-                    return;
-
-                u32 skinningMode = SkeletonSkinningMode::LinearBlend;
-                if(!SkeletonRuntime::BuildStoredJointPaletteFromSkeletonPose(*pose, m_scratchJoints, skinningMode))
-                    return;
-
-                NWB_ASSERT(attachment.parentJointIndex < m_scratchJoints.size());
-                const SIMDMatrix jointMatrix = LoadFloat(m_scratchJoints[attachment.parentJointIndex]);
-                worldTransform = MatrixMultiply(MatrixMultiply(parentMatrix, jointMatrix), localMatrix);
-            }
+            const bool paletteCurrent = SkeletonRuntime::SkeletonPosePaletteCurrent(*pose, posePalette);
+            u32 skinningMode = SkeletonSkinningMode::LinearBlend;
+            if(!paletteCurrent && !SkeletonRuntime::BuildStoredJointPaletteFromSkeletonPose(*pose, m_scratchJoints, skinningMode))
+                return;
 
-            SIMDVector scale;
-            SIMDVector rotation;
-            SIMDVector translation;
-            if(!MatrixDecompose(&scale, &rotation, &translation, worldTransform))
+            const auto& joints = paletteCurrent ? posePalette->joints : m_scratchJoints;
+            NWB_ASSERT(attachment.parentJointIndex < joints.size());
+            const SIMDMatrix localMatrix = MatrixMultiply(
+                LoadFloat(joints[attachment.parentJointIndex]),
+                LoadFloat(attachment.localTransform)
+            );
+            if(!__hidden_model_system::StoreDecomposedTransform(localMatrix, node.local))
                 return;
 
-            StoreFloat(VectorSetW(translation, 0.0f), &transform.position);
-            StoreFloat(rotation, &transform.rotation);
-            StoreFloat(VectorSetW(scale, 0.0f), &transform.scale);
+            attachment.poseRevision = pose->revision;
+            node.dirty = true;
         }
     );
 }
@@ -7,6 +7,7 @@
 
 #include "components.h"
 
+#include <core/assets/module.h>
 #include <core/assets/ref.h>
 #include <core/ecs/system.h>
 
@@ -58,6 +59,7 @@ NWB_IMPL_BEGIN
 
 class Material;
 class Model;
+class Skeleton;
 struct ModelSkeletonObject;
 struct ModelStaticMeshObject;
 struct ModelSkinnedMeshObject;
@@ -81,10 +83,52 @@ struct ModelObjectRendererHooks{
 };
 
 
+namespace ModelAssetLoadState{
+    enum Enum : u8{
+        LoadingModel,
+        LoadingSkeletons,
+        Ready,
+        Failed,
+    };
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
 class ModelSystem final : public Core::ECS::ISystem{
+private:
+    struct SkeletonLoad{
+        Name skeleton = NAME_NONE;
+        u64 requestId = 0u;
+        bool failed = false;
+        UniquePtr<Core::Assets::IAsset> asset;
+    };
+
+    // One load record per model asset, shared by every owner that spawns it. Owners wait on the record through
+    // ModelPendingSpawnComponent; the record is dropped once it settles and no owner waits on it anymore.
+    struct ModelLoad{
+        explicit ModelLoad(Core::Alloc::GlobalArena& arena)
+            : skeletons(arena)
+        {}
+
+        [[nodiscard]] const Skeleton* findSkeleton(Name skeletonName)const;
+
+        u64 requestId = 0u;
+        u32 waiters = 0u;
+        ModelAssetLoadState::Enum state = ModelAssetLoadState::LoadingModel;
+        UniquePtr<Core::Assets::IAsset> asset;
+        Vector<SkeletonLoad, Core::Alloc::GlobalArena> skeletons;
+    };
+
+    using ModelLoadMap = HashMap<Name, ModelLoad, Hasher<Name>, EqualTo<Name>, Core::Alloc::GlobalArena>;
+
+
+public:
+    static constexpr u32 s_DefaultSpawnBudget = 32u;
+    static constexpr u32 s_DefaultLoadBudget = 8u;
+
+
 public:
     ModelSystem(
         Core::Alloc::GlobalArena& arena,
@@ -98,19 +142,36 @@ public:
 public:
     virtual void prepare(Core::ECS::World& world)override;
     virtual void update(Core::ECS::World& world, f32 delta)override;
+    // Blocks until every ModelComponent is expanded. Meant for scene setup; per-frame work goes through prepare(),
+    // which only polls loads and completes at most spawnBudget() owners.
     void syncModelRuntimes();
 
+    // Owners expanded per prepare(). Zero stalls spawning until the budget is raised again.
+    void setSpawnBudget(u32 spawnBudget){ m_spawnBudget = spawnBudget; }
+    [[nodiscard]] u32 spawnBudget()const{ return m_spawnBudget; }
+    // Pending asset requests processed on the calling thread per prepare() when the asset manager has no async
+    // executor. Requests already dispatched to an executor are unaffected.
+    void setLoadBudget(u32 loadBudget){ m_loadBudget = loadBudget; }
+    [[nodiscard]] u32 loadBudget()const{ return m_loadBudget; }
+
+    [[nodiscard]] usize pendingSpawnCount()const;
+
 
 private:
+    void advanceModelRuntimes(u32 spawnBudget);
     void clearInvalidSpawnedObjects();
     void clearRuntimeObjectsWithoutModel();
     void ensureModelRuntime(Core::ECS::EntityID entity, const ModelComponent& component);
     void clearModelRuntime(Core::ECS::EntityID entity);
-    [[nodiscard]] bool expandModel(Core::ECS::EntityID owner, const Model& model, ModelRuntimeComponent& runtime);
-    [[nodiscard]] bool spawnSkeletonObject(Core::ECS::EntityID owner, const ModelSkeletonObject& object);
-    [[nodiscard]] bool spawnStaticMeshObject(Core::ECS::EntityID owner, const ModelStaticMeshObject& object);
+    void requestModelLoad(Name modelName);
+    void pollModelLoads();
+    [[nodiscard]] bool hasModelLoadsInFlight()const;
+    void spawnReadyModels(u32 spawnBudget);
+    void finishModelSpawn(Core::ECS::EntityID owner, ModelLoad& load);
+    [[nodiscard]] bool expandModel(Core::ECS::EntityID owner, const Model& model, const ModelLoad& load, ModelRuntimeComponent& runtime);
+    [[nodiscard]] bool spawnSkeletonObject(Core::ECS::EntityID owner, const ModelSkeletonObject& object, const Skeleton* skeleton);
+    [[nodiscard]] bool spawnStaticMeshObject(Core::ECS::EntityID owner, const ModelStaticMeshObject& object, const ModelLoad& load);
     [[nodiscard]] bool spawnSkinnedMeshObject(Core::ECS::EntityID owner, const ModelSkinnedMeshObject& object);
-    void updateModelObjectTransforms();
     void updateStaticMeshAttachments();
     [[nodiscard]] Core::ECS::EntityID findSpawnedObject(Core::ECS::EntityID owner, Name objectName)const;
 
@@ -121,7 +182,11 @@ private:
     Core::Assets::AssetManager& m_assetManager;
     ModelObjectRendererCallback m_applyRenderer;
     Vector<Core::ECS::EntityID, Core::Alloc::GlobalArena> m_scratchEntities;
+    Vector<Core::ECS::EntityID, Core::Alloc::GlobalArena> m_scratchSpawnEntities;
     Vector<SkeletonJointMatrix, Core::Alloc::GlobalArena> m_scratchJoints;
+    ModelLoadMap m_modelLoads;
+    u32 m_spawnBudget = s_DefaultSpawnBudget;
+    u32 m_loadBudget = s_DefaultLoadBudget;
 };
 
 
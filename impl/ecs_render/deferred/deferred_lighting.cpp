@@ -96,7 +96,7 @@ bool RendererDeferredSystem::createDeferredLightingResources(){
     if(!deferredState().m_lightBuffer){
         Core::BufferDesc lightBufferDesc;
         lightBufferDesc
-            .setByteSize(static_cast<u64>(sizeof(ECSRenderDetail::SceneLightGpuData) * NWB_SCENE_MAX_LIGHTS))
+            .setByteSize(static_cast<u64>(sizeof(ECSRenderDetail::SceneLightGpuData) * NWB_SCENE_LIGHT_LIST_CAPACITY))
             .setStructStride(sizeof(ECSRenderDetail::SceneLightGpuData))
             .setDebugName(ECSRenderDetail::s_SceneLightBufferName)
             .setQueueSharing(Core::ResourceQueueSharing::GraphicsAndAsyncCompute)
@@ -109,6 +109,22 @@ bool RendererDeferredSystem::createDeferredLightingResources(){
         }
     }
 
+    if(!deferredState().m_lightClusterBuffer){
+        Core::BufferDesc lightClusterBufferDesc;
+        lightClusterBufferDesc
+            .setByteSize(static_cast<u64>(sizeof(u32) * NWB_SCENE_LIGHT_CLUSTER_WORD_CAPACITY))
+            .setStructStride(sizeof(u32))
+            .setDebugName(ECSRenderDetail::s_SceneLightClusterBufferName)
+            .setQueueSharing(Core::ResourceQueueSharing::GraphicsAndAsyncCompute)
+            .enableAutomaticStateTracking(Core::ResourceStates::Common)
+        ;
+        deferredState().m_lightClusterBuffer = graphics().createBuffer(lightClusterBufferDesc);
+        if(!deferredState().m_lightClusterBuffer){
+            NWB_LOGGER_ERROR(NWB_TEXT("RendererSystem: failed to create scene light cluster buffer"));
+            return false;
+        }
+    }
+
     if(!deferredState().m_lightingBindingLayout){
         Core::BindingLayoutDesc bindingLayoutDesc(arena());
         bindingLayoutDesc
@@ -191,51 +207,74 @@ Core::GpuTaskId RendererDeferredSystem::declareDeferredLightingTask(
 
 bool RendererDeferredSystem::prepareSceneShadingBufferUploads(
     const f32 fallbackAspectRatio,
-    ECSRenderDetail::SceneLightGpuData* const outLightData,
-    const usize lightDataCapacity,
+    const u32 viewportWidth,
+    const u32 viewportHeight,
+    const ECSRenderDetail::SceneLightGpuData*& outLightData,
     u32& outLightCount,
+    u64& outLightDataHash,
     bool& outLightUploadRequired,
+    const u32*& outLightClusterData,
+    u32& outLightClusterWordCount,
+    u64& outLightClusterDataHash,
+    bool& outLightClusterUploadRequired,
     ECSRenderDetail::SceneShadingGpuData& outSceneShadingState,
     bool& outSceneShadingUploadRequired
 ){
-    NWB_ASSERT(deferredState().m_sceneShadingBuffer);
-    NWB_ASSERT(deferredState().m_lightBuffer);
+    RendererDeferredState& state = deferredState();
+    NWB_ASSERT(state.m_sceneShadingBuffer);
+    NWB_ASSERT(state.m_lightBuffer);
+    NWB_ASSERT(state.m_lightClusterBuffer);
+    outLightData = nullptr;
     outLightCount = 0u;
+    outLightDataHash = 0u;
     outLightUploadRequired = false;
+    outLightClusterData = nullptr;
+    outLightClusterWordCount = 0u;
+    outLightClusterDataHash = 0u;
+    outLightClusterUploadRequired = false;
     outSceneShadingUploadRequired = false;
-    if(!outLightData || lightDataCapacity < NWB_SCENE_MAX_LIGHTS)
-        return false;
 
+    state.m_sceneLights.resize(NWB_SCENE_LIGHT_LIST_CAPACITY);
+    state.m_sceneLightImportance.resize(NWB_SCENE_LIGHT_LIST_CAPACITY);
+    state.m_lightGpuUploadData.resize(NWB_SCENE_LIGHT_LIST_CAPACITY);
+    ECSRenderDetail::SceneLightGpuData* const lightData = state.m_lightGpuUploadData.data();
+
+    const ECSRenderDetail::SceneLightView lightView = ECSRenderDetail::ResolveSceneLightView(world(), fallbackAspectRatio);
     f32 causticLightImportance[NWB_SCENE_MAX_LIGHTS];
     const u32 lightCount = ECSRenderDetail::ResolveSceneLights(
         world(),
-        outLightData,
+        lightView,
+        state.m_sceneLights.data(),
+        state.m_sceneLightImportance.data(),
+        lightData,
         causticLightImportance,
-        NWB_SCENE_MAX_LIGHTS
+        NWB_SCENE_LIGHT_LIST_CAPACITY
     );
+    // Shadow, caustic and GI producers only walk the ranked NWB_SCENE_MAX_LIGHTS prefix of the list.
+    const u32 perLightPassCount = (lightCount < NWB_SCENE_MAX_LIGHTS) ? lightCount : NWB_SCENE_MAX_LIGHTS;
 
     // Caustic-light classification: rank the opted-in directional/spot lights and assign a caustic slot into
     // each chosen light's params.w, gated on the scene holding at least one refractive instance (gathered earlier this
     // frame by prepareCausticEmissionTargets into the ray-tracing state).
     const u32 refractiveInstanceCount = rayTracingState().m_causticRefractiveInstanceCount;
     const u32 causticLightCount = ECSRenderDetail::ResolveCausticLights(
-        outLightData,
+        lightData,
         causticLightImportance,
-        lightCount,
+        perLightPassCount,
         refractiveInstanceCount
     );
     rayTracingState().m_causticLightCount = causticLightCount;
-    // Active shadow slots = the importance-ranked pool ResolveSceneLights filled (slots 0..min(lightCount,N)-1); the
-    // half-res shadow upsample reads this so it only reconstructs the slots that hold a light.
-    rayTracingState().m_shadowSlotCount = (lightCount < NWB_SCENE_SHADOW_SLOT_COUNT) ? lightCount : NWB_SCENE_SHADOW_SLOT_COUNT;
+    // Active shadow slots = the leading lights of the ranked list (slots 0..min(lightCount,N)-1); the half-res shadow
+    // upsample reads this so it only reconstructs the slots that hold a light.
+    const u32 shadowSlotCount = (lightCount < NWB_SCENE_SHADOW_SLOT_COUNT) ? lightCount : NWB_SCENE_SHADOW_SLOT_COUNT;
+    rayTracingState().m_shadowSlotCount = shadowSlotCount;
     // Soft opaque shadow (all light types): record which shadow slots hold a light (params.z >= 0), regardless of type.
     // The soft path traces + denoises + upsamples exactly these slots (once per set bit): a directional light softens by
     // its constant angular radius, a point/spot light by the distance-dependent cone its source sphere subtends -- both
-    // handled inside the trace, so every slot light is soft. A light can land on any slot index (the slot allocator
-    // ranks by importance, not type), so this is a scattered bitmask, not a contiguous range.
+    // handled inside the trace, so every slot light is soft.
     u32 softShadowSlotMask = 0u;
-    for(u32 i = 0u; i < lightCount; ++i){
-        const f32 slot = outLightData[i].params.z;
+    for(u32 i = 0u; i < shadowSlotCount; ++i){
+        const f32 slot = lightData[i].params.z;
         if(slot >= 0.f){
             const u32 slotIndex = static_cast<u32>(slot);
             if(slotIndex < NWB_SCENE_SHADOW_SLOT_COUNT)
@@ -243,25 +282,72 @@ bool RendererDeferredSystem::prepareSceneShadingBufferUploads(
         }
     }
     rayTracingState().m_softShadowSlotMask = softShadowSlotMask;
-    logCausticClassificationOnce(outLightData, lightCount, causticLightCount, refractiveInstanceCount);
+    logCausticClassificationOnce(lightData, perLightPassCount, causticLightCount, refractiveInstanceCount);
 
     const usize lightByteCount = static_cast<usize>(lightCount) * sizeof(ECSRenderDetail::SceneLightGpuData);
-    NWB_ASSERT(lightByteCount <= sizeof(deferredState().m_lightGpuData));
+    const u64 lightDataHash = lightByteCount != 0u ? ComputeWyHash64(lightData, lightByteCount) : 0u;
     const bool lightDataUnchanged =
-        deferredState().m_lightGpuDataValid
-        && deferredState().m_lightGpuDataCount == lightCount
-        && NWB_MEMCMP(deferredState().m_lightGpuData, outLightData, lightByteCount) == 0
+        state.m_lightGpuDataValid
+        && state.m_lightGpuDataCount == lightCount
+        && state.m_lightGpuDataHash == lightDataHash
     ;
     // A zero-light scene has no copyable payload. The graph still transitions the buffer for a later SRV use,
     // while acceptance records the empty CPU mirror below.
     outLightUploadRequired = !lightDataUnchanged && lightByteCount != 0u;
+    outLightData = lightData;
     outLightCount = lightCount;
+    outLightDataHash = lightDataHash;
+
+    // Cluster the whole ranked list for the deferred lighting viewport. The grid reuses the importance the gather
+    // already computed, so each light is scored once per frame.
+    u32 clusterWordCount = 0u;
+    if(
+        lightCount != 0u
+        && state.m_lightClusterGrid.build(
+            ECSRenderDetail::BuildSceneLightClusterDesc(viewportWidth, viewportHeight),
+            lightView.basis,
+            lightView.projection,
+            state.m_sceneLights.data(),
+            lightCount,
+            world().taskPool(),
+            state.m_sceneLightImportance.data()
+        )
+    ){
+        const Scene::LightClusterGrid& grid = state.m_lightClusterGrid;
+        usize packedWordCount = grid.clusterCount() * 2u + grid.directionalLights().size() + grid.assignmentCount();
+        if(packedWordCount > NWB_SCENE_LIGHT_CLUSTER_WORD_CAPACITY)
+            packedWordCount = NWB_SCENE_LIGHT_CLUSTER_WORD_CAPACITY;
+        state.m_lightClusterGpuUploadData.resize(packedWordCount);
+        clusterWordCount = ECSRenderDetail::PackSceneLightClusters(
+            grid,
+            state.m_lightClusterGpuUploadData.data(),
+            static_cast<u32>(packedWordCount)
+        );
+    }
+    // Without cluster words the shading state reports no grid and the lighting pass walks the ranked prefix instead.
+    if(clusterWordCount == 0u)
+        state.m_lightClusterGrid.clear();
+
+    const usize clusterByteCount = static_cast<usize>(clusterWordCount) * sizeof(u32);
+    const u64 clusterDataHash = clusterByteCount != 0u
+        ? ComputeWyHash64(state.m_lightClusterGpuUploadData.data(), clusterByteCount)
+        : 0u
+    ;
+    const bool clusterDataUnchanged =
+        state.m_lightClusterGpuDataValid
+        && state.m_lightClusterGpuDataWordCount == clusterWordCount
+        && state.m_lightClusterGpuDataHash == clusterDataHash
+    ;
+    outLightClusterUploadRequired = !clusterDataUnchanged && clusterByteCount != 0u;
+    outLightClusterData = state.m_lightClusterGpuUploadData.data();
+    outLightClusterWordCount = clusterWordCount;
+    outLightClusterDataHash = clusterDataHash;
 
-    outSceneShadingState = ECSRenderDetail::ResolveSceneShadingState(world(), fallbackAspectRatio, lightCount);
+    outSceneShadingState = ECSRenderDetail::ResolveSceneShadingState(lightView, lightCount, state.m_lightClusterGrid);
     outSceneShadingUploadRequired = !(
-        deferredState().m_sceneShadingGpuDataValid
+        state.m_sceneShadingGpuDataValid
         && NWB_MEMCMP(
-            deferredState().m_sceneShadingGpuData,
+            state.m_sceneShadingGpuData,
             &outSceneShadingState,
             sizeof(outSceneShadingState)
         ) == 0
@@ -270,36 +356,36 @@ bool RendererDeferredSystem::prepareSceneShadingBufferUploads(
 }
 
 void RendererDeferredSystem::confirmSceneShadingBufferUploads(
-    const ECSRenderDetail::SceneLightGpuData* const lightData,
     const u32 lightCount,
+    const u64 lightDataHash,
     const bool lightUploadRequired,
+    const u32 lightClusterWordCount,
+    const u64 lightClusterDataHash,
+    const bool lightClusterUploadRequired,
     const ECSRenderDetail::SceneShadingGpuData& sceneShadingState,
     const bool sceneShadingUploadRequired
 ){
-    const usize lightByteCount = static_cast<usize>(lightCount) * sizeof(ECSRenderDetail::SceneLightGpuData);
+    RendererDeferredState& state = deferredState();
     // A zero-light frame has no blob to upload, but it must still commit its empty CPU mirror once its dependent
     // prefix packet accepts. Otherwise a transition from a nonempty list would be treated as changed forever.
     if(lightUploadRequired || lightCount == 0u){
-        NWB_ASSERT(lightData || lightByteCount == 0u);
-        if(lightByteCount != 0u){
-            NWB_MEMCPY(
-                deferredState().m_lightGpuData,
-                sizeof(deferredState().m_lightGpuData),
-                lightData,
-                lightByteCount
-            );
-        }
-        deferredState().m_lightGpuDataCount = lightCount;
-        deferredState().m_lightGpuDataValid = true;
+        state.m_lightGpuDataHash = lightDataHash;
+        state.m_lightGpuDataCount = lightCount;
+        state.m_lightGpuDataValid = true;
+    }
+    if(lightClusterUploadRequired || lightClusterWordCount == 0u){
+        state.m_lightClusterGpuDataHash = lightClusterDataHash;
+        state.m_lightClusterGpuDataWordCount = lightClusterWordCount;
+        state.m_lightClusterGpuDataValid = true;
     }
     if(sceneShadingUploadRequired){
         NWB_MEMCPY(
-            deferredState().m_sceneShadingGpuData,
-            sizeof(deferredState().m_sceneShadingGpuData),
+            state.m_sceneShadingGpuData,
+            sizeof(state.m_sceneShadingGpuData),
             &sceneShadingState,
             sizeof(sceneShadingState)
         );
-        deferredState().m_sceneShadingGpuDataValid = true;
+        state.m_sceneShadingGpuDataValid = true;
     }
 }
 
@@ -36,19 +36,30 @@ public:
 public:
     // Resolves immutable per-frame data before graph declaration. The shared renderer publishes changed payloads
     // through built-in graph uploads and confirms these CPU mirrors only after the packet accepts.
+    // Light data points at deferred-state scratch that stays valid until the next prepare; the graph copies it into
+    // its upload blobs during declaration.
     [[nodiscard]] bool prepareSceneShadingBufferUploads(
         f32 fallbackAspectRatio,
-        ECSRenderDetail::SceneLightGpuData* outLightData,
-        usize lightDataCapacity,
+        u32 viewportWidth,
+        u32 viewportHeight,
+        const ECSRenderDetail::SceneLightGpuData*& outLightData,
         u32& outLightCount,
+        u64& outLightDataHash,
         bool& outLightUploadRequired,
+        const u32*& outLightClusterData,
+        u32& outLightClusterWordCount,
+        u64& outLightClusterDataHash,
+        bool& outLightClusterUploadRequired,
         ECSRenderDetail::SceneShadingGpuData& outSceneShadingState,
         bool& outSceneShadingUploadRequired
     );
     void confirmSceneShadingBufferUploads(
-        const ECSRenderDetail::SceneLightGpuData* lightData,
         u32 lightCount,
+        u64 lightDataHash,
         bool lightUploadRequired,
+        u32 lightClusterWordCount,
+        u64 lightClusterDataHash,
+        bool lightClusterUploadRequired,
         const ECSRenderDetail::SceneShadingGpuData& sceneShadingState,
         bool sceneShadingUploadRequired
     );
@@ -148,6 +148,7 @@ bool RendererDeferredSystem::createDeferredBindlessFrameResources(DeferredFrameT
     NWB_ASSERT(avboitState().m_linearSampler);
     NWB_ASSERT(deferredState().m_sceneShadingBuffer);
     NWB_ASSERT(deferredState().m_lightBuffer);
+    NWB_ASSERT(deferredState().m_lightClusterBuffer);
     NWB_ASSERT(targets.csgIntervalTargetsValid());
 
     auto registerTexture = [&heap](
@@ -257,6 +258,8 @@ bool RendererDeferredSystem::createDeferredBindlessFrameResources(DeferredFrameT
         // shared singletons the deferred lighting pass now reads from the heap via its two spare avboit slot lanes.
         && registerConstantBuffer(bindless.sceneShading, deferredState().m_sceneShadingBuffer.get())
         && registerStructuredBuffer(bindless.lightList, deferredState().m_lightBuffer.get())
+        // Per-cluster light lists read by the clustered lighting loop (uint structured view of the same table).
+        && registerStructuredBuffer(bindless.lightClusters, deferredState().m_lightClusterBuffer.get())
         // CSG interval/peel resources use one persistent StorageImage descriptor each. Their target-generation slots
         // are consumed by the CSG compute, material surface, and cap-fill shaders through the shared slot cbuffer.
         && registerStorageTexture(bindless.csgCapBackNormal, targets.csgCapBackNormal.get(), targets.csgCapNormalFormat, Core::TextureDimension::Texture2DArray)
@@ -334,6 +337,7 @@ bool RendererDeferredSystem::createDeferredBindlessFrameResources(DeferredFrameT
     bindless.slots.avboitLinearSampler = bindless.avboitLinearSampler.slot();
     bindless.slots.sceneShading = bindless.sceneShading.slot();
     bindless.slots.lightList = bindless.lightList.slot();
+    bindless.slots.lightClusters = bindless.lightClusters.slot();
     bindless.slots.csgCapBackNormal = bindless.csgCapBackNormal.slot();
     bindless.slots.csgIntervalDepth = bindless.csgIntervalDepth.slot();
     bindless.slots.csgIntervalId = bindless.csgIntervalId.slot();
@@ -409,6 +413,7 @@ void RendererDeferredSystem::resetDeferredBindlessFrameResources(DeferredFrameTa
         heap.free(targets.bindless.avboitLinearSampler);
         heap.free(targets.bindless.sceneShading);
         heap.free(targets.bindless.lightList);
+        heap.free(targets.bindless.lightClusters);
         heap.free(targets.bindless.causticAccumulator);
         heap.free(targets.bindless.causticAccumulatorStorage);
         heap.free(targets.bindless.causticHistory);
@@ -282,6 +282,7 @@ void RendererSystem::buildDeferredLightingTaskGraph(
         || !m_drawState.m_meshViewBuffer
         || !m_deferredState.m_sceneShadingBuffer
         || !m_deferredState.m_lightBuffer
+        || !m_deferredState.m_lightClusterBuffer
         || !presentationFramebuffer
         || hasTransparentRenderers != features.hasTransparentRenderers
         || (useLaggedLightingHistory && (!history || !history->valid()))
@@ -643,6 +644,11 @@ void RendererSystem::buildDeferredLightingTaskGraph(
         Name("render.deferred_lighting.lights"),
         "Lights"
     );
+    const Core::GpuGraphResourceId lightClusters = importBuffer(
+        m_deferredState.m_lightClusterBuffer,
+        Name("render.deferred_lighting.light_clusters"),
+        "Light Clusters"
+    );
     const Core::GpuGraphResourceId meshView = importBuffer(
         m_drawState.m_meshViewBuffer,
         Name("render.deferred.mesh_view"),
@@ -847,6 +853,7 @@ void RendererSystem::buildDeferredLightingTaskGraph(
         || !opaqueColor.valid()
         || !sceneShading.valid()
         || !lights.valid()
+        || !lightClusters.valid()
         || !meshView.valid()
         || !bindlessSlots.valid()
         || !currentBindlessSlots.valid()
@@ -937,6 +944,7 @@ void RendererSystem::buildDeferredLightingTaskGraph(
         opaqueColor,
         sceneShading,
         lights,
+        lightClusters,
         meshView,
         materialInstances,
         materialTyped,
@@ -5784,6 +5792,7 @@ void RendererSystem::buildDeferredLightingTaskGraph(
             laggedReadsHaveIndependentStateSources
         ),
         ReadUse(lights, Core::ResourceStates::ShaderResource, laggedReadsHaveIndependentStateSources),
+        ReadUse(lightClusters, Core::ResourceStates::ShaderResource, laggedReadsHaveIndependentStateSources),
         ReadUse(
             bindlessSlots,
             Core::ResourceStates::ConstantBuffer,
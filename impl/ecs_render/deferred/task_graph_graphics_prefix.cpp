@@ -59,6 +59,7 @@ bool RendererSystem::declareDeferredGraphicsPrefixTasks(
     const Core::GpuGraphResourceId opaqueColor,
     const Core::GpuGraphResourceId sceneShading,
     const Core::GpuGraphResourceId lights,
+    const Core::GpuGraphResourceId lightClusters,
     const Core::GpuGraphResourceId meshView,
     const Core::GpuGraphResourceId materialInstances,
     const Core::GpuGraphResourceId materialTyped,
@@ -122,6 +123,7 @@ bool RendererSystem::declareDeferredGraphicsPrefixTasks(
         || !m_drawState.m_meshViewBuffer
         || !m_deferredState.m_sceneShadingBuffer
         || !m_deferredState.m_lightBuffer
+        || !m_deferredState.m_lightClusterBuffer
         || !albedo.valid()
         || !normal.valid()
         || !worldPosition.valid()
@@ -129,6 +131,7 @@ bool RendererSystem::declareDeferredGraphicsPrefixTasks(
         || !opaqueColor.valid()
         || !sceneShading.valid()
         || !lights.valid()
+        || !lightClusters.valid()
         || !meshView.valid()
         || !currentBindlessSlots.valid()
         || !materialContextSlots.valid()
@@ -190,10 +193,15 @@ bool RendererSystem::declareDeferredGraphicsPrefixTasks(
 
     ECSRenderDetail::MeshViewGpuData meshViewState;
     bool meshViewUploadRequired = false;
-    ECSRenderDetail::SceneLightGpuData sceneLightData[NWB_SCENE_MAX_LIGHTS] = {};
-    ECSRenderDetail::SceneShadingGpuData sceneShadingState;
+    const ECSRenderDetail::SceneLightGpuData* sceneLightData = nullptr;
     u32 sceneLightCount = 0u;
+    u64 sceneLightDataHash = 0u;
     bool sceneLightUploadRequired = false;
+    const u32* sceneLightClusterData = nullptr;
+    u32 sceneLightClusterWordCount = 0u;
+    u64 sceneLightClusterDataHash = 0u;
+    bool sceneLightClusterUploadRequired = false;
+    ECSRenderDetail::SceneShadingGpuData sceneShadingState;
     bool sceneShadingUploadRequired = false;
     if(
         !m_meshSystem.prepareMeshViewBufferUpload(
@@ -203,10 +211,16 @@ bool RendererSystem::declareDeferredGraphicsPrefixTasks(
         )
         || !m_deferredSystem.prepareSceneShadingBufferUploads(
             meshViewAspectRatio,
+            deferredTargets.width,
+            deferredTargets.height,
             sceneLightData,
-            LengthOf(sceneLightData),
             sceneLightCount,
+            sceneLightDataHash,
             sceneLightUploadRequired,
+            sceneLightClusterData,
+            sceneLightClusterWordCount,
+            sceneLightClusterDataHash,
+            sceneLightClusterUploadRequired,
             sceneShadingState,
             sceneShadingUploadRequired
         )
@@ -308,7 +322,7 @@ bool RendererSystem::declareDeferredGraphicsPrefixTasks(
 
     Core::GpuTaskId sceneUploadTask = meshViewCommitTask;
     if(sceneLightUploadRequired){
-        const usize sceneLightByteCount = static_cast<usize>(sceneLightCount) * sizeof(sceneLightData[0u]);
+        const usize sceneLightByteCount = static_cast<usize>(sceneLightCount) * sizeof(ECSRenderDetail::SceneLightGpuData);
         const Core::GpuUploadBlobId sceneLightBlob = m_deferredLightingTaskGraph.copyUploadData(
             sceneLightData,
             sceneLightByteCount,
@@ -341,6 +355,38 @@ bool RendererSystem::declareDeferredGraphicsPrefixTasks(
         }
     }
 
+    if(sceneLightClusterUploadRequired){
+        const Core::GpuUploadBlobId sceneLightClusterBlob = m_deferredLightingTaskGraph.copyUploadData(
+            sceneLightClusterData,
+            static_cast<usize>(sceneLightClusterWordCount) * sizeof(u32),
+            alignof(u32)
+        );
+        Core::GpuTaskDesc sceneLightClusterUploadDesc;
+        sceneLightClusterUploadDesc
+            .setIdentity(Name("render.graphics_prefix.scene_light_clusters_upload"))
+            .setMarkerLabel("Scene Light Clusters Upload")
+            .setQueue(GraphicsUploadQueueRequest())
+            .setScheduling(immutableUploadScheduling)
+            .setDependencies(&sceneUploadTask, 1u)
+        ;
+        sceneUploadTask = sceneLightClusterBlob.valid()
+            ? m_deferredLightingTaskGraph.addUploadBufferTask(
+                sceneLightClusterUploadDesc,
+                Core::GpuUploadBufferTaskDesc{
+                    .source = sceneLightClusterBlob,
+                    .destination = lightClusters,
+                    // Same Common boundary as the light list above.
+                    .finalState = Core::ResourceStates::Common,
+                }
+            )
+            : Core::GpuTaskId{}
+        ;
+        if(!sceneUploadTask.valid()){
+            NWB_LOGGER_WARNING(NWB_TEXT("RendererSystem: could not declare graph-owned scene-light-cluster upload"));
+            return false;
+        }
+    }
+
     if(sceneShadingUploadRequired){
         const Core::GpuUploadBlobId sceneShadingBlob = m_deferredLightingTaskGraph.copyUploadData(
             &sceneShadingState,
@@ -391,15 +437,13 @@ bool RendererSystem::declareDeferredGraphicsPrefixTasks(
     sceneShadingSetupPayload.renderer = this;
     sceneShadingSetupPayload.timingTicket = timingTicketSlot(PrefixTimingSlot::SceneShadingSetup);
     sceneShadingSetupPayload.ready = &m_graphicsPrefixSceneShadingSetupReady;
-    NWB_MEMCPY(
-        sceneShadingSetupPayload.lightData,
-        sizeof(sceneShadingSetupPayload.lightData),
-        sceneLightData,
-        sizeof(sceneLightData)
-    );
     sceneShadingSetupPayload.sceneShadingState = sceneShadingState;
+    sceneShadingSetupPayload.lightDataHash = sceneLightDataHash;
+    sceneShadingSetupPayload.lightClusterDataHash = sceneLightClusterDataHash;
     sceneShadingSetupPayload.lightCount = sceneLightCount;
+    sceneShadingSetupPayload.lightClusterWordCount = sceneLightClusterWordCount;
     sceneShadingSetupPayload.lightUploadRequired = sceneLightUploadRequired;
+    sceneShadingSetupPayload.lightClusterUploadRequired = sceneLightClusterUploadRequired;
     sceneShadingSetupPayload.sceneShadingUploadRequired = sceneShadingUploadRequired;
     m_graphicsPrefixSceneShadingSetupTask = m_deferredLightingTaskGraph.addTask<ECSRenderDetail::SceneShadingSetupGraphTask>(
         sceneShadingSetupDesc,
@@ -552,6 +596,7 @@ bool RendererSystem::declareDeferredGraphicsPrefixTasks(
 #endif
         materialTypedBytes,
         RendererResourceLookupMode::PreparedOnly,
+        &meshViewState,
         &meshViewState
     );
 
@@ -2062,13 +2107,14 @@ bool RendererSystem::declareDeferredGraphicsPrefixTasks(
 
     Core::Alloc::ScratchArena normalizeScratchArena(RendererArenaScope::s_TaskGraphArena);
     Vector<Core::GpuTaskResourceUse, Core::Alloc::ScratchArena> normalizeResourceUses{ normalizeScratchArena };
-    normalizeResourceUses.reserve(8u + (shadowTraceGeometryStatesGraphOwned ? 0u : shadowTraceGeometryResourceCount));
+    normalizeResourceUses.reserve(9u + (shadowTraceGeometryStatesGraphOwned ? 0u : shadowTraceGeometryResourceCount));
     normalizeResourceUses.push_back(ReadUse(meshView, Core::ResourceStates::ConstantBuffer));
     normalizeResourceUses.push_back(ReadUse(normal, Core::ResourceStates::ShaderResource));
     normalizeResourceUses.push_back(ReadUse(worldPosition, Core::ResourceStates::ShaderResource));
     normalizeResourceUses.push_back(ReadUse(depth, Core::ResourceStates::ShaderResource));
     normalizeResourceUses.push_back(ReadUse(sceneShading, Core::ResourceStates::ConstantBuffer));
     normalizeResourceUses.push_back(ReadUse(lights, Core::ResourceStates::ShaderResource));
+    normalizeResourceUses.push_back(ReadUse(lightClusters, Core::ResourceStates::ShaderResource));
     normalizeResourceUses.push_back(ReadUse(currentBindlessSlots, Core::ResourceStates::ConstantBuffer));
     normalizeResourceUses.push_back(ReadUse(materialContextSlots, Core::ResourceStates::ConstantBuffer));
     for(usize resourceIndex = 0u; resourceIndex < shadowTraceGeometryResourceCount; ++resourceIndex){
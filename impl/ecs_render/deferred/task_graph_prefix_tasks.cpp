@@ -44,9 +44,12 @@ void SceneShadingSetupGraphTask::accepted(Payload& payload, const Core::QueueSub
     if(!payload.renderer)
         return;
     payload.renderer->m_deferredSystem.confirmSceneShadingBufferUploads(
-        payload.lightData,
         payload.lightCount,
+        payload.lightDataHash,
         payload.lightUploadRequired,
+        payload.lightClusterWordCount,
+        payload.lightClusterDataHash,
+        payload.lightClusterUploadRequired,
         payload.sceneShadingState,
         payload.sceneShadingUploadRequired
     );
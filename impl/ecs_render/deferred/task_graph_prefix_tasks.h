@@ -37,10 +37,13 @@ struct SceneShadingSetupGraphTask{
         RendererSystem* renderer = nullptr;
         Core::GpuTimingSubmissionTicket** timingTicket = nullptr;
         bool* ready = nullptr;
-        ECSRenderDetail::SceneLightGpuData lightData[NWB_SCENE_MAX_LIGHTS] = {};
         ECSRenderDetail::SceneShadingGpuData sceneShadingState;
+        u64 lightDataHash = 0u;
+        u64 lightClusterDataHash = 0u;
         u32 lightCount = 0u;
+        u32 lightClusterWordCount = 0u;
         bool lightUploadRequired = false;
+        bool lightClusterUploadRequired = false;
         bool sceneShadingUploadRequired = false;
     };
 
@@ -62,6 +62,7 @@ inline constexpr Name s_CsgReceiverRangeBufferName("ecs_render/csg_receiver_rang
 inline constexpr Name s_CsgCutterBufferName("ecs_render/csg_cutters");
 inline constexpr Name s_SceneShadingBufferName("ecs_render/scene_shading_data");
 inline constexpr Name s_SceneLightBufferName("ecs_render/scene_light_data");
+inline constexpr Name s_SceneLightClusterBufferName("ecs_render/scene_light_clusters");
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -46,6 +46,7 @@ RendererSystem::RendererSystem(
     , m_deferredTaskTimingFeedback(arena, graphics)
     , m_meshState(arena)
     , m_materialState(arena)
+    , m_deferredState(arena)
     , m_rayTracingState(arena)
     , m_shadowComputePersistentState(arena)
     , m_shadowVisibilityReturnState(arena)
@@ -328,6 +328,7 @@ private:
         Core::GpuGraphResourceId opaqueColor,
         Core::GpuGraphResourceId sceneShading,
         Core::GpuGraphResourceId lights,
+        Core::GpuGraphResourceId lightClusters,
         Core::GpuGraphResourceId meshView,
         Core::GpuGraphResourceId materialInstances,
         Core::GpuGraphResourceId materialTyped,
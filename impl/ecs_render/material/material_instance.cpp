@@ -331,8 +331,20 @@ void RendererMaterialSystem::pruneMaterialInstanceMutableCache(){
     if(componentMutationVersion == materialState().m_instanceMutableCacheComponentMutationVersion)
         return;
 
-    materialState().m_instanceMutableCache.clear();
+    // Edits are caught per entry by the revision, so only entities that lost their instance need to go. Removals at the
+    // current tick can still follow, which is why the next walk starts one tick back; erasing an entry twice is cheap.
+    auto& cache = materialState().m_instanceMutableCache;
+    const bool removalsComplete = world().eachRemoved<MaterialInstanceComponent>(
+        materialState().m_instanceMutableCacheRemovedSinceTick,
+        [&cache](const Core::ECS::EntityID entity){
+            cache.erase(entity);
+        }
+    );
+    if(!removalsComplete)
+        cache.clear();
+
     materialState().m_instanceMutableCacheComponentMutationVersion = componentMutationVersion;
+    materialState().m_instanceMutableCacheRemovedSinceTick = world().changeTick() - 1u;
 }
 
 
@@ -5,6 +5,7 @@
 #include <impl/ecs_render/kernel/renderer_private.h>
 
 #include <impl/ecs_render/kernel/arena_names.h>
+#include <impl/ecs_render/material/material_pass_culling_private.h>
 
 
 
@@ -283,11 +284,15 @@ void RendererMaterialSystem::gatherMaterialPassDrawItems(
 #endif
     MaterialTypedByteDataVector& materialTypedBytes,
     const RendererResourceLookupMode::Enum lookupMode,
-    const ECSRenderDetail::MeshViewGpuData* const csgWorkRegionMeshViewState
+    const ECSRenderDetail::MeshViewGpuData* const csgWorkRegionMeshViewState,
+    const ECSRenderDetail::MeshViewGpuData* const cullingMeshViewState
 ){
     if(!framebuffer)
         return;
 
+    // Candidates are buffered only while culling, which never runs on the resource-creating prepare path.
+    NWB_ASSERT(!cullingMeshViewState || lookupMode == RendererResourceLookupMode::PreparedOnly);
+
     auto rendererView = world().view<RendererComponent>();
     auto* ecsMeshSystem = world().getSystem<NWB::Impl::MeshSystem>();
     const usize rendererCapacity = rendererView.candidateCount();
@@ -619,6 +624,14 @@ void RendererMaterialSystem::gatherMaterialPassDrawItems(
         return true;
     };
 
+    Core::Alloc::ScratchArena& cullScratchArena = materialTypedBytes.get_allocator().arena();
+    Vector<ECSRenderDetail::MaterialPassCullCandidate, Core::Alloc::ScratchArena> cullCandidates{ cullScratchArena };
+    ECSRenderDetail::MaterialPassCullBounds cullBounds(cullScratchArena);
+    if(cullingMeshViewState){
+        cullCandidates.reserve(rendererCapacity);
+        cullBounds.reserve(rendererCapacity);
+    }
+
     for(auto&& [entity, renderer] : rendererView){
         if(!renderer.visible)
             continue;
@@ -654,8 +667,98 @@ void RendererMaterialSystem::gatherMaterialPassDrawItems(
         if(csgReceiverLookupPtr && !csgReceiverLookupPtr->resolveReceiverDrawState(entity, csgReceiverPass, csgReceiverState))
             csgReceiverState = CsgReceiverDrawState{};
 
-        appendDrawForMesh(entity, renderer.material, *mesh, csgReceiverState);
+        if(!cullingMeshViewState){
+            appendDrawForMesh(entity, renderer.material, *mesh, csgReceiverState);
+            continue;
+        }
+
+        const u32 candidateIndex = static_cast<u32>(cullCandidates.size());
+        cullCandidates.push_back(ECSRenderDetail::MaterialPassCullCandidate{
+            .entity = entity,
+            .material = &renderer.material,
+            .mesh = mesh,
+            .csgReceiverState = csgReceiverState,
+        });
+
+        // Runtime meshes deform away from the bounds recorded at creation, so they always reach the GPU meshlet cull.
+        if(resolvedMesh.runtime || !CsgReceiverBoundsCanCull(mesh->csgLocalBounds))
+            continue;
+
+        SIMDVector worldCenter{};
+        SIMDVector worldExtents{};
+        if(!resolveMaterialPassWorldBounds(entity, *mesh, worldCenter, worldExtents))
+            continue;
+
+        cullBounds.append(worldCenter, worldExtents, candidateIndex);
+        cullCandidates.back().visible = false;
+    }
+
+    if(!cullingMeshViewState)
+        return;
+
+    FrustumBatchTests::Planes cullingPlanes;
+    FrustumBatchTests::LoadPlanes(cullingPlanes, cullingMeshViewState->frustumPlanes);
+    const usize cullBoundCount = cullBounds.candidateIndices.size();
+    Vector<u32, Core::Alloc::ScratchArena> visibleBounds{ cullScratchArena };
+    visibleBounds.resize(cullBoundCount);
+    const usize visibleBoundCount = FrustumBatchTests::CullBoxes(cullingPlanes, cullBounds.stream(), cullBoundCount, visibleBounds.data());
+    for(usize i = 0u; i < visibleBoundCount; ++i)
+        cullCandidates[cullBounds.candidateIndices[visibleBounds[i]]].visible = true;
+
+    for(const ECSRenderDetail::MaterialPassCullCandidate& candidate : cullCandidates){
+        if(!candidate.visible)
+            continue;
+        appendDrawForMesh(candidate.entity, *candidate.material, *candidate.mesh, candidate.csgReceiverState);
+    }
+}
+
+bool RendererMaterialSystem::resolveMaterialPassWorldBounds(
+    const Core::ECS::EntityID entity,
+    const MeshResources& mesh,
+    SIMDVector& outCenter,
+    SIMDVector& outExtents
+){
+    const NWB::Impl::Scene::WorldTransformComponent* worldTransform =
+        world().tryGetComponent<NWB::Impl::Scene::WorldTransformComponent>(entity)
+    ;
+    // Version zero means the hierarchy has not evaluated the node yet, so there is nothing to key the bounds on.
+    if(!worldTransform || worldTransform->version == 0u){
+        return ECSRenderDetail::ResolveMaterialPassWorldBounds(
+            world().tryGetComponent<NWB::Impl::Scene::TransformComponent>(entity),
+            mesh.csgLocalBounds,
+            outCenter,
+            outExtents
+        );
     }
+
+    auto& cache = materialState().m_passWorldBoundsCache;
+    const usize slot = static_cast<usize>(entity.index());
+    if(slot >= cache.size())
+        cache.resize(slot + 1u);
+
+    MaterialPassWorldBoundsCacheEntry& entry = cache[slot];
+    if(entry.entity == entity && entry.meshName == mesh.meshName && entry.transformVersion == worldTransform->version){
+        outCenter = LoadFloat(entry.center);
+        outExtents = LoadFloat(entry.extents);
+        return true;
+    }
+
+    if(!ECSRenderDetail::ResolveMaterialPassWorldBounds(
+        world().tryGetComponent<NWB::Impl::Scene::TransformComponent>(entity),
+        mesh.csgLocalBounds,
+        outCenter,
+        outExtents
+    )){
+        entry.entity = Core::ECS::ENTITY_ID_INVALID;
+        return false;
+    }
+
+    entry.entity = entity;
+    entry.meshName = mesh.meshName;
+    entry.transformVersion = worldTransform->version;
+    StoreFloat(outCenter, &entry.center);
+    StoreFloat(outExtents, &entry.extents);
+    return true;
 }
 
 
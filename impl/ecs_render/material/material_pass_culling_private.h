@@ -0,0 +1,143 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <impl/ecs_render/csg/renderer_csg_types.h>
+#include <impl/ecs_render/mesh/renderer_mesh_types.h>
+
+#include <core/alloc/scratch.h>
+#include <core/ecs/entity_id.h>
+#include <impl/assets/graphics/mesh/runtime_constants.h>
+#include <impl/ecs_csg/frame_state.h>
+#include <impl/ecs_scene/components.h>
+
+#include <global/containers.h>
+#include <global/simdmath.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace ECSRenderDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static_assert(NWB_MESH_VIEW_FRUSTUM_PLANE_COUNT == FrustumBatchTests::s_PlaneCount, "View culling expects six mesh-view frustum planes");
+
+// View culling buffers the gathered renderers, tests every static world AABB against the view frustum in one SoA
+// batch, and only then emits instances in the original renderer order so draw packing stays deterministic.
+struct MaterialPassCullCandidate{
+    Core::ECS::EntityID entity;
+    const Core::Assets::AssetRef<Material>* material = nullptr;
+    MeshResources* mesh = nullptr;
+    CsgReceiverDrawState csgReceiverState;
+    bool visible = true;
+};
+
+struct MaterialPassCullBounds{
+    Vector<f32, Core::Alloc::ScratchArena> centerX;
+    Vector<f32, Core::Alloc::ScratchArena> centerY;
+    Vector<f32, Core::Alloc::ScratchArena> centerZ;
+    Vector<f32, Core::Alloc::ScratchArena> extentsX;
+    Vector<f32, Core::Alloc::ScratchArena> extentsY;
+    Vector<f32, Core::Alloc::ScratchArena> extentsZ;
+    Vector<u32, Core::Alloc::ScratchArena> candidateIndices;
+
+    explicit MaterialPassCullBounds(Core::Alloc::ScratchArena& arena)
+        : centerX(arena)
+        , centerY(arena)
+        , centerZ(arena)
+        , extentsX(arena)
+        , extentsY(arena)
+        , extentsZ(arena)
+        , candidateIndices(arena)
+    {}
+
+    void reserve(const usize count){
+        centerX.reserve(count);
+        centerY.reserve(count);
+        centerZ.reserve(count);
+        extentsX.reserve(count);
+        extentsY.reserve(count);
+        extentsZ.reserve(count);
+        candidateIndices.reserve(count);
+    }
+    void append(const SIMDVector center, const SIMDVector extents, const u32 candidateIndex){
+        Float4 centerValue;
+        Float4 extentsValue;
+        StoreFloat(center, &centerValue);
+        StoreFloat(extents, &extentsValue);
+        centerX.push_back(centerValue.x);
+        centerY.push_back(centerValue.y);
+        centerZ.push_back(centerValue.z);
+        extentsX.push_back(extentsValue.x);
+        extentsY.push_back(extentsValue.y);
+        extentsZ.push_back(extentsValue.z);
+        candidateIndices.push_back(candidateIndex);
+    }
+    [[nodiscard]] BoundsBatch::BoxStream stream()const{
+        return BoundsBatch::BoxStream{
+            .centerX = centerX.data(),
+            .centerY = centerY.data(),
+            .centerZ = centerZ.data(),
+            .extentsX = extentsX.data(),
+            .extentsY = extentsY.data(),
+            .extentsZ = extentsZ.data(),
+        };
+    }
+};
+
+[[nodiscard]] inline bool ResolveMaterialPassWorldBounds(
+    const NWB::Impl::Scene::TransformComponent* transform,
+    const CsgReceiverCpuBounds& localBounds,
+    SIMDVector& outCenter,
+    SIMDVector& outExtents
+){
+    const SIMDVector localMinBounds = LoadFloatInt(localBounds.minBounds);
+    const SIMDVector localMaxBounds = LoadFloatInt(localBounds.maxBounds);
+    SIMDVector worldMinBounds = localMinBounds;
+    SIMDVector worldMaxBounds = localMaxBounds;
+    if(transform){
+        const SIMDMatrix localToWorld = MatrixAffineTransformation(
+            LoadFloat(transform->scale),
+            VectorZero(),
+            LoadFloat(transform->rotation),
+            LoadFloat(transform->position)
+        );
+        if(!AabbTests::Transform(localToWorld, localMinBounds, localMaxBounds, worldMinBounds, worldMaxBounds))
+            return false;
+    }
+    if(!VectorIsFinite(worldMinBounds, VectorComponentMask::s_XYZ) || !VectorIsFinite(worldMaxBounds, VectorComponentMask::s_XYZ))
+        return false;
+
+    outCenter = AabbTests::Center(worldMinBounds, worldMaxBounds);
+    outExtents = AabbTests::Extents(worldMinBounds, worldMaxBounds);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
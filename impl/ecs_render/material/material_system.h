@@ -106,7 +106,18 @@ public:
         RendererResourceLookupMode::Enum lookupMode,
         // Graph declaration can supply the exact immutable view payload that will be uploaded before this CSG
         // work records. Compatibility paths retain the accepted CPU mirror fallback.
-        const ECSRenderDetail::MeshViewGpuData* csgWorkRegionMeshViewState = nullptr
+        const ECSRenderDetail::MeshViewGpuData* csgWorkRegionMeshViewState = nullptr,
+        // When set, instances whose static world bounds fall outside this view's frustum are skipped before any
+        // instance or draw item is emitted. Runtime and non-finite bounds are always kept.
+        const ECSRenderDetail::MeshViewGpuData* cullingMeshViewState = nullptr
+    );
+    // Static world bounds for view culling. Entities in the transform hierarchy reuse the bounds from an earlier
+    // gather while their WorldTransformComponent version has not moved; everything else is transformed every call.
+    [[nodiscard]] bool resolveMaterialPassWorldBounds(
+        Core::ECS::EntityID entity,
+        const MeshResources& mesh,
+        SIMDVector& outCenter,
+        SIMDVector& outExtents
     );
     [[nodiscard]] static bool findMaterialInstanceOverrideField(
         Core::ECS::EntityID entity,
@@ -7,6 +7,8 @@
 
 #include <impl/ecs_render/material/renderer_pipeline_types.h>
 
+#include <core/ecs/entity_id.h>
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -38,6 +40,16 @@ struct MaterialInstanceMutableCacheEntry{
     {}
 };
 
+// Culling world bounds of one renderer, slotted by entity index. The entry stays valid while the entity, its mesh and
+// its WorldTransformComponent version are unchanged.
+struct MaterialPassWorldBoundsCacheEntry{
+    Core::ECS::EntityID entity = Core::ECS::ENTITY_ID_INVALID;
+    Name meshName = NAME_NONE;
+    u64 transformVersion = 0u;
+    Float4 center;
+    Float4 extents;
+};
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -179,7 +179,8 @@ struct DeferredBindlessResourceSlots{
     u32 csgRemovedIntervalCapNormal = 0u;
     u32 csgRemovedIntervalData = 0u;
     u32 csgRemovedIntervalCount = 0u;
-    u32 _csgPad = 0u;
+    // Per-cluster light lists; shares the last lane with the CSG removed-interval aliases.
+    u32 lightClusters = 0u;
 };
 static_assert(sizeof(DeferredBindlessResourceSlots) == sizeof(u32) * 36u, "Deferred bindless slots must match nine std140 uint4 lanes");
 
@@ -213,6 +214,7 @@ struct DeferredBindlessFrameResources{
     Core::GpuDescriptorHandle avboitLinearSampler = Core::GpuDescriptorHandle::invalid();
     Core::GpuDescriptorHandle sceneShading = Core::GpuDescriptorHandle::invalid();
     Core::GpuDescriptorHandle lightList = Core::GpuDescriptorHandle::invalid();
+    Core::GpuDescriptorHandle lightClusters = Core::GpuDescriptorHandle::invalid();
     // Typed uint accumulator plus floating-point caustic resolve views.
     Core::GpuDescriptorHandle causticAccumulator = Core::GpuDescriptorHandle::invalid();
     Core::GpuDescriptorHandle causticAccumulatorStorage = Core::GpuDescriptorHandle::invalid();
@@ -289,6 +291,7 @@ struct DeferredBindlessFrameResources{
             && avboitLinearSampler.valid()
             && sceneShading.valid()
             && lightList.valid()
+            && lightClusters.valid()
             && causticAccumulator.valid()
             && causticAccumulatorStorage.valid()
             && causticHistory.valid()
@@ -65,6 +65,18 @@ struct EmulatedVertex{
 struct SceneShadingGpuData{
     // xyz = camera world position, w = active light count.
     Float4 cameraPositionLightCount = Float4(0.f, 0.f, 0.f, 0.f);
+    // Light-cluster grid view: xyz = grid origin, w = near plane.
+    Float4 clusterOriginNear = Float4(0.f, 0.f, 0.f, 0.f);
+    // xyz = view right, w = horizontal view scale.
+    Float4 clusterRightScale = Float4(0.f, 0.f, 0.f, 0.f);
+    // xyz = view up, w = vertical view scale.
+    Float4 clusterUpScale = Float4(0.f, 0.f, 0.f, 0.f);
+    // xyz = view forward, w = depth-slice scale.
+    Float4 clusterForwardSliceScale = Float4(0.f, 0.f, 0.f, 0.f);
+    // x = tile count X, y = tile count Y, z = slice count (zero = no grid), w = directional light count.
+    Float4 clusterGrid = Float4(0.f, 0.f, 0.f, 0.f);
+    // x = tile width in NDC, y = tile height in NDC, zw reserved.
+    Float4 clusterTile = Float4(0.f, 0.f, 0.f, 0.f);
 };
 
 struct SceneLightGpuData{
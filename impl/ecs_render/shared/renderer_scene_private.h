@@ -31,12 +31,6 @@ inline constexpr f32 s_ShadowSlotUnassigned = -1.f;
 inline constexpr f32 s_CausticSlotUnassigned = s_ShadowSlotUnassigned;
 inline constexpr f32 s_CausticSlotDisabled = -2.f;
 inline constexpr f32 s_CausticSlotEnabledThreshold = s_CausticSlotUnassigned - 0.5f;
-inline constexpr f32 s_Rec709LuminanceRed = 0.2126f;
-inline constexpr f32 s_Rec709LuminanceGreen = 0.7152f;
-inline constexpr f32 s_Rec709LuminanceBlue = 0.0722f;
-inline constexpr f32 s_DirectionalShadowImportanceBoost = 4.0f;
-inline constexpr f32 s_ShadowImportanceDistanceSquaredEpsilon = 1e-4f;
-
 // SceneLightGpuData::params.y carries static_cast<f32>(LightType::Enum) (Directional=0, Point=1, Spot=2). These
 // thresholds decode the integer-typed light type back from its float packing: a half-way bound between adjacent
 // integer values absorbs any quantization noise from the float round-trip.
@@ -58,54 +52,46 @@ NWB_INLINE f32 ResolveFramebufferAspectRatio(const Core::FramebufferInfoEx& fram
     return ResolveExtentAspectRatio(framebufferInfo.width, framebufferInfo.height);
 }
 
-// Importance heuristic for the bounded shadow-slot pool: radiant power (luminance * intensity) weighted by
-// screen coverage. Directional lights cover the whole frame (and always outrank comparable local lights);
-// local lights are weighted by their influence range relative to the camera distance (a squared proxy --
-// monotonic, no sqrt). Higher = more worth a scarce shadow slot.
-inline f32 ShadowSlotImportance(
-    const SIMDVector colorIntensity,
-    const SIMDVector params,
-    const SIMDVector lightPosition,
-    const SIMDVector cameraPosition
-){
-    const SIMDVector luminance = Vector3Dot(
-        colorIntensity,
-        VectorSet(s_Rec709LuminanceRed, s_Rec709LuminanceGreen, s_Rec709LuminanceBlue, 0.0f)
-    );
-    const SIMDVector intensity = VectorMax(VectorSplatW(colorIntensity), VectorZero());
-    const SIMDVector radiantImportance = VectorMultiply(luminance, intensity);
-
-    if(VectorGetY(params) < s_LightTypeDirectionalMax)
-        return VectorGetX(VectorMultiplyAdd(radiantImportance, VectorReplicate(s_DirectionalShadowImportanceBoost), s_SIMDOne));
-
-    const SIMDVector delta = VectorSubtract(lightPosition, cameraPosition);
-    const SIMDVector distanceSquared = Vector3LengthSq(delta);
-    const SIMDVector range = VectorMax(VectorSplatX(params), VectorZero());
-    const SIMDVector rangeSquared = VectorMultiply(range, range);
-    const SIMDVector hasDistance = VectorGreater(distanceSquared, VectorReplicate(s_ShadowImportanceDistanceSquaredEpsilon));
-    const SIMDVector safeDistanceSquared = VectorSelect(s_SIMDOne, distanceSquared, hasDistance);
-    const SIMDVector coverageSquared = VectorSelect(
-        s_SIMDOne,
-        VectorDivide(rangeSquared, safeDistanceSquared),
-        hasDistance
-    );
-    return VectorGetX(VectorMultiply(radiantImportance, VectorMin(coverageSquared, s_SIMDOne)));
+// Camera view the scene lights are ranked and clustered against. Falls back to the default basis and projection
+// exactly like ResolveMeshViewState when the scene has no usable camera.
+struct SceneLightView{
+    NWB::Impl::Scene::SceneViewBasis basis;
+    NWB::Impl::Scene::CameraProjection projection;
+};
+
+inline SceneLightView ResolveSceneLightView(Core::ECS::World& world, const f32 fallbackAspectRatio){
+    SceneLightView view;
+    view.basis = NWB::Impl::Scene::BuildDefaultSceneViewBasis();
+    view.projection = NWB::Impl::Scene::BuildDefaultCameraProjection(fallbackAspectRatio);
+
+    const NWB::Impl::Scene::SceneCameraView cameraView = NWB::Impl::Scene::ResolveSceneCameraView(world, fallbackAspectRatio);
+    if(cameraView.valid()){
+        view.basis = NWB::Impl::Scene::BuildSceneViewBasis(
+            LoadFloat(cameraView.transform->position),
+            LoadFloat(cameraView.transform->rotation)
+        );
+        view.projection = cameraView.projection;
+    }
+    return view;
 }
 
-// Caustic importance: pure radiant power (luminance * intensity), the same energy proxy ShadowSlotImportance
-// uses, but WITHOUT the screen-coverage weighting (the caustic budget is aimed at the refractive occluders, not
-// the camera). Higher = more worth a scarce caustic slot.
+// Caustic importance: pure radiant power, the energy term of SceneLightImportance WITHOUT its screen-coverage
+// weighting (the caustic budget is aimed at the refractive occluders, not the camera). Higher = more worth a scarce
+// caustic slot.
 inline f32 CausticSlotImportance(const SIMDVector colorIntensity){
-    const SIMDVector luminance = Vector3Dot(
-        colorIntensity,
-        VectorSet(s_Rec709LuminanceRed, s_Rec709LuminanceGreen, s_Rec709LuminanceBlue, 0.0f)
-    );
-    const SIMDVector intensity = VectorMax(VectorSplatW(colorIntensity), VectorZero());
-    return VectorGetX(VectorMultiply(luminance, intensity));
+    return NWB::Impl::Scene::SceneLightRadiantPower(colorIntensity);
 }
 
+// Gathers up to maxLights scene lights (at most NWB_SCENE_LIGHT_LIST_CAPACITY), ranked most important for this view
+// first, into outSceneLights/outSceneLightImportance and their GPU records into outLights. Because the list is
+// ranked, the bounded shadow-slot pool simply goes to its first NWB_SCENE_SHADOW_SLOT_COUNT lights (slot index ->
+// params.z; the rest keep -1 and stay fully lit). Caustic importance is written for the NWB_SCENE_MAX_LIGHTS prefix
+// the caustic producers walk.
 inline u32 ResolveSceneLights(
     Core::ECS::World& world,
+    const SceneLightView& view,
+    NWB::Impl::Scene::SceneLight* outSceneLights,
+    f32* outSceneLightImportance,
     SceneLightGpuData* outLights,
     f32* outCausticImportance,
     const u32 maxLights
@@ -114,21 +100,21 @@ inline u32 ResolveSceneLights(
         return 0u;
 
     u32 capacity = maxLights;
-    if(capacity > NWB_SCENE_MAX_LIGHTS)
-        capacity = NWB_SCENE_MAX_LIGHTS;
+    if(capacity > NWB_SCENE_LIGHT_LIST_CAPACITY)
+        capacity = NWB_SCENE_LIGHT_LIST_CAPACITY;
 
     const NWB::Impl::Scene::SceneViewBasis defaultBasis = NWB::Impl::Scene::BuildDefaultSceneViewBasis();
-    NWB::Impl::Scene::SceneLight sceneLights[NWB_SCENE_MAX_LIGHTS];
-    f32 shadowImportance[NWB_SCENE_MAX_LIGHTS] = {};
-    const usize gatheredCount = NWB::Impl::Scene::GatherSceneLights(
+    const u32 lightCount = static_cast<u32>(NWB::Impl::Scene::GatherSceneLights(
         world,
         LoadFloat(defaultBasis.forward),
-        sceneLights,
+        VectorSetW(LoadFloat(view.basis.positionDepthBias), 0.0f),
+        outSceneLights,
+        outSceneLightImportance,
         capacity
-    );
+    ));
 
-    for(usize i = 0u; i < gatheredCount; ++i){
-        const NWB::Impl::Scene::SceneLight& src = sceneLights[i];
+    for(u32 i = 0u; i < lightCount; ++i){
+        const NWB::Impl::Scene::SceneLight& src = outSceneLights[i];
         SceneLightGpuData& dst = outLights[i];
         dst.position = src.position;
         dst.direction = src.direction;
@@ -136,59 +122,71 @@ inline u32 ResolveSceneLights(
         dst.params = Float4(
             src.range,
             static_cast<f32>(src.type),
-            s_ShadowSlotUnassigned,
+            i < NWB_SCENE_SHADOW_SLOT_COUNT ? static_cast<f32>(i) : s_ShadowSlotUnassigned,
             src.enableCaustics ? s_CausticSlotUnassigned : s_CausticSlotDisabled
         ); // z = shadow slot; w = caustic slot, or disabled when the light did not opt in
         dst.params2 = Float4(src.angularRadius, src.sourceRadius, 0.f, 0.f); // soft-shadow source size
-        outCausticImportance[i] = CausticSlotImportance(LoadFloat(src.colorIntensity));
+        if(i < NWB_SCENE_MAX_LIGHTS)
+            outCausticImportance[i] = CausticSlotImportance(LoadFloat(src.colorIntensity));
     }
 
-    // Importance-ranked shadow-slot allocator: hand the bounded pool of NWB_SCENE_SHADOW_SLOT_COUNT slots to
-    // the most important lights this frame (slot index -> params.z; lights that miss out keep -1 and stay
-    // fully lit). A simple K-pass selection over <= NWB_SCENE_MAX_LIGHTS lights is trivially cheap.
-    const u32 lightCount = static_cast<u32>(gatheredCount);
-    const NWB::Impl::Scene::SceneCameraView cameraView = NWB::Impl::Scene::ResolveSceneCameraView(
-        world,
-        NWB::Impl::Scene::CameraDefaults::s_FallbackAspectRatio
-    );
-    const SIMDVector cameraPosition = cameraView.valid()
-        ? LoadFloat(cameraView.transform->position)
-        : VectorZero()
-    ;
-    for(u32 i = 0u; i < lightCount; ++i){
-        const NWB::Impl::Scene::SceneLight& light = sceneLights[i];
-        shadowImportance[i] = ShadowSlotImportance(
-            LoadFloat(light.colorIntensity),
-            VectorSet(
-                light.range,
-                static_cast<f32>(light.type),
-                s_ShadowSlotUnassigned,
-                light.enableCaustics ? s_CausticSlotUnassigned : s_CausticSlotDisabled
-            ),
-            LoadFloat(light.position),
-            cameraPosition
-        );
-    }
+    return lightCount;
+}
 
-    const u32 slotCount = (lightCount < NWB_SCENE_SHADOW_SLOT_COUNT) ? lightCount : NWB_SCENE_SHADOW_SLOT_COUNT;
-    for(u32 slot = 0u; slot < slotCount; ++slot){
-        f32 bestImportance = -1.f;
-        u32 bestIndex = lightCount;
-        for(u32 i = 0u; i < lightCount; ++i){
-            if(outLights[i].params.z >= 0.f)
-                continue;
-            const f32 importance = shadowImportance[i];
-            if(importance > bestImportance){
-                bestImportance = importance;
-                bestIndex = i;
-            }
-        }
-        if(bestIndex >= lightCount)
+// Cluster grid layout for the deferred lighting viewport. Tiles start at the LightClusterGrid default and double until
+// the grid fits the NWB_SCENE_LIGHT_CLUSTER_MAX_COUNT (offset, count) pairs the cluster buffer reserves.
+inline NWB::Impl::Scene::LightClusterGridDesc BuildSceneLightClusterDesc(const u32 width, const u32 height){
+    NWB::Impl::Scene::LightClusterGridDesc desc;
+    desc.viewportWidth = width;
+    desc.viewportHeight = height;
+    if(width == 0u || height == 0u)
+        return desc;
+
+    for(;;){
+        const u64 clusterCount =
+            static_cast<u64>(DivideUp(width, desc.tileSizePixels))
+            * static_cast<u64>(DivideUp(height, desc.tileSizePixels))
+            * static_cast<u64>(desc.depthSliceCount)
+        ;
+        if(clusterCount <= NWB_SCENE_LIGHT_CLUSTER_MAX_COUNT)
             break;
-        outLights[bestIndex].params.z = static_cast<f32>(slot);
+        desc.tileSizePixels *= 2u;
     }
+    return desc;
+}
+
+// Flattens the grid into the cluster-buffer word layout nwbSceneLightListAt() reads: an absolute (offset, count) pair
+// per cluster, the directional light indices, then every cluster list. Lists that run past wordCapacity are cut
+// short, which drops their least important lights. Returns the word count; zero when the grid is empty.
+inline u32 PackSceneLightClusters(const NWB::Impl::Scene::LightClusterGrid& grid, u32* outWords, const u32 wordCapacity){
+    if(grid.sliceCount() == 0u)
+        return 0u;
 
-    return static_cast<u32>(gatheredCount);
+    const u32 clusterCount = static_cast<u32>(grid.clusterCount());
+    const auto& directionalLights = grid.directionalLights();
+    const auto& clusterLightIndices = grid.clusterLightIndices();
+    const u32 listBase = clusterCount * 2u + static_cast<u32>(directionalLights.size());
+    if(listBase > wordCapacity)
+        return 0u;
+
+    u32 listWordCount = static_cast<u32>(clusterLightIndices.size());
+    if(listWordCount > wordCapacity - listBase)
+        listWordCount = wordCapacity - listBase;
+
+    for(u32 cluster = 0u; cluster < clusterCount; ++cluster){
+        const NWB::Impl::Scene::LightClusterRange& range = grid.cluster(cluster);
+        u32 count = 0u;
+        if(range.offset < listWordCount)
+            count = Min(range.count, listWordCount - range.offset);
+        outWords[cluster * 2u] = listBase + range.offset;
+        outWords[cluster * 2u + 1u] = count;
+    }
+    if(!directionalLights.empty())
+        NWB_MEMCPY(outWords + clusterCount * 2u, directionalLights.size() * sizeof(u32), directionalLights.data(), directionalLights.size() * sizeof(u32));
+    if(listWordCount != 0u)
+        NWB_MEMCPY(outWords + listBase, listWordCount * sizeof(u32), clusterLightIndices.data(), listWordCount * sizeof(u32));
+
+    return listBase + listWordCount;
 }
 
 // True when the light is a caustic-eligible emitter: directional (params.y ~ 0) or spot (params.y ~ 2). Point
@@ -216,8 +214,8 @@ inline u32 ResolveCausticLights(
     if(refractiveInstanceCount == 0u || lightCount == 0u)
         return 0u;
 
-    // Importance-ranked caustic-slot allocator (mirrors the shadow-slot K-pass selection in ResolveSceneLights):
-    // hand each slot to the highest-importance eligible light without one yet. Point lights never qualify.
+    // Importance-ranked caustic-slot allocator: hand each slot to the highest-importance eligible light without one
+    // yet. Point lights never qualify.
     u32 assignedCount = 0u;
     for(u32 slot = 0u; slot < NWB_SCENE_CAUSTIC_SLOT_COUNT; ++slot){
         f32 bestImportance = -1.f;
@@ -244,16 +242,30 @@ inline u32 ResolveCausticLights(
     return assignedCount;
 }
 
-inline SceneShadingGpuData ResolveSceneShadingState(Core::ECS::World& world, const f32 fallbackAspectRatio, const u32 lightCount){
+inline SceneShadingGpuData ResolveSceneShadingState(
+    const SceneLightView& view,
+    const u32 lightCount,
+    const NWB::Impl::Scene::LightClusterGrid& clusters
+){
     SceneShadingGpuData state;
-    const NWB::Impl::Scene::SceneViewBasis defaultBasis = NWB::Impl::Scene::BuildDefaultSceneViewBasis();
-
-    const NWB::Impl::Scene::SceneCameraView cameraView = NWB::Impl::Scene::ResolveSceneCameraView(world, fallbackAspectRatio);
-    const SIMDVector cameraPosition = cameraView.valid()
-        ? LoadFloat(cameraView.transform->position)
-        : LoadFloat(defaultBasis.positionDepthBias)
-    ;
+    const SIMDVector cameraPosition = LoadFloat(view.basis.positionDepthBias);
     StoreFloat(VectorSetW(cameraPosition, static_cast<f32>(lightCount)), &state.cameraPositionLightCount);
+    if(clusters.sliceCount() == 0u)
+        return state;
+
+    // The lighting shader projects each shading point with this basis, so cluster lookup never depends on how the
+    // pixel grid is laid out.
+    StoreFloat(VectorSetW(cameraPosition, clusters.nearPlane()), &state.clusterOriginNear);
+    StoreFloat(VectorSetW(LoadFloat(view.basis.right), clusters.viewScaleX()), &state.clusterRightScale);
+    StoreFloat(VectorSetW(LoadFloat(view.basis.up), clusters.viewScaleY()), &state.clusterUpScale);
+    StoreFloat(VectorSetW(LoadFloat(view.basis.forward), clusters.logDepthScale()), &state.clusterForwardSliceScale);
+    state.clusterGrid = Float4(
+        static_cast<f32>(clusters.tileCountX()),
+        static_cast<f32>(clusters.tileCountY()),
+        static_cast<f32>(clusters.sliceCount()),
+        static_cast<f32>(clusters.directionalLights().size())
+    );
+    state.clusterTile = Float4(clusters.tileNdcWidth(), clusters.tileNdcHeight(), 0.f, 0.f);
     return state;
 }
 
@@ -63,6 +63,7 @@ RendererMaterialState::RendererMaterialState(Core::Alloc::GlobalArena& arena)
     , m_pipelines(0, MaterialPipelineKeyHasher(), MaterialPipelineKeyEqualTo(), arena)
     , m_instanceMutableCache(0, Hasher<Core::ECS::EntityID>(), EqualTo<Core::ECS::EntityID>(), arena)
     , m_loggedMaterialPaths(0, Hasher<Name>(), EqualTo<Name>(), arena)
+    , m_passWorldBoundsCache(arena)
 {}
 
 
@@ -70,7 +71,9 @@ void RendererMaterialState::invalidateResources(){
     m_pipelines.clear();
     m_instanceMutableCache.clear();
     m_loggedMaterialPaths.clear();
+    m_passWorldBoundsCache.clear();
     m_instanceMutableCacheComponentMutationVersion = 0u;
+    m_instanceMutableCacheRemovedSinceTick = 0u;
 }
 
 
@@ -132,6 +135,7 @@ void RendererDeferredState::invalidateResources(){
     m_lightingBindingLayout.reset();
     m_sceneShadingBuffer.reset();
     m_lightBuffer.reset();
+    m_lightClusterBuffer.reset();
     m_compositeVertexShader.reset();
     m_lightingComputeShader.reset();
     m_lightingPipeline.reset();
@@ -143,8 +147,13 @@ void RendererDeferredState::invalidateResources(){
     m_presentPixelShader.reset();
     m_presentPipeline.reset();
     m_sceneShadingGpuDataValid = false;
+    m_lightGpuDataHash = 0u;
     m_lightGpuDataCount = 0u;
     m_lightGpuDataValid = false;
+    m_lightClusterGpuDataHash = 0u;
+    m_lightClusterGpuDataWordCount = 0u;
+    m_lightClusterGpuDataValid = false;
+    m_lightClusterGrid.clear();
     m_targets = DeferredFrameTargets{};
 }
 
@@ -7,6 +7,7 @@
 
 #include <impl/ecs_render/kernel/renderer_types.h>
 #include <impl/ecs_render/kernel/renderer_constants_private.h>
+#include <impl/ecs_render/shared/renderer_push_constants_private.h>
 
 #include <core/ecs/entity_id.h>
 #include <core/graphics/rhi/gpu_descriptor_heap.h>
@@ -20,6 +21,7 @@
 #include <impl/assets/graphics/gi/surfel/surfel_binding_slots.h>
 #include <impl/assets_texture/loader.h>
 #include <impl/assets_sampler/loader.h>
+#include <impl/ecs_scene/light_clusters.h>
 
 #include <global/generic.h>
 #include <global/containers.h>   // dynamic Vector storage for the per-frame SW distinct-mesh table
@@ -137,7 +139,9 @@ private:
     HashMap<MaterialPipelineKey, MaterialPipelineResources, MaterialPipelineKeyHasher, MaterialPipelineKeyEqualTo, Core::Alloc::GlobalArena> m_pipelines;
     HashMap<Core::ECS::EntityID, MaterialInstanceMutableCacheEntry, Hasher<Core::ECS::EntityID>, EqualTo<Core::ECS::EntityID>, Core::Alloc::GlobalArena> m_instanceMutableCache;
     HashMap<Name, RenderPath::Enum, Hasher<Name>, EqualTo<Name>, Core::Alloc::GlobalArena> m_loggedMaterialPaths;
+    Vector<MaterialPassWorldBoundsCacheEntry, Core::Alloc::GlobalArena> m_passWorldBoundsCache;
     u64 m_instanceMutableCacheComponentMutationVersion = 0u;
+    u32 m_instanceMutableCacheRemovedSinceTick = 0u;
 };
 
 class RendererDrawState final : NoCopy{
@@ -234,7 +238,13 @@ class RendererDeferredState final : NoCopy{
     friend class RendererRayTracingSystem;
 
 public:
-    RendererDeferredState() = default;
+    explicit RendererDeferredState(Core::Alloc::GlobalArena& arena)
+        : m_lightClusterGrid(arena)
+        , m_sceneLights(arena)
+        , m_sceneLightImportance(arena)
+        , m_lightGpuUploadData(arena)
+        , m_lightClusterGpuUploadData(arena)
+    {}
 
 
 public:
@@ -245,6 +255,7 @@ private:
     Core::BindingLayoutHandle m_lightingBindingLayout;
     Core::BufferHandle m_sceneShadingBuffer;
     Core::BufferHandle m_lightBuffer;
+    Core::BufferHandle m_lightClusterBuffer;
     Core::ShaderHandle m_compositeVertexShader;
     Core::ShaderHandle m_lightingComputeShader;
     Core::ComputePipelineHandle m_lightingPipeline;
@@ -257,10 +268,20 @@ private:
     Core::GraphicsPipelineHandle m_presentPipeline;
     u8 m_sceneShadingGpuData[sizeof(f32) * NWB_SCENE_SHADING_BUFFER_FLOAT_COUNT] = {};
     bool m_sceneShadingGpuDataValid = false;
-    // Cached bytes avoid redundant light-buffer uploads.
-    u8 m_lightGpuData[sizeof(f32) * NWB_SCENE_LIGHT_RECORD_FLOAT_COUNT * NWB_SCENE_MAX_LIGHTS] = {};
+    // Per-frame scratch: the ranked scene lights with their importance, the cluster grid built from them, and the
+    // packed light-list and cluster-word payloads. The graph copies payloads into its own upload blobs, so only
+    // their hashes are kept to skip redundant uploads once the prefix packet accepts.
+    Scene::LightClusterGrid m_lightClusterGrid;
+    Vector<Scene::SceneLight, Core::Alloc::GlobalArena> m_sceneLights;
+    Vector<f32, Core::Alloc::GlobalArena> m_sceneLightImportance;
+    Vector<ECSRenderDetail::SceneLightGpuData, Core::Alloc::GlobalArena> m_lightGpuUploadData;
+    Vector<u32, Core::Alloc::GlobalArena> m_lightClusterGpuUploadData;
+    u64 m_lightGpuDataHash = 0u;
     u32 m_lightGpuDataCount = 0u;
     bool m_lightGpuDataValid = false;
+    u64 m_lightClusterGpuDataHash = 0u;
+    u32 m_lightClusterGpuDataWordCount = 0u;
+    bool m_lightClusterGpuDataValid = false;
     DeferredFrameTargets m_targets;
 };
 
@@ -55,6 +55,34 @@ static_assert((offsetof(TransformComponent, scale) % alignof(Float4)) == 0, "Tra
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// Parents the entity in the transform hierarchy. TransformHierarchySystem owns the entity's TransformComponent and
+// rewrites it as local composed with the parent world transform; set dirty after changing local or parent. A parent
+// without its own TransformParentComponent is a hierarchy root whose TransformComponent stays authored.
+struct alignas(Float4) TransformParentComponent{
+    TransformComponent local;
+    Core::ECS::EntityID parent = Core::ECS::ENTITY_ID_INVALID;
+    bool dirty = true;
+};
+
+static_assert(IsStandardLayout_V<TransformParentComponent>, "TransformParentComponent must stay layout-stable for ECS storage");
+static_assert(IsTriviallyCopyable_V<TransformParentComponent>, "TransformParentComponent must stay cheap to move in dense ECS storage");
+static_assert((offsetof(TransformParentComponent, local) % alignof(Float4)) == 0, "TransformParentComponent::local must stay aligned");
+
+// Cached world matrix of a hierarchy node. version is the TransformHierarchySystem change version at which world last
+// changed, so consumers that remember the last version they processed can skip unchanged nodes.
+struct alignas(Float4) WorldTransformComponent{
+    Float34 world = Float34Identity();
+    u64 version = 0u;
+};
+
+static_assert(IsStandardLayout_V<WorldTransformComponent>, "WorldTransformComponent must stay layout-stable for ECS storage");
+static_assert(IsTriviallyCopyable_V<WorldTransformComponent>, "WorldTransformComponent must stay cheap to move in dense ECS storage");
+static_assert((offsetof(WorldTransformComponent, world) % alignof(Float4)) == 0, "WorldTransformComponent::world must stay aligned");
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 struct ActiveCameraComponent{
     Core::ECS::EntityID camera = Core::ECS::ENTITY_ID_INVALID;
 };
@@ -0,0 +1,472 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "light_clusters.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_SCENE_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_light_clusters{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+inline constexpr u32 s_BlockLaneCount = 4u;
+// Padding lanes sit so far away that their squared distance to any cluster overflows and never passes the test.
+inline constexpr f32 s_PaddingCoordinate = 1e30f;
+inline constexpr f32 s_PointLightBackCullSlack = Limit<f32>::s_Max;
+
+
+struct ClusterBox{
+    SIMDVector minX;
+    SIMDVector minY;
+    SIMDVector minZ;
+    SIMDVector maxX;
+    SIMDVector maxY;
+    SIMDVector maxZ;
+};
+
+struct ClusterSphere{
+    SIMDVector centerX;
+    SIMDVector centerY;
+    SIMDVector centerZ;
+    SIMDVector radius;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+[[nodiscard]] static ClusterBox BuildClusterBox(
+    const f32 minX,
+    const f32 minY,
+    const f32 minZ,
+    const f32 maxX,
+    const f32 maxY,
+    const f32 maxZ
+){
+    return ClusterBox{
+        VectorReplicate(minX),
+        VectorReplicate(minY),
+        VectorReplicate(minZ),
+        VectorReplicate(maxX),
+        VectorReplicate(maxY),
+        VectorReplicate(maxZ),
+    };
+}
+
+[[nodiscard]] static ClusterSphere BuildClusterSphere(
+    const f32 minX,
+    const f32 minY,
+    const f32 minZ,
+    const f32 maxX,
+    const f32 maxY,
+    const f32 maxZ
+){
+    const f32 extentX = (maxX - minX) * 0.5f;
+    const f32 extentY = (maxY - minY) * 0.5f;
+    const f32 extentZ = (maxZ - minZ) * 0.5f;
+    return ClusterSphere{
+        VectorReplicate(minX + extentX),
+        VectorReplicate(minY + extentY),
+        VectorReplicate(minZ + extentZ),
+        VectorReplicate(Sqrt(extentX * extentX + extentY * extentY + extentZ * extentZ)),
+    };
+}
+
+// One lane per light: set when the light's influence sphere reaches the box.
+template<typename LightBlock>
+[[nodiscard]] NWB_INLINE u32 SphereBoxOverlapMask(const LightBlock& block, const ClusterBox& box){
+    const SIMDVector zero = VectorZero();
+    const SIMDVector centerX = LoadFloat(block.centerX);
+    const SIMDVector centerY = LoadFloat(block.centerY);
+    const SIMDVector centerZ = LoadFloat(block.centerZ);
+    const SIMDVector radius = LoadFloat(block.radius);
+
+    const SIMDVector outsideX = VectorMax(VectorMax(VectorSubtract(box.minX, centerX), VectorSubtract(centerX, box.maxX)), zero);
+    const SIMDVector outsideY = VectorMax(VectorMax(VectorSubtract(box.minY, centerY), VectorSubtract(centerY, box.maxY)), zero);
+    const SIMDVector outsideZ = VectorMax(VectorMax(VectorSubtract(box.minZ, centerZ), VectorSubtract(centerZ, box.maxZ)), zero);
+    const SIMDVector distanceSquared = VectorMultiplyAdd(
+        outsideZ,
+        outsideZ,
+        VectorMultiplyAdd(outsideY, outsideY, VectorMultiply(outsideX, outsideX))
+    );
+    return VectorMoveMask(VectorLessOrEqual(distanceSquared, VectorMultiply(radius, radius))) & VectorComponentMask::s_XYZW;
+}
+
+// One lane per light: cleared when the cluster's bounding sphere lies outside the light's cone (point lights use a
+// full cone, so only their range can reject). The cone is bounded by the light range along its axis.
+template<typename LightBlock>
+[[nodiscard]] NWB_INLINE u32 ConeSphereOverlapMask(const LightBlock& block, const ClusterSphere& sphere){
+    const SIMDVector toSphereX = VectorSubtract(sphere.centerX, LoadFloat(block.centerX));
+    const SIMDVector toSphereY = VectorSubtract(sphere.centerY, LoadFloat(block.centerY));
+    const SIMDVector toSphereZ = VectorSubtract(sphere.centerZ, LoadFloat(block.centerZ));
+    const SIMDVector lengthSquared = VectorMultiplyAdd(
+        toSphereZ,
+        toSphereZ,
+        VectorMultiplyAdd(toSphereY, toSphereY, VectorMultiply(toSphereX, toSphereX))
+    );
+    const SIMDVector axial = VectorMultiplyAdd(
+        toSphereZ,
+        LoadFloat(block.axisZ),
+        VectorMultiplyAdd(toSphereY, LoadFloat(block.axisY), VectorMultiply(toSphereX, LoadFloat(block.axisX)))
+    );
+    const SIMDVector radial = VectorSqrt(VectorMax(VectorSubtract(lengthSquared, VectorMultiply(axial, axial)), VectorZero()));
+    const SIMDVector closest = VectorSubtract(
+        VectorMultiply(LoadFloat(block.coneCos), radial),
+        VectorMultiply(axial, LoadFloat(block.coneSin))
+    );
+
+    const SIMDVector angleCull = VectorGreater(closest, sphere.radius);
+    const SIMDVector frontCull = VectorGreater(axial, VectorAdd(sphere.radius, LoadFloat(block.radius)));
+    const SIMDVector backCull = VectorLess(axial, VectorNegate(VectorAdd(sphere.radius, LoadFloat(block.backCullSlack))));
+    const SIMDVector culled = VectorOrInt(VectorOrInt(angleCull, frontCull), backCull);
+    return ~VectorMoveMask(culled) & VectorComponentMask::s_XYZW;
+}
+
+template<typename LightBlock>
+static void ResetBlock(LightBlock& block){
+    block.centerX = Float4(s_PaddingCoordinate, s_PaddingCoordinate, s_PaddingCoordinate, s_PaddingCoordinate);
+    block.centerY = Float4(0.0f, 0.0f, 0.0f, 0.0f);
+    block.centerZ = Float4(0.0f, 0.0f, 0.0f, 0.0f);
+    block.radius = Float4(0.0f, 0.0f, 0.0f, 0.0f);
+    block.axisX = Float4(0.0f, 0.0f, 0.0f, 0.0f);
+    block.axisY = Float4(0.0f, 0.0f, 0.0f, 0.0f);
+    block.axisZ = Float4(0.0f, 0.0f, 1.0f, 0.0f);
+    block.coneCos = Float4(-1.0f, -1.0f, -1.0f, -1.0f);
+    block.coneSin = Float4(0.0f, 0.0f, 0.0f, 0.0f);
+    block.backCullSlack = Float4(0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+template<typename LightBlock>
+static void CopyBlockLane(LightBlock& dst, const u32 dstLane, const LightBlock& src, const u32 srcLane){
+    dst.centerX.raw[dstLane] = src.centerX.raw[srcLane];
+    dst.centerY.raw[dstLane] = src.centerY.raw[srcLane];
+    dst.centerZ.raw[dstLane] = src.centerZ.raw[srcLane];
+    dst.radius.raw[dstLane] = src.radius.raw[srcLane];
+    dst.axisX.raw[dstLane] = src.axisX.raw[srcLane];
+    dst.axisY.raw[dstLane] = src.axisY.raw[srcLane];
+    dst.axisZ.raw[dstLane] = src.axisZ.raw[srcLane];
+    dst.coneCos.raw[dstLane] = src.coneCos.raw[srcLane];
+    dst.coneSin.raw[dstLane] = src.coneSin.raw[srcLane];
+    dst.backCullSlack.raw[dstLane] = src.backCullSlack.raw[srcLane];
+}
+
+[[nodiscard]] static bool IsClusteredLight(const SceneLight& light){
+    return (light.type == LightType::Point || light.type == LightType::Spot) && IsFinite(light.range) && light.range > 0.0f;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+LightClusterGrid::LightClusterGrid(Core::Alloc::GlobalArena& arena)
+    : m_arena(arena)
+    , m_clusters(arena)
+    , m_clusterLightIndices(arena)
+    , m_directionalLights(arena)
+    , m_localLights(arena)
+    , m_lightBlocks(arena)
+    , m_sliceDepths(arena)
+    , m_scratchImportance(arena)
+    , m_scratchOrder(arena)
+    , m_rows(arena)
+{}
+
+
+bool LightClusterGrid::build(
+    const LightClusterGridDesc& desc,
+    const SceneViewBasis& viewBasis,
+    const CameraProjection& projection,
+    const SceneLight* lights,
+    const usize lightCount,
+    Core::Alloc::ThreadPool& threadPool,
+    const f32* lightImportance
+){
+    clear();
+
+    if(desc.viewportWidth == 0u || desc.viewportHeight == 0u || desc.tileSizePixels == 0u)
+        return false;
+    if(desc.depthSliceCount == 0u || desc.maxLightsPerCluster == 0u)
+        return false;
+    if(!CameraProjectionStorageValid(projection))
+        return false;
+    if(lightCount != 0u && !lights)
+        return false;
+    if(lightCount > static_cast<usize>(Limit<u32>::s_Max))
+        return false;
+
+    m_tileCountX = DivideUp(desc.viewportWidth, desc.tileSizePixels);
+    m_tileCountY = DivideUp(desc.viewportHeight, desc.tileSizePixels);
+    m_sliceCount = desc.depthSliceCount;
+    m_maxLightsPerCluster = desc.maxLightsPerCluster;
+    m_tileNdcWidth = 2.0f * static_cast<f32>(desc.tileSizePixels) / static_cast<f32>(desc.viewportWidth);
+    m_tileNdcHeight = 2.0f * static_cast<f32>(desc.tileSizePixels) / static_cast<f32>(desc.viewportHeight);
+    m_viewScaleX = projection.tanHalfVerticalFov * projection.aspectRatio;
+    m_viewScaleY = projection.tanHalfVerticalFov;
+    m_nearPlane = projection.nearPlane;
+    m_farPlane = projection.farPlane;
+
+    // Exponential slices keep clusters roughly cubic in view space: near slices stay thin where tiles are small.
+    const f32 depthRatio = m_farPlane / m_nearPlane;
+    m_logDepthScale = static_cast<f32>(m_sliceCount) / Log(depthRatio);
+    m_sliceDepths.resize(static_cast<usize>(m_sliceCount) + 1u);
+    for(u32 slice = 0u; slice <= m_sliceCount; ++slice)
+        m_sliceDepths[slice] = m_nearPlane * Pow(depthRatio, static_cast<f32>(slice) / static_cast<f32>(m_sliceCount));
+    m_sliceDepths[m_sliceCount] = m_farPlane;
+
+    rankLights(desc, viewBasis, lights, lightCount, lightImportance);
+    packLightBlocks(viewBasis, lights);
+
+    const u32 rowCount = m_sliceCount * m_tileCountY;
+    m_clusters.resize(static_cast<usize>(rowCount) * m_tileCountX);
+    while(m_rows.size() < rowCount)
+        m_rows.emplace_back(m_arena);
+
+    threadPool.parallelFor(0u, static_cast<usize>(rowCount), [this](const usize rowIndex){
+        assignRow(static_cast<u32>(rowIndex));
+    });
+
+    // Rows finish in any order; stitching them serially keeps the flattened index list identical across runs.
+    usize assignmentTotal = 0u;
+    for(u32 rowIndex = 0u; rowIndex < rowCount; ++rowIndex)
+        assignmentTotal += m_rows[rowIndex].lightIndices.size();
+    m_clusterLightIndices.reserve(assignmentTotal);
+
+    for(u32 rowIndex = 0u; rowIndex < rowCount; ++rowIndex){
+        const RowScratch& row = m_rows[rowIndex];
+        const usize rowBase = static_cast<usize>(rowIndex) * m_tileCountX;
+        u32 rowOffset = 0u;
+        for(u32 tileX = 0u; tileX < m_tileCountX; ++tileX){
+            LightClusterRange& range = m_clusters[rowBase + tileX];
+            range.offset = static_cast<u32>(m_clusterLightIndices.size()) + rowOffset;
+            range.count = row.clusterCounts[tileX];
+            rowOffset += range.count;
+        }
+        m_clusterLightIndices.insert(m_clusterLightIndices.end(), row.lightIndices.begin(), row.lightIndices.end());
+    }
+    return true;
+}
+
+void LightClusterGrid::clear(){
+    m_tileCountX = 0u;
+    m_tileCountY = 0u;
+    m_sliceCount = 0u;
+    m_clusters.clear();
+    m_clusterLightIndices.clear();
+    m_directionalLights.clear();
+    m_localLights.clear();
+    m_lightBlocks.clear();
+    m_sliceDepths.clear();
+}
+
+u32 LightClusterGrid::sliceForDepth(const f32 viewDepth)const{
+    if(m_sliceCount == 0u || !(viewDepth > m_nearPlane))
+        return 0u;
+
+    const f32 slice = Floor(Log(viewDepth / m_nearPlane) * m_logDepthScale);
+    if(!(slice < static_cast<f32>(m_sliceCount - 1u)))
+        return m_sliceCount - 1u;
+    return static_cast<u32>(slice);
+}
+
+
+void LightClusterGrid::rankLights(
+    const LightClusterGridDesc& desc,
+    const SceneViewBasis& viewBasis,
+    const SceneLight* lights,
+    const usize lightCount,
+    const f32* lightImportance
+){
+    const SIMDVector viewPosition = LoadFloat(viewBasis.positionDepthBias);
+
+    m_scratchImportance.resize(lightCount);
+    m_scratchOrder.clear();
+    m_scratchOrder.reserve(lightCount);
+    for(usize lightIndex = 0u; lightIndex < lightCount; ++lightIndex){
+        const SceneLight& light = lights[lightIndex];
+        if(light.type != LightType::Directional && !__hidden_light_clusters::IsClusteredLight(light))
+            continue;
+
+        m_scratchImportance[lightIndex] = lightImportance
+            ? lightImportance[lightIndex]
+            : SceneLightImportance(light, viewPosition)
+        ;
+        m_scratchOrder.push_back(static_cast<u32>(lightIndex));
+    }
+
+    // Ties fall back to input order so the ranking, and with it every cluster list, is deterministic.
+    Sort(m_scratchOrder.begin(), m_scratchOrder.end(), [this](const u32 lhs, const u32 rhs){
+        if(m_scratchImportance[lhs] != m_scratchImportance[rhs])
+            return m_scratchImportance[lhs] > m_scratchImportance[rhs];
+        return lhs < rhs;
+    });
+
+    usize keptCount = m_scratchOrder.size();
+    if(desc.lightBudget != 0u && keptCount > desc.lightBudget)
+        keptCount = desc.lightBudget;
+
+    m_localLights.reserve(keptCount);
+    for(usize rank = 0u; rank < keptCount; ++rank){
+        const u32 lightIndex = m_scratchOrder[rank];
+        if(lights[lightIndex].type == LightType::Directional)
+            m_directionalLights.push_back(lightIndex);
+        else
+            m_localLights.push_back(lightIndex);
+    }
+}
+
+void LightClusterGrid::packLightBlocks(const SceneViewBasis& viewBasis, const SceneLight* lights){
+    const SIMDVector viewPosition = VectorSetW(LoadFloat(viewBasis.positionDepthBias), 0.0f);
+    const SIMDVector right = LoadFloat(viewBasis.right);
+    const SIMDVector up = LoadFloat(viewBasis.up);
+    const SIMDVector forward = LoadFloat(viewBasis.forward);
+
+    m_lightBlocks.resize(DivideUp(m_localLights.size(), static_cast<usize>(__hidden_light_clusters::s_BlockLaneCount)));
+    for(LightBlock& block : m_lightBlocks)
+        __hidden_light_clusters::ResetBlock(block);
+
+    for(usize localIndex = 0u; localIndex < m_localLights.size(); ++localIndex){
+        const SceneLight& light = lights[m_localLights[localIndex]];
+        LightBlock& block = m_lightBlocks[localIndex / __hidden_light_clusters::s_BlockLaneCount];
+        const u32 lane = static_cast<u32>(localIndex % __hidden_light_clusters::s_BlockLaneCount);
+
+        const SIMDVector offset = VectorSubtract(VectorSetW(LoadFloat(light.position), 0.0f), viewPosition);
+        block.centerX.raw[lane] = VectorGetX(Vector3Dot(offset, right));
+        block.centerY.raw[lane] = VectorGetX(Vector3Dot(offset, up));
+        block.centerZ.raw[lane] = VectorGetX(Vector3Dot(offset, forward));
+        block.radius.raw[lane] = light.range;
+
+        if(light.type == LightType::Spot){
+            const SIMDVector axis = LoadFloat(light.direction);
+            const f32 coneCos = light.direction.w;
+            block.axisX.raw[lane] = VectorGetX(Vector3Dot(axis, right));
+            block.axisY.raw[lane] = VectorGetX(Vector3Dot(axis, up));
+            block.axisZ.raw[lane] = VectorGetX(Vector3Dot(axis, forward));
+            block.coneCos.raw[lane] = coneCos;
+            block.coneSin.raw[lane] = Sqrt(Max(1.0f - coneCos * coneCos, 0.0f));
+            block.backCullSlack.raw[lane] = 0.0f;
+        }
+        else{
+            block.coneCos.raw[lane] = -1.0f;
+            block.coneSin.raw[lane] = 0.0f;
+            block.backCullSlack.raw[lane] = __hidden_light_clusters::s_PointLightBackCullSlack;
+        }
+    }
+}
+
+void LightClusterGrid::assignRow(const u32 rowIndex){
+    RowScratch& row = m_rows[rowIndex];
+    row.candidates.clear();
+    row.lightIndices.clear();
+    row.clusterCounts.assign(m_tileCountX, 0u);
+
+    const u32 slice = rowIndex / m_tileCountY;
+    const u32 tileY = rowIndex % m_tileCountY;
+    const f32 nearDepth = m_sliceDepths[slice];
+    const f32 farDepth = m_sliceDepths[slice + 1u];
+
+    // Tile rows run top to bottom while NDC y grows upward.
+    const f32 ndcTop = 1.0f - static_cast<f32>(tileY) * m_tileNdcHeight;
+    const f32 ndcBottom = Max(ndcTop - m_tileNdcHeight, -1.0f);
+    const f32 minY = Min(ndcBottom * nearDepth, ndcBottom * farDepth) * m_viewScaleY;
+    const f32 maxY = Max(ndcTop * nearDepth, ndcTop * farDepth) * m_viewScaleY;
+
+    // Broad phase against the whole row slab, so each tile only walks the lights that can reach its row.
+    const __hidden_light_clusters::ClusterBox rowBox = __hidden_light_clusters::BuildClusterBox(
+        -farDepth * m_viewScaleX,
+        minY,
+        nearDepth,
+        farDepth * m_viewScaleX,
+        maxY,
+        farDepth
+    );
+    for(usize blockIndex = 0u; blockIndex < m_lightBlocks.size(); ++blockIndex){
+        u32 mask = __hidden_light_clusters::SphereBoxOverlapMask(m_lightBlocks[blockIndex], rowBox);
+        for(u32 lane = 0u; mask != 0u; ++lane, mask >>= 1u){
+            if((mask & 1u) != 0u)
+                row.candidates.push_back(static_cast<u32>(blockIndex * __hidden_light_clusters::s_BlockLaneCount + lane));
+        }
+    }
+    if(row.candidates.empty())
+        return;
+
+    row.candidateBlocks.resize(DivideUp(row.candidates.size(), static_cast<usize>(__hidden_light_clusters::s_BlockLaneCount)));
+    for(LightBlock& block : row.candidateBlocks)
+        __hidden_light_clusters::ResetBlock(block);
+    for(usize candidateIndex = 0u; candidateIndex < row.candidates.size(); ++candidateIndex){
+        const u32 localIndex = row.candidates[candidateIndex];
+        __hidden_light_clusters::CopyBlockLane(
+            row.candidateBlocks[candidateIndex / __hidden_light_clusters::s_BlockLaneCount],
+            static_cast<u32>(candidateIndex % __hidden_light_clusters::s_BlockLaneCount),
+            m_lightBlocks[localIndex / __hidden_light_clusters::s_BlockLaneCount],
+            localIndex % __hidden_light_clusters::s_BlockLaneCount
+        );
+    }
+
+    for(u32 tileX = 0u; tileX < m_tileCountX; ++tileX){
+        const f32 ndcLeft = -1.0f + static_cast<f32>(tileX) * m_tileNdcWidth;
+        const f32 ndcRight = Min(ndcLeft + m_tileNdcWidth, 1.0f);
+        const f32 minX = Min(ndcLeft * nearDepth, ndcLeft * farDepth) * m_viewScaleX;
+        const f32 maxX = Max(ndcRight * nearDepth, ndcRight * farDepth) * m_viewScaleX;
+        const __hidden_light_clusters::ClusterBox box = __hidden_light_clusters::BuildClusterBox(
+            minX,
+            minY,
+            nearDepth,
+            maxX,
+            maxY,
+            farDepth
+        );
+        const __hidden_light_clusters::ClusterSphere sphere = __hidden_light_clusters::BuildClusterSphere(
+            minX,
+            minY,
+            nearDepth,
+            maxX,
+            maxY,
+            farDepth
+        );
+
+        // Candidates are in rank order, so stopping at the cap keeps the cluster's most important lights.
+        u32 count = 0u;
+        for(usize blockIndex = 0u; blockIndex < row.candidateBlocks.size() && count < m_maxLightsPerCluster; ++blockIndex){
+            const LightBlock& block = row.candidateBlocks[blockIndex];
+            u32 mask = __hidden_light_clusters::SphereBoxOverlapMask(block, box)
+                & __hidden_light_clusters::ConeSphereOverlapMask(block, sphere)
+            ;
+            for(u32 lane = 0u; mask != 0u && count < m_maxLightsPerCluster; ++lane, mask >>= 1u){
+                if((mask & 1u) == 0u)
+                    continue;
+
+                const u32 candidate = row.candidates[blockIndex * __hidden_light_clusters::s_BlockLaneCount + lane];
+                row.lightIndices.push_back(m_localLights[candidate]);
+                ++count;
+            }
+        }
+        row.clusterCounts[tileX] = count;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_SCENE_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
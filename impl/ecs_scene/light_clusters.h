@@ -0,0 +1,187 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "camera.h"
+#include "lighting.h"
+
+#include <core/alloc/general.h>
+#include <core/alloc/thread.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_SCENE_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace LightClusterDefaults{
+    // 64 px tiles and 24 exponential depth slices give a 30x17x24 grid at 1920x1080.
+    inline constexpr u32 s_TileSizePixels = 64u;
+    inline constexpr u32 s_DepthSliceCount = 24u;
+    inline constexpr u32 s_MaxLightsPerCluster = 128u;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+struct LightClusterGridDesc{
+    u32 viewportWidth = 0u;
+    u32 viewportHeight = 0u;
+    u32 tileSizePixels = LightClusterDefaults::s_TileSizePixels;
+    u32 depthSliceCount = LightClusterDefaults::s_DepthSliceCount;
+    // Clusters keep their most important lights when more than this many touch them.
+    u32 maxLightsPerCluster = LightClusterDefaults::s_MaxLightsPerCluster;
+    // Upper bound on the lights the grid considers at all; zero keeps every light.
+    u32 lightBudget = 0u;
+};
+
+struct LightClusterRange{
+    u32 offset = 0u;
+    u32 count = 0u;
+};
+
+
+// CPU-built froxel light lists. The view frustum is split into screen tiles and exponential view-space depth slices;
+// each cluster stores the point and spot lights whose influence reaches its view-space bounds. Lights are ranked
+// by SceneLightImportance first, so both the global budget and the per-cluster cap drop the least important lights
+// and every cluster list is ordered most important first. Directional lights touch every cluster and are kept in a
+// separate list instead of being written into each one.
+//
+// Cluster index = (slice * tileCountY + tileY) * tileCountX + tileX, with tile (0, 0) at the top-left of the
+// viewport. Light indices in clusterLightIndices() and directionalLights() refer to the input light array.
+class LightClusterGrid : NoCopy{
+private:
+    // Four lights per block so the overlap tests run one SIMD lane per light.
+    struct alignas(Float4) LightBlock{
+        Float4 centerX;
+        Float4 centerY;
+        Float4 centerZ;
+        Float4 radius;
+        Float4 axisX;
+        Float4 axisY;
+        Float4 axisZ;
+        Float4 coneCos;
+        Float4 coneSin;
+        // Zero for spot lights; a huge value for point lights so the cone's back-face test never rejects them.
+        Float4 backCullSlack;
+    };
+
+    struct RowScratch{
+        Vector<u32, Core::Alloc::GlobalArena> candidates;
+        Vector<LightBlock, Core::Alloc::GlobalArena> candidateBlocks;
+        Vector<u32, Core::Alloc::GlobalArena> lightIndices;
+        Vector<u32, Core::Alloc::GlobalArena> clusterCounts;
+
+        explicit RowScratch(Core::Alloc::GlobalArena& arena)
+            : candidates(arena)
+            , candidateBlocks(arena)
+            , lightIndices(arena)
+            , clusterCounts(arena)
+        {}
+    };
+
+
+public:
+    explicit LightClusterGrid(Core::Alloc::GlobalArena& arena);
+
+
+public:
+    // Rebuilds every cluster list for one view. Returns false when the viewport, projection or tile layout is
+    // unusable; the grid is empty afterwards. lightImportance, when given, holds SceneLightImportance for each input
+    // light relative to the view (as GatherSceneLights reports it) so the ranking does not evaluate it again.
+    bool build(
+        const LightClusterGridDesc& desc,
+        const SceneViewBasis& viewBasis,
+        const CameraProjection& projection,
+        const SceneLight* lights,
+        usize lightCount,
+        Core::Alloc::ThreadPool& threadPool,
+        const f32* lightImportance = nullptr
+    );
+    void clear();
+
+public:
+    [[nodiscard]] u32 tileCountX()const{ return m_tileCountX; }
+    [[nodiscard]] u32 tileCountY()const{ return m_tileCountY; }
+    [[nodiscard]] u32 sliceCount()const{ return m_sliceCount; }
+    [[nodiscard]] usize clusterCount()const{ return m_clusters.size(); }
+    [[nodiscard]] u32 clusterIndex(const u32 tileX, const u32 tileY, const u32 slice)const{
+        return (slice * m_tileCountY + tileY) * m_tileCountX + tileX;
+    }
+    // Slice holding a positive view-space depth, clamped to the grid.
+    [[nodiscard]] u32 sliceForDepth(f32 viewDepth)const;
+
+    // Grid geometry for consumers that locate clusters themselves (the deferred lighting shader).
+    [[nodiscard]] f32 tileNdcWidth()const{ return m_tileNdcWidth; }
+    [[nodiscard]] f32 tileNdcHeight()const{ return m_tileNdcHeight; }
+    [[nodiscard]] f32 viewScaleX()const{ return m_viewScaleX; }
+    [[nodiscard]] f32 viewScaleY()const{ return m_viewScaleY; }
+    [[nodiscard]] f32 nearPlane()const{ return m_nearPlane; }
+    [[nodiscard]] f32 logDepthScale()const{ return m_logDepthScale; }
+
+    [[nodiscard]] const LightClusterRange& cluster(const usize index)const{ return m_clusters[index]; }
+    [[nodiscard]] const Vector<u32, Core::Alloc::GlobalArena>& clusterLightIndices()const{ return m_clusterLightIndices; }
+    [[nodiscard]] const Vector<u32, Core::Alloc::GlobalArena>& directionalLights()const{ return m_directionalLights; }
+    // Point and spot lights that survived the budget, most important first.
+    [[nodiscard]] usize clusteredLightCount()const{ return m_localLights.size(); }
+    // Total number of light references across all clusters.
+    [[nodiscard]] usize assignmentCount()const{ return m_clusterLightIndices.size(); }
+
+
+private:
+    void rankLights(
+        const LightClusterGridDesc& desc,
+        const SceneViewBasis& viewBasis,
+        const SceneLight* lights,
+        usize lightCount,
+        const f32* lightImportance
+    );
+    void packLightBlocks(const SceneViewBasis& viewBasis, const SceneLight* lights);
+    void assignRow(u32 rowIndex);
+
+
+private:
+    Core::Alloc::GlobalArena& m_arena;
+
+    u32 m_tileCountX = 0u;
+    u32 m_tileCountY = 0u;
+    u32 m_sliceCount = 0u;
+    u32 m_maxLightsPerCluster = 0u;
+    f32 m_tileNdcWidth = 0.0f;
+    f32 m_tileNdcHeight = 0.0f;
+    f32 m_viewScaleX = 0.0f;
+    f32 m_viewScaleY = 0.0f;
+    f32 m_nearPlane = 0.0f;
+    f32 m_farPlane = 0.0f;
+    f32 m_logDepthScale = 0.0f;
+
+    Vector<LightClusterRange, Core::Alloc::GlobalArena> m_clusters;
+    Vector<u32, Core::Alloc::GlobalArena> m_clusterLightIndices;
+    Vector<u32, Core::Alloc::GlobalArena> m_directionalLights;
+    // Input indices of the clustered lights in rank order; block lane i maps to m_localLights[i].
+    Vector<u32, Core::Alloc::GlobalArena> m_localLights;
+    Vector<LightBlock, Core::Alloc::GlobalArena> m_lightBlocks;
+    Vector<f32, Core::Alloc::GlobalArena> m_sliceDepths;
+
+    Vector<f32, Core::Alloc::GlobalArena> m_scratchImportance;
+    Vector<u32, Core::Alloc::GlobalArena> m_scratchOrder;
+    Vector<RowScratch, Core::Alloc::GlobalArena> m_rows;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_SCENE_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
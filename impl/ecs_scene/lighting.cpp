@@ -27,6 +27,12 @@ inline constexpr f32 s_NormalizeLengthSquaredEpsilon = 0.0001f;
 // Cosine clamping bounds for valid light cone angles.
 inline constexpr f32 s_ConeCosineMin = -1.0f;
 inline constexpr f32 s_ConeCosineMax = 1.0f;
+// Rec. 709 luminance weights and the directional bias of the light-importance heuristic.
+inline constexpr f32 s_Rec709LuminanceRed = 0.2126f;
+inline constexpr f32 s_Rec709LuminanceGreen = 0.7152f;
+inline constexpr f32 s_Rec709LuminanceBlue = 0.0722f;
+inline constexpr f32 s_DirectionalImportanceBoost = 4.0f;
+inline constexpr f32 s_ImportanceDistanceSquaredEpsilon = 1e-4f;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -78,6 +84,70 @@ static bool IsValidLightCone(const f32 innerConeCos, const f32 outerConeCos){
     ;
 }
 
+static bool TryResolveLightComponent(const TransformComponent& transform, const LightComponent& light, SceneLight& outLight){
+    SIMDVector position = s_SIMDZero;
+    SIMDVector rotation = s_SIMDIdentityR3;
+    switch(light.type){
+    case LightType::Directional:
+        rotation = LoadFloat(transform.rotation);
+        break;
+    case LightType::Point:
+        position = LoadFloat(transform.position);
+        break;
+    case LightType::Spot:
+        position = LoadFloat(transform.position);
+        rotation = LoadFloat(transform.rotation);
+        break;
+    default:
+        return false;
+    }
+
+    return TryBuildSceneLight(
+        position,
+        rotation,
+        LoadFloat(light.colorIntensity),
+        light.range,
+        light.innerConeCos,
+        light.outerConeCos,
+        light.angularRadius,
+        light.sourceRadius,
+        light.type,
+        light.enableCaustics,
+        outLight
+    );
+}
+
+// Gathered lights are kept as a min-heap on importance while over budget, so the weakest kept light sits at the root.
+// The light and importance arrays always move in lockstep.
+static void SwapRankedLights(SceneLight* lights, f32* importance, const usize lhs, const usize rhs){
+    Swap(lights[lhs], lights[rhs]);
+    Swap(importance[lhs], importance[rhs]);
+}
+
+static void SiftDownWeakest(SceneLight* lights, f32* importance, usize root, const usize count){
+    for(;;){
+        const usize left = root * 2u + 1u;
+        if(left >= count)
+            return;
+
+        usize weakest = left;
+        const usize right = left + 1u;
+        if(right < count && importance[right] < importance[left])
+            weakest = right;
+        if(!(importance[weakest] < importance[root]))
+            return;
+
+        SwapRankedLights(lights, importance, root, weakest);
+        root = weakest;
+    }
+}
+
+static void BuildWeakestHeap(SceneLight* lights, f32* importance, const usize count){
+    for(usize root = count / 2u; root-- > 0u;)
+        SiftDownWeakest(lights, importance, root, count);
+}
+
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -238,80 +308,93 @@ bool TryBuildSceneLight(
     }
 }
 
-usize GatherSceneLights(Core::ECS::World& world, const SIMDVector defaultForward, SceneLight* outLights, const usize maxLights){
+f32 SceneLightRadiantPower(const SIMDVector colorIntensity){
+    const SIMDVector luminance = Vector3Dot(
+        colorIntensity,
+        VectorSet(
+            __hidden_lighting::s_Rec709LuminanceRed,
+            __hidden_lighting::s_Rec709LuminanceGreen,
+            __hidden_lighting::s_Rec709LuminanceBlue,
+            0.0f
+        )
+    );
+    const SIMDVector intensity = VectorMax(VectorSplatW(colorIntensity), VectorZero());
+    return VectorGetX(VectorMultiply(luminance, intensity));
+}
+
+f32 SceneLightImportance(const SceneLight& light, const SIMDVector viewPosition){
+    const f32 radiantImportance = SceneLightRadiantPower(LoadFloat(light.colorIntensity));
+
+    if(light.type == LightType::Directional)
+        return radiantImportance * __hidden_lighting::s_DirectionalImportanceBoost + 1.0f;
+
+    const f32 distanceSquared = VectorGetX(Vector3LengthSq(VectorSubtract(LoadFloat(light.position), viewPosition)));
+    if(!(distanceSquared > __hidden_lighting::s_ImportanceDistanceSquaredEpsilon))
+        return radiantImportance;
+
+    const f32 range = Max(light.range, 0.0f);
+    return radiantImportance * Min((range * range) / distanceSquared, 1.0f);
+}
+
+usize GatherSceneLights(
+    Core::ECS::World& world,
+    const SIMDVector defaultForward,
+    const SIMDVector viewPosition,
+    SceneLight* outLights,
+    f32* outImportance,
+    const usize maxLights
+){
     if(maxLights == 0u)
         return 0u;
 
+    // Fill the budget in iteration order. Once it is full the kept lights become a min-heap on importance, and each
+    // further light only replaces the root when it is more important.
     usize count = 0u;
+    bool overBudget = false;
+
     const auto lightView = world.view<TransformComponent, LightComponent>();
     for(auto it = lightView.begin(); it != lightView.end(); ++it){
-        if(count >= maxLights)
-            break;
-
         auto&& [entity, transform, light] = *it;
         static_cast<void>(entity);
 
-        const SIMDVector colorIntensity = LoadFloat(light.colorIntensity);
         SceneLight resolvedLight;
-        bool builtLight = false;
-        switch(light.type){
-        case LightType::Directional:
-            builtLight = TryBuildSceneLight(
-                s_SIMDZero,
-                LoadFloat(transform.rotation),
-                colorIntensity,
-                light.range,
-                light.innerConeCos,
-                light.outerConeCos,
-                light.angularRadius,
-                light.sourceRadius,
-                light.type,
-                light.enableCaustics,
-                resolvedLight
-            );
-            break;
-        case LightType::Point:
-            builtLight = TryBuildSceneLight(
-                LoadFloat(transform.position),
-                s_SIMDIdentityR3,
-                colorIntensity,
-                light.range,
-                light.innerConeCos,
-                light.outerConeCos,
-                light.angularRadius,
-                light.sourceRadius,
-                light.type,
-                light.enableCaustics,
-                resolvedLight
-            );
-            break;
-        case LightType::Spot:
-            builtLight = TryBuildSceneLight(
-                LoadFloat(transform.position),
-                LoadFloat(transform.rotation),
-                colorIntensity,
-                light.range,
-                light.innerConeCos,
-                light.outerConeCos,
-                light.angularRadius,
-                light.sourceRadius,
-                light.type,
-                light.enableCaustics,
-                resolvedLight
-            );
-            break;
-        default:
-            break;
-        }
-        if(builtLight){
+        if(!__hidden_lighting::TryResolveLightComponent(transform, light, resolvedLight))
+            continue;
+
+        const f32 importance = SceneLightImportance(resolvedLight, viewPosition);
+        if(count < maxLights){
             outLights[count] = resolvedLight;
+            outImportance[count] = importance;
             ++count;
+            continue;
+        }
+
+        if(!overBudget){
+            overBudget = true;
+            __hidden_lighting::BuildWeakestHeap(outLights, outImportance, count);
         }
+
+        if(importance <= outImportance[0])
+            continue;
+
+        outLights[0] = resolvedLight;
+        outImportance[0] = importance;
+        __hidden_lighting::SiftDownWeakest(outLights, outImportance, 0u, count);
     }
 
     if(count == 0u){
         outLights[0] = BuildDefaultSceneLight(defaultForward);
-        count = 1u;
+        outImportance[0] = SceneLightImportance(outLights[0], viewPosition);
+        return 1u;
+    }
+
+    // Renderer budgets take a prefix of the list, so rank it: popping the weakest to the back leaves the most important
+    // light first.
+    if(!overBudget)
+        __hidden_lighting::BuildWeakestHeap(outLights, outImportance, count);
+    for(usize end = count - 1u; end > 0u; --end){
+        __hidden_lighting::SwapRankedLights(outLights, outImportance, 0u, end);
+        __hidden_lighting::SiftDownWeakest(outLights, outImportance, 0u, end);
     }
 
     return count;
@@ -92,7 +92,23 @@ static_assert(alignof(SceneLight) >= alignof(Float4), "SceneLight must keep stor
     bool enableCaustics,
     SceneLight& outLight
 );
-[[nodiscard]] usize GatherSceneLights(Core::ECS::World& world, SIMDVector defaultForward, SceneLight* outLights, usize maxLights);
+// Radiant power proxy: Rec. 709 luminance of the light color times its intensity.
+[[nodiscard]] f32 SceneLightRadiantPower(SIMDVector colorIntensity);
+// Radiant power weighted by how much of the view the light can reach: directional lights cover all of it and outrank
+// comparable local lights, local lights scale with range^2 / distance^2 from the view (capped at one). Higher = more
+// worth a bounded light budget. The renderer's shadow-slot and clustered-light budgets both rank with this.
+[[nodiscard]] f32 SceneLightImportance(const SceneLight& light, SIMDVector viewPosition);
+// Writes at most maxLights lights, ordered most important first relative to viewPosition, and the importance of each
+// written light into outImportance. When the world holds more valid lights than that, the least important ones are
+// dropped. Importance is evaluated once per light.
+[[nodiscard]] usize GatherSceneLights(
+    Core::ECS::World& world,
+    SIMDVector defaultForward,
+    SIMDVector viewPosition,
+    SceneLight* outLights,
+    f32* outImportance,
+    usize maxLights
+);
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -9,6 +9,8 @@
 #include "view.h"
 #include "camera.h"
 #include "lighting.h"
+#include "light_clusters.h"
+#include "transform_hierarchy.h"
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,348 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "transform_hierarchy.h"
+
+#include <core/common/log.h>
+#include <core/ecs/entity.h>
+#include <core/ecs/world.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_SCENE_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_transform_hierarchy{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static constexpr usize s_ParallelTransformNodeGrainSize = 256u;
+static constexpr u32 s_UnresolvedDepth = Limit<u32>::s_Max;
+static constexpr u32 s_VisitingDepth = Limit<u32>::s_Max - 1u;
+
+[[nodiscard]] static SIMDMatrix TransformMatrix(const TransformComponent& transform){
+    return MatrixAffineTransformation(
+        LoadFloat(transform.scale),
+        VectorZero(),
+        LoadFloat(transform.rotation),
+        LoadFloat(transform.position)
+    );
+}
+
+[[nodiscard]] static bool SameAffine(const Float34& lhs, const Float34& rhs){
+    for(usize element = 0u; element < LengthOf(lhs.raw); ++element){
+        if(lhs.raw[element] != rhs.raw[element])
+            return false;
+    }
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TransformHierarchySystem::TransformHierarchySystem(Core::Alloc::GlobalArena& arena, Core::ECS::World& world)
+    : Core::ECS::ISystem(arena)
+    , m_arena(arena)
+    , m_world(world)
+    , m_slots(arena)
+    , m_levelOffsets(arena)
+    , m_changed(arena)
+    , m_scratchNodes(arena)
+    , m_scratchPath(arena)
+    , m_scratchEntities(arena)
+    , m_scratchIndices(0, Hasher<Core::ECS::EntityID>(), EqualTo<Core::ECS::EntityID>(), arena)
+{
+    writeAccess<TransformParentComponent>();
+    writeAccess<TransformComponent>();
+    writeAccess<WorldTransformComponent>();
+}
+
+void TransformHierarchySystem::prepare(Core::ECS::World& world){
+    static_cast<void>(world);
+
+    // Every node and every root needs a WorldTransformComponent; children also need the TransformComponent that
+    // renderers read.
+    m_scratchEntities.clear();
+    m_world.view<TransformParentComponent>().each(
+        [&](const Core::ECS::EntityID entity, TransformParentComponent& node){
+            if(!m_world.tryGetComponent<WorldTransformComponent>(entity) || !m_world.tryGetComponent<TransformComponent>(entity))
+                m_scratchEntities.push_back(entity);
+
+            if(
+                node.parent.valid()
+                && !m_world.tryGetComponent<TransformParentComponent>(node.parent)
+                && !m_world.tryGetComponent<WorldTransformComponent>(node.parent)
+                && m_world.tryGetComponent<TransformComponent>(node.parent)
+            )
+                m_scratchEntities.push_back(node.parent);
+        }
+    );
+
+    for(const Core::ECS::EntityID entity : m_scratchEntities){
+        auto handle = m_world.entity(entity);
+        handle.addComponent<TransformComponent>();
+        handle.addComponent<WorldTransformComponent>();
+    }
+}
+
+void TransformHierarchySystem::update(Core::ECS::World& world, const f32 delta){
+    static_cast<void>(world);
+    static_cast<void>(delta);
+
+    // Removing or adding hierarchy nodes can detach existing subtrees, so those rebuilds re-evaluate every node.
+    // Unrelated TransformComponent churn only refreshes the cached component addresses.
+    bool evaluateAll = false;
+    if(layoutStale()){
+        evaluateAll =
+            !m_layoutValid
+            || m_parentMutationVersion != m_world.componentMutationVersion<TransformParentComponent>()
+            || m_worldMutationVersion != m_world.componentMutationVersion<WorldTransformComponent>()
+        ;
+        rebuildLayout();
+    }
+
+    const u64 version = m_changeVersion + 1u;
+    usize changedCount = 0u;
+    // A rebuilt layout records every node's current parent, so the second pass cannot observe another reparent.
+    if(!evaluateLevels(evaluateAll, version, changedCount)){
+        rebuildLayout();
+        changedCount = 0u;
+        if(!evaluateLevels(true, version, changedCount))
+            NWB_LOGGER_ERROR(NWB_TEXT("TransformHierarchySystem: hierarchy changed during evaluation"));
+    }
+
+    if(changedCount != 0u)
+        m_changeVersion = version;
+}
+
+bool TransformHierarchySystem::layoutStale()const{
+    return
+        !m_layoutValid
+        || m_parentMutationVersion != m_world.componentMutationVersion<TransformParentComponent>()
+        || m_transformMutationVersion != m_world.componentMutationVersion<TransformComponent>()
+        || m_worldMutationVersion != m_world.componentMutationVersion<WorldTransformComponent>()
+    ;
+}
+
+void TransformHierarchySystem::rebuildLayout(){
+    gatherLayoutNodes();
+    resolveLayoutDepths();
+
+    const usize nodeCount = m_scratchNodes.size();
+    u32 levelCount = 0u;
+    for(const LayoutNode& layoutNode : m_scratchNodes)
+        levelCount = Max(levelCount, layoutNode.depth + 1u);
+
+    m_levelOffsets.clear();
+    m_levelOffsets.resize(static_cast<usize>(levelCount) + 1u, 0u);
+    for(const LayoutNode& layoutNode : m_scratchNodes)
+        ++m_levelOffsets[layoutNode.depth + 1u];
+    for(u32 level = 1u; level <= levelCount; ++level)
+        m_levelOffsets[level] += m_levelOffsets[level - 1u];
+
+    // Placement advances each level start to the next level start; shift them back afterwards. m_scratchPath maps
+    // slots back to layout nodes.
+    m_scratchPath.resize(nodeCount);
+    for(usize nodeIndex = 0u; nodeIndex < nodeCount; ++nodeIndex)
+        m_scratchPath[m_levelOffsets[m_scratchNodes[nodeIndex].depth]++] = static_cast<u32>(nodeIndex);
+    for(u32 level = levelCount; level > 0u; --level)
+        m_levelOffsets[level] = m_levelOffsets[level - 1u];
+    m_levelOffsets[0] = 0u;
+
+    m_scratchIndices.clear();
+    m_slots.resize(nodeCount);
+    for(usize slot = 0u; slot < nodeCount; ++slot){
+        const LayoutNode& layoutNode = m_scratchNodes[m_scratchPath[slot]];
+        m_slots[slot] = layoutNode.slot;
+        m_scratchIndices.emplace(layoutNode.entity, static_cast<u32>(slot));
+    }
+    for(NodeSlot& slot : m_slots){
+        if(!slot.node || slot.parentSlot == s_InvalidSlot)
+            continue;
+
+        const auto found = m_scratchIndices.find(slot.parentEntity);
+        slot.parentSlot = found != m_scratchIndices.end() ? found.value() : s_InvalidSlot;
+    }
+
+    m_changed.resize(nodeCount, 0u);
+    m_parentMutationVersion = m_world.componentMutationVersion<TransformParentComponent>();
+    m_transformMutationVersion = m_world.componentMutationVersion<TransformComponent>();
+    m_worldMutationVersion = m_world.componentMutationVersion<WorldTransformComponent>();
+    m_layoutValid = true;
+}
+
+void TransformHierarchySystem::gatherLayoutNodes(){
+    m_scratchNodes.clear();
+    m_scratchIndices.clear();
+
+    // parentSlot temporarily records whether the node has a parent to link; rebuildLayout() resolves the real slot.
+    m_world.view<TransformParentComponent, TransformComponent, WorldTransformComponent>().each(
+        [&](const Core::ECS::EntityID entity, TransformParentComponent& node, TransformComponent& transform, WorldTransformComponent& world){
+            LayoutNode layoutNode;
+            layoutNode.entity = entity;
+            layoutNode.slot.transform = &transform;
+            layoutNode.slot.node = &node;
+            layoutNode.slot.world = &world;
+            layoutNode.slot.parentEntity = node.parent;
+            layoutNode.slot.parentSlot = 0u;
+            layoutNode.depth = __hidden_transform_hierarchy::s_UnresolvedDepth;
+            m_scratchIndices.emplace(entity, static_cast<u32>(m_scratchNodes.size()));
+            m_scratchNodes.push_back(layoutNode);
+        }
+    );
+
+    const usize childCount = m_scratchNodes.size();
+    for(usize nodeIndex = 0u; nodeIndex < childCount; ++nodeIndex){
+        const Core::ECS::EntityID parent = m_scratchNodes[nodeIndex].slot.parentEntity;
+        if(!parent.valid() || m_scratchIndices.find(parent) != m_scratchIndices.end())
+            continue;
+
+        TransformComponent* transform = m_world.tryGetComponent<TransformComponent>(parent);
+        WorldTransformComponent* world = m_world.tryGetComponent<WorldTransformComponent>(parent);
+        if(!transform || !world)
+            continue;
+
+        LayoutNode root;
+        root.entity = parent;
+        root.slot.transform = transform;
+        root.slot.world = world;
+        root.depth = 0u;
+        m_scratchIndices.emplace(parent, static_cast<u32>(m_scratchNodes.size()));
+        m_scratchNodes.push_back(root);
+    }
+}
+
+void TransformHierarchySystem::resolveLayoutDepths(){
+    using namespace __hidden_transform_hierarchy;
+
+    bool reportedCycle = false;
+    for(usize nodeIndex = 0u; nodeIndex < m_scratchNodes.size(); ++nodeIndex){
+        if(m_scratchNodes[nodeIndex].depth != s_UnresolvedDepth)
+            continue;
+
+        // Walk up until a resolved ancestor, a missing parent, or a node already on this path (a cycle), then assign
+        // depths on the way back down.
+        m_scratchPath.clear();
+        u32 current = static_cast<u32>(nodeIndex);
+        u32 baseDepth = 0u;
+        for(;;){
+            LayoutNode& layoutNode = m_scratchNodes[current];
+            if(layoutNode.depth == s_VisitingDepth){
+                LayoutNode& last = m_scratchNodes[m_scratchPath.back()];
+                last.slot.parentSlot = s_InvalidSlot;
+                if(!reportedCycle){
+                    NWB_LOGGER_ERROR(NWB_TEXT("TransformHierarchySystem: transform parents form a cycle; detaching entity {}")
+                        , last.entity.id
+                    );
+                    reportedCycle = true;
+                }
+                break;
+            }
+            if(layoutNode.depth != s_UnresolvedDepth){
+                baseDepth = layoutNode.depth + 1u;
+                break;
+            }
+
+            layoutNode.depth = s_VisitingDepth;
+            m_scratchPath.push_back(current);
+
+            const auto found = layoutNode.slot.parentEntity.valid()
+                ? m_scratchIndices.find(layoutNode.slot.parentEntity)
+                : m_scratchIndices.end()
+            ;
+            if(found == m_scratchIndices.end()){
+                layoutNode.slot.parentSlot = s_InvalidSlot;
+                break;
+            }
+            current = found.value();
+        }
+
+        const usize pathLength = m_scratchPath.size();
+        for(usize pathIndex = 0u; pathIndex < pathLength; ++pathIndex)
+            m_scratchNodes[m_scratchPath[pathIndex]].depth = baseDepth + static_cast<u32>(pathLength - 1u - pathIndex);
+    }
+}
+
+bool TransformHierarchySystem::evaluateLevels(const bool evaluateAll, const u64 version, usize& outChangedCount){
+    using namespace __hidden_transform_hierarchy;
+
+    Atomic<usize> changedCount{ 0u };
+    Atomic<bool> reparented{ false };
+    for(usize level = 0u; level + 1u < m_levelOffsets.size(); ++level){
+        m_world.taskPool().parallelFor(
+            static_cast<usize>(m_levelOffsets[level]),
+            static_cast<usize>(m_levelOffsets[level + 1u]),
+            s_ParallelTransformNodeGrainSize,
+            [&](const usize slotIndex){
+                NodeSlot& slot = m_slots[slotIndex];
+                m_changed[slotIndex] = 0u;
+
+                SIMDMatrix worldMatrix{};
+                if(!slot.node){
+                    worldMatrix = TransformMatrix(*slot.transform);
+                    Float34 stored{};
+                    StoreFloat(worldMatrix, &stored);
+                    if(!evaluateAll && SameAffine(stored, slot.world->world))
+                        return;
+                }
+                else{
+                    if(slot.node->parent != slot.parentEntity){
+                        reparented.store(true, MemoryOrder::relaxed);
+                        return;
+                    }
+
+                    const bool parentChanged = slot.parentSlot != s_InvalidSlot && m_changed[slot.parentSlot] != 0u;
+                    if(!evaluateAll && !slot.node->dirty && !parentChanged)
+                        return;
+
+                    worldMatrix = TransformMatrix(slot.node->local);
+                    if(slot.parentSlot != s_InvalidSlot)
+                        worldMatrix = MatrixMultiply(LoadFloat(m_slots[slot.parentSlot].world->world), worldMatrix);
+                    slot.node->dirty = false;
+
+                    SIMDVector scale;
+                    SIMDVector rotation;
+                    SIMDVector translation;
+                    if(MatrixDecompose(&scale, &rotation, &translation, worldMatrix)){
+                        StoreFloat(VectorSetW(translation, 0.0f), &slot.transform->position);
+                        StoreFloat(rotation, &slot.transform->rotation);
+                        StoreFloat(VectorSetW(scale, 0.0f), &slot.transform->scale);
+                    }
+                }
+
+                StoreFloat(worldMatrix, &slot.world->world);
+                slot.world->version = version;
+                m_changed[slotIndex] = 1u;
+                changedCount.fetch_add(1u, MemoryOrder::relaxed);
+            }
+        );
+    }
+
+    outChangedCount = changedCount.load(MemoryOrder::relaxed);
+    return !reparented.load(MemoryOrder::relaxed);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_SCENE_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
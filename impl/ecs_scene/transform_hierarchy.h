@@ -0,0 +1,111 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "components.h"
+
+#include <core/alloc/general.h>
+#include <core/ecs/system.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_SCENE_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Resolves TransformParentComponent hierarchies into cached world transforms. Nodes are stored breadth-first in a
+// depth-sorted flat layout that is rebuilt only when hierarchy components are added or removed or a node is
+// reparented; every update walks the levels in order with parallelFor and recomputes only dirty nodes, nodes whose
+// parent changed this update, and the subtrees below moved roots.
+class TransformHierarchySystem final : public Core::ECS::ISystem{
+private:
+    struct NodeSlot{
+        TransformComponent* transform = nullptr;
+        // Null for roots, whose authored TransformComponent is the world transform.
+        TransformParentComponent* node = nullptr;
+        WorldTransformComponent* world = nullptr;
+        Core::ECS::EntityID parentEntity = Core::ECS::ENTITY_ID_INVALID;
+        u32 parentSlot = Limit<u32>::s_Max;
+    };
+
+    struct LayoutNode{
+        Core::ECS::EntityID entity = Core::ECS::ENTITY_ID_INVALID;
+        NodeSlot slot;
+        u32 depth = 0u;
+    };
+
+    using SlotIndexMap = HashMap<
+        Core::ECS::EntityID,
+        u32,
+        Hasher<Core::ECS::EntityID>,
+        EqualTo<Core::ECS::EntityID>,
+        Core::Alloc::GlobalArena
+    >;
+
+
+public:
+    static constexpr u32 s_InvalidSlot = Limit<u32>::s_Max;
+
+
+public:
+    TransformHierarchySystem(Core::Alloc::GlobalArena& arena, Core::ECS::World& world);
+    virtual ~TransformHierarchySystem()override = default;
+
+
+public:
+    virtual void prepare(Core::ECS::World& world)override;
+    virtual void update(Core::ECS::World& world, f32 delta)override;
+
+    // Advances whenever an update changes at least one world transform. WorldTransformComponent::version never
+    // exceeds it.
+    [[nodiscard]] u64 changeVersion()const{ return m_changeVersion; }
+    [[nodiscard]] usize nodeCount()const{ return m_slots.size(); }
+    [[nodiscard]] usize levelCount()const{ return m_levelOffsets.empty() ? 0u : m_levelOffsets.size() - 1u; }
+
+
+private:
+    [[nodiscard]] bool layoutStale()const;
+    void rebuildLayout();
+    void gatherLayoutNodes();
+    void resolveLayoutDepths();
+    // Returns false when a node was reparented since the layout was built; the caller rebuilds and evaluates again.
+    [[nodiscard]] bool evaluateLevels(bool evaluateAll, u64 version, usize& outChangedCount);
+
+
+private:
+    Core::Alloc::GlobalArena& m_arena;
+    Core::ECS::World& m_world;
+
+    Vector<NodeSlot, Core::Alloc::GlobalArena> m_slots;
+    Vector<u32, Core::Alloc::GlobalArena> m_levelOffsets;
+    // Per-slot flag set when the node's world transform changed during the current update.
+    Vector<u8, Core::Alloc::GlobalArena> m_changed;
+
+    Vector<LayoutNode, Core::Alloc::GlobalArena> m_scratchNodes;
+    Vector<u32, Core::Alloc::GlobalArena> m_scratchPath;
+    Vector<Core::ECS::EntityID, Core::Alloc::GlobalArena> m_scratchEntities;
+    SlotIndexMap m_scratchIndices;
+
+    u64 m_parentMutationVersion = 0u;
+    u64 m_transformMutationVersion = 0u;
+    u64 m_worldMutationVersion = 0u;
+    u64 m_changeVersion = 0u;
+    bool m_layoutValid = false;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_SCENE_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
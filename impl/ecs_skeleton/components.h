@@ -51,6 +51,7 @@ struct SkeletonJointPaletteComponent{
 
 
 inline constexpr u32 s_SkeletonRootParent = Limit<u32>::s_Max;
+inline constexpr u64 s_SkeletonPoseRevisionNone = Limit<u64>::s_Max;
 
 struct SkeletonPoseComponent{
     using ParentJointVector = Vector<u32, Core::Alloc::GlobalArena>;
@@ -59,6 +60,8 @@ struct SkeletonPoseComponent{
     ParentJointVector parentJoints;
     JointVector localJoints;
     u32 skinningMode = SkeletonSkinningMode::LinearBlend;
+    // Bumped by every writer of the fields above so cached palettes know when to re-evaluate.
+    u64 revision = 0u;
 
     explicit SkeletonPoseComponent(Core::Alloc::GlobalArena& arena)
         : parentJoints(arena)
@@ -70,6 +73,46 @@ struct SkeletonPoseComponent{
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// Model-space joints of the SkeletonPoseComponent on the same entity, evaluated by SkeletonPaletteSystem. Consumers
+// may use joints only while poseRevision matches the pose revision and valid is set. The remaining members are
+// evaluation state owned by the palette builder.
+struct SkeletonPosePaletteComponent{
+    using IndexVector = Vector<u32, Core::Alloc::GlobalArena>;
+    using StreamVector = Vector<f32, Core::Alloc::GlobalArena>;
+    using JointVector = Vector<SkeletonJointMatrix, Core::Alloc::GlobalArena>;
+
+    JointVector joints;
+    u64 poseRevision = s_SkeletonPoseRevisionNone;
+    u32 skinningMode = SkeletonSkinningMode::LinearBlend;
+    bool valid = false;
+
+    // Hierarchy the layout below was built from.
+    IndexVector layoutParents;
+    // Joints sorted by hierarchy depth; levelOffsets bounds each depth, so joints of one level only read earlier ones.
+    IndexVector sortedJoints;
+    IndexVector jointSlots;
+    IndexVector parentSlots;
+    IndexVector levelOffsets;
+    // s_SkeletonJointMatrixFloatCount streams of one affine element each, indexed by sorted slot.
+    StreamVector localStreams;
+    StreamVector modelStreams;
+
+    explicit SkeletonPosePaletteComponent(Core::Alloc::GlobalArena& arena)
+        : joints(arena)
+        , layoutParents(arena)
+        , sortedJoints(arena)
+        , jointSlots(arena)
+        , parentSlots(arena)
+        , levelOffsets(arena)
+        , localStreams(arena)
+        , modelStreams(arena)
+    {}
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 NWB_IMPL_END
 
 
@@ -0,0 +1,272 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "runtime_helpers.h"
+
+#include <global/cpu_topology.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace SkeletonRuntime{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace SkeletonPaletteDetail{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static constexpr usize s_AffineRowCount = 3u;
+static constexpr usize s_AffineColumnCount = 4u;
+static constexpr usize s_AffineTranslationColumn = 3u;
+
+[[nodiscard]] NWB_INLINE bool LayoutMatchesPose(const SkeletonPoseComponent& pose, const SkeletonPosePaletteComponent& palette){
+    const usize jointCount = pose.parentJoints.size();
+    if(palette.layoutParents.size() != jointCount)
+        return false;
+
+    for(usize jointIndex = 0u; jointIndex < jointCount; ++jointIndex){
+        if(palette.layoutParents[jointIndex] != pose.parentJoints[jointIndex])
+            return false;
+    }
+    return true;
+}
+
+// One hierarchy level of model = parent * local on affine 3x4 streams. Joints inside a level never depend on each
+// other, so the slot loop carries no dependency.
+NWB_INLINE void EvaluateLevel(
+    const f32* localStreams,
+    f32* modelStreams,
+    const u32* parentSlots,
+    const usize streamStride,
+    const usize slotBegin,
+    const usize slotEnd
+){
+    for(usize slot = slotBegin; slot < slotEnd; ++slot){
+        const usize parentSlot = parentSlots[slot];
+        for(usize row = 0u; row < s_AffineRowCount; ++row){
+            const f32* parentRow = modelStreams + row * s_AffineColumnCount * streamStride;
+            const f32 parent0 = parentRow[parentSlot];
+            const f32 parent1 = parentRow[streamStride + parentSlot];
+            const f32 parent2 = parentRow[2u * streamStride + parentSlot];
+            const f32 parent3 = parentRow[3u * streamStride + parentSlot];
+
+            f32* modelRow = modelStreams + row * s_AffineColumnCount * streamStride;
+            for(usize column = 0u; column < s_AffineColumnCount; ++column){
+                const f32* localColumn = localStreams + column * streamStride;
+                f32 value =
+                    parent0 * localColumn[slot]
+                    + parent1 * localColumn[s_AffineColumnCount * streamStride + slot]
+                    + parent2 * localColumn[2u * s_AffineColumnCount * streamStride + slot]
+                ;
+                if(column == s_AffineTranslationColumn)
+                    value += parent3;
+                modelRow[column * streamStride + slot] = value;
+            }
+        }
+    }
+}
+
+// Evaluates whole lane blocks of one level from `slotBegin` like EvaluateLevel and returns the first slot it left
+// for EvaluateLevel. Built in its own translation unit per SimdKernelTier.
+using EvaluateLevelBlocksFunction = usize(*)(
+    const f32* localStreams,
+    f32* modelStreams,
+    const u32* parentSlots,
+    usize streamStride,
+    usize slotBegin,
+    usize slotEnd
+);
+
+// Null when the build has no AVX-512 kernels.
+extern const EvaluateLevelBlocksFunction g_EvaluateLevelBlocksAvx512;
+
+[[nodiscard]] inline EvaluateLevelBlocksFunction ActiveEvaluateLevelBlocks(){
+    switch(ActiveSimdKernelTier()){
+    case SimdKernelTier::AVX512:
+        return g_EvaluateLevelBlocksAvx512;
+    default:
+        return nullptr;
+    }
+}
+
+#if defined(NWB_DEBUG)
+// Cooked bind poses are validated at cook time; debug builds also catch degenerate runtime poses at the source.
+[[nodiscard]] inline bool ValidatePaletteJoints(const SkeletonPoseComponent& pose, const SkeletonPosePaletteComponent& palette){
+    for(usize jointIndex = 0u; jointIndex < palette.joints.size(); ++jointIndex){
+        if(
+            !MatrixIsInvertibleAffine(LoadFloat(pose.localJoints[jointIndex]), s_AffineEpsilon, s_JointDeterminantEpsilon)
+            || !MatrixIsInvertibleAffine(LoadFloat(palette.joints[jointIndex]), s_AffineEpsilon, s_JointDeterminantEpsilon)
+        )
+            return false;
+    }
+    return true;
+}
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+[[nodiscard]] NWB_INLINE bool SkeletonPosePaletteCurrent(
+    const SkeletonPoseComponent& pose,
+    const SkeletonPosePaletteComponent* palette
+){
+    return palette && palette->valid && palette->poseRevision == pose.revision;
+}
+
+// Sorts joints by hierarchy depth so a level can be evaluated without per-joint ordering constraints. Structural
+// checks live here and run only when the hierarchy changes.
+[[nodiscard]] inline bool BuildSkeletonPaletteLayout(const SkeletonPoseComponent& pose, SkeletonPosePaletteComponent& palette){
+    palette.layoutParents.clear();
+    palette.levelOffsets.clear();
+
+    const usize jointCount = pose.parentJoints.size();
+    if(jointCount == 0u || jointCount > static_cast<usize>(Limit<u32>::s_Max))
+        return false;
+
+    palette.sortedJoints.resize(jointCount);
+    palette.jointSlots.resize(jointCount);
+    palette.parentSlots.resize(jointCount);
+
+    // jointSlots holds each joint depth until the joints are placed.
+    u32 levelCount = 0u;
+    for(usize jointIndex = 0u; jointIndex < jointCount; ++jointIndex){
+        const u32 parentJoint = pose.parentJoints[jointIndex];
+        u32 depth = 0u;
+        if(parentJoint != s_SkeletonRootParent){
+            if(parentJoint >= jointIndex)
+                return false;
+            depth = palette.jointSlots[parentJoint] + 1u;
+        }
+        palette.jointSlots[jointIndex] = depth;
+        levelCount = Max(levelCount, depth + 1u);
+    }
+
+    palette.levelOffsets.resize(static_cast<usize>(levelCount) + 1u, 0u);
+    for(usize jointIndex = 0u; jointIndex < jointCount; ++jointIndex)
+        ++palette.levelOffsets[palette.jointSlots[jointIndex] + 1u];
+    for(u32 level = 1u; level <= levelCount; ++level)
+        palette.levelOffsets[level] += palette.levelOffsets[level - 1u];
+
+    // Placement advances each level start to the next level start; shift them back afterwards.
+    for(usize jointIndex = 0u; jointIndex < jointCount; ++jointIndex){
+        const u32 slot = palette.levelOffsets[palette.jointSlots[jointIndex]]++;
+        palette.sortedJoints[slot] = static_cast<u32>(jointIndex);
+        palette.jointSlots[jointIndex] = slot;
+    }
+    for(u32 level = levelCount; level > 0u; --level)
+        palette.levelOffsets[level] = palette.levelOffsets[level - 1u];
+    palette.levelOffsets[0] = 0u;
+
+    for(usize slot = 0u; slot < jointCount; ++slot){
+        const u32 parentJoint = pose.parentJoints[palette.sortedJoints[slot]];
+        palette.parentSlots[slot] = parentJoint == s_SkeletonRootParent ? s_SkeletonRootParent : palette.jointSlots[parentJoint];
+    }
+
+    const usize streamFloatCount = jointCount * s_SkeletonJointMatrixFloatCount;
+    palette.localStreams.resize(streamFloatCount);
+    palette.modelStreams.resize(streamFloatCount);
+    palette.layoutParents.assign(pose.parentJoints.begin(), pose.parentJoints.end());
+    return true;
+}
+
+// Same result as BuildStoredJointPaletteFromSkeletonPose without per-joint validation in the loop: local joints are
+// transposed into structure-of-arrays streams, each hierarchy level is composed with affine 3x4 math, and the result
+// is scattered back to joint order. Debug builds validate the finished palette instead.
+[[nodiscard]] inline bool EvaluateSkeletonPalette(const SkeletonPoseComponent& pose, SkeletonPosePaletteComponent& palette){
+    using namespace SkeletonPaletteDetail;
+
+    palette.poseRevision = pose.revision;
+    palette.skinningMode = SkeletonSkinningMode::LinearBlend;
+    palette.valid = false;
+
+    const usize jointCount = pose.localJoints.size();
+    if(
+        !HasSkeletonPose(&pose)
+        || !ValidSkeletonSkinningMode(pose.skinningMode)
+        || pose.parentJoints.size() != jointCount
+        || (!LayoutMatchesPose(pose, palette) && !BuildSkeletonPaletteLayout(pose, palette))
+    ){
+        palette.joints.clear();
+        palette.valid = !HasSkeletonPose(&pose);
+        return palette.valid;
+    }
+
+    f32* localStreams = palette.localStreams.data();
+    f32* modelStreams = palette.modelStreams.data();
+    for(usize slot = 0u; slot < jointCount; ++slot){
+        const SkeletonJointMatrix& localJoint = pose.localJoints[palette.sortedJoints[slot]];
+        for(usize element = 0u; element < s_SkeletonJointMatrixFloatCount; ++element)
+            localStreams[element * jointCount + slot] = localJoint.raw[element];
+    }
+
+    const usize rootCount = palette.levelOffsets[1];
+    for(usize element = 0u; element < s_SkeletonJointMatrixFloatCount; ++element){
+        for(usize slot = 0u; slot < rootCount; ++slot)
+            modelStreams[element * jointCount + slot] = localStreams[element * jointCount + slot];
+    }
+    const EvaluateLevelBlocksFunction evaluateLevelBlocks = ActiveEvaluateLevelBlocks();
+    for(usize level = 1u; level + 1u < palette.levelOffsets.size(); ++level){
+        const usize slotEnd = palette.levelOffsets[level + 1u];
+        usize slotBegin = palette.levelOffsets[level];
+        if(evaluateLevelBlocks)
+            slotBegin = evaluateLevelBlocks(localStreams, modelStreams, palette.parentSlots.data(), jointCount, slotBegin, slotEnd);
+        EvaluateLevel(localStreams, modelStreams, palette.parentSlots.data(), jointCount, slotBegin, slotEnd);
+    }
+
+    palette.joints.resize(jointCount, SkeletonJointMatrix{});
+    for(usize slot = 0u; slot < jointCount; ++slot){
+        SkeletonJointMatrix& modelJoint = palette.joints[palette.sortedJoints[slot]];
+        for(usize element = 0u; element < s_SkeletonJointMatrixFloatCount; ++element)
+            modelJoint.raw[element] = modelStreams[element * jointCount + slot];
+    }
+
+#if defined(NWB_DEBUG)
+    if(!ValidatePaletteJoints(pose, palette)){
+        palette.joints.clear();
+        return false;
+    }
+#endif
+
+    palette.skinningMode = pose.skinningMode;
+    palette.valid = true;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,101 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Built with AVX-512 flags by nwb_apply_simd_avx512_sources. The kernel only runs after ActiveEvaluateLevelBlocks() has
+// checked the CPU, so nothing else from joint_palette.h may be called here.
+
+
+#include "joint_palette.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_HAS_AVX512)
+namespace __hidden_joint_palette_avx512{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static constexpr usize s_LaneCount = 16u;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Parents sit anywhere in earlier levels, so their rows are gathered; locals and outputs are contiguous per slot.
+static usize EvaluateLevelBlocks(
+    const f32* localStreams,
+    f32* modelStreams,
+    const u32* parentSlots,
+    const usize streamStride,
+    const usize slotBegin,
+    const usize slotEnd
+){
+    using namespace SkeletonRuntime::SkeletonPaletteDetail;
+
+    // Gather offsets are signed 32-bit.
+    if(streamStride > static_cast<usize>(Limit<i32>::s_Max))
+        return slotBegin;
+
+    usize slot = slotBegin;
+    for(; slot + s_LaneCount <= slotEnd; slot += s_LaneCount){
+        const __m512i parents = _mm512_loadu_si512(parentSlots + slot);
+        for(usize row = 0u; row < s_AffineRowCount; ++row){
+            const f32* parentRow = modelStreams + row * s_AffineColumnCount * streamStride;
+            const __m512 parent0 = _mm512_i32gather_ps(parents, parentRow, sizeof(f32));
+            const __m512 parent1 = _mm512_i32gather_ps(parents, parentRow + streamStride, sizeof(f32));
+            const __m512 parent2 = _mm512_i32gather_ps(parents, parentRow + 2u * streamStride, sizeof(f32));
+            const __m512 parent3 = _mm512_i32gather_ps(parents, parentRow + 3u * streamStride, sizeof(f32));
+
+            f32* modelRow = modelStreams + row * s_AffineColumnCount * streamStride;
+            for(usize column = 0u; column < s_AffineColumnCount; ++column){
+                const f32* localColumn = localStreams + column * streamStride;
+                __m512 value = _mm512_mul_ps(parent0, _mm512_loadu_ps(localColumn + slot));
+                value = _mm512_fmadd_ps(parent1, _mm512_loadu_ps(localColumn + s_AffineColumnCount * streamStride + slot), value);
+                value = _mm512_fmadd_ps(parent2, _mm512_loadu_ps(localColumn + 2u * s_AffineColumnCount * streamStride + slot), value);
+                if(column == s_AffineTranslationColumn)
+                    value = _mm512_add_ps(value, parent3);
+                _mm512_storeu_ps(modelRow + column * streamStride + slot, value);
+            }
+        }
+    }
+    return slot;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_HAS_AVX512)
+const SkeletonRuntime::SkeletonPaletteDetail::EvaluateLevelBlocksFunction SkeletonRuntime::SkeletonPaletteDetail::g_EvaluateLevelBlocksAvx512 =
+    &__hidden_joint_palette_avx512::EvaluateLevelBlocks
+;
+#else
+const SkeletonRuntime::SkeletonPaletteDetail::EvaluateLevelBlocksFunction SkeletonRuntime::SkeletonPaletteDetail::g_EvaluateLevelBlocksAvx512 = nullptr;
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
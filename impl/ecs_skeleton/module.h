@@ -6,7 +6,9 @@
 
 
 #include "components.h"
+#include "joint_palette.h"
 #include "runtime_helpers.h"
+#include "system.h"
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
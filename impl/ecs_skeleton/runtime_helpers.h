@@ -23,8 +23,8 @@ namespace SkeletonRuntime{
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-static constexpr f32 s_AffineEpsilon = 0.000001f;
-static constexpr f32 s_JointDeterminantEpsilon = 0.000000000001f;
+static constexpr f32 s_AffineEpsilon = s_SkeletonJointAffineEpsilon;
+static constexpr f32 s_JointDeterminantEpsilon = s_SkeletonJointDeterminantEpsilon;
 static constexpr f32 s_RigidJointEpsilon = 0.001f;
 
 
@@ -0,0 +1,148 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "system.h"
+#include "joint_palette.h"
+
+#include <core/common/log.h>
+#include <core/ecs/entity.h>
+#include <core/ecs/world.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_skeleton_system{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static constexpr usize s_ParallelSkeletonPaletteGrainSize = 8u;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+SkeletonPaletteSystem::SkeletonPaletteSystem(Core::Alloc::GlobalArena& arena, Core::ECS::World& world)
+    : Core::ECS::ISystem(arena)
+    , m_arena(arena)
+    , m_world(world)
+    , m_scratchEntities(arena)
+{
+    readAccess<SkeletonPoseComponent>();
+    writeAccess<SkeletonPosePaletteComponent>();
+}
+
+void SkeletonPaletteSystem::prepare(Core::ECS::World& world){
+    static_cast<void>(world);
+
+    m_scratchEntities.clear();
+    m_world.view<SkeletonPosePaletteComponent>().each(
+        [&](const Core::ECS::EntityID entity, SkeletonPosePaletteComponent& palette){
+            static_cast<void>(palette);
+            if(!m_world.tryGetComponent<SkeletonPoseComponent>(entity))
+                m_scratchEntities.push_back(entity);
+        }
+    );
+    for(const Core::ECS::EntityID entity : m_scratchEntities)
+        m_world.entity(entity).removeComponent<SkeletonPosePaletteComponent>();
+
+    m_scratchEntities.clear();
+    m_world.view<SkeletonPoseComponent>().each(
+        [&](const Core::ECS::EntityID entity, SkeletonPoseComponent& pose){
+            static_cast<void>(pose);
+            if(!m_world.tryGetComponent<SkeletonPosePaletteComponent>(entity))
+                m_scratchEntities.push_back(entity);
+        }
+    );
+    for(const Core::ECS::EntityID entity : m_scratchEntities)
+        m_world.entity(entity).addComponent<SkeletonPosePaletteComponent>(m_arena);
+}
+
+void SkeletonPaletteSystem::update(Core::ECS::World& world, const f32 delta){
+    static_cast<void>(world);
+    static_cast<void>(delta);
+
+    Atomic<u32> failedCount{ 0u };
+    auto evaluatePalette = [&failedCount](
+        const Core::ECS::EntityID entity,
+        const SkeletonPoseComponent& pose,
+        SkeletonPosePaletteComponent& palette
+    ){
+        static_cast<void>(entity);
+        if(palette.poseRevision == pose.revision)
+            return;
+        if(!SkeletonRuntime::EvaluateSkeletonPalette(pose, palette))
+            failedCount.fetch_add(1u, MemoryOrder::relaxed);
+    };
+
+    // Poses stamped since the last run are evaluated in parallel, plus the palettes prepare() just attached to poses
+    // that did not change; the revision check still skips a pose that was stamped without being rewritten.
+    const u32 sinceTick = lastRunTick();
+    const auto paletteView = m_world.view<SkeletonPoseComponent, SkeletonPosePaletteComponent>()
+        .write<SkeletonPosePaletteComponent>()
+    ;
+    paletteView.changed<SkeletonPoseComponent>(sinceTick).parallelEach(
+        m_world.taskPool(),
+        __hidden_skeleton_system::s_ParallelSkeletonPaletteGrainSize,
+        evaluatePalette
+    );
+    paletteView.added<SkeletonPosePaletteComponent>(sinceTick).parallelEach(
+        m_world.taskPool(),
+        __hidden_skeleton_system::s_ParallelSkeletonPaletteGrainSize,
+        evaluatePalette
+    );
+
+    // Writers that bump the revision without stamping the change are caught by a plain revision compare. Once every
+    // writer stamps, this pass only compares and nothing lands in the scratch list.
+    m_scratchEntities.clear();
+    m_world.view<SkeletonPoseComponent, SkeletonPosePaletteComponent>().each(
+        [&](const Core::ECS::EntityID entity, const SkeletonPoseComponent& pose, const SkeletonPosePaletteComponent& palette){
+            if(palette.poseRevision != pose.revision)
+                m_scratchEntities.push_back(entity);
+        }
+    );
+    m_world.taskPool().parallelFor(
+        static_cast<usize>(0u),
+        m_scratchEntities.size(),
+        __hidden_skeleton_system::s_ParallelSkeletonPaletteGrainSize,
+        [&](const usize index){
+            const Core::ECS::EntityID entity = m_scratchEntities[index];
+            const SkeletonPoseComponent* pose = m_world.tryGetComponent<SkeletonPoseComponent>(entity);
+            SkeletonPosePaletteComponent* palette = m_world.tryGetComponent<SkeletonPosePaletteComponent>(entity);
+            if(pose && palette)
+                evaluatePalette(entity, *pose, *palette);
+        }
+    );
+    for(const Core::ECS::EntityID entity : m_scratchEntities)
+        m_world.entity(entity).markChanged<SkeletonPosePaletteComponent>();
+
+    // Failed palettes stay invalid until the pose revision changes; consumers fall back to the per-joint builder.
+    const u32 failed = failedCount.load(MemoryOrder::relaxed);
+    if(failed != 0u)
+        NWB_LOGGER_WARNING(NWB_TEXT("SkeletonPaletteSystem: {} skeleton poses failed palette evaluation"), failed);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,52 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include "components.h"
+
+#include <core/ecs/system.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Keeps a SkeletonPosePaletteComponent next to every SkeletonPoseComponent and re-evaluates it in parallel for poses
+// whose revision moved. Pose writers should stamp the change through View::write() or markChanged() so the update
+// visits only changed poses; a revision bump alone is still picked up by a linear revision scan. Register it after the
+// systems that write poses and before the ones that skin them; consumers fall back to building the palette themselves
+// while it is stale.
+class SkeletonPaletteSystem final : public Core::ECS::ISystem{
+public:
+    SkeletonPaletteSystem(Core::Alloc::GlobalArena& arena, Core::ECS::World& world);
+    virtual ~SkeletonPaletteSystem()override = default;
+
+
+public:
+    virtual void prepare(Core::ECS::World& world)override;
+    virtual void update(Core::ECS::World& world, f32 delta)override;
+
+
+private:
+    Core::Alloc::GlobalArena& m_arena;
+    Core::ECS::World& m_world;
+    Vector<Core::ECS::EntityID, Core::Alloc::GlobalArena> m_scratchEntities;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
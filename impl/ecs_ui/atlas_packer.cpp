@@ -0,0 +1,270 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "atlas_packer.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+UiAtlasPacker::UiAtlasPacker(
+    Core::Alloc::GlobalArena& arena,
+    const u32 pageWidth,
+    const u32 pageHeight,
+    const u32 maxPageCount,
+    const u32 padding
+)
+    : m_arena(arena)
+    , m_pages(arena)
+    , m_entries(0, Hasher<u64>(), EqualTo<u64>(), arena)
+    , m_pageWidth(pageWidth)
+    , m_pageHeight(pageHeight)
+    , m_maxPageCount(maxPageCount)
+    , m_padding(padding)
+{
+    m_pages.reserve(maxPageCount);
+}
+
+bool UiAtlasPacker::acquire(
+    const u64 key,
+    const u32 width,
+    const u32 height,
+    UiAtlasAllocation& outAllocation,
+    bool& outInserted
+){
+    outInserted = false;
+
+    auto found = m_entries.find(key);
+    if(found != m_entries.end()){
+        Entry& entry = found.value();
+        if(entry.allocation.width == width && entry.allocation.height == height){
+            entry.lastUsedFrame = m_frame;
+            m_pages[entry.allocation.page].lastUsedFrame = m_frame;
+            outAllocation = entry.allocation;
+            ++m_hitCount;
+            return true;
+        }
+
+        // Same key, new extent: the old texels stay behind as a hole until their page is recycled.
+        Page& oldPage = m_pages[entry.allocation.page];
+        oldPage.usedArea -= static_cast<u64>(entry.allocation.width) * entry.allocation.height;
+        --oldPage.entryCount;
+        m_entries.erase(found);
+    }
+
+    const u64 paddedWidth = static_cast<u64>(width) + m_padding;
+    const u64 paddedHeight = static_cast<u64>(height) + m_padding;
+    if(width == 0u || height == 0u || paddedWidth > m_pageWidth || paddedHeight > m_pageHeight){
+        ++m_failedCount;
+        return false;
+    }
+
+    // Pages this frame already draws from come first: the frame's quads then share fewer textures, and untouched
+    // pages age toward eviction instead of collecting one fresh image each.
+    UiAtlasAllocation allocation;
+    bool placed = false;
+    for(u32 pageIndex = 0u; pageIndex < m_pages.size() && !placed; ++pageIndex){
+        if(m_pages[pageIndex].lastUsedFrame == m_frame)
+            placed = insertIntoPage(pageIndex, width, height, allocation);
+    }
+    for(u32 pageIndex = 0u; pageIndex < m_pages.size() && !placed; ++pageIndex){
+        if(m_pages[pageIndex].lastUsedFrame != m_frame)
+            placed = insertIntoPage(pageIndex, width, height, allocation);
+    }
+
+    if(!placed && m_pages.size() < m_maxPageCount){
+        resetPage(m_pages.emplace_back(m_arena));
+        placed = insertIntoPage(static_cast<u32>(m_pages.size() - 1u), width, height, allocation);
+    }
+
+    u32 evictedPage = 0u;
+    if(!placed && evictLeastRecentlyUsedPage(evictedPage))
+        placed = insertIntoPage(evictedPage, width, height, allocation);
+
+    if(!placed){
+        ++m_failedCount;
+        return false;
+    }
+
+    m_entries.emplace(key, Entry{ allocation, m_frame });
+    m_pages[allocation.page].lastUsedFrame = m_frame;
+    ++m_insertCount;
+    outAllocation = allocation;
+    outInserted = true;
+    return true;
+}
+
+const UiAtlasAllocation* UiAtlasPacker::find(const u64 key)const{
+    const auto found = m_entries.find(key);
+    return found != m_entries.end() ? &found->second.allocation : nullptr;
+}
+
+void UiAtlasPacker::clear(){
+    m_entries.clear();
+    m_pages.clear();
+}
+
+UiAtlasPackerStats UiAtlasPacker::stats()const{
+    UiAtlasPackerStats stats;
+    stats.entryCount = m_entries.size();
+    stats.pageCount = m_pages.size();
+    stats.hitCount = m_hitCount;
+    stats.insertCount = m_insertCount;
+    stats.failedCount = m_failedCount;
+    stats.evictedEntryCount = m_evictedEntryCount;
+    stats.evictedPageCount = m_evictedPageCount;
+    stats.pageArea = static_cast<u64>(m_pageWidth) * m_pageHeight * m_pages.size();
+    for(const Page& page : m_pages){
+        stats.usedArea += page.usedArea;
+        for(const SkylineNode& node : page.skyline)
+            stats.coveredArea += static_cast<u64>(node.width) * node.y;
+    }
+    return stats;
+}
+
+void UiAtlasPacker::resetPage(Page& page){
+    page.skyline.clear();
+    page.skyline.push_back(SkylineNode{ 0u, 0u, m_pageWidth });
+    page.lastUsedFrame = 0u;
+    page.usedArea = 0u;
+    page.entryCount = 0u;
+}
+
+// Bottom-left rule: the lowest resulting top edge wins, and scanning left to right keeps the leftmost on ties.
+bool UiAtlasPacker::findPosition(
+    const Page& page,
+    const u32 width,
+    const u32 height,
+    u32& outNode,
+    u32& outX,
+    u32& outY
+)const{
+    u64 bestBottom = Limit<u64>::s_Max;
+    const SkylineVector& skyline = page.skyline;
+    for(usize nodeIndex = 0u; nodeIndex < skyline.size(); ++nodeIndex){
+        const u32 x = skyline[nodeIndex].x;
+        if(static_cast<u64>(x) + width > m_pageWidth)
+            break;
+
+        u32 y = 0u;
+        u32 remaining = width;
+        bool fits = true;
+        for(usize spanIndex = nodeIndex; remaining != 0u; ++spanIndex){
+            y = Max(y, skyline[spanIndex].y);
+            if(static_cast<u64>(y) + height > m_pageHeight){
+                fits = false;
+                break;
+            }
+            remaining -= Min(remaining, skyline[spanIndex].width);
+        }
+        if(!fits || static_cast<u64>(y) + height >= bestBottom)
+            continue;
+
+        bestBottom = static_cast<u64>(y) + height;
+        outNode = static_cast<u32>(nodeIndex);
+        outX = x;
+        outY = y;
+    }
+    return bestBottom != Limit<u64>::s_Max;
+}
+
+void UiAtlasPacker::placeRect(Page& page, const u32 node, const u32 x, const u32 y, const u32 width, const u32 height){
+    SkylineVector& skyline = page.skyline;
+    skyline.insert(skyline.begin() + node, SkylineNode{ x, y + height, width });
+
+    const u32 right = x + width;
+    for(usize nodeIndex = node + 1u; nodeIndex < skyline.size();){
+        SkylineNode& covered = skyline[nodeIndex];
+        if(covered.x >= right)
+            break;
+
+        const u32 overlap = right - covered.x;
+        if(overlap < covered.width){
+            covered.x += overlap;
+            covered.width -= overlap;
+            break;
+        }
+        skyline.erase(skyline.begin() + nodeIndex);
+    }
+
+    for(usize nodeIndex = 1u; nodeIndex < skyline.size();){
+        if(skyline[nodeIndex - 1u].y != skyline[nodeIndex].y){
+            ++nodeIndex;
+            continue;
+        }
+        skyline[nodeIndex - 1u].width += skyline[nodeIndex].width;
+        skyline.erase(skyline.begin() + nodeIndex);
+    }
+}
+
+bool UiAtlasPacker::insertIntoPage(
+    const u32 pageIndex,
+    const u32 width,
+    const u32 height,
+    UiAtlasAllocation& outAllocation
+){
+    Page& page = m_pages[pageIndex];
+    const u32 paddedWidth = width + m_padding;
+    const u32 paddedHeight = height + m_padding;
+
+    u32 node = 0u;
+    u32 x = 0u;
+    u32 y = 0u;
+    if(!findPosition(page, paddedWidth, paddedHeight, node, x, y))
+        return false;
+
+    placeRect(page, node, x, y, paddedWidth, paddedHeight);
+    page.usedArea += static_cast<u64>(width) * height;
+    ++page.entryCount;
+
+    outAllocation.page = pageIndex;
+    outAllocation.x = x;
+    outAllocation.y = y;
+    outAllocation.width = width;
+    outAllocation.height = height;
+    return true;
+}
+
+bool UiAtlasPacker::evictLeastRecentlyUsedPage(u32& outPageIndex){
+    bool found = false;
+    u64 oldestFrame = m_frame;
+    for(u32 pageIndex = 0u; pageIndex < m_pages.size(); ++pageIndex){
+        if(m_pages[pageIndex].lastUsedFrame >= oldestFrame)
+            continue;
+
+        oldestFrame = m_pages[pageIndex].lastUsedFrame;
+        outPageIndex = pageIndex;
+        found = true;
+    }
+    if(!found)
+        return false;
+
+    for(auto it = m_entries.begin(); it != m_entries.end();){
+        if(it->second.allocation.page != outPageIndex){
+            ++it;
+            continue;
+        }
+        it = m_entries.erase(it);
+        ++m_evictedEntryCount;
+    }
+    resetPage(m_pages[outPageIndex]);
+    ++m_evictedPageCount;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,138 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+
+#include <impl/global.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Texel rectangle of one cached image. `width`/`height` exclude the padding gutter kept to the right and below it.
+struct UiAtlasAllocation{
+    u32 page = 0u;
+    u32 x = 0u;
+    u32 y = 0u;
+    u32 width = 0u;
+    u32 height = 0u;
+};
+
+struct UiAtlasPackerStats{
+    usize entryCount = 0u;
+    usize pageCount = 0u;
+    usize hitCount = 0u;
+    usize insertCount = 0u;
+    usize failedCount = 0u;
+    usize evictedEntryCount = 0u;
+    usize evictedPageCount = 0u;
+    // `usedArea` sums live image texels; `coveredArea` is everything under the page skylines, gutters and holes the
+    // skyline can no longer reach included.
+    u64 usedArea = 0u;
+    u64 coveredArea = 0u;
+    u64 pageArea = 0u;
+
+    [[nodiscard]] f64 fragmentation()const noexcept{
+        return coveredArea != 0u ? 1.0 - static_cast<f64>(usedArea) / static_cast<f64>(coveredArea) : 0.0;
+    }
+    [[nodiscard]] f64 occupancy()const noexcept{
+        return pageArea != 0u ? static_cast<f64>(usedArea) / static_cast<f64>(pageArea) : 0.0;
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Skyline bottom-left packer for small UI images keyed by a caller hash. Images are placed on the first page that
+// fits so a frame's quads concentrate on as few textures as possible. A skyline cannot release one rectangle, so
+// eviction is per page: when every page is full, the page least recently touched is emptied, provided no image on
+// it was acquired during the current frame. Acquiring an image the current frame already uses never invalidates it.
+class UiAtlasPacker final : NoCopy{
+private:
+    struct SkylineNode{
+        u32 x = 0u;
+        u32 y = 0u;
+        u32 width = 0u;
+    };
+    using SkylineVector = Vector<SkylineNode, Core::Alloc::GlobalArena>;
+
+    struct Page{
+        explicit Page(Core::Alloc::GlobalArena& arena)
+            : skyline(arena)
+        {}
+
+        SkylineVector skyline;
+        u64 lastUsedFrame = 0u;
+        u64 usedArea = 0u;
+        usize entryCount = 0u;
+    };
+    using PageVector = Vector<Page, Core::Alloc::GlobalArena>;
+
+    struct Entry{
+        UiAtlasAllocation allocation;
+        u64 lastUsedFrame = 0u;
+    };
+
+
+public:
+    UiAtlasPacker(Core::Alloc::GlobalArena& arena, u32 pageWidth, u32 pageHeight, u32 maxPageCount, u32 padding = 1u);
+
+
+public:
+    // Starts a new LRU frame. Pages touched before this call become eviction candidates again.
+    void beginFrame()noexcept{ ++m_frame; }
+    // Finds or places `key`. `outInserted` is true when the caller must write the image texels into the returned
+    // rectangle; an evicted page keeps its stale texels, so the caller owns clearing the padding gutter too.
+    [[nodiscard]] bool acquire(u64 key, u32 width, u32 height, UiAtlasAllocation& outAllocation, bool& outInserted);
+    [[nodiscard]] const UiAtlasAllocation* find(u64 key)const;
+    void clear();
+
+    [[nodiscard]] UiAtlasPackerStats stats()const;
+    [[nodiscard]] u32 pageWidth()const noexcept{ return m_pageWidth; }
+    [[nodiscard]] u32 pageHeight()const noexcept{ return m_pageHeight; }
+    [[nodiscard]] u32 padding()const noexcept{ return m_padding; }
+    [[nodiscard]] usize pageCount()const noexcept{ return m_pages.size(); }
+    [[nodiscard]] u64 frame()const noexcept{ return m_frame; }
+
+private:
+    void resetPage(Page& page);
+    [[nodiscard]] bool findPosition(const Page& page, u32 width, u32 height, u32& outNode, u32& outX, u32& outY)const;
+    void placeRect(Page& page, u32 node, u32 x, u32 y, u32 width, u32 height);
+    [[nodiscard]] bool insertIntoPage(u32 pageIndex, u32 width, u32 height, UiAtlasAllocation& outAllocation);
+    [[nodiscard]] bool evictLeastRecentlyUsedPage(u32& outPageIndex);
+
+
+private:
+    Core::Alloc::GlobalArena& m_arena;
+    PageVector m_pages;
+    HashMap<u64, Entry, Hasher<u64>, EqualTo<u64>, Core::Alloc::GlobalArena> m_entries;
+    u32 m_pageWidth = 0u;
+    u32 m_pageHeight = 0u;
+    u32 m_maxPageCount = 0u;
+    u32 m_padding = 0u;
+    u64 m_frame = 1u;
+    usize m_hitCount = 0u;
+    usize m_insertCount = 0u;
+    usize m_failedCount = 0u;
+    usize m_evictedEntryCount = 0u;
+    usize m_evictedPageCount = 0u;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_IMPL_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -37,10 +37,14 @@ NWB_IMPL_BEGIN
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+class UiSystem;
+
 struct UiDrawContext{
     Core::ECS::World& world;
     Core::ECS::EntityID entity = Core::ECS::ENTITY_ID_INVALID;
     f32 deltaSeconds = 0.0f;
+    // Owning system, for frame services such as UiSystem::acquireAtlasImage.
+    UiSystem* system = nullptr;
 };
 
 using UiDrawCallback = Function<void(UiDrawContext&)>;
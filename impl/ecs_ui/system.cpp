@@ -32,6 +32,9 @@ static constexpr f32 s_DefaultFramebufferScale = 1.0f;
 static constexpr usize s_TransferPreferredUploadMinimumBytes = 1024u * 1024u;
 static constexpr usize s_UploadAlignmentBytes = sizeof(u32);
 static constexpr Name s_TaskGraphDeclarationArena("impl/ecs_ui/task_graph");
+static constexpr u32 s_AtlasPageExtent = 1024u;
+static constexpr u32 s_AtlasMaxPageCount = 4u;
+static constexpr u32 s_AtlasPadding = 1u;
 
 static void DrawCallbackResetRenderState(const ImDrawList*, const ImDrawCmd*){}
 
@@ -218,6 +221,26 @@ static bool HasPendingTextureUploads(const ImDrawData& drawData){
     return desc;
 }
 
+// Shifts `indexCount` indices of the graph-owned index snapshot by `vertexDelta` so they address the same vertices
+// from an earlier base vertex. Leaves the snapshot untouched and fails if any shifted index would overflow ImDrawIdx.
+[[nodiscard]] static bool RebaseDrawIndices(
+    u8* const indexBytes,
+    const u64 startIndex,
+    const usize indexCount,
+    const u64 vertexDelta
+){
+    ImDrawIdx* const indices = reinterpret_cast<ImDrawIdx*>(indexBytes) + startIndex;
+    ImDrawIdx maxIndex = 0u;
+    for(usize i = 0u; i < indexCount; ++i)
+        maxIndex = Max(maxIndex, indices[i]);
+    if(vertexDelta > static_cast<u64>(Limit<ImDrawIdx>::s_Max - maxIndex))
+        return false;
+
+    for(usize i = 0u; i < indexCount; ++i)
+        indices[i] = static_cast<ImDrawIdx>(indices[i] + vertexDelta);
+    return true;
+}
+
 [[nodiscard]] static bool IsTaskGraphResetCallback(const ImDrawCmd& drawCommand){
     if(!drawCommand.UserCallback)
         return false;
@@ -371,6 +394,14 @@ UiSystem::UiSystem(
     , m_textures(arena)
     , m_textureUploadBatch(arena)
     , m_textureUploadScratch(arena)
+    , m_atlasPacker(
+        arena,
+        __hidden_ui::s_AtlasPageExtent,
+        __hidden_ui::s_AtlasPageExtent,
+        __hidden_ui::s_AtlasMaxPageCount,
+        __hidden_ui::s_AtlasPadding
+    )
+    , m_atlasPages(arena)
     , m_taskGraphVertexUpload(arena)
     , m_taskGraphIndexUpload(arena)
     , m_taskGraphDrawCommands(arena)
@@ -415,6 +446,7 @@ UiSystem::~UiSystem(){
         if(io.BackendRendererUserData == this)
             io.BackendRendererUserData = nullptr;
         invalidateResources();
+        releaseAtlasPages();
         ImGui::DestroyContext(m_imguiContext);
         m_imguiContext = nullptr;
     }
@@ -428,7 +460,7 @@ void UiSystem::update(Core::ECS::World& world, const f32 delta){
     static_cast<void>(world);
     beginFrame(delta);
 
-    UiDrawContext context{ m_world, Core::ECS::ENTITY_ID_INVALID, m_deltaSeconds };
+    UiDrawContext context{ m_world, Core::ECS::ENTITY_ID_INVALID, m_deltaSeconds, this };
     m_world.view<UiComponent>().each(
         [&context](const Core::ECS::EntityID entity, UiComponent& component){
             if(!component.visible || !component.draw)
@@ -461,6 +493,7 @@ void UiSystem::beginFrame(const f32 delta){
     ++m_frameGeneration;
     if(m_frameGeneration == 0u)
         ++m_frameGeneration;
+    m_atlasPacker.beginFrame();
 
     m_deltaSeconds = IsFinite(delta) && delta > 0.0f ? delta : __hidden_ui::s_FallbackDeltaSeconds;
 
@@ -867,6 +900,35 @@ bool UiSystem::prepareTaskGraphDrawUploads(ImDrawData& drawData){
                 return false;
             }
 
+            // Quads sampling the same texture (typically one atlas page) under the same scissor collapse into one
+            // draw when their indices are contiguous in the snapshot. A command from a later draw list starts at a
+            // higher base vertex, so its indices are rebased onto the earlier one while the combined range fits.
+            if(!m_taskGraphDrawCommands.empty()){
+                TaskGraphDrawCommand& previous = m_taskGraphDrawCommands.back();
+                if(
+                    previous.textureHeapHandle == textureResource->sampledImageHeapHandle
+                    && previous.clipMinX == clipMinX
+                    && previous.clipMinY == clipMinY
+                    && previous.clipMaxX == clipMaxX
+                    && previous.clipMaxY == clipMaxY
+                    && static_cast<u64>(previous.startIndexLocation) + previous.elementCount == startIndexLocation
+                    && static_cast<u64>(previous.elementCount) + commandElementCount <= Limit<u32>::s_Max
+                    && startVertexLocation >= previous.startVertexLocation
+                    && (
+                        startVertexLocation == previous.startVertexLocation
+                        || __hidden_ui::RebaseDrawIndices(
+                            m_taskGraphIndexUpload.data(),
+                            startIndexLocation,
+                            commandElementCount,
+                            startVertexLocation - previous.startVertexLocation
+                        )
+                    )
+                ){
+                    previous.elementCount += static_cast<u32>(commandElementCount);
+                    continue;
+                }
+            }
+
             const usize priorCommandCount = m_taskGraphDrawCommands.size();
             m_taskGraphDrawCommands.push_back(TaskGraphDrawCommand{
                 .texture = textureResource->texture,
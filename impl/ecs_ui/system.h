@@ -5,6 +5,7 @@
 #pragma once
 
 
+#include "atlas_packer.h"
 #include "components.h"
 #include "texture_submission.h"
 
@@ -46,6 +47,18 @@ NWB_IMPL_BEGIN
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// Where an atlas-cached image lives this frame. Pass `texture`, `uv0` and `uv1` straight to ImGui::Image or
+// ImDrawList::AddImage; quads on the same page then share one draw.
+struct UiAtlasImage{
+    ImTextureRef texture;
+    ImVec2 uv0 = ImVec2(0.0f, 0.0f);
+    ImVec2 uv1 = ImVec2(0.0f, 0.0f);
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 class UiSystem final
     : public Core::ECS::ISystem
     , public Core::IRenderPass
@@ -97,6 +110,12 @@ public:
     [[nodiscard]] bool wantsMouseCapture()const noexcept{ return m_wantsMouseCapture; }
     [[nodiscard]] bool wantsTextInput()const noexcept{ return m_wantsTextInput; }
 
+    // Caches a small image of tightly packed RGBA8 rows in the shared UI atlas. Call it every frame the image is
+    // drawn; `key` must change whenever the pixels do. Fails for images larger than an atlas page, or when every
+    // page already holds an image drawn this frame.
+    [[nodiscard]] bool acquireAtlasImage(u64 key, u32 width, u32 height, const u8* rgbaPixels, UiAtlasImage& outImage);
+    [[nodiscard]] UiAtlasPackerStats atlasStats()const{ return m_atlasPacker.stats(); }
+
 private:
     struct TaskGraphRenderTask;
     struct TaskGraphUploadCompletionTask;
@@ -122,6 +141,10 @@ private:
     using UiTextureResourcePtr = Core::GlobalUniquePtr<UiTextureResource>;
     using UiTextureResourceVector = Vector<UiTextureResourcePtr, Core::Alloc::GlobalArena>;
     using UiTextureUploadVector = Vector<u8, Core::Alloc::GlobalArena>;
+    // Atlas pages are CPU-owned ImGui user textures, so they reach the backend through the same WantCreate and
+    // WantUpdates requests as the font atlas.
+    using UiAtlasPagePtr = Core::GlobalUniquePtr<ImTextureData>;
+    using UiAtlasPageVector = Vector<UiAtlasPagePtr, Core::Alloc::GlobalArena>;
 
     struct UiPushConstants{
         Float4 scaleTranslate = Float4(0.0f, 0.0f, 0.0f, 0.0f);
@@ -216,6 +239,8 @@ private:
     );
     [[nodiscard]] Core::GpuTaskId declareStandaloneTextureUploadGraph(Core::GpuTaskGraph& graph);
     void destroyTexture(ImTextureData& textureData);
+    [[nodiscard]] ImTextureData* ensureAtlasPage(u32 pageIndex);
+    void releaseAtlasPages();
     [[nodiscard]] UiTextureResource* textureResourceFromId(ImTextureID textureId)const;
     [[nodiscard]] UiTextureResource* fallbackTextureResource()const{
         return m_textures.empty() ? nullptr : m_textures.front().get();
@@ -250,6 +275,8 @@ private:
     UiTextureResourceVector m_textures;
     UiTextureUploadBatch m_textureUploadBatch;
     UiTextureUploadVector m_textureUploadScratch;
+    UiAtlasPacker m_atlasPacker;
+    UiAtlasPageVector m_atlasPages;
     // Graph declaration snapshots both ImGui's transient upload bytes and the draw commands that consume them.
     // GpuTaskGraph then retains all late-record inputs independently of the next ImGui frame.
     UiTextureUploadVector m_taskGraphVertexUpload;
@@ -11,6 +11,8 @@
 #include <impl/assets/graphics/imgui/binding_slots.h>
 #include <core/common/log.h>
 
+#include <imgui_internal.h>
+
 #include <cstdint>
 
 
@@ -458,6 +460,105 @@ void UiSystem::destroyTexture(ImTextureData& textureData){
     textureData.SetTexID(ImTextureID_Invalid);
 }
 
+bool UiSystem::acquireAtlasImage(
+    const u64 key,
+    const u32 width,
+    const u32 height,
+    const u8* const rgbaPixels,
+    UiAtlasImage& outImage
+){
+    if(!m_imguiContext || !rgbaPixels)
+        return false;
+
+    UiAtlasAllocation allocation;
+    bool inserted = false;
+    if(!m_atlasPacker.acquire(key, width, height, allocation, inserted))
+        return false;
+
+    setCurrentContext();
+    ImTextureData* const page = ensureAtlasPage(allocation.page);
+    if(!page)
+        return false;
+
+    if(inserted){
+        // A recycled page still holds the texels of the images evicted from it, so the gutter is cleared with the
+        // copy and bilinear sampling at the image edge never reads a stale neighbour.
+        const u32 pageWidth = m_atlasPacker.pageWidth();
+        const u32 pageHeight = m_atlasPacker.pageHeight();
+        const u32 writeWidth = Min(width + m_atlasPacker.padding(), pageWidth - allocation.x);
+        const u32 writeHeight = Min(height + m_atlasPacker.padding(), pageHeight - allocation.y);
+        const usize rowBytes = static_cast<usize>(width) * __hidden_ui::s_RgbaPixelBytes;
+        const usize writeRowBytes = static_cast<usize>(writeWidth) * __hidden_ui::s_RgbaPixelBytes;
+        for(u32 row = 0u; row < writeHeight; ++row){
+            u8* const destination = static_cast<u8*>(page->GetPixelsAt(
+                static_cast<i32>(allocation.x),
+                static_cast<i32>(allocation.y + row)
+            ));
+            if(row >= height){
+                NWB_MEMSET(destination, 0, writeRowBytes);
+                continue;
+            }
+            NWB_MEMCPY(destination, writeRowBytes, rgbaPixels + static_cast<usize>(row) * rowBytes, rowBytes);
+            NWB_MEMSET(destination + rowBytes, 0, writeRowBytes - rowBytes);
+        }
+
+        page->UseColors = true;
+        if(page->Status != ImTextureStatus_WantDestroy && page->Status != ImTextureStatus_Destroyed){
+            ImTextureDataQueueUpload(
+                page,
+                static_cast<i32>(allocation.x),
+                static_cast<i32>(allocation.y),
+                static_cast<i32>(writeWidth),
+                static_cast<i32>(writeHeight)
+            );
+        }
+    }
+
+    const f32 inversePageWidth = 1.0f / static_cast<f32>(m_atlasPacker.pageWidth());
+    const f32 inversePageHeight = 1.0f / static_cast<f32>(m_atlasPacker.pageHeight());
+    outImage.texture = page->GetTexRef();
+    outImage.uv0 = ImVec2(
+        static_cast<f32>(allocation.x) * inversePageWidth,
+        static_cast<f32>(allocation.y) * inversePageHeight
+    );
+    outImage.uv1 = ImVec2(
+        static_cast<f32>(allocation.x + allocation.width) * inversePageWidth,
+        static_cast<f32>(allocation.y + allocation.height) * inversePageHeight
+    );
+    return true;
+}
+
+ImTextureData* UiSystem::ensureAtlasPage(const u32 pageIndex){
+    while(m_atlasPages.size() <= pageIndex){
+        auto page = Core::MakeGlobalUnique<ImTextureData>(m_arena);
+        if(!page){
+            NWB_LOGGER_ERROR(NWB_TEXT("UiSystem: failed to allocate UI atlas page"));
+            return nullptr;
+        }
+
+        page->Create(
+            ImTextureFormat_RGBA32,
+            static_cast<i32>(m_atlasPacker.pageWidth()),
+            static_cast<i32>(m_atlasPacker.pageHeight())
+        );
+        ImGui::RegisterUserTexture(page.get());
+        m_atlasPages.push_back(Move(page));
+    }
+    return m_atlasPages[pageIndex].get();
+}
+
+// Backend resources for the pages are released with every other ImGui texture in invalidateResources(); this only
+// detaches the CPU pages from the context that is about to be destroyed.
+void UiSystem::releaseAtlasPages(){
+    if(m_imguiContext){
+        setCurrentContext();
+        for(const UiAtlasPagePtr& page : m_atlasPages)
+            ImGui::UnregisterUserTexture(page.get());
+    }
+    m_atlasPages.clear();
+    m_atlasPacker.clear();
+}
+
 UiSystem::UiTextureResource* UiSystem::textureResourceFromId(const ImTextureID textureId)const{
     if(textureId == ImTextureID_Invalid)
         return nullptr;
@@ -5,6 +5,7 @@
 #include "crash_ingest.h"
 #include "crash_paths.h"
 
+#include <core/crash/package_codec.h>
 #include <core/crash/package_names.h>
 
 #include <global/binary.h>
@@ -33,6 +34,7 @@ using CrashBytes = Vector<u8, LogArena>;
 namespace CrashNames = ::NWB::Core::Crash::PackageNames;
 
 inline constexpr usize s_GeneratedJsonNeedleReserveSlack = 4u;
+inline constexpr usize s_MaxInflatedCrashArchiveBytes = 1024u * 1024u * 1024u;
 
 static void ApplyRetention(LogArena& arena, const CrashIngestConfig& config){
     if(!ApplyDirectoryRetention(
@@ -131,6 +133,20 @@ static void AppendAcceptedIngestDetails(LogArena& arena, CrashText& outReport, c
         outError = "failed to read crash archive";
         return false;
     }
+    if(Core::Crash::PackageCodec::IsCompressedArchive(archiveBytes.data(), archiveBytes.size())){
+        CrashBytes inflatedBytes{arena};
+        if(!Core::Crash::PackageCodec::DecompressArchive(
+            arena,
+            archiveBytes.data(),
+            archiveBytes.size(),
+            s_MaxInflatedCrashArchiveBytes,
+            inflatedBytes
+        )){
+            outError = "invalid compressed crash archive";
+            return false;
+        }
+        archiveBytes = Move(inflatedBytes);
+    }
 
     usize cursor = 0u;
     AStringView line;
@@ -192,6 +208,83 @@ static void AppendAcceptedIngestDetails(LogArena& arena, CrashText& outReport, c
 }
 
 
+struct CrashBatchEntry{
+    usize offset = 0u;
+    usize size = 0u;
+};
+using CrashBatchEntryVector = Vector<CrashBatchEntry, LogArena>;
+
+[[nodiscard]] static bool IsCrashUploadBatch(const CrashBytes& uploadBytes){
+    constexpr AStringView header(CrashNames::s_BatchHeaderText);
+    return uploadBytes.size() >= header.size()
+        && AStringView(reinterpret_cast<const char*>(uploadBytes.data()), header.size()) == header
+    ;
+}
+
+// Validates the framing of a whole batch before any entry is ingested, so a truncated upload is rejected as one unit
+// instead of half of it landing.
+[[nodiscard]] static bool SplitCrashUploadBatch(const CrashBytes& uploadBytes, CrashBatchEntryVector& outEntries, CrashText& outError){
+    outEntries.clear();
+
+    usize cursor = 0u;
+    AStringView line;
+    if(!NextLfByteLine(uploadBytes, cursor, line) || line != CrashNames::s_BatchHeaderLine){
+        outError = "invalid crash batch header";
+        return false;
+    }
+
+    constexpr AStringView prefix(CrashNames::s_BatchPackageHeaderPrefix);
+    while(cursor < uploadBytes.size()){
+        u64 entrySize = 0u;
+        if(
+            !NextLfByteLine(uploadBytes, cursor, line)
+            || line.size() <= prefix.size()
+            || AStringView(line.data(), prefix.size()) != prefix
+            || !ParseU64(AStringView(line.data() + prefix.size(), line.size() - prefix.size()), entrySize)
+        ){
+            outError = "malformed crash batch package header";
+            return false;
+        }
+        if(entrySize == 0u || entrySize > static_cast<u64>(uploadBytes.size() - cursor)){
+            outError = "truncated crash batch package payload";
+            return false;
+        }
+
+        outEntries.push_back(CrashBatchEntry{ cursor, static_cast<usize>(entrySize) });
+        cursor += static_cast<usize>(entrySize);
+
+        AStringView separator;
+        AStringView endMarker;
+        if(
+            !NextLfByteLine(uploadBytes, cursor, separator)
+            || !separator.empty()
+            || !NextLfByteLine(uploadBytes, cursor, endMarker)
+            || endMarker != CrashNames::s_ArchiveEntryEndLine
+        ){
+            outError = "malformed crash batch package footer";
+            return false;
+        }
+    }
+
+    if(outEntries.empty()){
+        outError = "crash batch contained no packages";
+        return false;
+    }
+    return true;
+}
+
+[[nodiscard]] static Path CrashBatchEntryPath(LogArena& arena, const Path& uploadPath, const usize entryIndex){
+    const auto fileName = StringFormat(
+        arena,
+        "{}_{}{}",
+        PathToString<char>(arena, uploadPath.stem()),
+        entryIndex,
+        PathToString<char>(arena, uploadPath.extension())
+    );
+    return uploadPath.parent_path() / fileName;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -374,7 +467,7 @@ static void AppendAcceptedIngestDetails(LogArena& arena, CrashText& outReport, c
     const AStringView reason
 ){
     ErrorCode removeError;
-    if(!RemoveAllIfExists(packageDirectory, removeError))
+    if(!packageDirectory.empty() && !RemoveAllIfExists(packageDirectory, removeError))
         NWB_LOGGER_WARNING(NWB_TEXT("Failed to remove rejected crash package directory"));
 
     Path invalidPath(arena);
@@ -454,6 +547,54 @@ CrashIngestResult ProcessCrashUpload(LogArena& arena, const Path& archivePath, c
 }
 
 
+CrashIngestResultVector ProcessCrashUploadBatch(LogArena& arena, const Path& uploadPath, const CrashIngestConfig& config){
+    namespace Ingest = __hidden_logger_crash_ingest;
+
+    CrashIngestResultVector results(arena);
+    Ingest::CrashBytes uploadBytes{arena};
+    ErrorCode readError;
+    if(!ReadBinaryFile(uploadPath, uploadBytes, readError) || !Ingest::IsCrashUploadBatch(uploadBytes)){
+        results.push_back(ProcessCrashUpload(arena, uploadPath, config));
+        return results;
+    }
+
+    Ingest::CrashText error(arena);
+    Ingest::CrashBatchEntryVector entries(arena);
+    if(!Ingest::SplitCrashUploadBatch(uploadBytes, entries, error)){
+        results.push_back(Ingest::RejectCrashUpload(arena, uploadPath, Path(arena), config, AStringView(error.data(), error.size())));
+        return results;
+    }
+
+    // Each package lands in the inbox as an archive of its own, so retention, rejection and the raw copy keep working
+    // per package exactly as they do for single uploads.
+    results.reserve(entries.size());
+    for(usize entryIndex = 0u; entryIndex < entries.size(); ++entryIndex){
+        const Ingest::CrashBatchEntry& entry = entries[entryIndex];
+        const Path entryPath = Ingest::CrashBatchEntryPath(arena, uploadPath, entryIndex);
+        const BinaryByteView entryBytes{ uploadBytes.data() + entry.offset, entry.size };
+        if(!WriteBinaryFile(entryPath, entryBytes)){
+            CrashIngestResult result(arena);
+            result.type = Type::Error;
+            result.message = StringFormat(
+                arena,
+                NWB_TEXT("Crash upload rejected: failed to unpack batch package {}; raw='{}'"),
+                entryIndex,
+                PathToString<tchar>(uploadPath)
+            );
+            results.push_back(Move(result));
+            continue;
+        }
+
+        results.push_back(ProcessCrashUpload(arena, entryPath, config));
+    }
+
+    ErrorCode removeError;
+    if(!RemoveFile(uploadPath, removeError))
+        NWB_LOGGER_WARNING(NWB_TEXT("Failed to remove unpacked crash upload batch"));
+    return results;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -52,7 +52,12 @@ struct CrashIngestResult{
 };
 
 
+using CrashIngestResultVector = Vector<CrashIngestResult, LogArena>;
+
+
 [[nodiscard]] CrashIngestResult ProcessCrashUpload(LogArena& arena, const Path& archivePath, const CrashIngestConfig& config);
+// Accepts any upload body: a plain or compressed package archive yields one result, a batch one result per package.
+[[nodiscard]] CrashIngestResultVector ProcessCrashUploadBatch(LogArena& arena, const Path& uploadPath, const CrashIngestConfig& config);
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
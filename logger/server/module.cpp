@@ -318,9 +318,10 @@ void Server::crashIngestUpdate(Server* self){
                 ingestConfig.symbolication.symbolStoreDirectory = self->m_crashIngestConfig.symbolication.symbolStoreDirectory;
                 ingestConfig.retention = self->m_crashIngestConfig.retention;
 
-                const Path archivePath(ingestArena, AStringView(crashUpload.path));
-                CrashIngestResult ingestResult = ProcessCrashUpload(ingestArena, archivePath, ingestConfig);
-                self->enqueue(Move(ingestResult.message), ingestResult.type);
+                const Path uploadPath(ingestArena, AStringView(crashUpload.path));
+                CrashIngestResultVector ingestResults = ProcessCrashUploadBatch(ingestArena, uploadPath, ingestConfig);
+                for(CrashIngestResult& ingestResult : ingestResults)
+                    self->enqueue(Move(ingestResult.message), ingestResult.type);
             }
             catch(const GeneralException& e){
                 self->enqueue(
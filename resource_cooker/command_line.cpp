@@ -27,6 +27,7 @@ struct ParsedCookOptions{
     AInteropString cacheDirectory;
     AInteropString configuration;
     AInteropString assetType;
+    u32 maxConcurrentShaderCompiles = NWB::Core::Assets::s_DefaultMaxConcurrentShaderCompiles;
 };
 
 inline constexpr AStringView s_ImplDirectoryName = "impl";
@@ -137,6 +138,11 @@ static void ConfigureCommandLineOptions(CLI::App& outApp, __hidden_command_line:
     outApp.add_option("--cache-directory", outOptions.cacheDirectory, "Asset cache root directory path");
     outApp.add_option("--configuration", outOptions.configuration, "Build configuration label");
     outApp.add_option("--asset-type", outOptions.assetType, "Asset cooker type (graphics, ...)");
+    outApp.add_option(
+        "--max-shader-compiles",
+        outOptions.maxConcurrentShaderCompiles,
+        "Shader compiler processes kept in flight (0 = one per cook thread)"
+    );
 }
 
 
@@ -154,6 +160,7 @@ CommandLineParseResult::Enum ParseCommandLine(
     outOptions.cacheDirectory.clear();
     outOptions.configuration.clear();
     outOptions.assetType.clear();
+    outOptions.maxConcurrentShaderCompiles = NWB::Core::Assets::s_DefaultMaxConcurrentShaderCompiles;
 
     if(CommandLineHasValidArgv(argc, argv)){
         for(int i = 1; i < argc; ++i){
@@ -201,6 +208,7 @@ CommandLineParseResult::Enum ParseCommandLine(
         outOptions.assetType
     ))
         return CommandLineParseResult::Error;
+    outOptions.maxConcurrentShaderCompiles = parsedOptions.maxConcurrentShaderCompiles;
 
     return CommandLineParseResult::Success;
 }
@@ -0,0 +1,238 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// In-memory skeleton and animation clip codecs shared by the AnimationSystem tests and the sampling profile. Every
+// skeleton is a chain of joints named "joint_<index>"; every clip rotates each joint about +Y by
+// offset + amplitude * sin(frame * s_AnimationTestFrequency + joint * s_AnimationTestJointPhase) with one key per frame.
+
+
+#pragma once
+
+
+#include <core/assets/manager.h>
+#include <impl/assets_animation/asset.h>
+#include <impl/assets_animation/compression.h>
+#include <impl/assets_skeleton/asset.h>
+
+#include <global/simdmath.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace Tests{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+inline constexpr f32 s_AnimationTestFrameRate = 30.0f;
+inline constexpr f32 s_AnimationTestFrequency = 0.2f;
+inline constexpr f32 s_AnimationTestJointPhase = 0.1f;
+inline constexpr f32 s_AnimationTestJointOffset = 0.25f;
+inline constexpr usize s_AnimationTestJointNameCapacity = 32u;
+
+
+struct AnimationTestClipDesc{
+    Name clip = NAME_NONE;
+    Name skeleton = NAME_NONE;
+    u32 frameCount = 1u;
+    f32 offset = 0.0f;
+    f32 amplitude = 0.0f;
+};
+
+struct AnimationTestSkeletonDesc{
+    Name skeleton = NAME_NONE;
+    u32 jointCount = 0u;
+};
+
+
+[[nodiscard]] inline Name AnimationTestJointName(const u32 jointIndex){
+    char buffer[s_AnimationTestJointNameCapacity] = "joint_";
+    usize length = 6u;
+    char digits[10] = {};
+    usize digitCount = 0u;
+    u32 value = jointIndex;
+    do{
+        digits[digitCount++] = static_cast<char>('0' + value % 10u);
+        value /= 10u;
+    }while(value != 0u);
+    while(digitCount > 0u)
+        buffer[length++] = digits[--digitCount];
+    return Name(AStringView(buffer, length));
+}
+
+[[nodiscard]] inline f32 AnimationTestJointAngle(const AnimationTestClipDesc& desc, const f32 frame, const u32 jointIndex){
+    return desc.offset + desc.amplitude * Sin(frame * s_AnimationTestFrequency + static_cast<f32>(jointIndex) * s_AnimationTestJointPhase);
+}
+
+// Joint translation along the chain; the clip only animates rotation so this comes from the bind pose.
+[[nodiscard]] inline Float3U AnimationTestJointTranslation(const u32 jointIndex){
+    return Float3U(0.0f, jointIndex == 0u ? 0.0f : 0.1f, 0.0f);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class AnimationTestBinarySource final : public Core::Assets::IAssetBinarySource{
+public:
+    virtual bool readAssetBinary(const Name& virtualPath, Core::Assets::AssetBytes& outBinary)const override{
+        static_cast<void>(virtualPath);
+        outBinary.push_back(0u);
+        return true;
+    }
+};
+
+class AnimationTestSkeletonCodec final : public Core::Assets::IAssetCodec{
+public:
+    AnimationTestSkeletonCodec(const AnimationTestSkeletonDesc* descs, const usize descCount)
+        : Core::Assets::IAssetCodec(Impl::Skeleton::AssetTypeName())
+        , m_descs(descs)
+        , m_descCount(descCount)
+    {}
+
+
+public:
+    virtual bool deserialize(
+        Core::Assets::AssetArena& arena,
+        const Name& virtualPath,
+        const Core::Assets::AssetBytes& binary,
+        UniquePtr<Core::Assets::IAsset>& outAsset
+    )const override{
+        static_cast<void>(binary);
+
+        const AnimationTestSkeletonDesc* desc = nullptr;
+        for(usize i = 0u; i < m_descCount; ++i){
+            if(m_descs[i].skeleton == virtualPath)
+                desc = &m_descs[i];
+        }
+        if(!desc)
+            return false;
+
+        Impl::Skeleton::JointVector joints(arena);
+        Impl::Skeleton::JointIndexMap jointIndices(0, Hasher<Name>(), EqualTo<Name>(), arena);
+        for(u32 jointIndex = 0u; jointIndex < desc->jointCount; ++jointIndex){
+            const Float3U translation = AnimationTestJointTranslation(jointIndex);
+            Impl::SkeletonJoint joint;
+            joint.parentIndex = jointIndex == 0u ? Impl::s_SkeletonInvalidJointIndex : jointIndex - 1u;
+            StoreFloat(MatrixTranslation(translation.x, translation.y, translation.z), &joint.localBindPose);
+            joints.push_back(joint);
+            jointIndices.emplace(AnimationTestJointName(jointIndex), jointIndex);
+        }
+
+        auto skeleton = MakeUnique<Impl::Skeleton>(arena, virtualPath);
+        skeleton->setJoints(Move(joints), Move(jointIndices));
+        outAsset = Move(skeleton);
+        return true;
+    }
+
+#if defined(NWB_COOK)
+    virtual bool serialize(const Core::Assets::IAsset& asset, Core::Assets::AssetBytes& outBinary)const override{
+        static_cast<void>(asset);
+        static_cast<void>(outBinary);
+        return false;
+    }
+#endif
+
+
+private:
+    const AnimationTestSkeletonDesc* m_descs = nullptr;
+    usize m_descCount = 0u;
+};
+
+class AnimationTestClipCodec final : public Core::Assets::IAssetCodec{
+public:
+    AnimationTestClipCodec(const AnimationTestClipDesc* descs, const usize descCount, const u32 jointCount)
+        : Core::Assets::IAssetCodec(Impl::AnimationClip::AssetTypeName())
+        , m_descs(descs)
+        , m_descCount(descCount)
+        , m_jointCount(jointCount)
+    {}
+
+
+public:
+    virtual bool deserialize(
+        Core::Assets::AssetArena& arena,
+        const Name& virtualPath,
+        const Core::Assets::AssetBytes& binary,
+        UniquePtr<Core::Assets::IAsset>& outAsset
+    )const override{
+        static_cast<void>(binary);
+
+        const AnimationTestClipDesc* desc = nullptr;
+        for(usize i = 0u; i < m_descCount; ++i){
+            if(m_descs[i].clip == virtualPath)
+                desc = &m_descs[i];
+        }
+        if(!desc || desc->frameCount == 0u)
+            return false;
+
+        Impl::AnimationClip::TrackVector tracks(arena);
+        Impl::AnimationClip::RotationKeyVector rotationKeys(arena);
+        for(u32 jointIndex = 0u; jointIndex < m_jointCount; ++jointIndex){
+            Impl::AnimationClipTrack track;
+            track.joint = AnimationTestJointName(jointIndex);
+            track.rotation.firstKey = static_cast<u32>(rotationKeys.size());
+            track.rotation.keyCount = desc->frameCount;
+            for(u32 frame = 0u; frame < desc->frameCount; ++frame){
+                const f32 halfAngle = 0.5f * AnimationTestJointAngle(*desc, static_cast<f32>(frame), jointIndex);
+                Impl::AnimationRotationKey key;
+                key.frame = static_cast<u16>(frame);
+                Impl::AnimationClipCompression::PackRotation(Float4(0.0f, Sin(halfAngle), 0.0f, Cos(halfAngle)), key.packed);
+                rotationKeys.push_back(key);
+            }
+            tracks.push_back(track);
+        }
+
+        Core::Assets::AssetRef<Impl::Skeleton> skeleton;
+        skeleton.virtualPath = desc->skeleton;
+
+        auto clip = MakeUnique<Impl::AnimationClip>(arena, virtualPath);
+        clip->setSkeleton(skeleton);
+        clip->setTiming(s_AnimationTestFrameRate, desc->frameCount);
+        clip->setTracks(Move(tracks), Move(rotationKeys), Impl::AnimationClip::VectorKeyVector(arena), Impl::AnimationClip::VectorKeyVector(arena));
+        if(!clip->validatePayload())
+            return false;
+
+        outAsset = Move(clip);
+        return true;
+    }
+
+#if defined(NWB_COOK)
+    virtual bool serialize(const Core::Assets::IAsset& asset, Core::Assets::AssetBytes& outBinary)const override{
+        static_cast<void>(asset);
+        static_cast<void>(outBinary);
+        return false;
+    }
+#endif
+
+
+private:
+    const AnimationTestClipDesc* m_descs = nullptr;
+    usize m_descCount = 0u;
+    u32 m_jointCount = 0u;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
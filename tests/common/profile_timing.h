@@ -0,0 +1,105 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Small shared helpers for the manually launched CPU profile executables under tests/unit. Profiles collect a fixed
+// number of wall-clock samples and report min/median/max so a single noisy sample does not skew an A/B comparison.
+
+
+#pragma once
+
+
+#include <global/global.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace Tests{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+inline constexpr u32 s_MaxProfileSampleCount = 64u;
+
+
+struct ProfileTimingSamples{
+    f64 values[s_MaxProfileSampleCount] = {};
+    u32 count = 0u;
+
+    [[nodiscard]] bool append(const f64 value)noexcept{
+        if(count >= LengthOf(values))
+            return false;
+        values[count++] = value;
+        return true;
+    }
+};
+
+struct ProfileTimingSummary{
+    f64 minimum = 0.0;
+    f64 median = 0.0;
+    f64 maximum = 0.0;
+};
+
+
+[[nodiscard]] inline ProfileTimingSummary SummarizeProfileTiming(const ProfileTimingSamples& samples)noexcept{
+    ProfileTimingSummary summary;
+    if(samples.count == 0u)
+        return summary;
+
+    f64 ordered[s_MaxProfileSampleCount] = {};
+    for(u32 index = 0u; index < samples.count; ++index)
+        ordered[index] = samples.values[index];
+    for(u32 index = 1u; index < samples.count; ++index){
+        const f64 value = ordered[index];
+        u32 insertion = index;
+        while(insertion > 0u && ordered[insertion - 1u] > value){
+            ordered[insertion] = ordered[insertion - 1u];
+            --insertion;
+        }
+        ordered[insertion] = value;
+    }
+
+    summary.minimum = ordered[0u];
+    summary.maximum = ordered[samples.count - 1u];
+    const u32 middle = samples.count / 2u;
+    summary.median = (samples.count & 1u) != 0u
+        ? ordered[middle]
+        : (ordered[middle - 1u] + ordered[middle]) * 0.5
+    ;
+    return summary;
+}
+
+inline void EmitProfileTiming(const char* name, const ProfileTimingSamples& samples){
+    const ProfileTimingSummary summary = SummarizeProfileTiming(samples);
+    NWB_COUT
+        << '\"' << name << "\":{"
+        << "\"min_ms\":" << summary.minimum * 1000.0 << ','
+        << "\"median_ms\":" << summary.median * 1000.0 << ','
+        << "\"max_ms\":" << summary.maximum * 1000.0
+        << '}'
+    ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,296 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static constexpr u32 s_AnimationClipTestWaveFrameCount = 31u;
+static constexpr f32 s_AnimationClipTestWaveAmplitude = 1.5f;
+// Quantization adds up to one 15-bit smallest-three step on top of the reduction tolerance.
+static constexpr f32 s_AnimationClipTestRotationSlack = 0.0005f;
+static constexpr f32 s_AnimationClipTestTranslationSlack = 0.0001f;
+
+static constexpr AStringView s_AnimationClipTestLinearMetadata =
+    "animation_clip asset;\n\n"
+    "asset.skeleton = \"project/characters/skeleton\";\n"
+    "asset.frame_rate = 30.0;\n"
+    "asset.tracks = [\n"
+    "    {\n"
+    "        \"joint\": \"root\",\n"
+    "        \"rotations\": [[0.0, 0.0, 0.0, 2.0]],\n"
+    "        \"translations\": [[0.0, 1.0, 0.0], [1.0, 1.0, 0.0], [2.0, 1.0, 0.0], [3.0, 1.0, 0.0], [4.0, 1.0, 0.0]],\n"
+    "    },\n"
+    "    {\n"
+    "        \"joint\": \"spine\",\n"
+    "        \"scales\": [[1.0, 1.0, 1.0], [1.0, 1.0, 1.0], [1.0, 1.0, 1.0], [1.0, 1.0, 1.0], [1.0, 1.0, 1.0]],\n"
+    "    },\n"
+    "];\n"
+;
+
+
+[[nodiscard]] static f32 AnimationClipTestWaveAngle(const u32 frame){
+    return s_AnimationClipTestWaveAmplitude * Sin(static_cast<f32>(frame) * 0.25f);
+}
+
+template<typename... Args>
+static void AppendAnimationClipTestFormattedMeta(AString& meta, AFormatString<Args...> format, Args&&... args){
+    const auto line = StringFormat(NWB::Tests::TestDetail::Arena(), format, Forward<Args>(args)...);
+    AppendTestMeta(meta, AStringView(line.data(), line.size()));
+}
+
+static AString BuildAnimationClipTestWaveMeta(){
+    AString meta;
+    AppendTestMeta(meta,
+        "animation_clip asset;\n\n"
+        "asset.skeleton = \"project/characters/skeleton\";\n"
+        "asset.frame_rate = 30.0;\n"
+        "asset.tracks = [\n"
+        "    {\n"
+        "        \"joint\": \"arm\",\n"
+        "        \"rotations\": [\n"
+    );
+    for(u32 frame = 0u; frame < s_AnimationClipTestWaveFrameCount; ++frame){
+        const f32 halfAngle = 0.5f * AnimationClipTestWaveAngle(frame);
+        AppendAnimationClipTestFormattedMeta(meta, "            [0.0, {}, 0.0, {}],\n", Sin(halfAngle), Cos(halfAngle));
+    }
+    AppendTestMeta(meta,
+        "        ],\n"
+        "    },\n"
+        "];\n"
+    );
+    return meta;
+}
+
+[[nodiscard]] static bool ParseAnimationClipTestEntry(
+    TestArena& testArena,
+    const AStringView metadata,
+    NWB::Impl::AnimationClipCookEntry& outEntry
+){
+    NWB::Core::Metascript::Document document(testArena.arena);
+    if(!document.parse(metadata))
+        return false;
+
+    const Path metadataPath = AssetsGraphicsTestCaseRoot(testArena, "animation_clip_parse") / "assets" / "clip.nwb";
+    return NWB::Impl::ParseAnimationClipCookMetadata(Name("project/characters/clip"), metadataPath, document.asset(), outEntry);
+}
+
+// Mirrors the runtime sampler: nlerp between the two surrounding keys along the shortest arc.
+[[nodiscard]] static Float4 SampleAnimationClipTestRotation(const NWB::Impl::AnimationClip& clip, const NWB::Impl::AnimationClipTrack& track, const u32 frame){
+    const NWB::Impl::AnimationRotationKey* keys = clip.rotationKeys().data() + track.rotation.firstKey;
+    u32 lower = 0u;
+    u32 upper = 0u;
+    f32 factor = 0.0f;
+    NWB::Impl::AnimationClipCompression::FindKeyPair(keys, track.rotation.keyCount, static_cast<f32>(frame), lower, upper, factor);
+
+    const SIMDVector from = LoadFloat(NWB::Impl::AnimationClipCompression::UnpackRotation(keys[lower].packed));
+    SIMDVector to = LoadFloat(NWB::Impl::AnimationClipCompression::UnpackRotation(keys[upper].packed));
+    if(VectorGetX(Vector4Dot(from, to)) < 0.0f)
+        to = VectorNegate(to);
+
+    Float4 result;
+    StoreFloat(QuaternionNormalize(VectorLerp(from, to, factor)), &result);
+    return result;
+}
+
+[[nodiscard]] static Float3U SampleAnimationClipTestTranslation(const NWB::Impl::AnimationClip& clip, const NWB::Impl::AnimationClipTrack& track, const u32 frame){
+    const NWB::Impl::AnimationVectorKey* keys = clip.translationKeys().data() + track.translation.firstKey;
+    u32 lower = 0u;
+    u32 upper = 0u;
+    f32 factor = 0.0f;
+    NWB::Impl::AnimationClipCompression::FindKeyPair(keys, track.translation.keyCount, static_cast<f32>(frame), lower, upper, factor);
+
+    const Float3U from = NWB::Impl::AnimationClipCompression::DequantizeVector(keys[lower], track.translationRange);
+    const Float3U to = NWB::Impl::AnimationClipCompression::DequantizeVector(keys[upper], track.translationRange);
+    return Float3U(from.x + (to.x - from.x) * factor, from.y + (to.y - from.y) * factor, from.z + (to.z - from.z) * factor);
+}
+
+[[nodiscard]] static f32 AnimationClipTestRotationAngle(const Float4& lhs, const Float4& rhs){
+    const f32 dot = Min(1.0f, Abs(lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z + lhs.w * rhs.w));
+    return 2.0f * ASin(Sqrt(Max(0.0f, 1.0f - dot * dot)));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TEST(AssetsGraphics, AnimationClipCookerReducesLinearAndConstantChannels){
+    CapturingLogger logger;
+    NWB::Core::Common::LoggerRegistrationGuard loggerRegistrationGuard(logger);
+
+    TestArena testArena;
+    NWB::Impl::AnimationClipCookEntry entry(testArena.arena);
+    ASSERT_TRUE(ParseAnimationClipTestEntry(testArena, s_AnimationClipTestLinearMetadata, entry));
+    EXPECT_EQ(entry.frameCount, 5u);
+
+    NWB::Impl::AnimationClip clip(testArena.arena);
+    ASSERT_TRUE(NWB::Impl::BuildAnimationClipAsset(entry, clip));
+    ASSERT_EQ(clip.tracks().size(), 2u);
+
+    const u32 rootIndex = clip.findTrackIndex(Name("root"));
+    const u32 spineIndex = clip.findTrackIndex(Name("spine"));
+    ASSERT_NE(rootIndex, NWB::Impl::s_AnimationClipInvalidTrackIndex);
+    ASSERT_NE(spineIndex, NWB::Impl::s_AnimationClipInvalidTrackIndex);
+    EXPECT_EQ(clip.findTrackIndex(Name("missing")), NWB::Impl::s_AnimationClipInvalidTrackIndex);
+
+    const NWB::Impl::AnimationClipTrack& root = clip.tracks()[rootIndex];
+    const NWB::Impl::AnimationClipTrack& spine = clip.tracks()[spineIndex];
+    EXPECT_EQ(root.rotation.keyCount, 1u);
+    EXPECT_EQ(root.translation.keyCount, 2u);
+    EXPECT_EQ(root.scale.keyCount, 0u);
+    EXPECT_EQ(spine.rotation.keyCount, 0u);
+    EXPECT_EQ(spine.translation.keyCount, 0u);
+    EXPECT_EQ(spine.scale.keyCount, 1u);
+
+    // The authored rotation is normalized before packing.
+    const Float4 rootRotation = SampleAnimationClipTestRotation(clip, root, 0u);
+    EXPECT_LE(AnimationClipTestRotationAngle(rootRotation, Float4(0.0f, 0.0f, 0.0f, 1.0f)), s_AnimationClipTestRotationSlack);
+    for(u32 frame = 0u; frame < entry.frameCount; ++frame){
+        const Float3U translation = SampleAnimationClipTestTranslation(clip, root, frame);
+        EXPECT_NEAR(translation.x, static_cast<f32>(frame), s_AnimationClipTestTranslationSlack);
+        EXPECT_NEAR(translation.y, 1.0f, s_AnimationClipTestTranslationSlack);
+        EXPECT_NEAR(translation.z, 0.0f, s_AnimationClipTestTranslationSlack);
+    }
+    EXPECT_EQ(logger.errorCount(), 0u);
+}
+
+TEST(AssetsGraphics, AnimationClipCookerKeepsRotationErrorWithinTolerance){
+    CapturingLogger logger;
+    NWB::Core::Common::LoggerRegistrationGuard loggerRegistrationGuard(logger);
+
+    TestArena testArena;
+    const AString meta = BuildAnimationClipTestWaveMeta();
+    NWB::Impl::AnimationClipCookEntry entry(testArena.arena);
+    ASSERT_TRUE(ParseAnimationClipTestEntry(testArena, AStringView(meta.data(), meta.size()), entry));
+    ASSERT_EQ(entry.frameCount, s_AnimationClipTestWaveFrameCount);
+
+    NWB::Impl::AnimationClip clip(testArena.arena);
+    ASSERT_TRUE(NWB::Impl::BuildAnimationClipAsset(entry, clip));
+    ASSERT_EQ(clip.tracks().size(), 1u);
+
+    const NWB::Impl::AnimationClipTrack& arm = clip.tracks()[0];
+    EXPECT_GT(arm.rotation.keyCount, 2u);
+    EXPECT_LT(arm.rotation.keyCount, s_AnimationClipTestWaveFrameCount);
+    for(u32 frame = 0u; frame < s_AnimationClipTestWaveFrameCount; ++frame){
+        const f32 halfAngle = 0.5f * AnimationClipTestWaveAngle(frame);
+        const Float4 expected(0.0f, Sin(halfAngle), 0.0f, Cos(halfAngle));
+        EXPECT_LE(
+            AnimationClipTestRotationAngle(SampleAnimationClipTestRotation(clip, arm, frame), expected),
+            entry.rotationTolerance + s_AnimationClipTestRotationSlack
+        ) << "frame " << frame;
+    }
+    EXPECT_EQ(logger.errorCount(), 0u);
+}
+
+TEST(AssetsGraphics, AnimationClipCodecRoundTripPreservesKeys){
+    CapturingLogger logger;
+    NWB::Core::Common::LoggerRegistrationGuard loggerRegistrationGuard(logger);
+
+    TestArena testArena;
+    NWB::Impl::AnimationClipCookEntry entry(testArena.arena);
+    ASSERT_TRUE(ParseAnimationClipTestEntry(testArena, s_AnimationClipTestLinearMetadata, entry));
+    NWB::Impl::AnimationClip clip(testArena.arena);
+    ASSERT_TRUE(NWB::Impl::BuildAnimationClipAsset(entry, clip));
+
+    NWB::Impl::AnimationClipAssetCodec codec;
+    NWB::Core::Assets::AssetBytes binary = MakeAssetBytes(testArena);
+    ASSERT_TRUE(codec.serialize(clip, binary));
+
+    UniquePtr<NWB::Core::Assets::IAsset> loadedAsset;
+    ASSERT_TRUE(codec.deserialize(testArena.arena, clip.virtualPath(), binary, loadedAsset));
+    ASSERT_NE(loadedAsset.get(), nullptr);
+    const NWB::Impl::AnimationClip& loaded = static_cast<const NWB::Impl::AnimationClip&>(*loadedAsset);
+    EXPECT_EQ(loaded.skeleton().name(), Name("project/characters/skeleton"));
+    EXPECT_EQ(loaded.frameRate(), 30.0f);
+    EXPECT_EQ(loaded.frameCount(), 5u);
+    ASSERT_EQ(loaded.tracks().size(), clip.tracks().size());
+    ASSERT_EQ(loaded.rotationKeys().size(), clip.rotationKeys().size());
+    ASSERT_EQ(loaded.translationKeys().size(), clip.translationKeys().size());
+    ASSERT_EQ(loaded.scaleKeys().size(), clip.scaleKeys().size());
+    for(usize trackIndex = 0u; trackIndex < clip.tracks().size(); ++trackIndex){
+        EXPECT_EQ(loaded.tracks()[trackIndex].joint, clip.tracks()[trackIndex].joint);
+        EXPECT_EQ(loaded.tracks()[trackIndex].translation.keyCount, clip.tracks()[trackIndex].translation.keyCount);
+        EXPECT_EQ(loaded.tracks()[trackIndex].translationRange.extent.x, clip.tracks()[trackIndex].translationRange.extent.x);
+    }
+    for(usize keyIndex = 0u; keyIndex < clip.translationKeys().size(); ++keyIndex){
+        EXPECT_EQ(loaded.translationKeys()[keyIndex].frame, clip.translationKeys()[keyIndex].frame);
+        EXPECT_EQ(loaded.translationKeys()[keyIndex].value[0], clip.translationKeys()[keyIndex].value[0]);
+    }
+
+    binary.pop_back();
+    UniquePtr<NWB::Core::Assets::IAsset> truncatedAsset;
+    EXPECT_FALSE(codec.deserialize(testArena.arena, clip.virtualPath(), binary, truncatedAsset));
+}
+
+TEST(AssetsGraphics, AnimationClipCookerRejectsMismatchedChannelLength){
+    CapturingLogger logger;
+    NWB::Core::Common::LoggerRegistrationGuard loggerRegistrationGuard(logger);
+
+    TestArena testArena;
+    static constexpr AStringView s_Metadata =
+        "animation_clip asset;\n\n"
+        "asset.skeleton = \"project/characters/skeleton\";\n"
+        "asset.frame_rate = 30.0;\n"
+        "asset.tracks = [\n"
+        "    { \"joint\": \"root\", \"translations\": [[0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [2.0, 0.0, 0.0]] },\n"
+        "    { \"joint\": \"spine\", \"scales\": [[1.0, 1.0, 1.0], [2.0, 2.0, 2.0]] },\n"
+        "];\n"
+    ;
+    NWB::Impl::AnimationClipCookEntry entry(testArena.arena);
+    EXPECT_FALSE(ParseAnimationClipTestEntry(testArena, s_Metadata, entry));
+    EXPECT_TRUE(logger.sawErrorContaining(NWB_TEXT("expected 1 or 3")));
+}
+
+TEST(AssetsGraphics, AnimationClipCookerRejectsZeroRotation){
+    CapturingLogger logger;
+    NWB::Core::Common::LoggerRegistrationGuard loggerRegistrationGuard(logger);
+
+    TestArena testArena;
+    static constexpr AStringView s_Metadata =
+        "animation_clip asset;\n\n"
+        "asset.skeleton = \"project/characters/skeleton\";\n"
+        "asset.frame_rate = 30.0;\n"
+        "asset.tracks = [\n"
+        "    { \"joint\": \"root\", \"rotations\": [[0.0, 0.0, 0.0, 0.0]] },\n"
+        "];\n"
+    ;
+    NWB::Impl::AnimationClipCookEntry entry(testArena.arena);
+    EXPECT_FALSE(ParseAnimationClipTestEntry(testArena, s_Metadata, entry));
+    EXPECT_TRUE(logger.sawErrorContaining(NWB_TEXT("must not be a zero quaternion")));
+}
+
+TEST(AssetsGraphics, AnimationClipCookerBuildsAnimationClipAsset){
+    CapturingLogger logger;
+    NWB::Core::Common::LoggerRegistrationGuard loggerRegistrationGuard(logger);
+
+    TestArena testArena;
+    Path root(testArena.arena);
+    Path outputDirectory(testArena.arena);
+    ASSERT_TRUE(PrepareAssetsGraphicsCookCase(
+        testArena,
+        "animation_clip_cooker_round_trip",
+        root,
+        outputDirectory
+    ));
+
+    const Path assetRoot = root / "assets";
+    ASSERT_TRUE(WriteTextFile(assetRoot / "characters" / "walk.nwb", s_AnimationClipTestLinearMetadata));
+    ASSERT_TRUE(CookPreparedGraphicsAssetRoots(testArena, root, outputDirectory, { assetRoot }));
+
+    UniquePtr<NWB::Core::Assets::IAsset> loadedAsset;
+    ASSERT_TRUE(LoadCookedAsset<NWB::Impl::AnimationClipAssetCodec>(
+        testArena,
+        outputDirectory,
+        Name("project/characters/walk"),
+        loadedAsset
+    ));
+    ASSERT_NE(loadedAsset.get(), nullptr);
+    const NWB::Impl::AnimationClip& clip = static_cast<const NWB::Impl::AnimationClip&>(*loadedAsset);
+    EXPECT_EQ(clip.frameCount(), 5u);
+    EXPECT_EQ(clip.tracks().size(), 2u);
+
+    ErrorCode errorCode;
+    EXPECT_TRUE(RemoveAllIfExists(root, errorCode));
+    EXPECT_EQ(logger.errorCount(), 0u);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
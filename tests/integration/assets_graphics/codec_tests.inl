@@ -345,6 +345,69 @@ TEST(AssetsGraphics, AssetVolumeCookWritesRegistryObjectCache){
     EXPECT_EQ(logger.errorCount(), 0u);
 }
 
+TEST(AssetsGraphics, AssetVolumeCookReusesInputCacheUntilInputsChange){
+    TestArena testArena;
+    Path root(testArena.arena);
+    Path outputDirectory(testArena.arena);
+    ASSERT_TRUE(PrepareAssetsGraphicsCookCase(
+        testArena,
+        "asset_volume_input_cache",
+        root,
+        outputDirectory
+    ));
+
+    const Path assetRoot = root / "assets";
+    const Path textureDataPath = assetRoot / "textures" / "checker.tex";
+    ASSERT_TRUE(WriteTextFile(assetRoot / "meshes" / "minimal_mesh.nwb", s_MinimalMeshMeta));
+    ASSERT_TRUE(WriteTextFile(assetRoot / "textures" / "checker.nwb", s_TextureTestMetadata));
+    ASSERT_TRUE(WriteBinaryFile(textureDataPath, MakeTextureTestUastcPayload(testArena)));
+
+    {
+        CapturingLogger logger;
+        NWB::Core::Common::LoggerRegistrationGuard loggerRegistrationGuard(logger);
+        EXPECT_TRUE(CookPreparedGraphicsAssetRoots(testArena, root, outputDirectory, { assetRoot }, 2u));
+        EXPECT_TRUE(logger.sawMessageContaining(NWB_TEXT("input cache hits=0 misses=2 uncached=0")));
+        EXPECT_TRUE(logger.sawMessageContaining(NWB_TEXT("'graphics_shaders'")));
+        EXPECT_TRUE(logger.sawMessageContaining(NWB_TEXT("'registry_objects'")));
+        EXPECT_EQ(logger.errorCount(), 0u);
+    }
+    {
+        CapturingLogger logger;
+        NWB::Core::Common::LoggerRegistrationGuard loggerRegistrationGuard(logger);
+        EXPECT_TRUE(CookPreparedGraphicsAssetRoots(testArena, root, outputDirectory, { assetRoot }, 2u));
+        EXPECT_TRUE(logger.sawMessageContaining(NWB_TEXT("input cache hits=2 misses=0 uncached=0")));
+        EXPECT_EQ(logger.errorCount(), 0u);
+
+        UniquePtr<NWB::Core::Assets::IAsset> loadedMesh;
+        EXPECT_TRUE(LoadCookedMinimalMesh(testArena, outputDirectory, loadedMesh));
+    }
+
+    // The texture .nwb is untouched, but its sidecar is a recorded input of the same cache entry.
+    ASSERT_TRUE(WriteBinaryFile(textureDataPath, MakeTextureTestUastcPayload(testArena, 96u, 7u)));
+    {
+        CapturingLogger logger;
+        NWB::Core::Common::LoggerRegistrationGuard loggerRegistrationGuard(logger);
+        EXPECT_TRUE(CookPreparedGraphicsAssetRoots(testArena, root, outputDirectory, { assetRoot }, 2u));
+        EXPECT_TRUE(logger.sawMessageContaining(NWB_TEXT("input cache hits=1 misses=1 uncached=0")));
+        EXPECT_EQ(logger.errorCount(), 0u);
+
+        UniquePtr<NWB::Core::Assets::IAsset> loadedTexture;
+        ASSERT_TRUE(LoadCookedAsset<NWB::Impl::TextureAssetCodec>(
+            testArena,
+            outputDirectory,
+            Name("project/textures/checker"),
+            loadedTexture
+        ));
+        ASSERT_NE(loadedTexture.get(), nullptr);
+        const NWB::Impl::Texture& texture = static_cast<const NWB::Impl::Texture&>(*loadedTexture);
+        ASSERT_FALSE(texture.uastcBlocks().empty());
+        EXPECT_EQ(texture.uastcBlocks()[0u], 7u);
+    }
+
+    ErrorCode errorCode;
+    EXPECT_TRUE(RemoveAllIfExists(root, errorCode));
+}
+
 static NWB::Impl::MeshletBounds MakeTestMeshletBounds(){
     return NWB::Impl::MeshletBounds{
         Float4U(0.0f, 0.0f, 0.0f, 1.0f),
@@ -9,17 +9,22 @@
 #include <impl/assets_model/asset.h>
 #include <core/assets/bunch/cook.h>
 #include <core/assets/volume/cooker.h>
+#include <core/assets/volume/manifest_cook_graph.h>
 #include <core/assets/cook_entry_registry.h>
 #include <impl/assets_material/cook.h>
 #include <impl/assets_material/binary_payload.h>
 #include <impl/assets_shader/asset.h>
 #include <impl/assets_shader/cook.h>
+#include <impl/assets_graphics/shader_volume_writer.h>
 #include <impl/assets_texture/asset.h>
 #include <impl/assets_texture/binary_payload.h>
 #include <impl/assets_texture/cook.h>
 #include <impl/assets_sampler/asset.h>
 #include <impl/assets_sampler/binary_payload.h>
 #include <impl/assets_sampler/cook.h>
+#include <impl/assets_animation/asset.h>
+#include <impl/assets_animation/compression.h>
+#include <impl/assets_animation/cook.h>
 #include <impl/assets/graphics/mesh/runtime_constants.h>
 #include <impl/ecs_csg/shape_registry.h>
 
@@ -47,6 +52,8 @@
 #include <global/hash_utils.h>
 #include <global/math/convert.h>
 #include <global/simdmath.h>
+#include <global/thread.h>
+#include <global/timer.h>
 
 #include <cmath>
 
@@ -1792,6 +1799,7 @@ static bool FindShaderArchiveSourceChecksum(
 #include "material_tests.inl"
 #include "material_cook_tests.inl"
 #include "sampler_tests.inl"
+#include "animation_clip_tests.inl"
 
 #include "volume_extensibility_tests.inl"
 
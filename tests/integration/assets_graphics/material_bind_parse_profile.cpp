@@ -0,0 +1,251 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Manual CPU probe for the material bind cook parse. It reads the repository's .bind sources and runs the cook's bind
+// reader over each of them with Document and with CompactDocument, one fresh document and entry per parse like
+// ParseMaterialBindSource does. The same reader handles both DOMs, so the timing difference is the DOM alone. It
+// reports min/median/max wall time per corpus pass and fails if the two DOMs produce different bind entries.
+
+
+#include <impl/assets_material/bind_private.h>
+
+#include <core/alloc/general.h>
+#include <core/common/application_entry.h>
+#include <core/common/module.h>
+
+#include <tests/common/profile_timing.h>
+#include <tests/common/test_context.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace MaterialBindParseProfile{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<typename T>
+using Vector = Tests::TestVector<T>;
+using MaterialBindEntry = Impl::MaterialBindEntry;
+using MaterialCookString = Impl::MaterialCookString;
+
+
+inline constexpr u32 s_CopyCount = 512u;
+inline constexpr u32 s_WarmupCount = 2u;
+inline constexpr u32 s_SampleCount = 15u;
+
+inline constexpr Name s_ProfileArena("tests/integration/assets_graphics/material_bind_parse_profile");
+inline constexpr Name s_ProfileScratchArena("tests/integration/assets_graphics/material_bind_parse_profile/scratch");
+
+inline constexpr AStringView s_BindSources[] = {
+    "CoolStuff/Testbed/assets/shaders/surface.bind",
+    "tests/smoke/assets/shaders/smoke_surface.bind",
+    "tests/smoke/assets/shaders/frost_surface.bind",
+    "tests/smoke/assets/shaders/texture_smoke_surface.bind",
+};
+
+
+struct Source{
+    Path path;
+    MaterialCookString text;
+
+    Source(Core::Alloc::GlobalArena& arena, Path&& sourcePath)
+        : path(Move(sourcePath))
+        , text(arena)
+    {}
+};
+
+struct Result{
+    usize sourceBytes = 0u;
+    usize parseCount = 0u;
+    Tests::ProfileTimingSamples document;
+    Tests::ProfileTimingSamples compact;
+};
+
+
+static Path RepoRoot(Core::Alloc::GlobalArena& arena){
+    return Path(arena, __FILE__).parent_path().parent_path().parent_path().parent_path().lexically_normal();
+}
+
+[[nodiscard]] static bool LoadSources(Core::Alloc::GlobalArena& arena, Vector<Source>& outSources, usize& outBytes){
+    const Path root = RepoRoot(arena);
+    outSources.reserve(LengthOf(s_BindSources));
+    outBytes = 0u;
+    for(const AStringView relativePath : s_BindSources){
+        Source& source = outSources.emplace_back(arena, root / relativePath);
+        if(!Impl::MaterialBindDetail::ReadMaterialBindText(source.path, source.text))
+            return false;
+        outBytes += source.text.size();
+    }
+    return true;
+}
+
+template<typename DocumentT>
+[[nodiscard]] static bool ParseSource(
+    Core::Alloc::GlobalArena& arena,
+    const Source& source,
+    MaterialBindEntry& outEntry,
+    Core::Alloc::ScratchArena& scratchArena
+){
+    DocumentT document(arena);
+    return
+        Impl::MaterialBindDetail::ParseMaterialBindDocument(source.path, AStringView(source.text), document)
+        && Impl::MaterialBindDetail::ParseMaterialBindSource(source.path, document, arena, outEntry, scratchArena)
+    ;
+}
+
+template<typename DocumentT>
+static void Measure(Core::Alloc::GlobalArena& arena, const Vector<Source>& sources, Tests::ProfileTimingSamples& outSamples){
+    Core::Alloc::ScratchArena scratchArena(s_ProfileScratchArena);
+    for(u32 i = 0u; i < s_WarmupCount + s_SampleCount; ++i){
+        const Timer begin = TimerNow();
+        for(u32 copy = 0u; copy < s_CopyCount; ++copy){
+            for(const Source& source : sources){
+                MaterialBindEntry entry(arena);
+                if(!ParseSource<DocumentT>(arena, source, entry, scratchArena))
+                    return;
+            }
+        }
+        if(i >= s_WarmupCount && !outSamples.append(DurationInSeconds<f64>(TimerNow(), begin)))
+            return;
+    }
+}
+
+[[nodiscard]] static bool SameAttributes(
+    const Impl::MaterialCookVector<Impl::MaterialBindAttribute>& expected,
+    const Impl::MaterialCookVector<Impl::MaterialBindAttribute>& actual
+){
+    if(expected.size() != actual.size())
+        return false;
+    for(usize i = 0u; i < expected.size(); ++i){
+        if(expected[i].name != actual[i].name || expected[i].arguments != actual[i].arguments)
+            return false;
+    }
+    return true;
+}
+
+[[nodiscard]] static bool SameEntry(const MaterialBindEntry& expected, const MaterialBindEntry& actual){
+    if(expected.source != actual.source)
+        return false;
+    if(expected.structs.size() != actual.structs.size() || expected.instances.size() != actual.instances.size())
+        return false;
+
+    for(usize i = 0u; i < expected.structs.size(); ++i){
+        const Impl::MaterialBindStruct& expectedStruct = expected.structs[i];
+        const Impl::MaterialBindStruct& actualStruct = actual.structs[i];
+        if(expectedStruct.name != actualStruct.name || expectedStruct.fields.size() != actualStruct.fields.size())
+            return false;
+        if(!SameAttributes(expectedStruct.attributes, actualStruct.attributes))
+            return false;
+        for(usize field = 0u; field < expectedStruct.fields.size(); ++field){
+            const Impl::MaterialBindField& expectedField = expectedStruct.fields[field];
+            const Impl::MaterialBindField& actualField = actualStruct.fields[field];
+            if(expectedField.type != actualField.type || expectedField.name != actualField.name)
+                return false;
+            if(!SameAttributes(expectedField.attributes, actualField.attributes))
+                return false;
+        }
+    }
+    for(usize i = 0u; i < expected.instances.size(); ++i){
+        if(expected.instances[i].type != actual.instances[i].type || expected.instances[i].name != actual.instances[i].name)
+            return false;
+    }
+    return true;
+}
+
+[[nodiscard]] static bool EntriesMatch(Core::Alloc::GlobalArena& arena, const Vector<Source>& sources){
+    Core::Alloc::ScratchArena scratchArena(s_ProfileScratchArena);
+    for(const Source& source : sources){
+        MaterialBindEntry document(arena);
+        MaterialBindEntry compact(arena);
+        if(!ParseSource<Core::Metascript::Document>(arena, source, document, scratchArena))
+            return false;
+        if(!ParseSource<Core::Metascript::CompactDocument>(arena, source, compact, scratchArena))
+            return false;
+        if(!SameEntry(document, compact))
+            return false;
+    }
+    return true;
+}
+
+[[nodiscard]] static bool RunProfile(Result& outResult){
+    Core::Alloc::GlobalArena arena(s_ProfileArena);
+
+    Vector<Source> sources;
+    if(!LoadSources(arena, sources, outResult.sourceBytes))
+        return false;
+    outResult.sourceBytes *= s_CopyCount;
+    outResult.parseCount = sources.size() * s_CopyCount;
+    if(!EntriesMatch(arena, sources))
+        return false;
+
+    Measure<Core::Metascript::Document>(arena, sources, outResult.document);
+    Measure<Core::Metascript::CompactDocument>(arena, sources, outResult.compact);
+    return outResult.document.count == s_SampleCount && outResult.compact.count == s_SampleCount;
+}
+
+static void EmitResult(const Result& result, const bool matched){
+    const f64 megabytes = static_cast<f64>(result.sourceBytes) / (1024.0 * 1024.0);
+    const f64 parses = static_cast<f64>(result.parseCount);
+    const f64 documentMedian = Tests::SummarizeProfileTiming(result.document).median;
+    const f64 compactMedian = Tests::SummarizeProfileTiming(result.compact).median;
+
+    NWB_COUT
+        << "{\"status\":\"" << (matched ? "ok" : "failed") << "\","
+        << "\"parses\":" << result.parseCount << ','
+        << "\"source_bytes\":" << result.sourceBytes << ','
+        << "\"samples\":" << s_SampleCount << ','
+        << "\"document_us_per_bind\":" << (parses > 0.0 ? documentMedian * 1000000.0 / parses : 0.0) << ','
+        << "\"compact_us_per_bind\":" << (parses > 0.0 ? compactMedian * 1000000.0 / parses : 0.0) << ','
+        << "\"document_mib_per_s\":" << (documentMedian > 0.0 ? megabytes / documentMedian : 0.0) << ','
+        << "\"compact_mib_per_s\":" << (compactMedian > 0.0 ? megabytes / compactMedian : 0.0) << ','
+    ;
+    Tests::EmitProfileTiming("document", result.document);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming("compact", result.compact);
+    NWB_COUT << "}\n";
+}
+
+[[nodiscard]] static int EntryPoint(const isize, tchar**, void*){
+    Core::Common::InitializerGuard commonInitializerGuard;
+    if(!commonInitializerGuard.initialize()){
+        NWB_CERR << "material bind parse profile initialization failed\n";
+        return 1;
+    }
+
+    Result result;
+    const bool matched = RunProfile(result);
+    EmitResult(result, matched);
+    return matched ? 0 : 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_DEFINE_APPLICATION_ENTRY_POINT(::NWB::MaterialBindParseProfile::EntryPoint)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -614,6 +614,204 @@ TEST(AssetsGraphics, ShaderCookIgnoresInvalidBytecodeCache){
     EXPECT_TRUE(RemoveAllIfExists(root, errorCode));
 }
 
+inline constexpr u32 s_FakeShaderCompileDelayMS = 20u;
+inline constexpr u32 s_FakeShaderVariantsPerEntry = 4u;
+
+struct FakeShaderCompilerStats{
+    Atomic<u32> inFlight{ 0u };
+    Atomic<u32> peakInFlight{ 0u };
+    Atomic<u32> compileCount{ 0u };
+
+    void reset(){
+        inFlight.store(0u, MemoryOrder::relaxed);
+        peakInFlight.store(0u, MemoryOrder::relaxed);
+        compileCount.store(0u, MemoryOrder::relaxed);
+    }
+};
+static FakeShaderCompilerStats s_FakeShaderCompilerStats;
+
+// Stands in for slangc: it holds each request for a fixed delay so overlapping calls are observable and returns a
+// two-word SPIR-V stub whose second word identifies the variant.
+class FakeShaderCompiler final : public NWB::Impl::ShaderCook::IShaderCompiler{
+public:
+    explicit FakeShaderCompiler(NWB::Impl::ShaderCook::CookArena& memoryArena)
+        : NWB::Impl::ShaderCook::IShaderCompiler(memoryArena)
+    {}
+
+
+public:
+    virtual bool compileVariant(
+        const NWB::Impl::ShaderCook::ShaderCompilerRequest& request,
+        NWB::Impl::ShaderCook::CookVector<u8>& outBytecode
+    )override{
+        const u32 inFlight = s_FakeShaderCompilerStats.inFlight.fetch_add(1u, MemoryOrder::acq_rel) + 1u;
+        u32 peakInFlight = s_FakeShaderCompilerStats.peakInFlight.load(MemoryOrder::relaxed);
+        while(peakInFlight < inFlight
+            && !s_FakeShaderCompilerStats.peakInFlight.compare_exchange_weak(peakInFlight, inFlight, MemoryOrder::relaxed)
+        ){}
+
+        SleepMS(s_FakeShaderCompileDelayMS);
+
+        const u32 words[] = { 0x07230203u, static_cast<u32>(ComputeFnv64Text(request.variantName)) };
+        outBytecode.resize(sizeof(words));
+        NWB_MEMCPY(outBytecode.data(), outBytecode.size(), words, sizeof(words));
+
+        s_FakeShaderCompilerStats.compileCount.fetch_add(1u, MemoryOrder::relaxed);
+        s_FakeShaderCompilerStats.inFlight.fetch_sub(1u, MemoryOrder::acq_rel);
+        return true;
+    }
+};
+
+static NWB::Core::GlobalUniquePtr<NWB::Impl::ShaderCook::IShaderCompiler> CreateFakeShaderCompiler(
+    NWB::Impl::ShaderCook::CookArena& memoryArena
+){
+    return NWB::Core::MakeGlobalUnique<FakeShaderCompiler>(memoryArena, memoryArena);
+}
+
+static bool AppendFakePreparedShader(
+    TestArena& testArena,
+    const AStringView shaderName,
+    NWB::Impl::AssetsGraphicsCookDetail::PreparedShaderVector& preparedEntries
+){
+    NWB::Impl::AssetsGraphicsCookDetail::PreparedShaderEntry preparedEntry(testArena.arena);
+    NWB::Impl::ShaderCook::ShaderEntry& entry = preparedEntry.entry;
+    entry.name.assign(shaderName.data(), shaderName.size());
+    if(!entry.stage.assign("ps") || !entry.archiveStage.assign("ps") || !entry.targetProfile.assign("6_6"))
+        return false;
+
+    NWB::Impl::ShaderCook::DefineEntry variantValues(testArena.arena);
+    for(u32 i = 0u; i < s_FakeShaderVariantsPerEntry; ++i){
+        NWB::Impl::ShaderCook::CookString value(testArena.arena);
+        value.push_back(static_cast<char>('0' + i));
+        variantValues.values.push_back(Move(value));
+    }
+    entry.defineValues.insert_or_assign(
+        NWB::Impl::ShaderCook::CookString("NWB_FAKE_VARIANT", testArena.arena),
+        Move(variantValues)
+    );
+
+    preparedEntry.sourcePath = Path(testArena.arena, "fake.slang");
+    preparedEntry.variantCount = s_FakeShaderVariantsPerEntry;
+    preparedEntries.push_back(Move(preparedEntry));
+    return true;
+}
+
+struct FakeShaderCookRun{
+    NWB::Core::Assets::AssetsVolumeCookDetail::AssetVolumePackManifest manifest;
+    f64 seconds = 0.0;
+    u32 peakInFlight = 0u;
+    u32 compileCount = 0u;
+
+    explicit FakeShaderCookRun(TestArena& testArena)
+        : manifest(testArena.arena)
+    {}
+};
+
+static bool CookFakeShaderVariants(
+    TestArena& testArena,
+    const Path& cacheDirectory,
+    const AStringView configurationSafeName,
+    const u32 workerThreadCount,
+    const u32 maxConcurrentCompiles,
+    FakeShaderCookRun& outRun
+){
+    NWB::Impl::AssetsGraphicsCookDetail::PreparedShaderVector preparedEntries(testArena.arena);
+    if(!AppendFakePreparedShader(testArena, "project/shaders/fake_variants_a", preparedEntries)
+        || !AppendFakePreparedShader(testArena, "project/shaders/fake_variants_b", preparedEntries)
+    )
+        return false;
+
+    NWB::Impl::ShaderCook shaderCook(testArena.arena, &CreateFakeShaderCompiler);
+    NWB::Core::Alloc::ThreadPool threadPool(workerThreadCount, CpuAffinity::Any);
+    NWB::Impl::AssetsGraphicsCookDetail::VirtualPathHashSet seenVirtualPathHashes(
+        0,
+        Hasher<NameHash>(),
+        EqualTo<NameHash>(),
+        testArena.arena
+    );
+    NWB::Core::Alloc::ScratchArena scratchArena(s_ShaderScratchArena);
+
+    s_FakeShaderCompilerStats.reset();
+    const Timer begin = TimerNow();
+    const bool appended = NWB::Impl::AssetsGraphicsCookDetail::AppendPreparedShadersToManifest(
+        testArena.arena,
+        shaderCook,
+        threadPool,
+        maxConcurrentCompiles,
+        cacheDirectory,
+        configurationSafeName,
+        preparedEntries,
+        outRun.manifest,
+        seenVirtualPathHashes,
+        scratchArena
+    );
+    outRun.seconds = DurationInSeconds<f64>(TimerNow(), begin);
+    outRun.peakInFlight = s_FakeShaderCompilerStats.peakInFlight.load(MemoryOrder::acquire);
+    outRun.compileCount = s_FakeShaderCompilerStats.compileCount.load(MemoryOrder::acquire);
+    return appended;
+}
+
+TEST(AssetsGraphics, ShaderVariantsCompileConcurrentlyInDeterministicOrder){
+    CapturingLogger logger;
+    NWB::Core::Common::LoggerRegistrationGuard loggerRegistrationGuard(logger);
+
+    TestArena testArena;
+    Path root(testArena.arena);
+    EXPECT_TRUE(PrepareAssetsGraphicsCaseRoot(testArena, "shader_variants_compile_concurrently", root));
+
+    static constexpr u32 s_VariantCount = s_FakeShaderVariantsPerEntry * 2u;
+    static constexpr u32 s_MaxConcurrentCompiles = 3u;
+
+    // Separate configuration names keep the second cook from hitting the first cook's bytecode cache.
+    FakeShaderCookRun serialRun(testArena);
+    FakeShaderCookRun parallelRun(testArena);
+    EXPECT_TRUE(CookFakeShaderVariants(testArena, root / "cache", "serial", 0u, 0u, serialRun));
+    EXPECT_TRUE(CookFakeShaderVariants(testArena, root / "cache", "parallel", 4u, s_MaxConcurrentCompiles, parallelRun));
+
+    EXPECT_EQ(serialRun.compileCount, s_VariantCount);
+    EXPECT_EQ(parallelRun.compileCount, s_VariantCount);
+    EXPECT_EQ(serialRun.peakInFlight, 1u);
+    EXPECT_GT(parallelRun.peakInFlight, 1u);
+    EXPECT_LE(parallelRun.peakInFlight, s_MaxConcurrentCompiles);
+
+    // One payload per variant followed by the archive index, in the same order no matter how compiles interleave.
+    const auto& serialEntries = serialRun.manifest.entries;
+    const auto& parallelEntries = parallelRun.manifest.entries;
+    ASSERT_EQ(serialEntries.size(), static_cast<usize>(s_VariantCount) + 1u);
+    ASSERT_EQ(parallelEntries.size(), serialEntries.size());
+    for(usize i = 0u; i < serialEntries.size(); ++i){
+        EXPECT_EQ(parallelEntries[i].virtualPath, serialEntries[i].virtualPath);
+        EXPECT_TRUE(parallelEntries[i].payloadBytes == serialEntries[i].payloadBytes);
+    }
+    EXPECT_EQ(serialEntries.back().virtualPath, NWB::Core::ShaderArchive::IndexVirtualPathName());
+
+    NWB::Core::GraphicsBytes indexBinary(testArena.arena);
+    indexBinary.assign(parallelEntries.back().payloadBytes.begin(), parallelEntries.back().payloadBytes.end());
+    NWB::Core::GraphicsVector<NWB::Core::ShaderArchive::Record> records(testArena.arena);
+    EXPECT_TRUE(NWB::Core::ShaderArchive::deserializeIndex(indexBinary, records));
+    ASSERT_EQ(records.size(), static_cast<usize>(s_VariantCount));
+    for(usize i = 0u; i < records.size(); ++i){
+        EXPECT_EQ(records[i].shaderName, Name(i < s_FakeShaderVariantsPerEntry
+            ? "project/shaders/fake_variants_a"
+            : "project/shaders/fake_variants_b"
+        ));
+        EXPECT_EQ(
+            NWB::Core::ShaderArchive::buildVirtualPathName(records[i].shaderName, AStringView(records[i].variantName), records[i].stage),
+            parallelEntries[i].virtualPath
+        );
+    }
+
+    EXPECT_LT(parallelRun.seconds, serialRun.seconds);
+    RecordProperty("shader_variant_serial_us", static_cast<int>(serialRun.seconds * 1000000.0));
+    RecordProperty("shader_variant_parallel_us", static_cast<int>(parallelRun.seconds * 1000000.0));
+    RecordProperty("shader_variant_peak_in_flight", static_cast<int>(parallelRun.peakInFlight));
+
+    EXPECT_EQ(logger.errorCount(), 0u);
+
+    ErrorCode errorCode;
+    EXPECT_TRUE(RemoveAllIfExists(root, errorCode));
+}
+
 using CookSingleMetaFn = bool(*)(AStringView, AStringView, TestArena&, Path&, Path&);
 using LoadCookedAssetFn = bool(*)(TestArena&, const Path&, UniquePtr<NWB::Core::Assets::IAsset>&);
 
@@ -205,6 +205,166 @@ TEST(AssetsGraphics, ProjectCookEntryAssetBunchCook){
     EXPECT_EQ(logger.errorCount(), 0u);
 }
 
+using ManifestCookerVector = NWB::Core::Assets::AssetsVolumeCookDetail::AssetVolumeManifestCookerVector;
+using ManifestPack = NWB::Core::Assets::AssetsVolumeCookDetail::AssetVolumePackManifest;
+using ManifestStageTimingVector = NWB::Core::Assets::AssetsVolumeCookDetail::AssetVolumeCookStageTimingVector;
+using ManifestCookerWorkers = NWB::Core::Assets::AssetsVolumeCookDetail::AssetVolumeCookerWorkers;
+
+static constexpr u32 s_ManifestProbeDelayMS = 40u;
+static constexpr usize s_ManifestProbeFanOutItems = 4u;
+
+static constexpr Name s_ManifestProbeProducerProduct("tests/assets_graphics/manifest_probe_producer");
+
+static bool AppendManifestProbeEntry(
+    ManifestPack& manifest,
+    NWB::Core::Assets::CookEntryPathHashSet& seenVirtualPathHashes,
+    const Name virtualPath
+){
+    const u32 marker = s_ProjectProbeDocumentMarker;
+    if(!seenVirtualPathHashes.insert(virtualPath.hash()).second)
+        return false;
+    return NWB::Core::Assets::AssetsVolumeCookDetail::AppendPayloadBytesToManifest(
+        manifest,
+        virtualPath,
+        static_cast<const void*>(&marker),
+        sizeof(marker)
+    );
+}
+
+static bool RunManifestProbeCookers(
+    TestArena& testArena,
+    NWB::Core::Alloc::ThreadPool& threadPool,
+    ManifestCookerVector& manifestCookers,
+    ManifestPack& outManifest,
+    ManifestStageTimingVector& outTimings
+){
+    NWB::Core::Assets::CookEntryPathHashSet seenVirtualPathHashes(0, Hasher<NameHash>(), EqualTo<NameHash>(), testArena.arena);
+    return NWB::Core::Assets::AssetsVolumeCookDetail::RunAssetVolumeManifestCookers(
+        testArena.arena,
+        threadPool,
+        manifestCookers,
+        outManifest,
+        seenVirtualPathHashes,
+        outTimings
+    );
+}
+
+TEST(AssetsGraphics, ManifestCookerWaitsForItsInputs){
+    CapturingLogger logger;
+    NWB::Core::Common::LoggerRegistrationGuard loggerRegistrationGuard(logger);
+
+    TestArena testArena;
+    NWB::Core::Alloc::ThreadPool threadPool(2u, CpuAffinity::Any);
+    Atomic<bool> produced{ false };
+    bool consumerSawProducer = false;
+
+    // The consumer registers first, so only the declared edge keeps it from starting alongside the producer.
+    ManifestCookerVector manifestCookers(testArena.arena);
+    NWB::Core::Assets::AssetsVolumeCookDetail::AssetVolumeManifestCooker& consumer = manifestCookers.emplace_back(
+        testArena.arena,
+        AStringView("probe_consumer"),
+        [&](
+            ManifestPack& manifest,
+            NWB::Core::Assets::CookEntryPathHashSet& seenVirtualPathHashes,
+            const ManifestCookerWorkers&,
+            NWB::Core::Assets::ScratchArena&
+        ){
+            consumerSawProducer = produced.load(MemoryOrder::acquire);
+            return AppendManifestProbeEntry(manifest, seenVirtualPathHashes, Name("project/probe/consumer"));
+        }
+    );
+    consumer.inputs.push_back(s_ManifestProbeProducerProduct);
+
+    NWB::Core::Assets::AssetsVolumeCookDetail::AssetVolumeManifestCooker& producer = manifestCookers.emplace_back(
+        testArena.arena,
+        AStringView("probe_producer"),
+        [&](
+            ManifestPack& manifest,
+            NWB::Core::Assets::CookEntryPathHashSet& seenVirtualPathHashes,
+            const ManifestCookerWorkers&,
+            NWB::Core::Assets::ScratchArena&
+        ){
+            SleepMS(s_ManifestProbeDelayMS);
+            produced.store(true, MemoryOrder::release);
+            return AppendManifestProbeEntry(manifest, seenVirtualPathHashes, Name("project/probe/producer"));
+        }
+    );
+    producer.outputs.push_back(s_ManifestProbeProducerProduct);
+
+    ManifestPack manifest(testArena.arena);
+    ManifestStageTimingVector timings(testArena.arena);
+    EXPECT_TRUE(RunManifestProbeCookers(testArena, threadPool, manifestCookers, manifest, timings));
+    EXPECT_TRUE(consumerSawProducer);
+
+    // Manifests and timings still come back in registration order.
+    EXPECT_EQ(manifest.entries.size(), 2u);
+    if(manifest.entries.size() == 2u){
+        EXPECT_EQ(manifest.entries[0].virtualPath, Name("project/probe/consumer"));
+        EXPECT_EQ(manifest.entries[1].virtualPath, Name("project/probe/producer"));
+    }
+    EXPECT_EQ(timings.size(), 2u);
+    if(timings.size() == 2u){
+        EXPECT_EQ(AStringView(timings[0].name.c_str()), AStringView("probe_consumer"));
+        EXPECT_EQ(AStringView(timings[1].name.c_str()), AStringView("probe_producer"));
+    }
+    EXPECT_EQ(logger.errorCount(), 0u);
+}
+
+TEST(AssetsGraphics, IndependentManifestCookersFanOutConcurrently){
+    CapturingLogger logger;
+    NWB::Core::Common::LoggerRegistrationGuard loggerRegistrationGuard(logger);
+
+    TestArena testArena;
+    NWB::Core::Alloc::ThreadPool threadPool(2u, CpuAffinity::Any);
+
+    struct FanOutSpan{
+        Timer begin;
+        Timer end;
+    };
+    FanOutSpan spans[2];
+
+    // Both cookers fan out like the shader and registry-object cookers do, on the one cook pool whose workers are
+    // already running the two cookers. ThreadPool::parallelFor would have made the second fan-out wait for the first.
+    ManifestCookerVector manifestCookers(testArena.arena);
+    for(usize cookerIndex = 0u; cookerIndex < 2u; ++cookerIndex){
+        manifestCookers.emplace_back(
+            testArena.arena,
+            cookerIndex == 0u ? AStringView("probe_fan_out_a") : AStringView("probe_fan_out_b"),
+            [&spans, cookerIndex](
+                ManifestPack& manifest,
+                NWB::Core::Assets::CookEntryPathHashSet& seenVirtualPathHashes,
+                const ManifestCookerWorkers& workers,
+                NWB::Core::Assets::ScratchArena&
+            ){
+                // The span opens when the first item runs, not when parallelFor is called, so time spent waiting for
+                // the pool does not count as overlap.
+                FanOutSpan& span = spans[cookerIndex];
+                Atomic<usize> startedItems{ 0u };
+                workers.parallelFor(static_cast<usize>(0u), s_ManifestProbeFanOutItems, static_cast<usize>(1u), [&](const usize){
+                    if(startedItems.fetch_add(1u, MemoryOrder::relaxed) == 0u)
+                        span.begin = TimerNow();
+                    SleepMS(s_ManifestProbeDelayMS);
+                });
+                span.end = TimerNow();
+
+                const Name virtualPath = cookerIndex == 0u ? Name("project/probe/fan_out_a") : Name("project/probe/fan_out_b");
+                return AppendManifestProbeEntry(manifest, seenVirtualPathHashes, virtualPath);
+            }
+        );
+    }
+
+    ManifestPack manifest(testArena.arena);
+    ManifestStageTimingVector timings(testArena.arena);
+    EXPECT_TRUE(RunManifestProbeCookers(testArena, threadPool, manifestCookers, manifest, timings));
+    EXPECT_EQ(manifest.entries.size(), 2u);
+
+    // Serialized fan-outs could at best touch end to begin; concurrent ones share most of their span.
+    const Timer latestBegin = spans[0].begin < spans[1].begin ? spans[1].begin : spans[0].begin;
+    const Timer earliestEnd = spans[0].end < spans[1].end ? spans[0].end : spans[1].end;
+    EXPECT_GE(DurationInMS<f64>(earliestEnd, latestBegin), static_cast<f64>(s_ManifestProbeDelayMS) * 0.5);
+    EXPECT_EQ(logger.errorCount(), 0u);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -6,14 +6,19 @@
 #include <tests/common/test_context.h>
 #include <gtest/gtest.h>
 
+#include <core/crash/package_codec.h>
 #include <core/crash/package_internal.h>
 
 #include <global/filesystem/operations.h>
 #include <global/thread.h>
 
 #if defined(NWB_PLATFORM_LINUX) && !defined(NWB_PLATFORM_ANDROID)
+#include <arpa/inet.h>
 #include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
 #include <signal.h>
+#include <sys/socket.h>
 #include <sys/wait.h>
 #include <unistd.h>
 #endif
@@ -30,12 +35,17 @@ namespace __hidden_crash_tests{
 
 using TestArena = NWB::Tests::TestArena<struct CrashTestsTag>;
 using CrashTestPath = Path<NWB::Core::Alloc::GlobalArena>;
+using CrashTestBytes = Vector<u8, NWB::Core::Alloc::GlobalArena>;
+using CrashTestBytesVector = Vector<CrashTestBytes, NWB::Core::Alloc::GlobalArena>;
 using ::TextFileContains;
 using ::WaitForDirectory;
 namespace CrashNames = NWB::Core::Crash::PackageNames;
 
 inline constexpr Name s_InstallArena("tests/integration/crash/install");
 inline constexpr Name s_SignalChildInstallArena("tests/integration/crash/signal_child_install");
+inline constexpr Name s_UploadStandInArena("tests/integration/crash/upload_stand_in");
+inline constexpr u64 s_CrashLoopImageBase = 0x00007F0000000000ull;
+inline constexpr u64 s_CrashLoopImageStride = 0x10000ull;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -139,6 +149,303 @@ static void FillPackageRequest(
     CopyPathText(arena, request.spoolDirectory, spoolDirectory);
 }
 
+// One iteration of a crash loop: a new process with its own crash id and image base crashing at the same site.
+static void FillCrashLoopRequest(
+    NWB::Core::Alloc::GlobalArena& arena,
+    NWB::Core::Crash::Detail::CrashRequest& request,
+    const CrashTestPath& spoolDirectory,
+    const u32 processId,
+    const u64 iteration,
+    const u32 triggerLine
+){
+    char crashId[NWB::Core::Crash::Detail::s_MaxShortText] = {};
+    BuildCrashIdForProcess(crashId, processId, iteration);
+    FillPackageRequest(arena, request, spoolDirectory, AStringView(crashId));
+    request.processId = processId;
+
+    const u64 imageBase = s_CrashLoopImageBase + iteration * s_CrashLoopImageStride;
+    request.callstackFrameCount = 3u;
+    request.callstackFrames[0] = imageBase + 0x1234u;
+    request.callstackFrames[1] = imageBase + 0x2345u;
+    request.callstackFrames[2] = imageBase + 0x3456u;
+    request.instructionPointer = request.callstackFrames[0];
+    request.triggerLine = triggerLine;
+    CopyFixedBuffer(request.triggerCategory, AStringView("test"));
+    CopyFixedBuffer(request.triggerMessage, AStringView("crash loop"));
+    CopyFixedBuffer(request.triggerFile, AStringView("tests/integration/crash/crash_package_tests.cpp"));
+}
+
+[[nodiscard]] static usize CountPackageDirectories(const CrashTestPath& bucketDirectory){
+    ErrorCode error;
+    DirectoryIterator directory(bucketDirectory, error);
+    if(error)
+        return 0u;
+
+    usize count = 0u;
+    for(const auto& entry : directory){
+        ErrorCode entryError;
+        if(IsDirectory(entry.path(), entryError) && !entryError)
+            ++count;
+    }
+    return count;
+}
+
+[[nodiscard]] static bool EveryPackageDirectory(
+    const CrashTestPath& bucketDirectory,
+    const AStringView requiredFile,
+    const AStringView absentFile,
+    const AStringView uploadState
+){
+    ErrorCode error;
+    DirectoryIterator directory(bucketDirectory, error);
+    if(error)
+        return false;
+
+    for(const auto& entry : directory){
+        if(!PathIsRegularFile(entry.path() / requiredFile) || PathExists(entry.path() / absentFile))
+            return false;
+        if(!TextFileContains(entry.path() / CrashNames::s_UploadAttemptFileName, uploadState))
+            return false;
+    }
+    return true;
+}
+
+// Walks the batch framing the way the logger server does and hands back each compressed package.
+[[nodiscard]] static bool SplitUploadBatch(
+    NWB::Core::Alloc::GlobalArena& arena,
+    const CrashTestBytes& body,
+    CrashTestBytesVector& outPackages
+){
+    outPackages.clear();
+
+    usize cursor = 0u;
+    AStringView line;
+    if(!NextLfByteLine(body, cursor, line) || line != CrashNames::s_BatchHeaderLine)
+        return false;
+
+    constexpr AStringView prefix(CrashNames::s_BatchPackageHeaderPrefix);
+    while(cursor < body.size()){
+        u64 packageSize = 0u;
+        if(
+            !NextLfByteLine(body, cursor, line)
+            || line.size() <= prefix.size()
+            || AStringView(line.data(), prefix.size()) != prefix
+            || !ParseU64(AStringView(line.data() + prefix.size(), line.size() - prefix.size()), packageSize)
+            || packageSize > body.size() - cursor
+        )
+            return false;
+
+        outPackages.emplace_back(body.begin() + cursor, body.begin() + cursor + packageSize, arena);
+        cursor += static_cast<usize>(packageSize);
+
+        AStringView separator;
+        if(!NextLfByteLine(body, cursor, separator) || !separator.empty() || !NextLfByteLine(body, cursor, line))
+            return false;
+        if(line != CrashNames::s_ArchiveEntryEndLine)
+            return false;
+    }
+    return !outPackages.empty();
+}
+
+[[nodiscard]] static bool BytesContain(const CrashTestBytes& bytes, const AStringView needle){
+    return AStringView(reinterpret_cast<const char*>(bytes.data()), bytes.size()).find(needle) != AStringView::npos;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(NWB_PLATFORM_LINUX) && !defined(NWB_PLATFORM_ANDROID)
+// Loopback HTTP endpoint standing in for the logger server. It answers 503 to the first `failingRequestCount`
+// requests and 200 afterwards, one connection at a time, and keeps every request body it received. A batch carrying
+// a package whose archive contains the rejection marker is refused with 400 regardless.
+class CrashUploadStandInServer final : NoCopy{
+private:
+    static constexpr int s_PollMilliseconds = 20;
+    static constexpr int s_ReceiveTimeoutMilliseconds = 2000;
+    static constexpr usize s_ReceiveChunkBytes = 64u * 1024u;
+    static constexpr AStringView s_ContentLengthHeader = "\r\nContent-Length:";
+    static constexpr AStringView s_ExpectContinueHeader = "\r\nExpect: 100-continue";
+    static constexpr AStringView s_HeaderEnd = "\r\n\r\n";
+    static constexpr AStringView s_ContinueResponse = "HTTP/1.1 100 Continue\r\n\r\n";
+    static constexpr AStringView s_SuccessResponse = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    static constexpr AStringView s_RejectedResponse =
+        "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"
+    ;
+    static constexpr AStringView s_UnavailableResponse =
+        "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"
+    ;
+
+
+public:
+    explicit CrashUploadStandInServer(const usize failingRequestCount)
+        : m_arena(s_UploadStandInArena)
+        , m_bodies(m_arena)
+        , m_failingRequestCount(failingRequestCount)
+    {}
+    ~CrashUploadStandInServer(){
+        m_stop.store(true, MemoryOrder::release);
+        if(m_thread.joinable())
+            m_thread.join();
+        if(m_listenSocket >= 0)
+            close(m_listenSocket);
+    }
+
+
+public:
+    void rejectPackagesContaining(const AStringView marker){
+        CopyFixedBuffer(m_rejectionMarker, marker);
+    }
+
+    [[nodiscard]] bool start(){
+        m_listenSocket = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if(m_listenSocket < 0)
+            return false;
+
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addressSize = sizeof(address);
+        if(
+            bind(m_listenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+            || listen(m_listenSocket, SOMAXCONN) != 0
+            || getsockname(m_listenSocket, reinterpret_cast<sockaddr*>(&address), &addressSize) != 0
+        )
+            return false;
+
+        m_port = ntohs(address.sin_port);
+        m_thread = Thread([this](){ serve(); });
+        return true;
+    }
+
+    template<usize N>
+    void copyUrl(char (&outUrl)[N])const{
+        CopyFixedBuffer(outUrl, AStringView("http://127.0.0.1:"));
+        AppendUnsignedToFixedBuffer(outUrl, static_cast<u64>(m_port));
+    }
+
+    [[nodiscard]] usize requestCount(){
+        ScopedLock lock(m_mutex);
+        return m_bodies.size();
+    }
+
+    [[nodiscard]] CrashTestBytes body(NWB::Core::Alloc::GlobalArena& arena, const usize index){
+        ScopedLock lock(m_mutex);
+        CrashTestBytes copy(arena);
+        if(index < m_bodies.size())
+            copy.assign(m_bodies[index].begin(), m_bodies[index].end());
+        return copy;
+    }
+
+
+private:
+    void serve(){
+        while(!m_stop.load(MemoryOrder::acquire)){
+            pollfd listenPoll = { m_listenSocket, POLLIN, 0 };
+            if(poll(&listenPoll, 1, s_PollMilliseconds) <= 0)
+                continue;
+
+            const int client = accept4(m_listenSocket, nullptr, nullptr, SOCK_CLOEXEC);
+            if(client < 0)
+                continue;
+            handleClient(client);
+            close(client);
+        }
+    }
+
+    [[nodiscard]] static bool receiveMore(const int client, CrashTestBytes& inOutBytes){
+        pollfd clientPoll = { client, POLLIN, 0 };
+        if(poll(&clientPoll, 1, s_ReceiveTimeoutMilliseconds) <= 0)
+            return false;
+
+        const usize offset = inOutBytes.size();
+        inOutBytes.resize(offset + s_ReceiveChunkBytes);
+        const ssize_t received = recv(client, inOutBytes.data() + offset, s_ReceiveChunkBytes, 0);
+        inOutBytes.resize(offset + (received > 0 ? static_cast<usize>(received) : 0u));
+        return received > 0;
+    }
+
+    static void sendAll(const int client, const AStringView text){
+        usize sent = 0u;
+        while(sent < text.size()){
+            const ssize_t written = send(client, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+            if(written <= 0)
+                return;
+            sent += static_cast<usize>(written);
+        }
+    }
+
+    void handleClient(const int client){
+        CrashTestBytes request(m_arena);
+        usize headerEnd = AStringView::npos;
+        while(headerEnd == AStringView::npos){
+            if(!receiveMore(client, request))
+                return;
+            headerEnd = AStringView(reinterpret_cast<const char*>(request.data()), request.size()).find(s_HeaderEnd);
+        }
+        headerEnd += s_HeaderEnd.size();
+
+        const AStringView headers(reinterpret_cast<const char*>(request.data()), headerEnd);
+        const usize lengthBegin = headers.find(s_ContentLengthHeader);
+        if(lengthBegin == AStringView::npos)
+            return;
+        const usize valueBegin = headers.find_first_not_of(' ', lengthBegin + s_ContentLengthHeader.size());
+        const usize valueEnd = headers.find('\r', valueBegin);
+        u64 contentLength = 0u;
+        if(valueBegin == AStringView::npos || !ParseU64(headers.substr(valueBegin, valueEnd - valueBegin), contentLength))
+            return;
+        if(headers.find(s_ExpectContinueHeader) != AStringView::npos)
+            sendAll(client, s_ContinueResponse);
+
+        while(request.size() < headerEnd + contentLength){
+            if(!receiveMore(client, request))
+                return;
+        }
+
+        CrashTestBytes body(request.begin() + headerEnd, request.begin() + headerEnd + contentLength, m_arena);
+        const bool reject = carriesRejectedPackage(body);
+        bool fail = false;
+        {
+            ScopedLock lock(m_mutex);
+            fail = m_bodies.size() < m_failingRequestCount;
+            m_bodies.push_back(Move(body));
+        }
+        sendAll(client, fail ? s_UnavailableResponse : reject ? s_RejectedResponse : s_SuccessResponse);
+    }
+
+    [[nodiscard]] bool carriesRejectedPackage(const CrashTestBytes& body){
+        const AStringView marker(m_rejectionMarker);
+        if(marker.empty())
+            return false;
+
+        CrashTestBytesVector packages(m_arena);
+        if(!SplitUploadBatch(m_arena, body, packages))
+            return false;
+        for(const CrashTestBytes& package : packages){
+            CrashTestBytes archive(m_arena);
+            if(
+                NWB::Core::Crash::PackageCodec::DecompressArchive(m_arena, package.data(), package.size(), Limit<usize>::s_Max, archive)
+                && BytesContain(archive, marker)
+            )
+                return true;
+        }
+        return false;
+    }
+
+
+private:
+    NWB::Core::Alloc::GlobalArena m_arena;
+    Futex m_mutex;
+    CrashTestBytesVector m_bodies;
+    usize m_failingRequestCount = 0u;
+    char m_rejectionMarker[NWB::Core::Crash::Detail::s_MaxShortText] = {};
+    Atomic<bool> m_stop = false;
+    Thread m_thread;
+    int m_listenSocket = -1;
+    u16 m_port = 0u;
+};
+#endif
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -358,6 +665,211 @@ TEST(Crash, FlushReportsFailsWhenUploadingRecoveryIsBlocked){
     RemoveTestArtifacts(arena, s_Group);
 }
 
+TEST(Crash, CrashLoopFoldsRepeatSignatureIntoOneSpoolEntry){
+    TestArena testArena;
+    auto& arena = testArena.arena;
+    constexpr AStringView s_Group("crash_loop_fold_test");
+    constexpr u32 s_FirstProcessId = 1000u;
+    constexpr u64 s_Iterations = 25u;
+    RemoveTestArtifacts(arena, s_Group);
+
+    const CrashTestPath spoolDirectory = SpoolDirectory(arena, s_Group);
+    NWB::Core::Crash::Detail::CrashRequest request;
+    for(u64 iteration = 0u; iteration < s_Iterations; ++iteration){
+        FillCrashLoopRequest(arena, request, spoolDirectory, s_FirstProcessId + static_cast<u32>(iteration), iteration, 42u);
+        EXPECT_TRUE(NWB::Core::Crash::Detail::WriteCrashPackage(request));
+    }
+
+    char firstCrashId[NWB::Core::Crash::Detail::s_MaxShortText] = {};
+    BuildCrashIdForProcess(firstCrashId, s_FirstProcessId, 0u);
+    char lastCrashId[NWB::Core::Crash::Detail::s_MaxShortText] = {};
+    BuildCrashIdForProcess(lastCrashId, s_FirstProcessId + static_cast<u32>(s_Iterations - 1u), s_Iterations - 1u);
+
+    const CrashTestPath pendingDirectory = BucketDirectory(arena, s_Group, CrashNames::s_PendingDirectoryName);
+    const CrashTestPath packageDirectory = pendingDirectory / AStringView(firstCrashId);
+    EXPECT_EQ(CountPackageDirectories(pendingDirectory), 1u);
+    EXPECT_TRUE(PathIsRegularFile(packageDirectory / CrashNames::s_ManifestFileName));
+    EXPECT_TRUE(PathIsRegularFile(packageDirectory / CrashNames::s_SignatureFileName));
+    const CrashTestPath occurrencesPath = packageDirectory / CrashNames::s_OccurrencesFileName;
+    EXPECT_TRUE(TextFileContains(occurrencesPath, AStringView("count=25\n")));
+    EXPECT_TRUE(TextFileContains(occurrencesPath, AStringView(firstCrashId)));
+    EXPECT_TRUE(TextFileContains(occurrencesPath, AStringView(lastCrashId)));
+
+    FillCrashLoopRequest(arena, request, spoolDirectory, s_FirstProcessId + 100u, 100u, 43u);
+    EXPECT_TRUE(NWB::Core::Crash::Detail::WriteCrashPackage(request));
+    EXPECT_EQ(CountPackageDirectories(pendingDirectory), 2u);
+    EXPECT_TRUE(TextFileContains(occurrencesPath, AStringView("count=25\n")));
+
+    RemoveTestArtifacts(arena, s_Group);
+}
+
+#if defined(NWB_PLATFORM_LINUX) && !defined(NWB_PLATFORM_ANDROID)
+TEST(Crash, FlushDrainsCrashLoopSpoolInBatchesWithRetry){
+    TestArena testArena;
+    auto& arena = testArena.arena;
+    constexpr AStringView s_Group("crash_upload_batch_test");
+    constexpr u32 s_SignatureCount = 5u;
+    constexpr u64 s_RepeatsPerSignature = 3u;
+    RemoveTestArtifacts(arena, s_Group);
+
+    CrashUploadStandInServer server(1u);
+    ASSERT_TRUE(server.start());
+
+    const CrashTestPath spoolDirectory = SpoolDirectory(arena, s_Group);
+    NWB::Core::Crash::Detail::CrashRequest request;
+    u64 iteration = 0u;
+    for(u64 repeat = 0u; repeat < s_RepeatsPerSignature; ++repeat){
+        for(u32 signature = 0u; signature < s_SignatureCount; ++signature, ++iteration){
+            FillCrashLoopRequest(arena, request, spoolDirectory, 2000u + static_cast<u32>(iteration), iteration, 100u + signature);
+            EXPECT_TRUE(NWB::Core::Crash::Detail::WriteCrashPackage(request));
+        }
+    }
+    EXPECT_EQ(CountPackageDirectories(BucketDirectory(arena, s_Group, CrashNames::s_PendingDirectoryName)), s_SignatureCount);
+
+    NWB::Core::Crash::Detail::CrashUploadSnapshot snapshot;
+    CopyPathText(arena, snapshot.spoolDirectory, spoolDirectory);
+    server.copyUrl(snapshot.logServerUrl);
+    snapshot.uploadPolicy.maxBatchPackages = 2u;
+    snapshot.uploadPolicy.maxAttempts = 3u;
+    snapshot.uploadPolicy.initialBackoffMilliseconds = 1u;
+    snapshot.uploadPolicy.maxBackoffMilliseconds = 4u;
+    EXPECT_TRUE(NWB::Core::Crash::Detail::FlushPendingCrashReportsImpl(arena, snapshot));
+
+    // The first batch is refused once and resent unchanged; the rest of the spool follows in two more batches.
+    ASSERT_EQ(server.requestCount(), 4u);
+    const CrashTestBytes refusedBody = server.body(arena, 0u);
+    const CrashTestBytes retriedBody = server.body(arena, 1u);
+    EXPECT_TRUE(refusedBody == retriedBody);
+
+    usize uploadedPackageCount = 0u;
+    CrashTestBytesVector packages(arena);
+    for(usize requestIndex = 1u; requestIndex < server.requestCount(); ++requestIndex){
+        EXPECT_TRUE(SplitUploadBatch(arena, server.body(arena, requestIndex), packages));
+        EXPECT_LE(packages.size(), snapshot.uploadPolicy.maxBatchPackages);
+        uploadedPackageCount += packages.size();
+    }
+    EXPECT_EQ(uploadedPackageCount, s_SignatureCount);
+
+    EXPECT_TRUE(SplitUploadBatch(arena, retriedBody, packages));
+    ASSERT_FALSE(packages.empty());
+    CrashTestBytes archive(arena);
+    EXPECT_TRUE(NWB::Core::Crash::PackageCodec::DecompressArchive(
+        arena,
+        packages[0].data(),
+        packages[0].size(),
+        Limit<usize>::s_Max,
+        archive
+    ));
+    EXPECT_TRUE(BytesContain(archive, CrashNames::s_ArchiveHeaderText));
+    EXPECT_TRUE(BytesContain(archive, CrashNames::s_ManifestFileName));
+    EXPECT_TRUE(BytesContain(archive, AStringView("count=3\n")));
+    EXPECT_LT(packages[0].size(), archive.size());
+
+    const CrashTestPath uploadedDirectory = BucketDirectory(arena, s_Group, CrashNames::s_UploadedDirectoryName);
+    EXPECT_EQ(CountPackageDirectories(uploadedDirectory), s_SignatureCount);
+    EXPECT_EQ(CountPackageDirectories(BucketDirectory(arena, s_Group, CrashNames::s_PendingDirectoryName)), 0u);
+    EXPECT_TRUE(EveryPackageDirectory(
+        uploadedDirectory,
+        CrashNames::s_SealedArchiveFileName,
+        CrashNames::s_ManifestFileName,
+        CrashNames::s_UploadAttemptUploadedState
+    ));
+
+    RemoveTestArtifacts(arena, s_Group);
+}
+
+TEST(Crash, FlushStopsAfterBoundedUploadRetries){
+    TestArena testArena;
+    auto& arena = testArena.arena;
+    constexpr AStringView s_Group("crash_upload_bounded_retry_test");
+    RemoveTestArtifacts(arena, s_Group);
+
+    CrashUploadStandInServer server(Limit<usize>::s_Max);
+    ASSERT_TRUE(server.start());
+
+    const CrashTestPath spoolDirectory = SpoolDirectory(arena, s_Group);
+    NWB::Core::Crash::Detail::CrashRequest request;
+    FillCrashLoopRequest(arena, request, spoolDirectory, 3000u, 0u, 200u);
+    EXPECT_TRUE(NWB::Core::Crash::Detail::WriteCrashPackage(request));
+    FillCrashLoopRequest(arena, request, spoolDirectory, 3001u, 1u, 201u);
+    EXPECT_TRUE(NWB::Core::Crash::Detail::WriteCrashPackage(request));
+
+    NWB::Core::Crash::Detail::CrashUploadSnapshot snapshot;
+    CopyPathText(arena, snapshot.spoolDirectory, spoolDirectory);
+    server.copyUrl(snapshot.logServerUrl);
+    snapshot.uploadPolicy.maxBatchPackages = 1u;
+    snapshot.uploadPolicy.maxAttempts = 3u;
+    snapshot.uploadPolicy.initialBackoffMilliseconds = 1u;
+    snapshot.uploadPolicy.maxBackoffMilliseconds = 4u;
+    EXPECT_FALSE(NWB::Core::Crash::Detail::FlushPendingCrashReportsImpl(arena, snapshot));
+
+    // The first batch spends the whole retry budget and the flush gives up instead of trying the second one.
+    EXPECT_EQ(server.requestCount(), 3u);
+    const CrashTestPath pendingDirectory = BucketDirectory(arena, s_Group, CrashNames::s_PendingDirectoryName);
+    EXPECT_EQ(CountPackageDirectories(pendingDirectory), 2u);
+    EXPECT_EQ(CountPackageDirectories(BucketDirectory(arena, s_Group, CrashNames::s_UploadingDirectoryName)), 0u);
+
+    char firstCrashId[NWB::Core::Crash::Detail::s_MaxShortText] = {};
+    BuildCrashIdForProcess(firstCrashId, 3000u, 0u);
+    const CrashTestPath firstPackageDirectory = pendingDirectory / AStringView(firstCrashId);
+    EXPECT_TRUE(PathIsRegularFile(firstPackageDirectory / CrashNames::s_SealedArchiveFileName));
+    EXPECT_TRUE(PathIsMissing(firstPackageDirectory / CrashNames::s_ManifestFileName));
+    EXPECT_TRUE(TextFileContains(
+        firstPackageDirectory / CrashNames::s_UploadAttemptFileName,
+        AStringView(CrashNames::s_UploadAttemptRetryPendingState)
+    ));
+
+    RemoveTestArtifacts(arena, s_Group);
+}
+
+TEST(Crash, FlushIsolatesPackageRejectedByServer){
+    TestArena testArena;
+    auto& arena = testArena.arena;
+    constexpr AStringView s_Group("crash_upload_rejected_package_test");
+    constexpr u32 s_PackageCount = 3u;
+    RemoveTestArtifacts(arena, s_Group);
+
+    char rejectedCrashId[NWB::Core::Crash::Detail::s_MaxShortText] = {};
+    BuildCrashIdForProcess(rejectedCrashId, 4001u, 1u);
+    CrashUploadStandInServer server(0u);
+    server.rejectPackagesContaining(AStringView(rejectedCrashId));
+    ASSERT_TRUE(server.start());
+
+    const CrashTestPath spoolDirectory = SpoolDirectory(arena, s_Group);
+    NWB::Core::Crash::Detail::CrashRequest request;
+    for(u32 i = 0u; i < s_PackageCount; ++i){
+        FillCrashLoopRequest(arena, request, spoolDirectory, 4000u + i, i, 300u + i);
+        EXPECT_TRUE(NWB::Core::Crash::Detail::WriteCrashPackage(request));
+    }
+
+    NWB::Core::Crash::Detail::CrashUploadSnapshot snapshot;
+    CopyPathText(arena, snapshot.spoolDirectory, spoolDirectory);
+    server.copyUrl(snapshot.logServerUrl);
+    snapshot.uploadPolicy.maxBatchPackages = s_PackageCount;
+    snapshot.uploadPolicy.maxAttempts = 3u;
+    snapshot.uploadPolicy.initialBackoffMilliseconds = 1u;
+    snapshot.uploadPolicy.maxBackoffMilliseconds = 4u;
+    EXPECT_FALSE(NWB::Core::Crash::Detail::FlushPendingCrashReportsImpl(arena, snapshot));
+
+    // The refused batch is resent one package at a time: its batch-mates get through and only the refused package
+    // is parked in failed, so it cannot hold the others back on later flushes.
+    EXPECT_EQ(server.requestCount(), 1u + s_PackageCount);
+    EXPECT_EQ(CountPackageDirectories(BucketDirectory(arena, s_Group, CrashNames::s_UploadedDirectoryName)), s_PackageCount - 1u);
+    EXPECT_EQ(CountPackageDirectories(BucketDirectory(arena, s_Group, CrashNames::s_PendingDirectoryName)), 0u);
+    const CrashTestPath failedDirectory = BucketDirectory(arena, s_Group, CrashNames::s_FailedDirectoryName);
+    EXPECT_EQ(CountPackageDirectories(failedDirectory), 1u);
+    EXPECT_TRUE(TextFileContains(
+        failedDirectory / AStringView(rejectedCrashId) / CrashNames::s_UploadAttemptFileName,
+        AStringView(CrashNames::s_UploadAttemptRejectedState)
+    ));
+
+    EXPECT_TRUE(NWB::Core::Crash::Detail::FlushPendingCrashReportsImpl(arena, snapshot));
+    EXPECT_EQ(server.requestCount(), 1u + s_PackageCount);
+
+    RemoveTestArtifacts(arena, s_Group);
+}
+#endif
+
 #if defined(NWB_PLATFORM_WINDOWS) || (defined(NWB_PLATFORM_LINUX) && !defined(NWB_PLATFORM_ANDROID))
 TEST(Crash, DesktopInstalledHandlerWritesManualDumpPackage){
     TestArena testArena;
@@ -0,0 +1,134 @@
+include("${CMAKE_CURRENT_LIST_DIR}/fbx_to_nwb_test_helpers.cmake")
+
+set(grid_mesh_count 4)
+set(grid_quads 48)
+set(grid_mesh_step 16)
+
+# Overlapping height-field grids: neighbouring meshes share positions, so the merged streams depend on the order the
+# per-mesh results are interned in.
+function(write_grid_fbx input_path output_path)
+    read_normalized_fbx("${input_path}" source_fbx)
+    string(FIND "${source_fbx}" "Objects:  {" objects_begin)
+    if(objects_begin EQUAL -1)
+        message(FATAL_ERROR "Missing Objects block in ${input_path}")
+    endif()
+    string(SUBSTRING "${source_fbx}" 0 ${objects_begin} header)
+    string(REPLACE "ObjectType: \"Geometry\" { Count: 1 }" "ObjectType: \"Geometry\" { Count: ${grid_mesh_count} }" header "${header}")
+    string(REPLACE "ObjectType: \"Model\" { Count: 1 }" "ObjectType: \"Model\" { Count: ${grid_mesh_count} }" header "${header}")
+    math(EXPR definition_count "${grid_mesh_count} * 2 + 1")
+    string(REPLACE "Count: 3" "Count: ${definition_count}" header "${header}")
+
+    math(EXPR grid_vertices "${grid_quads} + 1")
+    math(EXPR vertex_count "${grid_vertices} * ${grid_vertices}")
+    math(EXPR position_value_count "${vertex_count} * 3")
+    math(EXPR uv_value_count "${vertex_count} * 2")
+    math(EXPR index_count "${grid_quads} * ${grid_quads} * 4")
+    math(EXPR last_mesh "${grid_mesh_count} - 1")
+    math(EXPR last_vertex "${grid_vertices} - 1")
+    math(EXPR last_quad "${grid_quads} - 1")
+
+    set(objects "Objects:  {\n")
+    set(connections "Connections:  {\n")
+    foreach(mesh RANGE ${last_mesh})
+        math(EXPR geometry_id "${mesh} * 2 + 1")
+        math(EXPR model_id "${mesh} * 2 + 2")
+        math(EXPR mesh_offset "${mesh} * ${grid_mesh_step}")
+
+        set(positions "")
+        set(uvs "")
+        foreach(row RANGE ${last_vertex})
+            foreach(column RANGE ${last_vertex})
+                math(EXPR world_column "${column} + ${mesh_offset}")
+                math(EXPR height "(${world_column} * ${row}) % 5")
+                string(APPEND positions "${column},${row},${height},")
+                string(APPEND uvs "${world_column},${row},")
+            endforeach()
+        endforeach()
+        string(REGEX REPLACE ",$" "" positions "${positions}")
+        string(REGEX REPLACE ",$" "" uvs "${uvs}")
+
+        set(indices "")
+        foreach(row RANGE ${last_quad})
+            foreach(column RANGE ${last_quad})
+                math(EXPR v0 "${row} * ${grid_vertices} + ${column}")
+                math(EXPR v1 "${v0} + 1")
+                math(EXPR v2 "${v1} + ${grid_vertices}")
+                math(EXPR v3_end "-(${v0} + ${grid_vertices}) - 1")
+                string(APPEND indices "${v0},${v1},${v2},${v3_end},")
+            endforeach()
+        endforeach()
+        string(REGEX REPLACE ",$" "" indices "${indices}")
+
+        string(APPEND objects
+            "    Geometry: ${geometry_id}, \"Geometry::Grid${mesh}\", \"Mesh\" {\n"
+            "        Vertices: *${position_value_count} {\n            a: ${positions}\n        }\n"
+            "        PolygonVertexIndex: *${index_count} {\n            a: ${indices}\n        }\n"
+            "        LayerElementUV: 0 {\n"
+            "            Version: 101\n"
+            "            Name: \"UVChannel_1\"\n"
+            "            MappingInformationType: \"ByVertice\"\n"
+            "            ReferenceInformationType: \"Direct\"\n"
+            "            UV: *${uv_value_count} {\n                a: ${uvs}\n            }\n"
+            "        }\n"
+            "        Layer: 0 {\n"
+            "            Version: 100\n"
+            "            LayerElement:  {\n                Type: \"LayerElementUV\"\n                TypedIndex: 0\n            }\n"
+            "        }\n"
+            "    }\n"
+            "    Model: ${model_id}, \"Model::Grid${mesh}\", \"Mesh\" {\n"
+            "        Version: 232\n"
+            "        Properties70:  {\n"
+            "            P: \"Lcl Translation\", \"Lcl Translation\", \"\", \"A\",${mesh_offset},0,0\n"
+            "        }\n"
+            "        Shading: T\n"
+            "        Culling: \"CullingOff\"\n"
+            "    }\n"
+        )
+        string(APPEND connections "    C: \"OO\",${geometry_id},${model_id}\n    C: \"OO\",${model_id},0\n")
+    endforeach()
+    string(APPEND objects "}\n")
+    string(APPEND connections "}\n")
+
+    file(WRITE "${output_path}" "${header}${objects}${connections}")
+endfunction()
+
+function(run_grid_converter input_path output_path)
+    execute_process(
+        COMMAND
+            "${FBX_TO_NWB_EXE}"
+            "${input_path}"
+            --output "${output_path}"
+            --asset-type mesh
+            --mesh all
+            --normal-mode smooth
+            --preserve-space
+            --yes
+            --force
+            ${ARGN}
+        RESULT_VARIABLE result
+        OUTPUT_VARIABLE stdout
+        ERROR_VARIABLE stderr
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "fbx_to_nwb ${ARGN} failed:\n${stdout}\n${stderr}")
+    endif()
+endfunction()
+
+# Both runs write the same file name so names derived from the output path match.
+file(MAKE_DIRECTORY "${OUTPUT_DIR}/parallel" "${OUTPUT_DIR}/serial")
+set(grid_input "${OUTPUT_DIR}/grid_meshes.fbx")
+set(parallel_output "${OUTPUT_DIR}/parallel/grid_meshes.nwb")
+set(serial_output "${OUTPUT_DIR}/serial/grid_meshes.nwb")
+
+write_grid_fbx("${INPUT_FBX}" "${grid_input}")
+run_grid_converter("${grid_input}" "${parallel_output}")
+run_grid_converter("${grid_input}" "${serial_output}" --single-thread)
+
+file(READ "${parallel_output}" parallel_text)
+require_import_output("${parallel_text}" "parallel grid")
+
+file(SHA256 "${parallel_output}" parallel_hash)
+file(SHA256 "${serial_output}" serial_hash)
+if(NOT parallel_hash STREQUAL serial_hash)
+    message(FATAL_ERROR "parallel import differed from --single-thread import:\n${parallel_output}\n${serial_output}")
+endif()
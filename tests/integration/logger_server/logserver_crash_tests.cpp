@@ -10,6 +10,7 @@
 #include <gtest/gtest.h>
 
 #include <core/crash/module.h>
+#include <core/crash/package_codec.h>
 #include <core/crash/package_names.h>
 #include <core/common/log.h>
 #include <global/assert.h>
@@ -202,6 +203,26 @@ NWB_LOGSERVER_TEST_NOINLINE static void CaptureRecoverableErrorForCrashObservati
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+static void AppendCompressedBatchEntry(NWB::Core::Alloc::GlobalArena& arena, CrashTestBytes& batch, const CrashTestText& archive){
+    CrashTestBytes compressed(arena);
+    EXPECT_TRUE(NWB::Core::Crash::PackageCodec::CompressArchive(
+        arena,
+        reinterpret_cast<const u8*>(archive.data()),
+        archive.size(),
+        compressed
+    ));
+
+    char header[64] = {};
+    CopyFixedBuffer(header, CrashNames::s_BatchPackageHeaderPrefix);
+    AppendUnsignedToFixedBuffer(header, compressed.size());
+    AppendFixedBuffer(header, "\n");
+    const AStringView headerText(header);
+    batch.insert(batch.end(), headerText.begin(), headerText.end());
+    batch.insert(batch.end(), compressed.begin(), compressed.end());
+    const AStringView footer(CrashNames::s_ArchiveEntryEndText);
+    batch.insert(batch.end(), footer.begin(), footer.end());
+}
+
 static NWB::Log::CrashIngestResult ProcessCrashArchive(
     NWB::Core::Alloc::GlobalArena& arena,
     const AStringView testGroup,
@@ -823,6 +844,78 @@ TEST(LoggerServerCrash, CrashManifestWithoutEventIsRejected){
     RemoveTestArtifacts(arena, s_Group);
 }
 
+TEST(LoggerServerCrash, CompressedCrashBatchIngestsEachPackage){
+    TestArena testArena;
+    auto& arena = testArena.arena;
+    constexpr AStringView s_Group("logger_server_crash_batch_test");
+    constexpr AStringView s_Stem("crash_batch_001");
+    RemoveTestArtifacts(arena, s_Group);
+
+    CrashTestText firstArchive(arena);
+    BeginArchiveWithManifest(arena, firstArchive, "crash-batch-first", "linux", "crash", "signal", 11u);
+    AppendArchiveFile(firstArchive, CrashNames::s_OccurrencesFileName, "count=7\nfirst_crash_id=crash-batch-first\n");
+    CrashTestText secondArchive(arena);
+    BeginArchiveWithManifest(arena, secondArchive, "crash-batch-second", "linux", "crash", "signal", 6u);
+
+    CrashTestBytes batch(arena);
+    const AStringView batchHeader(CrashNames::s_BatchHeaderText);
+    batch.insert(batch.end(), batchHeader.begin(), batchHeader.end());
+    AppendCompressedBatchEntry(arena, batch, firstArchive);
+    AppendCompressedBatchEntry(arena, batch, secondArchive);
+    EXPECT_TRUE(WriteArchiveBytes(arena, s_Group, s_Stem, batch));
+
+    const NWB::Log::CrashIngestResultVector results = NWB::Log::ProcessCrashUploadBatch(
+        arena,
+        ArchivePath(arena, s_Group, s_Stem),
+        MakeIngestConfig(arena, s_Group)
+    );
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_TRUE(results[0].accepted);
+    EXPECT_TRUE(results[1].accepted);
+    EXPECT_TRUE(PathIsMissing(ArchivePath(arena, s_Group, s_Stem)));
+    EXPECT_TRUE(PathIsRegularFile(RawArchivePath(arena, s_Group, "crash_batch_001_0")));
+    EXPECT_TRUE(PathIsRegularFile(RawArchivePath(arena, s_Group, "crash_batch_001_1")));
+
+    CrashTestText report(arena);
+    EXPECT_TRUE(ReadServerSymbolication(arena, s_Group, "crash_batch_001_0", report));
+    EXPECT_TRUE(Contains(report, "[occurrences]"));
+    EXPECT_TRUE(Contains(report, "count=7"));
+
+    RemoveTestArtifacts(arena, s_Group);
+}
+
+TEST(LoggerServerCrash, TruncatedCrashBatchIsRejected){
+    TestArena testArena;
+    auto& arena = testArena.arena;
+    constexpr AStringView s_Group("logger_server_truncated_crash_batch_test");
+    constexpr AStringView s_Stem("truncated_batch_001");
+    RemoveTestArtifacts(arena, s_Group);
+
+    CrashTestText archive(arena);
+    BeginArchiveWithManifest(arena, archive, "crash-batch-truncated", "linux", "crash", "signal", 11u);
+
+    CrashTestBytes batch(arena);
+    const AStringView batchHeader(CrashNames::s_BatchHeaderText);
+    batch.insert(batch.end(), batchHeader.begin(), batchHeader.end());
+    AppendCompressedBatchEntry(arena, batch, archive);
+    AppendCompressedBatchEntry(arena, batch, archive);
+    batch.resize(batch.size() - 16u);
+    EXPECT_TRUE(WriteArchiveBytes(arena, s_Group, s_Stem, batch));
+
+    const NWB::Log::CrashIngestResultVector results = NWB::Log::ProcessCrashUploadBatch(
+        arena,
+        ArchivePath(arena, s_Group, s_Stem),
+        MakeIngestConfig(arena, s_Group)
+    );
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_FALSE(results[0].accepted);
+    EXPECT_TRUE(ContainsMessage(results[0].message, NWB_TEXT("truncated crash batch package payload")));
+    EXPECT_TRUE(PathIsRegularFile(InvalidArchivePath(arena, s_Group, s_Stem)));
+    EXPECT_TRUE(PathIsMissing(RawArchivePath(arena, s_Group, "truncated_batch_001_0")));
+
+    RemoveTestArtifacts(arena, s_Group);
+}
+
 TEST(LoggerServerCrash, CrashRetentionPrunesOldestAcceptedUploads){
     TestArena testArena;
     auto& arena = testArena.arena;
@@ -217,6 +217,8 @@ private:
             const SIMDMatrix animatedJoint = BuildWaveJointMatrix(LoadFloat(m_bindJoints[jointIndex]), jointIndex, timeSeconds);
             StoreFloat(animatedJoint, &pose->localJoints[jointIndex]);
         }
+        ++pose->revision;
+        m_world->entity(m_skeletonEntity).markChanged<NWB::Impl::SkeletonPoseComponent>();
     }
 
 
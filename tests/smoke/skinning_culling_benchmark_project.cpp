@@ -508,6 +508,8 @@ private:
                 );
                 StoreFloat(animatedJoint, &pose->localJoints[jointIndex]);
             }
+            ++pose->revision;
+            m_world->entity(m_entities[entityIndex]).markChanged<NWB::Impl::SkeletonPoseComponent>();
         }
     }
 
@@ -15,6 +15,8 @@
 #include <impl/ecs_mesh/skinning/module.h>
 #include <impl/ecs_model/module.h>
 #include <impl/ecs_model_renderer/model_renderer.h>
+#include <impl/ecs_scene/module.h>
+#include <impl/ecs_skeleton/module.h>
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -41,6 +43,8 @@ inline void AddSmokeSkinnedRenderSystems(
         context.assetManager,
         Impl::CreateModelObjectRendererHooks()
     );
+    world.addSystem<Impl::Scene::TransformHierarchySystem>(world);
+    world.addSystem<Impl::SkeletonPaletteSystem>(world);
     auto& meshSkinningSystem = world.addSystem<Impl::MeshSkinningSystem>(
         world,
         context.graphics,
@@ -0,0 +1,304 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <tests/common/test_context.h>
+#include <gtest/gtest.h>
+
+#include <core/alloc/job.h>
+#include <core/alloc/thread.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_alloc_tests{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+using JobSystem = NWB::Core::Alloc::JobSystem;
+using JobHandle = JobSystem::JobHandle;
+using ThreadPool = NWB::Core::Alloc::ThreadPool;
+
+template<typename T>
+using Vector = NWB::Tests::TestVector<T>;
+
+
+static constexpr u32 s_StressGraphCount = 4u;
+static constexpr u32 s_StressJobsPerGraph = 2048u;
+static constexpr u32 s_StressMaxDependencies = 4u;
+static constexpr u32 s_StressRounds = 3u;
+static constexpr u32 s_NotRun = 0u;
+// Submission can run far ahead of completion, so the pool queue and the job nodes need room for every job at once.
+static constexpr usize s_StressArenaBytes = 32u << 20u;
+// Small enough that a handful of wide joins spends every dependency link the arena can hold.
+static constexpr usize s_ExhaustionArenaBytes = 256u << 10u;
+static constexpr u32 s_ExhaustionDependencies = 64u;
+static constexpr u32 s_ExhaustionMaxJoins = 4096u;
+
+
+[[nodiscard]] static u32 NextRandom(u32& state){
+    state = state * 1664525u + 1013904223u;
+    return state >> 8u;
+}
+
+// One random DAG: every job depends on up to four earlier jobs of the same graph and records the global order in which
+// it ran, so the checks below can see whether a job ever ran before one of its dependencies.
+struct StressGraph{
+    Vector<u32> dependencies;
+    Vector<u32> dependencyCounts;
+    Vector<JobHandle> handles;
+    Vector<Atomic<u32>> runOrder;
+    Vector<Atomic<u32>> runCount;
+
+    void build(const u32 seed){
+        u32 state = seed;
+        dependencies.resize(static_cast<usize>(s_StressJobsPerGraph) * s_StressMaxDependencies);
+        dependencyCounts.resize(s_StressJobsPerGraph);
+        handles.resize(s_StressJobsPerGraph);
+        runOrder = Vector<Atomic<u32>>(s_StressJobsPerGraph);
+        runCount = Vector<Atomic<u32>>(s_StressJobsPerGraph);
+
+        for(u32 job = 0u; job < s_StressJobsPerGraph; ++job){
+            const u32 count = job == 0u ? 0u : NextRandom(state) % (s_StressMaxDependencies + 1u);
+            dependencyCounts[job] = count;
+            for(u32 i = 0u; i < count; ++i){
+                // Mostly near neighbours for long chains, sometimes anywhere earlier for wide fan-in.
+                const u32 distance = (NextRandom(state) & 3u) != 0u
+                    ? 1u + NextRandom(state) % 8u
+                    : 1u + NextRandom(state) % job
+                ;
+                dependencies[static_cast<usize>(job) * s_StressMaxDependencies + i] = job > distance ? job - distance : 0u;
+            }
+        }
+    }
+
+    void submit(JobSystem& jobSystem, Atomic<u32>& clock){
+        for(u32 job = 0u; job < s_StressJobsPerGraph; ++job){
+            JobHandle dependencyHandles[s_StressMaxDependencies];
+            for(u32 i = 0u; i < dependencyCounts[job]; ++i)
+                dependencyHandles[i] = handles[dependencies[static_cast<usize>(job) * s_StressMaxDependencies + i]];
+
+            handles[job] = jobSystem.submit(
+                [this, job, &clock](){
+                    runOrder[job].store(clock.fetch_add(1u, MemoryOrder::acq_rel) + 1u, MemoryOrder::release);
+                    runCount[job].fetch_add(1u, MemoryOrder::relaxed);
+                },
+                dependencyHandles,
+                dependencyCounts[job]
+            );
+        }
+    }
+
+    [[nodiscard]] bool ranInOrder()const{
+        for(u32 job = 0u; job < s_StressJobsPerGraph; ++job){
+            const u32 order = runOrder[job].load(MemoryOrder::acquire);
+            if(order == s_NotRun || runCount[job].load(MemoryOrder::relaxed) != 1u)
+                return false;
+            for(u32 i = 0u; i < dependencyCounts[job]; ++i){
+                const u32 dependency = dependencies[static_cast<usize>(job) * s_StressMaxDependencies + i];
+                if(runOrder[dependency].load(MemoryOrder::acquire) >= order)
+                    return false;
+            }
+        }
+        return true;
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TEST(Alloc, JobSystemRunsDependenciesBeforeDependents){
+    JobSystem jobSystem(3u, CpuAffinity::Any);
+
+    Atomic<u32> stage{ 0u };
+    Atomic<u32> violations{ 0u };
+    const JobHandle first = jobSystem.submit([&stage](){ stage.store(1u, MemoryOrder::release); });
+    const JobHandle second = jobSystem.submit([&stage](){ stage.store(2u, MemoryOrder::release); });
+    const JobHandle joined = jobSystem.submit(
+        [&stage, &violations](){
+            if(stage.load(MemoryOrder::acquire) == 0u)
+                violations.fetch_add(1u, MemoryOrder::relaxed);
+            stage.store(3u, MemoryOrder::release);
+        },
+        { first, second }
+    );
+    const JobHandle chained = jobSystem.then(joined, [&stage, &violations](){
+        if(stage.load(MemoryOrder::acquire) != 3u)
+            violations.fetch_add(1u, MemoryOrder::relaxed);
+    });
+
+    jobSystem.wait(chained);
+    EXPECT_TRUE(jobSystem.isComplete(first));
+    EXPECT_TRUE(jobSystem.isComplete(second));
+    EXPECT_TRUE(jobSystem.isComplete(joined));
+    EXPECT_TRUE(jobSystem.isComplete(chained));
+    EXPECT_EQ(violations.load(MemoryOrder::relaxed), 0u);
+
+    // Completed handles stay complete after their nodes are reused, and invalid handles never block.
+    Atomic<u32> lateRuns{ 0u };
+    const JobHandle late = jobSystem.submit(
+        [&lateRuns](){ lateRuns.fetch_add(1u, MemoryOrder::relaxed); },
+        { chained, JobHandle{} }
+    );
+    jobSystem.wait(late);
+    jobSystem.wait(chained);
+    jobSystem.wait(JobHandle{});
+    EXPECT_TRUE(jobSystem.isComplete(JobHandle{}));
+    EXPECT_EQ(lateRuns.load(MemoryOrder::relaxed), 1u);
+}
+
+TEST(Alloc, JobSystemRunsInlineWithoutWorkers){
+    JobSystem jobSystem(0u, CpuAffinity::Any);
+
+    u32 order[3] = {};
+    u32 next = 0u;
+    const JobHandle first = jobSystem.submit([&order, &next](){ order[next++] = 1u; });
+    const JobHandle second = jobSystem.then(first, [&order, &next](){ order[next++] = 2u; });
+    const JobHandle third = jobSystem.then(second, [&order, &next](){ order[next++] = 3u; });
+    jobSystem.waitAll();
+
+    EXPECT_TRUE(jobSystem.isComplete(third));
+    EXPECT_EQ(next, 3u);
+    EXPECT_EQ(order[0], 1u);
+    EXPECT_EQ(order[1], 2u);
+    EXPECT_EQ(order[2], 3u);
+}
+
+TEST(Alloc, JobSystemRandomGraphStress){
+    JobSystem jobSystem(4u, CpuAffinity::Any, s_StressArenaBytes);
+    ThreadPool submitters(s_StressGraphCount - 1u, CpuAffinity::Any);
+
+    for(u32 round = 0u; round < s_StressRounds; ++round){
+        StressGraph graphs[s_StressGraphCount];
+        for(u32 graph = 0u; graph < s_StressGraphCount; ++graph)
+            graphs[graph].build(0x9E3779B9u * (round * s_StressGraphCount + graph + 1u));
+
+        // Several threads build their graphs into the same job system at once while earlier jobs are completing.
+        Atomic<u32> clock{ 0u };
+        submitters.parallelFor(
+            static_cast<usize>(0),
+            static_cast<usize>(s_StressGraphCount),
+            static_cast<usize>(1),
+            [&graphs, &jobSystem, &clock](const usize graph){
+                graphs[graph].submit(jobSystem, clock);
+            }
+        );
+
+        for(u32 graph = 0u; graph < s_StressGraphCount; ++graph)
+            jobSystem.wait(graphs[graph].handles[s_StressJobsPerGraph - 1u]);
+        jobSystem.waitAll();
+
+        EXPECT_EQ(clock.load(MemoryOrder::relaxed), s_StressGraphCount * s_StressJobsPerGraph);
+        for(u32 graph = 0u; graph < s_StressGraphCount; ++graph){
+            EXPECT_TRUE(graphs[graph].ranInOrder()) << "round " << round << " graph " << graph;
+            for(const JobHandle handle : graphs[graph].handles)
+                EXPECT_TRUE(jobSystem.isComplete(handle));
+        }
+    }
+}
+
+// Every worker is busy inside its own fan-out, so the helpers those calls queue can only run if the callers pick them
+// up while they wait.
+TEST(Alloc, BoundedParallelForFromEveryWorker){
+    static constexpr u32 s_CallerCount = 3u;
+    static constexpr usize s_ItemCount = 64u;
+    static constexpr usize s_MaxParallelism = 2u;
+
+    ThreadPool pool(s_CallerCount, CpuAffinity::Any);
+    Atomic<u32> visits[s_CallerCount][s_ItemCount] = {};
+    Atomic<u32> active[s_CallerCount] = {};
+    Atomic<u32> peakActive[s_CallerCount] = {};
+
+    for(u32 caller = 0u; caller < s_CallerCount; ++caller){
+        pool.enqueue([&pool, &visits, &active, &peakActive, caller](){
+            pool.boundedParallelFor(static_cast<usize>(0), s_ItemCount, static_cast<usize>(1), s_MaxParallelism, [&](const usize item){
+                const u32 running = active[caller].fetch_add(1u, MemoryOrder::acq_rel) + 1u;
+                u32 peak = peakActive[caller].load(MemoryOrder::relaxed);
+                while(running > peak && !peakActive[caller].compare_exchange_weak(peak, running, MemoryOrder::relaxed))
+                    ;
+                visits[caller][item].fetch_add(1u, MemoryOrder::relaxed);
+                active[caller].fetch_sub(1u, MemoryOrder::acq_rel);
+            });
+        });
+    }
+    pool.wait();
+
+    for(u32 caller = 0u; caller < s_CallerCount; ++caller){
+        EXPECT_LE(peakActive[caller].load(MemoryOrder::relaxed), s_MaxParallelism) << "caller " << caller;
+        for(usize item = 0u; item < s_ItemCount; ++item)
+            EXPECT_EQ(visits[caller][item].load(MemoryOrder::relaxed), 1u) << "caller " << caller << " item " << item;
+    }
+}
+
+TEST(Alloc, JobSystemRejectsSubmissionWhenLinksRunOut){
+    ThreadPool pool(1u, CpuAffinity::Any);
+    JobSystem jobSystem(pool, s_ExhaustionArenaBytes);
+
+    // The gate holds every join pending, so their links stay in use until the arena has none left.
+    Atomic<u32> gateOpen{ 0u };
+    Atomic<u32> gateDone{ 0u };
+    const JobHandle gate = jobSystem.submit([&gateOpen, &gateDone](){
+        while(gateOpen.load(MemoryOrder::acquire) == 0u)
+            YieldThread();
+        gateDone.store(1u, MemoryOrder::release);
+    });
+    ASSERT_TRUE(gate.valid());
+
+    JobHandle dependencies[s_ExhaustionDependencies];
+    for(JobHandle& dependency : dependencies)
+        dependency = gate;
+
+    Atomic<u32> earlyRuns{ 0u };
+    Atomic<u32> runs{ 0u };
+    u32 accepted = 0u;
+    bool rejected = false;
+    for(u32 join = 0u; join < s_ExhaustionMaxJoins; ++join){
+        const JobHandle handle = jobSystem.submit(
+            [&gateDone, &earlyRuns, &runs](){
+                if(gateDone.load(MemoryOrder::acquire) == 0u)
+                    earlyRuns.fetch_add(1u, MemoryOrder::relaxed);
+                runs.fetch_add(1u, MemoryOrder::relaxed);
+            },
+            dependencies,
+            s_ExhaustionDependencies
+        );
+        if(!handle.valid()){
+            rejected = true;
+            break;
+        }
+        ++accepted;
+    }
+
+    EXPECT_TRUE(rejected);
+    EXPECT_GT(accepted, 0u);
+    EXPECT_EQ(runs.load(MemoryOrder::relaxed), 0u);
+
+    gateOpen.store(1u, MemoryOrder::release);
+    jobSystem.waitAll();
+    EXPECT_EQ(earlyRuns.load(MemoryOrder::relaxed), 0u);
+    EXPECT_EQ(runs.load(MemoryOrder::relaxed), accepted);
+
+    // A rejected submission hands its links back, and completed joins free theirs for the next one.
+    const JobHandle retried = jobSystem.submit(
+        [&runs](){ runs.fetch_add(1u, MemoryOrder::relaxed); },
+        dependencies,
+        s_ExhaustionDependencies
+    );
+    ASSERT_TRUE(retried.valid());
+    jobSystem.wait(retried);
+    EXPECT_EQ(runs.load(MemoryOrder::relaxed), accepted + 1u);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,636 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Manual CPU throughput probe for JobSystem on fine-grained job graphs. For every worker count from one to the core
+// count it runs a layered graph of 8,192 small jobs, each waiting on two jobs of the previous layer, through the
+// lock-free JobSystem and through a replica of the previous design (one Futex around scheduling, completion and
+// dependent release). It reports min/median/max wall time per graph and median jobs per second for both, and fails if
+// a graph skips a job or runs one before its dependencies.
+
+
+#include <core/alloc/general.h>
+#include <core/alloc/job.h>
+#include <core/alloc/thread.h>
+#include <core/common/application_entry.h>
+#include <core/common/module.h>
+
+#include <tests/common/profile_timing.h>
+#include <tests/common/test_context.h>
+
+#include <global/cpu_topology.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace JobSystemProfile{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<typename T>
+using TestVector = Tests::TestVector<T>;
+
+
+inline constexpr u32 s_LayerWidth = 64u;
+inline constexpr u32 s_LayerCount = 128u;
+inline constexpr u32 s_JobsPerGraph = s_LayerWidth * s_LayerCount;
+inline constexpr u32 s_JobWorkIterations = 64u;
+inline constexpr u32 s_MaxWorkerCount = 32u;
+inline constexpr u32 s_WarmupCount = 1u;
+inline constexpr u32 s_SampleCount = 9u;
+// Both systems get room for a whole graph in flight so neither measures arena exhaustion.
+inline constexpr usize s_ArenaBytes = 64u << 20u;
+
+inline constexpr Name s_LockedJobArena("tests/unit/alloc/job_system_profile/locked");
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// The pre-lock-free JobSystem, kept verbatim apart from owning no pool: every submit, dispatch and completion takes
+// m_mutex, and dependents are kept in per-node vectors.
+class LockedJobSystem : NoCopy{
+public:
+    struct JobHandle{
+        static constexpr u32 s_InvalidIndex = static_cast<u32>(-1);
+
+        u32 index = s_InvalidIndex;
+        u32 generation = 0;
+
+        inline bool valid()const{ return index != s_InvalidIndex && generation != 0; }
+        inline explicit operator bool()const{ return valid(); }
+    };
+
+
+private:
+    static constexpr usize s_JobInlineStorageBytes = 384;
+    static constexpr u32 s_WorkFirstDepthLimit = 8;
+
+
+private:
+    using JobFunction = InplaceFunction<s_JobInlineStorageBytes>;
+    using ReadyBatch = Vector<JobHandle, Core::Alloc::ScratchArena>;
+
+
+private:
+    struct JobSignal{
+        Atomic<u32> completedGeneration{ 0 };
+    };
+
+    struct JobNode{
+        using DependencyList = Vector<JobHandle, Core::Alloc::PersistentArena>;
+
+        JobFunction func;
+        DependencyList dependents;
+        JobSignal* completionSignal = nullptr;
+        u32 generation = 1;
+        u32 remainingDependencies = 0;
+        bool completed = true;
+        bool scheduled = false;
+
+
+    public:
+        inline explicit JobNode(Core::Alloc::PersistentArena& arena)
+            : dependents(DependencyList::allocator_type(arena))
+        {}
+    };
+
+
+private:
+    using JobNodeList = Vector<JobNode, Core::Alloc::PersistentArena>;
+    using JobFreeNodeList = Vector<u32, Core::Alloc::PersistentArena>;
+
+
+private:
+    static constexpr usize s_DefaultNodeReservePerThread = 256;
+
+
+private:
+    static inline usize defaultNodeReserveCount(u32 threadCount){
+        const usize totalThreads = AddSize(static_cast<usize>(threadCount), 1);
+        return SizeOf<s_DefaultNodeReservePerThread>(totalThreads);
+    }
+
+    inline void reserveDefaultNodes(const u32 threadCount){
+        const usize reserveCount = defaultNodeReserveCount(threadCount);
+        m_nodes.reserve(reserveCount);
+        m_freeNodes.reserve(reserveCount);
+    }
+
+
+public:
+    inline explicit LockedJobSystem(Core::Alloc::ThreadPool& pool, usize arenaSize)
+        : m_pool(pool)
+        , m_arena(s_LockedJobArena, arenaSize)
+        , m_nodes(JobNodeList::allocator_type(m_arena))
+        , m_freeNodes(JobFreeNodeList::allocator_type(m_arena))
+    {
+        reserveDefaultNodes(pool.workerThreadCount());
+    }
+
+    inline ~LockedJobSystem(){
+        waitAll();
+    }
+
+
+public:
+    template<typename Func>
+    inline JobHandle submit(Func&& task){
+        return submitWithDependencies(JobFunction(Forward<Func>(task)), nullptr, 0);
+    }
+
+    template<typename Func>
+    inline JobHandle submit(Func&& task, JobHandle dependency){
+        return submitWithDependencies(JobFunction(Forward<Func>(task)), &dependency, 1);
+    }
+
+    template<typename Func>
+    inline JobHandle submit(Func&& task, InitializerList<JobHandle> dependencies){
+        return submitWithDependencies(JobFunction(Forward<Func>(task)), dependencies.begin(), dependencies.size());
+    }
+
+    template<typename Func>
+    inline JobHandle submit(Func&& task, const JobHandle* dependencies, usize dependencyCount){
+        return submitWithDependencies(JobFunction(Forward<Func>(task)), dependencies, dependencyCount);
+    }
+
+    template<typename Func>
+    inline JobHandle then(JobHandle dependency, Func&& task){
+        return submit(Forward<Func>(task), dependency);
+    }
+
+public:
+    inline void wait(JobHandle handle){
+        if(!handle.valid())
+            return;
+
+        for(;;){
+            JobSignal* completionSignal = nullptr;
+            u32 completedGeneration = 0;
+
+            {
+                ScopedLock lock(m_mutex);
+
+                JobNode* node = tryResolveNodeLocked(handle);
+                if(!node)
+                    return;
+
+                completionSignal = node->completionSignal;
+                NWB_ASSERT_MSG(completionSignal != nullptr, NWB_TEXT("JobSystem encountered a null completion signal"));
+
+                completedGeneration = completionSignal->completedGeneration.load(MemoryOrder::acquire);
+                if(completedGeneration == handle.generation)
+                    return;
+            }
+
+            completionSignal->completedGeneration.wait(completedGeneration, MemoryOrder::relaxed);
+        }
+    }
+
+    inline void wait(InitializerList<JobHandle> handles){
+        for(const JobHandle handle : handles)
+            wait(handle);
+    }
+
+    inline void waitAll(){
+        usize current = m_pendingJobCount.load(MemoryOrder::acquire);
+        while(current > 0){
+            m_pendingJobCount.wait(current, MemoryOrder::relaxed);
+            current = m_pendingJobCount.load(MemoryOrder::acquire);
+        }
+    }
+
+    inline bool isComplete(JobHandle handle)const{
+        if(!handle.valid())
+            return true;
+
+        ScopedLock lock(m_mutex);
+        return !isPendingLocked(handle);
+    }
+
+private:
+    inline JobHandle submitWithDependencies(JobFunction&& task, const JobHandle* dependencies, usize dependencyCount){
+        if(!task)
+            return JobHandle{};
+
+        JobHandle output;
+        bool shouldSchedule = false;
+
+        {
+            ScopedLock lock(m_mutex);
+
+            output = acquireNodeLocked(Move(task));
+            JobNode* node = tryResolveNodeLocked(output);
+            NWB_ASSERT_MSG(node != nullptr, NWB_TEXT("JobSystem created an invalid job node"));
+            if(!node)
+                return JobHandle{};
+
+            u32 unresolved = 0;
+            for(usize i = 0; i < dependencyCount; ++i){
+                const JobHandle dependency = dependencies[i];
+                JobNode* dependencyNode = tryResolveNodeLocked(dependency);
+                if(!dependencyNode)
+                    continue;
+
+                dependencyNode->dependents.push_back(output);
+                ++unresolved;
+            }
+
+            m_pendingJobCount.fetch_add(1, MemoryOrder::release);
+            node->remainingDependencies = unresolved;
+            if(unresolved == 0){
+                node->scheduled = true;
+                shouldSchedule = true;
+            }
+        }
+
+        if(shouldSchedule)
+            enqueueExecution(output);
+
+        return output;
+    }
+
+    inline JobHandle acquireNodeLocked(JobFunction&& task){
+        u32 index = JobHandle::s_InvalidIndex;
+        if(!m_freeNodes.empty()){
+            index = m_freeNodes.back();
+            m_freeNodes.pop_back();
+        }
+        else{
+            if(m_nodes.size() >= static_cast<usize>(JobHandle::s_InvalidIndex)){
+                NWB_ASSERT_MSG(false, NWB_TEXT("JobSystem exceeded maximum number of trackable jobs"));
+                return JobHandle{};
+            }
+
+            index = static_cast<u32>(m_nodes.size());
+            m_nodes.emplace_back(m_arena);
+
+            JobNode& createdNode = m_nodes[index];
+            createdNode.completionSignal = NewArenaObject<JobSignal>(m_arena);
+            NWB_ASSERT_MSG(createdNode.completionSignal != nullptr, NWB_TEXT("JobSystem failed to allocate a completion signal"));
+        }
+
+        JobNode& node = m_nodes[index];
+        NWB_ASSERT_MSG(node.completionSignal != nullptr, NWB_TEXT("JobSystem acquired an invalid completion signal"));
+        node.func = Move(task);
+        node.dependents.clear();
+        node.remainingDependencies = 0;
+        node.completed = false;
+        node.scheduled = false;
+
+        JobHandle output;
+        output.index = index;
+        output.generation = node.generation;
+        return output;
+    }
+
+    inline void recycleNodeLocked(u32 index, JobNode& node){
+        node.func = JobFunction();
+        node.dependents.clear();
+        node.remainingDependencies = 0;
+        node.completed = true;
+        node.scheduled = false;
+
+        ++node.generation;
+        if(node.generation == 0)
+            node.generation = 1;
+
+        m_freeNodes.push_back(index);
+    }
+
+    inline bool isPendingLocked(JobHandle handle)const{
+        if(handle.index >= m_nodes.size())
+            return false;
+
+        const JobNode& node = m_nodes[handle.index];
+        if(node.generation != handle.generation)
+            return false;
+
+        return !node.completed;
+    }
+
+    inline JobNode* tryResolveNodeLocked(JobHandle handle){
+        if(!handle.valid() || handle.index >= m_nodes.size())
+            return nullptr;
+
+        JobNode& node = m_nodes[handle.index];
+        if(node.generation != handle.generation || node.completed)
+            return nullptr;
+
+        return &node;
+    }
+
+    inline void enqueueExecution(JobHandle handle){
+        m_pool.enqueue([this, handle](){
+            execute(handle);
+        });
+    }
+
+    inline void enqueueExecutionBatch(const JobHandle* handles, usize handleCount){
+        if(handleCount == 0)
+            return;
+
+        if(m_pool.workerThreadCount() == 0){
+            for(usize i = 0; i < handleCount; ++i)
+                execute(handles[i]);
+            return;
+        }
+
+        m_pool.enqueueBatch(handleCount, [this, handles](usize i){
+            const JobHandle handle = handles[i];
+            return [this, handle](){
+                execute(handle);
+            };
+        });
+    }
+
+    inline void execute(JobHandle handle){
+        JobHandle current = handle;
+        u32 workFirstDepth = 0;
+
+        while(current.valid()){
+            JobFunction task;
+            {
+                ScopedLock lock(m_mutex);
+
+                JobNode* node = tryResolveNodeLocked(current);
+                if(!node || !node->scheduled)
+                    return;
+
+                task = Move(node->func);
+            }
+
+            if(task)
+                task();
+
+            const bool allowInline = workFirstDepth < s_WorkFirstDepthLimit;
+            const JobHandle inlineContinuation = complete(current, allowInline);
+            if(!inlineContinuation.valid())
+                return;
+
+            current = inlineContinuation;
+            ++workFirstDepth;
+        }
+    }
+
+    inline JobHandle complete(JobHandle handle, bool allowInline){
+        Core::Alloc::ScratchArena scratchArena(Core::Alloc::ArenaScope::s_JobReadyBatch);
+        ReadyBatch readyJobs{ReadyBatch::allocator_type(scratchArena)};
+        JobSignal* completionSignal = nullptr;
+        JobHandle inlineContinuation;
+
+        {
+            ScopedLock lock(m_mutex);
+
+            JobNode* node = tryResolveNodeLocked(handle);
+            if(!node)
+                return JobHandle{};
+
+            completionSignal = node->completionSignal;
+            NWB_ASSERT_MSG(completionSignal != nullptr, NWB_TEXT("JobSystem encountered a null completion signal"));
+
+            const usize dependentCount = node->dependents.size();
+            for(usize i = 0; i < dependentCount; ++i){
+                const JobHandle dependentHandle = node->dependents[i];
+                JobNode* dependentNode = tryResolveNodeLocked(dependentHandle);
+                if(!dependentNode)
+                    continue;
+
+                NWB_ASSERT_MSG(dependentNode->remainingDependencies > 0, NWB_TEXT("JobSystem dependency counter underflow"));
+                if(dependentNode->remainingDependencies == 0)
+                    continue;
+
+                --dependentNode->remainingDependencies;
+                if(dependentNode->remainingDependencies == 0 && !dependentNode->scheduled){
+                    dependentNode->scheduled = true;
+
+                    if(allowInline && !inlineContinuation.valid()){
+                        inlineContinuation = dependentHandle;
+                        continue;
+                    }
+
+                    if(readyJobs.empty())
+                        readyJobs.reserve(dependentCount - i);
+                    readyJobs.push_back(dependentHandle);
+                }
+            }
+
+            completionSignal->completedGeneration.store(handle.generation, MemoryOrder::release);
+            recycleNodeLocked(handle.index, *node);
+        }
+
+        completionSignal->completedGeneration.notify_all();
+
+        enqueueExecutionBatch(readyJobs.data(), readyJobs.size());
+
+        if(m_pendingJobCount.fetch_sub(1, MemoryOrder::acq_rel) == 1)
+            m_pendingJobCount.notify_all();
+
+        return inlineContinuation;
+    }
+
+
+private:
+    Core::Alloc::ThreadPool& m_pool;
+
+    Core::Alloc::PersistentArena m_arena;
+    JobNodeList m_nodes;
+    JobFreeNodeList m_freeNodes;
+
+    mutable Futex m_mutex;
+    Atomic<usize> m_pendingJobCount{ 0 };
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+struct SystemSamples{
+    Tests::ProfileTimingSamples graph;
+};
+
+struct WorkerResult{
+    u32 workerCount = 0u;
+    SystemSamples lockFree;
+    SystemSamples locked;
+};
+
+// Each job stamps the order it ran in; a job is valid when it ran once and after both of its dependencies.
+struct GraphState{
+    Atomic<u32> clock{ 0u };
+    Atomic<u32> order[s_JobsPerGraph];
+    Atomic<u32> sink{ 0u };
+
+    void reset(){
+        clock.store(0u, MemoryOrder::relaxed);
+        for(Atomic<u32>& stamp : order)
+            stamp.store(0u, MemoryOrder::relaxed);
+    }
+
+    void run(const u32 job){
+        u32 value = job + 1u;
+        for(u32 i = 0u; i < s_JobWorkIterations; ++i){
+            value ^= value << 13u;
+            value ^= value >> 17u;
+            value ^= value << 5u;
+        }
+        sink.fetch_add(value, MemoryOrder::relaxed);
+        order[job].store(clock.fetch_add(1u, MemoryOrder::acq_rel) + 1u, MemoryOrder::release);
+    }
+
+    [[nodiscard]] bool valid()const{
+        if(clock.load(MemoryOrder::acquire) != s_JobsPerGraph)
+            return false;
+
+        for(u32 job = 0u; job < s_JobsPerGraph; ++job){
+            const u32 stamp = order[job].load(MemoryOrder::acquire);
+            if(stamp == 0u)
+                return false;
+            if(job < s_LayerWidth)
+                continue;
+
+            const u32 layerBegin = job - job % s_LayerWidth - s_LayerWidth;
+            const u32 left = layerBegin + job % s_LayerWidth;
+            const u32 right = layerBegin + (job + 1u) % s_LayerWidth;
+            if(order[left].load(MemoryOrder::acquire) >= stamp || order[right].load(MemoryOrder::acquire) >= stamp)
+                return false;
+        }
+        return true;
+    }
+};
+
+
+template<typename System>
+static void RunGraph(System& system, GraphState& state, TestVector<typename System::JobHandle>& handles){
+    using JobHandle = typename System::JobHandle;
+
+    for(u32 job = 0u; job < s_JobsPerGraph; ++job){
+        if(job < s_LayerWidth){
+            handles[job] = system.submit([&state, job](){ state.run(job); });
+            continue;
+        }
+
+        const u32 layerBegin = job - job % s_LayerWidth - s_LayerWidth;
+        const JobHandle dependencies[2] = {
+            handles[layerBegin + job % s_LayerWidth],
+            handles[layerBegin + (job + 1u) % s_LayerWidth],
+        };
+        handles[job] = system.submit([&state, job](){ state.run(job); }, dependencies, 2u);
+    }
+    system.waitAll();
+}
+
+template<typename System>
+[[nodiscard]] static bool Measure(System& system, GraphState& state, SystemSamples& outSamples){
+    TestVector<typename System::JobHandle> handles(s_JobsPerGraph);
+    bool valid = true;
+    for(u32 i = 0u; i < s_WarmupCount + s_SampleCount; ++i){
+        state.reset();
+
+        const Timer begin = TimerNow();
+        RunGraph(system, state, handles);
+        const Timer end = TimerNow();
+
+        valid = state.valid() && valid;
+        if(i < s_WarmupCount)
+            continue;
+        if(!outSamples.graph.append(DurationInSeconds<f64>(end, begin)))
+            break;
+    }
+    return valid;
+}
+
+[[nodiscard]] static bool RunProfile(TestVector<WorkerResult>& outResults){
+    const u32 maxWorkerCount = Min(Max(QueryCpuCoreCount(CpuAffinity::Any), 1u), s_MaxWorkerCount);
+
+    auto state = MakeUnique<GraphState>();
+    bool valid = true;
+    for(u32 workerCount = 1u; workerCount <= maxWorkerCount; ++workerCount){
+        WorkerResult& result = outResults.emplace_back();
+        result.workerCount = workerCount;
+        {
+            Core::Alloc::JobSystem system(workerCount, CpuAffinity::Any, s_ArenaBytes);
+            valid = Measure(system, *state, result.lockFree) && valid;
+        }
+        {
+            Core::Alloc::ThreadPool pool(workerCount, CpuAffinity::Any, s_ArenaBytes);
+            LockedJobSystem system(pool, s_ArenaBytes);
+            valid = Measure(system, *state, result.locked) && valid;
+        }
+    }
+    return valid;
+}
+
+static void EmitSystem(const char* name, const SystemSamples& samples){
+    const Tests::ProfileTimingSummary summary = Tests::SummarizeProfileTiming(samples.graph);
+    const f64 jobsPerSecond = summary.median > 0.0 ? static_cast<f64>(s_JobsPerGraph) / summary.median : 0.0;
+
+    NWB_COUT << '\"' << name << "\":{";
+    Tests::EmitProfileTiming("graph", samples.graph);
+    NWB_COUT << ",\"median_jobs_per_second\":" << jobsPerSecond << '}';
+}
+
+static void EmitResult(const TestVector<WorkerResult>& results, const bool valid){
+    NWB_COUT
+        << "{\"status\":\"" << (valid ? "ok" : "failed") << "\","
+        << "\"jobs_per_graph\":" << s_JobsPerGraph << ','
+        << "\"layer_width\":" << s_LayerWidth << ','
+        << "\"samples\":" << s_SampleCount << ','
+        << "\"workers\":["
+    ;
+    for(usize i = 0u; i < results.size(); ++i){
+        const WorkerResult& result = results[i];
+        if(i > 0u)
+            NWB_COUT << ',';
+        NWB_COUT << "{\"worker_threads\":" << result.workerCount << ',';
+        EmitSystem("lock_free", result.lockFree);
+        NWB_COUT << ',';
+        EmitSystem("locked", result.locked);
+        NWB_COUT << '}';
+    }
+    NWB_COUT << "]}\n";
+}
+
+[[nodiscard]] static int EntryPoint(const isize, tchar**, void*){
+    Core::Common::InitializerGuard commonInitializerGuard;
+    if(!commonInitializerGuard.initialize()){
+        NWB_CERR << "job system profile initialization failed\n";
+        return 1;
+    }
+
+    TestVector<WorkerResult> results;
+    const bool valid = RunProfile(results);
+    EmitResult(results, valid);
+    return valid ? 0 : 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_DEFINE_APPLICATION_ENTRY_POINT(::NWB::JobSystemProfile::EntryPoint)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
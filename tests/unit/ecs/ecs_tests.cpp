@@ -6,6 +6,7 @@
 #include <core/common/module.h>
 
 #include <tests/common/ecs_test_world.h>
+#include <tests/common/test_context.h>
 #include <gtest/gtest.h>
 
 #include <global/atomic.h>
@@ -43,10 +44,38 @@ struct alignas(32) OverAlignedComponent{
     u8 value[32] = {};
 };
 
+struct LabelComponent{
+    NWB::Tests::TestAString text;
+    u32 order = 0u;
+};
+
+struct LabelSerializer{
+    static constexpr bool s_Bulk = false;
+
+    static bool Write(NWB::Core::ECS::WorldSnapshotBytes& outBytes, const LabelComponent& component){
+        if(!AppendString(outBytes, AStringView(component.text.data(), component.text.size())))
+            return false;
+        AppendPOD(outBytes, component.order);
+        return true;
+    }
+    static bool Read(const BinaryByteView& bytes, usize& inOutCursor, LabelComponent& outComponent){
+        return ReadString(bytes, inOutCursor, outComponent.text) && ReadPOD(bytes, inOutCursor, outComponent.order);
+    }
+};
+
+inline constexpr Name s_SnapshotPositionName("tests/ecs/position");
+inline constexpr Name s_SnapshotAlignedName("tests/ecs/over_aligned");
+inline constexpr Name s_SnapshotLabelName("tests/ecs/label");
+
 struct TickMessage{
     u32 value = 0;
 };
 
+struct SequencedMessage{
+    u32 task = 0u;
+    u32 sequence = 0u;
+};
+
 struct MoveOnlyMessage{
     explicit MoveOnlyMessage(u32 v)
         : value(v)
@@ -100,6 +129,58 @@ public:
     f32 lastDelta = 0.0f;
 };
 
+class ChangeTrackingSystem final : public NWB::Core::ECS::ISystem{
+public:
+    explicit ChangeTrackingSystem(NWB::Core::Alloc::GlobalArena& arena)
+        : NWB::Core::ECS::ISystem(arena)
+    {
+        readAccess<PositionComponent>();
+    }
+
+public:
+    virtual void update(NWB::Core::ECS::World& world, const f32 delta)override{
+        static_cast<void>(delta);
+
+        added = 0u;
+        changed = 0u;
+        removed = 0u;
+        world.view<PositionComponent>().filter<NWB::Core::ECS::Added<PositionComponent>>(lastRunTick()).each(
+            [this](NWB::Core::ECS::EntityID, PositionComponent&){ ++added; }
+        );
+        const auto changedView = world.view<PositionComponent>().changed<PositionComponent>(lastRunTick());
+        for(auto itr = changedView.begin(); itr != changedView.end(); ++itr)
+            ++changed;
+        world.eachRemoved<PositionComponent>(lastRunTick(), [this](NWB::Core::ECS::EntityID){ ++removed; });
+    }
+
+public:
+    u32 added = 0u;
+    u32 changed = 0u;
+    u32 removed = 0u;
+};
+
+static void RegisterSnapshotComponents(NWB::Core::ECS::World& world){
+    world.registerSnapshotComponent<PositionComponent>(s_SnapshotPositionName);
+    world.registerSnapshotComponent<OverAlignedComponent>(s_SnapshotAlignedName);
+    world.registerSnapshotComponent<LabelComponent, LabelSerializer>(s_SnapshotLabelName);
+}
+
+[[nodiscard]] static BinaryByteView SnapshotView(const NWB::Core::ECS::WorldSnapshotBytes& bytes){
+    return BinaryByteView{ bytes.data(), bytes.size() };
+}
+
+template<typename... Ts>
+[[nodiscard]] usize CountView(const NWB::Core::ECS::View<Ts...>& view){
+    usize eachCount = 0u;
+    view.each([&eachCount](NWB::Core::ECS::EntityID, Ts&...){ ++eachCount; });
+
+    usize iteratorCount = 0u;
+    for(auto itr = view.begin(); itr != view.end(); ++itr)
+        ++iteratorCount;
+    EXPECT_EQ(eachCount, iteratorCount);
+    return eachCount;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -253,6 +334,352 @@ TEST(Ecs, ComponentMutationVersion){
     EXPECT_EQ(testWorld.world.componentMutationVersion<PositionComponent>(), 2u);
 }
 
+TEST(Ecs, ChangeFiltersFollowSystemRuns){
+    TestWorld testWorld;
+    auto& world = testWorld.world;
+
+    auto first = world.createEntity();
+    auto second = world.createEntity();
+    first.addComponent<PositionComponent>();
+    second.addComponent<PositionComponent>();
+
+    auto& system = world.addSystem<ChangeTrackingSystem>();
+    world.tick(0.0f);
+    EXPECT_EQ(system.added, 2u);
+    EXPECT_EQ(system.changed, 2u);
+    EXPECT_EQ(system.removed, 0u);
+
+    world.tick(0.0f);
+    EXPECT_EQ(system.added, 0u);
+    EXPECT_EQ(system.changed, 0u);
+
+    EXPECT_TRUE(second.markChanged<PositionComponent>());
+    EXPECT_FALSE(second.markChanged<VelocityComponent>());
+    auto third = world.createEntity();
+    third.addComponent<PositionComponent>();
+    world.tick(0.0f);
+    EXPECT_EQ(system.added, 1u);
+    EXPECT_EQ(system.changed, 2u);
+
+    first.removeComponent<PositionComponent>();
+    third.destroy();
+    world.tick(0.0f);
+    EXPECT_EQ(system.added, 0u);
+    EXPECT_EQ(system.changed, 0u);
+    EXPECT_EQ(system.removed, 2u);
+
+    // Removals every system has seen are trimmed, so even an older since tick finds none.
+    world.tick(0.0f);
+    EXPECT_EQ(system.removed, 0u);
+    usize staleRemovals = 0u;
+    EXPECT_FALSE(world.eachRemoved<PositionComponent>(
+        world.changeTick() - 8u,
+        [&staleRemovals](NWB::Core::ECS::EntityID){ ++staleRemovals; }
+    ));
+    EXPECT_EQ(staleRemovals, 0u);
+    EXPECT_TRUE(world.eachRemoved<PositionComponent>(world.changeTick() - 1u, [](NWB::Core::ECS::EntityID){}));
+}
+
+TEST(Ecs, ChangeTicksSurviveWraparound){
+    using NWB::Core::ECS::ChangeTick::IsNewer;
+    using NWB::Core::ECS::ChangeTick::Clamp;
+    using NWB::Core::ECS::ChangeTick::s_MaxAge;
+
+    EXPECT_TRUE(IsNewer(2u, ~0u - 1u));
+    EXPECT_FALSE(IsNewer(~0u - 1u, 2u));
+    EXPECT_FALSE(IsNewer(5u, 5u));
+    EXPECT_EQ(Clamp(1u, 3u), 1u);
+    EXPECT_EQ(Clamp(7u, 7u + s_MaxAge), 7u);
+    EXPECT_EQ(Clamp(7u, 8u + s_MaxAge), 8u);
+    EXPECT_EQ(Clamp(~0u - 4u, s_MaxAge), 0u);
+
+    TestWorld testWorld;
+    NWB::Core::ECS::ComponentPool<PositionComponent> pool(testWorld.arena);
+    const NWB::Core::ECS::EntityID before(0u, 0u);
+    const NWB::Core::ECS::EntityID after(1u, 0u);
+
+    const u32 beforeWrapTick = ~0u - 2u;
+    pool.setChangeTick(beforeWrapTick);
+    pool.add(before);
+    pool.setChangeTick(beforeWrapTick + 5u);
+    pool.add(after);
+
+    NWB::Core::ECS::View<PositionComponent> view(MakeTuple(&pool));
+    EXPECT_EQ(CountView(view.added<PositionComponent>(beforeWrapTick - 1u)), 2u);
+    EXPECT_EQ(CountView(view.added<PositionComponent>(beforeWrapTick)), 1u);
+    EXPECT_EQ(CountView(view.changed<PositionComponent>(beforeWrapTick + 5u)), 0u);
+
+    pool.setChangeTick(beforeWrapTick + 9u);
+    EXPECT_TRUE(pool.markChanged(before));
+    EXPECT_EQ(CountView(view.added<PositionComponent>(beforeWrapTick + 5u)), 0u);
+    EXPECT_EQ(CountView(view.changed<PositionComponent>(beforeWrapTick + 5u)), 1u);
+
+    // Once a tick falls s_MaxAge behind it is pinned there instead of wrapping back into the future.
+    const u32 farTick = beforeWrapTick + 8u + s_MaxAge;
+    pool.clampChangeTicks(farTick);
+    const NWB::Core::ECS::ComponentTicks* ticks = pool.tryGetTicks(before);
+    ASSERT_NE(ticks, nullptr);
+    EXPECT_EQ(ticks->added, farTick - s_MaxAge);
+    EXPECT_EQ(ticks->changed, beforeWrapTick + 9u);
+    EXPECT_EQ(CountView(view.changed<PositionComponent>(farTick - s_MaxAge)), 1u);
+}
+
+TEST(Ecs, SwapAndPopKeepsComponentTicks){
+    TestWorld testWorld;
+    NWB::Core::ECS::ComponentPool<PositionComponent> pool(testWorld.arena);
+    NWB::Core::ECS::ComponentPool<VelocityComponent> velocities(testWorld.arena);
+
+    const NWB::Core::ECS::EntityID entities[] = {
+        NWB::Core::ECS::EntityID(0u, 0u),
+        NWB::Core::ECS::EntityID(1u, 0u),
+        NWB::Core::ECS::EntityID(2u, 0u),
+    };
+    for(u32 i = 0u; i < 3u; ++i){
+        pool.setChangeTick(10u + i);
+        velocities.setChangeTick(10u + i);
+        pool.add(entities[i]).x = static_cast<i32>(i);
+        velocities.add(entities[i]);
+    }
+
+    // Removing the first slot moves the last entity into it; its ticks must move with it.
+    pool.setChangeTick(20u);
+    velocities.setChangeTick(20u);
+    EXPECT_TRUE(pool.remove(entities[0]));
+    EXPECT_FALSE(pool.remove(entities[0]));
+
+    const NWB::Core::ECS::ComponentTicks* movedTicks = pool.tryGetTicks(entities[2]);
+    ASSERT_NE(movedTicks, nullptr);
+    EXPECT_EQ(movedTicks->added, 12u);
+    EXPECT_EQ(movedTicks->changed, 12u);
+    EXPECT_EQ(pool.tryGetTicks(entities[0]), nullptr);
+
+    NWB::Core::ECS::View<PositionComponent> view(MakeTuple(&pool));
+    NWB::Core::ECS::EntityID addedEntity;
+    usize addedCount = 0u;
+    view.added<PositionComponent>(11u).each(
+        [&addedEntity, &addedCount](const NWB::Core::ECS::EntityID entityId, PositionComponent& position){
+            EXPECT_EQ(position.x, 2);
+            addedEntity = entityId;
+            ++addedCount;
+        }
+    );
+    EXPECT_EQ(addedCount, 1u);
+    EXPECT_EQ(addedEntity, entities[2]);
+
+    EXPECT_TRUE(view.markChanged<PositionComponent>(entities[1]));
+    NWB::Core::ECS::View<PositionComponent, VelocityComponent> pairView(MakeTuple(&pool, &velocities));
+    EXPECT_EQ(CountView(pairView.changed<PositionComponent>(12u)), 1u);
+    EXPECT_EQ(CountView(pairView.filter<NWB::Core::ECS::Changed<PositionComponent>, NWB::Core::ECS::Added<VelocityComponent>>(12u)), 0u);
+    EXPECT_EQ(CountView(pairView.filter<NWB::Core::ECS::Added<VelocityComponent>>(11u)), 1u);
+
+    usize removedCount = 0u;
+    EXPECT_TRUE(pool.eachRemoved(19u, [&removedCount, &entities](const NWB::Core::ECS::EntityID entityId){
+        EXPECT_EQ(entityId, entities[0]);
+        ++removedCount;
+    }));
+    EXPECT_EQ(removedCount, 1u);
+
+    pool.trimRemoved(20u);
+    removedCount = 0u;
+    EXPECT_FALSE(pool.eachRemoved(0u, [&removedCount](NWB::Core::ECS::EntityID){ ++removedCount; }));
+    EXPECT_EQ(removedCount, 0u);
+    EXPECT_TRUE(pool.eachRemoved(20u, [&removedCount](NWB::Core::ECS::EntityID){ ++removedCount; }));
+}
+
+TEST(Ecs, RemovalLogStaysBoundedWithoutTicks){
+    TestWorld testWorld;
+    NWB::Core::ECS::ComponentPool<PositionComponent> pool(testWorld.arena);
+    const NWB::Core::ECS::EntityID entity(0u, 0u);
+
+    // Nothing trims the log here, so only the cap keeps it from growing with every removal.
+    static constexpr u32 s_RemovalCount = 3u << 16u;
+    pool.setChangeTick(5u);
+    for(u32 i = 0u; i < s_RemovalCount; ++i){
+        pool.add(entity);
+        ASSERT_TRUE(pool.remove(entity));
+    }
+
+    usize removedCount = 0u;
+    EXPECT_FALSE(pool.eachRemoved(4u, [&removedCount](NWB::Core::ECS::EntityID){ ++removedCount; }));
+    EXPECT_GT(removedCount, 0u);
+    EXPECT_LE(removedCount, static_cast<usize>(1u << 16u));
+
+    // A reader past the discarded entries still gets a complete answer.
+    pool.setChangeTick(6u);
+    pool.add(entity);
+    ASSERT_TRUE(pool.remove(entity));
+    removedCount = 0u;
+    EXPECT_TRUE(pool.eachRemoved(5u, [&removedCount](NWB::Core::ECS::EntityID){ ++removedCount; }));
+    EXPECT_EQ(removedCount, 1u);
+}
+
+TEST(Ecs, ViewWriteStampsVisitedComponents){
+    TestWorld testWorld;
+    NWB::Core::ECS::ComponentPool<PositionComponent> positions(testWorld.arena);
+    NWB::Core::ECS::ComponentPool<VelocityComponent> velocities(testWorld.arena);
+
+    const NWB::Core::ECS::EntityID entities[] = {
+        NWB::Core::ECS::EntityID(0u, 0u),
+        NWB::Core::ECS::EntityID(1u, 0u),
+        NWB::Core::ECS::EntityID(2u, 0u),
+    };
+    positions.setChangeTick(10u);
+    velocities.setChangeTick(10u);
+    for(const NWB::Core::ECS::EntityID entityId : entities)
+        positions.add(entityId);
+    velocities.add(entities[0]);
+    velocities.add(entities[2]);
+
+    NWB::Core::ECS::View<PositionComponent> positionView(MakeTuple(&positions));
+    NWB::Core::ECS::View<VelocityComponent> velocityView(MakeTuple(&velocities));
+    NWB::Core::ECS::View<PositionComponent, VelocityComponent> pairView(MakeTuple(&positions, &velocities));
+
+    // Only components named in write() are stamped, and only for entities the callback actually received.
+    positions.setChangeTick(20u);
+    velocities.setChangeTick(20u);
+    pairView.write<PositionComponent>().each(
+        [](NWB::Core::ECS::EntityID, PositionComponent& position, VelocityComponent&){ ++position.x; }
+    );
+    EXPECT_EQ(CountView(positionView.changed<PositionComponent>(10u)), 2u);
+    EXPECT_EQ(CountView(velocityView.changed<VelocityComponent>(10u)), 0u);
+    ASSERT_NE(positions.tryGetTicks(entities[1]), nullptr);
+    EXPECT_EQ(positions.tryGetTicks(entities[1])->changed, 10u);
+
+    // A change filter narrows what gets stamped, and iterators stamp on dereference.
+    positions.setChangeTick(30u);
+    usize iterated = 0u;
+    const auto changedPositions = positionView.changed<PositionComponent>(10u).write<PositionComponent>();
+    for(auto itr = changedPositions.begin(); itr != changedPositions.end(); ++itr){
+        static_cast<void>(*itr);
+        ++iterated;
+    }
+    EXPECT_EQ(iterated, 2u);
+    EXPECT_EQ(CountView(positionView.changed<PositionComponent>(20u)), 2u);
+    EXPECT_EQ(positions.tryGetTicks(entities[0])->changed, 30u);
+    EXPECT_EQ(positions.tryGetTicks(entities[1])->changed, 10u);
+}
+
+TEST(Ecs, WorldSnapshotRoundTripIsBitExact){
+    TestWorld source;
+    RegisterSnapshotComponents(source.world);
+
+    NWB::Core::ECS::EntityID ids[8];
+    for(u32 i = 0u; i < 8u; ++i){
+        auto entity = source.world.createEntity();
+        ids[i] = entity.id();
+        entity.addComponent<PositionComponent>(PositionComponent{ static_cast<i32>(i), -static_cast<i32>(i) });
+        if((i & 1u) != 0u)
+            entity.addComponent<LabelComponent>().text = "label";
+        if(i == 5u)
+            entity.addComponent<OverAlignedComponent>().value[31] = 0x5Au;
+        entity.addComponent<VelocityComponent>();
+    }
+    source.world.entity(ids[2]).destroy();
+    source.world.entity(ids[6]).destroy();
+    source.world.entity(ids[3]).removeComponent<PositionComponent>();
+    // Reusing slot 2 bumps its generation; slot 6 stays on the free list.
+    auto reused = source.world.createEntity();
+    reused.addComponent<LabelComponent>().order = 77u;
+    ids[2] = reused.id();
+
+    NWB::Core::ECS::WorldSnapshotBytes firstBytes(source.arena);
+    ASSERT_TRUE(source.world.writeSnapshot(firstBytes));
+
+    TestWorld restored;
+    RegisterSnapshotComponents(restored.world);
+    restored.world.createEntity().addComponent<PositionComponent>();
+    ASSERT_TRUE(restored.world.restoreSnapshot(SnapshotView(firstBytes)));
+
+    NWB::Core::ECS::WorldSnapshotBytes secondBytes(restored.arena);
+    ASSERT_TRUE(restored.world.writeSnapshot(secondBytes));
+    ASSERT_EQ(firstBytes.size(), secondBytes.size());
+    EXPECT_EQ(NWB_MEMCMP(firstBytes.data(), secondBytes.data(), firstBytes.size()), 0);
+
+    EXPECT_EQ(restored.world.entityCount(), source.world.entityCount());
+    EXPECT_FALSE(restored.world.entity(ids[6]).alive());
+    EXPECT_FALSE(restored.world.entity(NWB::Core::ECS::EntityID(ids[2].index(), 0u)).alive());
+    for(const NWB::Core::ECS::EntityID entityId : ids){
+        auto entity = restored.world.entity(entityId);
+        EXPECT_EQ(entity.alive(), source.world.entity(entityId).alive());
+        EXPECT_FALSE(entity.hasComponent<VelocityComponent>());
+    }
+    EXPECT_FALSE(restored.world.entity(ids[3]).hasComponent<PositionComponent>());
+    EXPECT_EQ(restored.world.entity(ids[7]).getComponent<PositionComponent>().y, -7);
+    EXPECT_EQ(restored.world.entity(ids[5]).getComponent<LabelComponent>().text, "label");
+    EXPECT_EQ(restored.world.entity(ids[5]).getComponent<OverAlignedComponent>().value[31], 0x5Au);
+    EXPECT_EQ(restored.world.entity(ids[2]).getComponent<LabelComponent>().order, 77u);
+    EXPECT_EQ(CountView(restored.world.view<PositionComponent, LabelComponent>()), 3u);
+
+    // The free list is restored in reuse order and destroying restored entities unlinks their components.
+    EXPECT_EQ(restored.world.createEntity().id(), source.world.createEntity().id());
+    restored.world.entity(ids[5]).destroy();
+    EXPECT_EQ(CountView(restored.world.view<OverAlignedComponent>()), 0u);
+}
+
+TEST(Ecs, WorldSnapshotSkipsUnregisteredSections){
+    TestWorld source;
+    RegisterSnapshotComponents(source.world);
+    auto entity = source.world.createEntity();
+    entity.addComponent<PositionComponent>(PositionComponent{ 3, 4 });
+    entity.addComponent<LabelComponent>().text = "skipped";
+
+    NWB::Core::ECS::WorldSnapshotBytes bytes(source.arena);
+    ASSERT_TRUE(source.world.writeSnapshot(bytes));
+
+    TestWorld restored;
+    restored.world.registerSnapshotComponent<PositionComponent>(s_SnapshotPositionName);
+    ASSERT_TRUE(restored.world.restoreSnapshot(SnapshotView(bytes)));
+    auto restoredEntity = restored.world.entity(entity.id());
+    ASSERT_TRUE(restoredEntity.alive());
+    EXPECT_EQ(restoredEntity.getComponent<PositionComponent>().y, 4);
+    EXPECT_FALSE(restoredEntity.hasComponent<LabelComponent>());
+}
+
+TEST(Ecs, WorldSnapshotRejectsMalformedInput){
+    TestWorld source;
+    RegisterSnapshotComponents(source.world);
+    for(u32 i = 0u; i < 4u; ++i)
+        source.world.createEntity().addComponent<PositionComponent>();
+    source.world.entity(NWB::Core::ECS::EntityID(1u, 0u)).destroy();
+    source.world.entity(NWB::Core::ECS::EntityID(2u, 0u)).destroy();
+
+    NWB::Core::ECS::WorldSnapshotBytes bytes(source.arena);
+    ASSERT_TRUE(source.world.writeSnapshot(bytes));
+
+    TestWorld restored;
+    RegisterSnapshotComponents(restored.world);
+    const auto expectRejected = [&restored](const NWB::Core::ECS::WorldSnapshotBytes& candidate){
+        restored.world.createEntity().addComponent<PositionComponent>();
+        EXPECT_FALSE(restored.world.restoreSnapshot(SnapshotView(candidate)));
+        EXPECT_EQ(restored.world.entityCount(), 0u);
+        EXPECT_EQ(CountView(restored.world.view<PositionComponent>()), 0u);
+    };
+
+    NWB::Core::ECS::WorldSnapshotBytes corrupted(bytes);
+    corrupted.pop_back();
+    expectRejected(corrupted);
+
+    corrupted = bytes;
+    corrupted[0] ^= 0xFFu;
+    expectRejected(corrupted);
+
+    // Both free indices point at slot 1.
+    const usize freeListOffset = sizeof(NWB::Core::ECS::WorldSnapshotHeader) + 4u * sizeof(u16);
+    corrupted = bytes;
+    NWB_MEMCPY(corrupted.data() + freeListOffset + sizeof(u32), sizeof(u32), corrupted.data() + freeListOffset, sizeof(u32));
+    expectRejected(corrupted);
+
+    // A position listed for an entity that is on the free list.
+    const usize positionIdsOffset = freeListOffset + 2u * sizeof(u32) + sizeof(NWB::Core::ECS::WorldSnapshotComponentHeader);
+    const NWB::Core::ECS::EntityID deadEntity(2u, 1u);
+    corrupted = bytes;
+    NWB_MEMCPY(corrupted.data() + positionIdsOffset, sizeof(deadEntity), &deadEntity, sizeof(deadEntity));
+    expectRejected(corrupted);
+
+    ASSERT_TRUE(restored.world.restoreSnapshot(SnapshotView(bytes)));
+    EXPECT_EQ(restored.world.entityCount(), 2u);
+}
+
 TEST(Ecs, MessageBus){
     TestWorld testWorld;
 
@@ -308,6 +735,177 @@ TEST(Ecs, MoveOnlyMessageBus){
     EXPECT_EQ(testWorld.world.messageCount<MoveOnlyMessage>(), 0u);
 }
 
+TEST(Ecs, MessageBusKeepsSingleThreadPostingOrder){
+    TestWorld testWorld;
+
+    static constexpr u32 s_MessageCount = 1024u;
+    for(u32 round = 0u; round < 2u; ++round){
+        for(u32 i = 0u; i < s_MessageCount; ++i)
+            testWorld.world.postMessage(TickMessage{ round * s_MessageCount + i });
+
+        testWorld.world.swapMessageBuffers();
+        ASSERT_EQ(testWorld.world.messageCount<TickMessage>(), s_MessageCount);
+
+        u32 expected = round * s_MessageCount;
+        testWorld.world.consumeMessages<TickMessage>(
+            [&expected](const TickMessage& message){
+                EXPECT_EQ(message.value, expected);
+                ++expected;
+            }
+        );
+        EXPECT_EQ(expected, (round + 1u) * s_MessageCount);
+    }
+}
+
+TEST(Ecs, MessageBusConcurrentPosts){
+    NWB::Core::Alloc::GlobalArena arena(s_EcsParallelTestArena);
+    NWB::Core::Alloc::ThreadPool threadPool(3u, CpuAffinity::Any);
+    NWB::Core::ECS::World world(arena, threadPool);
+
+    static constexpr u32 s_TaskCount = 64u;
+    static constexpr u32 s_MessagesPerTask = 128u;
+    static constexpr u32 s_MessageCount = s_TaskCount * s_MessagesPerTask;
+
+    for(u32 round = 0u; round < 3u; ++round){
+        threadPool.parallelFor(
+            static_cast<usize>(0),
+            static_cast<usize>(s_TaskCount),
+            [&world](const usize taskIndex){
+                const u32 task = static_cast<u32>(taskIndex);
+                for(u32 sequence = 0u; sequence < s_MessagesPerTask; ++sequence){
+                    world.postMessage(SequencedMessage{ task, sequence });
+                    world.emplaceMessage<MoveOnlyMessage>(task * s_MessagesPerTask + sequence);
+                }
+            }
+        );
+        // Posts stay pending; readers still see the previous round until the swap.
+        EXPECT_EQ(world.messageCount<SequencedMessage>(), round == 0u ? 0u : s_MessageCount);
+
+        world.swapMessageBuffers();
+        ASSERT_EQ(world.messageCount<SequencedMessage>(), s_MessageCount);
+        ASSERT_EQ(world.messageCount<MoveOnlyMessage>(), s_MessageCount);
+
+        // A task runs on one thread, so its messages must arrive in the order it posted them.
+        u32 nextSequence[s_TaskCount] = {};
+        world.consumeMessages<SequencedMessage>(
+            [&nextSequence](const SequencedMessage& message){
+                ASSERT_LT(message.task, s_TaskCount);
+                EXPECT_EQ(message.sequence, nextSequence[message.task]);
+                ++nextSequence[message.task];
+            }
+        );
+        for(u32 task = 0u; task < s_TaskCount; ++task)
+            EXPECT_EQ(nextSequence[task], s_MessagesPerTask);
+
+        u32 seen[s_MessageCount] = {};
+        world.consumeMessages<MoveOnlyMessage>(
+            [&seen](const MoveOnlyMessage& message){
+                ASSERT_LT(message.value, s_MessageCount);
+                ++seen[message.value];
+            }
+        );
+        for(u32 i = 0u; i < s_MessageCount; ++i)
+            EXPECT_EQ(seen[i], 1u);
+    }
+
+    world.clearMessages();
+    EXPECT_EQ(world.messageCount<SequencedMessage>(), 0u);
+    EXPECT_EQ(world.messageCount<MoveOnlyMessage>(), 0u);
+}
+
+TEST(Ecs, MessageBusScopedPostsConsumeInItemOrder){
+    NWB::Core::Alloc::GlobalArena arena(s_EcsParallelTestArena);
+    NWB::Core::Alloc::ThreadPool threadPool(3u, CpuAffinity::Any);
+    NWB::Core::ECS::World world(arena, threadPool);
+
+    static constexpr u32 s_TaskCount = 48u;
+    static constexpr u32 s_MessagesPerTask = 16u;
+    static constexpr u32 s_LeadTask = s_TaskCount;
+    static constexpr u32 s_TrailTask = s_TaskCount + 1u;
+    static constexpr u32 s_DelaySpins = 16u;
+
+    for(u32 i = 0u; i < s_TaskCount; ++i){
+        auto entity = world.createEntity();
+        entity.addComponent<PositionComponent>().x = static_cast<i32>(i);
+    }
+
+    // Every round starts the items after a different shuffle of delays, so threads reach their first post in a
+    // different order each time; the consumed order must not follow it.
+    u32 state = 0x2545F491u;
+    for(u32 round = 0u; round < 4u; ++round){
+        u32 delays[s_TaskCount] = {};
+        for(u32 i = 0u; i < s_TaskCount; ++i)
+            delays[i] = i;
+        for(u32 i = s_TaskCount - 1u; i > 0u; --i){
+            state = state * 1664525u + 1013904223u;
+            Swap(delays[i], delays[(state >> 8u) % (i + 1u)]);
+        }
+
+        world.postMessage(SequencedMessage{ s_LeadTask, 0u });
+        {
+            const NWB::Core::ECS::MessageOrderRegion messageOrder;
+            threadPool.parallelFor(
+                static_cast<usize>(0),
+                static_cast<usize>(s_TaskCount),
+                static_cast<usize>(1),
+                [&world, &delays, &messageOrder](const usize taskIndex){
+                    const NWB::Core::ECS::MessageOrderScope messageScope(messageOrder, taskIndex);
+                    for(u32 spin = 0u; spin < delays[taskIndex] * s_DelaySpins; ++spin)
+                        YieldThread();
+
+                    const u32 task = static_cast<u32>(taskIndex);
+                    for(u32 sequence = 0u; sequence < s_MessagesPerTask; ++sequence)
+                        world.postMessage(SequencedMessage{ task, sequence });
+                }
+            );
+        }
+        world.view<PositionComponent>().parallelEach(
+            threadPool,
+            1u,
+            [&world, &delays](NWB::Core::ECS::EntityID, PositionComponent& position){
+                const u32 task = static_cast<u32>(position.x);
+                for(u32 spin = 0u; spin < delays[task] * s_DelaySpins; ++spin)
+                    YieldThread();
+
+                world.emplaceMessage<MoveOnlyMessage>(task);
+            }
+        );
+        world.postMessage(SequencedMessage{ s_TrailTask, 0u });
+
+        world.swapMessageBuffers();
+        ASSERT_EQ(world.messageCount<SequencedMessage>(), s_TaskCount * s_MessagesPerTask + 2u);
+        ASSERT_EQ(world.messageCount<MoveOnlyMessage>(), s_TaskCount);
+
+        // Posts before the region lead, the region's items follow in index order, and later posts trail.
+        u32 consumed = 0u;
+        world.consumeMessages<SequencedMessage>(
+            [&consumed](const SequencedMessage& message){
+                if(consumed == 0u){
+                    EXPECT_EQ(message.task, s_LeadTask);
+                }
+                else if(consumed == s_TaskCount * s_MessagesPerTask + 1u){
+                    EXPECT_EQ(message.task, s_TrailTask);
+                }
+                else{
+                    const u32 item = consumed - 1u;
+                    EXPECT_EQ(message.task, item / s_MessagesPerTask);
+                    EXPECT_EQ(message.sequence, item % s_MessagesPerTask);
+                }
+                ++consumed;
+            }
+        );
+
+        u32 nextTask = 0u;
+        world.consumeMessages<MoveOnlyMessage>(
+            [&nextTask](const MoveOnlyMessage& message){
+                EXPECT_EQ(message.value, nextTask);
+                ++nextTask;
+            }
+        );
+        EXPECT_EQ(nextTask, s_TaskCount);
+    }
+}
+
 TEST(Ecs, SystemTick){
     TestWorld testWorld;
 
@@ -0,0 +1,264 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Manual CPU contention probe for MessageBus posting. For every posting thread count from one to the core count it
+// posts 65,536 messages per thread through the per-thread segment bus and through a replica of the previous design
+// (a reader-locked channel lookup feeding one shared concurrent queue), then swaps once. It reports min/median/max wall
+// time for the post and swap phases of both, and fails if a swap loses messages or reorders one thread's posts.
+
+
+#include <core/alloc/general.h>
+#include <core/alloc/thread.h>
+#include <core/common/application_entry.h>
+#include <core/common/module.h>
+#include <core/ecs/message_bus.h>
+
+#include <tests/common/profile_timing.h>
+#include <tests/common/test_context.h>
+
+#include <global/cpu_topology.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace MessageBusProfile{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<typename T>
+using Vector = Tests::TestVector<T>;
+
+
+inline constexpr u32 s_MessagesPerThread = 65536u;
+inline constexpr u32 s_MaxPostingThreadCount = 32u;
+inline constexpr u32 s_WarmupCount = 1u;
+inline constexpr u32 s_SampleCount = 9u;
+
+inline constexpr Name s_ProfileArena("tests/unit/ecs/message_bus_profile");
+
+
+struct ProfileMessage{
+    u32 thread = 0u;
+    u32 sequence = 0u;
+    f32 payload[2] = {};
+};
+
+struct BusSamples{
+    Tests::ProfileTimingSamples post;
+    Tests::ProfileTimingSamples swap;
+};
+
+struct ThreadResult{
+    u32 postingThreadCount = 0u;
+    BusSamples segmented;
+    BusSamples shared;
+};
+
+
+// The pre-segment MessageBus path for a single message type: every post takes the channel table's reader lock and
+// pushes into one concurrent queue, and swap drains that queue into the read buffer.
+class SharedQueueChannel : NoCopy{
+public:
+    explicit SharedQueueChannel(Core::Alloc::GlobalArena& arena)
+        : m_pending(arena)
+    {}
+
+
+public:
+    void post(const ProfileMessage& message){
+        SharedMutex::scoped_lock lock(m_channelsMutex, false);
+        m_pending.push(message);
+    }
+
+    void swapBuffers(){
+        m_readBuffer.clear();
+        ProfileMessage message;
+        while(m_pending.try_pop(message))
+            m_readBuffer.push_back(message);
+    }
+
+    template<typename Func>
+    void consume(Func&& func)const{
+        for(const ProfileMessage& message : m_readBuffer)
+            func(message);
+    }
+
+    [[nodiscard]] usize messageCount()const{ return m_readBuffer.size(); }
+
+
+private:
+    SharedMutex m_channelsMutex;
+    ParallelQueue<ProfileMessage, Core::Alloc::GlobalArena> m_pending;
+    Vector<ProfileMessage> m_readBuffer;
+};
+
+class SegmentedChannel : NoCopy{
+public:
+    explicit SegmentedChannel(Core::Alloc::GlobalArena& arena)
+        : m_bus(arena)
+    {}
+
+
+public:
+    void post(const ProfileMessage& message){ m_bus.post(message); }
+    void swapBuffers(){ m_bus.swapBuffers(); }
+
+    template<typename Func>
+    void consume(Func&& func)const{ m_bus.consume<ProfileMessage>(Forward<Func>(func)); }
+
+    [[nodiscard]] usize messageCount()const{ return m_bus.messageCount<ProfileMessage>(); }
+
+
+private:
+    Core::ECS::MessageBus m_bus;
+};
+
+
+// Every message must arrive once and each posting thread's messages in posting order.
+template<typename Channel>
+[[nodiscard]] static bool ValidateSwap(const Channel& channel, const u32 postingThreadCount){
+    if(channel.messageCount() != static_cast<usize>(postingThreadCount) * s_MessagesPerThread)
+        return false;
+
+    u32 nextSequence[s_MaxPostingThreadCount] = {};
+    bool ordered = true;
+    channel.consume([&nextSequence, &ordered, postingThreadCount](const ProfileMessage& message){
+        if(message.thread >= postingThreadCount || message.sequence != nextSequence[message.thread]){
+            ordered = false;
+            return;
+        }
+        ++nextSequence[message.thread];
+    });
+    return ordered;
+}
+
+template<typename Channel>
+[[nodiscard]] static bool Measure(
+    Core::Alloc::GlobalArena& arena,
+    Core::Alloc::ThreadPool& pool,
+    const u32 postingThreadCount,
+    BusSamples& outSamples
+){
+    Channel channel(arena);
+    bool valid = true;
+    for(u32 i = 0u; i < s_WarmupCount + s_SampleCount; ++i){
+        const Timer postBegin = TimerNow();
+        pool.parallelFor(
+            static_cast<usize>(0),
+            static_cast<usize>(postingThreadCount),
+            static_cast<usize>(1),
+            [&channel](const usize threadIndex){
+                ProfileMessage message;
+                message.thread = static_cast<u32>(threadIndex);
+                for(u32 sequence = 0u; sequence < s_MessagesPerThread; ++sequence){
+                    message.sequence = sequence;
+                    message.payload[0] = static_cast<f32>(sequence);
+                    channel.post(message);
+                }
+            }
+        );
+        const Timer swapBegin = TimerNow();
+        channel.swapBuffers();
+        const Timer swapEnd = TimerNow();
+
+        valid = ValidateSwap(channel, postingThreadCount) && valid;
+        if(i < s_WarmupCount)
+            continue;
+        if(!outSamples.post.append(DurationInSeconds<f64>(swapBegin, postBegin)))
+            break;
+        if(!outSamples.swap.append(DurationInSeconds<f64>(swapEnd, swapBegin)))
+            break;
+    }
+    return valid;
+}
+
+[[nodiscard]] static bool RunProfile(Vector<ThreadResult>& outResults){
+    const u32 maxPostingThreadCount = Min(Max(QueryCpuCoreCount(CpuAffinity::Any), 1u), s_MaxPostingThreadCount);
+
+    Core::Alloc::GlobalArena arena(s_ProfileArena);
+    bool valid = true;
+    for(u32 postingThreadCount = 1u; postingThreadCount <= maxPostingThreadCount; ++postingThreadCount){
+        // The calling thread takes part in parallelFor, so one fewer worker gives one posting thread per index.
+        Core::Alloc::ThreadPool pool(postingThreadCount - 1u, CpuAffinity::Any);
+
+        ThreadResult& result = outResults.emplace_back();
+        result.postingThreadCount = postingThreadCount;
+        valid = Measure<SegmentedChannel>(arena, pool, postingThreadCount, result.segmented) && valid;
+        valid = Measure<SharedQueueChannel>(arena, pool, postingThreadCount, result.shared) && valid;
+    }
+    return valid;
+}
+
+static void EmitBus(const char* name, const BusSamples& samples){
+    NWB_COUT << '\"' << name << "\":{";
+    Tests::EmitProfileTiming("post", samples.post);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming("swap", samples.swap);
+    NWB_COUT << '}';
+}
+
+static void EmitResult(const Vector<ThreadResult>& results, const bool valid){
+    NWB_COUT
+        << "{\"status\":\"" << (valid ? "ok" : "failed") << "\","
+        << "\"messages_per_thread\":" << s_MessagesPerThread << ','
+        << "\"message_bytes\":" << sizeof(ProfileMessage) << ','
+        << "\"samples\":" << s_SampleCount << ','
+        << "\"threads\":["
+    ;
+    for(usize i = 0u; i < results.size(); ++i){
+        const ThreadResult& result = results[i];
+        if(i > 0u)
+            NWB_COUT << ',';
+        NWB_COUT << "{\"posting_threads\":" << result.postingThreadCount << ',';
+        EmitBus("segmented", result.segmented);
+        NWB_COUT << ',';
+        EmitBus("shared_queue", result.shared);
+        NWB_COUT << '}';
+    }
+    NWB_COUT << "]}\n";
+}
+
+[[nodiscard]] static int EntryPoint(const isize, tchar**, void*){
+    Core::Common::InitializerGuard commonInitializerGuard;
+    if(!commonInitializerGuard.initialize()){
+        NWB_CERR << "message bus profile initialization failed\n";
+        return 1;
+    }
+
+    Vector<ThreadResult> results;
+    const bool valid = RunProfile(results);
+    EmitResult(results, valid);
+    return valid ? 0 : 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_DEFINE_APPLICATION_ENTRY_POINT(::NWB::MessageBusProfile::EntryPoint)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,195 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Manual throughput probe for World snapshots. It builds a world of 1,048,576 entity slots (every sixteenth destroyed so
+// the free list is exercised) carrying a transform and velocity each and a bounds component on every fourth entity, then
+// times writeSnapshot into a reused buffer and restoreSnapshot into a second world. It reports min/median/max wall
+// time and median MB/s and entities/s for both, and fails if the restored world does not snapshot to identical bytes.
+
+
+#include <core/alloc/general.h>
+#include <core/alloc/thread.h>
+#include <core/common/application_entry.h>
+#include <core/common/module.h>
+#include <core/ecs/module.h>
+
+#include <tests/common/profile_timing.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace WorldSnapshotProfile{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+inline constexpr u32 s_EntitySlotCount = 1u << 20;
+inline constexpr u32 s_DestroyStride = 16u;
+inline constexpr u32 s_BoundsStride = 4u;
+inline constexpr u32 s_WarmupCount = 1u;
+inline constexpr u32 s_SampleCount = 7u;
+
+inline constexpr Name s_ProfileArena("tests/unit/ecs/world_snapshot_profile");
+inline constexpr Name s_TransformName("tests/unit/ecs/world_snapshot_profile/transform");
+inline constexpr Name s_VelocityName("tests/unit/ecs/world_snapshot_profile/velocity");
+inline constexpr Name s_BoundsName("tests/unit/ecs/world_snapshot_profile/bounds");
+
+
+struct ProfileTransform{
+    f32 position[3] = {};
+    f32 rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    f32 scale[3] = { 1.0f, 1.0f, 1.0f };
+};
+
+struct ProfileVelocity{
+    f32 linear[3] = {};
+};
+
+struct ProfileBounds{
+    f32 center[3] = {};
+    f32 radius = 0.0f;
+    u32 flags = 0u;
+};
+
+struct ProfileResult{
+    Tests::ProfileTimingSamples write;
+    Tests::ProfileTimingSamples restore;
+    usize snapshotBytes = 0u;
+    usize entityCount = 0u;
+};
+
+
+static void RegisterComponents(Core::ECS::World& world){
+    world.registerSnapshotComponent<ProfileTransform>(s_TransformName);
+    world.registerSnapshotComponent<ProfileVelocity>(s_VelocityName);
+    world.registerSnapshotComponent<ProfileBounds>(s_BoundsName);
+}
+
+static void PopulateWorld(Core::ECS::World& world){
+    for(u32 i = 0u; i < s_EntitySlotCount; ++i){
+        auto entity = world.createEntity();
+        const f32 value = static_cast<f32>(i);
+
+        ProfileTransform& transform = entity.addComponent<ProfileTransform>();
+        transform.position[0] = value;
+        transform.position[2] = -value;
+        entity.addComponent<ProfileVelocity>().linear[1] = value * 0.5f;
+        if(i % s_BoundsStride == 0u){
+            ProfileBounds& bounds = entity.addComponent<ProfileBounds>();
+            bounds.radius = value;
+            bounds.flags = i;
+        }
+    }
+    for(u32 i = 0u; i < s_EntitySlotCount; i += s_DestroyStride)
+        world.destroyEntity(Core::ECS::EntityID(i, 0u));
+}
+
+[[nodiscard]] static BinaryByteView SnapshotView(const Core::ECS::WorldSnapshotBytes& bytes){
+    return BinaryByteView{ bytes.data(), bytes.size() };
+}
+
+[[nodiscard]] static bool RunProfile(ProfileResult& outResult){
+    Core::Alloc::GlobalArena arena(s_ProfileArena);
+    Core::Alloc::ThreadPool pool(0u);
+
+    Core::ECS::World source(arena, pool);
+    Core::ECS::World restored(arena, pool);
+    RegisterComponents(source);
+    RegisterComponents(restored);
+    PopulateWorld(source);
+
+    Core::ECS::WorldSnapshotBytes sourceBytes(arena);
+    Core::ECS::WorldSnapshotBytes restoredBytes(arena);
+    for(u32 i = 0u; i < s_WarmupCount + s_SampleCount; ++i){
+        const Timer writeBegin = TimerNow();
+        const bool written = source.writeSnapshot(sourceBytes);
+        const Timer restoreBegin = TimerNow();
+        const bool restoredValid = restored.restoreSnapshot(SnapshotView(sourceBytes));
+        const Timer restoreEnd = TimerNow();
+        if(!written || !restoredValid)
+            return false;
+
+        if(i < s_WarmupCount)
+            continue;
+        if(!outResult.write.append(DurationInSeconds<f64>(restoreBegin, writeBegin)))
+            break;
+        if(!outResult.restore.append(DurationInSeconds<f64>(restoreEnd, restoreBegin)))
+            break;
+    }
+
+    outResult.snapshotBytes = sourceBytes.size();
+    outResult.entityCount = restored.entityCount();
+    if(!restored.writeSnapshot(restoredBytes) || restoredBytes.size() != sourceBytes.size())
+        return false;
+    return NWB_MEMCMP(restoredBytes.data(), sourceBytes.data(), sourceBytes.size()) == 0;
+}
+
+static void EmitThroughput(const char* name, const Tests::ProfileTimingSamples& samples, const ProfileResult& result){
+    const f64 seconds = Tests::SummarizeProfileTiming(samples).median;
+    const f64 megabytes = static_cast<f64>(result.snapshotBytes) / (1024.0 * 1024.0);
+    NWB_COUT << '\"' << name << "\":{";
+    Tests::EmitProfileTiming("time", samples);
+    NWB_COUT
+        << ",\"median_mb_per_s\":" << (seconds > 0.0 ? megabytes / seconds : 0.0)
+        << ",\"median_entities_per_s\":" << (seconds > 0.0 ? static_cast<f64>(result.entityCount) / seconds : 0.0)
+        << '}'
+    ;
+}
+
+static void EmitResult(const ProfileResult& result, const bool valid){
+    NWB_COUT
+        << "{\"status\":\"" << (valid ? "ok" : "failed") << "\","
+        << "\"entity_slots\":" << s_EntitySlotCount << ','
+        << "\"entities\":" << result.entityCount << ','
+        << "\"snapshot_bytes\":" << result.snapshotBytes << ','
+        << "\"samples\":" << s_SampleCount << ','
+    ;
+    EmitThroughput("write", result.write, result);
+    NWB_COUT << ',';
+    EmitThroughput("restore", result.restore, result);
+    NWB_COUT << "}\n";
+}
+
+[[nodiscard]] static int EntryPoint(const isize, tchar**, void*){
+    Core::Common::InitializerGuard commonInitializerGuard;
+    if(!commonInitializerGuard.initialize()){
+        NWB_CERR << "world snapshot profile initialization failed\n";
+        return 1;
+    }
+
+    ProfileResult result;
+    const bool valid = RunProfile(result);
+    EmitResult(result, valid);
+    return valid ? 0 : 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_DEFINE_APPLICATION_ENTRY_POINT(::NWB::WorldSnapshotProfile::EntryPoint)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,219 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Manual CPU probe for AnimationSystem sampling. It drives 1,000 skeletons of 100 joints, each blending two looping
+// clips, through AnimationSystem::update on an inline (zero worker) pool and on a pool with one worker per core,
+// reports min/median/max wall time per frame, and fails if the two runs produce different poses.
+
+
+#include <core/alloc/general.h>
+#include <core/alloc/thread.h>
+#include <core/common/application_entry.h>
+#include <core/common/module.h>
+#include <core/ecs/module.h>
+#include <impl/ecs_animation/system.h>
+#include <impl/ecs_skeleton/components.h>
+
+#include <tests/common/animation_test_assets.h>
+#include <tests/common/profile_timing.h>
+#include <tests/common/test_context.h>
+
+#include <global/cpu_topology.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace AnimationSamplingProfile{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<typename T>
+using Vector = Tests::TestVector<T>;
+
+
+inline constexpr u32 s_SkeletonCount = 1000u;
+inline constexpr u32 s_JointCount = 100u;
+inline constexpr u32 s_ClipFrameCount = 61u;
+inline constexpr u32 s_WarmupCount = 2u;
+inline constexpr u32 s_SampleCount = 31u;
+inline constexpr f32 s_FrameDelta = 1.0f / 60.0f;
+
+inline constexpr Name s_ProfileArena("tests/unit/ecs_graphics/animation_sampling_profile");
+inline constexpr Name s_SkeletonName("profile/animation/skeleton");
+inline constexpr Name s_WalkClipName("profile/animation/walk");
+inline constexpr Name s_RunClipName("profile/animation/run");
+
+inline constexpr Tests::AnimationTestSkeletonDesc s_Skeletons[] = {
+    { s_SkeletonName, s_JointCount },
+};
+inline constexpr Tests::AnimationTestClipDesc s_Clips[] = {
+    { s_WalkClipName, s_SkeletonName, s_ClipFrameCount, 0.0f, 0.6f },
+    { s_RunClipName, s_SkeletonName, s_ClipFrameCount, 0.1f, 0.9f },
+};
+
+
+struct ProfileWorld{
+    Core::Alloc::GlobalArena arena;
+    Core::Alloc::ThreadPool threadPool;
+    Core::ECS::World world;
+    Core::Assets::AssetRegistry registry;
+    Tests::AnimationTestBinarySource binarySource;
+    Core::Assets::AssetManager assetManager;
+    Impl::AnimationSystem& animationSystem;
+    Vector<Core::ECS::EntityID> owners;
+
+    explicit ProfileWorld(const u32 workerCount)
+        : arena(s_ProfileArena)
+        , threadPool(workerCount, CpuAffinity::Any)
+        , world(arena, threadPool)
+        , registry(arena)
+        , assetManager(arena, registry, binarySource)
+        , animationSystem(world.addSystem<Impl::AnimationSystem>(world, assetManager))
+    {}
+};
+
+struct Result{
+    u32 workerCount = 0u;
+    bool ready = false;
+    Tests::ProfileTimingSamples serial;
+    Tests::ProfileTimingSamples parallel;
+};
+
+
+[[nodiscard]] static bool PopulateWorld(ProfileWorld& profileWorld){
+    if(
+        !profileWorld.registry.registerCodec(MakeUnique<Tests::AnimationTestSkeletonCodec>(s_Skeletons, LengthOf(s_Skeletons)))
+        || !profileWorld.registry.registerCodec(MakeUnique<Tests::AnimationTestClipCodec>(s_Clips, LengthOf(s_Clips), s_JointCount))
+    )
+        return false;
+
+    profileWorld.owners.reserve(s_SkeletonCount);
+    for(u32 skeletonIndex = 0u; skeletonIndex < s_SkeletonCount; ++skeletonIndex){
+        auto entity = profileWorld.world.createEntity();
+        auto& player = entity.addComponent<Impl::AnimationPlayerComponent>();
+        // Stagger start times and blend weights so neighbouring skeletons decode different key pairs.
+        const f32 phase = static_cast<f32>(skeletonIndex % 97u) / 97.0f;
+        player.layers[0].clip.virtualPath = s_WalkClipName;
+        player.layers[0].time = phase;
+        player.layers[0].weight = 1.0f - 0.5f * phase;
+        player.layers[1].clip.virtualPath = s_RunClipName;
+        player.layers[1].time = 1.0f - phase;
+        player.layers[1].speed = 1.25f;
+        player.layers[1].weight = 0.5f + 0.5f * phase;
+        player.layerCount = 2u;
+
+        auto& pose = entity.addComponent<Impl::SkeletonPoseComponent>(profileWorld.arena);
+        pose.localJoints.resize(s_JointCount, Float34Identity());
+        profileWorld.owners.push_back(entity.id());
+    }
+
+    profileWorld.animationSystem.syncClipLoads();
+    return profileWorld.animationSystem.clipReady(s_WalkClipName) && profileWorld.animationSystem.clipReady(s_RunClipName);
+}
+
+static void Measure(ProfileWorld& profileWorld, Tests::ProfileTimingSamples& outSamples){
+    for(u32 i = 0u; i < s_WarmupCount; ++i)
+        profileWorld.world.tick(s_FrameDelta);
+    for(u32 i = 0u; i < s_SampleCount; ++i){
+        const Timer begin = TimerNow();
+        profileWorld.world.tick(s_FrameDelta);
+        if(!outSamples.append(DurationInSeconds<f64>(TimerNow(), begin)))
+            break;
+    }
+}
+
+[[nodiscard]] static bool PosesMatch(ProfileWorld& lhs, ProfileWorld& rhs){
+    for(u32 skeletonIndex = 0u; skeletonIndex < s_SkeletonCount; ++skeletonIndex){
+        const auto& lhsPose = lhs.world.entity(lhs.owners[skeletonIndex]).getComponent<Impl::SkeletonPoseComponent>();
+        const auto& rhsPose = rhs.world.entity(rhs.owners[skeletonIndex]).getComponent<Impl::SkeletonPoseComponent>();
+        for(u32 jointIndex = 0u; jointIndex < s_JointCount; ++jointIndex){
+            const Float34& lhsJoint = lhsPose.localJoints[jointIndex];
+            const Float34& rhsJoint = rhsPose.localJoints[jointIndex];
+            for(u32 row = 0u; row < 3u; ++row){
+                for(u32 column = 0u; column < 4u; ++column){
+                    if(lhsJoint.m[row][column] != rhsJoint.m[row][column])
+                        return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+[[nodiscard]] static bool RunProfile(Result& outResult){
+    outResult.workerCount = Max(QueryCpuCoreCount(CpuAffinity::Any), 1u);
+
+    ProfileWorld serialWorld(0u);
+    ProfileWorld parallelWorld(outResult.workerCount);
+    outResult.ready = PopulateWorld(serialWorld) && PopulateWorld(parallelWorld);
+    if(!outResult.ready)
+        return false;
+
+    Measure(serialWorld, outResult.serial);
+    Measure(parallelWorld, outResult.parallel);
+    return PosesMatch(serialWorld, parallelWorld);
+}
+
+static void EmitResult(const Result& result, const bool matched){
+    NWB_COUT
+        << "{\"status\":\"" << (matched ? "ok" : "failed") << "\","
+        << "\"lanes\":" << QuaternionBatch::s_LaneCount << ','
+        << "\"skeletons\":" << s_SkeletonCount << ','
+        << "\"joints\":" << s_JointCount << ','
+        << "\"workers\":" << result.workerCount << ','
+        << "\"samples\":" << s_SampleCount << ','
+    ;
+    Tests::EmitProfileTiming("serial", result.serial);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming("parallel", result.parallel);
+    NWB_COUT << "}\n";
+}
+
+[[nodiscard]] static int EntryPoint(const isize, tchar**, void*){
+    Core::Common::InitializerGuard commonInitializerGuard;
+    if(!commonInitializerGuard.initialize()){
+        NWB_CERR << "animation sampling profile initialization failed\n";
+        return 1;
+    }
+
+    Result result;
+    const bool matched = RunProfile(result);
+    if(!result.ready){
+        NWB_CERR << "animation sampling profile failed to load its clips\n";
+        return 1;
+    }
+    EmitResult(result, matched);
+    return matched ? 0 : 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_DEFINE_APPLICATION_ENTRY_POINT(::NWB::AnimationSamplingProfile::EntryPoint)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,208 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <tests/common/animation_test_assets.h>
+#include <tests/common/capturing_logger.h>
+#include <tests/common/ecs_test_world.h>
+#include <gtest/gtest.h>
+
+#include <core/assets/manager.h>
+#include <core/ecs/module.h>
+#include <impl/ecs_animation/system.h>
+#include <impl/ecs_skeleton/components.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_animation_system_tests{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+using TestWorld = NWB::Tests::EcsTestWorld;
+using CapturingLogger = NWB::Tests::CapturingLogger;
+
+inline constexpr u32 s_AnimationJointCount = 3u;
+inline constexpr f32 s_AnimationFrameDelta = 1.0f / NWB::Tests::s_AnimationTestFrameRate;
+inline constexpr f32 s_AnimationRotationEpsilon = 0.00001f;
+inline constexpr f32 s_AnimationTranslationEpsilon = 0.0001f;
+
+inline constexpr Name s_AnimationSkeletonName("tests/animation_system/skeleton");
+inline constexpr Name s_AnimationWaveClipName("tests/animation_system/wave");
+inline constexpr Name s_AnimationLowClipName("tests/animation_system/low");
+inline constexpr Name s_AnimationHighClipName("tests/animation_system/high");
+inline constexpr Name s_AnimationMissingClipName("tests/animation_system/missing");
+
+inline constexpr NWB::Tests::AnimationTestSkeletonDesc s_AnimationSkeletons[] = {
+    { s_AnimationSkeletonName, s_AnimationJointCount },
+};
+inline constexpr NWB::Tests::AnimationTestClipDesc s_AnimationClips[] = {
+    { s_AnimationWaveClipName, s_AnimationSkeletonName, 31u, 0.0f, 0.8f },
+    { s_AnimationLowClipName, s_AnimationSkeletonName, 2u, 0.2f, 0.0f },
+    { s_AnimationHighClipName, s_AnimationSkeletonName, 2u, 0.6f, 0.0f },
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+struct AnimationSystemFixture{
+    TestWorld testWorld;
+    NWB::Core::Assets::AssetRegistry registry;
+    NWB::Tests::AnimationTestBinarySource binarySource;
+    NWB::Core::Assets::AssetManager assetManager;
+    NWB::Impl::AnimationSystem& animationSystem;
+
+    AnimationSystemFixture()
+        : registry(testWorld.arena)
+        , assetManager(testWorld.arena, registry, binarySource)
+        , animationSystem(testWorld.world.addSystem<NWB::Impl::AnimationSystem>(testWorld.world, assetManager))
+    {
+        EXPECT_TRUE(registry.registerCodec(MakeUnique<NWB::Tests::AnimationTestSkeletonCodec>(
+            s_AnimationSkeletons,
+            LengthOf(s_AnimationSkeletons)
+        )));
+        EXPECT_TRUE(registry.registerCodec(MakeUnique<NWB::Tests::AnimationTestClipCodec>(
+            s_AnimationClips,
+            LengthOf(s_AnimationClips),
+            s_AnimationJointCount
+        )));
+    }
+};
+
+
+[[nodiscard]] static NWB::Core::ECS::EntityID AddAnimatedSkeleton(
+    AnimationSystemFixture& fixture,
+    const Name& clipName,
+    const u32 jointCount = s_AnimationJointCount
+){
+    auto entity = fixture.testWorld.world.createEntity();
+    auto& player = entity.addComponent<NWB::Impl::AnimationPlayerComponent>();
+    player.layers[0].clip.virtualPath = clipName;
+    player.layerCount = 1u;
+
+    auto& pose = entity.addComponent<NWB::Impl::SkeletonPoseComponent>(fixture.testWorld.arena);
+    pose.localJoints.resize(jointCount, Float34Identity());
+    return entity.id();
+}
+
+[[nodiscard]] static Float4 MakeYRotation(const f32 angle){
+    return Float4(0.0f, Sin(0.5f * angle), 0.0f, Cos(0.5f * angle));
+}
+
+[[nodiscard]] static bool JointRotationNear(const NWB::Impl::SkeletonJointMatrix& joint, const Float4& expected){
+    SIMDVector scale;
+    SIMDVector rotation;
+    SIMDVector translation;
+    if(!MatrixDecompose(&scale, &rotation, &translation, LoadFloat(joint)))
+        return false;
+
+    const f32 dot = Abs(VectorGetX(Vector4Dot(rotation, LoadFloat(expected))));
+    return dot >= 1.0f - s_AnimationRotationEpsilon;
+}
+
+[[nodiscard]] static f32 JointTranslationY(const NWB::Impl::SkeletonJointMatrix& joint){
+    SIMDVector scale;
+    SIMDVector rotation;
+    SIMDVector translation;
+    if(!MatrixDecompose(&scale, &rotation, &translation, LoadFloat(joint)))
+        return Limit<f32>::s_Max;
+    return VectorGetY(translation);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TEST(AnimationSystem, SamplesClipIntoLocalJoints){
+    AnimationSystemFixture fixture;
+    const NWB::Core::ECS::EntityID owner = AddAnimatedSkeleton(fixture, s_AnimationWaveClipName);
+
+    fixture.animationSystem.syncClipLoads();
+    ASSERT_TRUE(fixture.animationSystem.clipReady(s_AnimationWaveClipName));
+
+    fixture.testWorld.world.tick(2.0f * s_AnimationFrameDelta);
+    const auto& pose = fixture.testWorld.world.entity(owner).getComponent<NWB::Impl::SkeletonPoseComponent>();
+    for(u32 jointIndex = 0u; jointIndex < s_AnimationJointCount; ++jointIndex){
+        const f32 angle = NWB::Tests::AnimationTestJointAngle(s_AnimationClips[0], 2.0f, jointIndex);
+        EXPECT_TRUE(JointRotationNear(pose.localJoints[jointIndex], MakeYRotation(angle))) << "joint " << jointIndex;
+
+        // The clip has no translation keys, so the skeleton bind pose supplies them.
+        const Float3U bindTranslation = NWB::Tests::AnimationTestJointTranslation(jointIndex);
+        EXPECT_NEAR(JointTranslationY(pose.localJoints[jointIndex]), bindTranslation.y, s_AnimationTranslationEpsilon) << "joint " << jointIndex;
+    }
+}
+
+TEST(AnimationSystem, BlendsLayersByNormalizedWeight){
+    AnimationSystemFixture fixture;
+    const NWB::Core::ECS::EntityID owner = AddAnimatedSkeleton(fixture, s_AnimationLowClipName);
+    auto& player = fixture.testWorld.world.entity(owner).getComponent<NWB::Impl::AnimationPlayerComponent>();
+    player.layers[0].weight = 1.0f;
+    player.layers[1].clip.virtualPath = s_AnimationHighClipName;
+    player.layers[1].weight = 3.0f;
+    player.layerCount = 2u;
+
+    fixture.animationSystem.syncClipLoads();
+    fixture.testWorld.world.tick(0.0f);
+
+    const Float4 low = MakeYRotation(s_AnimationClips[1].offset);
+    const Float4 high = MakeYRotation(s_AnimationClips[2].offset);
+    Float4 expected;
+    StoreFloat(
+        QuaternionNormalize(VectorAdd(VectorScale(LoadFloat(low), 0.25f), VectorScale(LoadFloat(high), 0.75f))),
+        &expected
+    );
+    const auto& pose = fixture.testWorld.world.entity(owner).getComponent<NWB::Impl::SkeletonPoseComponent>();
+    for(u32 jointIndex = 0u; jointIndex < s_AnimationJointCount; ++jointIndex)
+        EXPECT_TRUE(JointRotationNear(pose.localJoints[jointIndex], expected)) << "joint " << jointIndex;
+}
+
+TEST(AnimationSystem, LoopingLayersWrapAndOneShotLayersClamp){
+    AnimationSystemFixture fixture;
+    const NWB::Core::ECS::EntityID looping = AddAnimatedSkeleton(fixture, s_AnimationWaveClipName);
+    const NWB::Core::ECS::EntityID oneShot = AddAnimatedSkeleton(fixture, s_AnimationWaveClipName);
+    fixture.testWorld.world.entity(oneShot).getComponent<NWB::Impl::AnimationPlayerComponent>().layers[0].loop = false;
+
+    fixture.animationSystem.syncClipLoads();
+    // The wave clip spans 30 frame intervals, one second at the test frame rate.
+    fixture.testWorld.world.tick(1.25f);
+
+    const auto& loopingPlayer = fixture.testWorld.world.entity(looping).getComponent<NWB::Impl::AnimationPlayerComponent>();
+    const auto& oneShotPlayer = fixture.testWorld.world.entity(oneShot).getComponent<NWB::Impl::AnimationPlayerComponent>();
+    EXPECT_NEAR(loopingPlayer.layers[0].time, 0.25f, s_AnimationTranslationEpsilon);
+    EXPECT_NEAR(oneShotPlayer.layers[0].time, 1.0f, s_AnimationTranslationEpsilon);
+}
+
+TEST(AnimationSystem, LeavesPoseUntouchedWhenClipCannotBind){
+    CapturingLogger logger;
+    NWB::Core::Common::LoggerRegistrationGuard loggerRegistrationGuard(logger);
+
+    AnimationSystemFixture fixture;
+    const NWB::Core::ECS::EntityID missing = AddAnimatedSkeleton(fixture, s_AnimationMissingClipName);
+    const NWB::Core::ECS::EntityID mismatched = AddAnimatedSkeleton(fixture, s_AnimationWaveClipName, s_AnimationJointCount + 1u);
+
+    fixture.animationSystem.syncClipLoads();
+    EXPECT_FALSE(fixture.animationSystem.clipReady(s_AnimationMissingClipName));
+    EXPECT_TRUE(fixture.animationSystem.clipReady(s_AnimationWaveClipName));
+    EXPECT_TRUE(logger.sawErrorContaining(NWB_TEXT("tests/animation_system/missing")));
+
+    fixture.testWorld.world.tick(s_AnimationFrameDelta);
+    for(const NWB::Core::ECS::EntityID owner : { missing, mismatched }){
+        const auto& pose = fixture.testWorld.world.entity(owner).getComponent<NWB::Impl::SkeletonPoseComponent>();
+        for(const NWB::Impl::SkeletonJointMatrix& joint : pose.localJoints)
+            EXPECT_TRUE(JointRotationNear(joint, Float4(0.0f, 0.0f, 0.0f, 1.0f)));
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,300 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <tests/common/ecs_test_world.h>
+#include <gtest/gtest.h>
+
+#include <core/assets/manager.h>
+#include <core/ecs/module.h>
+#include <impl/assets_model/asset.h>
+#include <impl/ecs_mesh/components.h>
+#include <impl/ecs_model/system.h>
+#include <impl/ecs_scene/module.h>
+
+#include <global/timer.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_model_system_tests{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+using TestWorld = NWB::Tests::EcsTestWorld;
+using TransformComponent = NWB::Impl::Scene::TransformComponent;
+using TransformParentComponent = NWB::Impl::Scene::TransformParentComponent;
+using WorldTransformComponent = NWB::Impl::Scene::WorldTransformComponent;
+
+inline constexpr u32 s_ModelOwnerCount = 1000u;
+inline constexpr u32 s_ModelSpawnBudget = 32u;
+inline constexpr u32 s_ModelObjectCount = 2u;
+inline constexpr u32 s_MaxModelSpawnFrames = 256u;
+inline constexpr f32 s_ModelFrameDelta = 1.0f / 60.0f;
+inline constexpr f32 s_TransformEpsilon = 0.0001f;
+
+inline constexpr Name s_ModelNames[] = {
+    "tests/model_system/model_a",
+    "tests/model_system/model_b",
+    "tests/model_system/model_c",
+    "tests/model_system/model_d",
+};
+inline constexpr Name s_MissingModelName("tests/model_system/missing");
+inline constexpr Name s_ModelObjectNames[s_ModelObjectCount] = {
+    "body",
+    "prop",
+};
+inline constexpr Name s_ModelMeshName("tests/model_system/mesh");
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class CountingBinarySource final : public NWB::Core::Assets::IAssetBinarySource{
+public:
+    virtual bool readAssetBinary(const Name& virtualPath, NWB::Core::Assets::AssetBytes& outBinary)const override{
+        ++readCount;
+        if(virtualPath == s_MissingModelName)
+            return false;
+
+        outBinary.push_back(0u);
+        return true;
+    }
+
+
+public:
+    mutable u32 readCount = 0u;
+};
+
+// Builds every model in memory with the same static mesh objects so the test does not depend on cooked payloads.
+class TestModelCodec final : public NWB::Core::Assets::IAssetCodec{
+public:
+    TestModelCodec()
+        : NWB::Core::Assets::IAssetCodec(NWB::Impl::Model::AssetTypeName())
+    {}
+
+
+public:
+    virtual bool deserialize(
+        NWB::Core::Assets::AssetArena& arena,
+        const Name& virtualPath,
+        const NWB::Core::Assets::AssetBytes& binary,
+        UniquePtr<NWB::Core::Assets::IAsset>& outAsset
+    )const override{
+        static_cast<void>(binary);
+
+        auto model = MakeUnique<NWB::Impl::Model>(arena, virtualPath);
+        NWB::Impl::Model::StaticMeshObjectVector staticMeshObjects(arena);
+        for(const Name& objectName : s_ModelObjectNames){
+            NWB::Impl::ModelStaticMeshObject object;
+            object.name = objectName;
+            object.mesh.virtualPath = s_ModelMeshName;
+            staticMeshObjects.push_back(object);
+        }
+        model->setObjects(
+            NWB::Impl::Model::SkeletonObjectVector(arena),
+            Move(staticMeshObjects),
+            NWB::Impl::Model::SkinnedMeshObjectVector(arena)
+        );
+        outAsset = Move(model);
+        return true;
+    }
+
+#if defined(NWB_COOK)
+    virtual bool serialize(const NWB::Core::Assets::IAsset& asset, NWB::Core::Assets::AssetBytes& outBinary)const override{
+        static_cast<void>(asset);
+        static_cast<void>(outBinary);
+        return false;
+    }
+#endif
+};
+
+struct ModelSystemFixture{
+    TestWorld testWorld;
+    NWB::Core::Assets::AssetRegistry registry;
+    CountingBinarySource binarySource;
+    NWB::Core::Assets::AssetManager assetManager;
+    NWB::Impl::ModelSystem& modelSystem;
+    NWB::Impl::Scene::TransformHierarchySystem& transformHierarchy;
+
+    ModelSystemFixture()
+        : registry(testWorld.arena)
+        , assetManager(testWorld.arena, registry, binarySource)
+        , modelSystem(testWorld.world.addSystem<NWB::Impl::ModelSystem>(testWorld.world, assetManager))
+        , transformHierarchy(testWorld.world.addSystem<NWB::Impl::Scene::TransformHierarchySystem>(testWorld.world))
+    {
+        EXPECT_TRUE(registry.registerCodec(MakeUnique<TestModelCodec>()));
+    }
+};
+
+
+[[nodiscard]] static NWB::Core::ECS::EntityID AddModelOwner(NWB::Core::ECS::World& world, const Name& modelName){
+    auto entity = world.createEntity();
+    entity.addComponent<NWB::Impl::ModelComponent>().model.virtualPath = modelName;
+    return entity.id();
+}
+
+[[nodiscard]] static usize CountSpawnedOwners(NWB::Core::ECS::World& world){
+    usize spawnedCount = 0u;
+    world.view<NWB::Impl::ModelRuntimeComponent>().each(
+        [&](const NWB::Core::ECS::EntityID entity, NWB::Impl::ModelRuntimeComponent& runtime){
+            static_cast<void>(entity);
+            if(runtime.model)
+                ++spawnedCount;
+        }
+    );
+    return spawnedCount;
+}
+
+[[nodiscard]] static usize CountModelObjects(NWB::Core::ECS::World& world){
+    usize objectCount = 0u;
+    world.view<NWB::Impl::ModelObjectComponent, NWB::Impl::MeshComponent>().each(
+        [&](const NWB::Core::ECS::EntityID entity, NWB::Impl::ModelObjectComponent& object, NWB::Impl::MeshComponent& mesh){
+            static_cast<void>(entity);
+            static_cast<void>(object);
+            if(mesh.mesh.name() == s_ModelMeshName)
+                ++objectCount;
+        }
+    );
+    return objectCount;
+}
+
+static void ExpectObjectsAt(NWB::Core::ECS::World& world, const NWB::Core::ECS::EntityID owner, const Float4& position){
+    usize objectCount = 0u;
+    world.view<NWB::Impl::ModelObjectComponent, TransformParentComponent, TransformComponent>().each(
+        [&](const NWB::Core::ECS::EntityID entity, NWB::Impl::ModelObjectComponent& object, TransformParentComponent& node, TransformComponent& transform){
+            static_cast<void>(entity);
+            if(object.owner != owner)
+                return;
+
+            ++objectCount;
+            EXPECT_EQ(node.parent, owner);
+            EXPECT_NEAR(transform.position.x, position.x, s_TransformEpsilon);
+            EXPECT_NEAR(transform.position.y, position.y, s_TransformEpsilon);
+            EXPECT_NEAR(transform.position.z, position.z, s_TransformEpsilon);
+        }
+    );
+    EXPECT_EQ(objectCount, static_cast<usize>(s_ModelObjectCount));
+}
+
+[[nodiscard]] static u64 MaxObjectVersion(NWB::Core::ECS::World& world){
+    u64 version = 0u;
+    world.view<NWB::Impl::ModelObjectComponent, WorldTransformComponent>().each(
+        [&](const NWB::Core::ECS::EntityID entity, NWB::Impl::ModelObjectComponent& object, WorldTransformComponent& worldTransform){
+            static_cast<void>(entity);
+            static_cast<void>(object);
+            version = Max(version, worldTransform.version);
+        }
+    );
+    return version;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TEST(ModelSystem, AsyncSpawnStaysWithinFrameBudget){
+    ModelSystemFixture fixture;
+    fixture.modelSystem.setSpawnBudget(s_ModelSpawnBudget);
+    for(u32 i = 0u; i < s_ModelOwnerCount; ++i)
+        EXPECT_TRUE(AddModelOwner(fixture.testWorld.world, s_ModelNames[i % LengthOf(s_ModelNames)]).valid());
+
+    // The first frame only enqueues loads; nothing may spawn before the assets are resident.
+    fixture.testWorld.world.tick(s_ModelFrameDelta);
+    EXPECT_EQ(CountSpawnedOwners(fixture.testWorld.world), 0u);
+    EXPECT_EQ(fixture.modelSystem.pendingSpawnCount(), static_cast<usize>(s_ModelOwnerCount));
+
+    u32 frameCount = 1u;
+    usize spawnedCount = 0u;
+    f64 worstFrameSeconds = 0.0;
+    while(spawnedCount < s_ModelOwnerCount && frameCount < s_MaxModelSpawnFrames){
+        const Timer frameBegin = TimerNow();
+        fixture.testWorld.world.tick(s_ModelFrameDelta);
+        const f64 frameSeconds = DurationInSeconds<f64>(TimerNow(), frameBegin);
+        worstFrameSeconds = Max(worstFrameSeconds, frameSeconds);
+        ++frameCount;
+
+        const usize frameSpawnedCount = CountSpawnedOwners(fixture.testWorld.world);
+        EXPECT_LE(frameSpawnedCount - spawnedCount, static_cast<usize>(s_ModelSpawnBudget));
+        spawnedCount = frameSpawnedCount;
+    }
+    RecordProperty("model_spawn_frames", static_cast<int>(frameCount));
+    RecordProperty("model_spawn_worst_frame_us", static_cast<int>(worstFrameSeconds * 1000000.0));
+
+    EXPECT_EQ(spawnedCount, static_cast<usize>(s_ModelOwnerCount));
+    EXPECT_GE(frameCount, s_ModelOwnerCount / s_ModelSpawnBudget);
+    EXPECT_EQ(fixture.modelSystem.pendingSpawnCount(), 0u);
+    EXPECT_EQ(CountModelObjects(fixture.testWorld.world), static_cast<usize>(s_ModelOwnerCount * s_ModelObjectCount));
+    EXPECT_EQ(fixture.binarySource.readCount, static_cast<u32>(LengthOf(s_ModelNames)));
+    EXPECT_EQ(fixture.assetManager.pendingRequestCount(), 0u);
+    EXPECT_EQ(fixture.assetManager.completedRequestCount(), 0u);
+}
+
+TEST(ModelSystem, SyncModelRuntimesExpandsEveryOwner){
+    ModelSystemFixture fixture;
+    fixture.modelSystem.setSpawnBudget(1u);
+    for(u32 i = 0u; i < LengthOf(s_ModelNames) * 4u; ++i)
+        EXPECT_TRUE(AddModelOwner(fixture.testWorld.world, s_ModelNames[i % LengthOf(s_ModelNames)]).valid());
+
+    fixture.modelSystem.syncModelRuntimes();
+    EXPECT_EQ(CountSpawnedOwners(fixture.testWorld.world), LengthOf(s_ModelNames) * 4u);
+    EXPECT_EQ(CountModelObjects(fixture.testWorld.world), LengthOf(s_ModelNames) * 4u * s_ModelObjectCount);
+    EXPECT_EQ(fixture.modelSystem.pendingSpawnCount(), 0u);
+}
+
+TEST(ModelSystem, ObjectsFollowOwnerThroughTransformHierarchy){
+    ModelSystemFixture fixture;
+    NWB::Core::ECS::World& world = fixture.testWorld.world;
+    const NWB::Core::ECS::EntityID owner = AddModelOwner(world, s_ModelNames[0]);
+    world.entity(owner).addComponent<TransformComponent>().position = Float4(1.0f, 2.0f, 3.0f);
+
+    fixture.modelSystem.syncModelRuntimes();
+    world.tick(s_ModelFrameDelta);
+    ExpectObjectsAt(world, owner, Float4(1.0f, 2.0f, 3.0f));
+
+    // A still owner leaves every object's world transform, and therefore its change version, untouched.
+    const u64 settledVersion = MaxObjectVersion(world);
+    EXPECT_NE(settledVersion, 0u);
+    world.tick(s_ModelFrameDelta);
+    EXPECT_EQ(MaxObjectVersion(world), settledVersion);
+
+    world.entity(owner).getComponent<TransformComponent>().position = Float4(4.0f, 5.0f, 6.0f);
+    world.tick(s_ModelFrameDelta);
+    ExpectObjectsAt(world, owner, Float4(4.0f, 5.0f, 6.0f));
+    EXPECT_GT(MaxObjectVersion(world), settledVersion);
+    EXPECT_EQ(MaxObjectVersion(world), fixture.transformHierarchy.changeVersion());
+}
+
+TEST(ModelSystem, FailedModelLoadIsNotRequestedEveryFrame){
+    ModelSystemFixture fixture;
+    const NWB::Core::ECS::EntityID owner = AddModelOwner(fixture.testWorld.world, s_MissingModelName);
+
+    for(u32 i = 0u; i < 8u; ++i)
+        fixture.testWorld.world.tick(s_ModelFrameDelta);
+
+    EXPECT_EQ(fixture.binarySource.readCount, 1u);
+    EXPECT_EQ(CountSpawnedOwners(fixture.testWorld.world), 0u);
+    EXPECT_EQ(fixture.modelSystem.pendingSpawnCount(), 0u);
+    const auto* pending = fixture.testWorld.world.tryGetComponent<NWB::Impl::ModelPendingSpawnComponent>(owner);
+    ASSERT_NE(pending, nullptr);
+    EXPECT_TRUE(pending->failed);
+
+    fixture.testWorld.world.entity(owner).getComponent<NWB::Impl::ModelComponent>().model.virtualPath = s_ModelNames[0];
+    for(u32 i = 0u; i < 4u; ++i)
+        fixture.testWorld.world.tick(s_ModelFrameDelta);
+    EXPECT_EQ(CountSpawnedOwners(fixture.testWorld.world), 1u);
+    EXPECT_EQ(fixture.testWorld.world.tryGetComponent<NWB::Impl::ModelPendingSpawnComponent>(owner), nullptr);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
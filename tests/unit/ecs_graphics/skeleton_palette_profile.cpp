@@ -0,0 +1,233 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Manual CPU probe for joint palette evaluation. It resolves 1,000 skeletons of 100 joints with the per-joint
+// BuildStoredJointPaletteFromSkeletonPose path, then with SkeletonPaletteSystem on an inline (zero worker) pool and on
+// a pool with one worker per core, plus a pass where no pose revision changes. It reports min/median/max wall time
+// per frame and fails if the batched palettes disagree with the per-joint ones.
+
+
+#include <core/alloc/general.h>
+#include <core/alloc/thread.h>
+#include <core/common/application_entry.h>
+#include <core/common/module.h>
+#include <core/ecs/module.h>
+#include <impl/ecs_skeleton/module.h>
+
+#include <tests/common/profile_timing.h>
+#include <tests/common/test_context.h>
+
+#include <global/cpu_topology.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace SkeletonPaletteProfile{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<typename T>
+using Vector = Tests::TestVector<T>;
+
+
+inline constexpr u32 s_SkeletonCount = 1000u;
+inline constexpr u32 s_JointCount = 100u;
+inline constexpr u32 s_WarmupCount = 2u;
+inline constexpr u32 s_SampleCount = 31u;
+inline constexpr f32 s_FrameDelta = 1.0f / 60.0f;
+inline constexpr f32 s_MatchEpsilon = 0.001f;
+
+inline constexpr Name s_ProfileArena("tests/unit/ecs_graphics/skeleton_palette_profile");
+
+
+struct ProfileWorld{
+    Core::Alloc::GlobalArena arena;
+    Core::Alloc::ThreadPool threadPool;
+    Core::ECS::World world;
+    Vector<Core::ECS::EntityID> owners;
+
+    explicit ProfileWorld(const u32 workerCount)
+        : arena(s_ProfileArena)
+        , threadPool(workerCount, CpuAffinity::Any)
+        , world(arena, threadPool)
+    {
+        world.addSystem<Impl::SkeletonPaletteSystem>(world);
+    }
+};
+
+struct Result{
+    u32 workerCount = 0u;
+    Tests::ProfileTimingSamples perJoint;
+    Tests::ProfileTimingSamples serial;
+    Tests::ProfileTimingSamples parallel;
+    Tests::ProfileTimingSamples unchanged;
+};
+
+
+[[nodiscard]] static Impl::SkeletonJointMatrix MakeLocalJoint(const u32 skeletonIndex, const u32 jointIndex){
+    const f32 angle = 0.05f * static_cast<f32>(jointIndex) + 0.01f * static_cast<f32>(skeletonIndex % 89u);
+    const SIMDMatrix joint = MatrixAffineTransformation(
+        VectorSet(1.0f, 1.0f + 0.001f * static_cast<f32>(jointIndex % 7u), 1.0f, 0.0f),
+        VectorZero(),
+        QuaternionNormalize(VectorSet(0.0f, Sin(angle), 0.0f, Cos(angle))),
+        VectorSet(0.0f, 0.1f, 0.02f * static_cast<f32>(jointIndex % 5u), 0.0f)
+    );
+
+    Impl::SkeletonJointMatrix stored{};
+    StoreFloat(joint, &stored);
+    return stored;
+}
+
+static void PopulateWorld(ProfileWorld& profileWorld){
+    profileWorld.owners.reserve(s_SkeletonCount);
+    for(u32 skeletonIndex = 0u; skeletonIndex < s_SkeletonCount; ++skeletonIndex){
+        auto entity = profileWorld.world.createEntity();
+        auto& pose = entity.addComponent<Impl::SkeletonPoseComponent>(profileWorld.arena);
+        pose.parentJoints.reserve(s_JointCount);
+        pose.localJoints.reserve(s_JointCount);
+        // Binary tree: seven levels deep, with wide levels for the batched evaluator to stream through.
+        for(u32 jointIndex = 0u; jointIndex < s_JointCount; ++jointIndex){
+            pose.parentJoints.push_back(jointIndex == 0u ? Impl::s_SkeletonRootParent : (jointIndex - 1u) / 2u);
+            pose.localJoints.push_back(MakeLocalJoint(skeletonIndex, jointIndex));
+        }
+        profileWorld.owners.push_back(entity.id());
+    }
+}
+
+static void BumpPoseRevisions(ProfileWorld& profileWorld){
+    for(const Core::ECS::EntityID owner : profileWorld.owners){
+        auto entity = profileWorld.world.entity(owner);
+        ++entity.getComponent<Impl::SkeletonPoseComponent>().revision;
+        entity.markChanged<Impl::SkeletonPoseComponent>();
+    }
+}
+
+static void MeasureBatched(ProfileWorld& profileWorld, const bool bumpRevisions, Tests::ProfileTimingSamples& outSamples){
+    for(u32 i = 0u; i < s_WarmupCount + s_SampleCount; ++i){
+        if(bumpRevisions)
+            BumpPoseRevisions(profileWorld);
+
+        const Timer begin = TimerNow();
+        profileWorld.world.tick(s_FrameDelta);
+        if(i >= s_WarmupCount && !outSamples.append(DurationInSeconds<f64>(TimerNow(), begin)))
+            break;
+    }
+}
+
+static void MeasurePerJoint(ProfileWorld& profileWorld, Tests::ProfileTimingSamples& outSamples){
+    Vector<Impl::SkeletonJointMatrix> joints;
+    joints.reserve(s_JointCount);
+    for(u32 i = 0u; i < s_WarmupCount + s_SampleCount; ++i){
+        const Timer begin = TimerNow();
+        for(const Core::ECS::EntityID owner : profileWorld.owners){
+            const auto& pose = profileWorld.world.entity(owner).getComponent<Impl::SkeletonPoseComponent>();
+            u32 skinningMode = Impl::SkeletonSkinningMode::LinearBlend;
+            if(!Impl::SkeletonRuntime::BuildStoredJointPaletteFromSkeletonPose(pose, joints, skinningMode))
+                return;
+        }
+        if(i >= s_WarmupCount && !outSamples.append(DurationInSeconds<f64>(TimerNow(), begin)))
+            break;
+    }
+}
+
+[[nodiscard]] static bool PalettesMatch(ProfileWorld& profileWorld){
+    Vector<Impl::SkeletonJointMatrix> expected;
+    for(const Core::ECS::EntityID owner : profileWorld.owners){
+        auto entity = profileWorld.world.entity(owner);
+        const auto& pose = entity.getComponent<Impl::SkeletonPoseComponent>();
+        const auto* palette = profileWorld.world.tryGetComponent<Impl::SkeletonPosePaletteComponent>(owner);
+        u32 skinningMode = Impl::SkeletonSkinningMode::LinearBlend;
+        if(
+            !Impl::SkeletonRuntime::SkeletonPosePaletteCurrent(pose, palette)
+            || !Impl::SkeletonRuntime::BuildStoredJointPaletteFromSkeletonPose(pose, expected, skinningMode)
+            || palette->joints.size() != expected.size()
+        )
+            return false;
+
+        for(usize jointIndex = 0u; jointIndex < expected.size(); ++jointIndex){
+            for(usize element = 0u; element < Impl::s_SkeletonJointMatrixFloatCount; ++element){
+                if(Abs(palette->joints[jointIndex].raw[element] - expected[jointIndex].raw[element]) > s_MatchEpsilon)
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+[[nodiscard]] static bool RunProfile(Result& outResult){
+    outResult.workerCount = Max(QueryCpuCoreCount(CpuAffinity::Any), 1u);
+
+    ProfileWorld serialWorld(0u);
+    ProfileWorld parallelWorld(outResult.workerCount);
+    PopulateWorld(serialWorld);
+    PopulateWorld(parallelWorld);
+
+    MeasurePerJoint(serialWorld, outResult.perJoint);
+    MeasureBatched(serialWorld, true, outResult.serial);
+    MeasureBatched(parallelWorld, true, outResult.parallel);
+    MeasureBatched(parallelWorld, false, outResult.unchanged);
+    return PalettesMatch(serialWorld) && PalettesMatch(parallelWorld);
+}
+
+static void EmitResult(const Result& result, const bool matched){
+    NWB_COUT
+        << "{\"status\":\"" << (matched ? "ok" : "failed") << "\","
+        << "\"skeletons\":" << s_SkeletonCount << ','
+        << "\"joints\":" << s_JointCount << ','
+        << "\"workers\":" << result.workerCount << ','
+        << "\"samples\":" << s_SampleCount << ','
+    ;
+    Tests::EmitProfileTiming("per_joint", result.perJoint);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming("serial", result.serial);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming("parallel", result.parallel);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming("unchanged", result.unchanged);
+    NWB_COUT << "}\n";
+}
+
+[[nodiscard]] static int EntryPoint(const isize, tchar**, void*){
+    Core::Common::InitializerGuard commonInitializerGuard;
+    if(!commonInitializerGuard.initialize()){
+        NWB_CERR << "skeleton palette profile initialization failed\n";
+        return 1;
+    }
+
+    Result result;
+    const bool matched = RunProfile(result);
+    EmitResult(result, matched);
+    return matched ? 0 : 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_DEFINE_APPLICATION_ENTRY_POINT(::NWB::SkeletonPaletteProfile::EntryPoint)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,212 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <tests/common/ecs_test_world.h>
+#include <gtest/gtest.h>
+
+#include <core/ecs/module.h>
+#include <global/cpu_topology.h>
+#include <impl/ecs_skeleton/module.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_skeleton_palette_tests{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+using TestWorld = NWB::Tests::EcsTestWorld;
+
+inline constexpr f32 s_PaletteEpsilon = 0.0001f;
+// Parents deliberately interleave depths so the level-sorted layout differs from joint order.
+inline constexpr u32 s_BranchingParents[] = {
+    NWB::Impl::s_SkeletonRootParent, 0u, 0u, 1u, NWB::Impl::s_SkeletonRootParent, 4u, 3u, 2u, 6u, 5u,
+};
+// Two roots with three children per joint: levels of 2, 6, 18 and 44 joints give wide kernels full blocks and tails.
+inline constexpr u32 s_FanJointCount = 70u;
+inline constexpr u32 s_FanRootCount = 2u;
+inline constexpr u32 s_FanChildCount = 3u;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+[[nodiscard]] static NWB::Impl::SkeletonJointMatrix MakeLocalJoint(const u32 jointIndex, const f32 phase){
+    const f32 angle = 0.3f * static_cast<f32>(jointIndex + 1u) + phase;
+    const SIMDMatrix joint = MatrixAffineTransformation(
+        VectorSet(1.0f + 0.05f * static_cast<f32>(jointIndex % 3u), 1.0f, 0.9f, 0.0f),
+        VectorZero(),
+        QuaternionNormalize(VectorSet(Sin(angle), 0.25f, Cos(angle), 1.0f)),
+        VectorSet(0.1f * static_cast<f32>(jointIndex), 0.5f, -0.2f * phase, 0.0f)
+    );
+
+    NWB::Impl::SkeletonJointMatrix stored{};
+    StoreFloat(joint, &stored);
+    return stored;
+}
+
+static void FillBranchingPose(NWB::Impl::SkeletonPoseComponent& pose, const f32 phase){
+    pose.parentJoints.clear();
+    pose.localJoints.clear();
+    for(u32 jointIndex = 0u; jointIndex < LengthOf(s_BranchingParents); ++jointIndex){
+        pose.parentJoints.push_back(s_BranchingParents[jointIndex]);
+        pose.localJoints.push_back(MakeLocalJoint(jointIndex, phase));
+    }
+    ++pose.revision;
+}
+
+static void FillFanPose(NWB::Impl::SkeletonPoseComponent& pose, const f32 phase){
+    pose.parentJoints.clear();
+    pose.localJoints.clear();
+    for(u32 jointIndex = 0u; jointIndex < s_FanJointCount; ++jointIndex){
+        pose.parentJoints.push_back(
+            jointIndex < s_FanRootCount ? NWB::Impl::s_SkeletonRootParent : (jointIndex - s_FanRootCount) / s_FanChildCount
+        );
+        pose.localJoints.push_back(MakeLocalJoint(jointIndex, phase));
+    }
+    ++pose.revision;
+}
+
+template<typename JointVector>
+static void ExpectPaletteMatchesPose(
+    TestWorld& testWorld,
+    const JointVector& joints,
+    const NWB::Impl::SkeletonPoseComponent& pose
+){
+    Vector<NWB::Impl::SkeletonJointMatrix, NWB::Core::Alloc::GlobalArena> expected(testWorld.arena);
+    u32 skinningMode = NWB::Impl::SkeletonSkinningMode::LinearBlend;
+    ASSERT_TRUE(NWB::Impl::SkeletonRuntime::BuildStoredJointPaletteFromSkeletonPose(pose, expected, skinningMode));
+    ASSERT_EQ(joints.size(), expected.size());
+    for(usize jointIndex = 0u; jointIndex < expected.size(); ++jointIndex){
+        for(usize element = 0u; element < NWB::Impl::s_SkeletonJointMatrixFloatCount; ++element)
+            EXPECT_NEAR(joints[jointIndex].raw[element], expected[jointIndex].raw[element], s_PaletteEpsilon) << "joint " << jointIndex;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TEST(SkeletonPalette, MatchesPerJointPaletteBuilder){
+    TestWorld testWorld;
+    NWB::Impl::SkeletonPoseComponent pose(testWorld.arena);
+    NWB::Impl::SkeletonPosePaletteComponent palette(testWorld.arena);
+    FillBranchingPose(pose, 0.0f);
+    pose.skinningMode = NWB::Impl::SkeletonSkinningMode::DualQuaternion;
+
+    ASSERT_TRUE(NWB::Impl::SkeletonRuntime::EvaluateSkeletonPalette(pose, palette));
+    EXPECT_TRUE(NWB::Impl::SkeletonRuntime::SkeletonPosePaletteCurrent(pose, &palette));
+    EXPECT_EQ(palette.skinningMode, NWB::Impl::SkeletonSkinningMode::DualQuaternion);
+    ExpectPaletteMatchesPose(testWorld, palette.joints, pose);
+
+    // A new pose on the same hierarchy reuses the layout.
+    FillBranchingPose(pose, 0.7f);
+    EXPECT_FALSE(NWB::Impl::SkeletonRuntime::SkeletonPosePaletteCurrent(pose, &palette));
+    ASSERT_TRUE(NWB::Impl::SkeletonRuntime::EvaluateSkeletonPalette(pose, palette));
+    ExpectPaletteMatchesPose(testWorld, palette.joints, pose);
+}
+
+TEST(SkeletonPalette, WideLevelsMatchOnEverySimdKernelTier){
+    TestWorld testWorld;
+    NWB::Impl::SkeletonPoseComponent pose(testWorld.arena);
+    NWB::Impl::SkeletonPosePaletteComponent palette(testWorld.arena);
+    FillFanPose(pose, 0.4f);
+
+    const SimdKernelTier::Enum activeTier = ActiveSimdKernelTier();
+    for(u8 tier = 0u; tier < SimdKernelTier::kCount; ++tier){
+        if(!SetActiveSimdKernelTier(static_cast<SimdKernelTier::Enum>(tier)))
+            continue;
+        SCOPED_TRACE(testing::Message() << "SimdKernelTier " << static_cast<u32>(tier));
+
+        ++pose.revision;
+        ASSERT_TRUE(NWB::Impl::SkeletonRuntime::EvaluateSkeletonPalette(pose, palette));
+        ExpectPaletteMatchesPose(testWorld, palette.joints, pose);
+    }
+    EXPECT_TRUE(SetActiveSimdKernelTier(activeTier));
+}
+
+TEST(SkeletonPalette, RejectsParentsThatFollowTheirChild){
+    TestWorld testWorld;
+    NWB::Impl::SkeletonPoseComponent pose(testWorld.arena);
+    NWB::Impl::SkeletonPosePaletteComponent palette(testWorld.arena);
+    FillBranchingPose(pose, 0.0f);
+    ASSERT_TRUE(NWB::Impl::SkeletonRuntime::EvaluateSkeletonPalette(pose, palette));
+
+    pose.parentJoints[1] = 3u;
+    ++pose.revision;
+    EXPECT_FALSE(NWB::Impl::SkeletonRuntime::EvaluateSkeletonPalette(pose, palette));
+    EXPECT_FALSE(NWB::Impl::SkeletonRuntime::SkeletonPosePaletteCurrent(pose, &palette));
+    EXPECT_TRUE(palette.joints.empty());
+}
+
+TEST(SkeletonPaletteSystem, EvaluatesOnlyChangedPoseRevisions){
+    TestWorld testWorld;
+    testWorld.world.addSystem<NWB::Impl::SkeletonPaletteSystem>(testWorld.world);
+
+    auto entity = testWorld.world.createEntity();
+    auto& pose = entity.addComponent<NWB::Impl::SkeletonPoseComponent>(testWorld.arena);
+    FillBranchingPose(pose, 0.0f);
+
+    testWorld.world.tick(0.0f);
+    const auto* palette = testWorld.world.tryGetComponent<NWB::Impl::SkeletonPosePaletteComponent>(entity.id());
+    ASSERT_NE(palette, nullptr);
+    ASSERT_TRUE(NWB::Impl::SkeletonRuntime::SkeletonPosePaletteCurrent(pose, palette));
+    ExpectPaletteMatchesPose(testWorld, palette->joints, pose);
+
+    // A change stamp without a revision bump is not observed.
+    const f32 evaluatedRootZ = palette->joints[0].raw[11];
+    pose.localJoints[0] = MakeLocalJoint(0u, 1.5f);
+    EXPECT_TRUE(entity.markChanged<NWB::Impl::SkeletonPoseComponent>());
+    testWorld.world.tick(0.0f);
+    EXPECT_EQ(palette->joints[0].raw[11], evaluatedRootZ);
+    EXPECT_NE(pose.localJoints[0].raw[11], evaluatedRootZ);
+
+    ++pose.revision;
+    EXPECT_TRUE(entity.markChanged<NWB::Impl::SkeletonPoseComponent>());
+    testWorld.world.tick(0.0f);
+    ASSERT_TRUE(NWB::Impl::SkeletonRuntime::SkeletonPosePaletteCurrent(pose, palette));
+    ExpectPaletteMatchesPose(testWorld, palette->joints, pose);
+
+    entity.removeComponent<NWB::Impl::SkeletonPoseComponent>();
+    testWorld.world.tick(0.0f);
+    EXPECT_FALSE(entity.hasComponent<NWB::Impl::SkeletonPosePaletteComponent>());
+}
+
+
+// Mirrors the smoke projects' pose writers before they stamped changes: joints rewritten in place and the revision
+// bumped, with no markChanged call.
+TEST(SkeletonPaletteSystem, EvaluatesRevisionBumpsWithoutChangeStamp){
+    TestWorld testWorld;
+    testWorld.world.addSystem<NWB::Impl::SkeletonPaletteSystem>(testWorld.world);
+
+    auto entity = testWorld.world.createEntity();
+    auto& pose = entity.addComponent<NWB::Impl::SkeletonPoseComponent>(testWorld.arena);
+    FillBranchingPose(pose, 0.0f);
+
+    testWorld.world.tick(0.0f);
+    const auto* palette = testWorld.world.tryGetComponent<NWB::Impl::SkeletonPosePaletteComponent>(entity.id());
+    ASSERT_NE(palette, nullptr);
+    ASSERT_TRUE(NWB::Impl::SkeletonRuntime::SkeletonPosePaletteCurrent(pose, palette));
+
+    for(u32 frame = 1u; frame <= 3u; ++frame){
+        for(u32 jointIndex = 0u; jointIndex < pose.localJoints.size(); ++jointIndex)
+            pose.localJoints[jointIndex] = MakeLocalJoint(jointIndex, static_cast<f32>(frame) * 0.25f);
+        ++pose.revision;
+        testWorld.world.tick(0.0f);
+        ASSERT_TRUE(NWB::Impl::SkeletonRuntime::SkeletonPosePaletteCurrent(pose, palette));
+        ExpectPaletteMatchesPose(testWorld, palette->joints, pose);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,131 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Canned Linux sysfs "devices/system" trees live under cpu_topology_fixtures; each directory is one machine.
+[[nodiscard]] static AInteropString CpuTopologyFixtureRoot(const char* machine){
+    AInteropString root(NWB_CPU_TOPOLOGY_FIXTURE_ROOT);
+    root += '/';
+    root += machine;
+    return root;
+}
+
+[[nodiscard]] static u64 CpuTopologyFixtureMask(const CpuTopology& topology){
+    u64 mask = 0u;
+    for(u32 i = 0u; i < topology.processorCount; ++i)
+        mask |= 1ull << topology.processors[i].cpu;
+    return mask;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TEST(Global, CpuTopologyParsesSmtAndSharedL3Clusters){
+    CpuTopology topology;
+    ASSERT_TRUE(ParseCpuTopology(CpuTopologyFixtureRoot("smt_split_l3").c_str(), 0u, topology));
+    ASSERT_EQ(topology.processorCount, 16u);
+    EXPECT_EQ(topology.physicalCoreCount, 8u);
+    EXPECT_EQ(topology.clusterCount, 2u);
+    EXPECT_EQ(topology.numaNodeCount, 1u);
+
+    // First SMT threads of cluster 0, then cluster 1, then the second threads in the same order.
+    const u32 expectedCpus[16] = { 0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u, 10u, 11u, 12u, 13u, 14u, 15u };
+    for(u32 i = 0u; i < topology.processorCount; ++i){
+        const CpuTopologyProcessor& processor = topology.processors[i];
+        EXPECT_EQ(processor.cpu, expectedCpus[i]);
+        EXPECT_EQ(processor.physicalCore, processor.cpu % 8u);
+        EXPECT_EQ(processor.smtRank, processor.cpu / 8u);
+        EXPECT_EQ(processor.cluster, (processor.cpu % 8u) / 4u);
+        EXPECT_EQ(processor.numaNode, 0u);
+    }
+
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::None, 3u), 0u);
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::PhysicalCore, 1u), 1ull << 1u);
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::PhysicalCore, 7u), 1ull << 7u);
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::PhysicalCore, 8u), 1ull << 8u);
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::PhysicalCore, 17u), 1ull << 1u);
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::ClusterLocal, 1u), 0x0F0Full);
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::ClusterLocal, 5u), 0xF0F0ull);
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::ClusterLocal, 12u), 0xF0F0ull);
+}
+
+TEST(Global, CpuTopologyHonorsAllowedMask){
+    // A cpuset with SMT siblings removed leaves one processor per core.
+    CpuTopology topology;
+    ASSERT_TRUE(ParseCpuTopology(CpuTopologyFixtureRoot("smt_split_l3").c_str(), 0x00F3ull, topology));
+    ASSERT_EQ(topology.processorCount, 6u);
+    EXPECT_EQ(CpuTopologyFixtureMask(topology), 0x00F3ull);
+    EXPECT_EQ(topology.physicalCoreCount, 6u);
+    EXPECT_EQ(topology.clusterCount, 2u);
+    for(u32 i = 0u; i < topology.processorCount; ++i)
+        EXPECT_EQ(topology.processors[i].smtRank, 0u);
+
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::ClusterLocal, 0u), 0x0003ull);
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::ClusterLocal, 2u), 0x00F0ull);
+
+    EXPECT_FALSE(ParseCpuTopology(CpuTopologyFixtureRoot("smt_split_l3").c_str(), 1ull << 40u, topology));
+    EXPECT_EQ(topology.processorCount, 0u);
+}
+
+TEST(Global, CpuTopologyFallsBackToPackagesAndReadsNumaNodes){
+    CpuTopology topology;
+    ASSERT_TRUE(ParseCpuTopology(CpuTopologyFixtureRoot("two_node_no_l3").c_str(), 0u, topology));
+    ASSERT_EQ(topology.processorCount, 7u);
+    EXPECT_EQ(CpuTopologyFixtureMask(topology), 0xDFull);
+    EXPECT_EQ(topology.physicalCoreCount, 7u);
+    EXPECT_EQ(topology.clusterCount, 2u);
+    EXPECT_EQ(topology.numaNodeCount, 2u);
+
+    const u32 expectedCpus[7] = { 0u, 1u, 2u, 3u, 4u, 6u, 7u };
+    for(u32 i = 0u; i < topology.processorCount; ++i){
+        const CpuTopologyProcessor& processor = topology.processors[i];
+        EXPECT_EQ(processor.cpu, expectedCpus[i]);
+        EXPECT_EQ(processor.smtRank, 0u);
+        EXPECT_EQ(processor.numaNode, processor.cpu < 4u ? 0u : 1u);
+        EXPECT_EQ(processor.cluster, processor.numaNode);
+    }
+
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::PhysicalCore, 5u), 1ull << 6u);
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::ClusterLocal, 5u), 0xD0ull);
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::ClusterLocal, 7u), 0x0Full);
+}
+
+TEST(Global, CpuTopologyRejectsMissingTrees){
+    CpuTopology topology;
+    topology.processorCount = 3u;
+    EXPECT_FALSE(ParseCpuTopology(CpuTopologyFixtureRoot("missing_machine").c_str(), 0u, topology));
+    EXPECT_EQ(topology.processorCount, 0u);
+    EXPECT_FALSE(ParseCpuTopology(nullptr, 0u, topology));
+
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::PhysicalCore, 1u), 0u);
+    EXPECT_EQ(CpuPinningMask(topology, CpuPinning::ClusterLocal, 1u), 0u);
+}
+
+TEST(Global, CpuTopologyQueryPinsCurrentThread){
+    const CpuTopology& topology = QueryCpuTopology();
+    EXPECT_EQ(&QueryCpuTopology(), &topology);
+    EXPECT_LE(topology.processorCount, s_MaxCpuTopologyProcessors);
+#if defined(NWB_PLATFORM_LINUX)
+    if(topology.processorCount == 0u)
+        GTEST_SKIP() << "sysfs CPU topology is unavailable";
+
+    cpu_set_t originalCpuSet;
+    ASSERT_EQ(::sched_getaffinity(0, sizeof(originalCpuSet), &originalCpuSet), 0);
+
+    const u32 pinnedCpu = topology.processors[0u].cpu;
+    SetCurrentThreadCpuAffinity(CpuPinningMask(topology, CpuPinning::PhysicalCore, 0u));
+    cpu_set_t pinnedCpuSet;
+    const int queryResult = ::sched_getaffinity(0, sizeof(pinnedCpuSet), &pinnedCpuSet);
+    const int restoreResult = ::sched_setaffinity(0, sizeof(originalCpuSet), &originalCpuSet);
+
+    ASSERT_EQ(queryResult, 0);
+    EXPECT_EQ(restoreResult, 0);
+    EXPECT_EQ(CPU_COUNT(&pinnedCpuSet), 1);
+    EXPECT_TRUE(CPU_ISSET(pinnedCpu, &pinnedCpuSet));
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -393,6 +393,31 @@ TEST(Global, CpuTopologyQueriesAreSafe){
     SetCurrentThreadCpuAffinity(0u);
 }
 
+TEST(Global, SimdKernelTierFollowsCpuFeatures){
+    const CpuFeature::Mask features = QueryCpuFeatures();
+    EXPECT_EQ(QueryCpuFeatures(), features);
+#if defined(NWB_HAS_AVX2)
+    EXPECT_NE(features & CpuFeature::AVX2, 0u);
+#endif
+
+    const SimdKernelTier::Enum activeTier = ActiveSimdKernelTier();
+    EXPECT_TRUE(SimdKernelTierSupported(activeTier));
+    EXPECT_TRUE(SimdKernelTierSupported(SimdKernelTier::Baseline));
+
+    const u32 avx512Features = CpuFeature::AVX512F | CpuFeature::AVX512DQ;
+    const bool avx512Supported = (features & avx512Features) == avx512Features;
+    EXPECT_EQ(SimdKernelTierSupported(SimdKernelTier::AVX512), avx512Supported);
+    EXPECT_FALSE(SimdKernelTierSupported(SimdKernelTier::kCount));
+
+    EXPECT_TRUE(SetActiveSimdKernelTier(SimdKernelTier::Baseline));
+    EXPECT_EQ(ActiveSimdKernelTier(), SimdKernelTier::Baseline);
+    EXPECT_EQ(SetActiveSimdKernelTier(SimdKernelTier::AVX512), avx512Supported);
+    EXPECT_EQ(ActiveSimdKernelTier(), avx512Supported ? SimdKernelTier::AVX512 : SimdKernelTier::Baseline);
+    EXPECT_FALSE(SetActiveSimdKernelTier(SimdKernelTier::kCount));
+
+    EXPECT_TRUE(SetActiveSimdKernelTier(activeTier));
+}
+
 TEST(Global, Vector3TryNormalizeRejectsInvalidValues){
     SIMDVector normalized = VectorSet(9.0f, 8.0f, 7.0f, 6.0f);
     const SIMDVector unchanged = normalized;
@@ -558,6 +583,42 @@ TEST(Global, RuntimeNameSymbolsRecordStringViewNames){
     EXPECT_FALSE(NWB::Core::Common::NameSymbols::Resolve(literalName.hash(), resolvedText, sizeof(resolvedText)));
 }
 
+TEST(Global, WyHash64KeepsItsOnDiskDefinition){
+    u8 bytes[200] = {};
+    for(u32 i = 0u; i < LengthOf(bytes); ++i)
+        bytes[i] = static_cast<u8>(i * 7u + 3u);
+
+    // Reference wyhash final 4 values; cooked payload hashes depend on them, so they must never change.
+    struct Expected{
+        usize byteCount;
+        u64 hash;
+    };
+    static constexpr Expected s_Expected[] = {
+        { 0u, 0x93228a4de0eec5a2ull },
+        { 3u, 0x9d6f309864716719ull },
+        { 4u, 0xe8936f54388cdbf5ull },
+        { 16u, 0x43271ea04489ebc4ull },
+        { 17u, 0xa55c3367b6b9a71cull },
+        { 48u, 0xb4f07cd76c392405ull },
+        { 49u, 0x5e3a1f603be7896aull },
+        { 200u, 0x5179e063b72e721bull },
+    };
+    for(const Expected& expected : s_Expected)
+        EXPECT_EQ(ComputeWyHash64(bytes, expected.byteCount), expected.hash) << expected.byteCount << " bytes";
+    EXPECT_EQ(ComputeWyHash64(bytes, LengthOf(bytes), 42u), 0x1a6fa0e9126cf46bull);
+
+    // Every split of the input must stream to the one-shot value, including splits inside and across blocks.
+    for(usize byteCount = 0u; byteCount <= LengthOf(bytes); ++byteCount){
+        const u64 expected = ComputeWyHash64(bytes, byteCount, 42u);
+        for(usize chunkBytes = 1u; chunkBytes <= 64u; chunkBytes += 7u){
+            WyHash64Stream stream(42u);
+            for(usize offset = 0u; offset < byteCount; offset += chunkBytes)
+                stream.update(bytes + offset, Min(chunkBytes, byteCount - offset));
+            ASSERT_EQ(stream.finish(), expected) << byteCount << " bytes in " << chunkBytes << "-byte chunks";
+        }
+    }
+}
+
 TEST(Global, NameHashDebugTextHelpers){
     const NameHash source = ComputeNameHash("global_name_hash_debug_text");
     char hashText[NameDetail::s_DebugHashTextLength + 1u] = {};
@@ -902,6 +963,17 @@ TEST(Global, FilesystemUtilityHelpers){
     EXPECT_TRUE(TextFileContains(textFile, AStringView("alpha")));
     EXPECT_FALSE(TextFileContains(textFile, AStringView("gamma")));
 
+    FileStamp stamp;
+    FileStamp sameStamp;
+    EXPECT_TRUE(QueryFileStamp(textFile, stamp, error));
+    EXPECT_FALSE(error);
+    EXPECT_EQ(stamp.size, 10u);
+    EXPECT_NE(stamp.lastWriteTime, 0u);
+    EXPECT_TRUE(QueryFileStamp(textFile, sameStamp, error));
+    EXPECT_EQ(stamp, sameStamp);
+    EXPECT_FALSE(QueryFileStamp(root / "missing.txt", stamp, error));
+    EXPECT_TRUE(error);
+
     EXPECT_TRUE(RemoveAllIfExists(root, error));
 }
 
@@ -1342,6 +1414,7 @@ TEST(Global, DiagnosticEventHook){
 
 
 #include "tangent_frame_tests.inl"
+#include "cpu_topology_tests.inl"
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,153 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Manual CPU probe for payload hashing. It hashes a 64 MiB payload with the byte-at-a-time FNV-1a path, one-shot
+// ComputeWyHash64 and WyHash64Stream fed in 64 KiB chunks, then reports min/median/max wall time and median GB/s per
+// pass. It fails if the streamed hash differs from the one-shot hash.
+
+
+#include <core/common/application_entry.h>
+#include <core/common/module.h>
+
+#include <tests/common/profile_timing.h>
+#include <tests/common/test_context.h>
+
+#include <global/hash_utils.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace PayloadHashProfile{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<typename T>
+using Vector = Tests::TestVector<T>;
+
+
+inline constexpr usize s_PayloadBytes = 64u << 20u;
+inline constexpr usize s_StreamChunkBytes = 64u << 10u;
+inline constexpr u32 s_WarmupCount = 1u;
+inline constexpr u32 s_SampleCount = 9u;
+inline constexpr f64 s_BytesPerGigabyte = 1000.0 * 1000.0 * 1000.0;
+
+
+struct Result{
+    Tests::ProfileTimingSamples fnv;
+    Tests::ProfileTimingSamples wyHash;
+    Tests::ProfileTimingSamples wyHashStream;
+    u64 fnvValue = 0u;
+    u64 wyHashValue = 0u;
+    u64 wyHashStreamValue = 0u;
+};
+
+
+static void FillPayload(Vector<u8>& outPayload){
+    outPayload.resize(s_PayloadBytes);
+    u64 state = 0x9e3779b97f4a7c15ull;
+    for(u8& byte : outPayload){
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        byte = static_cast<u8>(state >> 56u);
+    }
+}
+
+template<typename HashFunction>
+static u64 Measure(const HashFunction& hashFunction, Tests::ProfileTimingSamples& outSamples){
+    u64 hash = 0u;
+    for(u32 i = 0u; i < s_WarmupCount + s_SampleCount; ++i){
+        const Timer begin = TimerNow();
+        hash = hashFunction();
+        if(i >= s_WarmupCount && !outSamples.append(DurationInSeconds<f64>(TimerNow(), begin)))
+            break;
+    }
+    return hash;
+}
+
+static void RunProfile(const Vector<u8>& payload, Result& outResult){
+    const u8* bytes = payload.data();
+    outResult.fnvValue = Measure([bytes](){ return ComputeFnv64Bytes(bytes, s_PayloadBytes); }, outResult.fnv);
+    outResult.wyHashValue = Measure([bytes](){ return ComputeWyHash64(bytes, s_PayloadBytes); }, outResult.wyHash);
+    outResult.wyHashStreamValue = Measure(
+        [bytes](){
+            WyHash64Stream stream;
+            for(usize offset = 0u; offset < s_PayloadBytes; offset += s_StreamChunkBytes)
+                stream.update(bytes + offset, Min(s_StreamChunkBytes, s_PayloadBytes - offset));
+            return stream.finish();
+        },
+        outResult.wyHashStream
+    );
+}
+
+static void EmitPass(const char* name, const Tests::ProfileTimingSamples& samples, const u64 hash){
+    const Tests::ProfileTimingSummary summary = Tests::SummarizeProfileTiming(samples);
+    NWB_COUT << '\"' << name << "\":{\"hash\":" << hash << ',';
+    Tests::EmitProfileTiming("time", samples);
+    NWB_COUT
+        << ",\"median_gb_per_s\":"
+        << (summary.median > 0.0 ? static_cast<f64>(s_PayloadBytes) / s_BytesPerGigabyte / summary.median : 0.0)
+        << '}'
+    ;
+}
+
+static void EmitResult(const Result& result, const bool matched){
+    NWB_COUT
+        << "{\"status\":\"" << (matched ? "ok" : "failed") << "\","
+        << "\"payload_bytes\":" << s_PayloadBytes << ','
+        << "\"samples\":" << s_SampleCount << ','
+    ;
+    EmitPass("fnv1a", result.fnv, result.fnvValue);
+    NWB_COUT << ',';
+    EmitPass("wyhash", result.wyHash, result.wyHashValue);
+    NWB_COUT << ',';
+    EmitPass("wyhash_stream", result.wyHashStream, result.wyHashStreamValue);
+    NWB_COUT << "}\n";
+}
+
+[[nodiscard]] static int EntryPoint(const isize, tchar**, void*){
+    Core::Common::InitializerGuard commonInitializerGuard;
+    if(!commonInitializerGuard.initialize()){
+        NWB_CERR << "payload hash profile initialization failed\n";
+        return 1;
+    }
+
+    Vector<u8> payload;
+    FillPayload(payload);
+
+    Result result;
+    RunProfile(payload, result);
+    const bool matched = result.wyHashValue == result.wyHashStreamValue;
+    EmitResult(result, matched);
+    return matched ? 0 : 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_DEFINE_APPLICATION_ENTRY_POINT(::NWB::PayloadHashProfile::EntryPoint)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
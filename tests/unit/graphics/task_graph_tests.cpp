@@ -6829,6 +6829,213 @@ TEST(GpuTaskGraph, ExportsRequiredImportedResourceFinalStates){
 }
 
 
+TEST(GpuTaskGraph, PacksTransientLifetimesIntoSharedAllocation){
+    TestArena testArena;
+    Graphics::GpuTaskGraph graph(testArena.arena);
+
+    constexpr u64 s_MiB = 1024u * 1024u;
+    constexpr u64 s_Alignment = 64u * 1024u;
+    const auto createTransient = [&graph](const char* identity, const char* label, const u64 byteSize){
+        Graphics::GpuGraphResourceDesc desc;
+        desc
+            .setIdentity(Name(identity))
+            .setMarkerLabel(label)
+            .setType(Graphics::GpuGraphResourceType::Buffer)
+        ;
+        Graphics::BufferDesc buffer;
+        buffer.byteSize = byteSize;
+        return graph.createTransientBuffer(buffer, desc, Graphics::MemoryRequirements{ byteSize, s_Alignment });
+    };
+    const Graphics::GpuGraphResourceId first = createTransient(
+        "tests/task_graph/transient_first",
+        "Transient First",
+        s_MiB
+    );
+    const Graphics::GpuGraphResourceId second = createTransient(
+        "tests/task_graph/transient_second",
+        "Transient Second",
+        s_MiB
+    );
+    const Graphics::GpuGraphResourceId third = createTransient(
+        "tests/task_graph/transient_third",
+        "Transient Third",
+        s_MiB / 2u
+    );
+    const Graphics::GpuGraphResourceId unused = createTransient(
+        "tests/task_graph/transient_unused",
+        "Transient Unused",
+        s_MiB
+    );
+    ASSERT_TRUE(first.valid());
+    ASSERT_TRUE(second.valid());
+    ASSERT_TRUE(third.valid());
+    ASSERT_TRUE(unused.valid());
+    EXPECT_EQ(graph.transientResourceCount(), 4u);
+
+    const auto write = [](const Graphics::GpuGraphResourceId& resource){
+        return Graphics::GpuTaskResourceUse{
+            .resource = resource,
+            .range = {},
+            .requiredState = Graphics::ResourceStates::UnorderedAccess,
+            .access = Graphics::GpuTaskResourceAccess::Write,
+        };
+    };
+    const auto read = [](const Graphics::GpuGraphResourceId& resource){
+        return Graphics::GpuTaskResourceUse{
+            .resource = resource,
+            .range = {},
+            .requiredState = Graphics::ResourceStates::ShaderResource,
+            .access = Graphics::GpuTaskResourceAccess::Read,
+        };
+    };
+
+    const Graphics::GpuTaskResourceUse produceUses[] = { write(first) };
+    const Graphics::GpuTaskId produce = AddTask(
+        graph,
+        Name("tests/task_graph/transient_produce"),
+        "Transient Produce",
+        nullptr,
+        0u,
+        produceUses,
+        LengthOf(produceUses)
+    );
+    ASSERT_TRUE(produce.valid());
+    const Graphics::GpuTaskResourceUse expandUses[] = { read(first), write(second) };
+    const Graphics::GpuTaskId expand = AddTask(
+        graph,
+        Name("tests/task_graph/transient_expand"),
+        "Transient Expand",
+        &produce,
+        1u,
+        expandUses,
+        LengthOf(expandUses)
+    );
+    ASSERT_TRUE(expand.valid());
+    const Graphics::GpuTaskResourceUse reduceUses[] = { read(second), write(third) };
+    const Graphics::GpuTaskId reduce = AddTask(
+        graph,
+        Name("tests/task_graph/transient_reduce"),
+        "Transient Reduce",
+        &expand,
+        1u,
+        reduceUses,
+        LengthOf(reduceUses)
+    );
+    ASSERT_TRUE(reduce.valid());
+    const Graphics::GpuTaskResourceUse consumeUses[] = { read(third) };
+    const Graphics::GpuTaskId consume = AddTask(
+        graph,
+        Name("tests/task_graph/transient_consume"),
+        "Transient Consume",
+        &reduce,
+        1u,
+        consumeUses,
+        LengthOf(consumeUses)
+    );
+    ASSERT_TRUE(consume.valid());
+
+    const Graphics::GpuPhysicalQueueInfo queue = GraphicsQueue();
+    const Graphics::GpuTaskGraphQueueTopology topology{
+        .queues = &queue,
+        .queueCount = 1u,
+    };
+    Graphics::GpuTaskGraphAnalysis analysis(testArena.arena);
+    Graphics::GpuTaskGraphQueueAssignments assignments(testArena.arena);
+    Graphics::GpuCompiledGraph compiledGraph(testArena.arena);
+    ASSERT_TRUE(Compile(graph, analysis, topology, assignments, compiledGraph));
+
+    // first and second overlap at the expand task; third starts after first's last use and takes its memory.
+    ASSERT_EQ(compiledGraph.transientResourceCount(), 3u);
+    const Graphics::GpuCompiledTransientResource* const firstPlacement = compiledGraph.transientResource(first);
+    const Graphics::GpuCompiledTransientResource* const secondPlacement = compiledGraph.transientResource(second);
+    const Graphics::GpuCompiledTransientResource* const thirdPlacement = compiledGraph.transientResource(third);
+    ASSERT_NE(firstPlacement, nullptr);
+    ASSERT_NE(secondPlacement, nullptr);
+    ASSERT_NE(thirdPlacement, nullptr);
+    EXPECT_EQ(compiledGraph.transientResource(unused), nullptr);
+    EXPECT_EQ(firstPlacement->offset, 0u);
+    EXPECT_EQ(firstPlacement->firstTask, produce);
+    EXPECT_EQ(firstPlacement->lastTask, expand);
+    EXPECT_FALSE(firstPlacement->aliased);
+    EXPECT_EQ(secondPlacement->offset, s_MiB);
+    EXPECT_FALSE(secondPlacement->aliased);
+    EXPECT_EQ(thirdPlacement->offset, 0u);
+    EXPECT_EQ(thirdPlacement->firstTask, reduce);
+    EXPECT_EQ(thirdPlacement->lastTask, consume);
+    EXPECT_TRUE(thirdPlacement->aliased);
+    EXPECT_EQ(compiledGraph.transientAllocationBytes(), 2u * s_MiB);
+    EXPECT_EQ(compiledGraph.transientAllocationAlignment(), s_Alignment);
+
+    ASSERT_EQ(compiledGraph.transientAliasingBarrierCount(), 1u);
+    const Graphics::GpuCompiledTransientAliasingBarrier* const aliasingBarrier =
+        compiledGraph.transientAliasingBarrierAt(0u);
+    ASSERT_NE(aliasingBarrier, nullptr);
+    EXPECT_EQ(aliasingBarrier->task, reduce);
+    EXPECT_EQ(aliasingBarrier->before, first);
+    EXPECT_EQ(aliasingBarrier->after, third);
+    const Graphics::GpuCompiledTask* const compiledReduce = compiledGraph.findTask(reduce);
+    ASSERT_NE(compiledReduce, nullptr);
+    EXPECT_EQ(aliasingBarrier->queue, compiledReduce->queue);
+    EXPECT_EQ(compiledReduce->transientAliasingBarrierCount, 1u);
+    EXPECT_EQ(compiledGraph.taskTransientAliasingBarriers(reduce), aliasingBarrier);
+    EXPECT_EQ(compiledGraph.taskTransientAliasingBarriers(expand), nullptr);
+
+    const Graphics::GpuTaskGraphCompileStatistics& statistics = compiledGraph.compileStatistics();
+    EXPECT_EQ(statistics.transientResourceCount, 3u);
+    EXPECT_EQ(statistics.aliasedTransientResourceCount, 1u);
+    EXPECT_EQ(statistics.transientAliasingBarrierCount, 1u);
+    EXPECT_EQ(statistics.transientPeakBytes, 2u * s_MiB);
+    EXPECT_EQ(statistics.transientUnaliasedBytes, 2u * s_MiB + s_MiB / 2u);
+}
+
+TEST(GpuTaskGraph, ValidatesTransientResourceDeclarations){
+    TestArena testArena;
+    Graphics::GpuTaskGraph graph(testArena.arena);
+
+    Graphics::GpuGraphResourceDesc textureDesc;
+    textureDesc
+        .setIdentity(Name("tests/task_graph/transient_texture"))
+        .setMarkerLabel("Transient Texture")
+        .setType(Graphics::GpuGraphResourceType::Texture)
+    ;
+    Graphics::TextureDesc texture;
+    texture
+        .setWidth(256u)
+        .setHeight(256u)
+        .setMipLevels(9u)
+        .setFormat(Graphics::Format::RGBA8_UNORM)
+        .setInRenderTarget(true)
+    ;
+
+    Graphics::GpuGraphResourceDesc explicitStateDesc = textureDesc;
+    explicitStateDesc.setInitialState(Graphics::ResourceStates::Common);
+    EXPECT_FALSE(graph.createTransientTexture(texture, explicitStateDesc).valid());
+    EXPECT_FALSE(graph.createTransientTexture(texture, textureDesc, Graphics::MemoryRequirements{ 4096u, 3u }).valid());
+    Graphics::BufferDesc mismatchedBuffer;
+    mismatchedBuffer.byteSize = 4096u;
+    EXPECT_FALSE(graph.createTransientBuffer(mismatchedBuffer, textureDesc).valid());
+
+    // 256x256 RGBA8 with a full mip chain is 349524 bytes before rounding to the estimated placement alignment.
+    const Graphics::GpuGraphResourceId transient = graph.createTransientTexture(texture, textureDesc);
+    ASSERT_TRUE(transient.valid());
+    EXPECT_FALSE(graph.createTransientTexture(texture, textureDesc).valid());
+    Graphics::GpuGraphResourceDesc importDesc = textureDesc;
+    importDesc.setInitialState(Graphics::ResourceStates::Common);
+    EXPECT_FALSE(graph.importResource(importDesc).valid());
+
+    const Graphics::GpuTaskGraphResourceView view = graph.resourceAt(transient.index);
+    EXPECT_TRUE(view.transient);
+    EXPECT_EQ(view.initialState, Graphics::ResourceStates::Unknown);
+    EXPECT_EQ(view.transientMemory.size, 393216u);
+    EXPECT_EQ(view.transientMemory.alignment, 65536u);
+    const Graphics::TextureDesc* const declaredTexture = graph.transientTextureDesc(transient);
+    ASSERT_NE(declaredTexture, nullptr);
+    EXPECT_EQ(declaredTexture->mipLevels, 9u);
+    EXPECT_EQ(graph.transientBufferDesc(transient), nullptr);
+    EXPECT_EQ(graph.transientResourceCount(), 1u);
+}
+
+
 TEST(GpuTaskGraph, ExportsExclusiveImportedResourceOwnershipToExternalQueue){
     TestArena testArena;
     Graphics::GpuTaskGraph graph(testArena.arena);
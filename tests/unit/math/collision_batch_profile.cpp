@@ -0,0 +1,418 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Manual CPU probe for the SoA batch collision kernels. Over one million random bounds it times the scalar Bounding*
+// path against the batch kernels for frustum culling (spheres, boxes, oriented boxes), one ray against boxes and
+// oriented boxes, one query box against oriented boxes and a bulk box transform. It reports min/median/max wall time
+// per pass and fails if the two paths disagree on any result count.
+
+
+#include <core/common/application_entry.h>
+#include <core/common/module.h>
+
+#include <tests/common/profile_timing.h>
+#include <tests/common/test_context.h>
+
+#include <global/simdmath.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace CollisionBatchProfile{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<typename T>
+using Vector = Tests::TestVector<T>;
+
+
+inline constexpr u32 s_BoundCount = 1000000u;
+inline constexpr u32 s_WarmupCount = 2u;
+inline constexpr u32 s_SampleCount = 11u;
+
+
+struct Streams{
+    Vector<f32> centerX;
+    Vector<f32> centerY;
+    Vector<f32> centerZ;
+    Vector<f32> radius;
+    Vector<f32> extentsX;
+    Vector<f32> extentsY;
+    Vector<f32> extentsZ;
+    Vector<f32> orientationX;
+    Vector<f32> orientationY;
+    Vector<f32> orientationZ;
+    Vector<f32> orientationW;
+};
+
+struct Comparison{
+    usize scalarCount = 0u;
+    usize batchCount = 0u;
+    Tests::ProfileTimingSamples scalarSamples;
+    Tests::ProfileTimingSamples batchSamples;
+};
+
+struct Result{
+    Comparison frustumSpheres;
+    Comparison frustumBoxes;
+    Comparison frustumOrientedBoxes;
+    Comparison rayBoxes;
+    Comparison rayOrientedBoxes;
+    Comparison aabbOrientedBoxes;
+    Comparison transformBoxes;
+};
+
+
+static void FillStreams(Streams& outStreams){
+    u64 state = 0x9e3779b97f4a7c15ull;
+    const auto next = [&state](const f32 minimum, const f32 maximum){
+        state ^= state << 13u;
+        state ^= state >> 7u;
+        state ^= state << 17u;
+        return minimum + (maximum - minimum) * (static_cast<f32>(state >> 40u) * (1.0f / 16777216.0f));
+    };
+
+    outStreams.centerX.resize(s_BoundCount);
+    outStreams.centerY.resize(s_BoundCount);
+    outStreams.centerZ.resize(s_BoundCount);
+    outStreams.radius.resize(s_BoundCount);
+    outStreams.extentsX.resize(s_BoundCount);
+    outStreams.extentsY.resize(s_BoundCount);
+    outStreams.extentsZ.resize(s_BoundCount);
+    outStreams.orientationX.resize(s_BoundCount);
+    outStreams.orientationY.resize(s_BoundCount);
+    outStreams.orientationZ.resize(s_BoundCount);
+    outStreams.orientationW.resize(s_BoundCount);
+    for(u32 i = 0u; i < s_BoundCount; ++i){
+        outStreams.centerX[i] = next(-200.0f, 200.0f);
+        outStreams.centerY[i] = next(-200.0f, 200.0f);
+        outStreams.centerZ[i] = next(-200.0f, 200.0f);
+        outStreams.radius[i] = next(0.0f, 4.0f);
+        outStreams.extentsX[i] = next(0.0f, 3.0f);
+        outStreams.extentsY[i] = next(0.0f, 3.0f);
+        outStreams.extentsZ[i] = next(0.0f, 3.0f);
+
+        Float4 orientation;
+        StoreFloat(QuaternionRotationRollPitchYaw(next(-3.2f, 3.2f), next(-3.2f, 3.2f), next(-3.2f, 3.2f)), &orientation);
+        outStreams.orientationX[i] = orientation.x;
+        outStreams.orientationY[i] = orientation.y;
+        outStreams.orientationZ[i] = orientation.z;
+        outStreams.orientationW[i] = orientation.w;
+    }
+}
+
+template<typename Pass>
+[[nodiscard]] static usize Measure(Tests::ProfileTimingSamples& outSamples, Pass&& pass){
+    usize resultCount = 0u;
+    for(u32 i = 0u; i < s_WarmupCount; ++i)
+        resultCount = pass();
+    for(u32 i = 0u; i < s_SampleCount; ++i){
+        const Timer begin = TimerNow();
+        resultCount = pass();
+        if(!outSamples.append(DurationInSeconds<f64>(TimerNow(), begin)))
+            break;
+    }
+    return resultCount;
+}
+
+template<typename ScalarPass, typename BatchPass>
+static void Compare(Comparison& outComparison, ScalarPass&& scalarPass, BatchPass&& batchPass){
+    outComparison.scalarCount = Measure(outComparison.scalarSamples, scalarPass);
+    outComparison.batchCount = Measure(outComparison.batchSamples, batchPass);
+}
+
+static void RunProfile(Result& outResult){
+    Float4 orientation;
+    StoreFloat(QuaternionRotationRollPitchYaw(0.2f, -0.4f, 0.1f), &orientation);
+    const BoundingFrustum frustum(Float3U(0.0f, 0.0f, -20.0f), orientation, 1.0f, -1.0f, 0.6f, -0.6f, 0.1f, 180.0f);
+    FrustumBatchTests::Planes planes;
+    FrustumBatchTests::LoadPlanes(planes, frustum);
+
+    const Float3U rayOrigin(-250.0f, -10.0f, 5.0f);
+    const Float3U rayDirection(0.98f, 0.14f, -0.14f);
+    const SIMDVector rayOriginVector = LoadFloat(rayOrigin);
+    const SIMDVector rayDirectionVector = Vector3Normalize(LoadFloat(rayDirection));
+    Float3U normalizedRayDirection;
+    StoreFloat(rayDirectionVector, &normalizedRayDirection);
+
+    const BoundingBox query(Float3U(10.0f, -5.0f, 0.0f), Float3U(40.0f, 30.0f, 50.0f));
+    const SIMDMatrix transform = MatrixAffineTransformation(
+        VectorSet(1.5f, 0.5f, 2.0f, 0.0f),
+        VectorZero(),
+        QuaternionRotationRollPitchYaw(0.4f, -1.1f, 2.3f),
+        VectorSet(10.0f, -4.0f, 3.0f, 0.0f)
+    );
+
+    Streams streams;
+    FillStreams(streams);
+    Vector<u32> selected(s_BoundCount, 0u);
+    Vector<f32> distances(s_BoundCount, 0.0f);
+    Streams transformed;
+    transformed.centerX.resize(s_BoundCount);
+    transformed.centerY.resize(s_BoundCount);
+    transformed.centerZ.resize(s_BoundCount);
+    transformed.extentsX.resize(s_BoundCount);
+    transformed.extentsY.resize(s_BoundCount);
+    transformed.extentsZ.resize(s_BoundCount);
+
+    const BoundsBatch::SphereStream spheres{
+        .centerX = streams.centerX.data(),
+        .centerY = streams.centerY.data(),
+        .centerZ = streams.centerZ.data(),
+        .radius = streams.radius.data(),
+    };
+    const BoundsBatch::BoxStream boxes{
+        .centerX = streams.centerX.data(),
+        .centerY = streams.centerY.data(),
+        .centerZ = streams.centerZ.data(),
+        .extentsX = streams.extentsX.data(),
+        .extentsY = streams.extentsY.data(),
+        .extentsZ = streams.extentsZ.data(),
+    };
+    const BoundsBatch::OrientedBoxStream orientedBoxes{
+        .centerX = streams.centerX.data(),
+        .centerY = streams.centerY.data(),
+        .centerZ = streams.centerZ.data(),
+        .extentsX = streams.extentsX.data(),
+        .extentsY = streams.extentsY.data(),
+        .extentsZ = streams.extentsZ.data(),
+        .orientationX = streams.orientationX.data(),
+        .orientationY = streams.orientationY.data(),
+        .orientationZ = streams.orientationZ.data(),
+        .orientationW = streams.orientationW.data(),
+    };
+    const BoundsBatch::BoxOutputStream transformedBoxes{
+        .centerX = transformed.centerX.data(),
+        .centerY = transformed.centerY.data(),
+        .centerZ = transformed.centerZ.data(),
+        .extentsX = transformed.extentsX.data(),
+        .extentsY = transformed.extentsY.data(),
+        .extentsZ = transformed.extentsZ.data(),
+    };
+
+    const auto sphereAt = [&streams](const u32 i){
+        return BoundingSphere(Float3U(streams.centerX[i], streams.centerY[i], streams.centerZ[i]), streams.radius[i]);
+    };
+    const auto boxAt = [&streams](const u32 i){
+        return BoundingBox(
+            Float3U(streams.centerX[i], streams.centerY[i], streams.centerZ[i]),
+            Float3U(streams.extentsX[i], streams.extentsY[i], streams.extentsZ[i])
+        );
+    };
+    const auto orientedBoxAt = [&streams](const u32 i){
+        return BoundingOrientedBox(
+            Float3U(streams.centerX[i], streams.centerY[i], streams.centerZ[i]),
+            Float3U(streams.extentsX[i], streams.extentsY[i], streams.extentsZ[i]),
+            Float4(streams.orientationX[i], streams.orientationY[i], streams.orientationZ[i], streams.orientationW[i])
+        );
+    };
+    // Transform passes report how many results land in the +x half-space so both paths yield a comparable count.
+    const auto countPositiveCenters = [&transformed](){
+        usize positiveCount = 0u;
+        for(u32 i = 0u; i < s_BoundCount; ++i)
+            positiveCount += transformed.centerX[i] > 0.0f ? 1u : 0u;
+        return positiveCount;
+    };
+
+    Compare(
+        outResult.frustumSpheres,
+        [&](){
+            usize visibleCount = 0u;
+            for(u32 i = 0u; i < s_BoundCount; ++i){
+                selected[visibleCount] = i;
+                visibleCount += frustum.intersects(sphereAt(i)) ? 1u : 0u;
+            }
+            return visibleCount;
+        },
+        [&](){ return FrustumBatchTests::CullSpheres(planes, spheres, s_BoundCount, selected.data()); }
+    );
+    Compare(
+        outResult.frustumBoxes,
+        [&](){
+            usize visibleCount = 0u;
+            for(u32 i = 0u; i < s_BoundCount; ++i){
+                selected[visibleCount] = i;
+                visibleCount += frustum.intersects(boxAt(i)) ? 1u : 0u;
+            }
+            return visibleCount;
+        },
+        [&](){ return FrustumBatchTests::CullBoxes(planes, boxes, s_BoundCount, selected.data()); }
+    );
+    Compare(
+        outResult.frustumOrientedBoxes,
+        [&](){
+            usize visibleCount = 0u;
+            for(u32 i = 0u; i < s_BoundCount; ++i){
+                selected[visibleCount] = i;
+                visibleCount += frustum.intersects(orientedBoxAt(i)) ? 1u : 0u;
+            }
+            return visibleCount;
+        },
+        [&](){ return FrustumBatchTests::CullOrientedBoxes(planes, orientedBoxes, s_BoundCount, selected.data()); }
+    );
+    Compare(
+        outResult.rayBoxes,
+        [&](){
+            usize hitCount = 0u;
+            for(u32 i = 0u; i < s_BoundCount; ++i){
+                f32 distance = 0.0f;
+                if(boxAt(i).intersects(rayOriginVector, rayDirectionVector, distance)){
+                    selected[hitCount] = i;
+                    distances[hitCount] = distance;
+                    ++hitCount;
+                }
+            }
+            return hitCount;
+        },
+        [&](){
+            return RayBatchTests::IntersectBoxes(rayOrigin, normalizedRayDirection, boxes, s_BoundCount, selected.data(), distances.data());
+        }
+    );
+    Compare(
+        outResult.rayOrientedBoxes,
+        [&](){
+            usize hitCount = 0u;
+            for(u32 i = 0u; i < s_BoundCount; ++i){
+                f32 distance = 0.0f;
+                if(orientedBoxAt(i).intersects(rayOriginVector, rayDirectionVector, distance)){
+                    selected[hitCount] = i;
+                    distances[hitCount] = distance;
+                    ++hitCount;
+                }
+            }
+            return hitCount;
+        },
+        [&](){
+            return RayBatchTests::IntersectOrientedBoxes(
+                rayOrigin,
+                normalizedRayDirection,
+                orientedBoxes,
+                s_BoundCount,
+                selected.data(),
+                distances.data()
+            );
+        }
+    );
+    Compare(
+        outResult.aabbOrientedBoxes,
+        [&](){
+            usize overlapCount = 0u;
+            for(u32 i = 0u; i < s_BoundCount; ++i){
+                selected[overlapCount] = i;
+                overlapCount += query.intersects(orientedBoxAt(i)) ? 1u : 0u;
+            }
+            return overlapCount;
+        },
+        [&](){ return AabbBatchTests::OverlapOrientedBoxes(query, orientedBoxes, s_BoundCount, selected.data()); }
+    );
+    Compare(
+        outResult.transformBoxes,
+        [&](){
+            for(u32 i = 0u; i < s_BoundCount; ++i){
+                BoundingBox box;
+                boxAt(i).transform(box, transform);
+                transformed.centerX[i] = box.center.x;
+                transformed.centerY[i] = box.center.y;
+                transformed.centerZ[i] = box.center.z;
+                transformed.extentsX[i] = box.extents.x;
+                transformed.extentsY[i] = box.extents.y;
+                transformed.extentsZ[i] = box.extents.z;
+            }
+            return countPositiveCenters();
+        },
+        [&](){
+            AabbBatchTests::TransformBoxes(transform, boxes, s_BoundCount, transformedBoxes);
+            return countPositiveCenters();
+        }
+    );
+}
+
+static void EmitComparison(const char* name, const Comparison& comparison){
+    NWB_COUT << '"' << name << "\":{\"count\":" << comparison.batchCount << ',';
+    Tests::EmitProfileTiming("scalar", comparison.scalarSamples);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming("batch", comparison.batchSamples);
+    NWB_COUT << '}';
+}
+
+[[nodiscard]] static bool Matched(const Comparison& comparison){
+    return comparison.scalarCount == comparison.batchCount;
+}
+
+static void EmitResult(const Result& result, const bool matched){
+    NWB_COUT
+        << "{\"status\":\"" << (matched ? "ok" : "failed") << "\","
+        << "\"lanes\":" << BoundsBatch::s_LaneCount << ','
+        << "\"active_lanes\":" << BoundsBatch::ActiveLaneCount() << ','
+        << "\"bounds\":" << s_BoundCount << ','
+        << "\"samples\":" << s_SampleCount << ','
+    ;
+    EmitComparison("frustum_spheres", result.frustumSpheres);
+    NWB_COUT << ',';
+    EmitComparison("frustum_boxes", result.frustumBoxes);
+    NWB_COUT << ',';
+    EmitComparison("frustum_oriented_boxes", result.frustumOrientedBoxes);
+    NWB_COUT << ',';
+    EmitComparison("ray_boxes", result.rayBoxes);
+    NWB_COUT << ',';
+    EmitComparison("ray_oriented_boxes", result.rayOrientedBoxes);
+    NWB_COUT << ',';
+    EmitComparison("aabb_oriented_boxes", result.aabbOrientedBoxes);
+    NWB_COUT << ',';
+    EmitComparison("transform_boxes", result.transformBoxes);
+    NWB_COUT << "}\n";
+}
+
+[[nodiscard]] static int EntryPoint(const isize, tchar**, void*){
+    Core::Common::InitializerGuard commonInitializerGuard;
+    if(!commonInitializerGuard.initialize()){
+        NWB_CERR << "collision batch profile initialization failed\n";
+        return 1;
+    }
+
+    Result result;
+    RunProfile(result);
+    // Boundary rounding may differ from the AoS math, but a random corpus never lands on a boundary exactly.
+    const bool matched = Matched(result.frustumSpheres)
+        && Matched(result.frustumBoxes)
+        && Matched(result.frustumOrientedBoxes)
+        && Matched(result.rayBoxes)
+        && Matched(result.rayOrientedBoxes)
+        && Matched(result.aabbOrientedBoxes)
+        && Matched(result.transformBoxes)
+    ;
+    EmitResult(result, matched);
+    return matched ? 0 : 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_DEFINE_APPLICATION_ENTRY_POINT(::NWB::CollisionBatchProfile::EntryPoint)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,493 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+inline constexpr u32 s_CollisionBatchBoundCount = 4099u;
+inline constexpr f32 s_CollisionBatchBoundaryTolerance = 0.0001f;
+
+
+struct CollisionBatchRandom{
+    u64 state = 0x9e3779b97f4a7c15ull;
+
+    [[nodiscard]] f32 next(const f32 minimum, const f32 maximum){
+        state ^= state << 13u;
+        state ^= state >> 7u;
+        state ^= state << 17u;
+        const f32 unit = static_cast<f32>(state >> 40u) * (1.0f / 16777216.0f);
+        return minimum + (maximum - minimum) * unit;
+    }
+};
+
+struct CollisionBatchStreams{
+    Vector<f32> centerX;
+    Vector<f32> centerY;
+    Vector<f32> centerZ;
+    Vector<f32> radius;
+    Vector<f32> extentsX;
+    Vector<f32> extentsY;
+    Vector<f32> extentsZ;
+    Vector<f32> orientationX;
+    Vector<f32> orientationY;
+    Vector<f32> orientationZ;
+    Vector<f32> orientationW;
+
+    [[nodiscard]] BoundsBatch::SphereStream spheres()const{
+        return BoundsBatch::SphereStream{
+            .centerX = centerX.data(),
+            .centerY = centerY.data(),
+            .centerZ = centerZ.data(),
+            .radius = radius.data(),
+        };
+    }
+    [[nodiscard]] BoundsBatch::BoxStream boxes()const{
+        return BoundsBatch::BoxStream{
+            .centerX = centerX.data(),
+            .centerY = centerY.data(),
+            .centerZ = centerZ.data(),
+            .extentsX = extentsX.data(),
+            .extentsY = extentsY.data(),
+            .extentsZ = extentsZ.data(),
+        };
+    }
+    [[nodiscard]] BoundsBatch::OrientedBoxStream orientedBoxes()const{
+        return BoundsBatch::OrientedBoxStream{
+            .centerX = centerX.data(),
+            .centerY = centerY.data(),
+            .centerZ = centerZ.data(),
+            .extentsX = extentsX.data(),
+            .extentsY = extentsY.data(),
+            .extentsZ = extentsZ.data(),
+            .orientationX = orientationX.data(),
+            .orientationY = orientationY.data(),
+            .orientationZ = orientationZ.data(),
+            .orientationW = orientationW.data(),
+        };
+    }
+
+    // Scalar bounds for element `i`, with the radius or extents scaled so tests can probe whether a bound sits on a
+    // decision boundary.
+    [[nodiscard]] BoundingSphere sphere(const u32 i, const f32 scale = 1.0f)const{
+        return BoundingSphere(Float3U(centerX[i], centerY[i], centerZ[i]), radius[i] * scale);
+    }
+    [[nodiscard]] BoundingBox box(const u32 i, const f32 scale = 1.0f)const{
+        return BoundingBox(
+            Float3U(centerX[i], centerY[i], centerZ[i]),
+            Float3U(extentsX[i] * scale, extentsY[i] * scale, extentsZ[i] * scale)
+        );
+    }
+    [[nodiscard]] BoundingOrientedBox orientedBox(const u32 i, const f32 scale = 1.0f)const{
+        return BoundingOrientedBox(
+            Float3U(centerX[i], centerY[i], centerZ[i]),
+            Float3U(extentsX[i] * scale, extentsY[i] * scale, extentsZ[i] * scale),
+            Float4(orientationX[i], orientationY[i], orientationZ[i], orientationW[i])
+        );
+    }
+};
+
+// Walks a compacted batch selection alongside the full index range.
+struct CollisionBatchSelection{
+    const u32* indices = nullptr;
+    usize count = 0u;
+    usize cursor = 0u;
+
+    [[nodiscard]] bool next(const u32 index){
+        if(cursor >= count || indices[cursor] != index)
+            return false;
+        ++cursor;
+        return true;
+    }
+};
+
+
+[[nodiscard]] static BoundingFrustum MakeCollisionBatchFrustum(){
+    Float4 orientation;
+    StoreFloat(QuaternionRotationRollPitchYaw(0.3f, 0.7f, -0.2f), &orientation);
+    return BoundingFrustum(Float3U(4.0f, -2.0f, 1.0f), orientation, 1.2f, -0.8f, 0.9f, -0.6f, 0.5f, 60.0f);
+}
+
+static void FillCollisionBatchStreams(CollisionBatchStreams& outStreams, const u32 count){
+    CollisionBatchRandom random;
+    for(u32 i = 0u; i < count; ++i){
+        outStreams.centerX.push_back(random.next(-80.0f, 80.0f));
+        outStreams.centerY.push_back(random.next(-80.0f, 80.0f));
+        outStreams.centerZ.push_back(random.next(-80.0f, 80.0f));
+        outStreams.radius.push_back(random.next(0.0f, 6.0f));
+        outStreams.extentsX.push_back(random.next(0.0f, 5.0f));
+        outStreams.extentsY.push_back(random.next(0.0f, 5.0f));
+        outStreams.extentsZ.push_back(random.next(0.0f, 5.0f));
+
+        Float4 orientation;
+        StoreFloat(QuaternionRotationRollPitchYaw(random.next(-3.2f, 3.2f), random.next(-3.2f, 3.2f), random.next(-3.2f, 3.2f)), &orientation);
+        outStreams.orientationX.push_back(orientation.x);
+        outStreams.orientationY.push_back(orientation.y);
+        outStreams.orientationZ.push_back(orientation.z);
+        outStreams.orientationW.push_back(orientation.w);
+    }
+}
+
+// A batch answer may differ from the scalar one only where shrinking or growing the bound slightly flips the scalar
+// answer, i.e. where rounding alone decides.
+template<typename ScalarTest>
+[[nodiscard]] static bool CollisionBatchOnBoundary(const ScalarTest& scalarTest){
+    return scalarTest(1.0f - s_CollisionBatchBoundaryTolerance) != scalarTest(1.0f + s_CollisionBatchBoundaryTolerance);
+}
+
+[[nodiscard]] static bool CollisionBatchSameDistance(const f32 lhs, const f32 rhs){
+    return NearlyEqual(lhs, rhs, 0.001f * (1.0f + Abs(lhs)));
+}
+
+// Runs `body` under every SimdKernelTier this CPU supports, then restores the tier that was active.
+template<typename Body>
+static void ForEachSimdKernelTier(const Body& body){
+    const SimdKernelTier::Enum activeTier = ActiveSimdKernelTier();
+    for(u8 tier = 0u; tier < SimdKernelTier::kCount; ++tier){
+        if(!SetActiveSimdKernelTier(static_cast<SimdKernelTier::Enum>(tier)))
+            continue;
+        SCOPED_TRACE(testing::Message() << "SimdKernelTier " << static_cast<u32>(tier) << ", " << BoundsBatch::ActiveLaneCount() << " lanes");
+        body();
+    }
+    EXPECT_TRUE(SetActiveSimdKernelTier(activeTier));
+}
+
+[[nodiscard]] static bool CollisionBatchNearPlane(const SIMDVector plane, const SIMDVector center, const f32 radius){
+    const f32 distance = VectorGetX(PlaneTests::Distance(plane, center));
+    return Abs(distance + radius) <= s_CollisionBatchBoundaryTolerance * (1.0f + Abs(radius));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TEST(Math, FrustumBatchLoadPlanesMatchesFrustumPlanes){
+    const BoundingFrustum frustum = MakeCollisionBatchFrustum();
+    SIMDVector planes[FrustumBatchTests::s_PlaneCount];
+    frustum.getPlanes(&planes[0], &planes[1], &planes[2], &planes[3], &planes[4], &planes[5]);
+
+    FrustumBatchTests::Planes batchPlanes;
+    FrustumBatchTests::LoadPlanes(batchPlanes, frustum);
+    for(u32 planeIndex = 0u; planeIndex < FrustumBatchTests::s_PlaneCount; ++planeIndex){
+        EXPECT_TRUE(NearlyEqual4(
+            planes[planeIndex],
+            batchPlanes.normalX[planeIndex],
+            batchPlanes.normalY[planeIndex],
+            batchPlanes.normalZ[planeIndex],
+            batchPlanes.distance[planeIndex]
+        ));
+        EXPECT_EQ(batchPlanes.absNormalX[planeIndex], Abs(batchPlanes.normalX[planeIndex]));
+    }
+}
+
+TEST(Math, FrustumBatchSpheresMatchScalarIntersects){
+    const BoundingFrustum frustum = MakeCollisionBatchFrustum();
+    SIMDVector planes[FrustumBatchTests::s_PlaneCount];
+    frustum.getPlanes(&planes[0], &planes[1], &planes[2], &planes[3], &planes[4], &planes[5]);
+    FrustumBatchTests::Planes batchPlanes;
+    FrustumBatchTests::LoadPlanes(batchPlanes, frustum);
+
+    CollisionBatchStreams streams;
+    FillCollisionBatchStreams(streams, s_CollisionBatchBoundCount);
+    ForEachSimdKernelTier([&](){
+        Vector<u32> visible(s_CollisionBatchBoundCount, 0u);
+        const usize visibleCount = FrustumBatchTests::CullSpheres(
+            batchPlanes,
+            streams.spheres(),
+            s_CollisionBatchBoundCount,
+            visible.data()
+        );
+        ASSERT_GT(visibleCount, 0u);
+        ASSERT_LT(visibleCount, static_cast<usize>(s_CollisionBatchBoundCount));
+
+        usize cursor = 0u;
+        for(u32 i = 0u; i < s_CollisionBatchBoundCount; ++i){
+            const bool batchVisible = cursor < visibleCount && visible[cursor] == i;
+            if(batchVisible)
+                ++cursor;
+
+            const BoundingSphere sphere = streams.sphere(i);
+            if(batchVisible != frustum.intersects(sphere)){
+                bool nearBoundary = false;
+                for(u32 planeIndex = 0u; planeIndex < FrustumBatchTests::s_PlaneCount; ++planeIndex)
+                    nearBoundary = nearBoundary || CollisionBatchNearPlane(planes[planeIndex], LoadFloat(sphere.centerRadius), streams.radius[i]);
+                EXPECT_TRUE(nearBoundary) << "sphere " << i;
+            }
+        }
+        EXPECT_EQ(cursor, visibleCount);
+    });
+}
+
+TEST(Math, FrustumBatchBoxesMatchScalarIntersects){
+    const BoundingFrustum frustum = MakeCollisionBatchFrustum();
+    SIMDVector planes[FrustumBatchTests::s_PlaneCount];
+    frustum.getPlanes(&planes[0], &planes[1], &planes[2], &planes[3], &planes[4], &planes[5]);
+    FrustumBatchTests::Planes batchPlanes;
+    FrustumBatchTests::LoadPlanes(batchPlanes, frustum);
+
+    CollisionBatchStreams streams;
+    FillCollisionBatchStreams(streams, s_CollisionBatchBoundCount);
+    ForEachSimdKernelTier([&](){
+        Vector<u32> visible(s_CollisionBatchBoundCount, 0u);
+        const usize visibleCount = FrustumBatchTests::CullBoxes(
+            batchPlanes,
+            streams.boxes(),
+            s_CollisionBatchBoundCount,
+            visible.data()
+        );
+        ASSERT_GT(visibleCount, 0u);
+        ASSERT_LT(visibleCount, static_cast<usize>(s_CollisionBatchBoundCount));
+
+        usize cursor = 0u;
+        for(u32 i = 0u; i < s_CollisionBatchBoundCount; ++i){
+            const bool batchVisible = cursor < visibleCount && visible[cursor] == i;
+            if(batchVisible)
+                ++cursor;
+
+            const BoundingBox box = streams.box(i);
+            if(batchVisible != frustum.intersects(box)){
+                bool nearBoundary = false;
+                for(u32 planeIndex = 0u; planeIndex < FrustumBatchTests::s_PlaneCount; ++planeIndex){
+                    const f32 radius = VectorGetX(Vector3Dot(LoadFloat(box.extents), VectorAbs(planes[planeIndex])));
+                    nearBoundary = nearBoundary || CollisionBatchNearPlane(planes[planeIndex], LoadFloat(box.center), radius);
+                }
+                EXPECT_TRUE(nearBoundary) << "box " << i;
+            }
+        }
+        EXPECT_EQ(cursor, visibleCount);
+    });
+}
+
+TEST(Math, FrustumBatchHandlesTailsAndDegenerateBounds){
+    FrustumBatchTests::Planes batchPlanes;
+    FrustumBatchTests::LoadPlanes(
+        batchPlanes,
+        BoundingFrustum(Float3U(0.0f, 0.0f, 0.0f), Float4(0.0f, 0.0f, 0.0f, 1.0f), 1.0f, -1.0f, 1.0f, -1.0f, 0.5f, 60.0f)
+    );
+
+    const f32 centerX[] = { 0.0f, 400.0f, 0.0f };
+    const f32 centerY[] = { 0.0f, 0.0f, 0.0f };
+    const f32 centerZ[] = { 10.0f, 0.0f, 10.0f };
+    const f32 radius[] = { 0.0f, 1.0f, Limit<f32>::s_QuietNaN };
+    u32 visible[LengthOf(centerX)] = {};
+
+    const BoundsBatch::SphereStream spheres{ .centerX = centerX, .centerY = centerY, .centerZ = centerZ, .radius = radius };
+    EXPECT_EQ(FrustumBatchTests::CullSpheres(batchPlanes, spheres, 0u, visible), 0u);
+    ASSERT_EQ(FrustumBatchTests::CullSpheres(batchPlanes, spheres, LengthOf(centerX), visible), 2u);
+    EXPECT_EQ(visible[0], 0u);
+    EXPECT_EQ(visible[1], 2u);
+}
+
+TEST(Math, FrustumBatchOrientedBoxesMatchScalarIntersects){
+    const BoundingFrustum frustum = MakeCollisionBatchFrustum();
+    FrustumBatchTests::Planes batchPlanes;
+    FrustumBatchTests::LoadPlanes(batchPlanes, frustum);
+
+    CollisionBatchStreams streams;
+    FillCollisionBatchStreams(streams, s_CollisionBatchBoundCount);
+    ForEachSimdKernelTier([&](){
+        Vector<u32> visible(s_CollisionBatchBoundCount, 0u);
+        const usize visibleCount = FrustumBatchTests::CullOrientedBoxes(
+            batchPlanes,
+            streams.orientedBoxes(),
+            s_CollisionBatchBoundCount,
+            visible.data()
+        );
+        ASSERT_GT(visibleCount, 0u);
+        ASSERT_LT(visibleCount, static_cast<usize>(s_CollisionBatchBoundCount));
+
+        CollisionBatchSelection selection{ .indices = visible.data(), .count = visibleCount };
+        for(u32 i = 0u; i < s_CollisionBatchBoundCount; ++i){
+            if(selection.next(i) != frustum.intersects(streams.orientedBox(i))){
+                EXPECT_TRUE(CollisionBatchOnBoundary([&](const f32 scale){ return frustum.intersects(streams.orientedBox(i, scale)); }))
+                    << "oriented box " << i
+                ;
+            }
+        }
+        EXPECT_EQ(selection.cursor, visibleCount);
+    });
+}
+
+TEST(Math, PlaneBatchMatchesScalarIntersects){
+    CollisionBatchStreams streams;
+    FillCollisionBatchStreams(streams, s_CollisionBatchBoundCount);
+
+    const SIMDVector plane = PlaneTests::FromPointNormal(
+        VectorSet(0.3f, -0.8f, 0.5f, 0.0f),
+        VectorSet(4.0f, -2.0f, 1.0f, 0.0f),
+        VectorSet(0.0f, 1.0f, 0.0f, 0.0f)
+    );
+    Float4 planeValue;
+    StoreFloat(plane, &planeValue);
+
+    Vector<PlaneIntersectionType::Enum> results(s_CollisionBatchBoundCount, PlaneIntersectionType::Intersecting);
+    const auto check = [&](const char* label, const auto& scalarClassify){
+        usize resultCounts[3] = {};
+        for(u32 i = 0u; i < s_CollisionBatchBoundCount; ++i){
+            ++resultCounts[results[i]];
+            if(results[i] != scalarClassify(i, 1.0f)){
+                EXPECT_TRUE(CollisionBatchOnBoundary([&](const f32 scale){ return scalarClassify(i, scale); }))
+                    << label << ' ' << i
+                ;
+            }
+        }
+        EXPECT_GT(resultCounts[PlaneIntersectionType::Front], 0u) << label;
+        EXPECT_GT(resultCounts[PlaneIntersectionType::Intersecting], 0u) << label;
+        EXPECT_GT(resultCounts[PlaneIntersectionType::Back], 0u) << label;
+    };
+
+    PlaneBatchTests::ClassifySpheres(planeValue, streams.spheres(), s_CollisionBatchBoundCount, results.data());
+    check("sphere", [&](const u32 i, const f32 scale){ return streams.sphere(i, scale).intersects(plane); });
+    PlaneBatchTests::ClassifyBoxes(planeValue, streams.boxes(), s_CollisionBatchBoundCount, results.data());
+    check("box", [&](const u32 i, const f32 scale){ return streams.box(i, scale).intersects(plane); });
+    PlaneBatchTests::ClassifyOrientedBoxes(planeValue, streams.orientedBoxes(), s_CollisionBatchBoundCount, results.data());
+    check("oriented box", [&](const u32 i, const f32 scale){ return streams.orientedBox(i, scale).intersects(plane); });
+}
+
+TEST(Math, RayBatchMatchesScalarIntersects){
+    CollisionBatchStreams streams;
+    FillCollisionBatchStreams(streams, s_CollisionBatchBoundCount);
+
+    Vector<u32> hits(s_CollisionBatchBoundCount, 0u);
+    Vector<f32> distances(s_CollisionBatchBoundCount, 0.0f);
+    const auto check = [&](const char* label, const usize hitCount, const auto& scalarIntersects){
+        CollisionBatchSelection selection{ .indices = hits.data(), .count = hitCount };
+        for(u32 i = 0u; i < s_CollisionBatchBoundCount; ++i){
+            const bool batchHit = selection.next(i);
+            f32 scalarDistance = 0.0f;
+            const bool scalarHit = scalarIntersects(i, 1.0f, scalarDistance);
+            if(batchHit != scalarHit){
+                EXPECT_TRUE(CollisionBatchOnBoundary([&](const f32 scale){
+                    f32 distance = 0.0f;
+                    return scalarIntersects(i, scale, distance);
+                })) << label << ' ' << i;
+            }
+            else if(batchHit)
+                EXPECT_TRUE(CollisionBatchSameDistance(distances[selection.cursor - 1u], scalarDistance)) << label << ' ' << i;
+        }
+        EXPECT_EQ(selection.cursor, hitCount) << label;
+    };
+
+    // Axis-aligned directions take the parallel-slab path.
+    const Float3U directions[] = {
+        Float3U(0.6f, -0.48f, 0.64f),
+        Float3U(1.0f, 0.0f, 0.0f),
+        Float3U(0.0f, -1.0f, 0.0f),
+        Float3U(-0.267261f, 0.534522f, -0.801784f),
+    };
+    CollisionBatchRandom random;
+    usize sphereHits = 0u;
+    usize boxHits = 0u;
+    usize orientedBoxHits = 0u;
+    for(u32 rayIndex = 0u; rayIndex < 16u; ++rayIndex){
+        const Float3U origin(random.next(-60.0f, 60.0f), random.next(-60.0f, 60.0f), random.next(-60.0f, 60.0f));
+        const Float3U& direction = directions[rayIndex % LengthOf(directions)];
+        const SIMDVector originVector = LoadFloat(origin);
+        const SIMDVector directionVector = LoadFloat(direction);
+
+        usize hitCount = RayBatchTests::IntersectSpheres(origin, direction, streams.spheres(), s_CollisionBatchBoundCount, hits.data(), distances.data());
+        sphereHits += hitCount;
+        check("sphere", hitCount, [&](const u32 i, const f32 scale, f32& outDistance){
+            return streams.sphere(i, scale).intersects(originVector, directionVector, outDistance);
+        });
+
+        hitCount = RayBatchTests::IntersectBoxes(origin, direction, streams.boxes(), s_CollisionBatchBoundCount, hits.data(), distances.data());
+        boxHits += hitCount;
+        check("box", hitCount, [&](const u32 i, const f32 scale, f32& outDistance){
+            return streams.box(i, scale).intersects(originVector, directionVector, outDistance);
+        });
+
+        hitCount = RayBatchTests::IntersectOrientedBoxes(origin, direction, streams.orientedBoxes(), s_CollisionBatchBoundCount, hits.data(), distances.data());
+        orientedBoxHits += hitCount;
+        check("oriented box", hitCount, [&](const u32 i, const f32 scale, f32& outDistance){
+            return streams.orientedBox(i, scale).intersects(originVector, directionVector, outDistance);
+        });
+    }
+    EXPECT_GT(sphereHits, 0u);
+    EXPECT_GT(boxHits, 0u);
+    EXPECT_GT(orientedBoxHits, 0u);
+}
+
+TEST(Math, AabbBatchOverlapMatchesScalarIntersects){
+    CollisionBatchStreams streams;
+    FillCollisionBatchStreams(streams, s_CollisionBatchBoundCount);
+
+    Vector<u32> overlaps(s_CollisionBatchBoundCount, 0u);
+    const auto check = [&](const char* label, const usize overlapCount, const auto& scalarIntersects){
+        CollisionBatchSelection selection{ .indices = overlaps.data(), .count = overlapCount };
+        for(u32 i = 0u; i < s_CollisionBatchBoundCount; ++i){
+            if(selection.next(i) != scalarIntersects(i, 1.0f))
+                EXPECT_TRUE(CollisionBatchOnBoundary([&](const f32 scale){ return scalarIntersects(i, scale); })) << label << ' ' << i;
+        }
+        EXPECT_EQ(selection.cursor, overlapCount) << label;
+    };
+
+    CollisionBatchRandom random;
+    usize totalOverlaps = 0u;
+    for(u32 queryIndex = 0u; queryIndex < 8u; ++queryIndex){
+        const BoundingBox query(
+            Float3U(random.next(-60.0f, 60.0f), random.next(-60.0f, 60.0f), random.next(-60.0f, 60.0f)),
+            Float3U(random.next(4.0f, 24.0f), random.next(4.0f, 24.0f), random.next(4.0f, 24.0f))
+        );
+
+        usize overlapCount = AabbBatchTests::OverlapSpheres(query, streams.spheres(), s_CollisionBatchBoundCount, overlaps.data());
+        totalOverlaps += overlapCount;
+        check("sphere", overlapCount, [&](const u32 i, const f32 scale){ return query.intersects(streams.sphere(i, scale)); });
+
+        overlapCount = AabbBatchTests::OverlapBoxes(query, streams.boxes(), s_CollisionBatchBoundCount, overlaps.data());
+        totalOverlaps += overlapCount;
+        check("box", overlapCount, [&](const u32 i, const f32 scale){ return query.intersects(streams.box(i, scale)); });
+
+        overlapCount = AabbBatchTests::OverlapOrientedBoxes(query, streams.orientedBoxes(), s_CollisionBatchBoundCount, overlaps.data());
+        totalOverlaps += overlapCount;
+        check("oriented box", overlapCount, [&](const u32 i, const f32 scale){ return query.intersects(streams.orientedBox(i, scale)); });
+    }
+    EXPECT_GT(totalOverlaps, 0u);
+}
+
+TEST(Math, AabbBatchTransformMatchesScalarTransform){
+    CollisionBatchStreams streams;
+    FillCollisionBatchStreams(streams, s_CollisionBatchBoundCount);
+
+    const SIMDMatrix matrix = MatrixAffineTransformation(
+        VectorSet(1.5f, 0.5f, 2.0f, 0.0f),
+        VectorZero(),
+        QuaternionRotationRollPitchYaw(0.4f, -1.1f, 2.3f),
+        VectorSet(10.0f, -4.0f, 3.0f, 0.0f)
+    );
+
+    ForEachSimdKernelTier([&](){
+        // Transformed in place to cover the aliasing contract.
+        CollisionBatchStreams transformed = streams;
+        AabbBatchTests::TransformBoxes(
+            matrix,
+            transformed.boxes(),
+            s_CollisionBatchBoundCount,
+            BoundsBatch::BoxOutputStream{
+                .centerX = transformed.centerX.data(),
+                .centerY = transformed.centerY.data(),
+                .centerZ = transformed.centerZ.data(),
+                .extentsX = transformed.extentsX.data(),
+                .extentsY = transformed.extentsY.data(),
+                .extentsZ = transformed.extentsZ.data(),
+            }
+        );
+
+        for(u32 i = 0u; i < s_CollisionBatchBoundCount; ++i){
+            BoundingBox expected;
+            streams.box(i).transform(expected, matrix);
+            const BoundingBox actual = transformed.box(i);
+            EXPECT_TRUE(
+                CollisionBatchSameDistance(actual.center.x, expected.center.x)
+                && CollisionBatchSameDistance(actual.center.y, expected.center.y)
+                && CollisionBatchSameDistance(actual.center.z, expected.center.z)
+            ) << "box " << i;
+            EXPECT_TRUE(
+                CollisionBatchSameDistance(actual.extents.x, expected.extents.x)
+                && CollisionBatchSameDistance(actual.extents.y, expected.extents.y)
+                && CollisionBatchSameDistance(actual.extents.z, expected.extents.z)
+            ) << "box " << i;
+        }
+    });
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -9,6 +9,7 @@
 
 #include <global/simdmath.h>
 #include <global/compile.h>
+#include <global/cpu_topology.h>
 #include <global/limit.h>
 #include <global/simplemath.h>
 
@@ -25,6 +26,8 @@ namespace __hidden_math_tests{
 using NWB::Tests::NearlyEqual;
 using NWB::Tests::NearlyEqual3;
 using NWB::Tests::NearlyEqual4;
+template<typename T>
+using Vector = NWB::Tests::TestVector<T>;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -769,6 +772,13 @@ TEST(Math, MathStorageHashAndEquality){
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include "collision_batch_tests.inl"
+#include "quaternion_batch_tests.inl"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 };
 
 
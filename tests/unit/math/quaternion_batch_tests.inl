@@ -0,0 +1,134 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Deliberately not a multiple of any lane width so the scalar tail runs too.
+inline constexpr u32 s_QuaternionBatchCount = 37u;
+inline constexpr f32 s_QuaternionBatchTolerance = 0.00001f;
+
+
+struct QuaternionBatchStreams{
+    Vector<f32> x;
+    Vector<f32> y;
+    Vector<f32> z;
+    Vector<f32> w;
+
+    void resize(const usize count){
+        x.resize(count, 0.0f);
+        y.resize(count, 0.0f);
+        z.resize(count, 0.0f);
+        w.resize(count, 0.0f);
+    }
+
+    [[nodiscard]] QuaternionBatch::Stream stream(){ return { x.data(), y.data(), z.data(), w.data() }; }
+    [[nodiscard]] Float4 get(const usize index)const{ return Float4(x[index], y[index], z[index], w[index]); }
+    void set(const usize index, const Float4& value){
+        x[index] = value.x;
+        y[index] = value.y;
+        z[index] = value.z;
+        w[index] = value.w;
+    }
+};
+
+
+static void FillQuaternionBatchStreams(QuaternionBatchStreams& outStreams, CollisionBatchRandom& random, const u32 count){
+    outStreams.resize(count);
+    for(u32 i = 0u; i < count; ++i){
+        Float4 rotation;
+        StoreFloat(QuaternionRotationRollPitchYaw(random.next(-3.0f, 3.0f), random.next(-3.0f, 3.0f), random.next(-3.0f, 3.0f)), &rotation);
+        outStreams.set(i, rotation);
+    }
+}
+
+[[nodiscard]] static Float4 ReferenceQuaternionNlerp(const Float4& from, const Float4& to, const f32 factor){
+    const SIMDVector fromValue = LoadFloat(from);
+    SIMDVector toValue = LoadFloat(to);
+    if(VectorGetX(Vector4Dot(fromValue, toValue)) < 0.0f)
+        toValue = VectorNegate(toValue);
+
+    Float4 result;
+    StoreFloat(QuaternionNormalize(VectorLerp(fromValue, toValue, factor)), &result);
+    return result;
+}
+
+[[nodiscard]] static bool QuaternionBatchNearEqual(const Float4& lhs, const Float4& rhs){
+    return Abs(lhs.x - rhs.x) <= s_QuaternionBatchTolerance
+        && Abs(lhs.y - rhs.y) <= s_QuaternionBatchTolerance
+        && Abs(lhs.z - rhs.z) <= s_QuaternionBatchTolerance
+        && Abs(lhs.w - rhs.w) <= s_QuaternionBatchTolerance
+    ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TEST(Math, QuaternionBatchNlerpMatchesScalarShortestArc){
+    CollisionBatchRandom random;
+    QuaternionBatchStreams from;
+    QuaternionBatchStreams to;
+    QuaternionBatchStreams out;
+    FillQuaternionBatchStreams(from, random, s_QuaternionBatchCount);
+    FillQuaternionBatchStreams(to, random, s_QuaternionBatchCount);
+    out.resize(s_QuaternionBatchCount);
+
+    Vector<f32> factors;
+    for(u32 i = 0u; i < s_QuaternionBatchCount; ++i)
+        factors.push_back(random.next(0.0f, 1.0f));
+
+    QuaternionBatch::Nlerp(from.stream(), to.stream(), factors.data(), s_QuaternionBatchCount, out.stream());
+    for(u32 i = 0u; i < s_QuaternionBatchCount; ++i)
+        EXPECT_TRUE(QuaternionBatchNearEqual(out.get(i), ReferenceQuaternionNlerp(from.get(i), to.get(i), factors[i]))) << "lane " << i;
+}
+
+TEST(Math, QuaternionBatchNlerpOutputMayAliasInput){
+    CollisionBatchRandom random;
+    QuaternionBatchStreams from;
+    QuaternionBatchStreams to;
+    FillQuaternionBatchStreams(from, random, s_QuaternionBatchCount);
+    FillQuaternionBatchStreams(to, random, s_QuaternionBatchCount);
+    const QuaternionBatchStreams original = from;
+
+    Vector<f32> factors(s_QuaternionBatchCount, 0.25f);
+    QuaternionBatch::Nlerp(from.stream(), to.stream(), factors.data(), s_QuaternionBatchCount, from.stream());
+    for(u32 i = 0u; i < s_QuaternionBatchCount; ++i)
+        EXPECT_TRUE(QuaternionBatchNearEqual(from.get(i), ReferenceQuaternionNlerp(original.get(i), to.get(i), 0.25f))) << "lane " << i;
+}
+
+TEST(Math, QuaternionBatchAccumulateWeightedFlipsIntoAccumulatorHemisphere){
+    CollisionBatchRandom random;
+    QuaternionBatchStreams rotations;
+    QuaternionBatchStreams negated;
+    QuaternionBatchStreams accumulator;
+    FillQuaternionBatchStreams(rotations, random, s_QuaternionBatchCount);
+    negated.resize(s_QuaternionBatchCount);
+    accumulator.resize(s_QuaternionBatchCount);
+    for(u32 i = 0u; i < s_QuaternionBatchCount; ++i){
+        const Float4 rotation = rotations.get(i);
+        negated.set(i, Float4(-rotation.x, -rotation.y, -rotation.z, -rotation.w));
+    }
+
+    // q and -q describe the same rotation, so blending them must not cancel out.
+    QuaternionBatch::AccumulateWeighted(rotations.stream(), 0.5f, s_QuaternionBatchCount, accumulator.stream());
+    QuaternionBatch::AccumulateWeighted(negated.stream(), 0.5f, s_QuaternionBatchCount, accumulator.stream());
+    QuaternionBatch::Normalize(accumulator.stream(), s_QuaternionBatchCount);
+    for(u32 i = 0u; i < s_QuaternionBatchCount; ++i)
+        EXPECT_TRUE(QuaternionBatchNearEqual(accumulator.get(i), rotations.get(i))) << "lane " << i;
+}
+
+TEST(Math, QuaternionBatchNormalizeMapsDegenerateLanesToIdentity){
+    QuaternionBatchStreams rotations;
+    rotations.resize(s_QuaternionBatchCount);
+    for(u32 i = 0u; i < s_QuaternionBatchCount; ++i)
+        rotations.set(i, (i % 3u) == 0u ? Float4(0.0f, 0.0f, 0.0f, 0.0f) : Float4(0.0f, 2.0f, 0.0f, 0.0f));
+
+    QuaternionBatch::Normalize(rotations.stream(), s_QuaternionBatchCount);
+    for(u32 i = 0u; i < s_QuaternionBatchCount; ++i){
+        const Float4 expected = (i % 3u) == 0u ? Float4(0.0f, 0.0f, 0.0f, 1.0f) : Float4(0.0f, 1.0f, 0.0f, 0.0f);
+        EXPECT_TRUE(QuaternionBatchNearEqual(rotations.get(i), expected)) << "lane " << i;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
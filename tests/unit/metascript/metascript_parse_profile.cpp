@@ -0,0 +1,299 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Manual CPU probe for metascript parse throughput. It generates 2,000 asset descriptions shaped like the cooked .nwb
+// sources (texture headers, material parameter maps, mesh index lists and bind-style structs) and parses every one of
+// them with Document and with CompactDocument, one fresh document per source like the cookers do. It reports
+// min/median/max wall time per corpus pass and fails if the two DOMs disagree on any source.
+
+
+#include <core/alloc/general.h>
+#include <core/common/application_entry.h>
+#include <core/common/module.h>
+#include <core/metascript/compact_document.h>
+
+#include <tests/common/profile_timing.h>
+#include <tests/common/test_context.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace MetascriptParseProfile{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<typename T>
+using Vector = Tests::TestVector<T>;
+using AString = Tests::TestAString;
+using MStringView = Core::Metascript::MStringView;
+
+
+inline constexpr u32 s_DocumentCount = 2000u;
+inline constexpr u32 s_MeshIndexCount = 384u;
+inline constexpr u32 s_MaterialParameterCount = 24u;
+inline constexpr u32 s_WarmupCount = 2u;
+inline constexpr u32 s_SampleCount = 15u;
+
+inline constexpr Name s_ProfileArena("tests/unit/metascript/metascript_parse_profile");
+
+
+struct Source{
+    AString text;
+    bool implicitBind = false;
+};
+
+struct Result{
+    usize sourceBytes = 0u;
+    usize compactNodes = 0u;
+    Tests::ProfileTimingSamples document;
+    Tests::ProfileTimingSamples compact;
+};
+
+
+static void AppendU32(AString& out, u32 value){
+    char digits[10];
+    u32 count = 0u;
+    do{
+        digits[count++] = static_cast<char>('0' + value % 10u);
+        value /= 10u;
+    }while(value != 0u);
+    while(count > 0u)
+        out.push_back(digits[--count]);
+}
+
+static void BuildTexture(const u32 index, AString& out){
+    out += "texture asset;\n";
+    out += "asset.version = 1;\n";
+    out += "asset.format = \"uastc_ldr_4x4\";\n";
+    out += "asset.color_space = \"srgb\";\n";
+    out += "asset.width = ";
+    AppendU32(out, 64u + index % 512u);
+    out += ";\nasset.height = ";
+    AppendU32(out, 32u + index % 256u);
+    out += ";\nasset.data = \"project/textures/texture_";
+    AppendU32(out, index);
+    out += ".tex\";\nasset.mips = [\n";
+    for(u32 level = 0u; level < 6u; ++level){
+        out += "    { \"level\": ";
+        AppendU32(out, level);
+        out += ", \"width\": ";
+        AppendU32(out, 64u >> level);
+        out += ", \"height\": ";
+        AppendU32(out, 32u >> level);
+        out += ", \"offset_bytes\": ";
+        AppendU32(out, level * 4096u);
+        out += ", \"size_bytes\": 4096 },\n";
+    }
+    out += "];\n";
+}
+
+static void BuildMaterial(const u32 index, AString& out){
+    out += "material asset;\n";
+    out += "asset.shaders = { \"vs\": \"project/shaders/surface_vs\", \"ps\": \"project/shaders/surface_ps\" };\n";
+    out += "asset.name = \"material_\" + \"";
+    AppendU32(out, index);
+    out += "\";\n";
+    for(u32 parameter = 0u; parameter < s_MaterialParameterCount; ++parameter){
+        out += "asset.parameters.param_";
+        AppendU32(out, parameter);
+        out += " = [";
+        AppendU32(out, parameter);
+        out += ".25, 0.5, 1.0, 1.0];\n";
+    }
+    out += "asset.parameters.roughness = 0.5 * 2;\n";
+}
+
+static void BuildMesh(const u32 index, AString& out){
+    out += "mesh asset;\n";
+    out += "asset.name = \"project/meshes/mesh_";
+    AppendU32(out, index);
+    out += "\";\nasset.indices = [";
+    for(u32 i = 0u; i < s_MeshIndexCount; ++i){
+        AppendU32(out, (i * 7u + index) % 1021u);
+        out += i + 1u < s_MeshIndexCount ? ", " : "";
+    }
+    out += "];\nasset.bounds = { \"min\": [-1.0, -1.0, -1.0], \"max\": [1.0, 1.0, 1.0] };\n";
+}
+
+static void BuildBind(const u32 index, AString& out){
+    out += "[material_constant]\nstruct SurfaceMaterial";
+    AppendU32(out, index);
+    out += "{\n";
+    for(u32 field = 0u; field < 8u; ++field){
+        out += "    [default(\"float4(1.0, 1.0, 1.0, 1.0)\")]\n    float4 field_";
+        AppendU32(out, field);
+        out += ";\n";
+    }
+    out += "};\nSurfaceMaterial";
+    AppendU32(out, index);
+    out += " surface;\n";
+}
+
+static void BuildCorpus(Vector<Source>& outSources, usize& outBytes){
+    outSources.resize(s_DocumentCount);
+    outBytes = 0u;
+    for(u32 index = 0u; index < s_DocumentCount; ++index){
+        Source& source = outSources[index];
+        switch(index & 3u){
+        case 0u: BuildTexture(index, source.text); break;
+        case 1u: BuildMaterial(index, source.text); break;
+        case 2u: BuildMesh(index, source.text); break;
+        default:
+            BuildBind(index, source.text);
+            source.implicitBind = true;
+            break;
+        }
+        outBytes += source.text.size();
+    }
+}
+
+template<typename DocumentT>
+[[nodiscard]] static bool ParseSource(DocumentT& document, const Source& source){
+    const MStringView text(source.text.data(), source.text.size());
+    if(source.implicitBind)
+        return document.parseWithImplicitAsset(text, MStringView("material_bind"), MStringView("asset"));
+    return document.parse(text);
+}
+
+template<typename DocumentT>
+static void Measure(Core::Alloc::GlobalArena& arena, const Vector<Source>& sources, Tests::ProfileTimingSamples& outSamples){
+    for(u32 i = 0u; i < s_WarmupCount + s_SampleCount; ++i){
+        const Timer begin = TimerNow();
+        for(const Source& source : sources){
+            DocumentT document(arena);
+            if(!ParseSource(document, source))
+                return;
+        }
+        if(i >= s_WarmupCount && !outSamples.append(DurationInSeconds<f64>(TimerNow(), begin)))
+            return;
+    }
+}
+
+[[nodiscard]] static bool SameValue(const Core::Metascript::Value& expected, const Core::Metascript::CompactValue& actual){
+    if(expected.type() != actual.type())
+        return false;
+
+    switch(expected.type()){
+    case Core::Metascript::ValueType::Integer:
+        return expected.asInteger() == actual.asInteger();
+    case Core::Metascript::ValueType::Double:
+        return expected.asDouble() == actual.asDouble();
+    case Core::Metascript::ValueType::String:
+        return expected.asString() == actual.asString();
+    case Core::Metascript::ValueType::Reference:
+        return expected.asReference() == actual.asReference();
+    case Core::Metascript::ValueType::List:{
+        if(expected.asList().size() != actual.asList().size())
+            return false;
+        for(usize i = 0u; i < expected.asList().size(); ++i){
+            if(!SameValue(expected.asList()[i], actual.asList()[i]))
+                return false;
+        }
+        return true;
+    }
+    case Core::Metascript::ValueType::Map:{
+        if(expected.asMap().size() != actual.asMap().size())
+            return false;
+        for(const auto& [key, value] : expected.asMap()){
+            const Core::Metascript::CompactValue* field = actual.findField(MStringView(key.data(), key.size()));
+            if(!field || !SameValue(value, *field))
+                return false;
+        }
+        return true;
+    }
+    default:
+        return true;
+    }
+}
+
+[[nodiscard]] static bool DocumentsMatch(Core::Alloc::GlobalArena& arena, const Vector<Source>& sources, usize& outCompactNodes){
+    outCompactNodes = 0u;
+    for(const Source& source : sources){
+        Core::Metascript::Document document(arena);
+        Core::Metascript::CompactDocument compact(arena);
+        if(!ParseSource(document, source) || !ParseSource(compact, source))
+            return false;
+        if(!SameValue(document.asset(), compact.asset()))
+            return false;
+        outCompactNodes += compact.nodeCount();
+    }
+    return true;
+}
+
+[[nodiscard]] static bool RunProfile(Result& outResult){
+    Core::Alloc::GlobalArena arena(s_ProfileArena);
+
+    Vector<Source> sources;
+    BuildCorpus(sources, outResult.sourceBytes);
+    if(!DocumentsMatch(arena, sources, outResult.compactNodes))
+        return false;
+
+    Measure<Core::Metascript::Document>(arena, sources, outResult.document);
+    Measure<Core::Metascript::CompactDocument>(arena, sources, outResult.compact);
+    return outResult.document.count == s_SampleCount && outResult.compact.count == s_SampleCount;
+}
+
+static void EmitResult(const Result& result, const bool matched){
+    const f64 megabytes = static_cast<f64>(result.sourceBytes) / (1024.0 * 1024.0);
+    const f64 documentMedian = Tests::SummarizeProfileTiming(result.document).median;
+    const f64 compactMedian = Tests::SummarizeProfileTiming(result.compact).median;
+
+    NWB_COUT
+        << "{\"status\":\"" << (matched ? "ok" : "failed") << "\","
+        << "\"documents\":" << s_DocumentCount << ','
+        << "\"source_bytes\":" << result.sourceBytes << ','
+        << "\"compact_nodes\":" << result.compactNodes << ','
+        << "\"samples\":" << s_SampleCount << ','
+        << "\"document_mib_per_s\":" << (documentMedian > 0.0 ? megabytes / documentMedian : 0.0) << ','
+        << "\"compact_mib_per_s\":" << (compactMedian > 0.0 ? megabytes / compactMedian : 0.0) << ','
+    ;
+    Tests::EmitProfileTiming("document", result.document);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming("compact", result.compact);
+    NWB_COUT << "}\n";
+}
+
+[[nodiscard]] static int EntryPoint(const isize, tchar**, void*){
+    Core::Common::InitializerGuard commonInitializerGuard;
+    if(!commonInitializerGuard.initialize()){
+        NWB_CERR << "metascript parse profile initialization failed\n";
+        return 1;
+    }
+
+    Result result;
+    const bool matched = RunProfile(result);
+    EmitResult(result, matched);
+    return matched ? 0 : 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_DEFINE_APPLICATION_ENTRY_POINT(::NWB::MetascriptParseProfile::EntryPoint)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
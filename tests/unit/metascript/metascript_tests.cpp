@@ -3,6 +3,7 @@
 
 
 #include <core/metascript/parser.h>
+#include <core/metascript/compact_document.h>
 
 #include <tests/common/test_context.h>
 #include <gtest/gtest.h>
@@ -19,6 +20,8 @@ namespace __hidden_metascript_tests{
 
 using Document = NWB::Core::Metascript::Document;
 using Value = NWB::Core::Metascript::Value;
+using CompactDocument = NWB::Core::Metascript::CompactDocument;
+using CompactValue = NWB::Core::Metascript::CompactValue;
 using MStringView = NWB::Core::Metascript::MStringView;
 using AString = NWB::Tests::TestAString;
 
@@ -101,6 +104,129 @@ static void MakeSingleStringList(Value& list, ArenaT& arena, const AString& text
     list.append(Value(ViewOf(text), arena.arena));
 }
 
+static void CheckSameValue(const Value& expected, const CompactValue& actual){
+    ASSERT_EQ(expected.type(), actual.type());
+    switch(expected.type()){
+    case NWB::Core::Metascript::ValueType::Integer:
+        EXPECT_EQ(expected.asInteger(), actual.asInteger());
+        break;
+    case NWB::Core::Metascript::ValueType::Double:
+        EXPECT_EQ(expected.asDouble(), actual.asDouble());
+        break;
+    case NWB::Core::Metascript::ValueType::String:
+        EXPECT_EQ(expected.asString(), actual.asString());
+        break;
+    case NWB::Core::Metascript::ValueType::Reference:
+        EXPECT_EQ(expected.asReference(), actual.asReference());
+        break;
+    case NWB::Core::Metascript::ValueType::List:
+        ASSERT_EQ(expected.asList().size(), actual.asList().size());
+        for(usize i = 0u; i < expected.asList().size(); ++i)
+            CheckSameValue(expected.asList()[i], actual.asList()[i]);
+        break;
+    case NWB::Core::Metascript::ValueType::Map:
+        ASSERT_EQ(expected.asMap().size(), actual.asMap().size());
+        for(const auto& [key, value] : expected.asMap()){
+            const CompactValue* field = actual.findField(MStringView(key.data(), key.size()));
+            ASSERT_NE(field, nullptr);
+            CheckSameValue(value, *field);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void CheckSameDocument(const Document& expected, const CompactDocument& actual){
+    EXPECT_EQ(expected.assetType(), actual.assetType());
+    EXPECT_EQ(expected.assetVariable(), actual.assetVariable());
+    ASSERT_EQ(expected.declarations().size(), actual.declarations().size());
+    for(const auto& declaration : expected.declarations()){
+        const MStringView name(declaration.variable.data(), declaration.variable.size());
+        const Value* expectedValue = expected.findVariable(name);
+        const CompactValue* actualValue = actual.findVariable(name);
+        ASSERT_NE(expectedValue, nullptr);
+        ASSERT_NE(actualValue, nullptr);
+        CheckSameValue(*expectedValue, *actualValue);
+    }
+}
+
+static void CheckSameValue(const Value& expected, const Value& actual){
+    ASSERT_EQ(expected.type(), actual.type());
+    switch(expected.type()){
+    case NWB::Core::Metascript::ValueType::Integer:
+        EXPECT_EQ(expected.asInteger(), actual.asInteger());
+        break;
+    case NWB::Core::Metascript::ValueType::Double:
+        EXPECT_EQ(expected.asDouble(), actual.asDouble());
+        break;
+    case NWB::Core::Metascript::ValueType::String:
+        EXPECT_EQ(expected.asString(), actual.asString());
+        break;
+    case NWB::Core::Metascript::ValueType::Reference:
+        EXPECT_EQ(expected.asReference(), actual.asReference());
+        break;
+    case NWB::Core::Metascript::ValueType::List:
+        ASSERT_EQ(expected.asList().size(), actual.asList().size());
+        for(usize i = 0u; i < expected.asList().size(); ++i)
+            CheckSameValue(expected.asList()[i], actual.asList()[i]);
+        break;
+    case NWB::Core::Metascript::ValueType::Map:
+        ASSERT_EQ(expected.asMap().size(), actual.asMap().size());
+        for(const auto& [key, value] : expected.asMap()){
+            const Value* field = actual.findField(MStringView(key.data(), key.size()));
+            ASSERT_NE(field, nullptr);
+            CheckSameValue(value, *field);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void CheckSameDocument(const Document& expected, const Document& actual){
+    EXPECT_EQ(expected.assetType(), actual.assetType());
+    EXPECT_EQ(expected.assetVariable(), actual.assetVariable());
+    ASSERT_EQ(expected.declarations().size(), actual.declarations().size());
+    for(usize i = 0u; i < expected.declarations().size(); ++i){
+        EXPECT_EQ(expected.declarations()[i].type, actual.declarations()[i].type);
+        EXPECT_EQ(expected.declarations()[i].variable, actual.declarations()[i].variable);
+
+        const auto& variable = expected.declarations()[i].variable;
+        const Value* expectedValue = expected.findVariable(MStringView(variable.data(), variable.size()));
+        const Value* actualValue = actual.findVariable(MStringView(variable.data(), variable.size()));
+        ASSERT_NE(expectedValue, nullptr);
+        ASSERT_NE(actualValue, nullptr);
+        CheckSameValue(*expectedValue, *actualValue);
+    }
+}
+
+[[nodiscard]] static bool IsViewInto(const AString& source, MStringView text){
+    return text.data() >= source.data() && text.data() + text.size() <= source.data() + source.size();
+}
+
+class ChunkedReader final : public NWB::Core::Metascript::IMetaReader{
+public:
+    explicit ChunkedReader(const AString& source)
+        : m_source(source)
+    {}
+
+
+public:
+    virtual isize read(char* buffer, usize maxBytes)override{
+        const usize size = Min<usize>(Min<usize>(maxBytes, 7u), m_source.size() - m_offset);
+        for(usize i = 0u; i < size; ++i)
+            buffer[i] = m_source[m_offset + i];
+        m_offset += size;
+        return static_cast<isize>(size);
+    }
+
+
+private:
+    const AString& m_source;
+    usize m_offset = 0u;
+};
+
 TEST(Metascript, CrossArenaMoveAssignmentCopiesIntoDestinationArena){
     SourceArena sourceArena;
     DestinationArena destinationArena;
@@ -459,6 +585,235 @@ TEST(Metascript, TextureConverterMetadataSchema){
     EXPECT_EQ(offset->asInteger(), 0);
 }
 
+TEST(Metascript, CompactDocumentMatchesDocument){
+    const AString sources[] = {
+        AString(
+            "texture asset;\n"
+            "asset.version = 1;\n"
+            "asset.format = \"uastc_ldr_4x4\";\n"
+            "asset.scale = 2.5 * (3 - 1) / 2;\n"
+            "asset.count = -(4 + 2) * 3;\n"
+            "asset.label = \"mip\" + \"_\" + \"chain\";\n"
+            "asset.label += \"_v2\";\n"
+            "asset.mips = [{ \"level\": 0, \"width\": 7 }, { \"level\": 1, \"width\": 3 }];\n"
+            "asset.mips += { \"level\": 2, \"width\": 1 };\n"
+            "asset.mips += [{ \"level\": 3, \"width\": 1 }];\n"
+            "asset.nested.inner.depth = 3;\n"
+            "asset.nested.inner.depth *= 2;\n"
+            "asset.nested.inner.depth -= 1;\n"
+            "asset.nested.inner.ratio = 9;\n"
+            "asset.nested.inner.ratio /= 2;\n"
+            "asset.map = { \"zeta\": 1, \"alpha\": [1, 2.5, \"x\"], \"mid\" + \"dle\": {} };\n"
+            "asset.empty_list = {};\n"
+            "asset.tail = [1, 2, 3,];\n"
+        ),
+        AString(
+            "model model;\n"
+            "model.mesh = \"project/body/mesh\";\n"
+            "mesh mesh;\n"
+            "mesh.indices = [0, 1, 2];\n"
+            "asset_bunch bunch = [model, mesh.indices, model.mesh];\n"
+        ),
+    };
+
+    for(const AString& source : sources){
+        DestinationArena arena;
+        Document document(arena.arena);
+        CompactDocument compact(arena.arena);
+        ASSERT_TRUE(document.parse(ViewOf(source)));
+        ASSERT_TRUE(compact.parse(ViewOf(source)));
+        CheckSameDocument(document, compact);
+    }
+}
+
+TEST(Metascript, CompactDocumentMatchesImplicitBindDocument){
+    const AString source =
+        "[material_constant]\n"
+        "struct NwbProjectBxdfSurfaceMaterial{\n"
+        "    [default(\"float4(1.0, 1.0, 1.0, 1.0)\")]\n"
+        "    float4 base_color;\n"
+        "    float roughness;\n"
+        "};\n"
+        "NwbProjectBxdfSurfaceMaterial surface;\n"
+    ;
+
+    DestinationArena arena;
+    Document document(arena.arena);
+    CompactDocument compact(arena.arena);
+    ASSERT_TRUE(ParseImplicitMaterialBind(document, source));
+    ASSERT_TRUE(compact.parseWithImplicitAsset(ViewOf(source), LiteralView("material_bind"), LiteralView("asset")));
+    CheckSameDocument(document, compact);
+    EXPECT_EQ(compact.assetType(), LiteralView("material_bind"));
+}
+
+TEST(Metascript, CompactDocumentKeepsSourceViewsAndSortsMaps){
+    const AString source =
+        "texture asset;\n"
+        "asset.format = \"uastc_ldr_4x4\";\n"
+        "asset.label = \"mip\" + \"_chain\";\n"
+        "asset.ref = [asset.format];\n"
+    ;
+
+    DestinationArena arena;
+    CompactDocument compact(arena.arena);
+    ASSERT_TRUE(compact.parse(ViewOf(source)));
+
+    const CompactValue& asset = compact.asset();
+    ASSERT_TRUE(asset.isMap());
+
+    const CompactValue* format = asset.findField(LiteralView("format"));
+    ASSERT_NE(format, nullptr);
+    EXPECT_EQ(format->asString(), LiteralView("uastc_ldr_4x4"));
+    EXPECT_TRUE(IsViewInto(source, format->asString()));
+
+    const CompactValue* label = asset.findField(LiteralView("label"));
+    ASSERT_NE(label, nullptr);
+    EXPECT_EQ(label->asString(), LiteralView("mip_chain"));
+    EXPECT_FALSE(IsViewInto(source, label->asString()));
+
+    const CompactValue* ref = asset.findField(LiteralView("ref"));
+    ASSERT_NE(ref, nullptr);
+    ASSERT_EQ(ref->asList().size(), 1u);
+    EXPECT_EQ(ref->asList()[0u].asReference(), LiteralView("asset.format"));
+
+    const auto fields = asset.asMap();
+    ASSERT_EQ(fields.size(), 3u);
+    EXPECT_EQ(fields[0u].first, LiteralView("format"));
+    EXPECT_EQ(fields[1u].first, LiteralView("label"));
+    EXPECT_EQ(fields[2u].first, LiteralView("ref"));
+    EXPECT_EQ(asset.findField(LiteralView("missing")), nullptr);
+}
+
+TEST(Metascript, CompactDocumentReportsParserErrors){
+    const AString source =
+        "texture asset;\n"
+        "asset.value = 1 / 0;\n"
+    ;
+
+    DestinationArena arena;
+    Document document(arena.arena);
+    CompactDocument compact(arena.arena);
+    EXPECT_FALSE(document.parse(ViewOf(source)));
+    EXPECT_FALSE(compact.parse(ViewOf(source)));
+    ASSERT_EQ(document.errors().size(), compact.errors().size());
+    ASSERT_FALSE(compact.errors().empty());
+    EXPECT_EQ(compact.errors()[0u].message, document.errors()[0u].message);
+    EXPECT_EQ(compact.errors()[0u].line, document.errors()[0u].line);
+}
+
+TEST(Metascript, CompactDocumentOwnsReaderSource){
+    const AString source =
+        "mesh asset;\n"
+        "asset.name = \"reader_owned_mesh_name\";\n"
+        "asset.indices = [0, 1, 2, 2, 1, 3];\n"
+    ;
+
+    DestinationArena arena;
+    Document document(arena.arena);
+    CompactDocument compact(arena.arena);
+    ChunkedReader documentReader(source);
+    ChunkedReader compactReader(source);
+    ASSERT_TRUE(document.parse(documentReader));
+    ASSERT_TRUE(compact.parse(compactReader));
+    CheckSameDocument(document, compact);
+
+    const CompactValue* name = compact.asset().findField(LiteralView("name"));
+    ASSERT_NE(name, nullptr);
+    EXPECT_FALSE(IsViewInto(source, name->asString()));
+}
+
+TEST(Metascript, DocumentSnapshotRoundTrip){
+    const AString sources[] = {
+        AString(
+            "texture asset;\n"
+            "asset.version = 1;\n"
+            "asset.scale = 2.5 * (3 - 1) / 2;\n"
+            "asset.label = \"mip\" + \"_chain\";\n"
+            "asset.mips = [{ \"level\": 0, \"width\": 7 }, { \"level\": 1, \"width\": 3 }];\n"
+            "asset.nested.inner.depth = -3;\n"
+            "asset.empty_list = {};\n"
+        ),
+        AString(
+            "model model;\n"
+            "model.mesh = \"project/body/mesh\";\n"
+            "mesh mesh;\n"
+            "mesh.indices = [0, 1, 2];\n"
+            "asset_bunch bunch = [model, mesh.indices, model.mesh];\n"
+        ),
+    };
+
+    for(const AString& source : sources){
+        DestinationArena arena;
+        Document document(arena.arena);
+        ASSERT_TRUE(document.parse(ViewOf(source)));
+
+        NWB::Core::Metascript::MVector<u8> snapshot(arena.arena);
+        ASSERT_TRUE(document.writeSnapshot(snapshot));
+
+        Document restored(arena.arena);
+        ASSERT_TRUE(restored.readSnapshot(snapshot.data(), snapshot.size()));
+        EXPECT_FALSE(restored.hasErrors());
+        CheckSameDocument(document, restored);
+        CheckSameValue(document.asset(), restored.asset());
+    }
+
+    const AString bindSource =
+        "[material_constant]\n"
+        "struct SurfaceMaterial{\n"
+        "    float4 base_color;\n"
+        "};\n"
+        "SurfaceMaterial surface;\n"
+    ;
+    DestinationArena arena;
+    Document document(arena.arena);
+    ASSERT_TRUE(ParseImplicitMaterialBind(document, bindSource));
+
+    NWB::Core::Metascript::MVector<u8> snapshot(arena.arena);
+    ASSERT_TRUE(document.writeSnapshot(snapshot));
+    Document restored(arena.arena);
+    ASSERT_TRUE(restored.readSnapshot(snapshot.data(), snapshot.size()));
+    CheckSameDocument(document, restored);
+    EXPECT_EQ(restored.assetType(), LiteralView("material_bind"));
+}
+
+TEST(Metascript, DocumentSnapshotRejectsDamagedBytes){
+    const AString source =
+        "mesh asset;\n"
+        "asset.name = \"snapshot_mesh\";\n"
+        "asset.indices = [0, 1, 2, 2, 1, 3];\n"
+    ;
+
+    DestinationArena arena;
+    Document document(arena.arena);
+    ASSERT_TRUE(document.parse(ViewOf(source)));
+
+    NWB::Core::Metascript::MVector<u8> snapshot(arena.arena);
+    ASSERT_TRUE(document.writeSnapshot(snapshot));
+
+    Document restored(arena.arena);
+    for(usize size = 0u; size < snapshot.size(); ++size){
+        EXPECT_FALSE(restored.readSnapshot(snapshot.data(), size));
+        EXPECT_TRUE(restored.assetType().empty());
+        EXPECT_TRUE(restored.declarations().empty());
+    }
+
+    NWB::Core::Metascript::MVector<u8> foreign(snapshot);
+    foreign[0u] ^= 0xFFu;
+    EXPECT_FALSE(restored.readSnapshot(foreign.data(), foreign.size()));
+
+    NWB::Core::Metascript::MVector<u8> trailing(snapshot);
+    trailing.push_back(0u);
+    EXPECT_FALSE(restored.readSnapshot(trailing.data(), trailing.size()));
+
+    Document failed(arena.arena);
+    EXPECT_FALSE(failed.parse(LiteralView("mesh asset;\nasset.value = 1 / 0;\n")));
+    EXPECT_FALSE(failed.writeSnapshot(snapshot));
+
+    ASSERT_TRUE(document.writeSnapshot(snapshot));
+    ASSERT_TRUE(restored.readSnapshot(snapshot.data(), snapshot.size()));
+    CheckSameDocument(document, restored);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
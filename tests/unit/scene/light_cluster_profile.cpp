@@ -0,0 +1,218 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Manual CPU probe for clustered light assignment. It scatters 4,096 point and spot lights through the view frustum
+// and builds the default 30x17x24 cluster grid for a 1920x1080 viewport, on an inline (zero worker) pool and on a
+// pool with one worker per core. It reports min/median/max wall time per build plus the assignment totals, and fails
+// if the serial and parallel grids disagree.
+
+
+#include <core/alloc/general.h>
+#include <core/alloc/thread.h>
+#include <core/common/application_entry.h>
+#include <core/common/module.h>
+#include <impl/ecs_scene/module.h>
+
+#include <tests/common/profile_timing.h>
+#include <tests/common/test_context.h>
+
+#include <global/cpu_topology.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace LightClusterProfile{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<typename T>
+using Vector = Tests::TestVector<T>;
+
+
+inline constexpr u32 s_LightCount = 4096u;
+inline constexpr u32 s_ViewportWidth = 1920u;
+inline constexpr u32 s_ViewportHeight = 1080u;
+inline constexpr u32 s_WarmupCount = 2u;
+inline constexpr u32 s_SampleCount = 31u;
+inline constexpr f32 s_VerticalFov = 1.0471976f;
+inline constexpr f32 s_NearPlane = 0.1f;
+inline constexpr f32 s_FarPlane = 500.0f;
+
+inline constexpr Name s_ProfileArena("tests/unit/scene/light_cluster_profile");
+
+
+struct Result{
+    u32 workerCount = 0u;
+    usize clusterCount = 0u;
+    usize assignmentCount = 0u;
+    u32 maxClusterLights = 0u;
+    Tests::ProfileTimingSamples serial;
+    Tests::ProfileTimingSamples parallel;
+};
+
+
+static void BuildLights(const Impl::Scene::CameraProjection& projection, Vector<Impl::Scene::SceneLight>& outLights){
+    // Fixed LCG so every run and both pools see the same scene.
+    u32 seed = 0x2545F491u;
+    const auto next = [&seed](){
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<f32>(seed >> 8u) / static_cast<f32>(1u << 24u);
+    };
+
+    const f32 tanHalfFov = projection.tanHalfVerticalFov;
+    const f32 aspect = projection.aspectRatio;
+    outLights.reserve(s_LightCount);
+    for(u32 lightIndex = 0u; lightIndex < s_LightCount; ++lightIndex){
+        const f32 depth = 1.0f + next() * 200.0f;
+        Impl::Scene::SceneLight light;
+        light.position = Float4(
+            (next() * 2.0f - 1.0f) * depth * tanHalfFov * aspect,
+            (next() * 2.0f - 1.0f) * depth * tanHalfFov,
+            depth,
+            1.0f
+        );
+        light.colorIntensity = Float4(next(), next(), next(), 0.5f + next() * 4.0f);
+        light.range = 1.0f + next() * 9.0f;
+
+        if((lightIndex & 3u) == 0u){
+            const f32 coneCos = 0.6f + next() * 0.35f;
+            light.type = Impl::Scene::LightType::Spot;
+            light.position.w = Min(coneCos + 0.03f, 1.0f);
+            light.direction = Float4(0.0f, -1.0f, 0.0f, coneCos);
+        }
+        else
+            light.type = Impl::Scene::LightType::Point;
+        outLights.push_back(light);
+    }
+}
+
+static void Measure(
+    Impl::Scene::LightClusterGrid& grid,
+    Core::Alloc::ThreadPool& threadPool,
+    const Impl::Scene::CameraProjection& projection,
+    const Vector<Impl::Scene::SceneLight>& lights,
+    Tests::ProfileTimingSamples& outSamples
+){
+    Impl::Scene::LightClusterGridDesc desc;
+    desc.viewportWidth = s_ViewportWidth;
+    desc.viewportHeight = s_ViewportHeight;
+
+    const Impl::Scene::SceneViewBasis view;
+    for(u32 i = 0u; i < s_WarmupCount + s_SampleCount; ++i){
+        const Timer begin = TimerNow();
+        if(!grid.build(desc, view, projection, lights.data(), lights.size(), threadPool))
+            break;
+        if(i >= s_WarmupCount && !outSamples.append(DurationInSeconds<f64>(TimerNow(), begin)))
+            break;
+    }
+}
+
+[[nodiscard]] static bool GridsMatch(const Impl::Scene::LightClusterGrid& lhs, const Impl::Scene::LightClusterGrid& rhs){
+    if(lhs.clusterCount() == 0u || lhs.clusterCount() != rhs.clusterCount() || lhs.assignmentCount() != rhs.assignmentCount())
+        return false;
+
+    for(usize cluster = 0u; cluster < lhs.clusterCount(); ++cluster){
+        if(lhs.cluster(cluster).offset != rhs.cluster(cluster).offset || lhs.cluster(cluster).count != rhs.cluster(cluster).count)
+            return false;
+    }
+    for(usize i = 0u; i < lhs.assignmentCount(); ++i){
+        if(lhs.clusterLightIndices()[i] != rhs.clusterLightIndices()[i])
+            return false;
+    }
+    return true;
+}
+
+[[nodiscard]] static bool RunProfile(Result& outResult){
+    outResult.workerCount = Max(QueryCpuCoreCount(CpuAffinity::Any), 1u);
+
+    Core::Alloc::GlobalArena arena(s_ProfileArena);
+    Core::Alloc::ThreadPool serialPool(0u, CpuAffinity::Any);
+    Core::Alloc::ThreadPool parallelPool(outResult.workerCount, CpuAffinity::Any);
+
+    Impl::Scene::CameraProjection projection;
+    if(!Impl::Scene::TryBuildCameraProjection(
+        VectorReplicate(s_VerticalFov),
+        VectorReplicate(s_NearPlane),
+        VectorReplicate(s_FarPlane),
+        VectorReplicate(static_cast<f32>(s_ViewportWidth) / static_cast<f32>(s_ViewportHeight)),
+        VectorReplicate(1.0f),
+        projection
+    ))
+        return false;
+
+    Vector<Impl::Scene::SceneLight> lights;
+    BuildLights(projection, lights);
+
+    Impl::Scene::LightClusterGrid serialGrid(arena);
+    Impl::Scene::LightClusterGrid parallelGrid(arena);
+    Measure(serialGrid, serialPool, projection, lights, outResult.serial);
+    Measure(parallelGrid, parallelPool, projection, lights, outResult.parallel);
+
+    outResult.clusterCount = parallelGrid.clusterCount();
+    outResult.assignmentCount = parallelGrid.assignmentCount();
+    for(usize cluster = 0u; cluster < parallelGrid.clusterCount(); ++cluster)
+        outResult.maxClusterLights = Max(outResult.maxClusterLights, parallelGrid.cluster(cluster).count);
+    return GridsMatch(serialGrid, parallelGrid);
+}
+
+static void EmitResult(const Result& result, const bool matched){
+    NWB_COUT
+        << "{\"status\":\"" << (matched ? "ok" : "failed") << "\","
+        << "\"lights\":" << s_LightCount << ','
+        << "\"viewport\":\"" << s_ViewportWidth << 'x' << s_ViewportHeight << "\","
+        << "\"clusters\":" << result.clusterCount << ','
+        << "\"assignments\":" << result.assignmentCount << ','
+        << "\"max_cluster_lights\":" << result.maxClusterLights << ','
+        << "\"workers\":" << result.workerCount << ','
+        << "\"samples\":" << s_SampleCount << ','
+    ;
+    Tests::EmitProfileTiming("serial", result.serial);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming("parallel", result.parallel);
+    NWB_COUT << "}\n";
+}
+
+[[nodiscard]] static int EntryPoint(const isize, tchar**, void*){
+    Core::Common::InitializerGuard commonInitializerGuard;
+    if(!commonInitializerGuard.initialize()){
+        NWB_CERR << "light cluster profile initialization failed\n";
+        return 1;
+    }
+
+    Result result;
+    const bool matched = RunProfile(result);
+    EmitResult(result, matched);
+    return matched ? 0 : 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_DEFINE_APPLICATION_ENTRY_POINT(::NWB::LightClusterProfile::EntryPoint)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
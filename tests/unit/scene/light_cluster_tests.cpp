@@ -0,0 +1,304 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <core/ecs/module.h>
+#include <core/common/module.h>
+#include <impl/ecs_scene/module.h>
+
+#include <tests/common/ecs_test_world.h>
+
+#include <gtest/gtest.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_light_cluster_tests{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+using TestWorld = NWB::Tests::EcsTestWorld;
+using SceneLight = NWB::Impl::Scene::SceneLight;
+using LightClusterGrid = NWB::Impl::Scene::LightClusterGrid;
+using LightClusterGridDesc = NWB::Impl::Scene::LightClusterGridDesc;
+
+template<typename T>
+using TestVector = Vector<T, NWB::Core::Alloc::GlobalArena>;
+
+inline constexpr u32 s_ViewportWidth = 1920u;
+inline constexpr u32 s_ViewportHeight = 1080u;
+inline constexpr f32 s_NearPlane = 0.1f;
+inline constexpr f32 s_FarPlane = 100.0f;
+// A 90 degree vertical field of view makes tan(fov / 2) one, which keeps the view-space math below readable.
+inline constexpr f32 s_VerticalFov = 1.5707964f;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+[[nodiscard]] static NWB::Impl::Scene::CameraProjection BuildProjection(){
+    NWB::Impl::Scene::CameraProjection projection;
+    const bool built = NWB::Impl::Scene::TryBuildCameraProjection(
+        VectorReplicate(s_VerticalFov),
+        VectorReplicate(s_NearPlane),
+        VectorReplicate(s_FarPlane),
+        VectorReplicate(static_cast<f32>(s_ViewportWidth) / static_cast<f32>(s_ViewportHeight)),
+        VectorReplicate(1.0f),
+        projection
+    );
+    EXPECT_TRUE(built);
+    return projection;
+}
+
+[[nodiscard]] static LightClusterGridDesc BuildDesc(){
+    LightClusterGridDesc desc;
+    desc.viewportWidth = s_ViewportWidth;
+    desc.viewportHeight = s_ViewportHeight;
+    return desc;
+}
+
+[[nodiscard]] static SceneLight MakePointLight(const Float4& position, const f32 range, const f32 intensity = 1.0f){
+    SceneLight light;
+    light.type = NWB::Impl::Scene::LightType::Point;
+    light.position = Float4(position.x, position.y, position.z, 1.0f);
+    light.colorIntensity = Float4(1.0f, 1.0f, 1.0f, intensity);
+    light.range = range;
+    return light;
+}
+
+[[nodiscard]] static SceneLight MakeSpotLight(const Float4& position, const Float4& axis, const f32 range, const f32 outerConeCos){
+    SceneLight light = MakePointLight(position, range);
+    light.type = NWB::Impl::Scene::LightType::Spot;
+    light.position.w = outerConeCos;
+    light.direction = Float4(axis.x, axis.y, axis.z, outerConeCos);
+    return light;
+}
+
+// Tile coordinates of a view-space point under the test projection (identity view at the origin looking down +z).
+static void TileForViewPoint(const LightClusterGrid& grid, const Float4& point, u32& outTileX, u32& outTileY){
+    const f32 aspect = static_cast<f32>(s_ViewportWidth) / static_cast<f32>(s_ViewportHeight);
+    const f32 ndcX = point.x / (point.z * aspect);
+    const f32 ndcY = point.y / point.z;
+    const f32 pixelX = (ndcX * 0.5f + 0.5f) * static_cast<f32>(s_ViewportWidth);
+    const f32 pixelY = (0.5f - ndcY * 0.5f) * static_cast<f32>(s_ViewportHeight);
+    outTileX = Min(static_cast<u32>(pixelX) / NWB::Impl::Scene::LightClusterDefaults::s_TileSizePixels, grid.tileCountX() - 1u);
+    outTileY = Min(static_cast<u32>(pixelY) / NWB::Impl::Scene::LightClusterDefaults::s_TileSizePixels, grid.tileCountY() - 1u);
+}
+
+[[nodiscard]] static bool ClusterHoldsLight(const LightClusterGrid& grid, const u32 clusterIndex, const u32 lightIndex){
+    const NWB::Impl::Scene::LightClusterRange& range = grid.cluster(clusterIndex);
+    for(u32 i = 0u; i < range.count; ++i){
+        if(grid.clusterLightIndices()[range.offset + i] == lightIndex)
+            return true;
+    }
+    return false;
+}
+
+[[nodiscard]] static u32 ClusterAtViewPoint(const LightClusterGrid& grid, const Float4& point){
+    u32 tileX = 0u;
+    u32 tileY = 0u;
+    TileForViewPoint(grid, point, tileX, tileY);
+    return grid.clusterIndex(tileX, tileY, grid.sliceForDepth(point.z));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TEST(LightClusters, BuildsGridForViewport){
+    TestWorld testWorld;
+    LightClusterGrid grid(testWorld.arena);
+
+    SceneLight directional;
+    ASSERT_TRUE(grid.build(BuildDesc(), NWB::Impl::Scene::SceneViewBasis{}, BuildProjection(), &directional, 1u, testWorld.threadPool));
+    EXPECT_EQ(grid.tileCountX(), 30u);
+    EXPECT_EQ(grid.tileCountY(), 17u);
+    EXPECT_EQ(grid.sliceCount(), NWB::Impl::Scene::LightClusterDefaults::s_DepthSliceCount);
+    EXPECT_EQ(grid.clusterCount(), 30u * 17u * NWB::Impl::Scene::LightClusterDefaults::s_DepthSliceCount);
+    EXPECT_EQ(grid.assignmentCount(), 0u);
+    ASSERT_EQ(grid.directionalLights().size(), 1u);
+    EXPECT_EQ(grid.directionalLights()[0], 0u);
+
+    EXPECT_EQ(grid.sliceForDepth(s_NearPlane * 0.5f), 0u);
+    EXPECT_EQ(grid.sliceForDepth(s_FarPlane * 2.0f), grid.sliceCount() - 1u);
+    EXPECT_LT(grid.sliceForDepth(1.0f), grid.sliceForDepth(10.0f));
+
+    LightClusterGridDesc invalid = BuildDesc();
+    invalid.viewportWidth = 0u;
+    EXPECT_FALSE(grid.build(invalid, NWB::Impl::Scene::SceneViewBasis{}, BuildProjection(), nullptr, 0u, testWorld.threadPool));
+    EXPECT_EQ(grid.clusterCount(), 0u);
+}
+
+TEST(LightClusters, AssignsPointAndSpotLightsToReachedClusters){
+    TestWorld testWorld;
+    LightClusterGrid grid(testWorld.arena);
+
+    SceneLight lights[2] = {
+        MakePointLight(Float4(-4.0f, 0.0f, 20.0f), 1.0f),
+        MakeSpotLight(Float4(4.0f, 0.0f, 20.0f), Float4(0.0f, 0.0f, 1.0f), 6.0f, 0.9f),
+    };
+    ASSERT_TRUE(grid.build(BuildDesc(), NWB::Impl::Scene::SceneViewBasis{}, BuildProjection(), lights, 2u, testWorld.threadPool));
+    EXPECT_EQ(grid.clusteredLightCount(), 2u);
+
+    EXPECT_TRUE(ClusterHoldsLight(grid, ClusterAtViewPoint(grid, Float4(-4.0f, 0.0f, 20.0f)), 0u));
+    EXPECT_FALSE(ClusterHoldsLight(grid, ClusterAtViewPoint(grid, Float4(-4.0f, 0.0f, 40.0f)), 0u));
+    EXPECT_FALSE(ClusterHoldsLight(grid, ClusterAtViewPoint(grid, Float4(4.0f, 0.0f, 20.0f)), 0u));
+
+    // The spot reaches forward along its axis but not behind its apex, although both points are inside its range.
+    EXPECT_TRUE(ClusterHoldsLight(grid, ClusterAtViewPoint(grid, Float4(4.0f, 0.0f, 25.0f)), 1u));
+    EXPECT_FALSE(ClusterHoldsLight(grid, ClusterAtViewPoint(grid, Float4(4.0f, 0.0f, 15.0f)), 1u));
+}
+
+TEST(LightClusters, KeepsMostImportantLightsWithinBudgets){
+    TestWorld testWorld;
+    LightClusterGrid grid(testWorld.arena);
+
+    SceneLight lights[6];
+    for(u32 i = 0u; i < LengthOf(lights); ++i)
+        lights[i] = MakePointLight(Float4(0.0f, 0.0f, 10.0f), 2.0f, 1.0f + static_cast<f32>((i * 5u) % 6u));
+
+    LightClusterGridDesc desc = BuildDesc();
+    desc.maxLightsPerCluster = 3u;
+    ASSERT_TRUE(grid.build(desc, NWB::Impl::Scene::SceneViewBasis{}, BuildProjection(), lights, LengthOf(lights), testWorld.threadPool));
+
+    // Intensities are 1, 6, 5, 4, 3, 2: the cluster keeps the three brightest, brightest first.
+    const NWB::Impl::Scene::LightClusterRange& range = grid.cluster(ClusterAtViewPoint(grid, Float4(0.0f, 0.0f, 10.0f)));
+    ASSERT_EQ(range.count, 3u);
+    EXPECT_EQ(grid.clusterLightIndices()[range.offset + 0u], 1u);
+    EXPECT_EQ(grid.clusterLightIndices()[range.offset + 1u], 2u);
+    EXPECT_EQ(grid.clusterLightIndices()[range.offset + 2u], 3u);
+
+    desc.maxLightsPerCluster = NWB::Impl::Scene::LightClusterDefaults::s_MaxLightsPerCluster;
+    desc.lightBudget = 2u;
+    ASSERT_TRUE(grid.build(desc, NWB::Impl::Scene::SceneViewBasis{}, BuildProjection(), lights, LengthOf(lights), testWorld.threadPool));
+    EXPECT_EQ(grid.clusteredLightCount(), 2u);
+    for(const u32 lightIndex : grid.clusterLightIndices())
+        EXPECT_TRUE(lightIndex == 1u || lightIndex == 2u);
+}
+
+TEST(LightClusters, ParallelBuildMatchesInlineBuild){
+    TestWorld testWorld;
+    NWB::Core::Alloc::ThreadPool parallelPool(4u, CpuAffinity::Any);
+    LightClusterGrid inlineGrid(testWorld.arena);
+    LightClusterGrid parallelGrid(testWorld.arena);
+
+    // A deterministic spread of point and spot lights through the frustum, every center inside the view.
+    TestVector<SceneLight> lights(testWorld.arena);
+    u32 seed = 0x9E3779B9u;
+    const auto next = [&seed](){
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<f32>(seed >> 8u) / static_cast<f32>(1u << 24u);
+    };
+    for(u32 i = 0u; i < 1024u; ++i){
+        const f32 depth = 1.0f + next() * 80.0f;
+        const Float4 position((next() * 2.0f - 1.0f) * depth, (next() * 1.0f - 0.5f) * depth, depth);
+        if((i & 3u) == 0u)
+            lights.push_back(MakeSpotLight(position, Float4(0.0f, -1.0f, 0.0f), 1.0f + next() * 8.0f, 0.7f));
+        else
+            lights.push_back(MakePointLight(position, 0.5f + next() * 6.0f, 0.5f + next()));
+    }
+
+    LightClusterGridDesc desc = BuildDesc();
+    desc.maxLightsPerCluster = static_cast<u32>(lights.size());
+    const NWB::Impl::Scene::SceneViewBasis view;
+    ASSERT_TRUE(inlineGrid.build(desc, view, BuildProjection(), lights.data(), lights.size(), testWorld.threadPool));
+    ASSERT_TRUE(parallelGrid.build(desc, view, BuildProjection(), lights.data(), lights.size(), parallelPool));
+
+    ASSERT_EQ(inlineGrid.clusterCount(), parallelGrid.clusterCount());
+    ASSERT_EQ(inlineGrid.assignmentCount(), parallelGrid.assignmentCount());
+    for(usize cluster = 0u; cluster < inlineGrid.clusterCount(); ++cluster){
+        EXPECT_EQ(inlineGrid.cluster(cluster).offset, parallelGrid.cluster(cluster).offset);
+        EXPECT_EQ(inlineGrid.cluster(cluster).count, parallelGrid.cluster(cluster).count);
+    }
+    for(usize i = 0u; i < inlineGrid.assignmentCount(); ++i)
+        EXPECT_EQ(inlineGrid.clusterLightIndices()[i], parallelGrid.clusterLightIndices()[i]);
+
+    // No false negatives: the cluster holding each point light's center always lists that light.
+    for(u32 lightIndex = 0u; lightIndex < lights.size(); ++lightIndex){
+        if(lights[lightIndex].type != NWB::Impl::Scene::LightType::Point)
+            continue;
+        EXPECT_TRUE(ClusterHoldsLight(inlineGrid, ClusterAtViewPoint(inlineGrid, lights[lightIndex].position), lightIndex));
+    }
+}
+
+TEST(LightClusters, GatherKeepsMostImportantLightsOverBudget){
+    TestWorld testWorld;
+
+    // Dim lights first in ECS order, so a first-come gather would keep exactly the wrong ones. Every range covers
+    // the view, so importance follows intensity alone.
+    constexpr u32 s_LightCount = 8u;
+    for(u32 i = 0u; i < s_LightCount; ++i){
+        const NWB::Core::ECS::EntityID light = NWB::Impl::Scene::CreatePointLightEntity(
+            testWorld.world,
+            Float4(static_cast<f32>(i), 0.0f, 5.0f),
+            Float4(1.0f, 1.0f, 1.0f),
+            1.0f + static_cast<f32>(i),
+            100.0f
+        );
+        ASSERT_TRUE(light.valid());
+    }
+
+    SceneLight gathered[3];
+    f32 importance[LengthOf(gathered)] = {};
+    const usize count = NWB::Impl::Scene::GatherSceneLights(
+        testWorld.world,
+        s_SIMDIdentityR2,
+        VectorZero(),
+        gathered,
+        importance,
+        LengthOf(gathered)
+    );
+    ASSERT_EQ(count, 3u);
+    EXPECT_EQ(gathered[0].colorIntensity.w, 8.0f);
+    EXPECT_EQ(gathered[1].colorIntensity.w, 7.0f);
+    EXPECT_EQ(gathered[2].colorIntensity.w, 6.0f);
+    for(usize i = 0u; i < count; ++i)
+        EXPECT_EQ(importance[i], NWB::Impl::Scene::SceneLightImportance(gathered[i], VectorZero()));
+}
+
+TEST(LightClusters, GatherRanksLightsUnderBudget){
+    TestWorld testWorld;
+
+    // Renderer budgets take a prefix of the gathered list, so it is ranked even when every light fits.
+    constexpr u32 s_LightCount = 6u;
+    const f32 intensities[s_LightCount] = { 2.0f, 5.0f, 1.0f, 6.0f, 3.0f, 4.0f };
+    for(u32 i = 0u; i < s_LightCount; ++i){
+        const NWB::Core::ECS::EntityID light = NWB::Impl::Scene::CreatePointLightEntity(
+            testWorld.world,
+            Float4(static_cast<f32>(i), 0.0f, 5.0f),
+            Float4(1.0f, 1.0f, 1.0f),
+            intensities[i],
+            100.0f
+        );
+        ASSERT_TRUE(light.valid());
+    }
+
+    SceneLight gathered[8];
+    f32 importance[LengthOf(gathered)] = {};
+    const usize count = NWB::Impl::Scene::GatherSceneLights(
+        testWorld.world,
+        s_SIMDIdentityR2,
+        VectorZero(),
+        gathered,
+        importance,
+        LengthOf(gathered)
+    );
+    ASSERT_EQ(count, s_LightCount);
+    for(usize i = 0u; i < count; ++i)
+        EXPECT_EQ(gathered[i].colorIntensity.w, static_cast<f32>(s_LightCount - i));
+    for(usize i = 1u; i < count; ++i)
+        EXPECT_GE(importance[i - 1u], importance[i]);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,223 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Manual CPU probe for transform hierarchy propagation. It builds 100,000 nodes as 1,000 roots each carrying a
+// 99-node binary tree, then measures a full recompute, a frame where 1% of the nodes are marked dirty, and a frame
+// where nothing changes, on an inline (zero worker) pool and on a pool with one worker per core. It reports
+// min/median/max wall time per frame and fails if the serial and parallel world transforms disagree.
+
+
+#include <core/alloc/general.h>
+#include <core/alloc/thread.h>
+#include <core/common/application_entry.h>
+#include <core/common/module.h>
+#include <core/ecs/module.h>
+#include <impl/ecs_scene/module.h>
+
+#include <tests/common/profile_timing.h>
+#include <tests/common/test_context.h>
+
+#include <global/cpu_topology.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace TransformHierarchyProfile{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<typename T>
+using Vector = Tests::TestVector<T>;
+
+
+inline constexpr u32 s_RootCount = 1000u;
+inline constexpr u32 s_NodesPerTree = 100u;
+inline constexpr u32 s_DirtyStride = 100u;
+inline constexpr u32 s_WarmupCount = 2u;
+inline constexpr u32 s_SampleCount = 31u;
+inline constexpr f32 s_FrameDelta = 1.0f / 60.0f;
+inline constexpr f32 s_MatchEpsilon = 0.001f;
+
+inline constexpr Name s_ProfileArena("tests/unit/scene/transform_hierarchy_profile");
+
+
+struct ProfileWorld{
+    Core::Alloc::GlobalArena arena;
+    Core::Alloc::ThreadPool threadPool;
+    Core::ECS::World world;
+    Impl::Scene::TransformHierarchySystem* system = nullptr;
+    Vector<Core::ECS::EntityID> roots;
+    Vector<Core::ECS::EntityID> nodes;
+    u32 frame = 0u;
+
+    explicit ProfileWorld(const u32 workerCount)
+        : arena(s_ProfileArena)
+        , threadPool(workerCount, CpuAffinity::Any)
+        , world(arena, threadPool)
+    {
+        system = &world.addSystem<Impl::Scene::TransformHierarchySystem>(world);
+    }
+};
+
+struct Result{
+    u32 workerCount = 0u;
+    Tests::ProfileTimingSamples serialFull;
+    Tests::ProfileTimingSamples serialDirty;
+    Tests::ProfileTimingSamples parallelFull;
+    Tests::ProfileTimingSamples parallelDirty;
+    Tests::ProfileTimingSamples unchanged;
+};
+
+
+static void PopulateWorld(ProfileWorld& profileWorld){
+    profileWorld.roots.reserve(s_RootCount);
+    profileWorld.nodes.reserve(s_RootCount * (s_NodesPerTree - 1u));
+
+    Vector<Core::ECS::EntityID> tree;
+    tree.reserve(s_NodesPerTree);
+    for(u32 rootIndex = 0u; rootIndex < s_RootCount; ++rootIndex){
+        auto root = profileWorld.world.createEntity();
+        root.addComponent<Impl::Scene::TransformComponent>().position = Float4(static_cast<f32>(rootIndex), 0.0f, 0.0f);
+        profileWorld.roots.push_back(root.id());
+
+        tree.clear();
+        tree.push_back(root.id());
+        for(u32 nodeIndex = 1u; nodeIndex < s_NodesPerTree; ++nodeIndex){
+            const f32 angle = 0.05f * static_cast<f32>(nodeIndex);
+            auto entity = profileWorld.world.createEntity();
+            auto& node = entity.addComponent<Impl::Scene::TransformParentComponent>();
+            node.parent = tree[(nodeIndex - 1u) / 2u];
+            node.local.position = Float4(0.1f, 0.2f, 0.01f * static_cast<f32>(nodeIndex % 5u));
+            node.local.rotation = Float4(0.0f, Sin(angle), 0.0f, Cos(angle));
+            tree.push_back(entity.id());
+            profileWorld.nodes.push_back(entity.id());
+        }
+    }
+}
+
+static void MarkDirty(ProfileWorld& profileWorld){
+    // Rotate which nodes move each frame so repeated samples do not hit the same cache lines.
+    const u32 offset = profileWorld.frame++ % s_DirtyStride;
+    for(usize nodeIndex = offset; nodeIndex < profileWorld.nodes.size(); nodeIndex += s_DirtyStride){
+        auto& node = profileWorld.world.entity(profileWorld.nodes[nodeIndex]).getComponent<Impl::Scene::TransformParentComponent>();
+        node.local.position.y += 0.001f;
+        node.dirty = true;
+    }
+}
+
+static void MarkAllDirty(ProfileWorld& profileWorld){
+    for(const Core::ECS::EntityID root : profileWorld.roots)
+        profileWorld.world.entity(root).getComponent<Impl::Scene::TransformComponent>().position.y += 0.001f;
+}
+
+static void Measure(ProfileWorld& profileWorld, void (*mutate)(ProfileWorld&), Tests::ProfileTimingSamples& outSamples){
+    for(u32 i = 0u; i < s_WarmupCount + s_SampleCount; ++i){
+        if(mutate)
+            mutate(profileWorld);
+
+        const Timer begin = TimerNow();
+        profileWorld.world.tick(s_FrameDelta);
+        if(i >= s_WarmupCount && !outSamples.append(DurationInSeconds<f64>(TimerNow(), begin)))
+            break;
+    }
+}
+
+[[nodiscard]] static bool WorldsMatch(ProfileWorld& lhs, ProfileWorld& rhs){
+    if(lhs.nodes.size() != rhs.nodes.size() || lhs.system->nodeCount() != rhs.system->nodeCount())
+        return false;
+
+    for(usize nodeIndex = 0u; nodeIndex < lhs.nodes.size(); ++nodeIndex){
+        const auto* lhsWorld = lhs.world.tryGetComponent<Impl::Scene::WorldTransformComponent>(lhs.nodes[nodeIndex]);
+        const auto* rhsWorld = rhs.world.tryGetComponent<Impl::Scene::WorldTransformComponent>(rhs.nodes[nodeIndex]);
+        if(!lhsWorld || !rhsWorld)
+            return false;
+
+        for(usize element = 0u; element < LengthOf(lhsWorld->world.raw); ++element){
+            if(Abs(lhsWorld->world.raw[element] - rhsWorld->world.raw[element]) > s_MatchEpsilon)
+                return false;
+        }
+    }
+    return true;
+}
+
+[[nodiscard]] static bool RunProfile(Result& outResult){
+    outResult.workerCount = Max(QueryCpuCoreCount(CpuAffinity::Any), 1u);
+
+    ProfileWorld serialWorld(0u);
+    ProfileWorld parallelWorld(outResult.workerCount);
+    PopulateWorld(serialWorld);
+    PopulateWorld(parallelWorld);
+
+    // Both worlds apply the same mutation sequence so their transforms can be compared afterwards.
+    Measure(serialWorld, &MarkAllDirty, outResult.serialFull);
+    Measure(serialWorld, &MarkDirty, outResult.serialDirty);
+    Measure(parallelWorld, &MarkAllDirty, outResult.parallelFull);
+    Measure(parallelWorld, &MarkDirty, outResult.parallelDirty);
+    Measure(parallelWorld, nullptr, outResult.unchanged);
+    return serialWorld.system->nodeCount() == static_cast<usize>(s_RootCount) * s_NodesPerTree && WorldsMatch(serialWorld, parallelWorld);
+}
+
+static void EmitResult(const Result& result, const bool matched){
+    NWB_COUT
+        << "{\"status\":\"" << (matched ? "ok" : "failed") << "\","
+        << "\"nodes\":" << (s_RootCount * s_NodesPerTree) << ','
+        << "\"dirty_per_frame\":" << (s_RootCount * (s_NodesPerTree - 1u) / s_DirtyStride) << ','
+        << "\"workers\":" << result.workerCount << ','
+        << "\"samples\":" << s_SampleCount << ','
+    ;
+    Tests::EmitProfileTiming("serial_full", result.serialFull);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming("serial_dirty", result.serialDirty);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming("parallel_full", result.parallelFull);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming("parallel_dirty", result.parallelDirty);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming("unchanged", result.unchanged);
+    NWB_COUT << "}\n";
+}
+
+[[nodiscard]] static int EntryPoint(const isize, tchar**, void*){
+    Core::Common::InitializerGuard commonInitializerGuard;
+    if(!commonInitializerGuard.initialize()){
+        NWB_CERR << "transform hierarchy profile initialization failed\n";
+        return 1;
+    }
+
+    Result result;
+    const bool matched = RunProfile(result);
+    EmitResult(result, matched);
+    return matched ? 0 : 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_DEFINE_APPLICATION_ENTRY_POINT(::NWB::TransformHierarchyProfile::EntryPoint)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,193 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <core/ecs/module.h>
+#include <core/common/module.h>
+#include <impl/ecs_scene/module.h>
+
+#include <tests/common/ecs_test_world.h>
+
+#include <gtest/gtest.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_transform_hierarchy_tests{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+using TestWorld = NWB::Tests::EcsTestWorld;
+using TransformComponent = NWB::Impl::Scene::TransformComponent;
+using TransformParentComponent = NWB::Impl::Scene::TransformParentComponent;
+using WorldTransformComponent = NWB::Impl::Scene::WorldTransformComponent;
+
+inline constexpr f32 s_TransformEpsilon = 0.0001f;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+[[nodiscard]] static NWB::Core::ECS::EntityID AddChild(
+    TestWorld& testWorld,
+    const NWB::Core::ECS::EntityID parent,
+    const Float4& localPosition
+){
+    auto entity = testWorld.world.createEntity();
+    auto& node = entity.addComponent<TransformParentComponent>();
+    node.parent = parent;
+    node.local.position = localPosition;
+    return entity.id();
+}
+
+static void ExpectPosition(TestWorld& testWorld, const NWB::Core::ECS::EntityID entity, const f32 x, const f32 y, const f32 z){
+    const auto* transform = testWorld.world.tryGetComponent<TransformComponent>(entity);
+    const auto* world = testWorld.world.tryGetComponent<WorldTransformComponent>(entity);
+    ASSERT_NE(transform, nullptr);
+    ASSERT_NE(world, nullptr);
+    EXPECT_NEAR(transform->position.x, x, s_TransformEpsilon);
+    EXPECT_NEAR(transform->position.y, y, s_TransformEpsilon);
+    EXPECT_NEAR(transform->position.z, z, s_TransformEpsilon);
+    EXPECT_NEAR(world->world.m[0][3], x, s_TransformEpsilon);
+    EXPECT_NEAR(world->world.m[1][3], y, s_TransformEpsilon);
+    EXPECT_NEAR(world->world.m[2][3], z, s_TransformEpsilon);
+}
+
+[[nodiscard]] static u64 NodeVersion(TestWorld& testWorld, const NWB::Core::ECS::EntityID entity){
+    const auto* world = testWorld.world.tryGetComponent<WorldTransformComponent>(entity);
+    return world ? world->version : 0u;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TEST(TransformHierarchy, ComposesParentChains){
+    TestWorld testWorld;
+    auto& system = testWorld.world.addSystem<NWB::Impl::Scene::TransformHierarchySystem>(testWorld.world);
+
+    auto root = testWorld.world.createEntity();
+    auto& rootTransform = root.addComponent<TransformComponent>();
+    rootTransform.position = Float4(1.0f, 0.0f, 0.0f);
+    rootTransform.scale = Float4(2.0f, 2.0f, 2.0f);
+
+    const NWB::Core::ECS::EntityID child = AddChild(testWorld, root.id(), Float4(0.0f, 1.0f, 0.0f));
+    const NWB::Core::ECS::EntityID grandchild = AddChild(testWorld, child, Float4(0.0f, 0.0f, 1.0f));
+
+    testWorld.world.tick(0.0f);
+    EXPECT_EQ(system.nodeCount(), 3u);
+    EXPECT_EQ(system.levelCount(), 3u);
+    ExpectPosition(testWorld, root.id(), 1.0f, 0.0f, 0.0f);
+    ExpectPosition(testWorld, child, 1.0f, 2.0f, 0.0f);
+    ExpectPosition(testWorld, grandchild, 1.0f, 2.0f, 2.0f);
+    EXPECT_NEAR(testWorld.world.entity(grandchild).getComponent<TransformComponent>().scale.x, 2.0f, s_TransformEpsilon);
+    EXPECT_FALSE(testWorld.world.entity(child).getComponent<TransformParentComponent>().dirty);
+}
+
+TEST(TransformHierarchy, UpdatesOnlyDirtySubtrees){
+    TestWorld testWorld;
+    auto& system = testWorld.world.addSystem<NWB::Impl::Scene::TransformHierarchySystem>(testWorld.world);
+
+    auto root = testWorld.world.createEntity();
+    root.addComponent<TransformComponent>().position = Float4(0.0f, 0.0f, 0.0f);
+    const NWB::Core::ECS::EntityID left = AddChild(testWorld, root.id(), Float4(-1.0f, 0.0f, 0.0f));
+    const NWB::Core::ECS::EntityID right = AddChild(testWorld, root.id(), Float4(1.0f, 0.0f, 0.0f));
+    const NWB::Core::ECS::EntityID leftLeaf = AddChild(testWorld, left, Float4(0.0f, 1.0f, 0.0f));
+    const NWB::Core::ECS::EntityID rightLeaf = AddChild(testWorld, right, Float4(0.0f, 1.0f, 0.0f));
+
+    testWorld.world.tick(0.0f);
+    const u64 firstVersion = system.changeVersion();
+    EXPECT_NE(firstVersion, 0u);
+
+    // Nothing dirty: neither the system nor any node advances.
+    testWorld.world.tick(0.0f);
+    EXPECT_EQ(system.changeVersion(), firstVersion);
+
+    auto& leftNode = testWorld.world.entity(left).getComponent<TransformParentComponent>();
+    leftNode.local.position = Float4(-3.0f, 0.0f, 0.0f);
+    leftNode.dirty = true;
+    testWorld.world.tick(0.0f);
+
+    const u64 secondVersion = system.changeVersion();
+    EXPECT_GT(secondVersion, firstVersion);
+    EXPECT_EQ(NodeVersion(testWorld, left), secondVersion);
+    EXPECT_EQ(NodeVersion(testWorld, leftLeaf), secondVersion);
+    EXPECT_EQ(NodeVersion(testWorld, right), firstVersion);
+    EXPECT_EQ(NodeVersion(testWorld, rightLeaf), firstVersion);
+    ExpectPosition(testWorld, leftLeaf, -3.0f, 1.0f, 0.0f);
+    ExpectPosition(testWorld, rightLeaf, 1.0f, 1.0f, 0.0f);
+
+    // Moving a root propagates through its whole subtree without any dirty flags.
+    root.getComponent<TransformComponent>().position = Float4(0.0f, 0.0f, 5.0f);
+    testWorld.world.tick(0.0f);
+    EXPECT_EQ(NodeVersion(testWorld, rightLeaf), system.changeVersion());
+    ExpectPosition(testWorld, leftLeaf, -3.0f, 1.0f, 5.0f);
+    ExpectPosition(testWorld, rightLeaf, 1.0f, 1.0f, 5.0f);
+}
+
+TEST(TransformHierarchy, FollowsReparentingAndRemoval){
+    TestWorld testWorld;
+    auto& system = testWorld.world.addSystem<NWB::Impl::Scene::TransformHierarchySystem>(testWorld.world);
+
+    auto first = testWorld.world.createEntity();
+    first.addComponent<TransformComponent>().position = Float4(10.0f, 0.0f, 0.0f);
+    auto second = testWorld.world.createEntity();
+    second.addComponent<TransformComponent>().position = Float4(0.0f, 10.0f, 0.0f);
+
+    const NWB::Core::ECS::EntityID child = AddChild(testWorld, first.id(), Float4(1.0f, 0.0f, 0.0f));
+    const NWB::Core::ECS::EntityID leaf = AddChild(testWorld, child, Float4(0.0f, 0.0f, 1.0f));
+    testWorld.world.tick(0.0f);
+    ExpectPosition(testWorld, leaf, 11.0f, 0.0f, 1.0f);
+    EXPECT_EQ(system.nodeCount(), 3u);
+
+    auto& childNode = testWorld.world.entity(child).getComponent<TransformParentComponent>();
+    childNode.parent = second.id();
+    childNode.dirty = true;
+    testWorld.world.tick(0.0f);
+    EXPECT_EQ(system.nodeCount(), 3u);
+    ExpectPosition(testWorld, leaf, 1.0f, 10.0f, 1.0f);
+
+    // Dropping the node turns the leaf's parent into a root whose authored transform is the last resolved one.
+    testWorld.world.entity(child).removeComponent<TransformParentComponent>();
+    testWorld.world.tick(0.0f);
+    ExpectPosition(testWorld, leaf, 1.0f, 10.0f, 1.0f);
+    testWorld.world.entity(child).getComponent<TransformComponent>().position = Float4(0.0f, 0.0f, 0.0f);
+    testWorld.world.tick(0.0f);
+    ExpectPosition(testWorld, leaf, 0.0f, 0.0f, 1.0f);
+}
+
+TEST(TransformHierarchy, DetachesCycles){
+    TestWorld testWorld;
+    testWorld.world.addSystem<NWB::Impl::Scene::TransformHierarchySystem>(testWorld.world);
+
+    auto first = testWorld.world.createEntity();
+    auto second = testWorld.world.createEntity();
+    auto& firstNode = first.addComponent<TransformParentComponent>();
+    firstNode.parent = second.id();
+    firstNode.local.position = Float4(1.0f, 0.0f, 0.0f);
+    auto& secondNode = second.addComponent<TransformParentComponent>();
+    secondNode.parent = first.id();
+    secondNode.local.position = Float4(0.0f, 1.0f, 0.0f);
+
+    testWorld.world.tick(0.0f);
+    const auto& firstTransform = first.getComponent<TransformComponent>();
+    const auto& secondTransform = second.getComponent<TransformComponent>();
+    // One node is cut loose and keeps its local offset; the other composes on top of it.
+    const f32 firstSum = firstTransform.position.x + firstTransform.position.y;
+    const f32 secondSum = secondTransform.position.x + secondTransform.position.y;
+    EXPECT_NEAR(firstSum + secondSum, 3.0f, s_TransformEpsilon);
+    EXPECT_NEAR(Abs(firstSum - secondSum), 1.0f, s_TransformEpsilon);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
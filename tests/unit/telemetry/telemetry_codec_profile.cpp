@@ -0,0 +1,317 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Manual CPU probe for the telemetry stream codec. It records a 600-frame session through the real perf and text log
+// recorders (eight CPU and four GPU timing scopes, two memory scopes and a log line every 30 frames), then encodes and
+// decodes it as a fixed-header version 1 stream and as a compact stream. It reports the encoded and per-event header
+// bytes of both plus min/median/max wall time and median MB/s for each pass, and fails if either stream does not
+// decode back to the recorded session.
+
+
+#include <core/common/application_entry.h>
+#include <core/common/module.h>
+#include <core/telemetry/module.h>
+
+#include <tests/common/profile_timing.h>
+#include <tests/common/test_context.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace TelemetryCodecProfile{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace Telemetry = Core::Telemetry;
+
+
+inline constexpr u64 s_FrameCount = 600u;
+inline constexpr u64 s_LogFrameInterval = 30u;
+inline constexpr u32 s_CpuStreamId = 0u;
+inline constexpr u32 s_GpuStreamId = 1u;
+inline constexpr u32 s_MemoryStreamId = 2u;
+inline constexpr u32 s_LogStreamId = 3u;
+inline constexpr u32 s_WarmupCount = 1u;
+inline constexpr u32 s_SampleCount = 15u;
+inline constexpr f64 s_BytesPerMegabyte = 1000.0 * 1000.0;
+
+inline constexpr const char* s_CpuScopes[] = {
+    "frame/cpu",
+    "frame/input",
+    "frame/ecs/update",
+    "frame/ecs/transform",
+    "frame/scene/cull",
+    "frame/scene/lights",
+    "frame/render/record",
+    "frame/render/submit",
+};
+inline constexpr const char* s_GpuScopes[] = {
+    "frame/gpu",
+    "gpu/depth_prepass",
+    "gpu/lighting",
+    "gpu/post",
+};
+inline constexpr const char* s_MemoryScopes[] = {
+    "memory/global",
+    "memory/render",
+};
+
+inline constexpr Name s_ProfileArena("tests/unit/telemetry/telemetry_codec_profile");
+
+
+struct FormatResult{
+    usize encodedBytes = 0u;
+    Tests::ProfileTimingSamples encode;
+    Tests::ProfileTimingSamples decode;
+    bool matched = false;
+};
+
+struct Result{
+    usize eventCount = 0u;
+    usize payloadBytes = 0u;
+    FormatResult fixedHeader;
+    FormatResult compact;
+};
+
+
+[[nodiscard]] static bool RecordSession(Telemetry::Recorder& recorder){
+    for(u64 frame = 0u; frame < s_FrameCount; ++frame){
+        for(usize scope = 0u; scope < LengthOf(s_CpuScopes); ++scope){
+            Core::Perf::TimingStats stats;
+            stats.seconds = 0.0005 * static_cast<f64>(scope + 1u) + 0.00001 * static_cast<f64>(frame % 7u);
+            stats.minSeconds = stats.seconds * 0.9;
+            stats.maxSeconds = stats.seconds * 1.2;
+            stats.lastSeconds = stats.seconds;
+            stats.sampleCount = 1u;
+            stats.publishFrameIndex = frame;
+            stats.firstSampleFrameIndex = frame;
+            stats.lastSampleFrameIndex = frame;
+            const AStringView text(s_CpuScopes[scope]);
+            if(!Telemetry::RecordPerfTiming(recorder, Telemetry::PerfTimingSource::Cpu, Name(text), text, stats, s_CpuStreamId))
+                return false;
+        }
+        for(usize scope = 0u; scope < LengthOf(s_GpuScopes); ++scope){
+            Core::Perf::TimingStats stats;
+            stats.seconds = 0.001 * static_cast<f64>(scope + 1u);
+            stats.minSeconds = stats.seconds;
+            stats.maxSeconds = stats.seconds;
+            stats.lastSeconds = stats.seconds;
+            stats.sampleCount = 1u;
+            // GPU timings resolve a couple of frames late.
+            stats.publishFrameIndex = frame;
+            stats.firstSampleFrameIndex = frame > 2u ? frame - 2u : 0u;
+            stats.lastSampleFrameIndex = stats.firstSampleFrameIndex;
+            const AStringView text(s_GpuScopes[scope]);
+            if(!Telemetry::RecordPerfTiming(recorder, Telemetry::PerfTimingSource::Gpu, Name(text), text, stats, s_GpuStreamId))
+                return false;
+        }
+        for(usize scope = 0u; scope < LengthOf(s_MemoryScopes); ++scope){
+            const AStringView text(s_MemoryScopes[scope]);
+            Core::Perf::MemorySnapshot snapshot;
+            snapshot.scopeName = Name(text);
+            snapshot.frameIndex = frame;
+            snapshot.reservedBytes = (64ull << 20u) * (scope + 1u);
+            snapshot.usedBytes = (16ull << 20u) + frame * 4096u;
+            snapshot.peakUsedBytes = snapshot.usedBytes;
+            snapshot.allocationCount = frame * 37u;
+            snapshot.deallocationCount = frame * 35u;
+            Core::Perf::MemoryDelta delta;
+            delta.previousFrameIndex = frame > 0u ? frame - 1u : 0u;
+            if(!Telemetry::RecordPerfMemory(recorder, snapshot.scopeName, text, snapshot, delta, s_MemoryStreamId))
+                return false;
+        }
+        if(frame % s_LogFrameInterval == 0u){
+            if(!Telemetry::RecordTextLog(recorder, Core::Common::LogType::Info, NWB_TEXT("streaming: resident set updated"), frame, s_LogStreamId))
+                return false;
+        }
+    }
+    return true;
+}
+
+// The version 1 layout: a stream header followed by one EncodedEventHeader and payload per event.
+[[nodiscard]] static bool EncodeFixedHeaderStream(
+    const Telemetry::EventView& events,
+    Telemetry::TelemetryBytes& eventBytes,
+    Telemetry::TelemetryBytes& outBytes
+){
+    Telemetry::EncodedStreamHeader streamHeader;
+    streamHeader.version = Telemetry::s_TelemetryFixedHeaderFormatVersion;
+    streamHeader.eventCount = events.eventCount();
+
+    outBytes.clear();
+    outBytes.resize(sizeof(streamHeader));
+    for(usize i = 0u; i < events.eventCount(); ++i){
+        if(!Telemetry::EncodeEvent(*events.eventAt(i), eventBytes))
+            return false;
+        outBytes.insert(outBytes.end(), eventBytes.begin(), eventBytes.end());
+    }
+
+    streamHeader.payloadBytes = outBytes.size() - sizeof(streamHeader);
+    NWB_MEMCPY(outBytes.data(), outBytes.size(), &streamHeader, sizeof(streamHeader));
+    return true;
+}
+
+[[nodiscard]] static bool SessionsMatch(const Telemetry::Recorder& lhs, const Telemetry::Recorder& rhs){
+    if(lhs.eventCount() != rhs.eventCount())
+        return false;
+
+    for(usize i = 0u; i < lhs.eventCount(); ++i){
+        const Telemetry::EventRecord* left = lhs.view().eventAt(i);
+        const Telemetry::EventRecord* right = rhs.view().eventAt(i);
+        if(!left || !right)
+            return false;
+        if(left->header.kind != right->header.kind
+            || left->header.streamId != right->header.streamId
+            || left->header.frameIndex != right->header.frameIndex
+            || left->header.timestampNanoseconds != right->header.timestampNanoseconds
+            || left->payload.size() != right->payload.size()
+        )
+            return false;
+        if(!left->payload.empty() && NWB_MEMCMP(left->payload.data(), right->payload.data(), left->payload.size()) != 0)
+            return false;
+    }
+    return true;
+}
+
+template<typename EncodeFunction>
+static void Measure(
+    Core::Alloc::GlobalArena& arena,
+    const Telemetry::Recorder& session,
+    const EncodeFunction& encodeFunction,
+    Telemetry::TelemetryBytes& encoded,
+    FormatResult& outResult
+){
+    Telemetry::Recorder decoded(arena);
+    bool matched = true;
+    for(u32 i = 0u; i < s_WarmupCount + s_SampleCount; ++i){
+        const Timer encodeBegin = TimerNow();
+        matched = encodeFunction() && matched;
+        const Timer decodeBegin = TimerNow();
+        matched = Telemetry::DecodeEventStream(arena, encoded.data(), encoded.size(), decoded).ok() && matched;
+        const Timer decodeEnd = TimerNow();
+
+        if(i < s_WarmupCount)
+            continue;
+        if(!outResult.encode.append(DurationInSeconds<f64>(decodeBegin, encodeBegin)))
+            break;
+        if(!outResult.decode.append(DurationInSeconds<f64>(decodeEnd, decodeBegin)))
+            break;
+    }
+
+    outResult.encodedBytes = encoded.size();
+    outResult.matched = matched && SessionsMatch(session, decoded);
+}
+
+[[nodiscard]] static bool RunProfile(Result& outResult){
+    Core::Alloc::GlobalArena arena(s_ProfileArena);
+    Telemetry::Recorder session(arena);
+    session.setCaptureOptions(Telemetry::CaptureOptions::All());
+    if(!RecordSession(session))
+        return false;
+
+    outResult.eventCount = session.eventCount();
+    for(usize i = 0u; i < session.eventCount(); ++i)
+        outResult.payloadBytes += session.view().eventAt(i)->payload.size();
+
+    Telemetry::TelemetryBytes eventBytes(arena);
+    Telemetry::TelemetryBytes encoded(arena);
+    Measure(
+        arena,
+        session,
+        [&](){ return EncodeFixedHeaderStream(session.view(), eventBytes, encoded); },
+        encoded,
+        outResult.fixedHeader
+    );
+    Measure(
+        arena,
+        session,
+        [&](){ return Telemetry::EncodeEventStream(session.view(), encoded); },
+        encoded,
+        outResult.compact
+    );
+    return outResult.fixedHeader.matched && outResult.compact.matched;
+}
+
+static void EmitThroughput(const char* name, const Tests::ProfileTimingSamples& samples, const usize encodedBytes){
+    const Tests::ProfileTimingSummary summary = Tests::SummarizeProfileTiming(samples);
+    NWB_COUT << ',';
+    Tests::EmitProfileTiming(name, samples);
+    NWB_COUT
+        << ",\"" << name << "_median_mb_per_s\":"
+        << (summary.median > 0.0 ? static_cast<f64>(encodedBytes) / s_BytesPerMegabyte / summary.median : 0.0)
+    ;
+}
+
+static void EmitFormat(const char* name, const FormatResult& format, const Result& result){
+    const usize headerBytes = format.encodedBytes - sizeof(Telemetry::EncodedStreamHeader) - result.payloadBytes;
+    NWB_COUT
+        << '\"' << name << "\":{"
+        << "\"matched\":" << (format.matched ? "true" : "false") << ','
+        << "\"encoded_bytes\":" << format.encodedBytes << ','
+        << "\"event_header_bytes\":" << headerBytes << ','
+        << "\"bytes_per_event_header\":"
+        << (result.eventCount > 0u ? static_cast<f64>(headerBytes) / static_cast<f64>(result.eventCount) : 0.0)
+    ;
+    EmitThroughput("encode", format.encode, format.encodedBytes);
+    EmitThroughput("decode", format.decode, format.encodedBytes);
+    NWB_COUT << '}';
+}
+
+static void EmitResult(const Result& result, const bool matched){
+    NWB_COUT
+        << "{\"status\":\"" << (matched ? "ok" : "failed") << "\","
+        << "\"frames\":" << s_FrameCount << ','
+        << "\"events\":" << result.eventCount << ','
+        << "\"payload_bytes\":" << result.payloadBytes << ','
+        << "\"samples\":" << s_SampleCount << ','
+    ;
+    EmitFormat("fixed_header", result.fixedHeader, result);
+    NWB_COUT << ',';
+    EmitFormat("compact", result.compact, result);
+    NWB_COUT << "}\n";
+}
+
+[[nodiscard]] static int EntryPoint(const isize, tchar**, void*){
+    Core::Common::InitializerGuard commonInitializerGuard;
+    if(!commonInitializerGuard.initialize()){
+        NWB_CERR << "telemetry codec profile initialization failed\n";
+        return 1;
+    }
+
+    Result result;
+    const bool matched = RunProfile(result);
+    EmitResult(result, matched);
+    return matched ? 0 : 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_DEFINE_APPLICATION_ENTRY_POINT(::NWB::TelemetryCodecProfile::EntryPoint)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -243,7 +243,7 @@ TEST(Telemetry, EventStreamCodecRoundTrip){
 
     Telemetry::TelemetryBytes encoded(testArena.arena);
     EXPECT_TRUE(Telemetry::EncodeEventStream(recorder.view(), encoded));
-    EXPECT_EQ(encoded.size(), sizeof(Telemetry::EncodedStreamHeader)
+    EXPECT_LT(encoded.size(), sizeof(Telemetry::EncodedStreamHeader)
             + (sizeof(Telemetry::EncodedEventHeader) * 2u)
             + sizeof(perfPayload)
             + sizeof(frameGraphPayload) - 1u);
@@ -319,6 +319,149 @@ TEST(Telemetry, EventStreamCodecRejectsInvalidInput){
     EXPECT_EQ(result.status, Telemetry::DecodeStatus::InvalidHeader);
 }
 
+TEST(Telemetry, EventStreamCodecDecodesFixedHeaderStreams){
+    TestArena testArena;
+    Telemetry::Recorder recorder(testArena.arena);
+    recorder.setCaptureOptions(Telemetry::CaptureOptions::All());
+
+    const u32 perfPayload = 17u;
+    const char frameGraphPayload[] = "{frame:2}";
+    EXPECT_TRUE(recorder.recordBinary(Telemetry::EventKind::PerfFrame, 40u, &perfPayload, sizeof(perfPayload), 1u));
+    EXPECT_TRUE(recorder.recordBinary(
+        Telemetry::EventKind::FrameGraphFrame,
+        41u,
+        frameGraphPayload,
+        sizeof(frameGraphPayload) - 1u,
+        4u
+    ));
+
+    Telemetry::TelemetryBytes events(testArena.arena);
+    Telemetry::TelemetryBytes encodedEvent(testArena.arena);
+    for(usize i = 0u; i < recorder.eventCount(); ++i){
+        EXPECT_TRUE(Telemetry::EncodeEvent(*recorder.view().eventAt(i), encodedEvent));
+        events.insert(events.end(), encodedEvent.begin(), encodedEvent.end());
+    }
+
+    Telemetry::EncodedStreamHeader streamHeader;
+    streamHeader.version = Telemetry::s_TelemetryFixedHeaderFormatVersion;
+    streamHeader.eventCount = recorder.eventCount();
+    streamHeader.payloadBytes = events.size();
+
+    Telemetry::TelemetryBytes encoded(testArena.arena);
+    encoded.resize(sizeof(streamHeader));
+    NWB_MEMCPY(encoded.data(), encoded.size(), &streamHeader, sizeof(streamHeader));
+    encoded.insert(encoded.end(), events.begin(), events.end());
+
+    Telemetry::Recorder decoded(testArena.arena);
+    Telemetry::DecodeResult result = Telemetry::DecodeEventStream(testArena.arena, encoded.data(), encoded.size(), decoded);
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(result.bytesRead, encoded.size());
+    ASSERT_EQ(decoded.eventCount(), recorder.eventCount());
+    for(usize i = 0u; i < recorder.eventCount(); ++i){
+        const Telemetry::EventRecord* source = recorder.view().eventAt(i);
+        const Telemetry::EventRecord* parsed = decoded.view().eventAt(i);
+        ASSERT_NE(parsed, nullptr);
+        EXPECT_EQ(parsed->header.version, source->header.version);
+        EXPECT_EQ(parsed->header.kind, source->header.kind);
+        EXPECT_EQ(parsed->header.streamId, source->header.streamId);
+        EXPECT_EQ(parsed->header.frameIndex, source->header.frameIndex);
+        EXPECT_EQ(parsed->header.timestampNanoseconds, source->header.timestampNanoseconds);
+        ASSERT_EQ(parsed->payload.size(), source->payload.size());
+        EXPECT_EQ(NWB_MEMCMP(parsed->payload.data(), source->payload.data(), source->payload.size()), 0);
+    }
+
+    streamHeader.version = Telemetry::s_TelemetryFormatVersion + 1u;
+    NWB_MEMCPY(encoded.data(), encoded.size(), &streamHeader, sizeof(streamHeader));
+    result = Telemetry::DecodeEventStream(testArena.arena, encoded.data(), encoded.size(), decoded);
+    EXPECT_EQ(result.status, Telemetry::DecodeStatus::InvalidHeader);
+}
+
+TEST(Telemetry, EventStreamCodecFuzzRoundTrip){
+    static constexpr u32 s_RoundCount = 64u;
+    static constexpr u32 s_MaxEventCount = 96u;
+    static constexpr u32 s_MaxPayloadBytes = 300u;
+    static constexpr Telemetry::EventKind::Enum s_Kinds[] = {
+        Telemetry::EventKind::TextLog,
+        Telemetry::EventKind::Diagnostic,
+        Telemetry::EventKind::PerfFrame,
+        Telemetry::EventKind::FrameGraphFrame,
+        Telemetry::EventKind::MemoryFrame,
+    };
+
+    TestArena testArena;
+    u64 state = 0x2545f4914f6cdd1dull;
+    const auto next = [&state](){
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return state ^ (state >> 29u);
+    };
+
+    Telemetry::TelemetryBytes payload(testArena.arena);
+    Telemetry::TelemetryBytes encoded(testArena.arena);
+    Telemetry::TelemetryBytes corrupted(testArena.arena);
+    for(u32 round = 0u; round < s_RoundCount; ++round){
+        Telemetry::Recorder recorder(testArena.arena);
+        const usize eventCount = static_cast<usize>(next() % (s_MaxEventCount + 1u));
+        u64 frameIndex = next() >> (next() % 64u);
+        u64 timestamp = next();
+        for(usize i = 0u; i < eventCount; ++i){
+            // Mostly small forward steps, with occasional backward and full-range jumps to cover every delta width.
+            const u64 pattern = next() % 8u;
+            frameIndex = pattern == 0u ? next() : frameIndex + (pattern == 1u ? static_cast<u64>(0) - (next() % 4u) : next() % 3u);
+            timestamp = pattern == 2u ? next() : timestamp + (next() % 2000000u);
+
+            payload.resize(static_cast<usize>(next() % (s_MaxPayloadBytes + 1u)));
+            for(u8& byte : payload)
+                byte = static_cast<u8>(next());
+
+            Telemetry::EventHeader header;
+            header.kind = s_Kinds[next() % LengthOf(s_Kinds)];
+            header.reserved = (next() % 16u) == 0u ? static_cast<u8>(next()) : 0u;
+            header.streamId = (next() % 16u) == 0u ? static_cast<u32>(next()) : static_cast<u32>(next() % 4u);
+            header.frameIndex = frameIndex;
+            header.timestampNanoseconds = timestamp;
+            header.payloadBytes = payload.size();
+            ASSERT_TRUE(recorder.append(header, payload.data(), payload.size()));
+        }
+
+        ASSERT_TRUE(Telemetry::EncodeEventStream(recorder.view(), encoded));
+
+        Telemetry::Recorder decoded(testArena.arena);
+        const Telemetry::DecodeResult result = Telemetry::DecodeEventStream(testArena.arena, encoded.data(), encoded.size(), decoded);
+        ASSERT_TRUE(result.ok());
+        EXPECT_EQ(result.bytesRead, encoded.size());
+        ASSERT_EQ(decoded.eventCount(), eventCount);
+        for(usize i = 0u; i < eventCount; ++i){
+            const Telemetry::EventRecord* source = recorder.view().eventAt(i);
+            const Telemetry::EventRecord* parsed = decoded.view().eventAt(i);
+            ASSERT_NE(parsed, nullptr);
+            EXPECT_EQ(parsed->header.magic, Telemetry::s_EventMagic);
+            EXPECT_EQ(parsed->header.version, Telemetry::s_TelemetryFormatVersion);
+            EXPECT_EQ(parsed->header.kind, source->header.kind);
+            EXPECT_EQ(parsed->header.reserved, source->header.reserved);
+            EXPECT_EQ(parsed->header.streamId, source->header.streamId);
+            EXPECT_EQ(parsed->header.frameIndex, source->header.frameIndex);
+            EXPECT_EQ(parsed->header.timestampNanoseconds, source->header.timestampNanoseconds);
+            EXPECT_EQ(parsed->header.payloadBytes, source->header.payloadBytes);
+            ASSERT_EQ(parsed->payload.size(), source->payload.size());
+            if(!source->payload.empty())
+                EXPECT_EQ(NWB_MEMCMP(parsed->payload.data(), source->payload.data(), source->payload.size()), 0);
+        }
+
+        // Truncated and bit-flipped streams must be rejected or decoded without reading past the input.
+        const usize truncatedSize = static_cast<usize>(next() % (encoded.size() + 1u));
+        const Telemetry::DecodeResult truncated = Telemetry::DecodeEventStream(testArena.arena, encoded.data(), truncatedSize, decoded);
+        EXPECT_LE(truncated.bytesRead, truncatedSize);
+        if(truncatedSize < encoded.size())
+            EXPECT_FALSE(truncated.ok());
+
+        corrupted = encoded;
+        for(u32 flip = 0u; flip < 4u; ++flip)
+            corrupted[static_cast<usize>(next() % corrupted.size())] ^= static_cast<u8>(1u << (next() % 8u));
+        const Telemetry::DecodeResult flipped = Telemetry::DecodeEventStream(testArena.arena, corrupted.data(), corrupted.size(), decoded);
+        EXPECT_LE(flipped.bytesRead, corrupted.size());
+    }
+}
+
 static ::Path<NWB::Core::Alloc::GlobalArena> TelemetryTestStorageDirectory(NWB::Core::Alloc::GlobalArena& arena){
     ::Path<NWB::Core::Alloc::GlobalArena> executableDirectory(arena);
     if(GetExecutableDirectory(executableDirectory))
@@ -0,0 +1,322 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <tests/common/test_context.h>
+#include <gtest/gtest.h>
+
+#include <impl/ecs_ui/atlas_packer.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_ui_atlas_tests{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+using TestArena = NWB::Tests::TestArena<struct UiAtlasTestsTag>;
+using UiAtlasPacker = NWB::Impl::UiAtlasPacker;
+using UiAtlasAllocation = NWB::Impl::UiAtlasAllocation;
+using UiAtlasPackerStats = NWB::Impl::UiAtlasPackerStats;
+
+template<typename T>
+using TestVector = NWB::Tests::TestVector<T>;
+
+// Synthetic overlay: a HUD of icons and small thumbnails drawn every frame, a scrolling list that brings a few new
+// images into view per frame, and glyph-sized badges. Sizes and order come from a fixed LCG so runs are comparable.
+inline constexpr u32 s_OverlayPageExtent = 512u;
+inline constexpr u32 s_OverlayMaxPageCount = 6u;
+inline constexpr u32 s_OverlayFrameCount = 600u;
+inline constexpr u32 s_OverlayStaticImageCount = 96u;
+inline constexpr u32 s_OverlayScrollWindow = 48u;
+inline constexpr u32 s_OverlayScrollStep = 3u;
+inline constexpr u32 s_OverlayScrollImageCount = 2048u;
+inline constexpr u64 s_OverlayScrollKeyBase = 1u << 20;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+struct PlacedImage{
+    UiAtlasAllocation allocation;
+    u64 key = 0u;
+};
+
+struct OverlayImage{
+    u64 key = 0u;
+    u32 width = 0u;
+    u32 height = 0u;
+};
+
+
+[[nodiscard]] static u32 NextRandom(u32& state){
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+[[nodiscard]] static bool Overlaps(const UiAtlasAllocation& lhs, const UiAtlasAllocation& rhs, const u32 padding){
+    return lhs.page == rhs.page
+        && lhs.x < rhs.x + rhs.width + padding
+        && rhs.x < lhs.x + lhs.width + padding
+        && lhs.y < rhs.y + rhs.height + padding
+        && rhs.y < lhs.y + lhs.height + padding
+    ;
+}
+
+[[nodiscard]] static OverlayImage MakeOverlayImage(const u64 key, const u32 imageSeed){
+    u32 seed = imageSeed * 2654435761u + 0x9E3779B9u;
+    const u32 kind = NextRandom(seed) % 4u;
+    OverlayImage image;
+    image.key = key;
+    if(kind == 0u){
+        // Glyph-sized badge.
+        image.width = 8u + NextRandom(seed) % 9u;
+        image.height = 12u + NextRandom(seed) % 9u;
+    }
+    else if(kind == 3u){
+        // Thumbnail.
+        image.width = 48u + NextRandom(seed) % 33u;
+        image.height = 36u + NextRandom(seed) % 29u;
+    }
+    else{
+        // Icon.
+        image.width = 16u + NextRandom(seed) % 17u;
+        image.height = image.width;
+    }
+    return image;
+}
+
+// Consecutive quads on one page merge into a single draw, so a frame costs one draw per page change in draw order.
+[[nodiscard]] static usize CountBatchedDraws(const TestVector<u32>& drawPages){
+    usize drawCount = 0u;
+    for(usize i = 0u; i < drawPages.size(); ++i){
+        if(i == 0u || drawPages[i] != drawPages[i - 1u])
+            ++drawCount;
+    }
+    return drawCount;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TEST(UiAtlas, PacksImagesWithoutOverlap){
+    using namespace __hidden_ui_atlas_tests;
+
+    TestArena testArena;
+    UiAtlasPacker packer(testArena.arena, 256u, 256u, 8u, 1u);
+
+    TestVector<PlacedImage> placed;
+    u32 seed = 0x1234u;
+    for(u64 key = 0u; key < 400u; ++key){
+        const u32 width = 4u + NextRandom(seed) % 45u;
+        const u32 height = 4u + NextRandom(seed) % 45u;
+
+        UiAtlasAllocation allocation;
+        bool inserted = false;
+        ASSERT_TRUE(packer.acquire(key, width, height, allocation, inserted));
+        EXPECT_TRUE(inserted);
+        EXPECT_EQ(allocation.width, width);
+        EXPECT_EQ(allocation.height, height);
+        EXPECT_LT(allocation.page, packer.pageCount());
+        EXPECT_LE(allocation.x + width + packer.padding(), packer.pageWidth());
+        EXPECT_LE(allocation.y + height + packer.padding(), packer.pageHeight());
+        placed.push_back(PlacedImage{ allocation, key });
+    }
+
+    for(usize i = 0u; i < placed.size(); ++i){
+        for(usize j = i + 1u; j < placed.size(); ++j)
+            EXPECT_FALSE(Overlaps(placed[i].allocation, placed[j].allocation, packer.padding())) << i << " vs " << j;
+
+        const UiAtlasAllocation* const found = packer.find(placed[i].key);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(found->page, placed[i].allocation.page);
+        EXPECT_EQ(found->x, placed[i].allocation.x);
+        EXPECT_EQ(found->y, placed[i].allocation.y);
+    }
+
+    const UiAtlasPackerStats stats = packer.stats();
+    EXPECT_EQ(stats.entryCount, placed.size());
+    EXPECT_EQ(stats.insertCount, placed.size());
+    EXPECT_EQ(stats.evictedPageCount, 0u);
+    EXPECT_LE(stats.usedArea, stats.coveredArea);
+    EXPECT_LE(stats.coveredArea, stats.pageArea);
+}
+
+TEST(UiAtlas, ReacquireReturnsCachedPlacement){
+    using namespace __hidden_ui_atlas_tests;
+
+    TestArena testArena;
+    UiAtlasPacker packer(testArena.arena, 128u, 128u, 1u, 1u);
+
+    UiAtlasAllocation first;
+    bool inserted = false;
+    ASSERT_TRUE(packer.acquire(7u, 20u, 10u, first, inserted));
+    EXPECT_TRUE(inserted);
+
+    UiAtlasAllocation again;
+    ASSERT_TRUE(packer.acquire(7u, 20u, 10u, again, inserted));
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(again.x, first.x);
+    EXPECT_EQ(again.y, first.y);
+
+    // A key whose extent changed is a new image; the old rectangle is left as a hole until its page is recycled.
+    UiAtlasAllocation resized;
+    ASSERT_TRUE(packer.acquire(7u, 30u, 10u, resized, inserted));
+    EXPECT_TRUE(inserted);
+    EXPECT_FALSE(Overlaps(first, resized, packer.padding()));
+
+    const UiAtlasPackerStats stats = packer.stats();
+    EXPECT_EQ(stats.entryCount, 1u);
+    EXPECT_EQ(stats.hitCount, 1u);
+    EXPECT_EQ(stats.insertCount, 2u);
+    EXPECT_EQ(stats.usedArea, 300u);
+    EXPECT_GT(stats.fragmentation(), 0.0);
+}
+
+TEST(UiAtlas, RejectsEmptyAndOversizedImages){
+    using namespace __hidden_ui_atlas_tests;
+
+    TestArena testArena;
+    UiAtlasPacker packer(testArena.arena, 64u, 64u, 2u, 1u);
+
+    UiAtlasAllocation allocation;
+    bool inserted = true;
+    EXPECT_FALSE(packer.acquire(1u, 0u, 8u, allocation, inserted));
+    EXPECT_FALSE(inserted);
+    EXPECT_FALSE(packer.acquire(2u, 64u, 8u, allocation, inserted));
+    EXPECT_FALSE(packer.acquire(3u, 8u, 64u, allocation, inserted));
+    EXPECT_TRUE(packer.acquire(4u, 63u, 63u, allocation, inserted));
+    EXPECT_TRUE(inserted);
+
+    const UiAtlasPackerStats stats = packer.stats();
+    EXPECT_EQ(stats.failedCount, 3u);
+    EXPECT_EQ(stats.entryCount, 1u);
+    EXPECT_EQ(stats.pageCount, 1u);
+}
+
+TEST(UiAtlas, EvictsLeastRecentlyUsedPage){
+    using namespace __hidden_ui_atlas_tests;
+
+    TestArena testArena;
+    UiAtlasPacker packer(testArena.arena, 64u, 64u, 2u, 0u);
+
+    UiAtlasAllocation allocation;
+    bool inserted = false;
+    for(u64 key = 0u; key < 4u; ++key){
+        ASSERT_TRUE(packer.acquire(key, 32u, 32u, allocation, inserted));
+        EXPECT_EQ(allocation.page, 0u);
+    }
+
+    packer.beginFrame();
+    for(u64 key = 4u; key < 8u; ++key){
+        ASSERT_TRUE(packer.acquire(key, 32u, 32u, allocation, inserted));
+        EXPECT_EQ(allocation.page, 1u);
+    }
+
+    // Page 1 is touched again this frame, so the only candidate is page 0, last used two frames ago.
+    packer.beginFrame();
+    ASSERT_TRUE(packer.acquire(5u, 32u, 32u, allocation, inserted));
+    EXPECT_FALSE(inserted);
+    ASSERT_TRUE(packer.acquire(8u, 32u, 32u, allocation, inserted));
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(allocation.page, 0u);
+    EXPECT_EQ(allocation.x, 0u);
+    EXPECT_EQ(allocation.y, 0u);
+    for(u64 key = 0u; key < 4u; ++key)
+        EXPECT_EQ(packer.find(key), nullptr);
+    for(u64 key = 4u; key < 8u; ++key)
+        EXPECT_NE(packer.find(key), nullptr);
+
+    for(u64 key = 9u; key < 12u; ++key){
+        ASSERT_TRUE(packer.acquire(key, 32u, 32u, allocation, inserted));
+        EXPECT_EQ(allocation.page, 0u);
+    }
+
+    // Both pages now hold images drawn this frame; neither may be recycled under them.
+    EXPECT_FALSE(packer.acquire(12u, 32u, 32u, allocation, inserted));
+
+    const UiAtlasPackerStats stats = packer.stats();
+    EXPECT_EQ(stats.evictedPageCount, 1u);
+    EXPECT_EQ(stats.evictedEntryCount, 4u);
+    EXPECT_EQ(stats.failedCount, 1u);
+    EXPECT_EQ(stats.entryCount, 8u);
+    EXPECT_DOUBLE_EQ(stats.fragmentation(), 0.0);
+    EXPECT_DOUBLE_EQ(stats.occupancy(), 1.0);
+
+    // Next frame the older page gives way again.
+    packer.beginFrame();
+    EXPECT_TRUE(packer.acquire(12u, 32u, 32u, allocation, inserted));
+    EXPECT_EQ(packer.stats().evictedPageCount, 2u);
+}
+
+TEST(UiAtlas, SyntheticOverlayBatchesDrawsPerPage){
+    using namespace __hidden_ui_atlas_tests;
+
+    TestArena testArena;
+    UiAtlasPacker packer(testArena.arena, s_OverlayPageExtent, s_OverlayPageExtent, s_OverlayMaxPageCount, 1u);
+
+    TestVector<OverlayImage> frameImages;
+    TestVector<u32> drawPages;
+    usize batchedDrawCount = 0u;
+    usize unbatchedDrawCount = 0u;
+    usize peakBatchedDraws = 0u;
+    f64 peakFragmentation = 0.0;
+    for(u32 frame = 0u; frame < s_OverlayFrameCount; ++frame){
+        packer.beginFrame();
+
+        frameImages.clear();
+        for(u32 i = 0u; i < s_OverlayStaticImageCount; ++i)
+            frameImages.push_back(MakeOverlayImage(i, i));
+        const u32 scrollBegin = (frame * s_OverlayScrollStep) % s_OverlayScrollImageCount;
+        for(u32 i = 0u; i < s_OverlayScrollWindow; ++i){
+            const u32 scrollIndex = (scrollBegin + i) % s_OverlayScrollImageCount;
+            frameImages.push_back(MakeOverlayImage(s_OverlayScrollKeyBase + scrollIndex, scrollIndex * 7919u));
+        }
+
+        drawPages.clear();
+        for(const OverlayImage& image : frameImages){
+            UiAtlasAllocation allocation;
+            bool inserted = false;
+            ASSERT_TRUE(packer.acquire(image.key, image.width, image.height, allocation, inserted)) << frame;
+            drawPages.push_back(allocation.page);
+        }
+
+        const usize frameDraws = CountBatchedDraws(drawPages);
+        batchedDrawCount += frameDraws;
+        unbatchedDrawCount += frameImages.size();
+        peakBatchedDraws = Max(peakBatchedDraws, frameDraws);
+        peakFragmentation = Max(peakFragmentation, packer.stats().fragmentation());
+    }
+
+    const UiAtlasPackerStats stats = packer.stats();
+    const f64 drawsPerFrame = static_cast<f64>(batchedDrawCount) / s_OverlayFrameCount;
+    const f64 unbatchedDrawsPerFrame = static_cast<f64>(unbatchedDrawCount) / s_OverlayFrameCount;
+    EXPECT_LE(drawsPerFrame * 8.0, unbatchedDrawsPerFrame);
+    EXPECT_LT(stats.fragmentation(), 0.35);
+    EXPECT_LT(peakFragmentation, 0.5);
+    EXPECT_EQ(stats.failedCount, 0u);
+    EXPECT_GT(stats.hitCount, stats.insertCount);
+
+    RecordProperty("ui_atlas_draws_per_frame_x100", static_cast<int>(drawsPerFrame * 100.0));
+    RecordProperty("ui_atlas_unbatched_draws_per_frame", static_cast<int>(unbatchedDrawsPerFrame));
+    RecordProperty("ui_atlas_peak_draws_per_frame", static_cast<int>(peakBatchedDraws));
+    RecordProperty("ui_atlas_fragmentation_permille", static_cast<int>(stats.fragmentation() * 1000.0));
+    RecordProperty("ui_atlas_peak_fragmentation_permille", static_cast<int>(peakFragmentation * 1000.0));
+    RecordProperty("ui_atlas_occupancy_permille", static_cast<int>(stats.occupancy() * 1000.0));
+    RecordProperty("ui_atlas_pages", static_cast<int>(stats.pageCount));
+    RecordProperty("ui_atlas_evicted_pages", static_cast<int>(stats.evictedPageCount));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,156 @@
+// limztudio@gmail.com
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "skin.h"
+
+#include <core/common/log.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_FBX_TO_NWB_BEGIN
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+namespace __hidden_animation{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static constexpr f64 s_DefaultFramesPerSecond = 30.0;
+// Animation clip keys store their frame as u16.
+static constexpr usize s_MaxAnimationFrameCount = static_cast<usize>(Limit<u16>::s_Max) + 1u;
+static constexpr f64 s_FrameRoundingBias = 0.5;
+static constexpr usize s_UfbxErrorBufferSize = 4096u;
+
+ufbx_matrix MakeUniformScaleMatrix(const f64 scale){
+    ufbx_matrix matrix = {};
+    matrix.m00 = scale;
+    matrix.m11 = scale;
+    matrix.m22 = scale;
+    return matrix;
+}
+
+struct EvaluatedSceneHandle{
+    ufbx_scene* scene = nullptr;
+
+    EvaluatedSceneHandle() = default;
+    ~EvaluatedSceneHandle(){
+        if(scene)
+            ufbx_free_scene(scene);
+    }
+    EvaluatedSceneHandle(const EvaluatedSceneHandle&) = delete;
+    EvaluatedSceneHandle& operator=(const EvaluatedSceneHandle&) = delete;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+bool SampleSkeletonAnimation(
+    ufbx_scene* scene,
+    const ImportOptions& options,
+    const UtilityVector<ufbx_node*>& joints,
+    SampledSkeletonAnimation& outAnimation
+){
+    outAnimation = {};
+
+    if(!scene || joints.empty()){
+        NWB_LOGGER_ERROR(NWB_TEXT("Failed to sample FBX animation: skeleton joints are required"));
+        return false;
+    }
+    // Bind poses without baked transforms are relative to each mesh node, which a skeleton-wide clip cannot follow.
+    if(!options.bakeTransforms){
+        NWB_LOGGER_ERROR(NWB_TEXT("Failed to sample FBX animation: animation export requires baked node transforms (remove --local)"));
+        return false;
+    }
+    if(scene->anim_stacks.count == 0u || !scene->anim_stacks.data[0]){
+        NWB_LOGGER_ERROR(NWB_TEXT("Failed to sample FBX animation: scene contains no animation stacks"));
+        return false;
+    }
+
+    const ufbx_anim_stack& stack = *scene->anim_stacks.data[0];
+    if(scene->anim_stacks.count > 1u){
+        NWB_LOGGER_WARNING(NWB_TEXT("FBX scene contains {} animation stacks; exporting the first one ('{}')")
+            , scene->anim_stacks.count
+            , StringConvert(AStringView(stack.name.data ? stack.name.data : "", stack.name.length))
+        );
+    }
+
+    f64 frameRate = static_cast<f64>(scene->settings.frames_per_second);
+    if(!IsFinite(frameRate) || frameRate <= 0.0)
+        frameRate = __hidden_animation::s_DefaultFramesPerSecond;
+
+    const f64 duration = static_cast<f64>(stack.time_end) - static_cast<f64>(stack.time_begin);
+    if(!IsFinite(duration) || duration < 0.0){
+        NWB_LOGGER_ERROR(NWB_TEXT("Failed to sample FBX animation: animation stack has an invalid time range"));
+        return false;
+    }
+
+    const f64 frameSpan = Floor(duration * frameRate + __hidden_animation::s_FrameRoundingBias);
+    if(frameSpan + 1.0 > static_cast<f64>(__hidden_animation::s_MaxAnimationFrameCount)){
+        NWB_LOGGER_ERROR(NWB_TEXT("Failed to sample FBX animation: animation has more than {} frames")
+            , __hidden_animation::s_MaxAnimationFrameCount
+        );
+        return false;
+    }
+
+    outAnimation.name.assign(stack.name.data ? stack.name.data : "", stack.name.length);
+    outAnimation.frameRate = frameRate;
+    outAnimation.frameCount = static_cast<usize>(frameSpan) + 1u;
+    outAnimation.globalMatrices.resize(outAnimation.frameCount * joints.size(), JointMatrix{});
+
+    const ufbx_matrix outputScale = __hidden_animation::MakeUniformScaleMatrix(options.scale);
+    for(usize frame = 0u; frame < outAnimation.frameCount; ++frame){
+        const f64 time = static_cast<f64>(stack.time_begin) + static_cast<f64>(frame) / frameRate;
+
+        ufbx_error error = {};
+        __hidden_animation::EvaluatedSceneHandle evaluated;
+        evaluated.scene = ufbx_evaluate_scene(scene, stack.anim, time, nullptr, &error);
+        if(!evaluated.scene){
+            char buffer[__hidden_animation::s_UfbxErrorBufferSize] = {};
+            ufbx_format_error(buffer, sizeof(buffer), &error);
+            NWB_LOGGER_ERROR(NWB_TEXT("Failed to sample FBX animation at frame {}: {}"), frame, StringConvert(buffer));
+            return false;
+        }
+
+        for(usize jointIndex = 0u; jointIndex < joints.size(); ++jointIndex){
+            const ufbx_node* sourceJoint = joints[jointIndex];
+            if(!sourceJoint || sourceJoint->typed_id >= evaluated.scene->nodes.count){
+                NWB_LOGGER_ERROR(NWB_TEXT("Failed to sample FBX animation: skeleton joint {} is missing from the evaluated scene"), jointIndex);
+                return false;
+            }
+
+            const ufbx_node& joint = *evaluated.scene->nodes.data[sourceJoint->typed_id];
+            const ufbx_matrix global = ufbx_matrix_mul(&outputScale, &joint.node_to_world);
+            if(!FbxSkinDetail::FiniteUfbxMatrix(global)){
+                NWB_LOGGER_ERROR(NWB_TEXT("Failed to sample FBX animation: joint {} has a non-finite transform at frame {}"), jointIndex, frame);
+                return false;
+            }
+            outAnimation.globalMatrices[frame * joints.size() + jointIndex] = FbxSkinDetail::ToJointMatrix(global);
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+NWB_FBX_TO_NWB_END
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
@@ -929,6 +929,163 @@ bool WriteAssetBunch(
     return true;
 }
 
+struct AnimationJointChannels{
+    UtilityVector<Vec4> rotations;
+    UtilityVector<Vec3> translations;
+    UtilityVector<Vec3> scales;
+};
+
+template<typename T>
+bool ChannelIsConstant(const UtilityVector<T>& samples){
+    for(const T& sample : samples){
+        for(usize i = 0u; i < sizeof(sample.raw) / sizeof(sample.raw[0]); ++i){
+            if(FloatHashBits(sample.raw[i]) != FloatHashBits(samples.front().raw[i]))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Converts sampled global joint matrices to per-joint local rotation, translation, and scale channels, using the same
+// parent-relative decomposition the skeleton writer applies to bind poses.
+bool BuildAnimationJointChannels(
+    const UtilityVector<ufbx_node*>& joints,
+    const UtilityVector<AString>& jointNames,
+    const SampledSkeletonAnimation& animation,
+    UtilityVector<AnimationJointChannels>& outChannels
+){
+    outChannels.clear();
+    outChannels.resize(joints.size());
+
+    HashMap<const ufbx_node*, usize> jointLookup;
+    jointLookup.reserve(joints.size());
+    for(usize jointIndex = 0u; jointIndex < joints.size(); ++jointIndex)
+        jointLookup.emplace(joints[jointIndex], jointIndex);
+
+    UtilityVector<usize> parentIndices;
+    parentIndices.resize(joints.size(), Limit<usize>::s_Max);
+    for(usize jointIndex = 0u; jointIndex < joints.size(); ++jointIndex){
+        const ufbx_node* parent = joints[jointIndex] ? joints[jointIndex]->parent : nullptr;
+        const auto foundParent = parent ? jointLookup.find(parent) : jointLookup.end();
+        if(foundParent != jointLookup.end())
+            parentIndices[jointIndex] = foundParent.value();
+    }
+
+    for(AnimationJointChannels& channels : outChannels){
+        channels.rotations.reserve(animation.frameCount);
+        channels.translations.reserve(animation.frameCount);
+        channels.scales.reserve(animation.frameCount);
+    }
+
+    for(usize frame = 0u; frame < animation.frameCount; ++frame){
+        const JointMatrix* frameMatrices = animation.globalMatrices.data() + frame * joints.size();
+        for(usize jointIndex = 0u; jointIndex < joints.size(); ++jointIndex){
+            const SIMDMatrix globalMatrix = LoadFloat(frameMatrices[jointIndex]);
+            SIMDMatrix parentGlobalMatrix{};
+            const SIMDMatrix* parentGlobalMatrixPtr = nullptr;
+            if(parentIndices[jointIndex] != Limit<usize>::s_Max){
+                parentGlobalMatrix = LoadFloat(frameMatrices[parentIndices[jointIndex]]);
+                parentGlobalMatrixPtr = &parentGlobalMatrix;
+            }
+
+            SIMDMatrix localMatrix;
+            SIMDVector scale;
+            SIMDVector rotation;
+            SIMDVector translation;
+            if(
+                !BuildLocalBindPoseMatrix(globalMatrix, parentGlobalMatrixPtr, localMatrix)
+                || !MatrixDecompose(&scale, &rotation, &translation, localMatrix)
+            ){
+                NWB_LOGGER_ERROR(NWB_TEXT("Failed to write NWB animation clip: joint '{}' has a singular transform at frame {}")
+                    , StringConvert(jointNames[jointIndex])
+                    , frame
+                );
+                return false;
+            }
+
+            AnimationJointChannels& channels = outChannels[jointIndex];
+            Vec4 rotationValue{};
+            Vec3 translationValue{};
+            Vec3 scaleValue{};
+            StoreFloat(rotation, &rotationValue);
+            StoreFloat(translation, &translationValue);
+            StoreFloat(scale, &scaleValue);
+            channels.rotations.push_back(rotationValue);
+            channels.translations.push_back(translationValue);
+            channels.scales.push_back(scaleValue);
+        }
+    }
+
+    // A channel that never changes is written as one sample; the cooker treats it as constant.
+    for(AnimationJointChannels& channels : outChannels){
+        if(ChannelIsConstant(channels.rotations))
+            channels.rotations.resize(1u);
+        if(ChannelIsConstant(channels.translations))
+            channels.translations.resize(1u);
+        if(ChannelIsConstant(channels.scales))
+            channels.scales.resize(1u);
+    }
+    return true;
+}
+
+template<typename Stream, typename T, typename WriteFn>
+void WriteAnimationChannel(Stream& file, const AStringView fieldName, const UtilityVector<T>& samples, WriteFn&& writeSample){
+    file << "        \"" << fieldName << "\": [\n";
+    for(const T& sample : samples){
+        file << "            ";
+        writeSample(file, sample);
+        file << ",\n";
+    }
+    file << "        ],\n";
+}
+
+bool WriteAnimationClipAsset(
+    const Path& outputPath,
+    const AStringView skeletonName,
+    const UtilityVector<ufbx_node*>& joints,
+    const SampledSkeletonAnimation& animation
+){
+    const UtilityVector<AString> jointNames = BuildUniqueJointNames(joints);
+    UtilityVector<AnimationJointChannels> channels;
+    if(!BuildAnimationJointChannels(joints, jointNames, animation, channels))
+        return false;
+    if(!EnsureOutputDirectory(outputPath, "animation clip"))
+        return false;
+
+    BasicOutputFileStream<char> rawFile(outputPath, s_FileOpenBinary | s_FileOpenTruncate);
+    if(!rawFile){
+        NWB_LOGGER_ERROR(NWB_TEXT("Failed to write NWB animation clip: failed to open output file '{}'"), PathToString<tchar>(outputPath));
+        return false;
+    }
+    NwbTextOutputStream file(rawFile);
+    file.precision(s_OutputFloatPrecision);
+
+    file << "animation_clip asset;\n\n";
+    file << "asset.skeleton = ";
+    WriteReferenceValue(file, skeletonName, true);
+    file << ";\n";
+    file << "asset.frame_rate = ";
+    WriteFloat(file, static_cast<f32>(animation.frameRate));
+    file << ";\n";
+    file << "asset.tracks = [\n";
+    for(usize jointIndex = 0u; jointIndex < joints.size(); ++jointIndex){
+        const AString& jointName = jointNames[jointIndex];
+        file << "    {\n";
+        file << "        \"joint\": \"" << MakeJsonEscapedText<AString>(AStringView(jointName.data(), jointName.size())) << "\",\n";
+        WriteAnimationChannel(file, "rotations", channels[jointIndex].rotations, [](auto& out, const Vec4& value){ WriteVec4(out, value); });
+        WriteAnimationChannel(file, "translations", channels[jointIndex].translations, [](auto& out, const Vec3& value){ WriteVec3(out, value); });
+        WriteAnimationChannel(file, "scales", channels[jointIndex].scales, [](auto& out, const Vec3& value){ WriteVec3(out, value); });
+        file << "    },\n";
+    }
+    file << "];\n";
+
+    if(!file){
+        NWB_LOGGER_ERROR(NWB_TEXT("Failed to write NWB animation clip: failed while writing output file '{}'"), PathToString<tchar>(outputPath));
+        return false;
+    }
+    return true;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -955,6 +1112,10 @@ bool WriteNwbAsset(
         return false;
     }
 
+    if(assetType == OutputAssetType::Animation){
+        NWB_LOGGER_ERROR(NWB_TEXT("Failed to write NWB asset: animation clips are written by WriteNwbAnimationClip"));
+        return false;
+    }
     if(separateAssets && assetType != OutputAssetType::Bunch){
         NWB_LOGGER_ERROR(NWB_TEXT("Failed to write NWB asset: --separate-assets is only valid with asset type 'bunch'"));
         return false;
@@ -1052,6 +1213,37 @@ bool WriteNwbAsset(
     ;
 }
 
+bool WriteNwbAnimationClip(
+    const Path& outputPath,
+    ufbx_scene* scene,
+    const ImportOptions& options,
+    const SourceMeshStreams& mesh,
+    const UtilityVector<ufbx_node*>& skeletonJoints,
+    const UtilityVector<JointMatrix>& skeletonBindPoseMatrices,
+    const UtilityVector<JointMatrix>& inverseBindMatrices
+){
+    if(!__hidden_asset_writer::ValidateSplitSkinSource(mesh, skeletonJoints, skeletonBindPoseMatrices, inverseBindMatrices))
+        return false;
+
+    // Sort joints exactly like the skeleton writer so track names resolve against the exported skeleton.
+    __hidden_asset_writer::SkeletonOutputData skeletonOutput;
+    if(!__hidden_asset_writer::BuildSkeletonOutputData(
+        skeletonJoints,
+        skeletonBindPoseMatrices,
+        inverseBindMatrices,
+        skeletonOutput
+    ))
+        return false;
+
+    SampledSkeletonAnimation animation;
+    if(!SampleSkeletonAnimation(scene, options, skeletonOutput.joints, animation))
+        return false;
+
+    // Clips live in the package directory written by --separate-assets and reference the skeleton beside them.
+    const AString skeletonName = __hidden_asset_writer::BuildVirtualBasePath(outputPath.parent_path(), options.virtualRoot) + "/skeleton";
+    return __hidden_asset_writer::WriteAnimationClipAsset(outputPath, skeletonName, skeletonOutput.joints, animation);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -256,7 +256,10 @@ bool SelectedMeshesUseSkinning(
 }
 
 bool AssetTypeRequiresSkinning(const OutputAssetType::Enum assetType){
-    return assetType == OutputAssetType::Skeleton || assetType == OutputAssetType::Skin;
+    return assetType == OutputAssetType::Skeleton
+        || assetType == OutputAssetType::Skin
+        || assetType == OutputAssetType::Animation
+    ;
 }
 
 bool AssetTypeCanUseSkinning(const OutputAssetType::Enum assetType){
@@ -386,6 +389,7 @@ int Run(int argc, char** argv, Core::Alloc::ThreadPool& threadPool, bool& prompt
     app.add_flag("--force", options.forceOverwrite, "Overwrite an existing output file");
     app.add_flag("-y,--yes", options.acceptDefaults, "Use defaults for any import options that were not supplied");
     app.add_flag("--list-meshes", options.listMeshes, "List importable mesh instances and exit");
+    app.add_flag("--single-thread", options.singleThread, "Build and canonicalize meshes on the calling thread only");
 
     try{
         app.parse(argc, argv);
@@ -442,8 +446,13 @@ int Run(int argc, char** argv, Core::Alloc::ThreadPool& threadPool, bool& prompt
         return 1;
     }
 
+    Optional<Core::Alloc::ThreadPool> serialThreadPool;
+    if(options.singleThread)
+        serialThreadPool.emplace(0u);
+    Core::Alloc::ThreadPool& meshThreadPool = serialThreadPool ? *serialThreadPool : threadPool;
+
     if(__hidden_command_line::IsNwbRefreshMode(options))
-        return __hidden_command_line::RunNwbRefresh(options, presence, threadPool, prompted);
+        return __hidden_command_line::RunNwbRefresh(options, presence, meshThreadPool, prompted);
 
     SceneHandle scene;
     if(!LoadScene(options, scene))
@@ -521,7 +530,7 @@ int Run(int argc, char** argv, Core::Alloc::ThreadPool& threadPool, bool& prompt
         options,
         wantsSkinning,
         defaultColor,
-        threadPool,
+        meshThreadPool,
         mesh,
         skeletonJoints,
         skeletonBindPoseMatrices,
@@ -532,7 +541,19 @@ int Run(int argc, char** argv, Core::Alloc::ThreadPool& threadPool, bool& prompt
     ))
         return 1;
 
-    if(!WriteNwbAsset(
+    if(assetTypeValue == OutputAssetType::Animation){
+        if(!WriteNwbAnimationClip(
+            outputPath,
+            scene.scene,
+            options,
+            mesh,
+            skeletonJoints,
+            skeletonBindPoseMatrices,
+            inverseBindMatrices
+        ))
+            return 1;
+    }
+    else if(!WriteNwbAsset(
         outputPath,
         mesh,
         options.assetType,
@@ -30,6 +30,8 @@ static AStringView OutputAssetTypeText(const OutputAssetType::Enum assetType){
         return "skeleton";
     case OutputAssetType::Skin:
         return "skin";
+    case OutputAssetType::Animation:
+        return "animation";
     default:
         return {};
     }
@@ -44,8 +46,10 @@ AString OutputAssetTypeOptionsText(){
     text += OutputAssetTypeText(OutputAssetType::Model);
     text += ", ";
     text += OutputAssetTypeText(OutputAssetType::Skeleton);
-    text += ", or ";
+    text += ", ";
     text += OutputAssetTypeText(OutputAssetType::Skin);
+    text += ", or ";
+    text += OutputAssetTypeText(OutputAssetType::Animation);
     return text;
 }
 
@@ -76,6 +80,10 @@ static bool ParseNormalizedAssetTypeText(const AStringView value, OutputAssetTyp
         outAssetType = OutputAssetType::Skin;
         return true;
     }
+    if(value == OutputAssetTypeText(OutputAssetType::Animation)){
+        outAssetType = OutputAssetType::Animation;
+        return true;
+    }
 
     outAssetType = OutputAssetType::Bunch;
     return false;
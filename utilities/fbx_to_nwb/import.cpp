@@ -74,31 +74,50 @@ bool BuildMesh(
         return false;
     }
 
-    bool usedDefaultUvs = false;
-    __hidden_import::ReserveSourceMeshStreams(outMesh, estimatedTriangleCorners, wantsSkinning);
-    __hidden_import::SourceMeshBuildContext meshContext{ outMesh };
-    __hidden_import::ReserveSourceMeshBuildContext(meshContext, estimatedTriangleCorners, wantsSkinning);
+    UtilityVector<__hidden_import::SourceMeshFragment> fragments;
+    fragments.resize(selection.size());
 
-    UtilityVector<u32> triangleIndices;
     FbxSkinDetail::ExportContext skinContext;
-    for(const usize instanceIndex : selection){
-        NWB_ASSERT(instanceIndex < instances.size());
-        if(
-            !__hidden_import::AppendInstanceMesh(
-                instances[instanceIndex],
-                options,
-                wantsSkinning,
-                normalMode,
-                defaultColor,
-                triangleIndices,
-                meshContext,
-                skinContext,
-                outSawVertexColors,
-                outSawVertexUvs,
-                usedDefaultUvs
-            )
-        ){
+    if(wantsSkinning){
+        for(usize fragmentIndex = 0u; fragmentIndex < selection.size(); ++fragmentIndex){
+            if(!__hidden_import::PrepareInstanceSkin(instances[selection[fragmentIndex]], options, skinContext, fragments[fragmentIndex]))
+                return false;
+        }
+    }
+
+    threadPool.parallelFor(static_cast<usize>(0), fragments.size(), [&](const usize fragmentIndex){
+        __hidden_import::SourceMeshFragment& fragment = fragments[fragmentIndex];
+        fragment.built = __hidden_import::BuildInstanceMeshFragment(
+            instances[selection[fragmentIndex]],
+            options,
+            wantsSkinning,
+            normalMode,
+            defaultColor,
+            fragment
+        );
+    });
+
+    bool usedDefaultUvs = false;
+    for(const __hidden_import::SourceMeshFragment& fragment : fragments){
+        if(!fragment.built)
             return false;
+        outSawVertexColors = outSawVertexColors || fragment.sawVertexColors;
+        outSawVertexUvs = outSawVertexUvs || fragment.sawVertexUvs;
+        usedDefaultUvs = usedDefaultUvs || fragment.usedDefaultUvs;
+    }
+
+    if(!fragments.empty()){
+        outMesh = Move(fragments[0u].mesh);
+        if(fragments.size() > 1u){
+            __hidden_import::ReserveSourceMeshStreams(outMesh, estimatedTriangleCorners, wantsSkinning);
+            __hidden_import::SourceMeshBuildContext meshContext{ outMesh };
+            __hidden_import::ReserveSourceMeshBuildContext(meshContext, estimatedTriangleCorners, wantsSkinning);
+            __hidden_import::SeedSourceMeshBuildContext(meshContext);
+            for(usize fragmentIndex = 1u; fragmentIndex < fragments.size(); ++fragmentIndex){
+                if(!__hidden_import::AppendSourceMeshFragment(meshContext, fragments[fragmentIndex]))
+                    return false;
+                fragments[fragmentIndex].mesh = SourceMeshStreams{};
+            }
         }
     }
 
@@ -100,18 +100,44 @@ template<typename VisitTriangle>
     return true;
 }
 
-bool AppendInstanceMesh(
+// One selected instance built on its own: streams interned in first-seen corner order, indices into its own vertex
+// refs. Fragments are built concurrently and appended in selection order, which reproduces the streams a single
+// sequential pass over every corner would intern.
+struct SourceMeshFragment{
+    SourceMeshStreams mesh;
+    ufbx_skin_deformer* skin = nullptr;
+    UtilityVector<u16> clusterJoints;
+    bool built = false;
+    bool sawVertexColors = false;
+    bool sawVertexUvs = false;
+    bool usedDefaultUvs = false;
+};
+
+// Joint order follows the order clusters are first seen, so cluster maps are resolved on the calling thread in
+// selection order before fragments are built.
+bool PrepareInstanceSkin(
+    const MeshInstance& instance,
+    const ImportOptions& options,
+    FbxSkinDetail::ExportContext& inOutSkinContext,
+    SourceMeshFragment& inOutFragment
+){
+    ufbx_mesh* mesh = instance.mesh;
+    NWB_ASSERT(mesh != nullptr);
+    if(mesh->skin_deformers.count != 1u){
+        NWB_LOGGER_ERROR(NWB_TEXT("Failed to build mesh: skinned mesh requires exactly one skin deformer per selected mesh"));
+        return false;
+    }
+    inOutFragment.skin = mesh->skin_deformers.data[0u];
+    return FbxSkinDetail::BuildClusterJointMap(instance, options, inOutFragment.skin, inOutSkinContext, inOutFragment.clusterJoints);
+}
+
+bool BuildInstanceMeshFragment(
     const MeshInstance& instance,
     const ImportOptions& options,
     const bool wantsSkinning,
     const NormalMode::Enum normalMode,
     const Vec4& defaultColor,
-    UtilityVector<u32>& inOutTriangleIndices,
-    SourceMeshBuildContext& inOutMesh,
-    FbxSkinDetail::ExportContext& inOutSkinContext,
-    bool& inOutSawVertexColors,
-    bool& inOutSawVertexUvs,
-    bool& inOutUsedDefaultUvs
+    SourceMeshFragment& inOutFragment
 ){
     ufbx_mesh* mesh = instance.mesh;
     ufbx_node* node = instance.node;
@@ -131,23 +157,20 @@ bool AppendInstanceMesh(
     const bool importColors = options.importColors && mesh->vertex_color.exists;
     const bool importTangents = normalMode == NormalMode::Imported && mesh->vertex_tangent.exists;
     const SIMDVector defaultColorVector = LoadFloat(defaultColor);
-    ufbx_skin_deformer* skin = nullptr;
-    UtilityVector<u16> clusterJoints;
-    if(wantsSkinning){
-        if(mesh->skin_deformers.count != 1u){
-            NWB_LOGGER_ERROR(NWB_TEXT("Failed to build mesh: skinned mesh requires exactly one skin deformer per selected mesh"));
-            return false;
-        }
-        skin = mesh->skin_deformers.data[0u];
-        if(!FbxSkinDetail::BuildClusterJointMap(instance, options, skin, inOutSkinContext, clusterJoints))
-            return false;
-    }
+    ufbx_skin_deformer* const skin = inOutFragment.skin;
+    const UtilityVector<u16>& clusterJoints = inOutFragment.clusterJoints;
+
+    const usize estimatedTriangleCorners = static_cast<usize>(mesh->num_triangles) * s_TriangleIndexCount;
+    ReserveSourceMeshStreams(inOutFragment.mesh, estimatedTriangleCorners, wantsSkinning);
+    SourceMeshBuildContext meshContext{ inOutFragment.mesh };
+    ReserveSourceMeshBuildContext(meshContext, estimatedTriangleCorners, wantsSkinning);
+    UtilityVector<u32> triangleIndices;
 
     PositionNormalMap smoothNormals;
-    if(normalMode == NormalMode::Smooth && !BuildSmoothPositionNormals(*mesh, *node, options, wantsSkinning, inOutTriangleIndices, smoothNormals))
+    if(normalMode == NormalMode::Smooth && !BuildSmoothPositionNormals(*mesh, *node, options, wantsSkinning, triangleIndices, smoothNormals))
         return false;
 
-    return VisitTriangulatedMeshTriangles(*mesh, options.flipWinding, inOutTriangleIndices, [&](const u32 (&cornerIndices)[s_TriangleIndexCount]){
+    return VisitTriangulatedMeshTriangles(*mesh, options.flipWinding, triangleIndices, [&](const u32 (&cornerIndices)[s_TriangleIndexCount]){
         SourceTriangleCorner triangleCorners[s_TriangleIndexCount] = {};
         for(usize triangleCornerIndex = 0u; triangleCornerIndex < s_TriangleIndexCount; ++triangleCornerIndex){
             const u32 cornerIndex = cornerIndices[triangleCornerIndex];
@@ -183,10 +206,10 @@ bool AppendInstanceMesh(
                     0.0f,
                     0.0f
                 );
-                inOutSawVertexUvs = true;
+                inOutFragment.sawVertexUvs = true;
             }
             else{
-                inOutUsedDefaultUvs = true;
+                inOutFragment.usedDefaultUvs = true;
             }
             StoreFloat(uv0, &corner.uv0);
 
@@ -199,7 +222,7 @@ bool AppendInstanceMesh(
                     static_cast<f32>(sourceColor.z),
                     static_cast<f32>(sourceColor.w)
                 );
-                inOutSawVertexColors = true;
+                inOutFragment.sawVertexColors = true;
             }
             StoreFloat(color, &corner.color);
 
@@ -273,14 +296,62 @@ bool AppendInstanceMesh(
 
         for(const SourceTriangleCorner& corner : triangleCorners){
             u32 vertexRefIndex = 0u;
-            if(!InternSourceCorner(inOutMesh, corner, wantsSkinning, vertexRefIndex))
+            if(!InternSourceCorner(meshContext, corner, wantsSkinning, vertexRefIndex))
                 return false;
-            inOutMesh.mesh.indices.push_back(vertexRefIndex);
+            meshContext.mesh.indices.push_back(vertexRefIndex);
         }
         return true;
     });
 }
 
+// Interns a built fragment into the combined mesh. Fragment streams hold each value once in first-seen order, so
+// interning them in order and remapping the fragment's vertex refs matches interning its corners one by one.
+bool AppendSourceMeshFragment(SourceMeshBuildContext& inOutMesh, const SourceMeshFragment& fragment){
+    const SourceMeshStreams& source = fragment.mesh;
+
+    UtilityVector<u32> positionRemap;
+    UtilityVector<u32> normalRemap;
+    UtilityVector<u32> tangentRemap;
+    UtilityVector<u32> uv0Remap;
+    UtilityVector<u32> colorRemap;
+    UtilityVector<u32> skinRemap;
+    if(!InternSourceStream(inOutMesh.mesh.positions, inOutMesh.positions, source.positions, "position", positionRemap))
+        return false;
+    if(!InternSourceStream(inOutMesh.mesh.normals, inOutMesh.normals, source.normals, "normal", normalRemap))
+        return false;
+    if(!InternSourceStream(inOutMesh.mesh.tangents, inOutMesh.tangents, source.tangents, "tangent", tangentRemap))
+        return false;
+    if(!InternSourceStream(inOutMesh.mesh.uv0, inOutMesh.uv0, source.uv0, "uv0", uv0Remap))
+        return false;
+    if(!InternSourceStream(inOutMesh.mesh.colors, inOutMesh.colors, source.colors, "color", colorRemap))
+        return false;
+    if(!InternSourceStream(inOutMesh.mesh.skin, inOutMesh.skin, source.skin, "skin", skinRemap))
+        return false;
+
+    UtilityVector<u32> vertexRefRemap;
+    vertexRefRemap.reserve(source.vertexRefs.size());
+    for(const SourceVertexRef& sourceRef : source.vertexRefs){
+        SourceVertexRef ref;
+        ref.position = RemapSourceStreamIndex(sourceRef.position, positionRemap);
+        ref.normal = RemapSourceStreamIndex(sourceRef.normal, normalRemap);
+        ref.tangent = RemapSourceStreamIndex(sourceRef.tangent, tangentRemap);
+        ref.uv0 = RemapSourceStreamIndex(sourceRef.uv0, uv0Remap);
+        ref.color = RemapSourceStreamIndex(sourceRef.color, colorRemap);
+        ref.skin = RemapSourceStreamIndex(sourceRef.skin, skinRemap);
+
+        u32 vertexRefIndex = 0u;
+        if(!InternSourceValue(inOutMesh.mesh.vertexRefs, inOutMesh.vertexRefs, ref, "vertex_ref", vertexRefIndex))
+            return false;
+        vertexRefRemap.push_back(vertexRefIndex);
+    }
+
+    for(const u32 index : source.indices){
+        NWB_ASSERT(index < vertexRefRemap.size());
+        inOutMesh.mesh.indices.push_back(vertexRefRemap[index]);
+    }
+    return true;
+}
+
 bool EstimateSelectedTriangleCorners(
     const UtilityVector<MeshInstance>& instances,
     const UtilityVector<usize>& selection,
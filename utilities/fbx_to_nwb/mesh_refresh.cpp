@@ -32,6 +32,14 @@ using TextWrite::s_OutputFloatPrecision;
 
 static constexpr AStringView s_MeshMetaKind = "Mesh";
 static constexpr usize s_DeduplicateParallelGrainSize = 4096u;
+// Streams at least this long are welded with a parallel LSD radix sort when the pool has workers. Smaller streams and
+// the single-threaded path keep the comparison sort; both produce the same (value, sourceIndex) order.
+static constexpr usize s_RadixWeldMinCount = 4096u;
+static constexpr usize s_RadixChunkMinCount = 4096u;
+static constexpr usize s_RadixChunkOversubscription = 4u;
+static constexpr u32 s_RadixDigitBits = 8u;
+static constexpr usize s_RadixBucketCount = static_cast<usize>(1u) << s_RadixDigitBits;
+static constexpr u32 s_RadixDigitMask = static_cast<u32>(s_RadixBucketCount - 1u);
 
 struct TextReplacement{
     usize begin = 0u;
@@ -114,6 +122,117 @@ struct StreamSortEntry{
     return equal(lhs, rhs);
 }
 
+// Radix keys are the LessValue comparison flattened into u32 words, most significant first, so ordering the words
+// lexicographically orders the values exactly like LessValue.
+template<typename Value>
+inline constexpr usize s_SortKeyWordCount = 0u;
+template<>
+inline constexpr usize s_SortKeyWordCount<Vec2> = 2u;
+template<>
+inline constexpr usize s_SortKeyWordCount<Vec3> = 3u;
+template<>
+inline constexpr usize s_SortKeyWordCount<Vec4> = 4u;
+template<>
+inline constexpr usize s_SortKeyWordCount<MeshSkinInfluence> = s_MeshSkinInfluenceCount / 2u + s_MeshSkinInfluenceCount;
+
+void WriteSortKey(const Vec2& value, u32* outWords){
+    outWords[0] = FloatSortKey(value.x);
+    outWords[1] = FloatSortKey(value.y);
+}
+
+void WriteSortKey(const Vec3& value, u32* outWords){
+    outWords[0] = FloatSortKey(value.x);
+    outWords[1] = FloatSortKey(value.y);
+    outWords[2] = FloatSortKey(value.z);
+}
+
+void WriteSortKey(const Vec4& value, u32* outWords){
+    outWords[0] = FloatSortKey(value.x);
+    outWords[1] = FloatSortKey(value.y);
+    outWords[2] = FloatSortKey(value.z);
+    outWords[3] = FloatSortKey(value.w);
+}
+
+void WriteSortKey(const MeshSkinInfluence& value, u32* outWords){
+    static_assert((s_MeshSkinInfluenceCount % 2u) == 0u);
+    for(usize i = 0u; i < s_MeshSkinInfluenceCount; i += 2u)
+        *outWords++ = (static_cast<u32>(value.joint[i]) << 16u) | static_cast<u32>(value.joint[i + 1u]);
+    for(usize i = 0u; i < s_MeshSkinInfluenceCount; ++i)
+        *outWords++ = FloatSortKey(value.weight.raw[i]);
+}
+
+// Stable LSD radix sort of stream indices by sort key. Every pass histograms fixed chunks of the current order in
+// parallel, then scatters each chunk behind the earlier chunks of the same digit, so equal keys keep source order and
+// the result matches the comparison sort's sourceIndex tie-break. Passes whose digit is the same for every entry
+// (exponent bytes of tightly grouped values, unused joint slots) are skipped.
+template<typename Value>
+void RadixSortStreamOrder(const UtilityVector<Value>& stream, Core::Alloc::ThreadPool& threadPool, UtilityVector<u32>& outOrder){
+    constexpr usize wordCount = s_SortKeyWordCount<Value>;
+    static_assert(wordCount > 0u);
+
+    const usize count = stream.size();
+    NWB_ASSERT(count <= static_cast<usize>(Limit<u32>::s_Max));
+
+    UtilityVector<u32> keys;
+    keys.resize(count * wordCount);
+    outOrder.resize(count);
+    threadPool.parallelFor(static_cast<usize>(0), count, s_DeduplicateParallelGrainSize, [&](const usize index){
+        WriteSortKey(stream[index], keys.data() + index * wordCount);
+        outOrder[index] = static_cast<u32>(index);
+    });
+
+    const usize maxChunkCount = (static_cast<usize>(threadPool.workerThreadCount()) + 1u) * s_RadixChunkOversubscription;
+    const usize chunkCount = Min(DivideUp(count, s_RadixChunkMinCount), maxChunkCount);
+    const usize chunkSize = DivideUp(count, chunkCount);
+
+    UtilityVector<u32> scratchOrder;
+    scratchOrder.resize(count);
+    UtilityVector<u32> chunkOffsets;
+    chunkOffsets.resize(chunkCount * s_RadixBucketCount);
+
+    for(usize word = wordCount; word-- > 0u;){
+        for(u32 shift = 0u; shift < 32u; shift += s_RadixDigitBits){
+            const auto digitAt = [&](const usize orderIndex){
+                return (keys[static_cast<usize>(outOrder[orderIndex]) * wordCount + word] >> shift) & s_RadixDigitMask;
+            };
+
+            threadPool.parallelFor(static_cast<usize>(0), chunkCount, [&](const usize chunk){
+                u32* const counts = chunkOffsets.data() + chunk * s_RadixBucketCount;
+                NWB_MEMSET(counts, 0, s_RadixBucketCount * sizeof(u32));
+
+                const usize end = Min(count, (chunk + 1u) * chunkSize);
+                for(usize orderIndex = chunk * chunkSize; orderIndex < end; ++orderIndex)
+                    ++counts[digitAt(orderIndex)];
+            });
+
+            bool singleDigit = false;
+            u32 running = 0u;
+            for(usize bucket = 0u; bucket < s_RadixBucketCount; ++bucket){
+                const u32 bucketBegin = running;
+                for(usize chunk = 0u; chunk < chunkCount; ++chunk){
+                    u32& slot = chunkOffsets[chunk * s_RadixBucketCount + bucket];
+                    const u32 bucketCount = slot;
+                    slot = running;
+                    running += bucketCount;
+                }
+                if(static_cast<usize>(running - bucketBegin) == count)
+                    singleDigit = true;
+            }
+            if(singleDigit)
+                continue;
+
+            threadPool.parallelFor(static_cast<usize>(0), chunkCount, [&](const usize chunk){
+                u32* const offsets = chunkOffsets.data() + chunk * s_RadixBucketCount;
+
+                const usize end = Min(count, (chunk + 1u) * chunkSize);
+                for(usize orderIndex = chunk * chunkSize; orderIndex < end; ++orderIndex)
+                    scratchOrder[offsets[digitAt(orderIndex)]++] = outOrder[orderIndex];
+            });
+            Swap(outOrder, scratchOrder);
+        }
+    }
+}
+
 template<typename Value>
 [[nodiscard]] bool DeduplicateStream(
     UtilityVector<Value>& stream,
@@ -131,23 +250,36 @@ template<typename Value>
     UtilityVector<StreamSortEntry<Value>> sortedEntries;
     sortedEntries.resize(stream.size());
 
-    auto fillEntry = [&](const usize index){
-        sortedEntries[index].value = stream[index];
-        sortedEntries[index].sourceIndex = index;
-    };
-    threadPool.parallelFor(static_cast<usize>(0), stream.size(), s_DeduplicateParallelGrainSize, fillEntry);
+    if(threadPool.isParallelEnabled() && stream.size() >= s_RadixWeldMinCount && stream.size() <= static_cast<usize>(Limit<u32>::s_Max)){
+        UtilityVector<u32> sortedOrder;
+        RadixSortStreamOrder(stream, threadPool, sortedOrder);
 
-    Sort(
-        sortedEntries.begin(),
-        sortedEntries.end(),
-        [](const StreamSortEntry<Value>& lhs, const StreamSortEntry<Value>& rhs){
-            if(LessValue(lhs.value, rhs.value))
-                return true;
-            if(LessValue(rhs.value, lhs.value))
-                return false;
-            return lhs.sourceIndex < rhs.sourceIndex;
-        }
-    );
+        auto fillSortedEntry = [&](const usize sortedIndex){
+            const usize sourceIndex = static_cast<usize>(sortedOrder[sortedIndex]);
+            sortedEntries[sortedIndex].value = stream[sourceIndex];
+            sortedEntries[sortedIndex].sourceIndex = sourceIndex;
+        };
+        threadPool.parallelFor(static_cast<usize>(0), stream.size(), s_DeduplicateParallelGrainSize, fillSortedEntry);
+    }
+    else{
+        auto fillEntry = [&](const usize index){
+            sortedEntries[index].value = stream[index];
+            sortedEntries[index].sourceIndex = index;
+        };
+        threadPool.parallelFor(static_cast<usize>(0), stream.size(), s_DeduplicateParallelGrainSize, fillEntry);
+
+        Sort(
+            sortedEntries.begin(),
+            sortedEntries.end(),
+            [](const StreamSortEntry<Value>& lhs, const StreamSortEntry<Value>& rhs){
+                if(LessValue(lhs.value, rhs.value))
+                    return true;
+                if(LessValue(rhs.value, lhs.value))
+                    return false;
+                return lhs.sourceIndex < rhs.sourceIndex;
+            }
+        );
+    }
 
     usize uniqueCount = 0u;
     for(usize sortedIndex = 0u; sortedIndex < sortedEntries.size(); ++sortedIndex){
@@ -119,10 +119,20 @@ namespace OutputAssetType{
         Mesh,
         Model,
         Skeleton,
-        Skin
+        Skin,
+        Animation
     };
 };
 
+// Joint transforms sampled once per source frame. Matrices are global, in output space, and frame-major:
+// globalMatrices[frame * jointCount + joint].
+struct SampledSkeletonAnimation{
+    AString name;
+    f64 frameRate = 0.0;
+    usize frameCount = 0u;
+    UtilityVector<JointMatrix> globalMatrices;
+};
+
 struct SourceTangentReport{
     SourceTangentMode::Enum mode = SourceTangentMode::Imported;
     u32 degenerateUvTriangleCount = 0u;
@@ -156,6 +166,7 @@ struct ImportOptions{
     bool forceOverwrite = false;
     bool acceptDefaults = false;
     bool listMeshes = false;
+    bool singleThread = false;
 };
 
 
@@ -235,6 +246,22 @@ bool WriteNwbAsset(
     const UtilityVector<JointMatrix>& inverseBindMatrices
 );
 
+bool SampleSkeletonAnimation(
+    ufbx_scene* scene,
+    const ImportOptions& options,
+    const UtilityVector<ufbx_node*>& joints,
+    SampledSkeletonAnimation& outAnimation
+);
+bool WriteNwbAnimationClip(
+    const Path& outputPath,
+    ufbx_scene* scene,
+    const ImportOptions& options,
+    const SourceMeshStreams& mesh,
+    const UtilityVector<ufbx_node*>& skeletonJoints,
+    const UtilityVector<JointMatrix>& skeletonBindPoseMatrices,
+    const UtilityVector<JointMatrix>& inverseBindMatrices
+);
+
 int Run(int argc, char** argv, Core::Alloc::ThreadPool& threadPool, bool& prompted);
 
 
@@ -30,6 +30,9 @@ struct ExportContext{
     HashMap<ufbx_node*, u16> jointLookup;
 };
 
+bool FiniteUfbxMatrix(const ufbx_matrix& matrix);
+JointMatrix ToJointMatrix(const ufbx_matrix& matrix);
+
 bool BuildClusterJointMap(
     const MeshInstance& instance,
     const ImportOptions& options,
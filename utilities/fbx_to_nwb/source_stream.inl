@@ -376,6 +376,48 @@ template<typename Value, typename Lookup>
     return true;
 }
 
+template<typename Value, typename Lookup>
+[[nodiscard]] bool InternSourceStream(
+    UtilityVector<Value>& stream,
+    Lookup& lookup,
+    const UtilityVector<Value>& values,
+    const char* streamName,
+    UtilityVector<u32>& outRemap
+){
+    outRemap.clear();
+    outRemap.reserve(values.size());
+    for(const Value& value : values){
+        u32 index = 0u;
+        if(!InternSourceValue(stream, lookup, value, streamName, index))
+            return false;
+        outRemap.push_back(index);
+    }
+    return true;
+}
+
+[[nodiscard]] u32 RemapSourceStreamIndex(const u32 index, const UtilityVector<u32>& remap){
+    if(index == s_MissingSourceStreamIndex)
+        return s_MissingSourceStreamIndex;
+
+    NWB_ASSERT(index < remap.size());
+    return remap[index];
+}
+
+// Rebuilds the intern lookups of a context whose streams were filled elsewhere; every stream value must be unique.
+void SeedSourceMeshBuildContext(SourceMeshBuildContext& context){
+    const auto seed = [](const auto& stream, auto& lookup){
+        for(usize index = 0u; index < stream.size(); ++index)
+            lookup.emplace(stream[index], static_cast<u32>(index));
+    };
+    seed(context.mesh.positions, context.positions);
+    seed(context.mesh.normals, context.normals);
+    seed(context.mesh.tangents, context.tangents);
+    seed(context.mesh.uv0, context.uv0);
+    seed(context.mesh.colors, context.colors);
+    seed(context.mesh.skin, context.skin);
+    seed(context.mesh.vertexRefs, context.vertexRefs);
+}
+
 [[nodiscard]] bool GenerateSourceMeshTangents(
     SourceMeshStreams& mesh,
     const bool usedDefaultUvs,